@@ -29,6 +29,8 @@ AppBase::~AppBase()
 {
 	g_appBase = nullptr;
 
+	D3D11Utils::SetUploadManager(nullptr);
+
 	// CleanUp
 	ImGui_ImplDX11_Shutdown();
 	ImGui_ImplWin32_Shutdown();
@@ -50,6 +52,8 @@ int AppBase::Run()
 		}
 		else
 		{
+			m_frameAllocator.Reset();
+
 			ImGui_ImplDX11_NewFrame();
 			ImGui_ImplWin32_NewFrame();
 
@@ -68,6 +72,13 @@ int AppBase::Run()
 
 			Update(ImGui::GetIO().DeltaTime);
 
+			// 이번 Frame에 모인 Texture/Buffer 복사를 보내고 다 읽은 Staging Page 회수
+			m_uploadManager->EndFrame();
+
+			// 지난 Frame의 GUI 렌더링 등이 상태를 바꿨으므로 모두 다시 설정
+			m_stateCache.Invalidate();
+			m_stateCache.ResetStats();
+
 			Render(); // 우리가 구현한 렌더링
 
 			// GUI 렌더링
@@ -256,9 +267,9 @@ void AppBase::UpdateGlobalConstants(const DirectX::SimpleMath::Vector3& eyeWorld
 void AppBase::SetGlobalConsts(Microsoft::WRL::ComPtr<ID3D11Buffer>& globalConstsGPU)
 {
 	// 쉐이더와 일관성 유지 register(b1)
-	m_context->VSSetConstantBuffers(1, 1, globalConstsGPU.GetAddressOf());
-	m_context->GSSetConstantBuffers(1, 1, globalConstsGPU.GetAddressOf());
-	m_context->PSSetConstantBuffers(1, 1, globalConstsGPU.GetAddressOf());
+	m_stateCache.VSSetConstantBuffers(1, 1, globalConstsGPU.GetAddressOf());
+	m_stateCache.GSSetConstantBuffers(1, 1, globalConstsGPU.GetAddressOf());
+	m_stateCache.PSSetConstantBuffers(1, 1, globalConstsGPU.GetAddressOf());
 }
 
 void AppBase::CreateDepthBuffers()
@@ -342,23 +353,23 @@ void AppBase::CreateDepthBuffers()
 
 void AppBase::SetPipelineState(const GraphicsPSO& pso)
 {
-	m_context->IASetInputLayout(pso.m_inputLayout.Get());
-	m_context->IASetPrimitiveTopology(pso.m_primitiveTopology);
+	m_stateCache.IASetInputLayout(pso.m_inputLayout.Get());
+	m_stateCache.IASetPrimitiveTopology(pso.m_primitiveTopology);
 
-	m_context->VSSetShader(pso.m_vertexShader.Get(), 0, 0);
+	m_stateCache.VSSetShader(pso.m_vertexShader.Get(), 0, 0);
 
-	m_context->HSSetShader(pso.m_hullShader.Get(), 0, 0);
+	m_stateCache.HSSetShader(pso.m_hullShader.Get(), 0, 0);
 
-	m_context->DSSetShader(pso.m_domainShader.Get(), 0, 0);
+	m_stateCache.DSSetShader(pso.m_domainShader.Get(), 0, 0);
 
-	m_context->GSSetShader(pso.m_geometryShader.Get(), 0, 0);
+	m_stateCache.GSSetShader(pso.m_geometryShader.Get(), 0, 0);
 
-	m_context->RSSetState(pso.m_rasterizerState.Get());
+	m_stateCache.RSSetState(pso.m_rasterizerState.Get());
 
-	m_context->PSSetShader(pso.m_pixelShader.Get(), 0, 0);
+	m_stateCache.PSSetShader(pso.m_pixelShader.Get(), 0, 0);
 
-	m_context->OMSetBlendState(pso.m_blendState.Get(), pso.m_blendFactor, 0xffffffff);
-	m_context->OMSetDepthStencilState(pso.m_depthStencilState.Get(), pso.m_stencilRef);
+	m_stateCache.OMSetBlendState(pso.m_blendState.Get(), pso.m_blendFactor, 0xffffffff);
+	m_stateCache.OMSetDepthStencilState(pso.m_depthStencilState.Get(), pso.m_stencilRef);
 }
 
 bool AppBase::UpdateMouseControl(const DirectX::BoundingSphere& bs,
@@ -381,23 +392,11 @@ bool AppBase::UpdateMouseControl(const DirectX::BoundingSphere& bs,
 	// 마우스 좌클릭시 회전
 	if (m_leftButton)
 	{
-		Vector3 cursorNdcNear = Vector3(m_cursorNdcX, m_cursorNdcY, 0.0f);
-		Vector3 cursorNdcFar = Vector3(m_cursorNdcX, m_cursorNdcY, 1.0f);
-
-		// NDC 좌표계의 커서를 World 좌표계로 역변환 해주는 Matrix
-		Matrix inverseProjView = (viewRow * projRow).Invert();
-
-		// Picking Ray 생성
-		Vector3 cursorWorldNear = Vector3::Transform(cursorNdcNear, inverseProjView);
-		Vector3 cursorWorldFar = Vector3::Transform(cursorNdcFar, inverseProjView);
-		Vector3 dir = cursorWorldFar - cursorWorldNear;
-		dir.Normalize();
-
-		const Ray pickingRay = Ray(cursorWorldNear, dir);
+		const Ray pickingRay = GetPickingRay();
 		float dist = 0.0f;
 		if (pickingRay.Intersects(bs, dist))
 		{
-			pickPoint = cursorWorldNear + dist * dir;
+			pickPoint = pickingRay.position + dist * pickingRay.direction;
 
 			if (m_dragStartFlag)
 			{
@@ -467,6 +466,22 @@ bool AppBase::UpdateMouseControl(const DirectX::BoundingSphere& bs,
 	return false;
 }
 
+DirectX::SimpleMath::Ray AppBase::GetPickingRay()
+{
+	Vector3 cursorNdcNear = Vector3(m_cursorNdcX, m_cursorNdcY, 0.0f);
+	Vector3 cursorNdcFar = Vector3(m_cursorNdcX, m_cursorNdcY, 1.0f);
+
+	// NDC 좌표계의 커서를 World 좌표계로 역변환 해주는 Matrix
+	Matrix inverseProjView = (m_camera.GetViewRow() * m_camera.GetProjRow()).Invert();
+
+	Vector3 cursorWorldNear = Vector3::Transform(cursorNdcNear, inverseProjView);
+	Vector3 cursorWorldFar = Vector3::Transform(cursorNdcFar, inverseProjView);
+	Vector3 dir = cursorWorldFar - cursorWorldNear;
+	dir.Normalize();
+
+	return Ray(cursorWorldNear, dir);
+}
+
 bool AppBase::InitMainWindow()
 {
 	WNDCLASSEX wc = { sizeof(WNDCLASSEX), CS_CLASSDC, WndProc,
@@ -541,6 +556,12 @@ bool AppBase::InitDirect3D()
 		return false;
 	}
 
+	m_stateCache.SetContext(m_context.Get());
+
+	m_uploadDevice = make_unique<D3D11UploadDevice>(m_device, m_context);
+	m_uploadManager = make_unique<UploadManager>(*m_uploadDevice);
+	D3D11Utils::SetUploadManager(m_uploadManager.get());
+
 	Graphics::InitCommonStates(m_device);
 	CreateBuffers();
 	SetMainViewport();
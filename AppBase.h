@@ -11,9 +11,12 @@
 
 #include "Camera.h"
 #include "ConstantBuffers.h"
+#include "D3D11UploadDevice.h"
 #include "D3D11Utils.h"
+#include "FrameAllocator.h"
 #include "GraphicsPSO.h"
 #include "PostProcess.h"
+#include "StateCache.h"
 #include "GraphicsCommon.h"
 
 class AppBase {
@@ -47,6 +50,9 @@ public:
 							DirectX::SimpleMath::Vector3& dragTranslation,
 							DirectX::SimpleMath::Vector3& pickPoint);
 
+	// 커서 위치에서 화면 안쪽으로 향하는 World Space Picking Ray (direction은 정규화)
+	DirectX::SimpleMath::Ray GetPickingRay();
+
 protected:
 	bool InitMainWindow();
 	bool InitDirect3D();
@@ -68,6 +74,17 @@ public:
 	Microsoft::WRL::ComPtr<IDXGISwapChain> m_swapChain;
 	Microsoft::WRL::ComPtr<ID3D11RenderTargetView> m_backBufferRTV;
 
+	// SetPipelineState(), SetGlobalConsts(), RenderQueue에서 같은 상태를 다시 설정하지 않음
+	// m_context를 직접 사용하는 곳(ImGui, PostProcess 등)이 있으므로 Render() 전에 Invalidate()
+	StateCache<ID3D11DeviceContext> m_stateCache;
+
+	// Update()/Render()에서 그 Frame에만 쓰는 임시 배열 (Frame마다 Reset)
+	FrameAllocator m_frameAllocator;
+
+	// Texture/Buffer 데이터를 Staging Page에 모아서 Frame마다 한 번에 복사 (D3D11Utils에 등록)
+	std::unique_ptr<D3D11UploadDevice> m_uploadDevice;
+	std::unique_ptr<UploadManager> m_uploadManager;
+
 	// float(MSAA) -> resolved(Not MSAA) -> PostProcess -> backBuffer
 	Microsoft::WRL::ComPtr<ID3D11Texture2D> m_floatBuffer;
 	Microsoft::WRL::ComPtr<ID3D11Texture2D> m_resolvedBuffer;
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+// 연속된 배열을 복사하지 않고 가리킴 (std::span 대신, 가리키는 배열을 유지해야 함)
+// vector, C 배열, FrameAllocator::AllocateArray(), { a, b } 모두 받을 수 있으므로
+// 함수 인자로 const std::vector<T> &를 받는 대신 사용하면 호출하는 쪽에서 임시 vector를 만들지 않음
+template <typename T>
+class ArrayView {
+public:
+	ArrayView() = default;
+	ArrayView(T *data, const size_t size) : m_data(data), m_size(size) {}
+
+	template <size_t N>
+	ArrayView(T (&array)[N]) : m_data(array), m_size(N)
+	{
+	}
+
+	// data()와 size()가 있는 연속 Container (std::vector, std::array)
+	template <typename Container,
+			  typename = std::enable_if_t<std::is_convertible<
+				  std::remove_pointer_t<decltype(std::declval<Container &>().data())> (*)[], T (*)[]>::value>>
+	ArrayView(Container &container) : m_data(container.data()), m_size(container.size())
+	{
+	}
+
+	// 함수 인자로 넘긴 { a, b }는 호출이 끝날 때까지 유지됨
+	template <typename U = T, typename = std::enable_if_t<std::is_const<U>::value>>
+	ArrayView(std::initializer_list<std::remove_const_t<T>> list) : m_data(list.begin()), m_size(list.size())
+	{
+	}
+
+	T *data() const { return m_data; }
+	size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+
+	T *begin() const { return m_data; }
+	T *end() const { return m_data + m_size; }
+
+	T &operator[](const size_t i) const { return m_data[i]; }
+
+private:
+	T *m_data = nullptr;
+	size_t m_size = 0;
+};
@@ -0,0 +1,89 @@
+#include "AsyncModelLoader.h"
+#include "GeometryGenerator.h"
+#include "ThreadPool.h"
+
+using namespace std;
+
+AsyncModelLoader::AsyncModelLoader() : m_state(make_shared<SharedState>()) {}
+
+std::future<void> AsyncModelLoader::LoadModelAsync(const std::string& basePath, const std::string& fileName,
+												   bool reverseNormal, FinishFunc finish)
+{
+	ImageLoader::SkipFunc skipImage = m_skipImage;
+	return LoadAsync([=]() { return ReadModel(basePath, fileName, reverseNormal, skipImage); },
+					 std::move(finish));
+}
+
+std::future<void> AsyncModelLoader::LoadAsync(std::function<ModelPayload()> load, FinishFunc finish)
+{
+	// promise는 Render Thread에서 finish 후에 채움
+	unique_ptr<CompletedJob> job = make_unique<CompletedJob>();
+	job->finish = std::move(finish);
+	std::future<void> result = job->promise.get_future();
+
+	m_state->pendingCount++;
+
+	// std::function은 복사 가능해야 해서 shared_ptr로 넘김
+	shared_ptr<SharedState> state = m_state;
+	shared_ptr<unique_ptr<CompletedJob>> jobHolder = make_shared<unique_ptr<CompletedJob>>(std::move(job));
+	ThreadPool::GetInstance().Submit([state, jobHolder, load]() {
+		unique_ptr<CompletedJob>& job = *jobHolder;
+		try
+		{
+			job->payload = load();
+		}
+		catch (...)
+		{
+			job->error = current_exception();
+		}
+
+		state->completed.Push(std::move(job));
+	});
+
+	return result;
+}
+
+size_t AsyncModelLoader::ProcessCompleted(const size_t maxCount)
+{
+	size_t processed = 0;
+	unique_ptr<CompletedJob> job;
+	while (processed < maxCount && m_state->completed.TryPop(job))
+	{
+		if (job->error)
+		{
+			job->promise.set_exception(job->error);
+		}
+		else
+		{
+			try
+			{
+				job->finish(job->payload);
+				job->promise.set_value();
+			}
+			catch (...)
+			{
+				job->promise.set_exception(current_exception());
+			}
+		}
+
+		m_state->pendingCount--;
+		processed++;
+	}
+
+	return processed;
+}
+
+ModelPayload AsyncModelLoader::ReadModel(const std::string& basePath, const std::string& fileName,
+										 bool reverseNormal, const ImageLoader::SkipFunc& skipImage)
+{
+	ModelPayload payload;
+	payload.meshes = GeometryGenerator::ReadFromFile(basePath, fileName, reverseNormal);
+
+	// ReadMeshImages() 안에서도 Texture 단위로 병렬
+	payload.images.resize(payload.meshes.size());
+	ThreadPool::GetInstance().ParallelFor(0, payload.meshes.size(), [&](size_t i) {
+		ImageLoader::ReadMeshImages(payload.meshes[i], payload.images[i], skipImage);
+	});
+
+	return payload;
+}
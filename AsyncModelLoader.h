@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ImageLoader.h"
+#include "LockFreeQueue.h"
+#include "MeshData.h"
+
+// Worker Thread에서 만든 Model 하나의 CPU 데이터
+struct ModelPayload {
+	std::vector<MeshData> meshes;
+	std::vector<MeshImages> images; // meshes와 같은 순서
+};
+
+// 파일 읽기와 Texture Decoding은 ThreadPool에서, GPU 자원 생성은 Render Thread에서
+// D3D를 직접 사용하지 않음 (GPU 작업은 finish로 전달), Device 없이도 동작
+class AsyncModelLoader {
+public:
+	// Render Thread(ProcessCompleted)에서 payload로 GPU 자원을 만드는 함수
+	using FinishFunc = std::function<void(ModelPayload &)>;
+
+	AsyncModelLoader();
+
+	// finish까지 끝나면 future가 준비됨 (읽다가 실패하면 finish는 호출되지 않고 예외 전달)
+	std::future<void> LoadModelAsync(const std::string &basePath, const std::string &fileName,
+									 bool reverseNormal, FinishFunc finish);
+
+	// 파일 대신 임의의 CPU 작업으로 payload를 만듦
+	std::future<void> LoadAsync(std::function<ModelPayload()> load, FinishFunc finish);
+
+	// Render Thread에서 매 프레임 호출, 끝난 작업을 maxCount개까지 finish (처리한 개수 반환)
+	// 한 프레임에 GPU 생성이 몰리지 않도록 maxCount로 나눌 수 있음
+	size_t ProcessCompleted(const size_t maxCount = SIZE_MAX);
+
+	// Worker에서 진행 중이거나 ProcessCompleted()를 기다리는 작업 수
+	size_t GetPendingCount() const { return m_state->pendingCount; }
+
+	// GeometryGenerator::ReadFromFile() 후 모든 Texture를 병렬로 Decoding
+	static ModelPayload ReadModel(const std::string &basePath, const std::string &fileName,
+								  bool reverseNormal, const ImageLoader::SkipFunc &skipImage = nullptr);
+
+public:
+	// LoadModelAsync()에서 Decoding하지 않을 Texture (예: 이미 GPU에 있는 것)
+	// Worker Thread에서 호출됨
+	ImageLoader::SkipFunc m_skipImage;
+
+private:
+	struct CompletedJob {
+		ModelPayload payload;
+		FinishFunc finish;
+		std::promise<void> promise;
+		std::exception_ptr error;
+	};
+
+	// Loader가 먼저 사라져도 Worker가 안전하게 Push할 수 있도록 공유
+	struct SharedState {
+		LockFreeQueue<std::unique_ptr<CompletedJob>> completed;
+		std::atomic<size_t> pendingCount{ 0 };
+	};
+
+	std::shared_ptr<SharedState> m_state;
+};
@@ -0,0 +1,103 @@
+#include "AutoExposure.h"
+#include "PixelConverter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+void LuminanceHistogram::Clear()
+{
+	fill(bins, bins + binCount, 0);
+	pixelCount = 0;
+	minLuminance = numeric_limits<float>::infinity();
+	maxLuminance = 0.0f;
+}
+
+void LuminanceHistogram::Add(const uint16_t* rgba, const size_t width, const size_t height,
+							 const size_t rowPitch)
+{
+	if (pixelCount == 0)
+	{
+		minLuminance = numeric_limits<float>::infinity();
+		maxLuminance = 0.0f;
+	}
+
+	for (size_t y = 0; y < height; y++)
+	{
+		const uint16_t* row = (const uint16_t*)((const uint8_t*)rgba + y * rowPitch);
+		PixelConverter::LuminanceHistogramHalf(row, width, minLog2, maxLog2, bins, binCount,
+											   minLuminance, maxLuminance);
+	}
+
+	pixelCount += width * height;
+}
+
+float LuminanceHistogram::GetAverageLog2(const float lowPercent, const float highPercent) const
+{
+	if (pixelCount == 0)
+	{
+		return 0.0f;
+	}
+
+	// 누적 개수가 [low, high]에 들어가는 부분만 (bin 중간값으로)
+	const float low = float(pixelCount) * std::clamp(lowPercent, 0.0f, 1.0f);
+	const float high = float(pixelCount) * std::clamp(max(highPercent, lowPercent), 0.0f, 1.0f);
+	const float binSize = (maxLog2 - minLog2) / float(binCount);
+
+	float sum = 0.0f;
+	float count = 0.0f;
+	float start = 0.0f;
+	for (int i = 0; i < binCount; i++)
+	{
+		const float end = start + float(bins[i]);
+		const float used = min(end, high) - max(start, low);
+		if (used > 0.0f)
+		{
+			sum += used * (minLog2 + (float(i) + 0.5f) * binSize);
+			count += used;
+		}
+		start = end;
+	}
+
+	// low == high이면 그 위치의 bin 하나
+	if (count == 0.0f)
+	{
+		start = 0.0f;
+		for (int i = 0; i < binCount; i++)
+		{
+			start += float(bins[i]);
+			if (start >= low)
+			{
+				return minLog2 + (float(i) + 0.5f) * binSize;
+			}
+		}
+	}
+
+	return sum / max(count, 1.0f);
+}
+
+float AutoExposure::GetTargetExposure(const LuminanceHistogram& histogram) const
+{
+	if (histogram.pixelCount == 0)
+	{
+		return m_exposure;
+	}
+
+	const float averageLog2 = histogram.GetAverageLog2(m_lowPercent, m_highPercent);
+	const float exposure = m_targetLuminance * exp2(m_compensation - averageLog2);
+	return std::clamp(exposure, m_minExposure, m_maxExposure);
+}
+
+float AutoExposure::Update(const LuminanceHistogram& histogram, const float dt)
+{
+	// 사람 눈처럼 EV(log2) 공간에서 지수적으로 따라감 (Frame Rate와 무관)
+	const float current = log2(max(m_exposure, 1e-6f));
+	const float target = log2(GetTargetExposure(histogram));
+	const float speed = target > current ? m_speedUp : m_speedDown;
+	const float blend = 1.0f - exp(-max(dt, 0.0f) * speed);
+
+	m_exposure = exp2(current + (target - current) * blend);
+	return m_exposure;
+}
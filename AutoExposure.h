@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// HDR 이미지의 log2 Luminance 분포 (Frame 하나 또는 .exr 하나)
+struct LuminanceHistogram {
+	static const int binCount = 64;
+
+	float minLog2 = -10.0f; // bins[0]의 시작 (이보다 어두우면 bins[0])
+	float maxLog2 = 6.0f;	// bins[binCount - 1]의 끝 (이보다 밝으면 bins[binCount - 1])
+	uint32_t bins[binCount] = {};
+	size_t pixelCount = 0;
+	float minLuminance = 0.0f;
+	float maxLuminance = 0.0f;
+
+	void Clear();
+
+	// RGBA fp16 이미지를 누적 (rowPitch는 Byte 단위, Map한 Staging Texture를 그대로 넣을 수 있음)
+	void Add(const uint16_t *rgba, const size_t width, const size_t height, const size_t rowPitch);
+
+	// 어두운 쪽 lowPercent, 밝은 쪽 (1 - highPercent)를 빼고 평균한 log2 Luminance
+	float GetAverageLog2(const float lowPercent, const float highPercent) const;
+};
+
+// Histogram으로 목표 Exposure를 정하고 시간에 따라 천천히 따라감
+// D3D와 무관 (GPU에서 읽어오는 것은 PostProcess)
+class AutoExposure {
+public:
+	// 새 Histogram이 들어올 때마다 호출 (dt는 이전 호출부터의 시간, 초), 적용할 Exposure 반환
+	float Update(const LuminanceHistogram &histogram, const float dt);
+
+	float GetTargetExposure(const LuminanceHistogram &histogram) const;
+	float GetExposure() const { return m_exposure; }
+	void Reset(const float exposure) { m_exposure = exposure; }
+
+public:
+	float m_targetLuminance = 0.18f; // 평균 밝기를 Middle Gray로
+	float m_compensation = 0.0f;	 // EV (+1이면 두 배 밝게)
+
+	// 평균에서 제외할 어두운/밝은 부분 (하늘, 광원 등에 끌려가지 않도록)
+	float m_lowPercent = 0.5f;
+	float m_highPercent = 0.95f;
+
+	float m_minExposure = 0.05f;
+	float m_maxExposure = 20.0f;
+
+	// 1초에 남은 차이의 (1 - e^-speed)만큼 따라감
+	float m_speedUp = 3.0f;	  // 어두워져서 Exposure를 올릴 때
+	float m_speedDown = 1.5f; // 밝아져서 Exposure를 내릴 때
+
+private:
+	float m_exposure = 1.0f;
+};
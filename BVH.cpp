@@ -0,0 +1,318 @@
+#include "BVH.h"
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+
+using namespace std;
+using namespace DirectX;
+
+namespace {
+	// SSE 한 Register에 x, y, z (w는 사용하지 않음)
+	struct Bounds {
+		__m128 boxMin = _mm_set1_ps(FLT_MAX);
+		__m128 boxMax = _mm_set1_ps(-FLT_MAX);
+
+		void Grow(const __m128 p) { Grow(p, p); }
+
+		void Grow(const __m128 otherMin, const __m128 otherMax)
+		{
+			boxMin = _mm_min_ps(boxMin, otherMin);
+			boxMax = _mm_max_ps(boxMax, otherMax);
+		}
+
+		void Grow(const Bounds& other) { Grow(other.boxMin, other.boxMax); }
+
+		// 표면적의 절반 (SAH에서는 비율만 사용)
+		float HalfArea() const
+		{
+			alignas(16) float d[4];
+			_mm_store_ps(d, _mm_sub_ps(boxMax, boxMin));
+			if (d[0] < 0.0f)
+			{
+				return 0.0f;
+			}
+			return d[0] * d[1] + d[1] * d[2] + d[2] * d[0];
+		}
+
+		void Store(XMFLOAT3& outMin, XMFLOAT3& outMax) const
+		{
+			alignas(16) float lo[4], hi[4];
+			_mm_store_ps(lo, boxMin);
+			_mm_store_ps(hi, boxMax);
+			outMin = XMFLOAT3(lo[0], lo[1], lo[2]);
+			outMax = XMFLOAT3(hi[0], hi[1], hi[2]);
+		}
+	};
+
+	// Index를 따라가지 않도록 Box와 Centroid를 같이 들고 정렬 (큰 Mesh에서 Cache Miss 감소)
+	struct Primitive {
+		__m128 boxMin;
+		__m128 boxMax;
+		__m128 centroid;
+		uint32_t index;
+	};
+
+	// 자식의 경계는 부모가 Bin에서 합친 것을 넘겨줌 (Node마다 다시 읽지 않음)
+	struct BuildTask {
+		uint32_t node;
+		uint32_t begin;
+		uint32_t end;
+		uint32_t depth;
+		Bounds bounds;
+		Bounds centroidBounds;
+	};
+
+	struct Bin {
+		Bounds bounds;
+		Bounds centroidBounds;
+		uint32_t count = 0;
+	};
+
+	// Leaf 하나의 검사 비용 (groupSize개씩 한 번에 검사)
+	float LeafCost(const uint32_t count, const uint32_t groupSize)
+	{
+		return float((count + groupSize - 1) / groupSize);
+	}
+
+	void ComputeBounds(const vector<Primitive>& prims, const uint32_t begin, const uint32_t end,
+					   Bounds& bounds, Bounds& centroidBounds)
+	{
+		bounds = Bounds();
+		centroidBounds = Bounds();
+		for (uint32_t i = begin; i < end; i++)
+		{
+			bounds.Grow(prims[i].boxMin, prims[i].boxMax);
+			centroidBounds.Grow(prims[i].centroid);
+		}
+	}
+
+	// 세 축의 Bin Index를 한 번에
+	void GetBins(const __m128 centroid, const __m128 axisMin, const __m128 scale, int bins[4])
+	{
+		const __m128 b = _mm_min_ps(_mm_mul_ps(_mm_sub_ps(centroid, axisMin), scale),
+									_mm_set1_ps(float(BVH::BIN_COUNT - 1)));
+		_mm_storeu_si128((__m128i*)bins, _mm_cvttps_epi32(b));
+	}
+}
+
+void BVH::Build(const std::vector<BVHBox>& boxes, const Settings& settings,
+				std::vector<BVHNode>& nodes, std::vector<uint32_t>& order)
+{
+	nodes.clear();
+	order.clear();
+	if (boxes.empty())
+	{
+		return;
+	}
+
+	const __m128 half = _mm_set1_ps(0.5f);
+	vector<Primitive> prims(boxes.size());
+	for (size_t i = 0; i < boxes.size(); i++)
+	{
+		const BVHBox& b = boxes[i];
+		prims[i].boxMin = _mm_setr_ps(b.boxMin.x, b.boxMin.y, b.boxMin.z, 0.0f);
+		prims[i].boxMax = _mm_setr_ps(b.boxMax.x, b.boxMax.y, b.boxMax.z, 0.0f);
+		prims[i].centroid = _mm_mul_ps(_mm_add_ps(prims[i].boxMin, prims[i].boxMax), half);
+		prims[i].index = uint32_t(i);
+	}
+
+	// Leaf에 Primitive가 하나 이상이므로 Node는 2n - 1개 이하
+	nodes.reserve(boxes.size() * 2);
+	nodes.push_back(BVHNode());
+
+	vector<BuildTask> tasks(1);
+	tasks[0].node = 0;
+	tasks[0].begin = 0;
+	tasks[0].end = uint32_t(boxes.size());
+	tasks[0].depth = 0;
+	ComputeBounds(prims, 0, tasks[0].end, tasks[0].bounds, tasks[0].centroidBounds);
+
+	while (!tasks.empty())
+	{
+		const BuildTask task = tasks.back();
+		tasks.pop_back();
+
+		const uint32_t count = task.end - task.begin;
+
+		BVHNode& node = nodes[task.node];
+		task.bounds.Store(node.boxMin, node.boxMax);
+		node.leftFirst = task.begin;
+		node.count = count;
+
+		if (count <= 1 || task.depth + 1 >= MAX_DEPTH)
+		{
+			continue;
+		}
+
+		// 한 번 읽으면서 세 축 모두 Centroid를 BIN_COUNT개 구간으로 나눔
+		alignas(16) float extent[4];
+		_mm_store_ps(extent, _mm_sub_ps(task.centroidBounds.boxMax, task.centroidBounds.boxMin));
+		alignas(16) float scaleValues[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		for (int axis = 0; axis < 3; axis++)
+		{
+			scaleValues[axis] = extent[axis] > 0.0f ? float(BIN_COUNT) / extent[axis] : 0.0f;
+		}
+		const __m128 axisMin = task.centroidBounds.boxMin;
+		const __m128 scale = _mm_load_ps(scaleValues);
+
+		Bin bins[3][BIN_COUNT];
+		for (uint32_t i = task.begin; i < task.end; i++)
+		{
+			const Primitive& p = prims[i];
+			int b[4];
+			GetBins(p.centroid, axisMin, scale, b);
+			for (int axis = 0; axis < 3; axis++)
+			{
+				Bin& bin = bins[axis][b[axis]];
+				bin.bounds.Grow(p.boxMin, p.boxMax);
+				bin.centroidBounds.Grow(p.centroid);
+				bin.count++;
+			}
+		}
+
+		// 왼쪽부터 누적한 면적과 개수, 오른쪽은 Sweep하면서 누적
+		const float leafCost = LeafCost(count, settings.groupSize);
+		const float parentArea = max(task.bounds.HalfArea(), FLT_MIN);
+		float bestCost = FLT_MAX;
+		int bestAxis = -1;
+		uint32_t bestSplit = 0;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (scaleValues[axis] == 0.0f)
+			{
+				continue;
+			}
+
+			float leftArea[BIN_COUNT - 1];
+			uint32_t leftCount[BIN_COUNT - 1];
+			Bounds left;
+			uint32_t leftSum = 0;
+			for (uint32_t b = 0; b < BIN_COUNT - 1; b++)
+			{
+				left.Grow(bins[axis][b].bounds);
+				leftSum += bins[axis][b].count;
+				leftArea[b] = left.HalfArea();
+				leftCount[b] = leftSum;
+			}
+
+			Bounds right;
+			uint32_t rightSum = 0;
+			for (uint32_t b = BIN_COUNT - 1; b > 0; b--)
+			{
+				right.Grow(bins[axis][b].bounds);
+				rightSum += bins[axis][b].count;
+
+				const uint32_t split = b - 1; // [0, split] | [split + 1, BIN_COUNT)
+				if (leftCount[split] == 0 || rightSum == 0)
+				{
+					continue;
+				}
+
+				const float cost = settings.traversalCost +
+								   (leftArea[split] * LeafCost(leftCount[split], settings.groupSize) +
+									right.HalfArea() * LeafCost(rightSum, settings.groupSize)) /
+									   parentArea;
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = split;
+				}
+			}
+		}
+
+		if (bestCost >= leafCost && count <= settings.maxLeafSize)
+		{
+			continue;
+		}
+
+		uint32_t middle;
+		BuildTask leftTask;
+		BuildTask rightTask;
+		if (bestAxis >= 0)
+		{
+			const int axis = bestAxis;
+			middle = uint32_t(partition(prims.begin() + task.begin, prims.begin() + task.end,
+										[&](const Primitive& p) {
+											int b[4];
+											GetBins(p.centroid, axisMin, scale, b);
+											return uint32_t(b[axis]) <= bestSplit;
+										}) -
+							  prims.begin());
+
+			for (uint32_t b = 0; b < BIN_COUNT; b++)
+			{
+				BuildTask& side = b <= bestSplit ? leftTask : rightTask;
+				side.bounds.Grow(bins[axis][b].bounds);
+				side.centroidBounds.Grow(bins[axis][b].centroidBounds);
+			}
+		}
+		else
+		{
+			// Centroid가 모두 같으면 개수로 반씩 (maxLeafSize를 넘는 경우만)
+			middle = task.begin + count / 2;
+			ComputeBounds(prims, task.begin, middle, leftTask.bounds, leftTask.centroidBounds);
+			ComputeBounds(prims, middle, task.end, rightTask.bounds, rightTask.centroidBounds);
+		}
+
+		// 두 자식은 연속으로
+		const uint32_t leftChild = uint32_t(nodes.size());
+		nodes.push_back(BVHNode());
+		nodes.push_back(BVHNode());
+
+		BVHNode& parent = nodes[task.node];
+		parent.leftFirst = leftChild;
+		parent.count = 0;
+
+		leftTask.node = leftChild;
+		leftTask.begin = task.begin;
+		leftTask.end = middle;
+		leftTask.depth = task.depth + 1;
+
+		rightTask.node = leftChild + 1;
+		rightTask.begin = middle;
+		rightTask.end = task.end;
+		rightTask.depth = task.depth + 1;
+
+		// 왼쪽을 먼저 처리 (Stack이므로 나중에 넣음)
+		tasks.push_back(rightTask);
+		tasks.push_back(leftTask);
+	}
+
+	order.resize(prims.size());
+	for (size_t i = 0; i < prims.size(); i++)
+	{
+		order[i] = prims[i].index;
+	}
+}
+
+void BVH::Refit(const std::vector<BVHBox>& boxes, const std::vector<uint32_t>& order,
+				std::vector<BVHNode>& nodes)
+{
+	// 자식은 항상 부모보다 뒤에 있음
+	for (size_t i = nodes.size(); i-- > 0;)
+	{
+		BVHNode& node = nodes[i];
+		Bounds bounds;
+		if (node.IsLeaf())
+		{
+			for (uint32_t k = node.leftFirst; k < node.leftFirst + node.count; k++)
+			{
+				const BVHBox& b = boxes[order[k]];
+				bounds.Grow(_mm_setr_ps(b.boxMin.x, b.boxMin.y, b.boxMin.z, 0.0f),
+							_mm_setr_ps(b.boxMax.x, b.boxMax.y, b.boxMax.z, 0.0f));
+			}
+		}
+		else
+		{
+			const BVHNode& left = nodes[node.leftFirst];
+			const BVHNode& right = nodes[node.leftFirst + 1];
+			bounds.Grow(_mm_setr_ps(left.boxMin.x, left.boxMin.y, left.boxMin.z, 0.0f),
+						_mm_setr_ps(left.boxMax.x, left.boxMax.y, left.boxMax.z, 0.0f));
+			bounds.Grow(_mm_setr_ps(right.boxMin.x, right.boxMin.y, right.boxMin.z, 0.0f),
+						_mm_setr_ps(right.boxMax.x, right.boxMax.y, right.boxMax.z, 0.0f));
+		}
+		bounds.Store(node.boxMin, node.boxMax);
+	}
+}
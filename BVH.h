@@ -0,0 +1,151 @@
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// 32 Byte, 내부 Node의 두 자식은 연속으로 저장 (오른쪽 = leftFirst + 1)
+struct BVHNode {
+	DirectX::XMFLOAT3 boxMin;
+	uint32_t leftFirst; // 내부 Node: 왼쪽 자식 Index, Leaf: 첫 Primitive 위치
+	DirectX::XMFLOAT3 boxMax;
+	uint32_t count; // Leaf의 Primitive 수, 0이면 내부 Node
+
+	bool IsLeaf() const { return count > 0; }
+};
+
+// Primitive(삼각형, Model) 하나의 AABB
+struct BVHBox {
+	DirectX::XMFLOAT3 boxMin;
+	DirectX::XMFLOAT3 boxMax;
+};
+
+// Traversal용으로 방향의 역수를 미리 계산한 Ray (direction은 정규화하지 않아도 됨)
+struct BVHRay {
+	float origin[3];
+	float invDir[3];
+
+	BVHRay(const DirectX::XMFLOAT3 &o, const DirectX::XMFLOAT3 &d)
+	{
+		const float dir[3] = { d.x, d.y, d.z };
+		for (int a = 0; a < 3; a++)
+		{
+			origin[a] = (&o.x)[a];
+
+			// 축과 평행해도 0 * inf = NaN이 나오지 않도록
+			const float safe = std::fabs(dir[a]) > 1e-20f ? dir[a] : std::copysign(1e-20f, dir[a]);
+			invDir[a] = 1.0f / safe;
+		}
+	}
+
+	// 반환값: Box에 들어가는 거리 (maxDistance 안에서 만나지 않으면 FLT_MAX)
+	float IntersectBox(const BVHNode &node, const float maxDistance) const
+	{
+		float tMin = 0.0f;
+		float tMax = maxDistance;
+		for (int a = 0; a < 3; a++)
+		{
+			const float t1 = ((&node.boxMin.x)[a] - origin[a]) * invDir[a];
+			const float t2 = ((&node.boxMax.x)[a] - origin[a]) * invDir[a];
+			tMin = std::max(tMin, std::min(t1, t2));
+			tMax = std::min(tMax, std::max(t1, t2));
+		}
+		return tMin <= tMax ? tMin : FLT_MAX;
+	}
+};
+
+// AABB 목록으로 Binned SAH BVH를 만들고 Ray로 순회 (MeshBVH, SceneBVH에서 사용)
+// Node는 배열 하나에 깊이 우선 순서로, Primitive는 order에 Leaf 순서로 모음
+class BVH {
+public:
+	static const uint32_t BIN_COUNT = 16;
+	static const uint32_t MAX_DEPTH = 64; // Traverse()의 Stack 크기
+
+	struct Settings {
+		uint32_t maxLeafSize = 4; // SAH로 더 나누지 않아도 이보다 많으면 나눔
+		uint32_t groupSize = 1;	  // Leaf 비용을 이 개수 단위로 올림 (SIMD로 한 번에 검사하는 수)
+		float traversalCost = 1.0f; // Group 하나를 검사하는 비용 대비 Node 하나 방문 비용
+	};
+
+	// Leaf i의 Primitive는 order[leftFirst, leftFirst + count)
+	static void Build(const std::vector<BVHBox> &boxes, const Settings &settings,
+					  std::vector<BVHNode> &nodes, std::vector<uint32_t> &order);
+
+	// Tree 구조는 그대로 두고 boxes로 Node 경계만 다시 계산 (Primitive가 움직였을 때)
+	static void Refit(const std::vector<BVHBox> &boxes, const std::vector<uint32_t> &order,
+					  std::vector<BVHNode> &nodes);
+
+	// 가까운 자식부터 방문, leafFunc(leaf, maxDistance)가 maxDistance를 줄이면 더 먼 Node는 건너뜀
+	// leafFunc가 true를 반환하면 바로 끝냄 (Any Hit)
+	template <typename LeafFunc>
+	static void Traverse(const std::vector<BVHNode> &nodes, const BVHRay &ray, float &maxDistance,
+						 LeafFunc &&leafFunc)
+	{
+		if (nodes.empty() || ray.IntersectBox(nodes[0], maxDistance) == FLT_MAX)
+		{
+			return;
+		}
+
+		uint32_t stack[MAX_DEPTH];
+		float stackDistance[MAX_DEPTH];
+		uint32_t stackSize = 0;
+
+		uint32_t current = 0;
+		while (true)
+		{
+			const BVHNode &node = nodes[current];
+			if (node.IsLeaf())
+			{
+				if (leafFunc(node, maxDistance))
+				{
+					return;
+				}
+			}
+			else
+			{
+				uint32_t nearChild = node.leftFirst;
+				uint32_t farChild = nearChild + 1;
+				float nearDistance = ray.IntersectBox(nodes[nearChild], maxDistance);
+				float farDistance = ray.IntersectBox(nodes[farChild], maxDistance);
+				if (farDistance < nearDistance)
+				{
+					std::swap(nearChild, farChild);
+					std::swap(nearDistance, farDistance);
+				}
+
+				if (nearDistance != FLT_MAX)
+				{
+					if (farDistance != FLT_MAX)
+					{
+						stack[stackSize] = farChild;
+						stackDistance[stackSize] = farDistance;
+						stackSize++;
+					}
+					current = nearChild;
+					continue;
+				}
+			}
+
+			// 넣은 뒤에 더 가까운 교차가 나왔으면 버림
+			bool found = false;
+			while (stackSize > 0)
+			{
+				stackSize--;
+				if (stackDistance[stackSize] <= maxDistance)
+				{
+					current = stack[stackSize];
+					found = true;
+					break;
+				}
+			}
+			if (!found)
+			{
+				return;
+			}
+		}
+	}
+};
@@ -3,9 +3,8 @@
 // 메쉬 재질 텍스춰들 t0 부터 시작
 Texture2D albedoTex : register(t0);
 Texture2D normalTex : register(t1);
-Texture2D aoTex : register(t2);
-Texture2D metallicRoughnessTex : register(t3);
-Texture2D emissiveTex : register(t4);
+Texture2D ormTex : register(t2); // Red: Occlusion, Green: Roughness, Blue: Metallic
+Texture2D emissiveTex : register(t3);
 
 static const float3 Fdielectric = 0.04; // 비금속(Dielectric) 재질의 F0
 
@@ -43,17 +42,19 @@ float3 GetNormal(PixelShaderInput input)
     
     if (useNormalMap) // NormalWorld를 교체
     {
-        float3 normal = normalTex.SampleLevel(linearWrapSampler, input.texcoord, lodBias).rgb; // texture의 범위: [0.0, 1.0]
-        normal = 2.0 * normal - 1.0; // normal로 사용하기 위한 범위 조절 [-1.0, 1.0]
+        float3 normal;
+        normal.xy = normalTex.SampleLevel(linearWrapSampler, input.texcoord, lodBias).rg; // texture의 범위: [0.0, 1.0]
+        normal.xy = 2.0 * normal.xy - 1.0; // normal로 사용하기 위한 범위 조절 [-1.0, 1.0]
+        normal.z = sqrt(saturate(1.0 - dot(normal.xy, normal.xy))); // BC5는 xy만 저장하므로 z는 복원
 
         // OpenGL 용 노멀맵일 경우에는 y 방향을 뒤집어줌
         normal.y = invertNormalMapY ? -normal.y : normal.y;
         
         // Normal Vector 회전용 TangentSpace (3x3)
         float3 N = normalWorld; // Model의 nomalWorld 그대로 사용
-        float3 T = normalize(input.tangentWorld - dot(input.tangentWorld, N) * N); // tangentWorld와 normalWorld가 수직이 아닐 수도 있다
+        float3 T = normalize(input.tangentWorld.xyz - dot(input.tangentWorld.xyz, N) * N); // tangentWorld와 normalWorld가 수직이 아닐 수도 있다
                                                                                    // => normalWorld의 성분을 빼줘 수직을 보장
-        float3 B = cross(N, T); // 순서 유의
+        float3 B = cross(N, T) * input.tangentWorld.w; // 순서 유의, 거울 UV는 w = -1
         
         // matrix는 float4x4, 여기서는 벡터 변환용이라서 3x3 사용
         float3x3 TBN = float3x3(T, B, N);
@@ -269,11 +270,11 @@ PixelShaderOutput main(PixelShaderInput input)
     
     float3 albedo = useAlbedoMap ? albedoTex.SampleLevel(linearWrapSampler, input.texcoord, lodBias).rgb * albedoFactor
                                  : albedoFactor;
-    float ao = useAOMap ? aoTex.SampleLevel(linearWrapSampler, input.texcoord, lodBias).r : 1.0;
-    float metallic = useMetallicMap ? metallicRoughnessTex.SampleLevel(linearWrapSampler, input.texcoord, lodBias).b * metallicFactor
-                                    : metallicFactor;
-    float roughness = useRoughnessMap ? metallicRoughnessTex.SampleLevel(linearWrapSampler, input.texcoord, lodBias).g * roughnessFactor
-                                      : roughnessFactor;
+    float3 orm = (useAOMap || useMetallicMap || useRoughnessMap) ? ormTex.SampleLevel(linearWrapSampler, input.texcoord, lodBias).rgb
+                                                                 : 1.0; // 한 번만 Sample
+    float ao = useAOMap ? orm.r : 1.0;
+    float metallic = useMetallicMap ? orm.b * metallicFactor : metallicFactor;
+    float roughness = useRoughnessMap ? orm.g * roughnessFactor : roughnessFactor;
     float3 emission = useEmissiveMap ? emissiveTex.SampleLevel(linearWrapSampler, input.texcoord, lodBias).rgb
                                      : emissionFactor;
 
@@ -12,8 +12,10 @@ cbuffer MeshConstants : register(b0)
     float2 dummy;
 };
 
-PixelShaderInput main(VertexShaderInput input)
+PixelShaderInput main(QuantizedVertexShaderInput quantizedInput)
 {
+    VertexShaderInput input = DecodeVertex(quantizedInput);
+
     // 뷰 좌표계는 NDC이기 때문에 월드 좌표를 이용해서 조명 계산
     
     PixelShaderInput output;
@@ -24,7 +26,7 @@ PixelShaderInput main(VertexShaderInput input)
     output.normalWorld = normalize(output.normalWorld);
     
     // Tangent 벡터는 world로 변환
-    float4 tangentWorld = float4(input.tangentModel, 0.0f);
+    float4 tangentWorld = float4(input.tangentModel.xyz, 0.0f);
     tangentWorld = mul(tangentWorld, world);
 
     float4 pos = float4(input.posModel, 1.0f);
@@ -45,7 +47,7 @@ PixelShaderInput main(VertexShaderInput input)
 
     output.posProj = pos;
     output.texcoord = input.texcoord;
-    output.tangentWorld = tangentWorld.xyz;
+    output.tangentWorld = float4(tangentWorld.xyz, input.tangentModel.w); // Bitangent 부호는 그대로 전달
     
     return output;
 }
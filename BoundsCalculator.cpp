@@ -0,0 +1,536 @@
+#include "BoundsCalculator.h"
+#include "ThreadPool.h"
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace std;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	// 이 크기보다 큰 Mesh만 블록 단위로 나눠서 병렬
+	const size_t BLOCK_SIZE = 16384;
+
+	// 1단계 블록 결과
+	struct FirstPassResult {
+		float minValue[3];
+		float maxValue[3];
+		uint32_t minIndex[3];
+		uint32_t maxIndex[3];
+		double sum[3];        // 첫 Vertex 기준 (큰 좌표에서 공분산 정밀도 유지)
+		double sumProduct[6]; // xx, yy, zz, xy, xz, yz
+	};
+
+	// 2단계 블록 결과
+	struct SecondPassResult {
+		BoundingSphere sphere;
+		float minProjection[3];
+		float maxProjection[3];
+	};
+
+	__m128i Select(const __m128 mask, const __m128i a, const __m128i b)
+	{
+		const __m128i m = _mm_castps_si128(mask);
+		return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+	}
+
+	// Vertex 4개의 Position을 SoA로 (position 뒤의 normal.x까지 읽어서 전치)
+	// 끝을 넘는 Lane은 마지막 Vertex로 채우고 valid에서 제외
+	void LoadPositions(const Vertex *vertices, const size_t i, const size_t end,
+					   __m128 &x, __m128 &y, __m128 &z, __m128 &valid)
+	{
+		__m128 rows[4];
+		for (size_t k = 0; k < 4; k++)
+		{
+			rows[k] = _mm_loadu_ps(&vertices[min(i + k, end - 1)].position.x);
+		}
+		_MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+		x = rows[0];
+		y = rows[1];
+		z = rows[2];
+
+		const __m128 lane = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+		valid = _mm_cmplt_ps(lane, _mm_set1_ps(float(min(end - i, size_t(4)))));
+	}
+
+	FirstPassResult FirstPass(const Vertex *vertices, const size_t begin, const size_t end,
+							  const Vector3 &origin, const bool computeCovariance)
+	{
+		__m128 minValue[3], maxValue[3];
+		__m128i minIndex[3], maxIndex[3];
+		for (int a = 0; a < 3; a++)
+		{
+			minValue[a] = _mm_set1_ps(FLT_MAX);
+			maxValue[a] = _mm_set1_ps(-FLT_MAX);
+			minIndex[a] = _mm_setzero_si128();
+			maxIndex[a] = _mm_setzero_si128();
+		}
+
+		__m128 sum[3] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+		__m128 sumProduct[6] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(),
+								 _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+		const __m128 originX = _mm_set1_ps(origin.x);
+		const __m128 originY = _mm_set1_ps(origin.y);
+		const __m128 originZ = _mm_set1_ps(origin.z);
+
+		for (size_t i = begin; i < end; i += 4)
+		{
+			__m128 p[3], valid;
+			LoadPositions(vertices, i, end, p[0], p[1], p[2], valid);
+
+			const uint32_t last = uint32_t(end - 1);
+			const __m128i index = _mm_setr_epi32(int(min(uint32_t(i), last)), int(min(uint32_t(i + 1), last)),
+												 int(min(uint32_t(i + 2), last)), int(min(uint32_t(i + 3), last)));
+
+			for (int a = 0; a < 3; a++)
+			{
+				const __m128 less = _mm_cmplt_ps(p[a], minValue[a]);
+				minValue[a] = _mm_min_ps(p[a], minValue[a]);
+				minIndex[a] = Select(less, index, minIndex[a]);
+
+				const __m128 greater = _mm_cmpgt_ps(p[a], maxValue[a]);
+				maxValue[a] = _mm_max_ps(p[a], maxValue[a]);
+				maxIndex[a] = Select(greater, index, maxIndex[a]);
+			}
+
+			if (computeCovariance)
+			{
+				const __m128 dx = _mm_and_ps(valid, _mm_sub_ps(p[0], originX));
+				const __m128 dy = _mm_and_ps(valid, _mm_sub_ps(p[1], originY));
+				const __m128 dz = _mm_and_ps(valid, _mm_sub_ps(p[2], originZ));
+
+				sum[0] = _mm_add_ps(sum[0], dx);
+				sum[1] = _mm_add_ps(sum[1], dy);
+				sum[2] = _mm_add_ps(sum[2], dz);
+				sumProduct[0] = _mm_add_ps(sumProduct[0], _mm_mul_ps(dx, dx));
+				sumProduct[1] = _mm_add_ps(sumProduct[1], _mm_mul_ps(dy, dy));
+				sumProduct[2] = _mm_add_ps(sumProduct[2], _mm_mul_ps(dz, dz));
+				sumProduct[3] = _mm_add_ps(sumProduct[3], _mm_mul_ps(dx, dy));
+				sumProduct[4] = _mm_add_ps(sumProduct[4], _mm_mul_ps(dx, dz));
+				sumProduct[5] = _mm_add_ps(sumProduct[5], _mm_mul_ps(dy, dz));
+			}
+		}
+
+		// Lane 4개를 하나로
+		FirstPassResult result;
+		for (int a = 0; a < 3; a++)
+		{
+			float values[4];
+			uint32_t indices[4];
+
+			_mm_storeu_ps(values, minValue[a]);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(indices), minIndex[a]);
+			result.minValue[a] = values[0];
+			result.minIndex[a] = indices[0];
+			for (int k = 1; k < 4; k++)
+			{
+				if (values[k] < result.minValue[a])
+				{
+					result.minValue[a] = values[k];
+					result.minIndex[a] = indices[k];
+				}
+			}
+
+			_mm_storeu_ps(values, maxValue[a]);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(indices), maxIndex[a]);
+			result.maxValue[a] = values[0];
+			result.maxIndex[a] = indices[0];
+			for (int k = 1; k < 4; k++)
+			{
+				if (values[k] > result.maxValue[a])
+				{
+					result.maxValue[a] = values[k];
+					result.maxIndex[a] = indices[k];
+				}
+			}
+		}
+
+		for (int s = 0; s < 9; s++)
+		{
+			float values[4];
+			_mm_storeu_ps(values, (s < 3) ? sum[s] : sumProduct[s - 3]);
+			const double total = double(values[0]) + double(values[1]) + double(values[2]) + double(values[3]);
+			if (s < 3)
+			{
+				result.sum[s] = total;
+			}
+			else
+			{
+				result.sumProduct[s - 3] = total;
+			}
+		}
+
+		return result;
+	}
+
+	SecondPassResult SecondPass(const Vertex *vertices, const size_t begin, const size_t end,
+								const BoundingSphere &initialSphere, const Vector3 axes[3],
+								const bool computeProjection)
+	{
+		Vector3 center = initialSphere.Center;
+		float radius = initialSphere.Radius;
+
+		__m128 centerX = _mm_set1_ps(center.x);
+		__m128 centerY = _mm_set1_ps(center.y);
+		__m128 centerZ = _mm_set1_ps(center.z);
+		__m128 radiusSq = _mm_set1_ps(radius * radius);
+
+		__m128 minProjection[3], maxProjection[3];
+		for (int a = 0; a < 3; a++)
+		{
+			minProjection[a] = _mm_set1_ps(FLT_MAX);
+			maxProjection[a] = _mm_set1_ps(-FLT_MAX);
+		}
+
+		for (size_t i = begin; i < end; i += 4)
+		{
+			__m128 x, y, z, valid;
+			LoadPositions(vertices, i, end, x, y, z, valid);
+
+			const __m128 dx = _mm_sub_ps(x, centerX);
+			const __m128 dy = _mm_sub_ps(y, centerY);
+			const __m128 dz = _mm_sub_ps(z, centerZ);
+			const __m128 distanceSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+												 _mm_mul_ps(dz, dz));
+
+			// 구 밖의 점은 드물어서 그때만 하나씩 구를 키움
+			int outside = _mm_movemask_ps(_mm_cmpgt_ps(distanceSq, radiusSq));
+			if (outside)
+			{
+				float xs[4], ys[4], zs[4];
+				_mm_storeu_ps(xs, x);
+				_mm_storeu_ps(ys, y);
+				_mm_storeu_ps(zs, z);
+
+				for (int k = 0; k < 4; k++)
+				{
+					if (outside & (1 << k))
+					{
+						const Vector3 p(xs[k], ys[k], zs[k]);
+						const float distance = (p - center).Length();
+						if (distance > radius)
+						{
+							const float newRadius = (radius + distance) * 0.5f;
+							center += (p - center) * ((newRadius - radius) / distance);
+							radius = newRadius;
+						}
+					}
+				}
+
+				centerX = _mm_set1_ps(center.x);
+				centerY = _mm_set1_ps(center.y);
+				centerZ = _mm_set1_ps(center.z);
+				radiusSq = _mm_set1_ps(radius * radius);
+			}
+
+			if (computeProjection)
+			{
+				for (int a = 0; a < 3; a++)
+				{
+					const __m128 projection = _mm_add_ps(
+						_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(axes[a].x)), _mm_mul_ps(y, _mm_set1_ps(axes[a].y))),
+						_mm_mul_ps(z, _mm_set1_ps(axes[a].z)));
+					minProjection[a] = _mm_min_ps(minProjection[a], projection);
+					maxProjection[a] = _mm_max_ps(maxProjection[a], projection);
+				}
+			}
+		}
+
+		SecondPassResult result;
+		result.sphere = BoundingSphere(center, radius);
+		for (int a = 0; a < 3; a++)
+		{
+			float mins[4], maxs[4];
+			_mm_storeu_ps(mins, minProjection[a]);
+			_mm_storeu_ps(maxs, maxProjection[a]);
+			result.minProjection[a] = min(min(mins[0], mins[1]), min(mins[2], mins[3]));
+			result.maxProjection[a] = max(max(maxs[0], maxs[1]), max(maxs[2], maxs[3]));
+		}
+
+		return result;
+	}
+
+	// 3x3 대칭 행렬의 고유 벡터 (Jacobi 회전), 열이 고유 벡터
+	void ComputeEigenvectors(double a[3][3], double v[3][3])
+	{
+		for (int r = 0; r < 3; r++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				v[r][c] = (r == c) ? 1.0 : 0.0;
+			}
+		}
+
+		const int pairs[3][2] = { { 0, 1 }, { 0, 2 }, { 1, 2 } };
+		for (int sweep = 0; sweep < 16; sweep++)
+		{
+			const double offDiagonal = abs(a[0][1]) + abs(a[0][2]) + abs(a[1][2]);
+			const double diagonal = abs(a[0][0]) + abs(a[1][1]) + abs(a[2][2]);
+			if (offDiagonal <= diagonal * 1e-12)
+			{
+				break;
+			}
+
+			for (const auto& pair : pairs)
+			{
+				const int p = pair[0];
+				const int q = pair[1];
+				if (a[p][q] == 0.0)
+				{
+					continue;
+				}
+
+				const double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+				const double t = ((theta >= 0.0) ? 1.0 : -1.0) / (abs(theta) + sqrt(theta * theta + 1.0));
+				const double c = 1.0 / sqrt(t * t + 1.0);
+				const double s = t * c;
+
+				for (int k = 0; k < 3; k++)
+				{
+					const double akp = a[k][p];
+					const double akq = a[k][q];
+					a[k][p] = c * akp - s * akq;
+					a[k][q] = s * akp + c * akq;
+				}
+				for (int k = 0; k < 3; k++)
+				{
+					const double apk = a[p][k];
+					const double aqk = a[q][k];
+					a[p][k] = c * apk - s * aqk;
+					a[q][k] = s * apk + c * aqk;
+				}
+				for (int k = 0; k < 3; k++)
+				{
+					const double vkp = v[k][p];
+					const double vkq = v[k][q];
+					v[k][p] = c * vkp - s * vkq;
+					v[k][q] = s * vkp + c * vkq;
+				}
+			}
+		}
+	}
+
+	// 공분산의 고유 벡터를 오른손 좌표축으로 (Quaternion으로 바꿀 수 있도록)
+	void ComputePrincipalAxes(const FirstPassResult &stats, const size_t count, Vector3 axes[3])
+	{
+		const double n = double(count);
+		const double mean[3] = { stats.sum[0] / n, stats.sum[1] / n, stats.sum[2] / n };
+
+		double covariance[3][3];
+		covariance[0][0] = stats.sumProduct[0] / n - mean[0] * mean[0];
+		covariance[1][1] = stats.sumProduct[1] / n - mean[1] * mean[1];
+		covariance[2][2] = stats.sumProduct[2] / n - mean[2] * mean[2];
+		covariance[0][1] = covariance[1][0] = stats.sumProduct[3] / n - mean[0] * mean[1];
+		covariance[0][2] = covariance[2][0] = stats.sumProduct[4] / n - mean[0] * mean[2];
+		covariance[1][2] = covariance[2][1] = stats.sumProduct[5] / n - mean[1] * mean[2];
+
+		double eigenvectors[3][3];
+		ComputeEigenvectors(covariance, eigenvectors);
+
+		axes[0] = Vector3(float(eigenvectors[0][0]), float(eigenvectors[1][0]), float(eigenvectors[2][0]));
+		axes[1] = Vector3(float(eigenvectors[0][1]), float(eigenvectors[1][1]), float(eigenvectors[2][1]));
+		axes[0].Normalize();
+		axes[1] -= axes[0] * axes[0].Dot(axes[1]);
+		axes[1].Normalize();
+		axes[2] = axes[0].Cross(axes[1]);
+	}
+
+	// count가 크면 BLOCK_SIZE 단위로 나눠서 병렬 실행, 결과는 블록 순서대로
+	template <typename T_RESULT, typename T_FUNC>
+	vector<T_RESULT> RunBlocks(const size_t count, T_FUNC func)
+	{
+		const size_t numBlocks = max((count + BLOCK_SIZE - 1) / BLOCK_SIZE, size_t(1));
+		vector<T_RESULT> results(numBlocks);
+		if (numBlocks == 1)
+		{
+			results[0] = func(size_t(0), count);
+			return results;
+		}
+
+		ThreadPool::GetInstance().ParallelFor(0, numBlocks, [&](size_t block) {
+			results[block] = func(block * BLOCK_SIZE, min((block + 1) * BLOCK_SIZE, count));
+		});
+
+		return results;
+	}
+}
+
+MeshBounds BoundsCalculator::Compute(const Vertex* vertices, const size_t vertexCount,
+									 const bool computeOrientedBox)
+{
+	MeshBounds bounds;
+	bounds.isValid = true;
+	if (vertexCount == 0)
+	{
+		bounds.box = BoundingBox(Vector3(0.0f), Vector3(0.0f));
+		bounds.sphere = BoundingSphere(Vector3(0.0f), 0.0f);
+		BoundingOrientedBox::CreateFromBoundingBox(bounds.orientedBox, bounds.box);
+		return bounds;
+	}
+
+	// 1. AABB, 축별 양 끝 Vertex, 공분산
+	const Vector3 origin = vertices[0].position;
+	const vector<FirstPassResult> firstResults = RunBlocks<FirstPassResult>(vertexCount, [&](size_t begin, size_t end) {
+		return FirstPass(vertices, begin, end, origin, computeOrientedBox);
+	});
+
+	FirstPassResult stats = firstResults[0];
+	for (size_t b = 1; b < firstResults.size(); b++)
+	{
+		const FirstPassResult& block = firstResults[b];
+		for (int a = 0; a < 3; a++)
+		{
+			if (block.minValue[a] < stats.minValue[a])
+			{
+				stats.minValue[a] = block.minValue[a];
+				stats.minIndex[a] = block.minIndex[a];
+			}
+			if (block.maxValue[a] > stats.maxValue[a])
+			{
+				stats.maxValue[a] = block.maxValue[a];
+				stats.maxIndex[a] = block.maxIndex[a];
+			}
+			stats.sum[a] += block.sum[a];
+		}
+		for (int s = 0; s < 6; s++)
+		{
+			stats.sumProduct[s] += block.sumProduct[s];
+		}
+	}
+
+	const Vector3 vmin(stats.minValue[0], stats.minValue[1], stats.minValue[2]);
+	const Vector3 vmax(stats.maxValue[0], stats.maxValue[1], stats.maxValue[2]);
+	BoundingBox::CreateFromPoints(bounds.box, vmin, vmax);
+
+	// Ritter: 가장 멀리 떨어진 축 양 끝 쌍에서 시작
+	int widestAxis = 0;
+	float widestDistanceSq = -1.0f;
+	for (int a = 0; a < 3; a++)
+	{
+		const float distanceSq = Vector3::DistanceSquared(vertices[stats.minIndex[a]].position,
+														  vertices[stats.maxIndex[a]].position);
+		if (distanceSq > widestDistanceSq)
+		{
+			widestDistanceSq = distanceSq;
+			widestAxis = a;
+		}
+	}
+
+	const Vector3& p0 = vertices[stats.minIndex[widestAxis]].position;
+	const Vector3& p1 = vertices[stats.maxIndex[widestAxis]].position;
+	const BoundingSphere initialSphere((p0 + p1) * 0.5f, sqrt(widestDistanceSq) * 0.5f);
+
+	Vector3 axes[3] = { Vector3(1.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f), Vector3(0.0f, 0.0f, 1.0f) };
+	if (computeOrientedBox)
+	{
+		ComputePrincipalAxes(stats, vertexCount, axes);
+	}
+
+	// 2. 구를 키우면서 PCA 축으로 투영한 범위
+	const vector<SecondPassResult> secondResults = RunBlocks<SecondPassResult>(vertexCount, [&](size_t begin, size_t end) {
+		return SecondPass(vertices, begin, end, initialSphere, axes, computeOrientedBox);
+	});
+
+	// 블록마다 따로 키운 구는 모두 처음 구를 포함하므로 합쳐도 크게 늘지 않음
+	bounds.sphere = secondResults[0].sphere;
+	for (size_t b = 1; b < secondResults.size(); b++)
+	{
+		BoundingSphere::CreateMerged(bounds.sphere, bounds.sphere, secondResults[b].sphere);
+	}
+
+	BoundingOrientedBox::CreateFromBoundingBox(bounds.orientedBox, bounds.box);
+	if (computeOrientedBox)
+	{
+		float minProjection[3], maxProjection[3];
+		for (int a = 0; a < 3; a++)
+		{
+			minProjection[a] = secondResults[0].minProjection[a];
+			maxProjection[a] = secondResults[0].maxProjection[a];
+			for (size_t b = 1; b < secondResults.size(); b++)
+			{
+				minProjection[a] = min(minProjection[a], secondResults[b].minProjection[a]);
+				maxProjection[a] = max(maxProjection[a], secondResults[b].maxProjection[a]);
+			}
+		}
+
+		Vector3 center(0.0f);
+		Vector3 extents;
+		for (int a = 0; a < 3; a++)
+		{
+			center += axes[a] * ((minProjection[a] + maxProjection[a]) * 0.5f);
+		}
+		extents = Vector3(maxProjection[0] - minProjection[0], maxProjection[1] - minProjection[1],
+						  maxProjection[2] - minProjection[2]) * 0.5f;
+
+		// PCA 축이 항상 더 좋은 것은 아니므로 부피가 작을 때만 사용
+		const Vector3 boxExtents = bounds.box.Extents;
+		if (extents.x * extents.y * extents.z < boxExtents.x * boxExtents.y * boxExtents.z)
+		{
+			const Matrix rotation(axes[0], axes[1], axes[2]);
+			bounds.orientedBox = BoundingOrientedBox(center, extents, Quaternion::CreateFromRotationMatrix(rotation));
+		}
+	}
+
+	return bounds;
+}
+
+void BoundsCalculator::Compute(std::vector<MeshData>& meshes, const bool computeOrientedBox)
+{
+	ThreadPool::GetInstance().ParallelFor(0, meshes.size(), [&](size_t i) {
+		meshes[i].bounds = Compute(meshes[i].vertices.data(), meshes[i].vertices.size(), computeOrientedBox);
+	});
+}
+
+MeshBounds BoundsCalculator::Merge(const std::vector<MeshBounds>& bounds)
+{
+	MeshBounds result;
+	for (const MeshBounds& b : bounds)
+	{
+		if (!b.isValid)
+		{
+			continue;
+		}
+
+		if (!result.isValid)
+		{
+			result.box = b.box;
+			result.sphere = b.sphere;
+			result.isValid = true;
+			continue;
+		}
+
+		BoundingBox::CreateMerged(result.box, result.box, b.box);
+		BoundingSphere::CreateMerged(result.sphere, result.sphere, b.sphere);
+	}
+
+	// 구를 여러 개 합치면 커지기 쉬우므로 AABB를 감싸는 구가 더 작으면 그것을 사용
+	BoundingSphere boxSphere;
+	BoundingSphere::CreateFromBoundingBox(boxSphere, result.box);
+	if (boxSphere.Radius < result.sphere.Radius)
+	{
+		result.sphere = boxSphere;
+	}
+
+	BoundingOrientedBox::CreateFromBoundingBox(result.orientedBox, result.box);
+
+	return result;
+}
+
+MeshBounds BoundsCalculator::Transform(const MeshBounds& bounds, const float scale,
+									   const DirectX::SimpleMath::Vector3& translation)
+{
+	MeshBounds result;
+	result.isValid = bounds.isValid;
+
+	const XMVECTOR rotation = XMQuaternionIdentity();
+	bounds.box.Transform(result.box, scale, rotation, translation);
+	bounds.sphere.Transform(result.sphere, scale, rotation, translation);
+	bounds.orientedBox.Transform(result.orientedBox, scale, rotation, translation);
+
+	return result;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <DirectXCollision.h>
+#include <directxtk/SimpleMath.h>
+
+#include <vector>
+
+#include "MeshData.h"
+#include "Vertex.h"
+
+// Vertex를 두 번 읽어서 AABB, 경계 구, OBB를 같이 계산 (SSE, 큰 Mesh는 블록 단위 병렬)
+// 1. AABB + 축별 양 끝 Vertex + 공분산 (PCA)
+// 2. 양 끝 Vertex 쌍으로 시작한 구를 키움 (Ritter) + PCA 축으로 투영한 범위
+class BoundsCalculator {
+public:
+	static MeshBounds Compute(const Vertex *vertices, const size_t vertexCount,
+							  const bool computeOrientedBox = true);
+
+	// Mesh 단위로 병렬 (meshes[i].bounds에 저장)
+	static void Compute(std::vector<MeshData> &meshes, const bool computeOrientedBox = true);
+
+	// 여러 Mesh를 합친 경계 (OBB는 합친 AABB와 같음)
+	static MeshBounds Merge(const std::vector<MeshBounds> &bounds);
+
+	// position * scale + translation을 적용한 경계 (정규화 후 다시 읽지 않도록)
+	static MeshBounds Transform(const MeshBounds &bounds, const float scale,
+								const DirectX::SimpleMath::Vector3 &translation);
+};
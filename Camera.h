@@ -9,6 +9,7 @@ public:
 	DirectX::SimpleMath::Matrix GetViewRow();
 	DirectX::SimpleMath::Matrix GetProjRow();
 	DirectX::SimpleMath::Vector3 GetEyePos();
+	float GetFovAngleY() { return m_projFovAngleY; } // Degree
 
 	void UpdateViewDir();
 	void UpdateKeyboard(const float dt, bool const keyPreesed[256]);
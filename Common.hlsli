@@ -71,16 +71,57 @@ struct VertexShaderInput
     float3 posModel : POSITION; //모델 좌표계의 위치 position
     float3 normalModel : NORMAL0; // 모델 좌표계의 normal    
     float2 texcoord : TEXCOORD0;
-    float3 tangentModel : TANGENT0;
+    float4 tangentModel : TANGENT0; // w: Bitangent 부호 (B = cross(N, T) * w)
 };
 
+// Vertex.h의 QuantizedVertex (SNORM, FLOAT16은 Input Assembler에서 float로 변환됨)
+struct QuantizedVertexShaderInput
+{
+    float4 posQuantized : POSITION; // xyz: [-1, 1], Mesh AABB 기준, w: Bitangent 부호
+    float2 normalOct : NORMAL0; // Octahedral
+    float2 texcoord : TEXCOORD0;
+    float2 tangentOct : TANGENT0;
+};
+
+// Mesh마다 다름 (ConstantBuffers.h의 QuantizationConstants)
+cbuffer QuantizationConstants : register(b2)
+{
+    float3 positionOffset;
+    float quantizationDummy1;
+    float3 positionScale;
+    float quantizationDummy2;
+};
+
+float3 DecodeOctahedral(float2 e)
+{
+    float3 n = float3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = saturate(-n.z); // 아래쪽 반구는 접었던 것을 펼침
+    n.xy += (n.xy >= 0.0) ? -t : t;
+    return normalize(n);
+}
+
+float3 DecodePosition(float4 posQuantized)
+{
+    return positionOffset + posQuantized.xyz * positionScale;
+}
+
+VertexShaderInput DecodeVertex(QuantizedVertexShaderInput input)
+{
+    VertexShaderInput output;
+    output.posModel = DecodePosition(input.posQuantized);
+    output.normalModel = DecodeOctahedral(input.normalOct);
+    output.texcoord = input.texcoord;
+    output.tangentModel = float4(DecodeOctahedral(input.tangentOct), input.posQuantized.w < 0.0 ? -1.0 : 1.0);
+    return output;
+}
+
 struct PixelShaderInput
 {
     float4 posProj : SV_POSITION; // Screen position
     float3 posWorld : POSITION; // World position (조명 계산에 사용)
     float3 normalWorld : NORMAL0;
     float2 texcoord : TEXCOORD0;
-    float3 tangentWorld : TANGENT0;
+    float4 tangentWorld : TANGENT0; // w: Bitangent 부호
 };
 
 static const float2 poissonDisk[16] =
@@ -20,6 +20,15 @@ __declspec(align(256)) struct MeshConstants {
 	DirectX::SimpleMath::Vector2 dummy;
 };
 
+// QuantizedVertex의 Position 복원: offset + snorm * scale (Mesh마다 하나)
+// for Vertex Shader
+__declspec(align(256)) struct QuantizationConstants {
+	DirectX::SimpleMath::Vector3 positionOffset = DirectX::SimpleMath::Vector3(0.0f);
+	float dummy1 = 0.0f;
+	DirectX::SimpleMath::Vector3 positionScale = DirectX::SimpleMath::Vector3(1.0f);
+	float dummy2 = 0.0f;
+};
+
 // for Pixel Shader
 __declspec(align(256)) struct MaterialConstants {
 	DirectX::SimpleMath::Vector3 albedoFactor = DirectX::SimpleMath::Vector3(1.0f);
@@ -0,0 +1,28 @@
+#include "CountingResource.h"
+
+using namespace std;
+
+void* CountingResource::do_allocate(size_t bytes, size_t alignment)
+{
+	void* p = m_upstream->allocate(bytes, alignment);
+
+	m_allocationCount++;
+	const size_t current = m_currentBytes += bytes;
+	size_t peak = m_peakBytes;
+	while (current > peak && !m_peakBytes.compare_exchange_weak(peak, current))
+	{
+	}
+
+	return p;
+}
+
+void CountingResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+	m_upstream->deallocate(p, bytes, alignment);
+	m_currentBytes -= bytes;
+}
+
+bool CountingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+	return this == &other;
+}
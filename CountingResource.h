@@ -0,0 +1,30 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+
+// 상위 memory_resource로 가는 할당 횟수와 최대 사용량을 기록 (여러 스레드에서 사용 가능)
+class CountingResource : public std::pmr::memory_resource {
+public:
+	explicit CountingResource(
+		std::pmr::memory_resource *upstream = std::pmr::new_delete_resource())
+		: m_upstream(upstream)
+	{
+	}
+
+	size_t GetAllocationCount() const { return m_allocationCount; }
+	size_t GetCurrentBytes() const { return m_currentBytes; }
+	size_t GetPeakBytes() const { return m_peakBytes; }
+
+private:
+	void *do_allocate(size_t bytes, size_t alignment) override;
+	void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+	bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+private:
+	std::pmr::memory_resource *m_upstream;
+	std::atomic<size_t> m_allocationCount{ 0 };
+	std::atomic<size_t> m_currentBytes{ 0 };
+	std::atomic<size_t> m_peakBytes{ 0 };
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+// StateCache와 MockDeviceContext가 사용하는 D3D11 이름들
+// Windows는 d3d11.h, 그 외(Linux에서 Test)에는 포인터로만 쓰는 Interface 선언과 필요한 상수만
+// (DXGI_FORMAT은 UploadManager처럼 dxgiformat.h, Linux에서는 DirectX-Headers)
+#ifdef _WIN32
+#include <d3d11.h>
+#else
+#include <dxgiformat.h>
+
+#include <cstdint>
+
+typedef uint32_t UINT;
+typedef int32_t INT;
+typedef float FLOAT;
+
+struct ID3D11InputLayout;
+struct ID3D11Buffer;
+struct ID3D11VertexShader;
+struct ID3D11HullShader;
+struct ID3D11DomainShader;
+struct ID3D11GeometryShader;
+struct ID3D11PixelShader;
+struct ID3D11ClassInstance;
+struct ID3D11ShaderResourceView;
+struct ID3D11SamplerState;
+struct ID3D11RasterizerState;
+struct ID3D11BlendState;
+struct ID3D11DepthStencilState;
+struct ID3D11RenderTargetView;
+struct ID3D11DepthStencilView;
+
+// d3dcommon.h와 같은 값
+enum D3D11_PRIMITIVE_TOPOLOGY {
+	D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED = 0,
+	D3D11_PRIMITIVE_TOPOLOGY_POINTLIST = 1,
+	D3D11_PRIMITIVE_TOPOLOGY_LINELIST = 2,
+	D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP = 3,
+	D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST = 4,
+	D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP = 5,
+};
+
+#define D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT (32)
+#define D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT (14)
+#define D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT (128)
+#define D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT (16)
+#endif
@@ -0,0 +1,159 @@
+#include "D3D11UploadDevice.h"
+
+#include <iostream>
+
+using namespace std;
+using Microsoft::WRL::ComPtr;
+
+D3D11UploadDevice::D3D11UploadDevice(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+									 Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context)
+	: m_device(device), m_context(context)
+{
+}
+
+void* D3D11UploadDevice::CreatePage(const UploadPageDesc& desc)
+{
+	ID3D11Resource* page = nullptr;
+
+	if (desc.format == DXGI_FORMAT_UNKNOWN)
+	{
+		D3D11_BUFFER_DESC bufferDesc;
+		ZeroMemory(&bufferDesc, sizeof(bufferDesc));
+		bufferDesc.ByteWidth = desc.width;
+		bufferDesc.Usage = D3D11_USAGE_STAGING;
+		bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+		ComPtr<ID3D11Buffer> buffer;
+		if (SUCCEEDED(m_device->CreateBuffer(&bufferDesc, NULL, buffer.GetAddressOf())))
+		{
+			page = buffer.Detach();
+		}
+	}
+	else
+	{
+		D3D11_TEXTURE2D_DESC texDesc;
+		ZeroMemory(&texDesc, sizeof(texDesc));
+		texDesc.Width = desc.width;
+		texDesc.Height = desc.height;
+		texDesc.MipLevels = 1;
+		texDesc.ArraySize = 1;
+		texDesc.Format = desc.format;
+		texDesc.SampleDesc.Count = 1;
+		texDesc.Usage = D3D11_USAGE_STAGING;
+		texDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+		ComPtr<ID3D11Texture2D> texture;
+		if (SUCCEEDED(m_device->CreateTexture2D(&texDesc, NULL, texture.GetAddressOf())))
+		{
+			page = texture.Detach();
+		}
+	}
+
+	if (!page)
+	{
+		cout << "D3D11UploadDevice::CreatePage() failed." << endl;
+	}
+
+	return page;
+}
+
+void D3D11UploadDevice::DestroyPage(void* page)
+{
+	((ID3D11Resource*)page)->Release();
+}
+
+uint8_t* D3D11UploadDevice::MapPage(void* page, size_t& rowPitch)
+{
+	// UploadManager가 GPU가 다 읽은 Page만 Map하므로 보통 기다리지 않음
+	D3D11_MAPPED_SUBRESOURCE ms;
+	if (FAILED(m_context->Map((ID3D11Resource*)page, 0, D3D11_MAP_WRITE, 0, &ms)))
+	{
+		cout << "D3D11UploadDevice::MapPage() failed." << endl;
+		return nullptr;
+	}
+
+	rowPitch = ms.RowPitch;
+	return (uint8_t*)ms.pData;
+}
+
+void D3D11UploadDevice::UnmapPage(void* page)
+{
+	m_context->Unmap((ID3D11Resource*)page, 0);
+}
+
+void D3D11UploadDevice::Copy(void* page, const UploadCopy& copy)
+{
+	const D3D11_BOX box = { copy.srcX, copy.srcY, 0, copy.srcX + copy.width, copy.srcY + copy.height, 1 };
+	m_context->CopySubresourceRegion(copy.dst, copy.subresource, copy.dstX, copy.dstY, 0,
+									 (ID3D11Resource*)page, 0, &box);
+}
+
+void D3D11UploadDevice::UpdateDirect(const UploadCopy& copy, const uint8_t* data, const size_t rowPitch)
+{
+	D3D11_RESOURCE_DIMENSION dimension;
+	copy.dst->GetType(&dimension);
+
+	// Buffer는 Box를 Byte 단위로
+	const D3D11_BOX box = { copy.dstX, copy.dstY, 0, copy.dstX + copy.width, copy.dstY + copy.height, 1 };
+	m_context->UpdateSubresource(copy.dst, copy.subresource, &box, data,
+								 dimension == D3D11_RESOURCE_DIMENSION_BUFFER ? 0 : UINT(rowPitch), 0);
+}
+
+uint64_t D3D11UploadDevice::Signal()
+{
+	ComPtr<ID3D11Query> query;
+	if (!m_freeQueries.empty())
+	{
+		query = m_freeQueries.back();
+		m_freeQueries.pop_back();
+	}
+	else
+	{
+		D3D11_QUERY_DESC queryDesc = { D3D11_QUERY_EVENT, 0 };
+		if (FAILED(m_device->CreateQuery(&queryDesc, query.GetAddressOf())))
+		{
+			// Query가 없으면 UploadManager::Settings::retireFrames로만 회수
+			return ++m_signaled;
+		}
+	}
+
+	m_context->End(query.Get());
+	m_pending.push_back({ ++m_signaled, query });
+	return m_signaled;
+}
+
+uint64_t D3D11UploadDevice::GetCompletedFence()
+{
+	// 앞에서부터 순서대로 끝남
+	while (!m_pending.empty())
+	{
+		BOOL isDone = FALSE;
+		const HRESULT hr = m_context->GetData(m_pending.front().query.Get(), &isDone, sizeof(isDone),
+											  D3D11_ASYNC_GETDATA_DONOTFLUSH);
+		if (hr != S_OK || !isDone)
+		{
+			break;
+		}
+
+		m_completed = m_pending.front().fence;
+		m_freeQueries.push_back(m_pending.front().query);
+		m_pending.pop_front();
+	}
+
+	return m_completed;
+}
+
+void D3D11UploadDevice::WaitForFence(const uint64_t fence)
+{
+	// 처음 한 번만 Flush해서 명령을 GPU로 보냄
+	bool flushed = false;
+	while (GetCompletedFence() < fence && !m_pending.empty())
+	{
+		if (!flushed)
+		{
+			m_context->Flush();
+			flushed = true;
+		}
+		SwitchToThread();
+	}
+}
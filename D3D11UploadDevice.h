@@ -0,0 +1,47 @@
+#pragma once
+
+#include <d3d11.h>
+#include <wrl/client.h>
+
+#include <deque>
+#include <vector>
+
+#include "UploadManager.h"
+
+// UploadManager가 사용하는 D3D11 구현
+// Page는 STAGING Texture/Buffer, Fence는 Event Query
+class D3D11UploadDevice : public UploadDevice {
+public:
+	D3D11UploadDevice(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+					  Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context);
+
+	void *CreatePage(const UploadPageDesc &desc) override;
+	void DestroyPage(void *page) override;
+
+	uint8_t *MapPage(void *page, size_t &rowPitch) override;
+	void UnmapPage(void *page) override;
+
+	void Copy(void *page, const UploadCopy &copy) override;
+	void UpdateDirect(const UploadCopy &copy, const uint8_t *data, const size_t rowPitch) override;
+
+	void AddRef(ID3D11Resource *resource) override { resource->AddRef(); }
+	void Release(ID3D11Resource *resource) override { resource->Release(); }
+
+	uint64_t Signal() override;
+	uint64_t GetCompletedFence() override;
+	void WaitForFence(const uint64_t fence) override;
+
+private:
+	struct PendingQuery {
+		uint64_t fence;
+		Microsoft::WRL::ComPtr<ID3D11Query> query;
+	};
+
+	Microsoft::WRL::ComPtr<ID3D11Device> m_device;
+	Microsoft::WRL::ComPtr<ID3D11DeviceContext> m_context;
+
+	std::deque<PendingQuery> m_pending;
+	std::vector<Microsoft::WRL::ComPtr<ID3D11Query>> m_freeQueries; // 끝난 Query는 다시 사용
+	uint64_t m_signaled = 0;
+	uint64_t m_completed = 0;
+};
@@ -2,18 +2,14 @@
 
 #include "D3D11Utils.h"
 
-#include <DirectXTexEXR.h> // Read .exr
 #include <directxtk/DDSTextureLoader.h> // Read CupeMap
 #include <dxgi.h>
 #include <dxgi1_4.h>
-#include <fp16.h>
 
 #include <iostream>
 #include <algorithm>
 
-#define STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_WRITE_IMPLEMENTATION
-#include "stb_image.h"
 #include "stb_image_write.h"
 
 using namespace std;
@@ -150,198 +146,158 @@ void D3D11Utils::CreatePixelShader(Microsoft::WRL::ComPtr<ID3D11Device>& device,
 							   NULL, &pixelShader);
 }
 
-void D3D11Utils::CreateIndexBuffer(Microsoft::WRL::ComPtr<ID3D11Device>& device,
-								   const std::vector<uint32_t>& indices,
-								   Microsoft::WRL::ComPtr<ID3D11Buffer>& indexBuffer)
-{
-	D3D11_BUFFER_DESC bufferDesc;
-	ZeroMemory(&bufferDesc, sizeof(bufferDesc));
-	bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
-	bufferDesc.ByteWidth = UINT(sizeof(uint32_t) * indices.size());
-	bufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
-	bufferDesc.CPUAccessFlags = 0;
-	bufferDesc.StructureByteStride = sizeof(uint32_t);
-
-	D3D11_SUBRESOURCE_DATA indexBufferData = { 0 };
-	indexBufferData.pSysMem = indices.data();
-	indexBufferData.SysMemPitch = 0;
-	indexBufferData.SysMemSlicePitch = 0;
-
-	device->CreateBuffer(&bufferDesc, &indexBufferData,
-						 indexBuffer.GetAddressOf());
+namespace {
+	UploadManager* g_uploadManager = nullptr;
 }
 
-void ReadEXRImage(const std::string fileName, std::vector<uint8_t>& image,
-				  int& width, int& height, DXGI_FORMAT& pixelFormat)
+void D3D11Utils::SetUploadManager(UploadManager* uploadManager)
 {
-	const std::wstring wFilename(fileName.begin(), fileName.end());
-
-	TexMetadata metadata;
-	ThrowIfFailed(GetMetadataFromEXRFile(wFilename.c_str(), metadata));
-
-	ScratchImage scratchImage;
-	ThrowIfFailed(LoadFromEXRFile(wFilename.c_str(), NULL, scratchImage));
-
-	width = static_cast<int>(metadata.width);
-	height = static_cast<int>(metadata.height);
-	pixelFormat = metadata.format;
-
-	cout << fileName << " " << metadata.width << " " << metadata.height
-		<< metadata.format << endl;
-
-	image.resize(scratchImage.GetPixelsSize());
-	memcpy(image.data(), scratchImage.GetPixels(), image.size()); // image에 처리한 scratchImage를 저장
-
-	// Debug용 데이터 범위 확인해보기
-	vector<float> f32(image.size() / 2);
-	uint16_t* f16 = (uint16_t*)image.data(); // image의 data(8bit)를 16bit씩 처리
-	for (int i = 0; i < image.size() / 2; i++) {
-		f32[i] = fp16_ieee_to_fp32_value(f16[i]); 
-	}
-
-	const float minValue = *std::min_element(f32.begin(), f32.end());
-	const float maxValue = *std::max_element(f32.begin(), f32.end());
-
-	cout << minValue << " " << maxValue << endl;
+	g_uploadManager = uploadManager;
 }
 
-void ReadImage(const std::string filename, std::vector<uint8_t>& image,
-			   int& width, int& height)
+UploadManager* D3D11Utils::GetUploadManager()
 {
-	int channels;
+	return g_uploadManager;
+}
 
-	unsigned char* img =
-		stbi_load(filename.c_str(), &width, &height, &channels, 0);
+HRESULT D3D11Utils::CreateBufferWithData(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+										 D3D11_BUFFER_DESC& bufferDesc, const void* data,
+										 Microsoft::WRL::ComPtr<ID3D11Buffer>& buffer)
+{
+	if (!g_uploadManager)
+	{
+		D3D11_SUBRESOURCE_DATA initData = { 0 };
+		initData.pSysMem = data;
+		initData.SysMemPitch = 0;
+		initData.SysMemSlicePitch = 0;
 
-	cout << filename << " " << width << " " << height << " " << channels
-		<< endl;
+		return device->CreateBuffer(&bufferDesc, &initData, buffer.GetAddressOf());
+	}
 
-	// 4채널로 만들어서 복사
-	image.resize(width * height * 4);
+	// IMMUTABLE은 복사 대상이 될 수 없음
+	bufferDesc.Usage = D3D11_USAGE_DEFAULT;
 
-	if (channels == 1) {
-		for (size_t i = 0; i < width * height; i++) {
-			uint8_t g = img[i * channels + 0];
-			for (size_t c = 0; c < 4; c++) {
-				image[4 * i + c] = g;
-			}
-		}
-	}
-	else if (channels == 2) {
-		for (size_t i = 0; i < width * height; i++) {
-			for (size_t c = 0; c < 2; c++) {
-				image[4 * i + c] = img[i * channels + c];
-			}
-			image[4 * i + 2] = 255;
-			image[4 * i + 3] = 255;
-		}
-	}
-	else if (channels == 3) {
-		for (size_t i = 0; i < width * height; i++) {
-			for (size_t c = 0; c < 3; c++) {
-				image[4 * i + c] = img[i * channels + c];
-			}
-			image[4 * i + 3] = 255;
-		}
-	}
-	else if (channels == 4) {
-		for (size_t i = 0; i < width * height; i++) {
-			for (size_t c = 0; c < 4; c++) {
-				image[4 * i + c] = img[i * channels + c];
-			}
-		}
-	}
-	else {
-		std::cout << "Cannot read " << channels << " channels" << endl;
+	const HRESULT hr = device->CreateBuffer(&bufferDesc, NULL, buffer.GetAddressOf());
+	if (SUCCEEDED(hr))
+	{
+		g_uploadManager->UploadBuffer(buffer.Get(), data, bufferDesc.ByteWidth);
 	}
-
-	delete[] img;
+	return hr;
 }
 
-ComPtr<ID3D11Texture2D> CreateStagingTexture(ComPtr<ID3D11Device>& device,
-											 ComPtr<ID3D11DeviceContext>& context,
-											 const int width, const int height,
-											 const vector<uint8_t>& image,
-											 const DXGI_FORMAT pixelFormat = DXGI_FORMAT_R8G8B8A8_UNORM,
-											 const int mipLevels = 1, const int arraySize = 1)
+// image의 Mip들(없으면 Mip 0)을 texture의 arraySlice로 복사
+// UploadManager를 사용하면 GPU에는 Flush() 이후에 반영됨
+void UploadImage(ComPtr<ID3D11DeviceContext>& context,
+				 ComPtr<ID3D11Texture2D>& texture,
+				 const UINT arraySlice,
+				 const ImageData& image)
 {
+	// MipLevels = 0으로 만든 Texture도 실제 Mip 개수
 	D3D11_TEXTURE2D_DESC texDesc;
-	ZeroMemory(&texDesc, sizeof(texDesc));
-	texDesc.Width = width;
-	texDesc.Height = height;
-	texDesc.MipLevels = mipLevels;
-	texDesc.ArraySize = arraySize;
-	texDesc.Format = pixelFormat;
-	texDesc.SampleDesc.Count = 1;
-	texDesc.Usage = D3D11_USAGE_STAGING;
-	texDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE | D3D11_CPU_ACCESS_READ;
+	texture->GetDesc(&texDesc);
 
-	ComPtr<ID3D11Texture2D> stagingTexture;
-	if (FAILED(device->CreateTexture2D(&texDesc, NULL, stagingTexture.GetAddressOf())))
+	if (g_uploadManager)
 	{
-		cout << "Failed()\n";
+		g_uploadManager->UploadTexture(texture.Get(), texDesc.MipLevels, arraySlice, image);
+		return;
 	}
 
-	// CPU에서 이미지 데이터 복사
-	size_t pixelSize = sizeof(uint8_t) * 4;
-	if (pixelFormat == DXGI_FORMAT_R16G16B16A16_FLOAT)
+	for (int mip = 0; mip < max(image.mipLevels, 1); mip++)
 	{
-		pixelSize = sizeof(uint16_t) * 4;
+		context->UpdateSubresource(texture.Get(), D3D11CalcSubresource(UINT(mip), arraySlice, texDesc.MipLevels),
+								   NULL, image.pixels.data() + image.GetMipOffset(mip),
+								   UINT(image.GetRowPitch(mip)), 0);
 	}
-
-	D3D11_MAPPED_SUBRESOURCE ms;
-	context->Map(stagingTexture.Get(), NULL, D3D11_MAP_WRITE, NULL, &ms);
-	uint8_t *pData = (uint8_t *)ms.pData;
-	for (UINT h = 0; h < UINT(height); h++) // 가로로 한 줄씩 복사
-	{
-		memcpy(&pData[h * ms.RowPitch],
-			   &image[h * width * pixelSize],
-			   width * pixelSize);
-	}
-	context->Unmap(stagingTexture.Get(), NULL);
-
-	return stagingTexture;
 }
 
 void CreateTextureHelper(ComPtr<ID3D11Device>& device,
 						 ComPtr<ID3D11DeviceContext>& context,
-						 const int width, const int height,
-						 const vector<uint8_t>& image,
-						 const DXGI_FORMAT pixelFormat,
+						 const ImageData& image,
 						 ComPtr<ID3D11Texture2D>& texture,
 						 ComPtr<ID3D11ShaderResourceView>& srv)
 {
-	// Staging Texture를 만들고 CPU에서 이미지를 복사
-	ComPtr<ID3D11Texture2D> stagingTexture = CreateStagingTexture(device, context, width, height, image, pixelFormat);
-
 	// 실제 사용할 texture 설정
 	D3D11_TEXTURE2D_DESC texDesc;
 	ZeroMemory(&texDesc, sizeof(texDesc));
-	texDesc.Width = width;
-	texDesc.Height = height;
+	texDesc.Width = image.width;
+	texDesc.Height = image.height;
 	texDesc.MipLevels = 0; // Mipmap 최대 레벨 사용
 	texDesc.ArraySize = 1;
-	texDesc.Format = pixelFormat;
+	texDesc.Format = image.format;
 	texDesc.SampleDesc.Count = 1;
-	texDesc.Usage = D3D11_USAGE_DEFAULT; // Staging texture로부터 복사해야하기 때문에 Default
+	texDesc.Usage = D3D11_USAGE_DEFAULT; // Staging으로부터 복사해야하기 때문에 Default
 	texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
 	texDesc.MiscFlags = D3D11_RESOURCE_MISC_GENERATE_MIPS; // Mipmap 사용
 	texDesc.CPUAccessFlags = 0; // GPU 내에서 복사하기 때문에 0
 
 	// 초기 데이터 없이(검은색) texture 생성
-	device->CreateTexture2D(&texDesc, NULL, texture.GetAddressOf());
-	
-	// Staging texture로부터 가장 높은 해상도의 texture 복사
-	context->CopySubresourceRegion(texture.Get(), 0, 0, 0, 0,
-								   stagingTexture.Get(), 0, NULL);
+	if (FAILED(device->CreateTexture2D(&texDesc, NULL, texture.GetAddressOf())))
+	{
+		cout << "CreateTextureHelper() failed." << endl;
+		return;
+	}
+
+	// 가장 높은 해상도의 texture 복사
+	UploadImage(context, texture, 0, image);
 
 	// SRV 생성
 	device->CreateShaderResourceView(texture.Get(), 0, srv.GetAddressOf());
 
-	// 해상도를 낮춰가며 Mipmap 생성
+	// 해상도를 낮춰가며 Mipmap 생성 (복사가 먼저 GPU에 가야 함)
+	if (g_uploadManager)
+	{
+		g_uploadManager->Flush();
+	}
 	context->GenerateMips(srv.Get());
 }
 
+// TextureBaker로 Mipmap까지 미리 만든 이미지 (GenerateMips 없이 모든 Mip을 올림)
+bool CreateTextureWithMips(ComPtr<ID3D11Device>& device,
+						   ComPtr<ID3D11DeviceContext>& context,
+						   const ImageData& image,
+						   ComPtr<ID3D11Texture2D>& texture,
+						   ComPtr<ID3D11ShaderResourceView>& srv)
+{
+	vector<D3D11_SUBRESOURCE_DATA> initData(image.mipLevels);
+	for (int mip = 0; mip < image.mipLevels; mip++)
+	{
+		initData[mip].pSysMem = image.pixels.data() + image.GetMipOffset(mip);
+		initData[mip].SysMemPitch = UINT(image.GetRowPitch(mip));
+		initData[mip].SysMemSlicePitch = 0;
+	}
+
+	D3D11_TEXTURE2D_DESC texDesc;
+	ZeroMemory(&texDesc, sizeof(texDesc));
+	texDesc.Width = image.width;
+	texDesc.Height = image.height;
+	texDesc.MipLevels = image.mipLevels;
+	texDesc.ArraySize = 1;
+	texDesc.Format = image.format;
+	texDesc.SampleDesc.Count = 1;
+	texDesc.Usage = D3D11_USAGE_DEFAULT;
+	texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE; // GenerateMips를 안 하므로 Render Target 불필요
+	texDesc.MiscFlags = 0;
+	texDesc.CPUAccessFlags = 0;
+
+	// UploadManager가 있으면 빈 Texture를 만들고 Staging Page로 복사
+	if (FAILED(device->CreateTexture2D(&texDesc, g_uploadManager ? NULL : initData.data(),
+									   texture.ReleaseAndGetAddressOf())) ||
+		FAILED(device->CreateShaderResourceView(texture.Get(), 0, srv.ReleaseAndGetAddressOf())))
+	{
+		cout << "CreateTextureWithMips() failed." << endl;
+		texture.Reset();
+		srv.Reset();
+		return false;
+	}
+
+	if (g_uploadManager)
+	{
+		UploadImage(context, texture, 0, image);
+	}
+
+	return true;
+}
+
 void D3D11Utils::CreateTexture(Microsoft::WRL::ComPtr<ID3D11Device>& device,
 							   Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
 							   const std::string fileName,
@@ -349,79 +305,118 @@ void D3D11Utils::CreateTexture(Microsoft::WRL::ComPtr<ID3D11Device>& device,
 							   Microsoft::WRL::ComPtr<ID3D11Texture2D>& texture,
 							   Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv)
 {
+	ImageData image;
+	ImageLoader::ReadImage(fileName, useSRGB, image);
 
-	int width = 0, height = 0;
-	vector<uint8_t> image;
-	DXGI_FORMAT pixelFormat = useSRGB ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB // SRGB를 붙이면 DirectX 내부적으로
-									  : DXGI_FORMAT_R8G8B8A8_UNORM;	    // HDR과 같은 선상으로 Gamma correction 처리
+	CreateTexture(device, context, image, texture, srv);
+}
 
-	string ext(fileName.end() - 3, fileName.end());
-	std::transform(ext.begin(), ext.end(), ext.begin(), std::tolower); // 확장자 소문자로 변환
-	if (ext == "exr")
+void D3D11Utils::CreateTexture(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+							   Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
+							   const ImageData& image,
+							   Microsoft::WRL::ComPtr<ID3D11Texture2D>& texture,
+							   Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv)
+{
+	if (image.IsEmpty())
 	{
-		ReadEXRImage(fileName, image, width, height, pixelFormat);
+		cout << "CreateTexture() image is empty." << endl;
+		return;
 	}
-	else
+
+	if (image.HasMips())
 	{
-		ReadImage(fileName, image, width, height);
+		CreateTextureWithMips(device, context, image, texture, srv);
+		return;
 	}
 
-	CreateTextureHelper(device, context, width, height, image, pixelFormat, texture, srv);
+	CreateTextureHelper(device, context, image, texture, srv);
 }
 
-void D3D11Utils::CreateMetallicRoughnessTexture(Microsoft::WRL::ComPtr<ID3D11Device>& device,
-												Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
-												const std::string metallicFimeName,
-												const std::string roughnessFileName,
-												Microsoft::WRL::ComPtr<ID3D11Texture2D>& texture,
-												Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv)
+void D3D11Utils::CreateTextures(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+								Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
+								const std::vector<const ImageData*>& images,
+								std::vector<Microsoft::WRL::ComPtr<ID3D11Texture2D>>& textures,
+								std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>>& srvs)
 {
-	if (!metallicFimeName.empty() && (metallicFimeName == roughnessFileName))
-	{
-		CreateTexture(device, context, metallicFimeName, false, texture, srv);
-	}
-	else
+	textures.assign(images.size(), nullptr);
+	srvs.assign(images.size(), nullptr);
+
+	// CreateTextureHelper()와 같은 설정, 초기 데이터 없이 생성
+	for (size_t i = 0; i < images.size(); i++)
 	{
-		int mWidth = 0, mHeight = 0;
-		int rWidth = 0, rHeight = 0;
-		vector<uint8_t> mImage;
-		vector<uint8_t> rImage;
+		const ImageData& image = *images[i];
+		if (image.IsEmpty())
+		{
+			cout << "CreateTextures() image is empty." << endl;
+			continue;
+		}
 
-		if (!metallicFimeName.empty())
+		// 미리 만든 Mipmap은 초기 데이터로 바로 올림
+		if (image.HasMips())
 		{
-			ReadImage(metallicFimeName, mImage, mWidth, mHeight);
+			CreateTextureWithMips(device, context, image, textures[i], srvs[i]);
+			continue;
 		}
-		if (!roughnessFileName.empty())
+
+		D3D11_TEXTURE2D_DESC texDesc;
+		ZeroMemory(&texDesc, sizeof(texDesc));
+		texDesc.Width = image.width;
+		texDesc.Height = image.height;
+		texDesc.MipLevels = 0;
+		texDesc.ArraySize = 1;
+		texDesc.Format = image.format;
+		texDesc.SampleDesc.Count = 1;
+		texDesc.Usage = D3D11_USAGE_DEFAULT;
+		texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+		texDesc.MiscFlags = D3D11_RESOURCE_MISC_GENERATE_MIPS;
+		texDesc.CPUAccessFlags = 0;
+
+		if (FAILED(device->CreateTexture2D(&texDesc, NULL, textures[i].GetAddressOf())) ||
+			FAILED(device->CreateShaderResourceView(textures[i].Get(), 0, srvs[i].GetAddressOf())))
 		{
-			ReadImage(roughnessFileName, rImage, rWidth, rHeight);
+			cout << "CreateTextures() failed." << endl;
+			textures[i].Reset();
+			srvs[i].Reset();
 		}
+	}
 
-		// MetallicTexture와 RoughnessTexture의 해상도가 같다고 가정
-		if (!metallicFimeName.empty() && !roughnessFileName.empty())
+	// 가장 높은 해상도만 복사 (UploadManager가 있으면 한 번의 Flush로)
+	for (size_t i = 0; i < images.size(); i++)
+	{
+		if (textures[i] && !images[i]->HasMips())
 		{
-			assert(mWidth == rWidth);
-			assert(mHeight == rHeight);
+			UploadImage(context, textures[i], 0, *images[i]);
 		}
+	}
 
-		vector<uint8_t> combinedImage(size_t(mWidth * mHeight) * 4);
-		fill(combinedImage.begin(), combinedImage.end(), 0);
+	if (g_uploadManager)
+	{
+		g_uploadManager->Flush();
+	}
 
-		for (size_t i = 0; i < size_t(mWidth * mHeight); i++)
+	// 해상도를 낮춰가며 Mipmap 생성
+	for (size_t i = 0; i < images.size(); i++)
+	{
+		if (srvs[i] && !images[i]->HasMips())
 		{
-			if (rImage.size())
-			{
-				combinedImage[4 * i + 1] = rImage[4 * i]; // Green == Roughness
-			}
-			if (mImage.size())
-			{
-				combinedImage[4 * i + 2] = mImage[4 * i]; // Blue == Metallic
-			}
+			context->GenerateMips(srvs[i].Get());
 		}
-
-		CreateTextureHelper(device, context, mWidth, mHeight, combinedImage, DXGI_FORMAT_R8G8B8A8_UNORM, texture, srv);
 	}
 }
 
+void D3D11Utils::CreateORMTexture(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+								  Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
+								  const std::string aoFileName, const std::string roughnessFileName,
+								  const std::string metallicFileName,
+								  Microsoft::WRL::ComPtr<ID3D11Texture2D>& texture,
+								  Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv)
+{
+	ImageData image;
+	ImageLoader::ReadORM(aoFileName, roughnessFileName, metallicFileName, image);
+
+	CreateTexture(device, context, image, texture, srv);
+}
+
 void D3D11Utils::CreateTextureArray(Microsoft::WRL::ComPtr<ID3D11Device>& device,
 									Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
 									const std::vector<std::string> fileNames,
@@ -431,50 +426,54 @@ void D3D11Utils::CreateTextureArray(Microsoft::WRL::ComPtr<ID3D11Device>& device
 	if (fileNames.empty())
 		return;
 
-	int width = 0, height = 0;
-	vector<vector<uint8_t>> imageArray;
-	for (const auto& f : fileNames)
+	vector<ImageData> imageArray(fileNames.size());
+	for (size_t i = 0; i < fileNames.size(); i++)
 	{	
-		vector<uint8_t> image;
-		ReadImage(f, image, width, height);
-
-		imageArray.push_back(image);
+		ImageLoader::ReadSourceImage(fileNames[i], false, imageArray[i]);
 	}
 
+	// 모든 이미지는 첫 번째와 크기와 Format이 같아야 함
+	const ImageData& first = imageArray[0];
 	UINT size = UINT(fileNames.size());
 
 	// Create Texture2DArray
 	D3D11_TEXTURE2D_DESC texDesc;
 	ZeroMemory(&texDesc, sizeof(texDesc));
-	texDesc.Width = UINT(width);
-	texDesc.Height = UINT(height);
+	texDesc.Width = UINT(first.width);
+	texDesc.Height = UINT(first.height);
 	texDesc.MipLevels = 0;
 	texDesc.ArraySize = size; // ArraySize
-	texDesc.Format = DXGI_FORMAT_R8G8_UNORM;
+	texDesc.Format = first.format;
 	texDesc.SampleDesc.Count = 1;
 	texDesc.SampleDesc.Quality = 0;
 	texDesc.Usage = D3D11_USAGE_DEFAULT;
 	texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
 	texDesc.MiscFlags = D3D11_RESOURCE_MISC_GENERATE_MIPS;
 
-	device->CreateTexture2D(&texDesc, NULL, texture.GetAddressOf());
-
-	//texture->GetDesc(&texDesc);
+	if (FAILED(device->CreateTexture2D(&texDesc, NULL, texture.GetAddressOf())))
+	{
+		cout << "CreateTextureArray() failed." << endl;
+		return;
+	}
 
-	// Staging texture를 만들어서 하나씩 복사
+	// 각 Slice의 Mip 0에 복사 (Subresource는 실제 Mip 개수로 계산)
 	for (size_t i = 0; i < imageArray.size(); i++)
 	{
-		vector<uint8_t>& image = imageArray[i];
-		
-		ComPtr<ID3D11Texture2D> stagingTexture = CreateStagingTexture(device, context, width, height, image, texDesc.Format, 1, 1);
-
-		UINT subresourceIndex = D3D11CalcSubresource(0, UINT(i), texDesc.MipLevels);
+		const ImageData& image = imageArray[i];
+		if (image.width != first.width || image.height != first.height || image.format != first.format)
+		{
+			cout << "CreateTextureArray() size mismatch: " << fileNames[i] << endl;
+			continue;
+		}
 
-		context->CopySubresourceRegion(texture.Get(), subresourceIndex, 0, 0, 0, 
-									   stagingTexture.Get(), 0, NULL);
+		UploadImage(context, texture, UINT(i), image);
 	}
 
 	device->CreateShaderResourceView(texture.Get(), NULL, srv.GetAddressOf());
+	if (g_uploadManager)
+	{
+		g_uploadManager->Flush();
+	}
 	context->GenerateMips(srv.Get());
 }
 
@@ -10,6 +10,10 @@
 #include <windows.h>
 #include <wrl/client.h> // ComPtr
 
+#include "ImageLoader.h"
+#include "UploadManager.h"
+#include "VertexLayout.h"
+
 inline void ThrowIfFailed(HRESULT hr) {
 	if (FAILED(hr)) {
 		throw std::exception();
@@ -18,6 +22,11 @@ inline void ThrowIfFailed(HRESULT hr) {
 
 class D3D11Utils {
 public:
+	// 등록되어 있으면 Vertex/Index Buffer와 Texture 데이터를 Staging Page에 모아서 올림 (AppBase가 등록)
+	// 없으면 예전처럼 초기 데이터/UpdateSubresource
+	static void SetUploadManager(UploadManager *uploadManager);
+	static UploadManager *GetUploadManager();
+
 	static void CreateVertexShaderAndInputLayout(
 		Microsoft::WRL::ComPtr<ID3D11Device> &device, const std::wstring &fileName,
 		const std::vector<D3D11_INPUT_ELEMENT_DESC> &inputElements,
@@ -40,32 +49,76 @@ public:
 								  const std::wstring &fileName,
 								  Microsoft::WRL::ComPtr<ID3D11PixelShader> &pixelShader);
 
+	// T_INDEX는 uint16_t(DXGI_FORMAT_R16_UINT) 또는 uint32_t(DXGI_FORMAT_R32_UINT)
+	template <typename T_INDEX>
+	static void CreateIndexBuffer(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+								  const std::vector<T_INDEX> &indices,
+							      Microsoft::WRL::ComPtr<ID3D11Buffer> &indexBuffer)
+	{
+		CreateIndexBuffer(device, indices.data(), indices.size(), indexBuffer);
+	}
+
+	// mmap된 캐시처럼 vector가 아닌 메모리에서 바로 생성
+	template <typename T_INDEX>
 	static void CreateIndexBuffer(Microsoft::WRL::ComPtr<ID3D11Device> &device,
-								  const std::vector<uint32_t> &indices,
-							      Microsoft::WRL::ComPtr<ID3D11Buffer> &indexBuffer);
+								  const T_INDEX *indices, const size_t indexCount,
+								  Microsoft::WRL::ComPtr<ID3D11Buffer> &indexBuffer)
+	{
+		static_assert(sizeof(T_INDEX) == 2 || sizeof(T_INDEX) == 4, "Index must be 16 or 32 bit");
+
+		D3D11_BUFFER_DESC bufferDesc;
+		ZeroMemory(&bufferDesc, sizeof(bufferDesc));
+		bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+		bufferDesc.ByteWidth = UINT(sizeof(T_INDEX) * indexCount);
+		bufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+		bufferDesc.CPUAccessFlags = 0;
+		bufferDesc.StructureByteStride = sizeof(T_INDEX);
+
+		CreateBufferWithData(device, bufferDesc, indices, indexBuffer);
+	}
+
+	// CreateVertexBuffer<T_VERTEX>로 만든 버퍼에 맞는 Input Layout (VertexLayout.h)
+	template <typename T_VERTEX>
+	static std::vector<D3D11_INPUT_ELEMENT_DESC> GetInputElements()
+	{
+		std::vector<D3D11_INPUT_ELEMENT_DESC> inputElements;
+		for (const VertexElement &element : VertexLayout<T_VERTEX>::elements)
+		{
+			inputElements.push_back({ element.semanticName, 0, element.format, 0, element.offset,
+									  D3D11_INPUT_PER_VERTEX_DATA, 0 });
+		}
+		return inputElements;
+	}
 
 	template <typename T_VERTEX>
 	static void CreateVertexBuffer(Microsoft::WRL::ComPtr<ID3D11Device> &device,
 								   const std::vector<T_VERTEX> &vertices,
 								   Microsoft::WRL::ComPtr<ID3D11Buffer> &vertexBuffer)
+	{
+		CreateVertexBuffer(device, vertices.data(), vertices.size(), vertexBuffer);
+	}
+
+	template <typename T_VERTEX>
+	static void CreateVertexBuffer(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+								   const T_VERTEX *vertices, const size_t vertexCount,
+								   Microsoft::WRL::ComPtr<ID3D11Buffer> &vertexBuffer)
 	{	
 		D3D11_BUFFER_DESC bufferDesc;
 		ZeroMemory(&bufferDesc, sizeof(bufferDesc));
 		bufferDesc.Usage = D3D11_USAGE_IMMUTABLE; // 초기화 이후 변경 X, vertex는 변경 사항 없음
-		bufferDesc.ByteWidth = UINT(sizeof(T_VERTEX) * vertices.size());
+		bufferDesc.ByteWidth = UINT(sizeof(T_VERTEX) * vertexCount);
 		bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
 		bufferDesc.CPUAccessFlags = 0; // No CPU access is necessary
 		bufferDesc.StructureByteStride = sizeof(T_VERTEX);
 
-		D3D11_SUBRESOURCE_DATA vertexBufferData = { 0 };
-		vertexBufferData.pSysMem = vertices.data();
-		vertexBufferData.SysMemPitch = 0;
-		vertexBufferData.SysMemSlicePitch = 0;
-
-		ThrowIfFailed(device->CreateBuffer(&bufferDesc, &vertexBufferData,
-										   vertexBuffer.GetAddressOf()));
+		ThrowIfFailed(CreateBufferWithData(device, bufferDesc, vertices, vertexBuffer));
 	}
 
+	// UploadManager가 있으면 IMMUTABLE 대신 DEFAULT로 만들고 Staging Page로 복사
+	static HRESULT CreateBufferWithData(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+										D3D11_BUFFER_DESC &bufferDesc, const void *data,
+										Microsoft::WRL::ComPtr<ID3D11Buffer> &buffer);
+
 	template <typename T_CONSTANT>
 	static void CreateConstBuffer(Microsoft::WRL::ComPtr<ID3D11Device> &device,
 								  const T_CONSTANT &constantBufferData,
@@ -115,12 +168,28 @@ public:
 							  Microsoft::WRL::ComPtr<ID3D11Texture2D> &texture,
 							  Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> &srv);
 
-	static void CreateMetallicRoughnessTexture(Microsoft::WRL::ComPtr<ID3D11Device> &device,
-											   Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
-											   const std::string metallicFimeName,
-											   const std::string roughnessFileName,
-											   Microsoft::WRL::ComPtr<ID3D11Texture2D> &texture,
-											   Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> &srv);
+	// ImageLoader로 미리 읽어둔 이미지로 생성 (Render Thread에서 GPU 작업만)
+	static void CreateTexture(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+							  Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
+							  const ImageData &image,
+							  Microsoft::WRL::ComPtr<ID3D11Texture2D> &texture,
+							  Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> &srv);
+
+	// 여러 이미지를 한꺼번에 생성 (Texture 생성 -> 복사 -> Mipmap 생성을 종류별로 모아서)
+	// 복사는 UploadManager가 있으면 Staging Page로, 없으면 UpdateSubresource로
+	static void CreateTextures(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+							   Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
+							   const std::vector<const ImageData *> &images,
+							   std::vector<Microsoft::WRL::ComPtr<ID3D11Texture2D>> &textures,
+							   std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> &srvs);
+
+	// Red: Occlusion, Green: Roughness, Blue: Metallic (ImageLoader::ReadORM)
+	static void CreateORMTexture(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+								 Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
+								 const std::string aoFileName, const std::string roughnessFileName,
+								 const std::string metallicFileName,
+								 Microsoft::WRL::ComPtr<ID3D11Texture2D> &texture,
+								 Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> &srv);
 
 	static void CreateTextureArray(Microsoft::WRL::ComPtr<ID3D11Device> &device,
 								   Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
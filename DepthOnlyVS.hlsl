@@ -9,8 +9,9 @@ cbuffer MeshConstants : register(b0)
     float2 dummy;
 };
 
-float4 main(VertexShaderInput input) : SV_POSITION
+// Position Stream만 사용 (Vertex.h의 QuantizedPosition)
+float4 main(float4 posQuantized : POSITION) : SV_POSITION
 {
-    float4 pos = mul(float4(input.posModel, 1.0f), world);
+    float4 pos = mul(float4(DecodePosition(posQuantized), 1.0f), world);
     return mul(pos, viewProj);
 }
@@ -7,6 +7,8 @@
 #include <vector>
 
 #include "GraphicsCommon.h"
+#include "Stats.h"
+#include "TextureCache.h"
 
 using namespace std;
 using namespace DirectX;
@@ -16,6 +18,8 @@ ExampleApp::ExampleApp() : AppBase() {}
 
 bool ExampleApp::Initialize()
 {
+	m_startTime = chrono::steady_clock::now();
+
 	if (!AppBase::Initialize())
 	{
 		return false;
@@ -28,7 +32,9 @@ bool ExampleApp::Initialize()
 	// 후처리용 화면 사각형
 	{
 		MeshData meshData = GeometryGenerator::MakeSquare();
-		m_screenSquare = make_shared<Model>(m_device, m_context, vector{ meshData });
+		m_screenSquare = make_shared<Model>();
+		m_screenSquare->m_useQuantizedVertices = false; // samplingIL은 Vertex 그대로 사용
+		m_screenSquare->Initialize(m_device, m_context, vector{ meshData });
 	}
 
 	// Skybox
@@ -59,12 +65,14 @@ bool ExampleApp::Initialize()
 	{
 		/*vector<MeshData> mainMeshes = GeometryGenerator::ReadFromFile("Assets/Models/medieval_vagrant_knights/",
 																	    "scene.gltf", true);*/
-		vector<MeshData> mainMeshes = GeometryGenerator::ReadFromFile("Assets/Models/mechanical_shark/",
-																	  "scene.gltf", true);
 		//vector<MeshData> mainMeshes = { GeometryGenerator::MakeSphere(0.4f, 50, 50) };
 
+		// 파일과 Texture는 Worker Thread에서 읽고, 그동안은 구를 대신 그림
+		// 두 번째 실행부터는 Cooked 캐시(scene.gltf.cmesh)를 사용
+		// 구와 읽은 Model 모두 m_modelRegistry에 두고 공유 (같은 파일을 다시 읽어도 GPU 버퍼는 하나)
 		Vector3 center(0.0f, 0.0f, 2.0f);
-		m_mainObj = make_shared<Model>(m_device, m_context, mainMeshes);
+		shared_ptr<const Model> placeholder = m_modelRegistry.MakeSphere(m_device, m_context, 0.4f, 50, 50);
+		m_mainObj = make_shared<ModelInstance>(m_device, placeholder);
 		m_mainObj->m_materialConstsCPU.invertNoramlMapY = true; // GLTF는 true
 		m_mainObj->m_materialConstsCPU.albedoFactor - Vector3(1.0f);
 		m_mainObj->m_materialConstsCPU.roughnessFactor = 0.3f;
@@ -72,8 +80,30 @@ bool ExampleApp::Initialize()
 		m_mainObj->UpdateWorldRow(Matrix::CreateTranslation(center));
 
 		m_basicList.push_back(m_mainObj);
-		
-		m_mainBoundingSphere = BoundingSphere(center, 0.4f);
+
+		// 이미 GPU에 있는 Texture는 Worker에서 Decoding하지 않음
+		m_modelLoader.m_skipImage = [](const string& key) {
+			return TextureCache::GetInstance().Contains(key);
+		};
+
+		shared_ptr<ModelInstance> mainObj = m_mainObj;
+		m_mainObjLoaded = m_modelRegistry.LoadAsync(
+			m_device, m_context, m_modelLoader, "Assets/Models/mechanical_shark/", "scene.gltf", true, true,
+			[this, mainObj](shared_ptr<const Model> model) {
+				mainObj->SetModel(m_device, m_context, model);
+
+				if (g_printStats)
+				{
+					const chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - m_startTime;
+					cout << "Main model ready: " << elapsed.count() << " ms" << endl;
+
+					const TextureCache& textures = TextureCache::GetInstance();
+					cout << "Texture cache: " << textures.GetHitCount() << " hits, "
+						 << textures.GetMissCount() << " misses (decode: "
+						 << ImageLoader::GetCache().GetHitCount() << " hits, "
+						 << ImageLoader::GetCache().GetMissCount() << " misses)" << endl;
+				}
+			});
 	}
 
 	// Lights
@@ -99,10 +129,11 @@ bool ExampleApp::Initialize()
 
 	// Lights 위치 표시
 	{
+		// 모든 조명이 같은 Vertex/Index Buffer 사용
+		shared_ptr<const Model> sphere = m_modelRegistry.MakeSphere(m_device, m_context, 1.0f, 20, 20);
 		for (int i = 0; i < MAX_LIGHTS; i++)
 		{
-			MeshData sphere = GeometryGenerator::MakeSphere(1.0f, 20, 20);
-			m_lightSphere[i] = make_shared<Model>(m_device, m_context, vector{ sphere });
+			m_lightSphere[i] = make_shared<ModelInstance>(m_device, sphere);
 			m_lightSphere[i]->UpdateWorldRow(Matrix::CreateTranslation(m_globalConstsCPU.lights[i].position));
 			m_lightSphere[i]->m_materialConstsCPU.albedoFactor = Vector3(0.0f);
 			m_lightSphere[i]->m_materialConstsCPU.emissionFactor = Vector3(1.0f, 1.0f, 0.0f);
@@ -119,8 +150,8 @@ bool ExampleApp::Initialize()
 
 	// 마우스 커서 표시
 	{
-		MeshData sphere = GeometryGenerator::MakeSphere(0.01f, 10, 10);
-		m_cursorSphere = make_shared<Model>(m_device, m_context, vector{ sphere });
+		shared_ptr<const Model> sphere = m_modelRegistry.MakeSphere(m_device, m_context, 0.01f, 10, 10);
+		m_cursorSphere = make_shared<ModelInstance>(m_device, sphere);
 		m_cursorSphere->m_isVisible = false; // 마우스 클릭했을 때만 보임
 		m_cursorSphere->m_castShadow = false; // 그림자 X
 		m_cursorSphere->m_materialConstsCPU.albedoFactor = Vector3(0.0f);
@@ -129,6 +160,12 @@ bool ExampleApp::Initialize()
 		m_basicList.push_back(m_cursorSphere);
 	}
 
+	if (g_printStats)
+	{
+		cout << "Model registry: " << m_modelRegistry.GetHitCount() << " hits, "
+			 << m_modelRegistry.GetMissCount() << " misses" << endl;
+	}
+
 	return true;
 }
 
@@ -144,6 +181,37 @@ void ExampleApp::UpdateGUI()
 			CreateBuffers();
 		}
 		ImGui::Checkbox("Perspective Projection", &m_camera.m_usePerspectiveProjection);
+		if (m_modelLoader.GetPendingCount() > 0)
+		{
+			ImGui::Text("Loading Models: %zu", m_modelLoader.GetPendingCount());
+		}
+		ImGui::Text("Depth/Shadow Vertex Fetch: %zu KB (Full Vertex: %zu KB)",
+					m_depthPassFetchBytes / 1024, m_depthPassFetchBytesFull / 1024);
+		const StateCache<ID3D11DeviceContext>::Stats& stateStats = m_stateCache.GetStats();
+		ImGui::Text("Render Queue: %zu draws, State Calls: %zu (%zu redundant dropped, %zu trimmed)",
+					m_queuedDrawCount, stateStats.calls, stateStats.dropped, stateStats.trimmed);
+		ImGui::Text("Frame Allocator: peak %zu KB, %zu heap blocks", m_frameAllocator.GetPeakSize() / 1024,
+					m_frameAllocator.GetBlockAllocCount());
+		ImGui::Checkbox("Frustum Culling", &m_useFrustumCulling);
+		if (m_useFrustumCulling)
+		{
+			ImGui::Text("Visible Boxes: %zu / %zu (Reflection %zu)",
+						m_frustumCuller.GetVisibleCount(m_mainView), m_frustumCuller.GetBoxCount(),
+						m_frustumCuller.GetVisibleCount(m_reflectView));
+		}
+		if (m_pickedModel)
+		{
+			ImGui::Text("Picked: Mesh %u, Triangle %u (u %.2f, v %.2f)", m_pickHit.mesh, m_pickHit.triangle,
+						m_pickHit.u, m_pickHit.v);
+		}
+		ImGui::Checkbox("Meshlet Culling", &m_useMeshletCulling);
+		if (m_useMeshletCulling && m_mainObj->m_totalTriangleCount > 0)
+		{
+			const size_t rejected = m_mainObj->m_totalTriangleCount - m_mainObj->m_visibleTriangleCount;
+			ImGui::Text("Rejected Triangles: %zu / %zu (%.1f%%)", rejected,
+						m_mainObj->m_totalTriangleCount,
+						100.0f * float(rejected) / float(m_mainObj->m_totalTriangleCount));
+		}
 		ImGui::TreePop();
 	}
 
@@ -186,9 +254,24 @@ void ExampleApp::UpdateGUI()
 		flag += ImGui::SliderFloat("Bloom Strength",
 								   &m_postProcess.m_combineFilter.m_constData.strength,
 								   0.0f, 1.0f);
-		flag += ImGui::SliderFloat("Exposure",
-								   &m_postProcess.m_combineFilter.m_constData.option1,
-								   0.0f, 10.0f);
+		ImGui::Checkbox("Auto Exposure", &m_postProcess.m_useAutoExposure);
+		if (m_postProcess.m_useAutoExposure)
+		{
+			AutoExposure& autoExposure = m_postProcess.m_autoExposure;
+			ImGui::Text("Exposure: %.3f (Target %.3f)", autoExposure.GetExposure(),
+						autoExposure.GetTargetExposure(m_postProcess.m_histogram));
+			ImGui::Text("Luminance: %.4f ~ %.2f", m_postProcess.m_histogram.minLuminance,
+						m_postProcess.m_histogram.maxLuminance);
+			ImGui::SliderFloat("Compensation (EV)", &autoExposure.m_compensation, -4.0f, 4.0f);
+			ImGui::SliderFloat("Adapt Speed Up", &autoExposure.m_speedUp, 0.1f, 10.0f);
+			ImGui::SliderFloat("Adapt Speed Down", &autoExposure.m_speedDown, 0.1f, 10.0f);
+		}
+		else
+		{
+			flag += ImGui::SliderFloat("Exposure",
+									   &m_postProcess.m_combineFilter.m_constData.option1,
+									   0.0f, 10.0f);
+		}
 		flag += ImGui::SliderFloat("Gamma",
 								   &m_postProcess.m_combineFilter.m_constData.option2,
 								   0.1f, 5.0f);
@@ -282,6 +365,25 @@ void ExampleApp::UpdateGUI()
 
 void ExampleApp::Update(float dt)
 {
+	// Worker Thread에서 읽기가 끝난 Model의 GPU 자원 생성 (실패하면 Placeholder 유지)
+	m_modelLoader.ProcessCompleted();
+	if (m_mainObjLoaded.valid() &&
+		m_mainObjLoaded.wait_for(chrono::seconds(0)) == future_status::ready)
+	{
+		try
+		{
+			m_mainObjLoaded.get();
+		}
+		catch (const exception& e)
+		{
+			cout << "Failed to load main model: " << e.what() << endl;
+		}
+		m_mainObjLoaded = shared_future<void>();
+	}
+
+	// 이전 Frame들의 HDR 밝기로 Exposure 조절
+	m_postProcess.UpdateExposure(m_device, m_context, dt);
+
 	// Camera 이동
 	m_camera.UpdateKeyboard(dt, m_keyPressed);
 
@@ -309,18 +411,34 @@ void ExampleApp::Update(float dt)
 	// 마우스 이동/회전 반영
 	if (m_leftButton || m_rightButton)
 	{
+		// 드래그를 시작할 때 커서 아래의 Model 선택 (없으면 다음 Frame에 다시)
+		if (m_dragStartFlag)
+		{
+			PickModel();
+		}
+
 		Quaternion q;
 		Vector3 dragTranslation;
 		Vector3 pickPoint;
 
-		if (UpdateMouseControl(m_mainBoundingSphere, q, dragTranslation, pickPoint))
+		if (m_pickedModel &&
+			UpdateMouseControl(m_pickedModel->GetWorldBoundingSphere(), q, dragTranslation, pickPoint))
 		{
-			Vector3 translation = m_mainObj->m_worldRow.Translation();
-			m_mainObj->m_worldRow.Translation(Vector3(0.0f));
-			m_mainObj->UpdateWorldRow(m_mainObj->m_worldRow *
-									  Matrix::CreateFromQuaternion(q) *
-									  Matrix::CreateTranslation(dragTranslation + translation));
-			m_mainBoundingSphere.Center = m_mainObj->m_worldRow.Translation();
+			Vector3 translation = m_pickedModel->m_worldRow.Translation();
+			m_pickedModel->m_worldRow.Translation(Vector3(0.0f));
+			m_pickedModel->UpdateWorldRow(m_pickedModel->m_worldRow *
+										  Matrix::CreateFromQuaternion(q) *
+										  Matrix::CreateTranslation(dragTranslation + translation));
+
+			// 커서가 표면 위에 있으면 그 지점, 아니면 경계 구 위의 지점
+			const Ray ray = GetPickingRay();
+			const Matrix worldToModel = m_pickedModel->m_worldRow.Invert();
+			RayHit hit;
+			if (m_pickedModel->IntersectRay(Vector3::Transform(ray.position, worldToModel),
+											Vector3::TransformNormal(ray.direction, worldToModel), hit))
+			{
+				pickPoint = ray.position + hit.distance * ray.direction;
+			}
 
 			// 충돌 지점에 작은 구 그리기
 			m_cursorSphere->m_isVisible = true;
@@ -340,6 +458,181 @@ void ExampleApp::Update(float dt)
 	{
 		i->UpdateConstantBuffers(m_device, m_context);
 	}
+
+	// 화면에서 1픽셀 이하로 보이는 오차의 LOD 선택
+	for (shared_ptr<Model>& i : m_basicList)
+	{
+		i->UpdateLod(eyeWorld, XMConvertToRadians(m_camera.GetFovAngleY()), float(m_screenHeight));
+	}
+
+	if (m_useMeshletCulling)
+	{
+		for (shared_ptr<Model>& i : m_basicList)
+		{
+			i->UpdateVisibleMeshlets(viewRow, projRow, eyeWorld);
+		}
+	}
+
+	UpdateFrustumCulling(viewRow, projRow, reflectRow);
+	UpdateRenderQueue(viewRow, reflectRow);
+}
+
+void ExampleApp::PickModel()
+{
+	// 조명과 커서 위치 표시용 구는 고르지 않음
+	auto isCandidate = [&](const shared_ptr<Model>& model) {
+		const bool isMarker = model == m_cursorSphere ||
+							  find(begin(m_lightSphere), end(m_lightSphere), model) != end(m_lightSphere);
+		return model->m_isVisible && !isMarker;
+	};
+
+	ArrayView<const Model*> models = m_frameAllocator.AllocateArray<const Model*>(m_basicList.size());
+	size_t modelCount = 0;
+	bool isSameModels = true;
+	for (shared_ptr<Model>& i : m_basicList)
+	{
+		if (isCandidate(i))
+		{
+			isSameModels = isSameModels && modelCount < m_pickCandidates.size() && m_pickCandidates[modelCount] == i;
+			models[modelCount++] = i.get();
+		}
+	}
+	isSameModels = isSameModels && modelCount == m_pickCandidates.size();
+
+	// Model이 추가/제거되었을 때만 다시 만들고, 움직이기만 했으면 Tree는 그대로 두고 경계만 갱신
+	if (isSameModels)
+	{
+		m_pickScene.Refit();
+	}
+	else
+	{
+		m_pickCandidates.clear();
+		for (shared_ptr<Model>& i : m_basicList)
+		{
+			if (isCandidate(i))
+			{
+				m_pickCandidates.push_back(i);
+			}
+		}
+		m_pickScene.Build(ArrayView<const Model* const>(models.data(), modelCount));
+	}
+
+	m_pickHit = RayHit();
+	m_pickScene.IntersectClosest(GetPickingRay(), m_pickHit);
+	m_pickedModel = m_pickHit.IsHit() ? m_pickCandidates[m_pickHit.object] : nullptr;
+}
+
+void ExampleApp::UpdateFrustumCulling(const Matrix& viewRow, const Matrix& projRow, const Matrix& reflectRow)
+{
+	m_frustumCuller.ClearBoxes();
+	m_frustumCuller.ClearViews();
+
+	m_mainView = m_reflectView = UINT32_MAX;
+	for (int i = 0; i < MAX_LIGHTS; i++)
+	{
+		m_shadowViews[i] = UINT32_MAX;
+	}
+
+	// View가 없으면 모두 보임
+	if (m_useFrustumCulling)
+	{
+		for (shared_ptr<Model>& i : m_basicList)
+		{
+			i->AddCullBoxes(m_frustumCuller);
+		}
+		m_mirror->AddCullBoxes(m_frustumCuller);
+
+		m_mainView = m_frustumCuller.AddView(viewRow * projRow);
+
+		// 반사된 물체는 reflectRow * viewRow로 그리므로 원래 위치의 Box를 그대로 검사
+		m_reflectView = m_frustumCuller.AddView(reflectRow * viewRow * projRow);
+
+		for (int i = 0; i < MAX_LIGHTS; i++)
+		{
+			if (m_globalConstsCPU.lights[i].type & LIGHT_SHADOW)
+			{
+				m_shadowViews[i] = m_frustumCuller.AddView(m_shadowGlobalConstsCPU[i].viewProj.Transpose());
+			}
+		}
+	}
+
+	m_frustumCuller.Cull();
+}
+
+void ExampleApp::UpdateRenderQueue(const Matrix& viewRow, const Matrix& reflectRow)
+{
+	m_renderQueue.Clear();
+	m_drawItems.clear();
+
+	// 둘 다 Render()에서 실제로 그린 Depth Only Packet(Culling 후)만 더함
+	m_depthPassFetchBytes = 0;
+	m_depthPassFetchBytesFull = 0;
+
+	const CullVisibility mainVisibility = m_frustumCuller.GetVisibility(m_mainView);
+	for (shared_ptr<Model>& i : m_basicList)
+	{
+		i->AddDrawPackets(m_renderQueue, m_drawItems, PASS_DEPTH_ONLY, DrawKind::DepthOnly, mainVisibility,
+						  viewRow);
+	}
+
+	for (int l = 0; l < MAX_LIGHTS; l++)
+	{
+		if (m_globalConstsCPU.lights[l].type & LIGHT_SHADOW)
+		{
+			const CullVisibility shadowVisibility = m_frustumCuller.GetVisibility(m_shadowViews[l]);
+			const Matrix lightViewRow = m_shadowGlobalConstsCPU[l].view.Transpose();
+			for (shared_ptr<Model>& i : m_basicList)
+			{
+				if (i->m_castShadow)
+				{
+					i->AddDrawPackets(m_renderQueue, m_drawItems, PASS_SHADOW + l, DrawKind::DepthOnly,
+									  shadowVisibility, lightViewRow);
+				}
+			}
+		}
+	}
+
+	const DrawKind opaqueKind = m_useMeshletCulling ? DrawKind::VisibleMeshlets : DrawKind::Full;
+	for (shared_ptr<Model>& i : m_basicList)
+	{
+		i->AddDrawPackets(m_renderQueue, m_drawItems, PASS_OPAQUE, opaqueKind, mainVisibility, viewRow);
+	}
+
+	if (m_mirrorAlpha < 1.0f && mainVisibility.IsVisible(m_mirror->m_cullIndex))
+	{
+		const CullVisibility reflectVisibility = m_frustumCuller.GetVisibility(m_reflectView);
+		const Matrix reflectViewRow = reflectRow * viewRow;
+		for (shared_ptr<Model>& i : m_basicList)
+		{
+			i->AddDrawPackets(m_renderQueue, m_drawItems, PASS_REFLECT, DrawKind::Full, reflectVisibility,
+							  reflectViewRow);
+		}
+	}
+
+	m_renderQueue.Sort();
+}
+
+void ExampleApp::RenderQueuedPass(const uint32_t pass)
+{
+	// Pass 사이에 m_context로 직접 그린 것(Skybox, 거울)과 Render Target 변경으로 바뀌었을 수 있음
+	m_stateCache.InvalidateResources();
+
+	size_t count = 0;
+	const RenderQueue::Packet* packets = m_renderQueue.GetPassPackets(pass, count);
+	for (size_t p = 0; p < count; p++)
+	{
+		const DrawItem& item = m_drawItems[packets[p].item];
+		item.model->RenderQueued(m_stateCache, item.mesh, item.kind);
+
+		if (item.kind == DrawKind::DepthOnly)
+		{
+			const Mesh& mesh = *item.model->m_meshes[item.mesh];
+			m_depthPassFetchBytes += size_t(mesh.vertexCount) * mesh.positionStride;
+			m_depthPassFetchBytesFull += size_t(mesh.vertexCount) * sizeof(Vertex);
+		}
+	}
+
+	m_queuedDrawCount += count;
 }
 
 void ExampleApp::Render()
@@ -347,18 +640,18 @@ void ExampleApp::Render()
 	AppBase::SetMainViewport();
 
 	// 모든 샘플러들을 공통으로 사용
-	m_context->VSSetSamplers(0, UINT(Graphics::sampleStates.size()),
+	m_stateCache.VSSetSamplers(0, UINT(Graphics::sampleStates.size()),
 		Graphics::sampleStates.data());
-	m_context->PSSetSamplers(0, UINT(Graphics::sampleStates.size()),
+	m_stateCache.PSSetSamplers(0, UINT(Graphics::sampleStates.size()),
 		Graphics::sampleStates.data());
 
 	// 공용 텍스춰들: "Common.hlsli"에서 register(t10)부터 시작
-	vector<ID3D11ShaderResourceView*> commonSRVs = { m_envSRV.Get(), m_specularSRV.Get(),
-													 m_irradianceSRV.Get(), m_brdfSRV.Get() };
-	m_context->PSSetShaderResources(10, UINT(commonSRVs.size()), commonSRVs.data());
+	ID3D11ShaderResourceView* commonSRVs[] = { m_envSRV.Get(), m_specularSRV.Get(), m_irradianceSRV.Get(),
+												m_brdfSRV.Get() };
+	m_context->PSSetShaderResources(10, UINT(size(commonSRVs)), commonSRVs);
 
 	const float clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
-	vector<ID3D11RenderTargetView*> rtvs = { m_floatRTV.Get() };
+	ID3D11RenderTargetView* rtvs[] = { m_floatRTV.Get() };
 
 	// Depth Only Pass (RTS 생략 가능)
 	m_context->OMSetRenderTargets(0, NULL, m_depthOnlyDSV.Get());
@@ -366,12 +659,12 @@ void ExampleApp::Render()
 	AppBase::SetPipelineState(Graphics::depthOnlyPSO);
 	AppBase::SetGlobalConsts(m_globalConstsGPU);
 
-	for (auto& i : m_basicList)
-	{
-		i->Render(m_context);
-	}
-	m_skybox->Render(m_context);
-	m_mirror->Render(m_context);
+	m_queuedDrawCount = 0;
+
+	const CullVisibility mainVisibility = m_frustumCuller.GetVisibility(m_mainView);
+	RenderQueuedPass(PASS_DEPTH_ONLY);
+	RenderDepthOnly(m_skybox, CullVisibility());
+	RenderDepthOnly(m_mirror, mainVisibility);
 
 	// 그림자맵 만들기
 	AppBase::SetShadowViewport(); // 그림자맵 해상도
@@ -384,16 +677,10 @@ void ExampleApp::Render()
 			m_context->OMSetRenderTargets(0, NULL, m_shadowDSVs[i].Get());
 			m_context->ClearDepthStencilView(m_shadowDSVs[i].Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
 			AppBase::SetGlobalConsts(m_shadowGlobalConstsGPU[i]);
-			for (auto& i : m_basicList)
-			{
-				if (i->m_castShadow && i->m_isVisible)
-				{
-					i->Render(m_context);
-				}
-			}
-				
-			m_skybox->Render(m_context);
-			m_mirror->Render(m_context);
+			const CullVisibility shadowVisibility = m_frustumCuller.GetVisibility(m_shadowViews[i]);
+			RenderQueuedPass(PASS_SHADOW + i);
+			RenderDepthOnly(m_skybox, CullVisibility());
+			RenderDepthOnly(m_mirror, shadowVisibility);
 		}
 	}
 
@@ -401,20 +688,20 @@ void ExampleApp::Render()
 	AppBase::SetMainViewport();
 
 	// 거울 1. 거울은 빼고 원래 대로 그리기
-	for (size_t i = 0; i < rtvs.size(); i++)
+	for (size_t i = 0; i < size(rtvs); i++)
 	{
 		m_context->ClearRenderTargetView(rtvs[i], clearColor);
 	}
-	m_context->OMSetRenderTargets(UINT(rtvs.size()), rtvs.data(), m_depthStencilView.Get());
+	m_context->OMSetRenderTargets(UINT(size(rtvs)), rtvs, m_depthStencilView.Get());
 
 	// 그림자맵들도 공용 텍스춰들 이후에 추가
 	// 주의: 마지막 shadowDSV를 RenderTarget에서 해제한 후 설정
-	vector<ID3D11ShaderResourceView*> shadowSRVs;
+	ID3D11ShaderResourceView* shadowSRVs[MAX_LIGHTS];
 	for (int i = 0; i < MAX_LIGHTS; i++)
 	{
-		shadowSRVs.push_back(m_shadowSRVs[i].Get());
+		shadowSRVs[i] = m_shadowSRVs[i].Get();
 	}
-	m_context->PSSetShaderResources(15, UINT(shadowSRVs.size()), shadowSRVs.data());
+	m_context->PSSetShaderResources(15, MAX_LIGHTS, shadowSRVs);
 
 	m_context->ClearDepthStencilView(m_depthStencilView.Get(),
 									 D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL,
@@ -423,15 +710,12 @@ void ExampleApp::Render()
 										   : Graphics::defaultSolidPSO);
 	AppBase::SetGlobalConsts(m_globalConstsGPU);
 
-	for (auto& i : m_basicList)
-	{
-		i->Render(m_context);
-	}
+	RenderQueuedPass(PASS_OPAQUE);
 
 	// 거울 반사를 그릴 필요가 없으면 불투명 거울만 그리기
 	if (m_mirrorAlpha == 1.0f)
 	{
-		m_mirror->Render(m_context);
+		m_mirror->Render(m_context, mainVisibility);
 	}
 
 	AppBase::SetPipelineState(Graphics::normalsPSO);
@@ -448,13 +732,14 @@ void ExampleApp::Render()
 
 	m_skybox->Render(m_context);
 
-	if (m_mirrorAlpha < 1.0f)
+	// 거울이 화면 밖이면 반사도 그리지 않음
+	if (m_mirrorAlpha < 1.0f && mainVisibility.IsVisible(m_mirror->m_cullIndex))
 	{ // 거울을 그려야 하는 상황
 
 		// 거울 2. 거울 위치만 StencilBuffer에 1로 표기
 		AppBase::SetPipelineState(Graphics::stencilMaskPSO);
 
-		m_mirror->Render(m_context);
+		m_mirror->RenderDepthOnly(m_context);
 
 		// 거울 3. 거울 위치에 반사된 물체들을 렌더링
 		AppBase::SetPipelineState(m_drawAsWire ? Graphics::reflectWirePSO
@@ -464,10 +749,7 @@ void ExampleApp::Render()
 		m_context->ClearDepthStencilView(m_depthStencilView.Get(),
 										 D3D11_CLEAR_DEPTH, 1.0f, 0);
 
-		for (auto& i : m_basicList)
-		{
-			i->Render(m_context);
-		}
+		RenderQueuedPass(PASS_REFLECT);
 
 		AppBase::SetPipelineState(m_drawAsWire ? Graphics::reflectSkyboxWirePSO
 											   : Graphics::reflectSkyboxSolidPSO);
@@ -489,13 +771,12 @@ void ExampleApp::Render()
 	// PostEffects
 	AppBase::SetPipelineState(Graphics::postEffectsPSO);
 
-	vector<ID3D11ShaderResourceView*> postEffectsSRVs = { m_resolvedSRV.Get(),
-														  m_depthOnlySRV.Get() };
+	ID3D11ShaderResourceView* postEffectsSRVs[] = { m_resolvedSRV.Get(), m_depthOnlySRV.Get() };
 
 	AppBase::SetGlobalConsts(m_globalConstsGPU);
 
 	// 20번에 넣어줌
-	m_context->PSSetShaderResources(20, UINT(postEffectsSRVs.size()), postEffectsSRVs.data());
+	m_context->PSSetShaderResources(20, UINT(size(postEffectsSRVs)), postEffectsSRVs);
 	m_context->OMSetRenderTargets(1, m_postEffectsRTV.GetAddressOf(), NULL);
 
 	m_context->PSSetConstantBuffers(3, 1, m_postEffectsConstsGPU.GetAddressOf());
@@ -504,6 +785,14 @@ void ExampleApp::Render()
 	// 단순 이미지 처리와 블룸
 	AppBase::SetPipelineState(Graphics::postProcessingPSO);
 	m_postProcess.Render(m_context);
+
+	if (!m_firstFrameRendered && g_printStats)
+	{
+		m_firstFrameRendered = true;
+
+		const chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - m_startTime;
+		cout << "Time to first frame: " << elapsed.count() << " ms" << endl;
+	}
 }
 
 void ExampleApp::UpdateLights(float dt)
@@ -546,3 +835,13 @@ void ExampleApp::UpdateLights(float dt)
 		}
 	}
 }
+
+void ExampleApp::RenderDepthOnly(std::shared_ptr<Model>& model, const CullVisibility& visibility)
+{
+	if (!model->m_isVisible)
+	{
+		return;
+	}
+
+	m_depthPassFetchBytes += model->RenderDepthOnly(m_context, visibility, &m_depthPassFetchBytesFull);
+}
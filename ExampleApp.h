@@ -4,12 +4,18 @@
 
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <future>
 #include <memory>
 
 #include "AppBase.h"
+#include "AsyncModelLoader.h"
 #include "GeometryGenerator.h"
 #include "ImageFilter.h"
 #include "Model.h"
+#include "ModelInstance.h"
+#include "ModelRegistry.h"
+#include "SceneBVH.h"
 
 class ExampleApp : public AppBase {
 public:
@@ -22,15 +28,66 @@ public:
 
 	void UpdateLights(float dt);
 
+	// 이번 Frame의 모든 Pass(Main, 거울 반사, Shadow)의 View로 한 번에 Frustum Culling
+	void UpdateFrustumCulling(const DirectX::SimpleMath::Matrix &viewRow,
+							  const DirectX::SimpleMath::Matrix &projRow,
+							  const DirectX::SimpleMath::Matrix &reflectRow);
+
+	// Position Stream으로 그리고 읽은 양을 Pass 통계에 더함
+	void RenderDepthOnly(std::shared_ptr<Model> &model, const CullVisibility &visibility);
+
+	// m_basicList의 모든 Pass의 Draw를 m_renderQueue에 모아서 정렬 (UpdateFrustumCulling() 이후)
+	void UpdateRenderQueue(const DirectX::SimpleMath::Matrix &viewRow,
+						   const DirectX::SimpleMath::Matrix &reflectRow);
+
+	// pass의 Draw들을 정렬된 순서로 m_stateCache로 그림 (PSO, Global Consts는 호출하는 쪽에서 설정)
+	void RenderQueuedPass(const uint32_t pass);
+
+	// 커서 아래에서 가장 가까운 Model을 삼각형 단위로 찾아서 m_pickedModel에 저장
+	void PickModel();
+
 protected:
 	std::shared_ptr<Model> m_ground;
-	std::shared_ptr<Model> m_mainObj;
-	std::shared_ptr<Model> m_lightSphere[MAX_LIGHTS];
+	std::shared_ptr<ModelInstance> m_mainObj;
+	std::shared_ptr<ModelInstance> m_lightSphere[MAX_LIGHTS];
 	std::shared_ptr<Model> m_skybox;
-	std::shared_ptr<Model> m_cursorSphere;
+	std::shared_ptr<ModelInstance> m_cursorSphere;
 	std::shared_ptr<Model> m_screenSquare;
 
-	DirectX::BoundingSphere m_mainBoundingSphere;
+	// 드래그를 시작할 때 고른 Model (조명/커서 표시용 구 제외), 드래그하는 동안 유지
+	// m_pickScene은 Frame이 지나도 유지 (고를 수 있는 Model이 바뀔 때만 다시 만듦)
+	SceneBVH m_pickScene;
+	std::vector<std::shared_ptr<Model>> m_pickCandidates; // m_pickScene의 object 순서
+	std::shared_ptr<Model> m_pickedModel;
+	RayHit m_pickHit;
+
+	// 화면 밖/뒷면 Meshlet은 Main Pass에서 그리지 않음
+	bool m_useMeshletCulling = true;
+
+	// 화면/거울/그림자에 보이지 않는 Model과 Mesh는 해당 Pass에서 그리지 않음
+	bool m_useFrustumCulling = true;
+	FrustumCuller m_frustumCuller;
+	uint32_t m_mainView = UINT32_MAX;
+	uint32_t m_reflectView = UINT32_MAX;
+	uint32_t m_shadowViews[MAX_LIGHTS];
+
+	// 한 프레임의 Depth Only + Shadow Pass에서 읽은 Vertex Buffer 크기
+	// (Full은 Culling 없이 같은 Model들을 전체 Vertex로 그렸을 때)
+	size_t m_depthPassFetchBytes = 0;
+	size_t m_depthPassFetchBytesFull = 0;
+
+	// Render Queue Key의 Pass (그리는 순서와 같음)
+	enum RenderPass : uint32_t {
+		PASS_DEPTH_ONLY = 0,
+		PASS_SHADOW = 1, // + Light Index
+		PASS_OPAQUE = PASS_SHADOW + MAX_LIGHTS,
+		PASS_REFLECT,
+	};
+	RenderQueue m_renderQueue;
+	std::vector<DrawItem> m_drawItems; // RenderQueue::Packet::item이 가리킴
+
+	// 한 프레임에 Queue로 그린 Mesh 수
+	size_t m_queuedDrawCount = 0;
 
 	// 거울
 	std::shared_ptr<Model> m_mirror;
@@ -39,4 +96,15 @@ protected:
 
 	// 거울 제외 Object 리스트
 	std::vector<std::shared_ptr<Model>> m_basicList;
+
+	// 같은 파일/Parameter로 만드는 Geometry 공유
+	ModelRegistry m_modelRegistry;
+
+	// Main Object는 Placeholder를 그리는 동안 비동기로 읽음
+	AsyncModelLoader m_modelLoader;
+	std::shared_future<void> m_mainObjLoaded;
+
+	// 첫 프레임까지 걸린 시간 출력용
+	std::chrono::steady_clock::time_point m_startTime;
+	bool m_firstFrameRendered = false;
 };
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "FrameAllocator.h"
+
+#include <algorithm>
+
+using namespace std;
+
+FrameAllocator::FrameAllocator(const size_t blockSize) : m_blockSize(blockSize)
+{
+	m_blocks.reserve(8);
+}
+
+void* FrameAllocator::Allocate(const size_t size, const size_t alignment)
+{
+	if (m_blocks.empty())
+	{
+		AddBlock(size + alignment);
+	}
+
+	// Block 시작 주소 기준이 아니라 실제 주소로 정렬
+	uintptr_t base = uintptr_t(m_blocks.back().data.get());
+	size_t aligned = ((base + m_offset + alignment - 1) & ~uintptr_t(alignment - 1)) - base;
+	if (aligned + size > m_blocks.back().size)
+	{
+		AddBlock(size + alignment);
+		base = uintptr_t(m_blocks.back().data.get());
+		aligned = ((base + alignment - 1) & ~uintptr_t(alignment - 1)) - base;
+	}
+
+	m_usedSize += aligned + size - m_offset;
+	m_peakSize = max(m_peakSize, m_usedSize);
+	m_offset = aligned + size;
+
+	return m_blocks.back().data.get() + aligned;
+}
+
+void FrameAllocator::Reset()
+{
+	// 이번 Frame에 Block 하나로 모자랐으면 다음 Frame부터는 합친 크기의 Block 하나로
+	if (m_blocks.size() > 1)
+	{
+		const size_t capacity = GetCapacity();
+		m_blocks.clear();
+		AddBlock(capacity);
+	}
+
+	m_offset = 0;
+	m_usedSize = 0;
+}
+
+size_t FrameAllocator::GetCapacity() const
+{
+	size_t capacity = 0;
+	for (const Block& block : m_blocks)
+	{
+		capacity += block.size;
+	}
+	return capacity;
+}
+
+void FrameAllocator::AddBlock(const size_t minSize)
+{
+	// 이전 Block의 남은 공간은 이번 Frame에서 버림
+	if (!m_blocks.empty())
+	{
+		m_usedSize += m_blocks.back().size - m_offset;
+	}
+
+	const size_t size = max(m_blockSize, minSize);
+	m_blocks.push_back({ make_unique<uint8_t[]>(size), size });
+	m_offset = 0;
+	m_blockAllocCount++;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "ArrayView.h"
+
+// 한 Frame 동안만 쓰는 임시 배열용 선형(Bump) 할당기, Reset()으로 한꺼번에 버림
+// Block이 모자라면 새 Block을 할당하고 Reset()에서 그 Frame에 쓴 크기만큼 하나로 합치므로
+// 처음 몇 Frame이 지나면 Heap 할당이 없음 (Render Thread 전용)
+class FrameAllocator {
+public:
+	static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+	explicit FrameAllocator(const size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+	FrameAllocator(const FrameAllocator &) = delete;
+	FrameAllocator &operator=(const FrameAllocator &) = delete;
+
+	void *Allocate(const size_t size, const size_t alignment = alignof(std::max_align_t));
+
+	// 초기화하지 않은 count개 (소멸자를 호출하지 않으므로 Pointer, POD만)
+	template <typename T>
+	ArrayView<T> AllocateArray(const size_t count)
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "FrameAllocator does not call destructors");
+		return ArrayView<T>(static_cast<T *>(Allocate(sizeof(T) * count, alignof(T))), count);
+	}
+
+	// 이번 Frame에 할당한 것을 모두 버림 (이전에 받은 Pointer는 사용할 수 없음)
+	void Reset();
+
+	size_t GetUsedSize() const { return m_usedSize; }
+	size_t GetPeakSize() const { return m_peakSize; }
+	size_t GetCapacity() const;
+	size_t GetBlockAllocCount() const { return m_blockAllocCount; } // Heap 할당 횟수
+
+private:
+	struct Block {
+		std::unique_ptr<uint8_t[]> data;
+		size_t size;
+	};
+
+	void AddBlock(const size_t minSize);
+
+	std::vector<Block> m_blocks; // 마지막 Block에서 할당
+	size_t m_offset = 0;		 // 마지막 Block에서 사용한 크기
+	size_t m_blockSize;
+
+	size_t m_usedSize = 0; // 이번 Frame (정렬 때문에 생긴 빈 공간 포함)
+	size_t m_peakSize = 0;
+	size_t m_blockAllocCount = 0;
+};
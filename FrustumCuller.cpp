@@ -0,0 +1,332 @@
+#include "FrustumCuller.h"
+#include "PixelConverter.h"
+#include "ThreadPool.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+
+using namespace std;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+// GCC/Clang은 함수 단위로 명령어 집합을 켜야 함 (MSVC는 그대로 사용 가능)
+#if defined(_MSC_VER) && !defined(__clang__)
+#define TARGET_AVX
+#else
+#define TARGET_AVX __attribute__((target("avx")))
+#endif
+
+namespace {
+	const size_t simdWidth = 8;			 // 배열을 이 배수로 채움 (AVX)
+	const float alwaysVisibleExtent = 1e18f; // 경계가 없는 Box (어떤 Plane에도 걸치도록)
+
+	struct BoxArrays {
+		const float *centerX, *centerY, *centerZ;
+		const float *extentX, *extentY, *extentZ;
+	};
+
+	// Box가 Plane 바깥 = (중심까지의 거리 + Extents를 법선에 투영한 반지름) < 0
+	// 6개 Plane의 값을 OR하면 부호 bit가 하나라도 바깥인 Box
+	uint64_t CullWordScalar(const BoxArrays &boxes, const size_t first, const size_t count,
+							const float *nx, const float *ny, const float *nz, const float *d,
+							const float *ax, const float *ay, const float *az)
+	{
+		uint64_t word = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			const size_t k = first + i;
+			bool isVisible = true;
+			for (int j = 0; j < 6 && isVisible; j++)
+			{
+				const float distance = nx[j] * boxes.centerX[k] + ny[j] * boxes.centerY[k] +
+									   nz[j] * boxes.centerZ[k] + d[j];
+				const float radius = ax[j] * boxes.extentX[k] + ay[j] * boxes.extentY[k] +
+									 az[j] * boxes.extentZ[k];
+				isVisible = distance + radius >= 0.0f;
+			}
+			word |= uint64_t(isVisible) << i;
+		}
+		return word;
+	}
+
+	uint64_t CullWordSSE(const BoxArrays &boxes, const size_t first, const size_t count,
+						 const float *nx, const float *ny, const float *nz, const float *d,
+						 const float *ax, const float *ay, const float *az)
+	{
+		uint64_t outside = 0;
+		for (size_t i = 0; i < count; i += 4)
+		{
+			const size_t k = first + i;
+			const __m128 cx = _mm_loadu_ps(boxes.centerX + k);
+			const __m128 cy = _mm_loadu_ps(boxes.centerY + k);
+			const __m128 cz = _mm_loadu_ps(boxes.centerZ + k);
+			const __m128 ex = _mm_loadu_ps(boxes.extentX + k);
+			const __m128 ey = _mm_loadu_ps(boxes.extentY + k);
+			const __m128 ez = _mm_loadu_ps(boxes.extentZ + k);
+
+			__m128 sign = _mm_setzero_ps();
+			for (int j = 0; j < 6; j++)
+			{
+				const __m128 distance = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(_mm_set1_ps(nx[j]), cx), _mm_mul_ps(_mm_set1_ps(ny[j]), cy)),
+					_mm_add_ps(_mm_mul_ps(_mm_set1_ps(nz[j]), cz), _mm_set1_ps(d[j])));
+				const __m128 radius = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(_mm_set1_ps(ax[j]), ex), _mm_mul_ps(_mm_set1_ps(ay[j]), ey)),
+					_mm_mul_ps(_mm_set1_ps(az[j]), ez));
+				sign = _mm_or_ps(sign, _mm_add_ps(distance, radius));
+			}
+			outside |= uint64_t(_mm_movemask_ps(sign)) << i;
+		}
+		return ~outside;
+	}
+
+	TARGET_AVX uint64_t CullWordAVX(const BoxArrays &boxes, const size_t first, const size_t count,
+									const float *nx, const float *ny, const float *nz, const float *d,
+									const float *ax, const float *ay, const float *az)
+	{
+		uint64_t outside = 0;
+		for (size_t i = 0; i < count; i += 8)
+		{
+			const size_t k = first + i;
+			const __m256 cx = _mm256_loadu_ps(boxes.centerX + k);
+			const __m256 cy = _mm256_loadu_ps(boxes.centerY + k);
+			const __m256 cz = _mm256_loadu_ps(boxes.centerZ + k);
+			const __m256 ex = _mm256_loadu_ps(boxes.extentX + k);
+			const __m256 ey = _mm256_loadu_ps(boxes.extentY + k);
+			const __m256 ez = _mm256_loadu_ps(boxes.extentZ + k);
+
+			__m256 sign = _mm256_setzero_ps();
+			for (int j = 0; j < 6; j++)
+			{
+				const __m256 distance = _mm256_add_ps(
+					_mm256_add_ps(_mm256_mul_ps(_mm256_broadcast_ss(nx + j), cx),
+								  _mm256_mul_ps(_mm256_broadcast_ss(ny + j), cy)),
+					_mm256_add_ps(_mm256_mul_ps(_mm256_broadcast_ss(nz + j), cz), _mm256_broadcast_ss(d + j)));
+				const __m256 radius = _mm256_add_ps(
+					_mm256_add_ps(_mm256_mul_ps(_mm256_broadcast_ss(ax + j), ex),
+								  _mm256_mul_ps(_mm256_broadcast_ss(ay + j), ey)),
+					_mm256_mul_ps(_mm256_broadcast_ss(az + j), ez));
+				sign = _mm256_or_ps(sign, _mm256_add_ps(distance, radius));
+			}
+			outside |= uint64_t(_mm256_movemask_ps(sign)) << i;
+		}
+		return ~outside;
+	}
+}
+
+void FrustumCuller::ClearBoxes()
+{
+	m_count = 0;
+	m_centerX.clear();
+	m_centerY.clear();
+	m_centerZ.clear();
+	m_extentX.clear();
+	m_extentY.clear();
+	m_extentZ.clear();
+}
+
+uint32_t FrustumCuller::AddBox(const DirectX::BoundingBox& worldBox)
+{
+	// 마지막 SIMD 묶음이 배열 밖을 읽지 않도록 simdWidth개씩 늘림
+	if (m_count % simdWidth == 0)
+	{
+		const size_t size = m_count + simdWidth;
+		for (vector<float>* values : { &m_centerX, &m_centerY, &m_centerZ, &m_extentX, &m_extentY, &m_extentZ })
+		{
+			values->resize(size, 0.0f);
+		}
+	}
+
+	m_centerX[m_count] = worldBox.Center.x;
+	m_centerY[m_count] = worldBox.Center.y;
+	m_centerZ[m_count] = worldBox.Center.z;
+	m_extentX[m_count] = worldBox.Extents.x;
+	m_extentY[m_count] = worldBox.Extents.y;
+	m_extentZ[m_count] = worldBox.Extents.z;
+
+	return uint32_t(m_count++);
+}
+
+uint32_t FrustumCuller::AddBox(const MeshBounds& bounds, const DirectX::SimpleMath::Matrix& worldRow)
+{
+	if (!bounds.isValid)
+	{
+		return AddBox(BoundingBox(XMFLOAT3(0.0f, 0.0f, 0.0f),
+								  XMFLOAT3(alwaysVisibleExtent, alwaysVisibleExtent, alwaysVisibleExtent)));
+	}
+
+	// 8개 모서리를 옮기는 대신 중심만 옮기고 Extents는 |M|으로 (Arvo)
+	const Vector3 center = Vector3::Transform(Vector3(bounds.box.Center), worldRow);
+	const Vector3& e = bounds.box.Extents;
+	const Vector3 extents(abs(worldRow._11) * e.x + abs(worldRow._21) * e.y + abs(worldRow._31) * e.z,
+						  abs(worldRow._12) * e.x + abs(worldRow._22) * e.y + abs(worldRow._32) * e.z,
+						  abs(worldRow._13) * e.x + abs(worldRow._23) * e.y + abs(worldRow._33) * e.z);
+
+	return AddBox(BoundingBox(center, extents));
+}
+
+void FrustumCuller::ClearViews()
+{
+	m_views.clear();
+}
+
+uint32_t FrustumCuller::AddView(const DirectX::SimpleMath::Matrix& viewProjRow)
+{
+	if (m_views.size() >= MAX_VIEWS)
+	{
+		return UINT32_MAX;
+	}
+
+	// MeshletCullView::Create()와 같은 방식 (M의 열로 Plane, 안쪽이 양수)
+	const Matrix& m = viewProjRow;
+	const Vector4 column0(m._11, m._21, m._31, m._41);
+	const Vector4 column1(m._12, m._22, m._32, m._42);
+	const Vector4 column2(m._13, m._23, m._33, m._43);
+	const Vector4 column3(m._14, m._24, m._34, m._44);
+
+	const Vector4 planes[6] = {
+		column3 + column0, // Left
+		column3 - column0, // Right
+		column3 + column1, // Bottom
+		column3 - column1, // Top
+		column2,		   // Near
+		column3 - column2  // Far
+	};
+
+	ViewPlanes view;
+	for (int j = 0; j < 6; j++)
+	{
+		Vector4 plane = planes[j];
+		const float length = Vector3(plane.x, plane.y, plane.z).Length();
+		if (length > 0.0f)
+		{
+			plane /= length;
+		}
+
+		view.nx[j] = plane.x;
+		view.ny[j] = plane.y;
+		view.nz[j] = plane.z;
+		view.d[j] = plane.w;
+		view.ax[j] = abs(plane.x);
+		view.ay[j] = abs(plane.y);
+		view.az[j] = abs(plane.z);
+	}
+
+	m_views.push_back(view);
+	return uint32_t(m_views.size() - 1);
+}
+
+void FrustumCuller::Cull()
+{
+	m_culledCount = m_count;
+	m_wordCount = (m_count + 63) / 64;
+	m_bits.assign(m_views.size() * m_wordCount, 0);
+
+	if (m_views.empty() || m_count == 0)
+	{
+		return;
+	}
+
+	if (m_count < parallelThreshold)
+	{
+		CullWords(0, m_wordCount);
+		return;
+	}
+
+	// Word 64개(Box 4096개)씩, 결과는 서로 다른 Word에 쓰므로 동기화 불필요
+	const size_t wordsPerTask = 64;
+	ThreadPool::GetInstance().ParallelFor(0, (m_wordCount + wordsPerTask - 1) / wordsPerTask, [&](size_t task) {
+		CullWords(task * wordsPerTask, min(m_wordCount, (task + 1) * wordsPerTask));
+	});
+}
+
+void FrustumCuller::CullWords(const size_t firstWord, const size_t endWord)
+{
+	const BoxArrays boxes = { m_centerX.data(), m_centerY.data(), m_centerZ.data(),
+							  m_extentX.data(), m_extentY.data(), m_extentZ.data() };
+	const PixelConverter::SimdLevel level = PixelConverter::GetSimdLevel();
+
+	// Box 64개를 읽어서 모든 View를 검사한 뒤 다음 64개로 (Box 데이터는 L1에 남아있음)
+	for (size_t w = firstWord; w < endWord; w++)
+	{
+		const size_t first = w * 64;
+		const size_t count = min(m_count - first, size_t(64));
+		const uint64_t mask = count == 64 ? ~uint64_t(0) : (uint64_t(1) << count) - 1;
+
+		for (size_t v = 0; v < m_views.size(); v++)
+		{
+			const ViewPlanes& p = m_views[v];
+
+			uint64_t word;
+			switch (level)
+			{
+			case PixelConverter::SimdLevel::AVX2:
+				word = CullWordAVX(boxes, first, count, p.nx, p.ny, p.nz, p.d, p.ax, p.ay, p.az);
+				break;
+			case PixelConverter::SimdLevel::SSE41:
+				word = CullWordSSE(boxes, first, count, p.nx, p.ny, p.nz, p.d, p.ax, p.ay, p.az);
+				break;
+			default:
+				word = CullWordScalar(boxes, first, count, p.nx, p.ny, p.nz, p.d, p.ax, p.ay, p.az);
+				break;
+			}
+
+			m_bits[v * m_wordCount + w] = word & mask;
+		}
+	}
+}
+
+void FrustumCuller::CullScalar()
+{
+	m_culledCount = m_count;
+	m_wordCount = (m_count + 63) / 64;
+	m_bits.assign(m_views.size() * m_wordCount, 0);
+
+	for (size_t v = 0; v < m_views.size(); v++)
+	{
+		const ViewPlanes& p = m_views[v];
+		uint64_t* bits = m_bits.data() + v * m_wordCount;
+
+		for (size_t i = 0; i < m_count; i++)
+		{
+			bool isVisible = true;
+			for (int j = 0; j < 6 && isVisible; j++)
+			{
+				const float distance = p.nx[j] * m_centerX[i] + p.ny[j] * m_centerY[i] + p.nz[j] * m_centerZ[i] + p.d[j];
+				const float radius = p.ax[j] * m_extentX[i] + p.ay[j] * m_extentY[i] + p.az[j] * m_extentZ[i];
+				isVisible = distance + radius >= 0.0f;
+			}
+
+			if (isVisible)
+			{
+				bits[i >> 6] |= uint64_t(1) << (i & 63);
+			}
+		}
+	}
+}
+
+CullVisibility FrustumCuller::GetVisibility(const uint32_t view) const
+{
+	CullVisibility visibility;
+	if (view < m_views.size() && m_culledCount > 0 && m_bits.size() == m_views.size() * m_wordCount)
+	{
+		visibility.bits = m_bits.data() + view * m_wordCount;
+		visibility.count = uint32_t(m_culledCount);
+	}
+	return visibility;
+}
+
+size_t FrustumCuller::GetVisibleCount(const uint32_t view) const
+{
+	const CullVisibility visibility = GetVisibility(view);
+
+	size_t count = 0;
+	for (size_t w = 0; visibility.bits && w < m_wordCount; w++)
+	{
+		count += bitset<64>(visibility.bits[w]).count();
+	}
+	return count;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <directxtk/SimpleMath.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "MeshData.h"
+
+// FrustumCuller::Cull() 결과 중 View 하나 (Box Index마다 1 bit)
+// 넣지 않은 Index(count 이상)는 보이는 것으로 봄
+struct CullVisibility {
+	const uint64_t *bits = nullptr;
+	uint32_t count = 0;
+
+	bool IsVisible(const uint32_t index) const
+	{
+		return index >= count || ((bits[index >> 6] >> (index & 63)) & 1);
+	}
+};
+
+// 여러 View(Main Camera, 거울 반사, Light별 Shadow)를 World Space AABB 목록에 대해 한 번에 검사
+// Box는 SoA로 저장하고 64개 단위로 모든 View를 검사 (Box 데이터를 한 번만 읽음)
+// 4개(SSE)/8개(AVX2) Box를 6개 Plane과 동시에 비교, PixelConverter::GetSimdLevel()을 따름
+// CPU만 사용, Render Thread에서 Update 때
+class FrustumCuller {
+public:
+	static const uint32_t MAX_VIEWS = 8;
+
+	void ClearBoxes();
+
+	// 반환값: Box Index
+	uint32_t AddBox(const DirectX::BoundingBox &worldBox);
+
+	// Model Space Box를 worldRow로 옮긴 AABB, bounds가 없으면 항상 보임
+	uint32_t AddBox(const MeshBounds &bounds, const DirectX::SimpleMath::Matrix &worldRow);
+
+	void ClearViews();
+
+	// Row Vector 기준 view * proj (Clip = v * M, D3D: 0 <= z <= w)
+	// 반환값: View Index, MAX_VIEWS를 넘으면 UINT32_MAX
+	uint32_t AddView(const DirectX::SimpleMath::Matrix &viewProjRow);
+
+	// 모든 View의 Bitset을 다시 계산
+	void Cull();
+
+	// View마다 Box를 하나씩 검사 (비교용)
+	void CullScalar();
+
+	CullVisibility GetVisibility(const uint32_t view) const;
+	bool IsVisible(const uint32_t view, const uint32_t box) const { return GetVisibility(view).IsVisible(box); }
+	size_t GetVisibleCount(const uint32_t view) const;
+
+	size_t GetBoxCount() const { return m_count; }
+	size_t GetViewCount() const { return m_views.size(); }
+
+public:
+	// 이보다 Box가 많으면 ThreadPool로 나눠서
+	size_t parallelThreshold = 32768;
+
+private:
+	// Plane j: (nx, ny, nz) . p + d >= 0이 안쪽, a는 |n| (Box Extents 투영용)
+	struct ViewPlanes {
+		float nx[6], ny[6], nz[6], d[6];
+		float ax[6], ay[6], az[6];
+	};
+
+	void CullWords(const size_t firstWord, const size_t endWord);
+
+	size_t m_count = 0;
+	size_t m_culledCount = 0; // 마지막 Cull() 때의 Box 수
+
+	// SIMD 폭(8)의 배수로 채움
+	std::vector<float> m_centerX, m_centerY, m_centerZ;
+	std::vector<float> m_extentX, m_extentY, m_extentZ;
+
+	std::vector<ViewPlanes> m_views;
+
+	// View마다 m_wordCount개 (View 순서대로 이어져 있음)
+	std::vector<uint64_t> m_bits;
+	size_t m_wordCount = 0;
+};
@@ -1,6 +1,13 @@
 #include "GeometryGenerator.h"
 
+#include "BoundsCalculator.h"
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
 #include "ModelLoader.h"
+#include "Stats.h"
+#include "TangentGenerator.h"
+#include "ThreadPool.h"
 
 using namespace std;
 using namespace DirectX;
@@ -10,46 +17,70 @@ std::vector<MeshData> GeometryGenerator::ReadFromFile(std::string basePath,
 													  std::string fileName,
 													  bool reverseNormal)
 {
+    // 이전에 Import한 결과가 있으면 Assimp를 거치지 않음
+    shared_ptr<MeshCache> cache = MeshCache::Load(basePath, fileName, reverseNormal);
+    if (cache)
+    {
+        return cache->ToMeshData();
+    }
+
     ModelLoader modelLoader;
     modelLoader.Load(basePath, fileName, reverseNormal);
     vector<MeshData>& meshes = modelLoader.m_meshes;
 
-    // Normalize vertices
-    Vector3 vmin(1000, 1000, 1000);
-    Vector3 vmax(-1000, -1000, -1000);
-    for (MeshData& mesh : meshes)
+    // Mesh마다 AABB, 경계 구, OBB를 계산 (SIMD, 병렬)
+    BoundsCalculator::Compute(meshes);
+
+    vector<MeshBounds> meshBounds(meshes.size());
+    for (size_t i = 0; i < meshes.size(); i++)
     {
-        for (Vertex& v : mesh.vertices)
+        meshBounds[i] = meshes[i].bounds;
+    }
+    const BoundingBox modelBox = BoundsCalculator::Merge(meshBounds).box;
+
+    // Normalize vertices: 가장 긴 축의 길이가 1, 중심은 원점
+    // 경계는 같은 변환을 적용해서 다시 계산하지 않음
+    const float dl = 2.0f * XMMax(XMMax(modelBox.Extents.x, modelBox.Extents.y), modelBox.Extents.z);
+    const float invScale = (dl > 0.0f) ? 1.0f / dl : 1.0f;
+    const Vector3 translation = -Vector3(modelBox.Center) * invScale;
+
+    ThreadPool::GetInstance().ParallelFor(0, meshes.size(), [&](size_t i) {
+        for (Vertex& v : meshes[i].vertices)
         {
-            vmin.x = XMMin(vmin.x, v.position.x);
-            vmin.y = XMMin(vmin.y, v.position.y);
-            vmin.z = XMMin(vmin.z, v.position.z);
-            vmax.x = XMMax(vmin.x, v.position.x);
-            vmax.y = XMMax(vmin.y, v.position.y);
-            vmax.z = XMMax(vmin.z, v.position.z);
+            v.position = v.position * invScale + translation;
         }
-    }
+        meshes[i].bounds = BoundsCalculator::Transform(meshes[i].bounds, invScale, translation);
+    });
 
-    float dx = vmax.x - vmin.x;
-    float dy = vmax.y - vmin.y;
-    float dz = vmax.z - vmin.z;
-    float dl = XMMax(XMMax(dx, dy), dz);
+    // 중복 Vertex 제거 및 GPU 캐시/Overdraw/Fetch 순서 최적화 (결과는 캐시에 저장됨)
+    vector<MeshOptimizerStats> stats(meshes.size());
+    ThreadPool::GetInstance().ParallelFor(0, meshes.size(), [&](size_t i) {
+        stats[i] = MeshOptimizer::Optimize(meshes[i]);
 
-    float cx = (vmax.x + vmin.x) * 0.5f;
-    float cy = (vmax.y + vmin.y) * 0.5f;
-    float cz = (vmax.z + vmin.z) * 0.5f;
+        // 최적화된 Vertex Buffer를 공유하는 LOD들
+        meshes[i].lods = MeshSimplifier::BuildLodChain(meshes[i]);
+    });
 
-    for (MeshData& mesh : meshes)
+    for (size_t i = 0; i < meshes.size() && g_printStats; i++)
     {
-        for (Vertex& v : mesh.vertices)
+        cout << "Mesh " << i << ": vertices " << stats[i].vertexCountBefore << " -> "
+             << stats[i].vertexCountAfter << ", ACMR " << stats[i].acmrBefore << " -> "
+             << stats[i].acmrAfter << ", ATVR " << stats[i].atvrBefore << " -> "
+             << stats[i].atvrAfter << endl;
+
+        for (size_t l = 0; l < meshes[i].lods.size(); l++)
         {
-            v.position.x = (v.position.x - cx) / dl;
-            v.position.y = (v.position.y - cy) / dl;
-            v.position.z = (v.position.z - cz) / dl;
+            cout << "    LOD " << l + 1 << ": triangles " << meshes[i].lods[l].indices.size() / 3
+                 << ", error " << meshes[i].lods[l].error << endl;
         }
     }
 
-	return meshes;
+    if (!meshes.empty())
+    {
+        MeshCache::Write(MeshCache::GetCacheFileName(basePath, fileName), meshes, reverseNormal);
+    }
+
+	return std::move(meshes);
 }
 
 MeshData GeometryGenerator::MakeSquare(const float scale,
@@ -87,7 +118,7 @@ MeshData GeometryGenerator::MakeSquare(const float scale,
         v.position = positions[i];
         v.normalModel = normals[i];
         v.texcoord = texcoords[i] * texScale;
-        v.tangentModel = Vector3(1.0f, 0.0f, 0.0f);
+        v.tangentModel = Vector4(1.0f, 0.0f, 0.0f, 1.0f);
 
         meshData.vertices.push_back(v);
     }
@@ -115,7 +146,7 @@ MeshData GeometryGenerator::MakeSquareGrid(const int numSlices, const int numSta
             v.position = Vector3(x, y, 0.0f) * scale;
             v.normalModel = Vector3(0.0f, 0.0f, -1.0f);
             v.texcoord = Vector2(x + 1.0f, y + 1.0f) * 0.5f * texScale;
-            v.tangentModel = Vector3(1.0f, 0.0f, 0.0f);
+            v.tangentModel = Vector4(1.0f, 0.0f, 0.0f, 1.0f);
 
             meshData.vertices.push_back(v);
 
@@ -272,6 +303,9 @@ MeshData GeometryGenerator::MakeBox(const float scale)
                          16, 17, 18, 16, 18, 19,    // 왼쪽
                          20, 21, 22, 20, 22, 23 };  // 오른쪽
 
+    // 면마다 UV 방향이 달라서 Tangent는 따로 계산
+    TangentGenerator::Compute(meshData.vertices, meshData.indices);
+
     return meshData;
 }
 
@@ -324,6 +358,8 @@ MeshData GeometryGenerator::MakeCylinder(const float bottomRadius, const float t
         indices.push_back(i + 1);
     }
 
+    TangentGenerator::Compute(meshData.vertices, meshData.indices);
+
     return meshData;
 }
 
@@ -360,8 +396,9 @@ MeshData GeometryGenerator::MakeSphere(const float radius, const int numSlices,
             Vector3 normalOrth = v.normalModel - biTangent.Dot(v.normalModel) * v.normalModel;
             normalOrth.Normalize();
 
-            v.tangentModel = biTangent.Cross(normalOrth);
-            v.tangentModel.Normalize();
+            Vector3 tangent = biTangent.Cross(normalOrth);
+            tangent.Normalize();
+            v.tangentModel = Vector4(tangent.x, tangent.y, tangent.z, 1.0f);
 
             vertices.push_back(v);
         }
@@ -45,6 +45,7 @@ namespace Graphics {
 	ComPtr<ID3D11InputLayout> basicIL;
 	ComPtr<ID3D11InputLayout> samplingIL;
 	ComPtr<ID3D11InputLayout> skyboxIL;
+	ComPtr<ID3D11InputLayout> depthOnlyIL;
 	ComPtr<ID3D11InputLayout> postProcessingIL;
 
 	// Blend States
@@ -199,12 +200,8 @@ void Graphics::InitDepthStencilStates(ComPtr<ID3D11Device>& device)
 void Graphics::InitShaders(ComPtr<ID3D11Device>& device)
 {
 	// Input Layouts
-	vector<D3D11_INPUT_ELEMENT_DESC> basicIE{
-		{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
-		{"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0},
-		{"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 24, D3D11_INPUT_PER_VERTEX_DATA, 0},
-		{"TANGENT", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 32, D3D11_INPUT_PER_VERTEX_DATA, 0},
-	};
+	// Model은 QuantizedVertex 사용 (Shader에서 DecodeVertex로 복원)
+	vector<D3D11_INPUT_ELEMENT_DESC> basicIE = D3D11Utils::GetInputElements<QuantizedVertex>();
 
 	vector<D3D11_INPUT_ELEMENT_DESC> samplingIE{
 		{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
@@ -212,12 +209,8 @@ void Graphics::InitShaders(ComPtr<ID3D11Device>& device)
 		{"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 24, D3D11_INPUT_PER_VERTEX_DATA, 0},
 	};
 
-	vector<D3D11_INPUT_ELEMENT_DESC> skyboxIE{
-		{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
-		{"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0},
-		{"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 24, D3D11_INPUT_PER_VERTEX_DATA, 0},
-		{"TANGENT", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 32, D3D11_INPUT_PER_VERTEX_DATA, 0},
-	};
+	vector<D3D11_INPUT_ELEMENT_DESC> skyboxIE = D3D11Utils::GetInputElements<QuantizedVertex>();
+	vector<D3D11_INPUT_ELEMENT_DESC> depthOnlyIE = D3D11Utils::GetInputElements<QuantizedPosition>();
 
 	// Shaders
 	D3D11Utils::CreateVertexShaderAndInputLayout(device, L"BasicVS.hlsl",
@@ -229,7 +222,7 @@ void Graphics::InitShaders(ComPtr<ID3D11Device>& device)
 	D3D11Utils::CreateVertexShaderAndInputLayout(device, L"SkyboxVS.hlsl",
 												 skyboxIE, skyboxVS, skyboxIL);
 	D3D11Utils::CreateVertexShaderAndInputLayout(device, L"DepthOnlyVS.hlsl",
-												 basicIE, depthOnlyVS, skyboxIL);
+												 depthOnlyIE, depthOnlyVS, depthOnlyIL);
 
 	D3D11Utils::CreateGeometryShader(device, L"NormalGS.hlsl", normalGS);
 
@@ -281,6 +274,7 @@ void Graphics::InitPipelineStates(ComPtr<ID3D11Device>& device)
 	stencilMaskPSO = defaultSolidPSO;
 	stencilMaskPSO.m_depthStencilState = maskDSS;
 	stencilMaskPSO.m_stencilRef = 1;
+	stencilMaskPSO.m_inputLayout = depthOnlyIL;
 	stencilMaskPSO.m_vertexShader = depthOnlyVS;
 	stencilMaskPSO.m_pixelShader = depthOnlyPS;
 
@@ -337,6 +331,7 @@ void Graphics::InitPipelineStates(ComPtr<ID3D11Device>& device)
 
 	// depthOnlyPSO
 	depthOnlyPSO = defaultSolidPSO;
+	depthOnlyPSO.m_inputLayout = depthOnlyIL;
 	depthOnlyPSO.m_vertexShader = depthOnlyVS;
 	depthOnlyPSO.m_pixelShader = depthOnlyPS;
 
@@ -53,6 +53,7 @@ namespace Graphics {
 	extern Microsoft::WRL::ComPtr<ID3D11InputLayout> basicIL;
 	extern Microsoft::WRL::ComPtr<ID3D11InputLayout> samplingIL;
 	extern Microsoft::WRL::ComPtr<ID3D11InputLayout> skyboxIL;
+	extern Microsoft::WRL::ComPtr<ID3D11InputLayout> depthOnlyIL; // Position Stream만
 	extern Microsoft::WRL::ComPtr<ID3D11InputLayout> postProcessingIL;
 
 	// Blend States
@@ -49,7 +49,7 @@ void ImageFilter::Render(Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context) c
 	context->PSSetConstantBuffers(0, 1, m_constBuffer.GetAddressOf());
 }
 
-void ImageFilter::SetShaderResources(const std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>>& srvs)
+void ImageFilter::SetShaderResources(ArrayView<const Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> srvs)
 {
 	m_SRVs.clear();
 	for (const Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv : srvs)
@@ -58,7 +58,7 @@ void ImageFilter::SetShaderResources(const std::vector<Microsoft::WRL::ComPtr<ID
 	}
 }
 
-void ImageFilter::SetRenderTarget(const std::vector<Microsoft::WRL::ComPtr<ID3D11RenderTargetView>>& rtvs)
+void ImageFilter::SetRenderTarget(ArrayView<const Microsoft::WRL::ComPtr<ID3D11RenderTargetView>> rtvs)
 {
 	m_RTVs.clear();
 	for (const Microsoft::WRL::ComPtr<ID3D11RenderTargetView> rtv : rtvs)
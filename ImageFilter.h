@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ArrayView.h"
 #include "D3D11Utils.h"
 #include "GeometryGenerator.h"
 #include "Mesh.h"
@@ -23,9 +24,9 @@ public:
 
 	void Render(Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context) const;
 
-	void SetShaderResources(const std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> &srvs);
+	void SetShaderResources(ArrayView<const Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> srvs);
 
-	void SetRenderTarget(const std::vector<Microsoft::WRL::ComPtr<ID3D11RenderTargetView>> &rtvs);
+	void SetRenderTarget(ArrayView<const Microsoft::WRL::ComPtr<ID3D11RenderTargetView>> rtvs);
 
 public:
 	struct ImageFilterConstData {
@@ -33,7 +34,7 @@ public:
 		float dy;
 		float threshold;
 		float strength;
-		float option1; // exposure in CombinePS.hlsl
+		float option1; // exposure in CombinePS.hlsl (PostProcess::UpdateExposure()에서 자동으로 바꿀 수 있음)
 		float option2; // gamma in CombinePS.hlsl;
 		float option3;
 		float option4;
@@ -0,0 +1,310 @@
+#include "ImageLoader.h"
+#include "MappedFile.h"
+#include "MaterialPacker.h"
+#include "PixelConverter.h"
+#include "TextureBaker.h"
+#include "ThreadPool.h"
+
+#include <DirectXTexEXR.h> // Read .exr
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <system_error>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+using namespace std;
+using namespace DirectX;
+
+namespace {
+	void ReadEXRImage(const std::string fileName, std::vector<uint8_t>& image,
+					  int& width, int& height, DXGI_FORMAT& pixelFormat)
+	{
+		const std::wstring wFilename(fileName.begin(), fileName.end());
+
+		TexMetadata metadata;
+		if (FAILED(GetMetadataFromEXRFile(wFilename.c_str(), metadata)))
+		{
+			cout << "Failed to read " << fileName << endl;
+			return;
+		}
+
+		ScratchImage scratchImage;
+		if (FAILED(LoadFromEXRFile(wFilename.c_str(), NULL, scratchImage)))
+		{
+			cout << "Failed to read " << fileName << endl;
+			return;
+		}
+
+		width = static_cast<int>(metadata.width);
+		height = static_cast<int>(metadata.height);
+		pixelFormat = metadata.format;
+
+		image.resize(scratchImage.GetPixelsSize());
+		memcpy(image.data(), scratchImage.GetPixels(), image.size()); // image에 처리한 scratchImage를 저장
+	}
+
+	void ReadStbImage(const std::string filename, std::vector<uint8_t>& image,
+					  int& width, int& height)
+	{
+		// 파일을 매핑해서 Decoder가 바로 읽음 (stdio 버퍼 복사 X)
+		MappedFile file;
+		if (!file.Open(filename) || file.GetSize() > size_t(INT_MAX))
+		{
+			cout << "Failed to read " << filename << endl;
+			width = height = 0;
+			return;
+		}
+
+		int channels;
+		unsigned char* img = stbi_load_from_memory(file.GetData(), int(file.GetSize()),
+												   &width, &height, &channels, 0);
+		if (!img)
+		{
+			cout << "Failed to decode " << filename << ": " << stbi_failure_reason() << endl;
+			width = height = 0;
+			return;
+		}
+
+		if (channels < 1 || channels > 4)
+		{
+			cout << "Cannot read " << channels << " channels" << endl;
+			width = height = 0;
+			stbi_image_free(img);
+			return;
+		}
+
+		// 4채널로 만들어서 복사
+		image.resize(size_t(width) * height * 4);
+		PixelConverter::ExpandToRGBA8(img, channels, size_t(width) * height, image.data());
+
+		stbi_image_free(img);
+	}
+
+	string CanonicalPath(const string& fileName)
+	{
+		error_code ec;
+		const filesystem::path path = filesystem::weakly_canonical(fileName, ec);
+		string result = ec ? fileName : path.generic_string();
+
+#ifdef _WIN32
+		// Windows는 경로의 대소문자를 구분하지 않음
+		std::transform(result.begin(), result.end(), result.begin(), ::tolower);
+#endif
+
+		return result;
+	}
+
+	// ORM(AO + Roughness + Metallic)을 제외한 Texture 종류
+	struct ImageSlot {
+		const string MeshData::*fileName;
+		shared_ptr<const ImageData> MeshImages::*image;
+		bool useSRGB;
+	};
+
+	const ImageSlot slots[] = {
+		{ &MeshData::albedoTextureFileName, &MeshImages::albedo, true },
+		{ &MeshData::emissiveTextureFileName, &MeshImages::emissive, true },
+		{ &MeshData::normalTextureFileName, &MeshImages::normal, false },
+		{ &MeshData::heightTextureFileName, &MeshImages::height, false },
+	};
+	const size_t numSlots = sizeof(slots) / sizeof(slots[0]);
+
+	bool IsEXR(const string& fileName)
+	{
+		if (fileName.size() < 3)
+		{
+			return false;
+		}
+
+		string ext(fileName.end() - 3, fileName.end());
+		std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+		return ext == "exr";
+	}
+
+	bool HasORM(const MeshData& meshData)
+	{
+		return !meshData.aoTextureFileName.empty() || !meshData.roughnessTextureFileName.empty() ||
+			   !meshData.metallicTextureFileName.empty();
+	}
+}
+
+size_t ImageData::GetRowPitch(const int mip) const
+{
+	const size_t blockCount = size_t(GetMipWidth(mip) + 3) / 4;
+
+	switch (format)
+	{
+	case DXGI_FORMAT_R8G8B8A8_UNORM:
+	case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+		return size_t(GetMipWidth(mip)) * 4;
+	case DXGI_FORMAT_R16G16B16A16_FLOAT:
+		return size_t(GetMipWidth(mip)) * 8;
+	case DXGI_FORMAT_BC1_UNORM:
+	case DXGI_FORMAT_BC1_UNORM_SRGB:
+	case DXGI_FORMAT_BC4_UNORM:
+		return blockCount * 8;
+	case DXGI_FORMAT_BC5_UNORM:
+	case DXGI_FORMAT_BC7_UNORM:
+	case DXGI_FORMAT_BC7_UNORM_SRGB:
+		return blockCount * 16;
+	default:
+		return 0;
+	}
+}
+
+size_t ImageData::GetMipSize(const int mip) const
+{
+	const int rows = IsBlockCompressed(format) ? (GetMipHeight(mip) + 3) / 4 : GetMipHeight(mip);
+	return GetRowPitch(mip) * rows;
+}
+
+size_t ImageData::GetMipOffset(const int mip) const
+{
+	size_t offset = 0;
+	for (int i = 0; i < mip; i++)
+	{
+		offset += GetMipSize(i);
+	}
+	return offset;
+}
+
+bool ImageData::IsBlockCompressed(const DXGI_FORMAT format)
+{
+	return (format >= DXGI_FORMAT_BC1_TYPELESS && format <= DXGI_FORMAT_BC5_SNORM) ||
+		   (format >= DXGI_FORMAT_BC6H_TYPELESS && format <= DXGI_FORMAT_BC7_UNORM_SRGB);
+}
+
+bool ImageData::IsSRGB(const DXGI_FORMAT format)
+{
+	return format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB || format == DXGI_FORMAT_BC1_UNORM_SRGB ||
+		   format == DXGI_FORMAT_BC7_UNORM_SRGB;
+}
+
+void ImageLoader::ReadImage(const std::string& fileName, const bool useSRGB, ImageData& image)
+{
+	if (TextureBaker::ReadBaked(fileName, useSRGB, image))
+	{
+		return;
+	}
+
+	ReadSourceImage(fileName, useSRGB, image);
+}
+
+void ImageLoader::ReadSourceImage(const std::string& fileName, const bool useSRGB, ImageData& image)
+{
+	image.mipLevels = 0;
+	image.format = useSRGB ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB // SRGB를 붙이면 DirectX 내부적으로
+						   : DXGI_FORMAT_R8G8B8A8_UNORM;	 // HDR과 같은 선상으로 Gamma correction 처리
+
+	if (IsEXR(fileName))
+	{
+		ReadEXRImage(fileName, image.pixels, image.width, image.height, image.format);
+	}
+	else
+	{
+		ReadStbImage(fileName, image.pixels, image.width, image.height);
+	}
+}
+
+void ImageLoader::ReadORM(const std::string& aoFileName, const std::string& roughnessFileName,
+						  const std::string& metallicFileName, ImageData& image)
+{
+	MaterialPacker::ReadPacked(MaterialPacker::GetORMSources(aoFileName, roughnessFileName, metallicFileName),
+							   image);
+}
+
+std::string ImageLoader::MakeKey(const std::string& fileName, const bool useSRGB)
+{
+	// .exr은 Float 그대로, 나머지는 RGBA8로 변환
+	return CanonicalPath(fileName) + (useSRGB ? "|srgb" : "|linear") +
+		   (IsEXR(fileName) ? "|rgba16f" : "|rgba8");
+}
+
+std::string ImageLoader::MakeORMKey(const std::string& aoFileName, const std::string& roughnessFileName,
+									const std::string& metallicFileName)
+{
+	const string ao = aoFileName.empty() ? "" : CanonicalPath(aoFileName);
+	const string roughness = roughnessFileName.empty() ? "" : CanonicalPath(roughnessFileName);
+	const string metallic = metallicFileName.empty() ? "" : CanonicalPath(metallicFileName);
+	return ao + "+" + roughness + "+" + metallic + "|linear|orm";
+}
+
+std::shared_ptr<const ImageData> ImageLoader::ReadImageCached(const std::string& fileName,
+															  const bool useSRGB)
+{
+	return GetCache().GetOrCreate(MakeKey(fileName, useSRGB), [&]() {
+		shared_ptr<ImageData> image = make_shared<ImageData>();
+		ReadImage(fileName, useSRGB, *image);
+		return image;
+	});
+}
+
+std::shared_ptr<const ImageData> ImageLoader::ReadORMCached(const std::string& aoFileName,
+															const std::string& roughnessFileName,
+															const std::string& metallicFileName)
+{
+	const string key = MakeORMKey(aoFileName, roughnessFileName, metallicFileName);
+	return GetCache().GetOrCreate(key, [&]() {
+		shared_ptr<ImageData> image = make_shared<ImageData>();
+		ReadORM(aoFileName, roughnessFileName, metallicFileName, *image);
+		return image;
+	});
+}
+
+ResourceCache<const ImageData>& ImageLoader::GetCache()
+{
+	static ResourceCache<const ImageData> cache;
+	return cache;
+}
+
+void ImageLoader::ReadMeshImages(const MeshData& meshData, MeshImages& images, const SkipFunc& skip)
+{
+	// 마지막 하나는 ORM
+	// 여러 Mesh가 같은 파일을 쓰면 먼저 시작한 쪽만 Decoding하고 나머지는 기다렸다가 공유
+	ThreadPool::GetInstance().ParallelFor(0, numSlots + 1, [&](size_t i) {
+		if (i < numSlots)
+		{
+			const string& fileName = meshData.*slots[i].fileName;
+			if (!fileName.empty() && !(skip && skip(MakeKey(fileName, slots[i].useSRGB))))
+			{
+				images.*slots[i].image = ReadImageCached(fileName, slots[i].useSRGB);
+			}
+		}
+		else if (HasORM(meshData))
+		{
+			const string key = MakeORMKey(meshData.aoTextureFileName, meshData.roughnessTextureFileName,
+										  meshData.metallicTextureFileName);
+			if (!(skip && skip(key)))
+			{
+				images.orm = ReadORMCached(meshData.aoTextureFileName, meshData.roughnessTextureFileName,
+										   meshData.metallicTextureFileName);
+			}
+		}
+	});
+}
+
+void ImageLoader::GetMeshImageKeys(const MeshData& meshData, const MeshImages& images,
+								   std::vector<KeyedImage>& keyedImages)
+{
+	for (const ImageSlot& slot : slots)
+	{
+		const string& fileName = meshData.*slot.fileName;
+		if (!fileName.empty())
+		{
+			keyedImages.push_back({ MakeKey(fileName, slot.useSRGB), images.*slot.image });
+		}
+	}
+
+	if (HasORM(meshData))
+	{
+		keyedImages.push_back({ MakeORMKey(meshData.aoTextureFileName, meshData.roughnessTextureFileName,
+										   meshData.metallicTextureFileName),
+								images.orm });
+	}
+}
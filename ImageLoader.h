@@ -0,0 +1,94 @@
+#pragma once
+
+#include <dxgiformat.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MeshData.h"
+#include "ResourceCache.h"
+
+// CPU에서 Decoding한 Texture (GPU 자원은 D3D11Utils::CreateTexture로 생성)
+// D3D Device 없이 Worker Thread에서 만들 수 있음
+struct ImageData {
+	int width = 0;
+	int height = 0;
+	DXGI_FORMAT format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	std::vector<uint8_t> pixels;
+
+	// 0이면 pixels에 Mip 0만 있고 GPU에서 GenerateMips
+	// 아니면 Mip 0부터 mipLevels개가 차례로 들어있음 (TextureBaker로 미리 만든 것, BC 압축 가능)
+	int mipLevels = 0;
+
+	bool IsEmpty() const { return pixels.empty(); }
+	bool HasMips() const { return mipLevels > 0; }
+
+	int GetMipWidth(const int mip) const { return width >> mip > 0 ? width >> mip : 1; }
+	int GetMipHeight(const int mip) const { return height >> mip > 0 ? height >> mip : 1; }
+
+	// 가로 한 줄(BC Format은 4x4 Block 한 줄)의 Byte 수, 지원하지 않는 Format이면 0
+	size_t GetRowPitch(const int mip) const;
+	size_t GetMipSize(const int mip) const;
+	size_t GetMipOffset(const int mip) const;
+
+	static bool IsBlockCompressed(const DXGI_FORMAT format);
+	static bool IsSRGB(const DXGI_FORMAT format);
+};
+
+// Mesh 하나가 사용하는 Texture들 (같은 파일을 쓰는 Mesh끼리 공유)
+// 파일 경로가 없거나 읽지 않고 건너뛴 것은 nullptr
+struct MeshImages {
+	std::shared_ptr<const ImageData> albedo;
+	std::shared_ptr<const ImageData> emissive;
+	std::shared_ptr<const ImageData> normal;
+	std::shared_ptr<const ImageData> height;
+	std::shared_ptr<const ImageData> orm; // Red: Occlusion, Green: Roughness, Blue: Metallic
+};
+
+// GPU Texture를 만들 때 사용 (image가 nullptr이면 읽지 않고 건너뛴 것)
+struct KeyedImage {
+	std::string key;
+	std::shared_ptr<const ImageData> image;
+};
+
+class ImageLoader {
+public:
+	// true를 반환하는 key는 읽지 않음 (예: 이미 GPU에 올라가 있는 Texture)
+	using SkipFunc = std::function<bool(const std::string &key)>;
+
+	// TextureBaker로 만든 최신 .dds가 있으면 그것을 읽음 (Mipmap 포함)
+	// 없으면 ReadSourceImage()
+	static void ReadImage(const std::string &fileName, const bool useSRGB, ImageData &image);
+
+	// 원본 파일만 읽음, 항상 4채널로 변환, .exr은 R16G16B16A16_FLOAT 그대로
+	static void ReadSourceImage(const std::string &fileName, const bool useSRGB, ImageData &image);
+
+	// AO, Roughness, Metallic을 하나의 Texture에 넣음 (MaterialPacker, 해상도가 달라도 됨)
+	static void ReadORM(const std::string &aoFileName, const std::string &roughnessFileName,
+						const std::string &metallicFileName, ImageData &image);
+
+	// 같은 결과가 되는 파일은 같은 key (정규화한 경로 + sRGB + Format)
+	static std::string MakeKey(const std::string &fileName, const bool useSRGB);
+	static std::string MakeORMKey(const std::string &aoFileName, const std::string &roughnessFileName,
+								  const std::string &metallicFileName);
+
+	// MakeKey()로 공유, 사용하는 곳이 있는 동안은 다시 Decoding하지 않음
+	static std::shared_ptr<const ImageData> ReadImageCached(const std::string &fileName,
+															 const bool useSRGB);
+	static std::shared_ptr<const ImageData> ReadORMCached(const std::string &aoFileName,
+														   const std::string &roughnessFileName,
+														   const std::string &metallicFileName);
+
+	// meshData의 Texture 경로들을 모두 읽음 (Albedo, Emissive는 sRGB)
+	static void ReadMeshImages(const MeshData &meshData, MeshImages &images,
+							   const SkipFunc &skip = nullptr);
+
+	// ReadMeshImages()로 읽은 이미지들과 각각의 key
+	static void GetMeshImageKeys(const MeshData &meshData, const MeshImages &images,
+								 std::vector<KeyedImage> &keyedImages);
+
+	static ResourceCache<const ImageData> &GetCache();
+};
@@ -0,0 +1,105 @@
+#include "IndexNarrower.h"
+
+#include <emmintrin.h>
+
+#include <algorithm>
+
+using namespace std;
+
+std::vector<IndexChunk> IndexNarrower::Split(const uint32_t* indices, const size_t indexCount)
+{
+	vector<IndexChunk> chunks;
+	if (indexCount == 0)
+	{
+		return chunks;
+	}
+
+	IndexChunk current;
+	uint32_t chunkMin = UINT32_MAX;
+	uint32_t chunkMax = 0;
+
+	// 삼각형이 두 구간에 걸치지 않도록 3개씩 확인
+	for (size_t i = 0; i < indexCount; i += 3)
+	{
+		const size_t count = min(size_t(3), indexCount - i);
+
+		uint32_t triangleMin = indices[i];
+		uint32_t triangleMax = indices[i];
+		for (size_t k = 1; k < count; k++)
+		{
+			triangleMin = min(triangleMin, indices[i + k]);
+			triangleMax = max(triangleMax, indices[i + k]);
+		}
+
+		const uint32_t newMin = min(chunkMin, triangleMin);
+		const uint32_t newMax = max(chunkMax, triangleMax);
+
+		if (current.indexCount > 0 && newMax - newMin >= MAX_VERTEX_RANGE)
+		{
+			current.baseVertex = chunkMin;
+			chunks.push_back(current);
+
+			current.indexOffset = uint32_t(i);
+			current.indexCount = 0;
+			chunkMin = triangleMin;
+			chunkMax = triangleMax;
+		}
+		else
+		{
+			chunkMin = newMin;
+			chunkMax = newMax;
+		}
+
+		current.indexCount += uint32_t(count);
+	}
+
+	current.baseVertex = chunkMin;
+	chunks.push_back(current);
+
+	return chunks;
+}
+
+void IndexNarrower::Narrow(const uint32_t* indices, const size_t indexCount, const uint32_t baseVertex,
+						   uint16_t* output)
+{
+	// SSE2에는 부호 없는 Pack이 없으므로 32768을 빼서 부호 있는 범위로 Pack한 뒤 최상위 Bit를 되돌림
+	const __m128i bias = _mm_set1_epi32(int(baseVertex) + 32768);
+	const __m128i flip = _mm_set1_epi16(short(0x8000));
+
+	size_t i = 0;
+	for (; i + 8 <= indexCount; i += 8)
+	{
+		const __m128i a = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(indices + i)), bias);
+		const __m128i b = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(indices + i + 4)), bias);
+		const __m128i packed = _mm_xor_si128(_mm_packs_epi32(a, b), flip);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(output + i), packed);
+	}
+
+	for (; i < indexCount; i++)
+	{
+		output[i] = uint16_t(indices[i] - baseVertex);
+	}
+}
+
+bool IndexNarrower::Build(const uint32_t* indices, const size_t indexCount, std::vector<uint16_t>& output,
+						  std::vector<IndexChunk>& chunks)
+{
+	chunks = Split(indices, indexCount);
+
+	// 구간당 평균 삼각형이 너무 적으면 Draw Call 증가가 절약보다 큼
+	const size_t minTrianglesPerChunk = 1024;
+	if (chunks.size() > 1 && chunks.size() * minTrianglesPerChunk > indexCount / 3)
+	{
+		chunks.clear();
+		output.clear();
+		return false;
+	}
+
+	output.resize(indexCount);
+	for (const IndexChunk& chunk : chunks)
+	{
+		Narrow(indices + chunk.indexOffset, chunk.indexCount, chunk.baseVertex, output.data() + chunk.indexOffset);
+	}
+
+	return true;
+}
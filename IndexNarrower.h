@@ -0,0 +1,50 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Index Buffer에서 같은 BaseVertex로 그리는 구간
+// DrawIndexed(indexCount, indexOffset, baseVertex)
+struct IndexChunk {
+	uint32_t indexOffset = 0;
+	uint32_t indexCount = 0;
+	uint32_t baseVertex = 0;
+};
+
+// 32-bit Index를 16-bit로 줄임 (Index 메모리/대역폭 절반)
+// Vertex가 65536개보다 많으면 삼각형 순서대로 구간을 나누고 구간마다 BaseVertex를 빼서 16-bit에 맞춤
+class IndexNarrower {
+public:
+	static const uint32_t MAX_VERTEX_RANGE = 65536;
+
+	// 각 구간이 참조하는 Vertex 범위(max - min + 1)가 MAX_VERTEX_RANGE 이하가 되도록 나눔
+	static std::vector<IndexChunk> Split(const uint32_t *indices, const size_t indexCount);
+
+	// output[i] = indices[i] - baseVertex (SSE2, 결과가 16-bit에 들어간다고 가정)
+	static void Narrow(const uint32_t *indices, const size_t indexCount, const uint32_t baseVertex,
+					   uint16_t *output);
+
+	// Split + Narrow, 구간이 너무 잘게 나뉘면(Draw Call 증가) false를 반환하고 32-bit를 그대로 사용
+	static bool Build(const uint32_t *indices, const size_t indexCount, std::vector<uint16_t> &output,
+					  std::vector<IndexChunk> &chunks);
+
+	// Index Buffer의 [indexOffset, indexOffset + indexCount) 구간을 chunks 경계에서 나눠
+	// 겹치는 구간마다 draw(indexCount, indexOffset, baseVertex) 호출 (Model::DrawIndexRange)
+	template <typename T_DRAW>
+	static void ForEachChunkRange(const std::vector<IndexChunk> &chunks, const uint32_t indexOffset,
+								  const uint32_t indexCount, T_DRAW &&draw)
+	{
+		const uint32_t end = indexOffset + indexCount;
+		for (const IndexChunk &chunk : chunks)
+		{
+			const uint32_t begin = std::max(indexOffset, chunk.indexOffset);
+			const uint32_t finish = std::min(end, chunk.indexOffset + chunk.indexCount);
+			if (begin < finish)
+			{
+				draw(finish - begin, begin, chunk.baseVertex);
+			}
+		}
+	}
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+// 여러 Thread가 Push하고 한 Thread(Render Thread)만 Pop하는 Lock-Free Queue
+// Push는 Stack에 CAS로 쌓고, Pop하는 쪽이 Stack 전체를 한 번에 가져와서 순서를 뒤집음
+// => Pop끼리 경쟁하지 않으므로 ABA 문제가 없고, Push 순서대로 나옴
+template <typename T>
+class LockFreeQueue {
+public:
+	LockFreeQueue() = default;
+	~LockFreeQueue()
+	{
+		T value;
+		while (TryPop(value))
+		{
+		}
+	}
+
+	LockFreeQueue(const LockFreeQueue &) = delete;
+	LockFreeQueue &operator=(const LockFreeQueue &) = delete;
+
+	void Push(T value)
+	{
+		Node *node = new Node{ std::move(value), m_head.load(std::memory_order_relaxed) };
+		while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release,
+											 std::memory_order_relaxed))
+		{
+		}
+	}
+
+	// Pop하는 Thread에서만 호출
+	bool TryPop(T &value)
+	{
+		if (!m_pending)
+		{
+			Node *stack = m_head.exchange(nullptr, std::memory_order_acquire);
+			while (stack)
+			{
+				Node *next = stack->next;
+				stack->next = m_pending;
+				m_pending = stack;
+				stack = next;
+			}
+		}
+
+		if (!m_pending)
+		{
+			return false;
+		}
+
+		Node *node = m_pending;
+		m_pending = node->next;
+		value = std::move(node->value);
+		delete node;
+
+		return true;
+	}
+
+private:
+	struct Node {
+		T value;
+		Node *next;
+	};
+
+	std::atomic<Node *> m_head{ nullptr };
+	Node *m_pending = nullptr; // Pop하는 Thread 전용, 가장 먼저 Push된 것이 앞
+};
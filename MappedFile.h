@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 읽기 전용으로 메모리에 매핑한 파일 (Windows: FileMapping, Linux: mmap)
+class MappedFile {
+public:
+	MappedFile() {}
+	~MappedFile();
+
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	bool Open(const std::string &fileName);
+	void Close();
+
+	bool IsOpen() const { return m_data != nullptr; }
+	const uint8_t *GetData() const { return m_data; }
+	size_t GetSize() const { return m_size; }
+
+private:
+	const uint8_t *m_data = nullptr;
+	size_t m_size = 0;
+
+#ifdef _WIN32
+	void *m_file = nullptr;
+	void *m_mapping = nullptr;
+#else
+	int m_fd = -1;
+#endif
+};
@@ -0,0 +1,351 @@
+#include "MaterialPacker.h"
+#include "PixelConverter.h"
+#include "Stats.h"
+#include "TextureBaker.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <system_error>
+#include <unordered_set>
+
+using namespace std;
+
+namespace {
+	// 한 방향 Resample 가중치 (dst의 texel 하나에 들어가는 src texel들)
+	struct ResampleTap {
+		int index;
+		float weight;
+	};
+
+	vector<vector<ResampleTap>> MakeResampleTaps(const int srcSize, const int dstSize)
+	{
+		vector<vector<ResampleTap>> taps(dstSize);
+		const float scale = float(srcSize) / float(dstSize);
+
+		if (dstSize <= srcSize)
+		{
+			// 축소: 겹치는 길이만큼 평균 (Box)
+			for (int i = 0; i < dstSize; i++)
+			{
+				const float begin = i * scale;
+				const float end = (i + 1) * scale;
+				for (int s = int(begin); s < srcSize && float(s) < end; s++)
+				{
+					const float overlap = min(end, float(s + 1)) - max(begin, float(s));
+					if (overlap > 1e-6f)
+					{
+						taps[i].push_back({ s, overlap / scale });
+					}
+				}
+			}
+		}
+		else
+		{
+			// 확대: texel 중심끼리 맞춰서 Bilinear (가장자리는 Clamp)
+			for (int i = 0; i < dstSize; i++)
+			{
+				const float x = (i + 0.5f) * scale - 0.5f;
+				const float x0 = floor(x);
+				const float t = x - x0;
+				const int i0 = std::clamp(int(x0), 0, srcSize - 1);
+				const int i1 = std::clamp(int(x0) + 1, 0, srcSize - 1);
+				taps[i].push_back({ i0, 1.0f - t });
+				taps[i].push_back({ i1, t });
+			}
+		}
+
+		return taps;
+	}
+
+	const char channelNames[] = "rgba";
+}
+
+ChannelSources MaterialPacker::GetORMSources(const std::string& aoFileName,
+											 const std::string& roughnessFileName,
+											 const std::string& metallicFileName)
+{
+	const bool isGLTF = !metallicFileName.empty() && metallicFileName == roughnessFileName;
+
+	ChannelSources sources;
+	sources[0] = { aoFileName, 0, 255 };
+	sources[1] = { roughnessFileName, isGLTF ? 1 : 0, 255 };
+	sources[2] = { metallicFileName, isGLTF ? 2 : 0, 255 };
+	sources[3] = { "", 0, 255 };
+	return sources;
+}
+
+bool MaterialPacker::Pack(const ChannelSources& sources, ImageData& image)
+{
+	// 같은 파일은 한 번만 읽음 (GLTF는 Roughness와 Metallic이 같은 파일)
+	vector<string> fileNames;
+	vector<ImageData> sourceImages;
+	int sourceIndices[4] = { -1, -1, -1, -1 };
+	for (int c = 0; c < 4; c++)
+	{
+		const string& fileName = sources[c].fileName;
+		if (fileName.empty())
+		{
+			continue;
+		}
+
+		auto it = std::find(fileNames.begin(), fileNames.end(), fileName);
+		if (it == fileNames.end())
+		{
+			fileNames.push_back(fileName);
+			sourceImages.emplace_back();
+			ImageLoader::ReadSourceImage(fileName, false, sourceImages.back());
+
+			if (!sourceImages.back().IsEmpty() && sourceImages.back().format != DXGI_FORMAT_R8G8B8A8_UNORM)
+			{
+				cout << "Cannot pack " << fileName << " (only 8-bit images)" << endl;
+				sourceImages.back() = ImageData();
+			}
+
+			it = fileNames.end() - 1;
+		}
+
+		const int index = int(it - fileNames.begin());
+		if (!sourceImages[index].IsEmpty())
+		{
+			sourceIndices[c] = index;
+		}
+	}
+
+	// 가장 큰 해상도에 맞춤 (작은 쪽을 Resample)
+	int width = 0, height = 0;
+	for (const ImageData& source : sourceImages)
+	{
+		width = max(width, source.width);
+		height = max(height, source.height);
+	}
+
+	if (width == 0 || height == 0)
+	{
+		return false;
+	}
+
+	image.width = width;
+	image.height = height;
+	image.format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	image.mipLevels = 0;
+	image.pixels.resize(size_t(width) * height * 4);
+
+	const uint8_t defaults[4] = { sources[0].defaultValue, sources[1].defaultValue,
+								  sources[2].defaultValue, sources[3].defaultValue };
+	for (size_t i = 0; i < image.pixels.size(); i += 4)
+	{
+		memcpy(&image.pixels[i], defaults, 4);
+	}
+
+	for (int c = 0; c < 4; c++)
+	{
+		if (sourceIndices[c] < 0)
+		{
+			continue;
+		}
+
+		const ImageData& source = sourceImages[sourceIndices[c]];
+		if ((source.width != width || source.height != height) && g_printStats)
+		{
+			cout << "Resampling " << sources[c].fileName << " " << source.width << "x" << source.height
+				 << " -> " << width << "x" << height << endl;
+		}
+
+		ResampleChannel(source.pixels.data(), source.width, source.height, sources[c].channel,
+						image.pixels.data(), width, height, c);
+	}
+
+	return true;
+}
+
+void MaterialPacker::ResampleChannel(const uint8_t* src, const int srcWidth, const int srcHeight,
+									 const int srcChannel, uint8_t* dst, const int dstWidth,
+									 const int dstHeight, const int dstChannel)
+{
+	if (srcWidth == dstWidth && srcHeight == dstHeight)
+	{
+		PixelConverter::PackChannelRGBA8(src, srcChannel, size_t(srcWidth) * srcHeight, dst, dstChannel);
+		return;
+	}
+
+	const vector<vector<ResampleTap>> tapsX = MakeResampleTaps(srcWidth, dstWidth);
+	const vector<vector<ResampleTap>> tapsY = MakeResampleTaps(srcHeight, dstHeight);
+
+	ThreadPool& pool = ThreadPool::GetInstance();
+
+	// 가로 먼저 (srcHeight x dstWidth)
+	vector<float> rows(size_t(srcHeight) * dstWidth);
+	pool.ParallelFor(0, srcHeight, [&](size_t y) {
+		const uint8_t* srcRow = src + y * srcWidth * 4 + srcChannel;
+		float* row = &rows[y * dstWidth];
+		for (int x = 0; x < dstWidth; x++)
+		{
+			float sum = 0.0f;
+			for (const ResampleTap& tap : tapsX[x])
+			{
+				sum += srcRow[tap.index * 4] * tap.weight;
+			}
+			row[x] = sum;
+		}
+	}, 16);
+
+	// 세로
+	pool.ParallelFor(0, dstHeight, [&](size_t y) {
+		uint8_t* dstRow = dst + y * dstWidth * 4 + dstChannel;
+		for (int x = 0; x < dstWidth; x++)
+		{
+			float sum = 0.0f;
+			for (const ResampleTap& tap : tapsY[y])
+			{
+				sum += rows[size_t(tap.index) * dstWidth + x] * tap.weight;
+			}
+			dstRow[x * 4] = uint8_t(std::clamp(sum + 0.5f, 0.0f, 255.0f));
+		}
+	}, 16);
+}
+
+std::string MaterialPacker::GetCachePath(const ChannelSources& sources)
+{
+	filesystem::path directory;
+	string name;
+	int lastUsed = -1;
+	for (int c = 0; c < 4; c++)
+	{
+		if (!sources[c].fileName.empty())
+		{
+			lastUsed = c;
+		}
+	}
+
+	for (int c = 0; c <= lastUsed; c++)
+	{
+		if (c > 0)
+		{
+			name += "+";
+		}
+
+		if (sources[c].fileName.empty())
+		{
+			name += "_";
+			continue;
+		}
+
+		const filesystem::path path(sources[c].fileName);
+		if (directory.empty())
+		{
+			directory = path.parent_path();
+		}
+		name += path.stem().string() + "." + channelNames[std::clamp(sources[c].channel, 0, 3)];
+	}
+
+	return (directory / (name + ".packed.dds")).string();
+}
+
+bool MaterialPacker::IsUpToDate(const ChannelSources& sources)
+{
+	error_code ec;
+	const auto packedTime = filesystem::last_write_time(GetCachePath(sources), ec);
+	if (ec)
+	{
+		return false;
+	}
+
+	// 원본 없이 저장본만 배포한 경우도 사용 (TextureBaker::IsUpToDate()와 같음)
+	for (const ChannelSource& source : sources)
+	{
+		if (source.fileName.empty())
+		{
+			continue;
+		}
+
+		const auto sourceTime = filesystem::last_write_time(source.fileName, ec);
+		if (!ec && sourceTime > packedTime)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool MaterialPacker::ReadPacked(const ChannelSources& sources, ImageData& image)
+{
+	if (IsUpToDate(sources))
+	{
+		ImageData packed;
+		if (TextureBaker::ReadDDS(GetCachePath(sources), packed) && !ImageData::IsSRGB(packed.format))
+		{
+			image = std::move(packed);
+			return true;
+		}
+	}
+
+	if (!Pack(sources, image))
+	{
+		return false;
+	}
+
+	// 저장에 실패해도 이번에는 그대로 사용
+	TextureBaker::GenerateMips(image, TextureRole::ORM);
+	TextureBaker::WriteDDS(GetCachePath(sources), image);
+
+	return true;
+}
+
+bool MaterialPacker::BakeFile(const ChannelSources& sources, const bool force)
+{
+	if (!force && IsUpToDate(sources))
+	{
+		return false;
+	}
+
+	ImageData packed;
+	if (!Pack(sources, packed))
+	{
+		return false;
+	}
+
+	TextureBaker::GenerateMips(packed, TextureRole::ORM);
+
+	ImageData image;
+	const DXGI_FORMAT format = TextureBaker::GetBakedFormat(TextureRole::ORM, packed.width, packed.height);
+	if (ImageData::IsBlockCompressed(format))
+	{
+		TextureBaker::Compress(packed, format, image);
+	}
+	else
+	{
+		image = std::move(packed);
+	}
+
+	return TextureBaker::WriteDDS(GetCachePath(sources), image);
+}
+
+size_t MaterialPacker::BakeFiles(const std::vector<ChannelSources>& items, const bool force)
+{
+	// 여러 Mesh가 같은 Material을 쓰는 경우가 많음
+	vector<const ChannelSources*> uniqueItems;
+	unordered_set<string> paths;
+	for (const ChannelSources& item : items)
+	{
+		if (paths.insert(GetCachePath(item)).second)
+		{
+			uniqueItems.push_back(&item);
+		}
+	}
+
+	atomic<size_t> bakedCount(0);
+	ThreadPool::GetInstance().ParallelFor(0, uniqueItems.size(), [&](size_t i) {
+		if (BakeFile(*uniqueItems[i], force))
+		{
+			bakedCount++;
+		}
+	});
+
+	return bakedCount;
+}
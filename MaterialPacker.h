@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ImageLoader.h"
+
+// 결과 Texture의 채널 하나를 어디서 가져올지
+struct ChannelSource {
+	std::string fileName;	   // 비어있으면 defaultValue로 채움
+	int channel = 0;		   // 원본을 RGBA8로 읽었을 때의 채널
+	uint8_t defaultValue = 255;
+};
+
+using ChannelSources = std::array<ChannelSource, 4>; // RGBA 순서
+
+// 여러 흑백 Texture의 채널을 RGBA8 하나로 합침 (Bind/Sample 횟수를 줄이기 위해)
+// 해상도가 다르면 가장 큰 것에 맞춰 Resample (축소는 Box, 확대는 Bilinear)
+// 결과는 Mipmap과 함께 원본 옆에 .packed.dds로 저장해두고 다음부터 읽기만 함
+// D3D Device를 사용하지 않음 (Linux에서도 빌드/실행 가능)
+class MaterialPacker {
+public:
+	// Red: Occlusion, Green: Roughness, Blue: Metallic (GLTF의 occlusion/metallicRoughness와 같은 배치)
+	// Roughness와 Metallic이 같은 파일이면 GLTF처럼 이미 G/B에 들어있는 것으로 봄
+	static ChannelSources GetORMSources(const std::string &aoFileName, const std::string &roughnessFileName,
+										const std::string &metallicFileName);
+
+	// RGBA8 Mip 0만 만듦, 읽은 파일이 하나도 없으면 false
+	static bool Pack(const ChannelSources &sources, ImageData &image);
+
+	// RGBA8 src의 srcChannel을 크기를 바꿔서 RGBA8 dst의 dstChannel에 넣음
+	static void ResampleChannel(const uint8_t *src, const int srcWidth, const int srcHeight,
+								const int srcChannel, uint8_t *dst, const int dstWidth,
+								const int dstHeight, const int dstChannel);
+
+	// 첫 번째 원본 파일이 있는 폴더에 원본 이름과 채널을 이어서 만든 이름 (예: ao.r+mr.g+mr.b.packed.dds)
+	static std::string GetCachePath(const ChannelSources &sources);
+
+	// 저장된 것이 모든 원본보다 나중에 만들어졌는지
+	static bool IsUpToDate(const ChannelSources &sources);
+
+	// 최신 저장본이 있으면 읽고, 없으면 Pack() + Mipmap 생성 후 저장 (실행 중에는 압축하지 않음)
+	static bool ReadPacked(const ChannelSources &sources, ImageData &image);
+
+	// BakeTextures용, 가능하면 BC7로 압축해서 저장 (force가 아니면 최신인 것은 건너뜀)
+	static bool BakeFile(const ChannelSources &sources, const bool force = false);
+
+	// 같은 저장 경로는 한 번만, 병렬 처리, 새로 저장한 개수 반환
+	static size_t BakeFiles(const std::vector<ChannelSources> &items, const bool force = false);
+};
@@ -6,31 +6,59 @@
 #include <wrl/client.h>
 
 #include <iostream>
+#include <memory>
 #include <vector>
 
+#include "ConstantBuffers.h"
+#include "IndexNarrower.h"
+#include "MeshBVH.h"
+#include "MeshData.h"
+#include "Meshlet.h"
+#include "TextureCache.h"
+
 struct Mesh {
 	Microsoft::WRL::ComPtr<ID3D11Buffer> vertexBuffer;
 	Microsoft::WRL::ComPtr<ID3D11Buffer> indexBuffer;
 
-	Microsoft::WRL::ComPtr<ID3D11Buffer> vertexConstBuffer;
-	Microsoft::WRL::ComPtr<ID3D11Buffer> pixelConstBuffer;
+	// Depth Only/Shadow Pass용 (QuantizedPosition, Quantized Vertex를 쓸 때만)
+	Microsoft::WRL::ComPtr<ID3D11Buffer> positionBuffer;
+	UINT positionStride = 0;
+
+	// QuantizedVertex 복원용 (stride가 sizeof(QuantizedVertex)일 때만 사용)
+	QuantizationConstants quantizationConstsCPU;
+	Microsoft::WRL::ComPtr<ID3D11Buffer> quantizationConstBuffer;
 
-	Microsoft::WRL::ComPtr<ID3D11Texture2D> albedoTexture;
-	Microsoft::WRL::ComPtr<ID3D11Texture2D> emissiveTexture;
-	Microsoft::WRL::ComPtr<ID3D11Texture2D> normalTexture;
-	Microsoft::WRL::ComPtr<ID3D11Texture2D> heightTexture;
-	Microsoft::WRL::ComPtr<ID3D11Texture2D> aoTexture;
-	Microsoft::WRL::ComPtr<ID3D11Texture2D> metallicRoughnessTexture;
+	// TextureCache에서 공유 (SRV는 Bind용으로 복사해둔 것)
+	std::shared_ptr<const TextureResource> albedoTexture;
+	std::shared_ptr<const TextureResource> emissiveTexture;
+	std::shared_ptr<const TextureResource> normalTexture;
+	std::shared_ptr<const TextureResource> heightTexture;
+	std::shared_ptr<const TextureResource> ormTexture; // Red: Occlusion, Green: Roughness, Blue: Metallic
 
 	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> albedoSRV;
 	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> emissiveSRV;
 	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> normalSRV;
 	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> heightSRV;
-	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> aoSRV;
-	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> metallicRoughnessSRV;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> ormSRV;
+
+	// R16_UINT이면 indexChunks의 구간마다 baseVertex를 더해서 그림 (Model::DrawIndexRange)
+	DXGI_FORMAT indexFormat = DXGI_FORMAT_R32_UINT;
+	std::vector<IndexChunk> indexChunks;
 
 	UINT indexCount = 0;
 	UINT vertexCount = 0;
 	UINT stride = 0;
 	UINT offset = 0;
+
+	// Index Buffer 안의 LOD별 범위 (LOD 0부터)
+	std::vector<MeshLodRange> lods;
+
+	// Model Space
+	MeshBounds bounds;
+
+	// Cluster Culling용 (Index Buffer를 연속 구간으로 나눈 것)
+	std::vector<Meshlet> meshlets;
+
+	// Picking용 LOD 0 삼각형 BVH (Model Space, CPU 메모리)
+	MeshBVH bvh;
 };
\ No newline at end of file
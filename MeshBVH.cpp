@@ -0,0 +1,232 @@
+#include "MeshBVH.h"
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	struct RayLanes {
+		__m128 ox, oy, oz;
+		__m128 dx, dy, dz;
+	};
+
+	RayLanes MakeRayLanes(const Vector3& origin, const Vector3& dir)
+	{
+		return { _mm_set1_ps(origin.x), _mm_set1_ps(origin.y), _mm_set1_ps(origin.z),
+				 _mm_set1_ps(dir.x),	_mm_set1_ps(dir.y),	   _mm_set1_ps(dir.z) };
+	}
+
+	// 4개 삼각형과 동시에 Moller-Trumbore, 반환값: 교차한 Lane의 Bit
+	template <typename Group>
+	int IntersectGroup(const Group& g, const RayLanes& ray, const float maxDistance, __m128& t, __m128& u,
+					   __m128& v)
+	{
+		const __m128 e1x = _mm_loadu_ps(g.e1x), e1y = _mm_loadu_ps(g.e1y), e1z = _mm_loadu_ps(g.e1z);
+		const __m128 e2x = _mm_loadu_ps(g.e2x), e2y = _mm_loadu_ps(g.e2y), e2z = _mm_loadu_ps(g.e2z);
+
+		// p = dir x e2, det = e1 . p
+		const __m128 px = _mm_sub_ps(_mm_mul_ps(ray.dy, e2z), _mm_mul_ps(ray.dz, e2y));
+		const __m128 py = _mm_sub_ps(_mm_mul_ps(ray.dz, e2x), _mm_mul_ps(ray.dx, e2z));
+		const __m128 pz = _mm_sub_ps(_mm_mul_ps(ray.dx, e2y), _mm_mul_ps(ray.dy, e2x));
+		const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+
+		const __m128 zero = _mm_setzero_ps();
+		__m128 mask = _mm_cmpneq_ps(det, zero);
+		if (_mm_movemask_ps(mask) == 0)
+		{
+			return 0;
+		}
+		const __m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+		// s = origin - v0
+		const __m128 sx = _mm_sub_ps(ray.ox, _mm_loadu_ps(g.v0x));
+		const __m128 sy = _mm_sub_ps(ray.oy, _mm_loadu_ps(g.v0y));
+		const __m128 sz = _mm_sub_ps(ray.oz, _mm_loadu_ps(g.v0z));
+
+		u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), invDet);
+
+		// q = s x e1
+		const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+		const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+		const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+
+		v = _mm_mul_ps(
+			_mm_add_ps(_mm_add_ps(_mm_mul_ps(ray.dx, qx), _mm_mul_ps(ray.dy, qy)), _mm_mul_ps(ray.dz, qz)), invDet);
+		t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+
+		const __m128 one = _mm_set1_ps(1.0f);
+		mask = _mm_and_ps(mask, _mm_cmpge_ps(u, zero));
+		mask = _mm_and_ps(mask, _mm_cmpge_ps(v, zero));
+		mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), one));
+		mask = _mm_and_ps(mask, _mm_cmpge_ps(t, zero));
+		mask = _mm_and_ps(mask, _mm_cmplt_ps(t, _mm_set1_ps(maxDistance)));
+
+		return _mm_movemask_ps(mask);
+	}
+
+	// bits 중 가장 가까운 Lane을 hit에 기록
+	template <typename Group>
+	void RecordClosest(const Group& g, const int bits, const __m128& t, const __m128& u, const __m128& v, RayHit& hit)
+	{
+		alignas(16) float ts[4], us[4], vs[4];
+		_mm_store_ps(ts, t);
+		_mm_store_ps(us, u);
+		_mm_store_ps(vs, v);
+		for (int lane = 0; lane < 4; lane++)
+		{
+			if ((bits >> lane) & 1 && ts[lane] < hit.distance)
+			{
+				hit.distance = ts[lane];
+				hit.triangle = g.triangle[lane];
+				hit.u = us[lane];
+				hit.v = vs[lane];
+			}
+		}
+	}
+}
+
+void MeshBVH::Build(const Vertex* vertices, const size_t vertexCount, const uint32_t* indices,
+					const size_t indexCount)
+{
+	m_nodes.clear();
+	m_groups.clear();
+
+	// Vertex가 없으면 Index가 있어도 읽지 않음 (빈 Mesh)
+	m_triangleCount = vertexCount > 0 ? indexCount / 3 : 0;
+
+	vector<BVHBox> boxes(m_triangleCount);
+	for (size_t i = 0; i < m_triangleCount; i++)
+	{
+		const Vector3& p0 = vertices[indices[i * 3]].position;
+		const Vector3& p1 = vertices[indices[i * 3 + 1]].position;
+		const Vector3& p2 = vertices[indices[i * 3 + 2]].position;
+		boxes[i].boxMin = XMFLOAT3(min({ p0.x, p1.x, p2.x }), min({ p0.y, p1.y, p2.y }), min({ p0.z, p1.z, p2.z }));
+		boxes[i].boxMax = XMFLOAT3(max({ p0.x, p1.x, p2.x }), max({ p0.y, p1.y, p2.y }), max({ p0.z, p1.z, p2.z }));
+	}
+
+	BVH::Settings settings;
+	settings.maxLeafSize = MAX_LEAF_TRIANGLES;
+	settings.groupSize = 4;
+
+	vector<uint32_t> order;
+	BVH::Build(boxes, settings, m_nodes, order);
+
+	// Leaf마다 삼각형을 4개 단위 Group으로 복사 (Traversal 중에는 Vertex/Index를 읽지 않음)
+	size_t groupCount = 0;
+	for (const BVHNode& node : m_nodes)
+	{
+		if (node.IsLeaf())
+		{
+			groupCount += (node.count + 3) / 4;
+		}
+	}
+	m_groups.reserve(groupCount);
+
+	for (BVHNode& node : m_nodes)
+	{
+		if (!node.IsLeaf())
+		{
+			continue;
+		}
+
+		const uint32_t first = node.leftFirst;
+		node.leftFirst = uint32_t(m_groups.size());
+
+		for (uint32_t k = 0; k < node.count; k++)
+		{
+			if (k % 4 == 0)
+			{
+				m_groups.push_back(TriangleGroup()); // 0으로 채움
+				fill(begin(m_groups.back().triangle), end(m_groups.back().triangle), UINT32_MAX);
+			}
+
+			TriangleGroup& g = m_groups.back();
+			const uint32_t lane = k % 4;
+			const uint32_t t = order[first + k];
+			const Vector3& p0 = vertices[indices[t * 3]].position;
+			const Vector3 e1 = vertices[indices[t * 3 + 1]].position - p0;
+			const Vector3 e2 = vertices[indices[t * 3 + 2]].position - p0;
+			g.v0x[lane] = p0.x;
+			g.v0y[lane] = p0.y;
+			g.v0z[lane] = p0.z;
+			g.e1x[lane] = e1.x;
+			g.e1y[lane] = e1.y;
+			g.e1z[lane] = e1.z;
+			g.e2x[lane] = e2.x;
+			g.e2y[lane] = e2.y;
+			g.e2z[lane] = e2.z;
+			g.triangle[lane] = t;
+		}
+	}
+}
+
+template <bool anyHit>
+bool MeshBVH::Intersect(const Vector3& origin, const Vector3& dir, RayHit& hit) const
+{
+	const RayLanes lanes = MakeRayLanes(origin, dir);
+	const BVHRay ray(origin, dir);
+
+	bool found = false;
+	float maxDistance = hit.distance;
+	BVH::Traverse(m_nodes, ray, maxDistance, [&](const BVHNode& leaf, float& distance) {
+		const uint32_t groupEnd = leaf.leftFirst + (leaf.count + 3) / 4;
+		for (uint32_t i = leaf.leftFirst; i < groupEnd; i++)
+		{
+			__m128 t, u, v;
+			const int bits = IntersectGroup(m_groups[i], lanes, distance, t, u, v);
+			if (bits)
+			{
+				RecordClosest(m_groups[i], bits, t, u, v, hit);
+				distance = hit.distance;
+				found = true;
+				if (anyHit)
+				{
+					return true;
+				}
+			}
+		}
+		return false;
+	});
+
+	return found;
+}
+
+bool MeshBVH::IntersectClosest(const Vector3& origin, const Vector3& dir, RayHit& hit) const
+{
+	return Intersect<false>(origin, dir, hit);
+}
+
+bool MeshBVH::IntersectAny(const Vector3& origin, const Vector3& dir, const float maxDistance) const
+{
+	RayHit hit;
+	hit.distance = maxDistance;
+	return Intersect<true>(origin, dir, hit);
+}
+
+bool MeshBVH::IntersectClosestBruteForce(const Vector3& origin, const Vector3& dir, RayHit& hit) const
+{
+	const RayLanes lanes = MakeRayLanes(origin, dir);
+
+	bool found = false;
+	for (const TriangleGroup& g : m_groups)
+	{
+		__m128 t, u, v;
+		const int bits = IntersectGroup(g, lanes, hit.distance, t, u, v);
+		if (bits)
+		{
+			RecordClosest(g, bits, t, u, v, hit);
+			found = true;
+		}
+	}
+	return found;
+}
+
+size_t MeshBVH::GetMemorySize() const
+{
+	return m_nodes.size() * sizeof(BVHNode) + m_groups.size() * sizeof(TriangleGroup);
+}
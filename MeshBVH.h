@@ -0,0 +1,68 @@
+#pragma once
+
+#include <directxtk/SimpleMath.h>
+
+#include <cfloat>
+#include <cstdint>
+#include <vector>
+
+#include "BVH.h"
+#include "Vertex.h"
+
+// Ray와 삼각형의 가장 가까운 교차
+struct RayHit {
+	float distance = FLT_MAX;		// Ray 방향 벡터 길이 단위 (정규화된 방향이면 거리)
+	uint32_t triangle = UINT32_MAX; // LOD 0 Index 기준 (indices[3 * triangle + k])
+	float u = 0.0f;					// p = (1 - u - v) * p0 + u * p1 + v * p2
+	float v = 0.0f;
+	uint32_t mesh = UINT32_MAX;	  // Model::m_meshes Index
+	uint32_t object = UINT32_MAX; // SceneBVH::Build()에 넣은 순서
+
+	bool IsHit() const { return triangle != UINT32_MAX; }
+};
+
+// Mesh 하나의 삼각형 BVH (Model Space, Picking 등 CPU에서 Ray 검사용)
+// 삼각형은 Leaf 순서로 4개씩 SoA로 복사해두고 SSE로 4개를 동시에 검사 (Moller-Trumbore)
+// 만든 뒤에는 읽기만 하므로 여러 Thread에서 동시에 검사해도 됨
+class MeshBVH {
+public:
+	static const uint32_t MAX_LEAF_TRIANGLES = 8;
+
+	void Build(const Vertex *vertices, const size_t vertexCount, const uint32_t *indices,
+			   const size_t indexCount);
+
+	// hit.distance보다 가까운 교차만 기록 (앞/뒷면 모두)
+	bool IntersectClosest(const DirectX::SimpleMath::Vector3 &origin,
+						  const DirectX::SimpleMath::Vector3 &dir, RayHit &hit) const;
+
+	// maxDistance 안에 교차가 하나라도 있는지 (그림자, 가림 확인용)
+	bool IntersectAny(const DirectX::SimpleMath::Vector3 &origin,
+					  const DirectX::SimpleMath::Vector3 &dir, const float maxDistance = FLT_MAX) const;
+
+	// 모든 삼각형을 하나씩 검사 (비교용)
+	bool IntersectClosestBruteForce(const DirectX::SimpleMath::Vector3 &origin,
+									const DirectX::SimpleMath::Vector3 &dir, RayHit &hit) const;
+
+	bool IsEmpty() const { return m_nodes.empty(); }
+	size_t GetNodeCount() const { return m_nodes.size(); }
+	size_t GetTriangleCount() const { return m_triangleCount; }
+	size_t GetMemorySize() const;
+
+private:
+	// 삼각형 4개, 빈 칸은 면적 0 (det = 0이라서 교차하지 않음)
+	struct TriangleGroup {
+		float v0x[4], v0y[4], v0z[4];
+		float e1x[4], e1y[4], e1z[4]; // p1 - p0
+		float e2x[4], e2y[4], e2z[4]; // p2 - p0
+		uint32_t triangle[4];
+	};
+
+	// Leaf의 leftFirst는 m_groups Index, count는 삼각형 수
+	template <bool anyHit>
+	bool Intersect(const DirectX::SimpleMath::Vector3 &origin, const DirectX::SimpleMath::Vector3 &dir,
+				   RayHit &hit) const;
+
+	std::vector<BVHNode> m_nodes;
+	std::vector<TriangleGroup> m_groups;
+	size_t m_triangleCount = 0;
+};
@@ -0,0 +1,364 @@
+#include "MeshCache.h"
+#include "BoundsCalculator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	const uint32_t FLAG_REVERSE_NORMAL = 0x01;
+	const uint64_t DATA_ALIGNMENT = 16;
+	const size_t TEXTURE_COUNT = 7;
+
+	// 캐시에 저장하는 Texture 경로 순서
+	std::string MeshData::*const textureMembers[TEXTURE_COUNT] = {
+		&MeshData::albedoTextureFileName,
+		&MeshData::emissiveTextureFileName,
+		&MeshData::normalTextureFileName,
+		&MeshData::heightTextureFileName,
+		&MeshData::aoTextureFileName,
+		&MeshData::metallicTextureFileName,
+		&MeshData::roughnessTextureFileName,
+	};
+
+	struct FileHeader {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t flags;
+		uint32_t meshCount;
+		uint32_t vertexStride;
+		uint32_t reserved[3];
+	};
+
+	struct FileMeshEntry {
+		uint64_t vertexOffset;
+		uint64_t indexOffset;
+		uint32_t vertexCount;
+		uint32_t indexCount; // 모든 LOD의 합
+		uint32_t lodCount;
+		uint32_t reserved;
+		uint32_t lodIndexCounts[MeshCache::MAX_LODS];
+		float lodErrors[MeshCache::MAX_LODS];
+		float boxCenter[3];
+		float boxExtents[3];
+		float sphere[4]; // Center, Radius
+		float orientedBoxCenter[3];
+		float orientedBoxExtents[3];
+		float orientedBoxOrientation[4];
+		uint32_t textureOffsets[TEXTURE_COUNT];
+		uint32_t textureLengths[TEXTURE_COUNT];
+	};
+
+	static_assert(sizeof(FileHeader) == 32, "MeshCache header layout changed.");
+	static_assert(sizeof(FileMeshEntry) % 8 == 0, "MeshCache entry must be 8-byte aligned.");
+
+	uint64_t AlignOffset(uint64_t offset)
+	{
+		return (offset + DATA_ALIGNMENT - 1) & ~(DATA_ALIGNMENT - 1);
+	}
+
+	bool IsInRange(uint64_t offset, uint64_t bytes, uint64_t fileSize)
+	{
+		return offset <= fileSize && bytes <= fileSize - offset;
+	}
+
+	void WritePadding(ofstream& file, uint64_t& position, uint64_t target)
+	{
+		const char zeros[DATA_ALIGNMENT] = {};
+		file.write(zeros, streamsize(target - position));
+		position = target;
+	}
+}
+
+std::string MeshCache::GetCacheFileName(const std::string& basePath, const std::string& fileName)
+{
+	return basePath + fileName + ".cmesh";
+}
+
+std::shared_ptr<MeshCache> MeshCache::Load(const std::string& basePath, const std::string& fileName,
+										   bool reverseNormal)
+{
+	const string cacheFileName = GetCacheFileName(basePath, fileName);
+
+	error_code cacheError;
+	const auto cacheTime = filesystem::last_write_time(cacheFileName, cacheError);
+	if (cacheError)
+	{
+		return nullptr;
+	}
+
+	// 원본이 없으면 캐시만 사용
+	error_code sourceError;
+	const auto sourceTime = filesystem::last_write_time(basePath + fileName, sourceError);
+	if (!sourceError && cacheTime < sourceTime)
+	{
+		return nullptr;
+	}
+
+	shared_ptr<MeshCache> cache = make_shared<MeshCache>();
+	if (!cache->Open(cacheFileName, reverseNormal))
+	{
+		return nullptr;
+	}
+
+	return cache;
+}
+
+bool MeshCache::Write(const std::string& cacheFileName, const std::vector<MeshData>& meshes,
+					  bool reverseNormal)
+{
+	FileHeader header = {};
+	header.magic = MAGIC;
+	header.version = VERSION;
+	header.flags = reverseNormal ? FLAG_REVERSE_NORMAL : 0;
+	header.meshCount = uint32_t(meshes.size());
+	header.vertexStride = uint32_t(sizeof(Vertex));
+
+	vector<FileMeshEntry> entries(meshes.size());
+	uint64_t offset = sizeof(FileHeader) + sizeof(FileMeshEntry) * entries.size();
+
+	// Texture 경로는 Table 바로 뒤에 모아서 저장
+	string names;
+	for (size_t i = 0; i < meshes.size(); i++)
+	{
+		for (size_t t = 0; t < TEXTURE_COUNT; t++)
+		{
+			const string& name = meshes[i].*textureMembers[t];
+			entries[i].textureOffsets[t] = uint32_t(offset + names.size());
+			entries[i].textureLengths[t] = uint32_t(name.size());
+			names += name;
+		}
+	}
+	offset += names.size();
+
+	// Vertex/Index 데이터는 16Byte 정렬
+	for (size_t i = 0; i < meshes.size(); i++)
+	{
+		const MeshData& mesh = meshes[i];
+		FileMeshEntry& entry = entries[i];
+
+		entry.vertexCount = uint32_t(mesh.vertices.size());
+		entry.lodCount = uint32_t(min(mesh.lods.size() + 1, size_t(MAX_LODS)));
+		entry.lodIndexCounts[0] = uint32_t(mesh.indices.size());
+		entry.lodErrors[0] = 0.0f;
+		for (uint32_t l = 1; l < entry.lodCount; l++)
+		{
+			entry.lodIndexCounts[l] = uint32_t(mesh.lods[l - 1].indices.size());
+			entry.lodErrors[l] = mesh.lods[l - 1].error;
+		}
+
+		entry.indexCount = 0;
+		for (uint32_t l = 0; l < entry.lodCount; l++)
+		{
+			entry.indexCount += entry.lodIndexCounts[l];
+		}
+
+		// ReadFromFile()에서 계산한 경계를 그대로 저장 (없으면 여기서 계산)
+		const MeshBounds bounds = mesh.bounds.isValid
+									  ? mesh.bounds
+									  : BoundsCalculator::Compute(mesh.vertices.data(), mesh.vertices.size());
+		memcpy(entry.boxCenter, &bounds.box.Center, sizeof(entry.boxCenter));
+		memcpy(entry.boxExtents, &bounds.box.Extents, sizeof(entry.boxExtents));
+		memcpy(entry.sphere, &bounds.sphere.Center, sizeof(float) * 3);
+		entry.sphere[3] = bounds.sphere.Radius;
+		memcpy(entry.orientedBoxCenter, &bounds.orientedBox.Center, sizeof(entry.orientedBoxCenter));
+		memcpy(entry.orientedBoxExtents, &bounds.orientedBox.Extents, sizeof(entry.orientedBoxExtents));
+		memcpy(entry.orientedBoxOrientation, &bounds.orientedBox.Orientation, sizeof(entry.orientedBoxOrientation));
+
+		offset = AlignOffset(offset);
+		entry.vertexOffset = offset;
+		offset += uint64_t(sizeof(Vertex)) * entry.vertexCount;
+
+		offset = AlignOffset(offset);
+		entry.indexOffset = offset;
+		offset += uint64_t(sizeof(uint32_t)) * entry.indexCount;
+	}
+
+	// 임시 파일에 쓴 다음 교체 (중간에 실패해도 깨진 캐시가 남지 않도록)
+	const string tempFileName = cacheFileName + ".tmp";
+	{
+		ofstream file(tempFileName, ios::binary | ios::trunc);
+		if (!file)
+		{
+			cout << "Failed to write mesh cache: " << cacheFileName << endl;
+			return false;
+		}
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(entries.data()), streamsize(sizeof(FileMeshEntry) * entries.size()));
+		file.write(names.data(), streamsize(names.size()));
+
+		uint64_t position = sizeof(FileHeader) + sizeof(FileMeshEntry) * entries.size() + names.size();
+		for (size_t i = 0; i < meshes.size(); i++)
+		{
+			WritePadding(file, position, entries[i].vertexOffset);
+			file.write(reinterpret_cast<const char*>(meshes[i].vertices.data()),
+					   streamsize(sizeof(Vertex) * meshes[i].vertices.size()));
+			position += sizeof(Vertex) * meshes[i].vertices.size();
+
+			// LOD 0 다음에 나머지 LOD를 이어서 저장
+			WritePadding(file, position, entries[i].indexOffset);
+			for (uint32_t l = 0; l < entries[i].lodCount; l++)
+			{
+				const vector<uint32_t>& indices = (l == 0) ? meshes[i].indices : meshes[i].lods[l - 1].indices;
+				file.write(reinterpret_cast<const char*>(indices.data()),
+						   streamsize(sizeof(uint32_t) * indices.size()));
+				position += sizeof(uint32_t) * indices.size();
+			}
+		}
+
+		if (!file)
+		{
+			cout << "Failed to write mesh cache: " << cacheFileName << endl;
+			return false;
+		}
+	}
+
+	error_code ec;
+	filesystem::rename(tempFileName, cacheFileName, ec);
+	if (ec)
+	{
+		cout << "Failed to write mesh cache: " << cacheFileName << endl;
+		filesystem::remove(tempFileName, ec);
+		return false;
+	}
+
+	return true;
+}
+
+bool MeshCache::Open(const std::string& cacheFileName, bool reverseNormal)
+{
+	m_meshes.clear();
+
+	if (!m_file.Open(cacheFileName))
+	{
+		return false;
+	}
+
+	const uint8_t* data = m_file.GetData();
+	const uint64_t fileSize = m_file.GetSize();
+
+	FileHeader header;
+	if (fileSize < sizeof(header))
+	{
+		m_file.Close();
+		return false;
+	}
+	memcpy(&header, data, sizeof(header));
+
+	const uint32_t flags = reverseNormal ? FLAG_REVERSE_NORMAL : 0;
+	if (header.magic != MAGIC || header.version != VERSION ||
+		header.vertexStride != sizeof(Vertex) || header.flags != flags ||
+		!IsInRange(sizeof(FileHeader), uint64_t(sizeof(FileMeshEntry)) * header.meshCount, fileSize))
+	{
+		m_file.Close();
+		return false;
+	}
+
+	// mmap은 페이지 단위로 정렬되어 있으므로 Table을 그대로 읽어도 됨
+	const FileMeshEntry* entries = reinterpret_cast<const FileMeshEntry*>(data + sizeof(FileHeader));
+
+	m_meshes.resize(header.meshCount);
+	for (uint32_t i = 0; i < header.meshCount; i++)
+	{
+		const FileMeshEntry& entry = entries[i];
+		CookedMesh& mesh = m_meshes[i];
+
+		if (!IsInRange(entry.vertexOffset, uint64_t(sizeof(Vertex)) * entry.vertexCount, fileSize) ||
+			!IsInRange(entry.indexOffset, uint64_t(sizeof(uint32_t)) * entry.indexCount, fileSize) ||
+			entry.vertexOffset % DATA_ALIGNMENT != 0 || entry.indexOffset % DATA_ALIGNMENT != 0)
+		{
+			m_meshes.clear();
+			m_file.Close();
+			return false;
+		}
+
+		mesh.vertices = reinterpret_cast<const Vertex*>(data + entry.vertexOffset);
+		mesh.vertexCount = entry.vertexCount;
+		mesh.indices = reinterpret_cast<const uint32_t*>(data + entry.indexOffset);
+		mesh.indexCount = entry.indexCount;
+
+		if (entry.lodCount == 0 || entry.lodCount > MAX_LODS)
+		{
+			m_meshes.clear();
+			m_file.Close();
+			return false;
+		}
+
+		uint64_t lodOffset = 0;
+		mesh.lods.resize(entry.lodCount);
+		for (uint32_t l = 0; l < entry.lodCount; l++)
+		{
+			mesh.lods[l].indexOffset = uint32_t(lodOffset);
+			mesh.lods[l].indexCount = entry.lodIndexCounts[l];
+			mesh.lods[l].error = entry.lodErrors[l];
+			lodOffset += entry.lodIndexCounts[l];
+		}
+
+		if (lodOffset != entry.indexCount)
+		{
+			m_meshes.clear();
+			m_file.Close();
+			return false;
+		}
+
+		memcpy(&mesh.bounds.box.Center, entry.boxCenter, sizeof(entry.boxCenter));
+		memcpy(&mesh.bounds.box.Extents, entry.boxExtents, sizeof(entry.boxExtents));
+		memcpy(&mesh.bounds.sphere.Center, entry.sphere, sizeof(float) * 3);
+		mesh.bounds.sphere.Radius = entry.sphere[3];
+		memcpy(&mesh.bounds.orientedBox.Center, entry.orientedBoxCenter, sizeof(entry.orientedBoxCenter));
+		memcpy(&mesh.bounds.orientedBox.Extents, entry.orientedBoxExtents, sizeof(entry.orientedBoxExtents));
+		memcpy(&mesh.bounds.orientedBox.Orientation, entry.orientedBoxOrientation,
+			   sizeof(entry.orientedBoxOrientation));
+		mesh.bounds.isValid = true;
+
+		for (size_t t = 0; t < TEXTURE_COUNT; t++)
+		{
+			if (!IsInRange(entry.textureOffsets[t], entry.textureLengths[t], fileSize))
+			{
+				m_meshes.clear();
+				m_file.Close();
+				return false;
+			}
+
+			mesh.material.*textureMembers[t] = string(reinterpret_cast<const char*>(data + entry.textureOffsets[t]),
+													  entry.textureLengths[t]);
+		}
+	}
+
+	return true;
+}
+
+std::vector<MeshData> MeshCache::ToMeshData() const
+{
+	vector<MeshData> meshes(m_meshes.size());
+
+	for (size_t i = 0; i < m_meshes.size(); i++)
+	{
+		const CookedMesh& cooked = m_meshes[i];
+
+		meshes[i] = cooked.material;
+		meshes[i].bounds = cooked.bounds;
+		meshes[i].vertices.assign(cooked.vertices, cooked.vertices + cooked.vertexCount);
+
+		const MeshLodRange& lod0 = cooked.lods[0];
+		meshes[i].indices.assign(cooked.indices + lod0.indexOffset,
+								 cooked.indices + lod0.indexOffset + lod0.indexCount);
+
+		meshes[i].lods.resize(cooked.lods.size() - 1);
+		for (size_t l = 1; l < cooked.lods.size(); l++)
+		{
+			const MeshLodRange& range = cooked.lods[l];
+			meshes[i].lods[l - 1].indices.assign(cooked.indices + range.indexOffset,
+												 cooked.indices + range.indexOffset + range.indexCount);
+			meshes[i].lods[l - 1].error = range.error;
+		}
+	}
+
+	return meshes;
+}
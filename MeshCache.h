@@ -0,0 +1,56 @@
+#pragma once
+
+#include <directxtk/SimpleMath.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+#include "MeshData.h"
+#include "Vertex.h"
+
+// 캐시 파일에 들어있는 Mesh 하나 (mmap된 메모리를 그대로 가리킴, 복사 X)
+struct CookedMesh {
+	const Vertex *vertices = nullptr;
+	uint32_t vertexCount = 0;
+	const uint32_t *indices = nullptr; // 모든 LOD를 이어붙인 Index
+	uint32_t indexCount = 0;
+	std::vector<MeshLodRange> lods;	   // LOD 0부터
+
+	MeshBounds bounds;
+
+	// vertices, indices는 비어있고 Texture 경로만 채워짐
+	MeshData material;
+};
+
+// ModelLoader(Assimp)의 최종 결과를 저장해두는 바이너리 캐시 (scene.gltf -> scene.gltf.cmesh)
+class MeshCache {
+public:
+	static const uint32_t MAGIC = 0x4853454D; // "MESH"
+	static const uint32_t VERSION = 5;
+	static const uint32_t MAX_LODS = 8;
+
+	static std::string GetCacheFileName(const std::string &basePath, const std::string &fileName);
+
+	// 원본 파일보다 캐시가 오래됐거나 Import 옵션이 다르면 nullptr
+	static std::shared_ptr<MeshCache> Load(const std::string &basePath, const std::string &fileName,
+										   bool reverseNormal);
+
+	static bool Write(const std::string &cacheFileName, const std::vector<MeshData> &meshes,
+					  bool reverseNormal);
+
+	bool Open(const std::string &cacheFileName, bool reverseNormal);
+
+	size_t GetMeshCount() const { return m_meshes.size(); }
+	const CookedMesh &GetMesh(size_t i) const { return m_meshes[i]; }
+	const std::vector<CookedMesh> &GetMeshes() const { return m_meshes; }
+
+	// 소유권이 필요한 경우에만 복사
+	std::vector<MeshData> ToMeshData() const;
+
+private:
+	MappedFile m_file;
+	std::vector<CookedMesh> m_meshes;
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <DirectXCollision.h>
 #include <directxtk/SimpleMath.h>
 
 #include <string>
@@ -7,9 +8,32 @@
 
 #include "Vertex.h"
 
+// 단순화된 Index 목록 (Vertex는 원본과 공유)
+struct MeshLod {
+	std::vector<uint32_t> indices;
+	float error = 0.0f; // 원본과의 최대 거리 추정치 (Model Space)
+};
+
+// 모든 LOD를 이어붙인 Index Buffer에서 LOD 하나의 범위
+struct MeshLodRange {
+	uint32_t indexOffset = 0;
+	uint32_t indexCount = 0;
+	float error = 0.0f;
+};
+
+// Model Space 경계 (BoundsCalculator로 계산)
+struct MeshBounds {
+	DirectX::BoundingBox box;
+	DirectX::BoundingSphere sphere;
+	DirectX::BoundingOrientedBox orientedBox; // PCA 축, AABB보다 크면 AABB와 같음
+	bool isValid = false;                     // false면 아직 계산하지 않은 것
+};
+
 struct MeshData {
 	std::vector<Vertex> vertices;
 	std::vector<uint32_t> indices;
+	std::vector<MeshLod> lods; // LOD 1부터 (indices가 LOD 0)
+	MeshBounds bounds;
 
 	std::string albedoTextureFileName;
 	std::string emissiveTextureFileName;
@@ -0,0 +1,485 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <unordered_set>
+
+using namespace std;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	// Forsyth, "Linear-Speed Vertex Cache Optimisation"의 기본값
+	const int FORSYTH_CACHE_SIZE = 32;
+	const float CACHE_DECAY_POWER = 1.5f;
+	const float LAST_TRI_SCORE = 0.75f;
+	const float VALENCE_BOOST_SCALE = 2.0f;
+	const float VALENCE_BOOST_POWER = 0.5f;
+	const int MAX_VALENCE_SCORE = 32;
+
+	struct ForsythTables {
+		float cacheScore[FORSYTH_CACHE_SIZE];
+		float valenceScore[MAX_VALENCE_SCORE];
+
+		ForsythTables()
+		{
+			for (int i = 0; i < FORSYTH_CACHE_SIZE; i++)
+			{
+				if (i < 3)
+				{
+					cacheScore[i] = LAST_TRI_SCORE;
+				}
+				else
+				{
+					const float scaler = 1.0f / (FORSYTH_CACHE_SIZE - 3);
+					cacheScore[i] = pow(1.0f - (i - 3) * scaler, CACHE_DECAY_POWER);
+				}
+			}
+
+			for (int i = 0; i < MAX_VALENCE_SCORE; i++)
+			{
+				valenceScore[i] = (i == 0) ? 0.0f : VALENCE_BOOST_SCALE * pow(float(i), -VALENCE_BOOST_POWER);
+			}
+		}
+	};
+
+	float GetVertexScore(const ForsythTables& tables, const int cachePosition, const uint32_t remaining)
+	{
+		if (remaining == 0)
+		{
+			return -1.0f; // 더 이상 사용되지 않음
+		}
+
+		float score = (cachePosition < 0) ? 0.0f : tables.cacheScore[cachePosition];
+		if (remaining < MAX_VALENCE_SCORE)
+		{
+			score += tables.valenceScore[remaining];
+		}
+		else
+		{
+			score += VALENCE_BOOST_SCALE * pow(float(remaining), -VALENCE_BOOST_POWER);
+		}
+
+		return score;
+	}
+
+	// 인덱스가 가리키는 Vertex의 내용으로 비교 (Vertex는 float만 있어서 padding 없음)
+	struct VertexHasher {
+		const Vertex* vertices;
+
+		size_t operator()(const uint32_t index) const
+		{
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&vertices[index]);
+			uint64_t hash = 14695981039346656037ull; // FNV-1a
+			for (size_t i = 0; i < sizeof(Vertex); i++)
+			{
+				hash = (hash ^ bytes[i]) * 1099511628211ull;
+			}
+			return size_t(hash);
+		}
+	};
+
+	struct VertexEqual {
+		const Vertex* vertices;
+
+		bool operator()(const uint32_t a, const uint32_t b) const
+		{
+			return memcmp(&vertices[a], &vertices[b], sizeof(Vertex)) == 0;
+		}
+	};
+
+	static_assert(sizeof(Vertex) == sizeof(float) * 12, "Vertex must not contain padding.");
+
+	// FIFO 캐시를 흉내내서 Vertex Shader가 실행되는 횟수를 셈
+	size_t CountCacheMisses(const vector<uint32_t>& indices, const size_t cacheSize)
+	{
+		vector<uint32_t> timestamps; // Vertex가 캐시에 들어간 시점 + 1 (0이면 캐시에 없음)
+		size_t misses = 0;
+
+		for (const uint32_t index : indices)
+		{
+			if (index >= timestamps.size())
+			{
+				timestamps.resize(index + 1, 0);
+			}
+
+			if (timestamps[index] == 0 || misses + 1 - timestamps[index] > cacheSize)
+			{
+				misses++;
+				timestamps[index] = uint32_t(misses);
+			}
+		}
+
+		return misses;
+	}
+}
+
+MeshOptimizerStats MeshOptimizer::Optimize(MeshData& meshData, const float overdrawThreshold)
+{
+	MeshOptimizerStats stats;
+	stats.vertexCountBefore = meshData.vertices.size();
+	stats.acmrBefore = ComputeACMR(meshData.indices);
+	stats.atvrBefore = ComputeATVR(meshData.indices, meshData.vertices.size());
+
+	if (meshData.indices.size() >= 3)
+	{
+		WeldVertices(meshData);
+		OptimizeVertexCache(meshData.indices, meshData.vertices.size());
+		OptimizeOverdraw(meshData.indices, meshData.vertices, overdrawThreshold);
+		OptimizeVertexFetch(meshData);
+	}
+
+	stats.vertexCountAfter = meshData.vertices.size();
+	stats.acmrAfter = ComputeACMR(meshData.indices);
+	stats.atvrAfter = ComputeATVR(meshData.indices, meshData.vertices.size());
+
+	return stats;
+}
+
+void MeshOptimizer::WeldVertices(MeshData& meshData)
+{
+	vector<Vertex>& vertices = meshData.vertices;
+
+	unordered_set<uint32_t, VertexHasher, VertexEqual> unique(
+		vertices.size(), VertexHasher{ vertices.data() }, VertexEqual{ vertices.data() });
+
+	// 같은 내용의 Vertex 중 처음 나온 것으로 통일
+	vector<uint32_t> remap(vertices.size());
+	for (uint32_t i = 0; i < uint32_t(vertices.size()); i++)
+	{
+		remap[i] = *unique.insert(i).first;
+	}
+
+	if (unique.size() == vertices.size())
+	{
+		return;
+	}
+
+	for (uint32_t& index : meshData.indices)
+	{
+		index = remap[index];
+	}
+
+	// 남는 Vertex는 OptimizeVertexFetch()에서 제거되지만 단독으로 호출해도 되도록 여기서 정리
+	OptimizeVertexFetch(meshData);
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices, const size_t vertexCount)
+{
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0)
+	{
+		return;
+	}
+
+	static const ForsythTables tables;
+
+	// Vertex -> 인접 삼각형 목록 (CSR)
+	vector<uint32_t> remaining(vertexCount, 0);
+	for (size_t i = 0; i < triangleCount * 3; i++)
+	{
+		remaining[indices[i]]++;
+	}
+
+	vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+	for (size_t v = 0; v < vertexCount; v++)
+	{
+		adjacencyOffsets[v + 1] = adjacencyOffsets[v] + remaining[v];
+	}
+
+	vector<uint32_t> adjacency(triangleCount * 3);
+	{
+		vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+		for (uint32_t t = 0; t < uint32_t(triangleCount); t++)
+		{
+			for (int k = 0; k < 3; k++)
+			{
+				adjacency[fill[indices[t * 3 + k]]++] = t;
+			}
+		}
+	}
+
+	vector<float> vertexScore(vertexCount);
+	for (size_t v = 0; v < vertexCount; v++)
+	{
+		vertexScore[v] = GetVertexScore(tables, -1, remaining[v]);
+	}
+
+	vector<float> triangleScore(triangleCount);
+	vector<bool> emitted(triangleCount, false);
+	for (size_t t = 0; t < triangleCount; t++)
+	{
+		triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] +
+						   vertexScore[indices[t * 3 + 2]];
+	}
+
+	vector<uint32_t> result;
+	result.reserve(triangleCount * 3);
+
+	vector<uint32_t> cache;
+	vector<uint32_t> newCache;
+	cache.reserve(FORSYTH_CACHE_SIZE + 3);
+	newCache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+	size_t nextUnemitted = 0; // 캐시에 후보가 없을 때 입력 순서대로 다음 삼각형을 사용
+	int64_t bestTriangle = -1;
+
+	for (size_t emittedCount = 0; emittedCount < triangleCount; emittedCount++)
+	{
+		if (bestTriangle < 0)
+		{
+			while (emitted[nextUnemitted])
+			{
+				nextUnemitted++;
+			}
+			bestTriangle = int64_t(nextUnemitted);
+		}
+
+		const uint32_t t = uint32_t(bestTriangle);
+		const uint32_t* tri = &indices[t * 3];
+
+		emitted[t] = true;
+		result.insert(result.end(), tri, tri + 3);
+
+		// 인접 목록에서 제거
+		for (int k = 0; k < 3; k++)
+		{
+			const uint32_t v = tri[k];
+			uint32_t* begin = &adjacency[adjacencyOffsets[v]];
+			uint32_t* end = begin + remaining[v];
+			*find(begin, end, t) = *(end - 1);
+			remaining[v]--;
+		}
+
+		// 방금 그린 삼각형의 Vertex를 캐시 앞쪽으로
+		newCache.assign(tri, tri + 3);
+		for (const uint32_t v : cache)
+		{
+			if (v != tri[0] && v != tri[1] && v != tri[2])
+			{
+				newCache.push_back(v);
+			}
+		}
+
+		swap(cache, newCache);
+
+		// 점수가 바뀐 Vertex와 그 인접 삼각형만 갱신
+		float bestScore = -1.0f;
+		bestTriangle = -1;
+		for (size_t i = 0; i < cache.size(); i++)
+		{
+			const uint32_t v = cache[i];
+			const int position = (i < FORSYTH_CACHE_SIZE) ? int(i) : -1; // -1: 캐시에서 밀려남
+
+			const float newScore = GetVertexScore(tables, position, remaining[v]);
+			const float delta = newScore - vertexScore[v];
+			vertexScore[v] = newScore;
+
+			for (uint32_t a = adjacencyOffsets[v]; a < adjacencyOffsets[v] + remaining[v]; a++)
+			{
+				const uint32_t adjacent = adjacency[a];
+				triangleScore[adjacent] += delta;
+				if (triangleScore[adjacent] > bestScore)
+				{
+					bestScore = triangleScore[adjacent];
+					bestTriangle = adjacent;
+				}
+			}
+		}
+
+		if (cache.size() > FORSYTH_CACHE_SIZE)
+		{
+			cache.resize(FORSYTH_CACHE_SIZE);
+		}
+	}
+
+	// 삼각형이 아닌 나머지 인덱스(있다면)는 그대로 유지
+	result.insert(result.end(), indices.begin() + triangleCount * 3, indices.end());
+	indices = std::move(result);
+}
+
+void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices,
+									 const float threshold)
+{
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0)
+	{
+		return;
+	}
+
+	// 1. 캐시를 모두 놓친 삼각형에서 나누면 Vertex Cache 효율에 영향이 없음 (Hard Boundary)
+	// 2. 그 안에서 ACMR이 전체의 threshold배 이하로 유지되는 지점에서 더 나눔 (Soft Boundary)
+	vector<size_t> clusters; // 각 Cluster의 첫 삼각형
+	{
+		vector<uint32_t> timestamps(vertices.size(), 0);
+		size_t misses = 0;
+		vector<size_t> hardBoundaries;
+
+		for (size_t t = 0; t < triangleCount; t++)
+		{
+			size_t triangleMisses = 0;
+			for (int k = 0; k < 3; k++)
+			{
+				const uint32_t v = indices[t * 3 + k];
+				if (timestamps[v] == 0 || misses + 1 - timestamps[v] > VERTEX_CACHE_SIZE)
+				{
+					misses++;
+					triangleMisses++;
+					timestamps[v] = uint32_t(misses);
+				}
+			}
+
+			if (t == 0 || triangleMisses == 3)
+			{
+				hardBoundaries.push_back(t);
+			}
+		}
+		hardBoundaries.push_back(triangleCount);
+
+		const float targetACMR = threshold * float(misses) / float(triangleCount);
+
+		// Cluster는 순서가 바뀌므로 빈 캐시에서 시작한다고 가정하고 다시 계산
+		fill(timestamps.begin(), timestamps.end(), 0);
+		misses = 0;
+
+		for (size_t h = 0; h + 1 < hardBoundaries.size(); h++)
+		{
+			const size_t start = hardBoundaries[h];
+			const size_t end = hardBoundaries[h + 1];
+
+			clusters.push_back(start);
+
+			size_t clusterStart = start;
+			size_t clusterBase = misses; // 이 값 이하의 timestamp는 캐시에 없는 것으로 취급
+			for (size_t t = start; t < end; t++)
+			{
+				for (int k = 0; k < 3; k++)
+				{
+					const uint32_t v = indices[t * 3 + k];
+					if (timestamps[v] <= clusterBase || misses + 1 - timestamps[v] > VERTEX_CACHE_SIZE)
+					{
+						misses++;
+						timestamps[v] = uint32_t(misses);
+					}
+				}
+
+				// Cluster가 너무 작으면 정렬해도 이득이 없으므로 최소 크기 유지
+				const size_t clusterSize = t + 1 - clusterStart;
+				if (clusterSize >= 8 && t + 1 < end &&
+					float(misses - clusterBase) / float(clusterSize) <= targetACMR)
+				{
+					clusters.push_back(t + 1);
+					clusterStart = t + 1;
+					clusterBase = misses;
+				}
+			}
+		}
+		clusters.push_back(triangleCount);
+	}
+
+	const size_t clusterCount = clusters.size() - 1;
+	if (clusterCount <= 1)
+	{
+		return;
+	}
+
+	// 3. Mesh 중심에서 바깥쪽을 향하는 Cluster일수록 먼저 그림
+	Vector3 meshCenter(0.0f);
+	float meshArea = 0.0f;
+	vector<Vector3> clusterCenters(clusterCount, Vector3(0.0f));
+	vector<Vector3> clusterNormals(clusterCount, Vector3(0.0f));
+	vector<float> clusterAreas(clusterCount, 0.0f);
+
+	for (size_t c = 0; c < clusterCount; c++)
+	{
+		for (size_t t = clusters[c]; t < clusters[c + 1]; t++)
+		{
+			const Vector3& p0 = vertices[indices[t * 3]].position;
+			const Vector3& p1 = vertices[indices[t * 3 + 1]].position;
+			const Vector3& p2 = vertices[indices[t * 3 + 2]].position;
+
+			const Vector3 normal = (p1 - p0).Cross(p2 - p0); // 길이 = 넓이 * 2
+			const float area = normal.Length();
+			const Vector3 center = (p0 + p1 + p2) * (area / 3.0f);
+
+			clusterCenters[c] += center;
+			clusterNormals[c] += normal;
+			clusterAreas[c] += area;
+			meshCenter += center;
+			meshArea += area;
+		}
+	}
+
+	if (meshArea > 0.0f)
+	{
+		meshCenter /= meshArea;
+	}
+
+	vector<float> sortKeys(clusterCount);
+	for (size_t c = 0; c < clusterCount; c++)
+	{
+		Vector3 center = (clusterAreas[c] > 0.0f) ? clusterCenters[c] / clusterAreas[c] : Vector3(0.0f);
+		Vector3 normal = clusterNormals[c];
+		normal.Normalize();
+		sortKeys[c] = (center - meshCenter).Dot(normal);
+	}
+
+	vector<size_t> order(clusterCount);
+	iota(order.begin(), order.end(), size_t(0));
+	stable_sort(order.begin(), order.end(),
+				[&sortKeys](size_t a, size_t b) { return sortKeys[a] > sortKeys[b]; });
+
+	vector<uint32_t> result;
+	result.reserve(indices.size());
+	for (const size_t c : order)
+	{
+		result.insert(result.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+	}
+	result.insert(result.end(), indices.begin() + triangleCount * 3, indices.end());
+
+	indices = std::move(result);
+}
+
+void MeshOptimizer::OptimizeVertexFetch(MeshData& meshData)
+{
+	const uint32_t unused = ~0u;
+	vector<uint32_t> remap(meshData.vertices.size(), unused);
+	vector<Vertex> vertices;
+	vertices.reserve(meshData.vertices.size());
+
+	for (uint32_t& index : meshData.indices)
+	{
+		if (remap[index] == unused)
+		{
+			remap[index] = uint32_t(vertices.size());
+			vertices.push_back(meshData.vertices[index]);
+		}
+		index = remap[index];
+	}
+
+	meshData.vertices = std::move(vertices);
+}
+
+float MeshOptimizer::ComputeACMR(const std::vector<uint32_t>& indices, const size_t cacheSize)
+{
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0)
+	{
+		return 0.0f;
+	}
+
+	return float(CountCacheMisses(indices, cacheSize)) / float(triangleCount);
+}
+
+float MeshOptimizer::ComputeATVR(const std::vector<uint32_t>& indices, const size_t vertexCount,
+								 const size_t cacheSize)
+{
+	if (vertexCount == 0)
+	{
+		return 0.0f;
+	}
+
+	return float(CountCacheMisses(indices, cacheSize)) / float(vertexCount);
+}
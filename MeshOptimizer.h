@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "MeshData.h"
+#include "Vertex.h"
+
+// 최적화 전/후 비교용 수치
+// ACMR: 삼각형당 Vertex Shader 실행 횟수 (최소 0.5, 최대 3.0)
+// ATVR: Vertex당 Vertex Shader 실행 횟수 (최소 1.0)
+struct MeshOptimizerStats {
+	size_t vertexCountBefore = 0;
+	size_t vertexCountAfter = 0;
+	float acmrBefore = 0.0f;
+	float acmrAfter = 0.0f;
+	float atvrBefore = 0.0f;
+	float atvrAfter = 0.0f;
+};
+
+// MeshData를 GPU에서 그리기 좋은 순서로 바꾸는 CPU 전처리 (D3D11 의존성 없음)
+class MeshOptimizer {
+public:
+	static const size_t VERTEX_CACHE_SIZE = 16; // 통계 계산에 사용하는 FIFO 캐시 크기
+
+	// Weld -> Vertex Cache -> Overdraw -> Vertex Fetch 순서로 모두 적용
+	static MeshOptimizerStats Optimize(MeshData &meshData, const float overdrawThreshold = 1.05f);
+
+	// 모든 성분이 같은 Vertex를 하나로 합침
+	static void WeldVertices(MeshData &meshData);
+
+	// Forsyth 알고리즘으로 Post-transform Vertex Cache 재사용이 많아지도록 삼각형 순서 변경
+	static void OptimizeVertexCache(std::vector<uint32_t> &indices, const size_t vertexCount);
+
+	// Vertex Cache 순서를 크게 해치지 않는 범위(threshold)에서 바깥쪽을 향하는 Cluster를 먼저 그림
+	static void OptimizeOverdraw(std::vector<uint32_t> &indices, const std::vector<Vertex> &vertices,
+								 const float threshold = 1.05f);
+
+	// 처음 사용되는 순서대로 Vertex를 재배치 (사용되지 않는 Vertex는 제거)
+	static void OptimizeVertexFetch(MeshData &meshData);
+
+	static float ComputeACMR(const std::vector<uint32_t> &indices,
+							 const size_t cacheSize = VERTEX_CACHE_SIZE);
+	static float ComputeATVR(const std::vector<uint32_t> &indices, const size_t vertexCount,
+							 const size_t cacheSize = VERTEX_CACHE_SIZE);
+};
@@ -0,0 +1,425 @@
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+using namespace std;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	// 대칭 행렬 A, 벡터 b, 상수 c로 표현한 Quadric: p^T A p + 2 b.p + c
+	struct Quadric {
+		double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+		double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+		double c = 0.0;
+		double weight = 0.0; // 평면 수
+
+		void AddPlane(const Vector3& n, const double d)
+		{
+			a00 += n.x * n.x;
+			a01 += n.x * n.y;
+			a02 += n.x * n.z;
+			a11 += n.y * n.y;
+			a12 += n.y * n.z;
+			a22 += n.z * n.z;
+			b0 += n.x * d;
+			b1 += n.y * d;
+			b2 += n.z * d;
+			c += d * d;
+			weight += 1.0;
+		}
+
+		void Add(const Quadric& q)
+		{
+			a00 += q.a00;
+			a01 += q.a01;
+			a02 += q.a02;
+			a11 += q.a11;
+			a12 += q.a12;
+			a22 += q.a22;
+			b0 += q.b0;
+			b1 += q.b1;
+			b2 += q.b2;
+			c += q.c;
+			weight += q.weight;
+		}
+
+		// 각 평면까지 거리 제곱의 평균
+		double Evaluate(const Vector3& p) const
+		{
+			if (weight <= 0.0)
+			{
+				return 0.0;
+			}
+
+			const double x = p.x, y = p.y, z = p.z;
+			const double result = a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z +
+								  a11 * y * y + 2.0 * a12 * y * z + a22 * z * z +
+								  2.0 * (b0 * x + b1 * y + b2 * z) + c;
+			return max(result, 0.0) / weight;
+		}
+	};
+
+	struct Collapse {
+		uint32_t from;
+		uint32_t to;
+		double cost;
+	};
+
+	uint64_t MakeEdgeKey(uint32_t a, uint32_t b)
+	{
+		if (a > b)
+		{
+			swap(a, b);
+		}
+		return (uint64_t(a) << 32) | b;
+	}
+
+	// 같은 위치의 Vertex 중 처음 나온 것의 인덱스
+	vector<uint32_t> BuildPositionRemap(const vector<Vertex>& vertices)
+	{
+		struct PositionHasher {
+			size_t operator()(const Vector3& p) const
+			{
+				uint32_t bits[3];
+				memcpy(bits, &p, sizeof(bits));
+				return size_t(bits[0] * 73856093u ^ bits[1] * 19349663u ^ bits[2] * 83492791u);
+			}
+		};
+		struct PositionEqual {
+			bool operator()(const Vector3& a, const Vector3& b) const
+			{
+				return memcmp(&a, &b, sizeof(Vector3)) == 0;
+			}
+		};
+
+		unordered_map<Vector3, uint32_t, PositionHasher, PositionEqual> first(vertices.size());
+		vector<uint32_t> remap(vertices.size());
+		for (uint32_t i = 0; i < uint32_t(vertices.size()); i++)
+		{
+			remap[i] = first.emplace(vertices[i].position, i).first->second;
+		}
+
+		return remap;
+	}
+
+	// from을 to의 위치로 옮겼을 때 주변 삼각형이 뒤집히는지 확인
+	bool IsFlipped(const vector<Vertex>& vertices, const vector<uint32_t>& indices,
+				   const uint32_t* triangles, const uint32_t triangleCount, const uint32_t from,
+				   const uint32_t to)
+	{
+		const Vector3& target = vertices[to].position;
+
+		for (uint32_t i = 0; i < triangleCount; i++)
+		{
+			const uint32_t* tri = &indices[triangles[i] * 3];
+			if (tri[0] == to || tri[1] == to || tri[2] == to)
+			{
+				continue; // 없어지는 삼각형
+			}
+
+			Vector3 p[3] = { vertices[tri[0]].position, vertices[tri[1]].position, vertices[tri[2]].position };
+			const Vector3 before = (p[1] - p[0]).Cross(p[2] - p[0]);
+			for (int k = 0; k < 3; k++)
+			{
+				if (tri[k] == from)
+				{
+					p[k] = target;
+				}
+			}
+			const Vector3 after = (p[1] - p[0]).Cross(p[2] - p[0]);
+
+			if (before.Dot(after) <= 0.0f)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+
+std::vector<uint32_t> MeshSimplifier::Simplify(const std::vector<Vertex>& vertices,
+											   const std::vector<uint32_t>& indices,
+											   const size_t targetIndexCount, float& resultError)
+{
+	resultError = 0.0f;
+
+	vector<uint32_t> result(indices.begin(), indices.begin() + indices.size() / 3 * 3);
+	if (result.size() <= targetIndexCount)
+	{
+		return result;
+	}
+
+	const size_t vertexCount = vertices.size();
+	const vector<uint32_t> positionRemap = BuildPositionRemap(vertices);
+
+	// 1. 움직이면 안 되는 Vertex 표시
+	//    - Seam: 같은 위치에 다른 UV/Normal을 가진 Vertex가 있음
+	//    - Border/Non-manifold: 위치 기준으로 삼각형 1개 또는 3개 이상이 공유하는 Edge 위
+	vector<uint8_t> locked(vertexCount, 0);
+	{
+		vector<uint32_t> wedgeCount(vertexCount, 0);
+		for (size_t v = 0; v < vertexCount; v++)
+		{
+			wedgeCount[positionRemap[v]]++;
+		}
+		for (size_t v = 0; v < vertexCount; v++)
+		{
+			locked[v] = wedgeCount[positionRemap[v]] > 1;
+		}
+
+		unordered_map<uint64_t, uint32_t> edgeCount(result.size());
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			for (int k = 0; k < 3; k++)
+			{
+				const uint32_t a = positionRemap[result[i + k]];
+				const uint32_t b = positionRemap[result[i + (k + 1) % 3]];
+				edgeCount[MakeEdgeKey(a, b)]++;
+			}
+		}
+
+		vector<uint8_t> lockedPosition(vertexCount, 0);
+		for (const auto& edge : edgeCount)
+		{
+			if (edge.second != 2)
+			{
+				lockedPosition[uint32_t(edge.first >> 32)] = 1;
+				lockedPosition[uint32_t(edge.first & 0xFFFFFFFF)] = 1;
+			}
+		}
+		for (size_t v = 0; v < vertexCount; v++)
+		{
+			locked[v] |= lockedPosition[positionRemap[v]];
+		}
+	}
+
+	// 2. 각 Vertex에 주변 삼각형 평면들의 Quadric 누적
+	vector<Quadric> quadrics(vertexCount);
+	for (size_t i = 0; i < result.size(); i += 3)
+	{
+		const Vector3& p0 = vertices[result[i]].position;
+		const Vector3& p1 = vertices[result[i + 1]].position;
+		const Vector3& p2 = vertices[result[i + 2]].position;
+
+		Vector3 normal = (p1 - p0).Cross(p2 - p0);
+		if (normal.LengthSquared() <= 0.0f)
+		{
+			continue;
+		}
+		normal.Normalize();
+		const double d = -double(normal.Dot(p0));
+
+		for (int k = 0; k < 3; k++)
+		{
+			quadrics[result[i + k]].AddPlane(normal, d);
+		}
+	}
+
+	double maxCost = 0.0;
+	vector<uint32_t> collapseTarget(vertexCount);
+	vector<uint8_t> touched(vertexCount);
+	vector<uint32_t> adjacencyOffsets(vertexCount + 1);
+	vector<uint32_t> adjacency;
+	vector<Collapse> collapses;
+
+	// 3. 비용이 작은 Collapse부터, 서로 겹치지 않는 것들만 한 번에 적용하고 반복
+	while (result.size() > targetIndexCount)
+	{
+		const size_t triangleCount = result.size() / 3;
+
+		// Vertex -> 삼각형 (CSR)
+		fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+		for (const uint32_t index : result)
+		{
+			adjacencyOffsets[index + 1]++;
+		}
+		for (size_t v = 0; v < vertexCount; v++)
+		{
+			adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+		}
+		adjacency.resize(result.size());
+		{
+			vector<uint32_t> fillOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+			for (uint32_t i = 0; i < uint32_t(result.size()); i++)
+			{
+				adjacency[fillOffsets[result[i]]++] = i / 3;
+			}
+		}
+
+		collapses.clear();
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			for (int k = 0; k < 3; k++)
+			{
+				const uint32_t a = result[i + k];
+				const uint32_t b = result[i + (k + 1) % 3];
+				if (!locked[a])
+				{
+					collapses.push_back({ a, b, quadrics[a].Evaluate(vertices[b].position) });
+				}
+				if (!locked[b])
+				{
+					collapses.push_back({ b, a, quadrics[b].Evaluate(vertices[a].position) });
+				}
+			}
+		}
+
+		if (collapses.empty())
+		{
+			break;
+		}
+
+		sort(collapses.begin(), collapses.end(),
+			 [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+		for (uint32_t v = 0; v < uint32_t(vertexCount); v++)
+		{
+			collapseTarget[v] = v;
+		}
+		fill(touched.begin(), touched.end(), 0);
+
+		// Collapse 1번에 삼각형이 보통 2개씩 줄어듦
+		const size_t trianglesToRemove = triangleCount - targetIndexCount / 3;
+		size_t removedTriangles = 0;
+
+		for (const Collapse& collapse : collapses)
+		{
+			if (removedTriangles >= trianglesToRemove)
+			{
+				break;
+			}
+
+			const uint32_t from = collapse.from;
+			const uint32_t to = collapse.to;
+			if (touched[from] || touched[to])
+			{
+				continue;
+			}
+
+			const uint32_t* triangles = &adjacency[adjacencyOffsets[from]];
+			const uint32_t count = adjacencyOffsets[from + 1] - adjacencyOffsets[from];
+
+			if (IsFlipped(vertices, result, triangles, count, from, to))
+			{
+				continue;
+			}
+
+			collapseTarget[from] = to;
+			quadrics[to].Add(quadrics[from]);
+			maxCost = max(maxCost, collapse.cost);
+
+			// 이번 반복에서 주변 삼각형이 다시 바뀌지 않도록 1-Ring 전체를 잠금
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const uint32_t* tri = &result[triangles[i] * 3];
+				touched[tri[0]] = touched[tri[1]] = touched[tri[2]] = 1;
+				if (tri[0] == to || tri[1] == to || tri[2] == to)
+				{
+					removedTriangles++;
+				}
+			}
+		}
+
+		if (removedTriangles == 0)
+		{
+			break;
+		}
+
+		// 4. Index를 바꾸고 퇴화된 삼각형 제거
+		size_t write = 0;
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			const uint32_t a = collapseTarget[result[i]];
+			const uint32_t b = collapseTarget[result[i + 1]];
+			const uint32_t c = collapseTarget[result[i + 2]];
+			if (a != b && b != c && c != a)
+			{
+				result[write++] = a;
+				result[write++] = b;
+				result[write++] = c;
+			}
+		}
+		result.resize(write);
+	}
+
+	resultError = float(sqrt(maxCost));
+
+	return result;
+}
+
+std::vector<MeshLod> MeshSimplifier::BuildLodChain(const MeshData& meshData, const size_t maxLodCount,
+												   const float ratio)
+{
+	const size_t minTriangleCount = 32; // 이보다 작은 Mesh는 LOD 이득이 없음
+
+	vector<MeshLod> lods;
+	for (size_t level = 1; level < maxLodCount; level++)
+	{
+		const vector<uint32_t>& source = lods.empty() ? meshData.indices : lods.back().indices;
+		const float sourceError = lods.empty() ? 0.0f : lods.back().error;
+
+		const size_t sourceTriangleCount = source.size() / 3;
+		const size_t targetTriangleCount = size_t(float(sourceTriangleCount) * ratio);
+		if (targetTriangleCount < minTriangleCount)
+		{
+			break;
+		}
+
+		MeshLod lod;
+		float error = 0.0f;
+		lod.indices = Simplify(meshData.vertices, source, targetTriangleCount * 3, error);
+
+		// Seam이 많아서 거의 줄지 않았으면 중단
+		if (lod.indices.size() / 3 > sourceTriangleCount * 9 / 10)
+		{
+			break;
+		}
+
+		// 이전 LOD를 기준으로 단순화했으므로 오차는 누적
+		lod.error = sourceError + error;
+		MeshOptimizer::OptimizeVertexCache(lod.indices, meshData.vertices.size());
+
+		lods.push_back(std::move(lod));
+	}
+
+	return lods;
+}
+
+float LodSelector::GetPixelsPerUnit(const float distance, const float fovAngleY, const float viewportHeight)
+{
+	// 시점 안쪽이면 가장 세밀한 LOD가 선택되도록 아주 큰 값
+	const float safeDistance = max(distance, 1e-4f);
+
+	return viewportHeight * 0.5f / (safeDistance * tan(fovAngleY * 0.5f));
+}
+
+size_t LodSelector::Select(const std::vector<float>& lodErrors, const float pixelsPerUnit,
+						   const size_t currentLod, const float thresholdPixels, const float hysteresis)
+{
+	// 기준을 만족하는 가장 거친 LOD
+	for (size_t lod = lodErrors.size(); lod-- > 1;)
+	{
+		float threshold = thresholdPixels;
+		if (lod > currentLod)
+		{
+			threshold *= (1.0f - hysteresis);
+		}
+		else if (lod == currentLod)
+		{
+			threshold *= (1.0f + hysteresis);
+		}
+
+		if (lodErrors[lod] * pixelsPerUnit <= threshold)
+		{
+			return lod;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "MeshData.h"
+#include "Vertex.h"
+
+// Quadric Error Metric 기반 Edge Collapse (Vertex를 이웃 Vertex로 합침)
+// UV/Normal Seam과 열린 경계에 있는 Vertex는 움직이지 않으므로 모양과 Texture 경계가 유지됨
+class MeshSimplifier {
+public:
+	// targetIndexCount 이하가 되거나 더 이상 합칠 수 없을 때까지 단순화
+	// resultError: 이번 단순화로 생긴 최대 거리 추정치
+	static std::vector<uint32_t> Simplify(const std::vector<Vertex> &vertices,
+										  const std::vector<uint32_t> &indices,
+										  const size_t targetIndexCount, float &resultError);
+
+	// 삼각형 수를 ratio배씩 줄여가며 LOD 1 ~ (maxLodCount - 1) 생성
+	static std::vector<MeshLod> BuildLodChain(const MeshData &meshData, const size_t maxLodCount = 4,
+											  const float ratio = 0.5f);
+};
+
+// 화면에서 보이는 오차(픽셀)로 LOD 선택
+class LodSelector {
+public:
+	// Model Space 오차 1이 화면에서 몇 픽셀인지
+	static float GetPixelsPerUnit(const float distance, const float fovAngleY, const float viewportHeight);
+
+	// lodErrors는 LOD 0(오차 0)부터 오름차순
+	// 거친 LOD로 바꿀 때는 (1 - hysteresis), 현재 LOD를 유지할 때는 (1 + hysteresis) 만큼 기준을 조정해서
+	// 경계 거리에서 LOD가 매 프레임 바뀌는 것을 막음
+	static size_t Select(const std::vector<float> &lodErrors, const float pixelsPerUnit,
+						 const size_t currentLod, const float thresholdPixels = 1.0f,
+						 const float hysteresis = 0.25f);
+};
@@ -0,0 +1,232 @@
+#include "Meshlet.h"
+
+#include <DirectXCollision.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	void FinishMeshlet(Meshlet& meshlet, const Vertex* vertices, const uint32_t* indices,
+					   const vector<uint32_t>& meshletVertices)
+	{
+		meshlet.vertexCount = uint32_t(meshletVertices.size());
+
+		vector<XMFLOAT3> positions(meshletVertices.size());
+		for (size_t i = 0; i < meshletVertices.size(); i++)
+		{
+			positions[i] = vertices[meshletVertices[i]].position;
+		}
+
+		BoundingSphere sphere;
+		BoundingSphere::CreateFromPoints(sphere, positions.size(), positions.data(), sizeof(XMFLOAT3));
+		meshlet.center = sphere.Center;
+		meshlet.radius = sphere.Radius;
+
+		// 삼각형 법선(Winding 기준, 앞면 방향)의 평균을 축으로 사용
+		vector<Vector3> normals;
+		normals.reserve(meshlet.indexCount / 3);
+		Vector3 axis(0.0f);
+		for (uint32_t i = meshlet.indexOffset; i < meshlet.indexOffset + meshlet.indexCount; i += 3)
+		{
+			const Vector3& p0 = vertices[indices[i]].position;
+			const Vector3& p1 = vertices[indices[i + 1]].position;
+			const Vector3& p2 = vertices[indices[i + 2]].position;
+
+			Vector3 normal = (p1 - p0).Cross(p2 - p0);
+			if (normal.LengthSquared() > 1e-20f)
+			{
+				normal.Normalize();
+				normals.push_back(normal);
+				axis += normal;
+			}
+		}
+
+		meshlet.coneAxis = Vector3(0.0f);
+		meshlet.coneCutoff = 1.0f;
+
+		if (normals.empty() || axis.LengthSquared() < 1e-12f)
+		{
+			return;
+		}
+		axis.Normalize();
+
+		float minDot = 1.0f;
+		for (const Vector3& normal : normals)
+		{
+			minDot = min(minDot, normal.Dot(axis));
+		}
+
+		// 원뿔이 반구에 가까우면 뒷면이 될 수 있는 시점이 거의 없으므로 사용 안 함
+		if (minDot <= 0.1f)
+		{
+			return;
+		}
+
+		// 시선과 축 사이 각도가 90도 - (원뿔 반각)보다 작으면 모든 삼각형이 뒷면
+		meshlet.coneAxis = axis;
+		meshlet.coneCutoff = sqrt(1.0f - minDot * minDot);
+	}
+}
+
+MeshletCullView MeshletCullView::Create(const DirectX::SimpleMath::Matrix& worldRow,
+										const DirectX::SimpleMath::Matrix& viewRow,
+										const DirectX::SimpleMath::Matrix& projRow,
+										const DirectX::SimpleMath::Vector3& eyeWorld)
+{
+	MeshletCullView view;
+
+	// Row Vector 기준 Clip = v * M 이므로 M의 열로 Plane을 만듦 (D3D: 0 <= z <= w)
+	const Matrix m = worldRow * viewRow * projRow;
+	const Vector4 column0(m._11, m._21, m._31, m._41);
+	const Vector4 column1(m._12, m._22, m._32, m._42);
+	const Vector4 column2(m._13, m._23, m._33, m._43);
+	const Vector4 column3(m._14, m._24, m._34, m._44);
+
+	view.planes[0] = column3 + column0; // Left
+	view.planes[1] = column3 - column0; // Right
+	view.planes[2] = column3 + column1; // Bottom
+	view.planes[3] = column3 - column1; // Top
+	view.planes[4] = column2;			// Near
+	view.planes[5] = column3 - column2; // Far
+
+	for (Vector4& plane : view.planes)
+	{
+		const float length = Vector3(plane.x, plane.y, plane.z).Length();
+		if (length > 0.0f)
+		{
+			plane /= length;
+		}
+	}
+
+	view.eyeModel = Vector3::Transform(eyeWorld, worldRow.Invert());
+
+	// 직교 투영에서는 시점 위치로 뒷면을 판단할 수 없음
+	view.useConeCulling = (projRow._44 == 0.0f);
+
+	return view;
+}
+
+std::vector<Meshlet> MeshletBuilder::Build(const Vertex* vertices, const size_t vertexCount,
+										   const uint32_t* indices, const size_t indexCount,
+										   const uint32_t maxVertices, const uint32_t maxTriangles)
+{
+	vector<Meshlet> meshlets;
+
+	const size_t triangleCount = indexCount / 3;
+	if (triangleCount == 0)
+	{
+		return meshlets;
+	}
+
+	meshlets.reserve(triangleCount / maxTriangles + 1);
+
+	// 현재 Meshlet에 이미 들어있는 Vertex인지 표시 (Meshlet 번호 + 1)
+	vector<uint32_t> owner(vertexCount, 0);
+	vector<uint32_t> meshletVertices;
+	meshletVertices.reserve(maxVertices);
+
+	Meshlet current;
+	uint32_t currentId = 1;
+
+	for (size_t t = 0; t < triangleCount; t++)
+	{
+		const uint32_t* tri = &indices[t * 3];
+
+		uint32_t newVertices = 0;
+		for (int k = 0; k < 3; k++)
+		{
+			const bool duplicated = (k > 0 && tri[k] == tri[0]) || (k > 1 && tri[k] == tri[1]);
+			if (owner[tri[k]] != currentId && !duplicated)
+			{
+				newVertices++;
+			}
+		}
+
+		if (meshletVertices.size() + newVertices > maxVertices || current.indexCount / 3 + 1 > maxTriangles)
+		{
+			FinishMeshlet(current, vertices, indices, meshletVertices);
+			meshlets.push_back(current);
+
+			current = Meshlet();
+			current.indexOffset = uint32_t(t * 3);
+			meshletVertices.clear();
+			currentId++;
+		}
+
+		for (int k = 0; k < 3; k++)
+		{
+			if (owner[tri[k]] != currentId)
+			{
+				owner[tri[k]] = currentId;
+				meshletVertices.push_back(tri[k]);
+			}
+		}
+		current.indexCount += 3;
+	}
+
+	FinishMeshlet(current, vertices, indices, meshletVertices);
+	meshlets.push_back(current);
+
+	return meshlets;
+}
+
+bool MeshletBuilder::IsVisible(const Meshlet& meshlet, const MeshletCullView& view)
+{
+	for (const Vector4& plane : view.planes)
+	{
+		const float distance = plane.x * meshlet.center.x + plane.y * meshlet.center.y +
+							   plane.z * meshlet.center.z + plane.w;
+		if (distance < -meshlet.radius)
+		{
+			return false;
+		}
+	}
+
+	if (view.useConeCulling && meshlet.coneCutoff < 1.0f)
+	{
+		// 경계 구 안의 모든 점에서 봐도 뒷면인 경우만 제외 (보수적)
+		const Vector3 toCenter = meshlet.center - view.eyeModel;
+		if (toCenter.Dot(meshlet.coneAxis) >= meshlet.coneCutoff * toCenter.Length() + meshlet.radius)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+size_t MeshletBuilder::Cull(const std::vector<Meshlet>& meshlets, const MeshletCullView& view,
+							std::vector<MeshletDrawRange>& ranges)
+{
+	ranges.clear();
+
+	size_t visibleTriangles = 0;
+	for (const Meshlet& meshlet : meshlets)
+	{
+		if (!IsVisible(meshlet, view))
+		{
+			continue;
+		}
+
+		visibleTriangles += meshlet.indexCount / 3;
+
+		// Index Buffer에서 이어져 있으면 한 번의 DrawIndexed로 합침
+		if (!ranges.empty() && ranges.back().indexOffset + ranges.back().indexCount == meshlet.indexOffset)
+		{
+			ranges.back().indexCount += meshlet.indexCount;
+		}
+		else
+		{
+			MeshletDrawRange range;
+			range.indexOffset = meshlet.indexOffset;
+			range.indexCount = meshlet.indexCount;
+			ranges.push_back(range);
+		}
+	}
+
+	return visibleTriangles;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <directxtk/SimpleMath.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "Vertex.h"
+
+// Index Buffer에서 연속된 삼각형 묶음 (최대 64 Vertex, 124 삼각형)
+// 순서를 바꾸지 않고 나누기 때문에 DrawIndexed(indexCount, indexOffset, 0)로 바로 그릴 수 있음
+struct Meshlet {
+	uint32_t indexOffset = 0;
+	uint32_t indexCount = 0;
+	uint32_t vertexCount = 0; // 서로 다른 Vertex 수
+
+	// Model Space 경계 구
+	DirectX::SimpleMath::Vector3 center;
+	float radius = 0.0f;
+
+	// 삼각형 법선들이 들어가는 원뿔 (coneCutoff >= 1이면 뒷면 Culling 불가)
+	DirectX::SimpleMath::Vector3 coneAxis;
+	float coneCutoff = 1.0f;
+};
+
+// 연속으로 보이는 Meshlet들을 합친 DrawIndexed 범위
+struct MeshletDrawRange {
+	uint32_t indexOffset = 0;
+	uint32_t indexCount = 0;
+};
+
+// Culling은 Model Space에서 수행 (Plane과 시점을 Model Space로 옮김)
+struct MeshletCullView {
+	DirectX::SimpleMath::Vector4 planes[6]; // 안쪽이 양수, 정규화됨
+	DirectX::SimpleMath::Vector3 eyeModel;
+	bool useConeCulling = true;
+
+	// Camera::GetViewRow(), GetProjRow(), GetEyePos()와 Model의 worldRow로 생성
+	static MeshletCullView Create(const DirectX::SimpleMath::Matrix &worldRow,
+								  const DirectX::SimpleMath::Matrix &viewRow,
+								  const DirectX::SimpleMath::Matrix &projRow,
+								  const DirectX::SimpleMath::Vector3 &eyeWorld);
+};
+
+class MeshletBuilder {
+public:
+	static const uint32_t MAX_VERTICES = 64;
+	static const uint32_t MAX_TRIANGLES = 124;
+
+	// Index 순서(Vertex Cache 최적화 결과)를 유지하면서 앞에서부터 채움
+	static std::vector<Meshlet> Build(const Vertex *vertices, const size_t vertexCount,
+									  const uint32_t *indices, const size_t indexCount,
+									  const uint32_t maxVertices = MAX_VERTICES,
+									  const uint32_t maxTriangles = MAX_TRIANGLES);
+
+	static bool IsVisible(const Meshlet &meshlet, const MeshletCullView &view);
+
+	// 보이는 Meshlet만 모아서 ranges에 저장, 보이는 삼각형 수 반환
+	static size_t Cull(const std::vector<Meshlet> &meshlets, const MeshletCullView &view,
+					   std::vector<MeshletDrawRange> &ranges);
+};
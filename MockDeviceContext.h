@@ -0,0 +1,224 @@
+#pragma once
+
+#include <cstring>
+#include <vector>
+
+#include "D3D11Types.h"
+
+// StateCache를 Linux에서 Test/Benchmark하기 위한 Device Context
+// ID3D11DeviceContext와 같은 이름의 함수로 받은 호출을 기록하고 현재 상태를 저장
+// (D3D11처럼 Render Target과 SRV가 같은 자원인지는 검사하지 않음)
+class MockDeviceContext {
+public:
+	struct Call {
+		const char *name;
+		UINT startSlot;
+		UINT count; // Slot 수 (Slot이 없는 호출은 1)
+	};
+
+	struct Stage {
+		void *shader = nullptr;
+		ID3D11Buffer *constantBuffers[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT] = {};
+		ID3D11ShaderResourceView *shaderResources[D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT] = {};
+		ID3D11SamplerState *samplers[D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT] = {};
+	};
+
+	void IASetInputLayout(ID3D11InputLayout *inputLayout)
+	{
+		Record("IASetInputLayout");
+		m_inputLayout = inputLayout;
+	}
+
+	void IASetPrimitiveTopology(const D3D11_PRIMITIVE_TOPOLOGY topology)
+	{
+		Record("IASetPrimitiveTopology");
+		m_topology = topology;
+	}
+
+	void IASetVertexBuffers(const UINT startSlot, const UINT numBuffers, ID3D11Buffer *const *buffers,
+							const UINT *strides, const UINT *offsets)
+	{
+		Record("IASetVertexBuffers", startSlot, numBuffers);
+		for (UINT i = 0; i < numBuffers; i++)
+		{
+			m_vertexBuffers[startSlot + i] = buffers[i];
+			m_vertexStrides[startSlot + i] = strides[i];
+			m_vertexOffsets[startSlot + i] = offsets[i];
+		}
+	}
+
+	void IASetIndexBuffer(ID3D11Buffer *indexBuffer, const DXGI_FORMAT format, const UINT offset)
+	{
+		Record("IASetIndexBuffer");
+		m_indexBuffer = indexBuffer;
+		m_indexFormat = format;
+		m_indexOffset = offset;
+	}
+
+	void VSSetShader(ID3D11VertexShader *shader, ID3D11ClassInstance *const *, UINT)
+	{
+		Record("VSSetShader");
+		m_vs.shader = shader;
+	}
+
+	void HSSetShader(ID3D11HullShader *shader, ID3D11ClassInstance *const *, UINT)
+	{
+		Record("HSSetShader");
+		m_hs.shader = shader;
+	}
+
+	void DSSetShader(ID3D11DomainShader *shader, ID3D11ClassInstance *const *, UINT)
+	{
+		Record("DSSetShader");
+		m_ds.shader = shader;
+	}
+
+	void GSSetShader(ID3D11GeometryShader *shader, ID3D11ClassInstance *const *, UINT)
+	{
+		Record("GSSetShader");
+		m_gs.shader = shader;
+	}
+
+	void PSSetShader(ID3D11PixelShader *shader, ID3D11ClassInstance *const *, UINT)
+	{
+		Record("PSSetShader");
+		m_ps.shader = shader;
+	}
+
+	void VSSetConstantBuffers(const UINT startSlot, const UINT num, ID3D11Buffer *const *buffers)
+	{
+		Record("VSSetConstantBuffers", startSlot, num);
+		Copy(m_vs.constantBuffers, startSlot, num, buffers);
+	}
+
+	void GSSetConstantBuffers(const UINT startSlot, const UINT num, ID3D11Buffer *const *buffers)
+	{
+		Record("GSSetConstantBuffers", startSlot, num);
+		Copy(m_gs.constantBuffers, startSlot, num, buffers);
+	}
+
+	void PSSetConstantBuffers(const UINT startSlot, const UINT num, ID3D11Buffer *const *buffers)
+	{
+		Record("PSSetConstantBuffers", startSlot, num);
+		Copy(m_ps.constantBuffers, startSlot, num, buffers);
+	}
+
+	void VSSetShaderResources(const UINT startSlot, const UINT num, ID3D11ShaderResourceView *const *views)
+	{
+		Record("VSSetShaderResources", startSlot, num);
+		Copy(m_vs.shaderResources, startSlot, num, views);
+	}
+
+	void GSSetShaderResources(const UINT startSlot, const UINT num, ID3D11ShaderResourceView *const *views)
+	{
+		Record("GSSetShaderResources", startSlot, num);
+		Copy(m_gs.shaderResources, startSlot, num, views);
+	}
+
+	void PSSetShaderResources(const UINT startSlot, const UINT num, ID3D11ShaderResourceView *const *views)
+	{
+		Record("PSSetShaderResources", startSlot, num);
+		Copy(m_ps.shaderResources, startSlot, num, views);
+	}
+
+	void VSSetSamplers(const UINT startSlot, const UINT num, ID3D11SamplerState *const *samplers)
+	{
+		Record("VSSetSamplers", startSlot, num);
+		Copy(m_vs.samplers, startSlot, num, samplers);
+	}
+
+	void PSSetSamplers(const UINT startSlot, const UINT num, ID3D11SamplerState *const *samplers)
+	{
+		Record("PSSetSamplers", startSlot, num);
+		Copy(m_ps.samplers, startSlot, num, samplers);
+	}
+
+	void RSSetState(ID3D11RasterizerState *rasterizerState)
+	{
+		Record("RSSetState");
+		m_rasterizerState = rasterizerState;
+	}
+
+	void OMSetBlendState(ID3D11BlendState *blendState, const FLOAT blendFactor[4], const UINT sampleMask)
+	{
+		Record("OMSetBlendState");
+		m_blendState = blendState;
+		for (int i = 0; i < 4; i++)
+		{
+			m_blendFactor[i] = blendFactor ? blendFactor[i] : 1.0f;
+		}
+		m_sampleMask = sampleMask;
+	}
+
+	void OMSetDepthStencilState(ID3D11DepthStencilState *depthStencilState, const UINT stencilRef)
+	{
+		Record("OMSetDepthStencilState");
+		m_depthStencilState = depthStencilState;
+		m_stencilRef = stencilRef;
+	}
+
+	void OMSetRenderTargets(const UINT numViews, ID3D11RenderTargetView *const *, ID3D11DepthStencilView *)
+	{
+		Record("OMSetRenderTargets", 0, numViews);
+	}
+
+	void DrawIndexed(const UINT, const UINT, const INT)
+	{
+		Record("DrawIndexed");
+		m_drawCount++;
+	}
+
+	// 두 Context의 상태가 같은지 (StateCache를 거친 것과 직접 호출한 것 비교)
+	bool HasSameState(const MockDeviceContext &other) const
+	{
+		auto same = [](const auto &a, const auto &b) { return memcmp(&a, &b, sizeof(a)) == 0; };
+		return m_inputLayout == other.m_inputLayout && m_topology == other.m_topology &&
+			   same(m_vertexBuffers, other.m_vertexBuffers) && same(m_vertexStrides, other.m_vertexStrides) &&
+			   same(m_vertexOffsets, other.m_vertexOffsets) && m_indexBuffer == other.m_indexBuffer &&
+			   m_indexFormat == other.m_indexFormat && m_indexOffset == other.m_indexOffset &&
+			   same(m_vs, other.m_vs) && same(m_hs, other.m_hs) && same(m_ds, other.m_ds) &&
+			   same(m_gs, other.m_gs) && same(m_ps, other.m_ps) && m_rasterizerState == other.m_rasterizerState &&
+			   m_blendState == other.m_blendState && same(m_blendFactor, other.m_blendFactor) &&
+			   m_sampleMask == other.m_sampleMask && m_depthStencilState == other.m_depthStencilState &&
+			   m_stencilRef == other.m_stencilRef;
+	}
+
+	void ClearCalls() { m_calls.clear(); }
+
+public:
+	std::vector<Call> m_calls;
+	size_t m_slotCount = 0; // 모든 호출이 설정한 Slot 수의 합
+	size_t m_drawCount = 0;
+
+	ID3D11InputLayout *m_inputLayout = nullptr;
+	D3D11_PRIMITIVE_TOPOLOGY m_topology = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+	ID3D11Buffer *m_vertexBuffers[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT] = {};
+	UINT m_vertexStrides[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT] = {};
+	UINT m_vertexOffsets[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT] = {};
+	ID3D11Buffer *m_indexBuffer = nullptr;
+	DXGI_FORMAT m_indexFormat = DXGI_FORMAT_UNKNOWN;
+	UINT m_indexOffset = 0;
+	Stage m_vs, m_hs, m_ds, m_gs, m_ps;
+	ID3D11RasterizerState *m_rasterizerState = nullptr;
+	ID3D11BlendState *m_blendState = nullptr;
+	FLOAT m_blendFactor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	UINT m_sampleMask = 0xffffffff;
+	ID3D11DepthStencilState *m_depthStencilState = nullptr;
+	UINT m_stencilRef = 0;
+
+private:
+	void Record(const char *name, const UINT startSlot = 0, const UINT count = 1)
+	{
+		m_calls.push_back({ name, startSlot, count });
+		m_slotCount += count;
+	}
+
+	template <typename T, size_t N>
+	static void Copy(T (&dst)[N], const UINT startSlot, const UINT num, T const *src)
+	{
+		for (UINT i = 0; i < num && startSlot + i < N; i++)
+		{
+			dst[startSlot + i] = src[i];
+		}
+	}
+};
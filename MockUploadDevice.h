@@ -0,0 +1,193 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "UploadManager.h"
+
+// GPU 자원 대신 CPU 메모리 (Texture는 Subresource마다 Block 단위로 저장)
+struct MockResource {
+	std::vector<std::vector<uint8_t>> subresources;
+	std::vector<size_t> rowPitches;
+	uint32_t blockSize = 1;
+	uint32_t bytesPerBlock = 1;
+	int refCount = 1;
+
+	static std::unique_ptr<MockResource> CreateBuffer(const size_t size)
+	{
+		std::unique_ptr<MockResource> resource = std::make_unique<MockResource>();
+		resource->subresources.assign(1, std::vector<uint8_t>(size, 0));
+		resource->rowPitches.assign(1, size);
+		return resource;
+	}
+
+	static std::unique_ptr<MockResource> CreateTexture(const DXGI_FORMAT format, const int width, const int height,
+													   const int mipLevels, const int arraySize)
+	{
+		std::unique_ptr<MockResource> resource = std::make_unique<MockResource>();
+		ImageData probe;
+		probe.format = format;
+		probe.width = width;
+		probe.height = height;
+		resource->blockSize = ImageData::IsBlockCompressed(format) ? 4 : 1;
+		resource->bytesPerBlock = uint32_t(probe.GetRowPitch(0) / ((width + resource->blockSize - 1) / resource->blockSize));
+
+		for (int slice = 0; slice < arraySize; slice++)
+		{
+			for (int mip = 0; mip < mipLevels; mip++)
+			{
+				resource->subresources.emplace_back(probe.GetMipSize(mip), 0);
+				resource->rowPitches.push_back(probe.GetRowPitch(mip));
+			}
+		}
+		return resource;
+	}
+
+	ID3D11Resource *Get() { return reinterpret_cast<ID3D11Resource *>(this); }
+};
+
+// UploadManager를 Linux에서 Test/Benchmark하기 위한 UploadDevice
+// Copy()는 바로 메모리 복사, Fence는 Signal()보다 gpuLatency만큼 늦게 완료된 것으로 봄
+class MockUploadDevice : public UploadDevice {
+public:
+	struct Page {
+		UploadPageDesc desc;
+		std::vector<uint8_t> data;
+		size_t rowPitch = 0;
+		uint32_t blockSize = 1;
+		uint32_t bytesPerBlock = 1;
+		bool isMapped = false;
+		uint64_t lastFence = 0; // 이 Page를 읽는 마지막 복사
+	};
+
+	void *CreatePage(const UploadPageDesc &desc) override
+	{
+		Page *page = new Page();
+		page->desc = desc;
+		if (desc.format == DXGI_FORMAT_UNKNOWN)
+		{
+			page->rowPitch = desc.width;
+		}
+		else
+		{
+			ImageData probe;
+			probe.format = desc.format;
+			probe.width = int(desc.width);
+			probe.height = int(desc.height);
+			page->blockSize = ImageData::IsBlockCompressed(desc.format) ? 4 : 1;
+			page->rowPitch = probe.GetRowPitch(0);
+			page->bytesPerBlock = uint32_t(page->rowPitch / (desc.width / page->blockSize));
+		}
+		page->data.assign(page->rowPitch * (desc.height / page->blockSize), 0);
+
+		m_pageCreateCount++;
+		m_livePageCount++;
+		return page;
+	}
+
+	void DestroyPage(void *page) override
+	{
+		delete (Page *)page;
+		m_livePageCount--;
+	}
+
+	uint8_t *MapPage(void *handle, size_t &rowPitch) override
+	{
+		Page *page = (Page *)handle;
+
+		// D3D11이라면 여기서 GPU를 기다림
+		if (page->lastFence > m_completed)
+		{
+			m_mapStallCount++;
+			m_completed = page->lastFence;
+		}
+
+		page->isMapped = true;
+		rowPitch = page->rowPitch;
+		m_mapCount++;
+		return page->data.data();
+	}
+
+	void UnmapPage(void *handle) override { ((Page *)handle)->isMapped = false; }
+
+	void Copy(void *handle, const UploadCopy &copy) override
+	{
+		Page *page = (Page *)handle;
+		if (page->isMapped)
+		{
+			m_errorCount++; // D3D11은 Map한 채로 복사할 수 없음
+		}
+
+		const uint8_t *src = page->data.data() + (copy.srcY / page->blockSize) * page->rowPitch +
+							 (copy.srcX / page->blockSize) * page->bytesPerBlock;
+		Write(copy, src, page->rowPitch);
+
+		page->lastFence = m_signaled + 1;
+		m_copyCount++;
+	}
+
+	void UpdateDirect(const UploadCopy &copy, const uint8_t *data, const size_t rowPitch) override
+	{
+		Write(copy, data, rowPitch);
+		m_directCount++;
+	}
+
+	void AddRef(ID3D11Resource *resource) override { ((MockResource *)resource)->refCount++; }
+	void Release(ID3D11Resource *resource) override { ((MockResource *)resource)->refCount--; }
+
+	uint64_t Signal() override { return ++m_signaled; }
+
+	uint64_t GetCompletedFence() override
+	{
+		m_completed = std::max(m_completed, m_signaled > m_gpuLatency ? m_signaled - m_gpuLatency : 0);
+		return m_completed;
+	}
+
+	void WaitForFence(const uint64_t fence) override
+	{
+		m_completed = std::max(m_completed, fence);
+		m_waitCount++;
+	}
+
+public:
+	uint64_t m_gpuLatency = 2; // 몇 번의 Signal() 뒤에 완료되는지
+
+	uint64_t m_signaled = 0;
+	uint64_t m_completed = 0;
+
+	size_t m_pageCreateCount = 0;
+	size_t m_livePageCount = 0;
+	size_t m_mapCount = 0;
+	size_t m_mapStallCount = 0; // 아직 GPU가 읽는 Page를 Map (D3D11이라면 기다림)
+	size_t m_copyCount = 0;
+	size_t m_copiedBytes = 0;
+	size_t m_directCount = 0;
+	size_t m_waitCount = 0;
+	size_t m_errorCount = 0;
+
+private:
+	void Write(const UploadCopy &copy, const uint8_t *src, const size_t srcPitch)
+	{
+		MockResource *dst = (MockResource *)copy.dst;
+		std::vector<uint8_t> &data = dst->subresources[copy.subresource];
+		const size_t dstPitch = dst->rowPitches[copy.subresource];
+
+		// 작은 Mip은 Block 하나보다 작아도 Block 단위로 복사
+		const size_t rowBytes = (copy.width + dst->blockSize - 1) / dst->blockSize * dst->bytesPerBlock;
+		const uint32_t rows = (copy.height + dst->blockSize - 1) / dst->blockSize;
+		const size_t offset = (copy.dstY / dst->blockSize) * dstPitch + (copy.dstX / dst->blockSize) * dst->bytesPerBlock;
+
+		for (uint32_t r = 0; r < rows; r++)
+		{
+			if (offset + r * dstPitch + rowBytes > data.size())
+			{
+				m_errorCount++;
+				return;
+			}
+			memcpy(data.data() + offset + r * dstPitch, src + r * srcPitch, rowBytes);
+		}
+		m_copiedBytes += rowBytes * rows;
+	}
+};
@@ -1,14 +1,27 @@
 #include "Model.h"
+#include "BoundsCalculator.h"
 #include "GeometryGenerator.h"
+#include "MeshSimplifier.h"
+#include "Stats.h"
+#include "ThreadPool.h"
+#include "VertexQuantizer.h"
+
+#include <algorithm>
 
 using namespace std;
 using namespace DirectX::SimpleMath;
 
+namespace {
+	// 이미 GPU에 있는 Texture는 Decoding하지 않음
+	bool IsTextureLoaded(const string& key) { return TextureCache::GetInstance().Contains(key); }
+}
+
 Model::Model(Microsoft::WRL::ComPtr<ID3D11Device>& device,
 			 Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
-			 const std::string& basePath, const std::string& fileName)
+			 const std::string& basePath, const std::string& fileName,
+			 bool reverseNormal)
 {
-	this->Initialize(device, context, basePath, fileName);
+	this->Initialize(device, context, basePath, fileName, reverseNormal);
 }
 
 Model::Model(Microsoft::WRL::ComPtr<ID3D11Device>& device,
@@ -20,9 +33,51 @@ Model::Model(Microsoft::WRL::ComPtr<ID3D11Device>& device,
 
 void Model::Initialize(Microsoft::WRL::ComPtr<ID3D11Device>& device,
 					   Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
-					   const std::string& basePath, const std::string& fileName)
+					   const std::string& basePath, const std::string& fileName,
+					   bool reverseNormal)
 {
-	vector<MeshData> meshes = GeometryGenerator::ReadFromFile(basePath, fileName);
+	// Cooked 캐시가 최신이면 mmap된 메모리에서 바로 GPU 버퍼 생성 (Assimp, 복사 X)
+	shared_ptr<MeshCache> cache = MeshCache::Load(basePath, fileName, reverseNormal);
+	if (cache)
+	{
+		m_meshConstsCPU.world = Matrix();
+
+		D3D11Utils::CreateConstBuffer(device, m_meshConstsCPU, m_meshConstsGPU);
+		D3D11Utils::CreateConstBuffer(device, m_materialConstsCPU, m_materialConstsGPU);
+
+		const vector<CookedMesh>& cookedMeshes = cache->GetMeshes();
+
+		// Texture Decoding은 Worker Thread에서 한꺼번에
+		vector<MeshImages> images(cookedMeshes.size());
+		ThreadPool::GetInstance().ParallelFor(0, cookedMeshes.size(), [&](size_t i) {
+			ImageLoader::ReadMeshImages(cookedMeshes[i].material, images[i], IsTextureLoaded);
+		});
+
+		// 처음 올리는 Texture들은 한꺼번에 생성 (InitializeMesh()에서는 찾기만 함)
+		vector<KeyedImage> keyedImages;
+		for (size_t i = 0; i < cookedMeshes.size(); i++)
+		{
+			ImageLoader::GetMeshImageKeys(cookedMeshes[i].material, images[i], keyedImages);
+		}
+		const vector<shared_ptr<const TextureResource>> textures =
+			TextureCache::GetInstance().CreateBatch(device, context, keyedImages);
+
+		for (size_t i = 0; i < cookedMeshes.size(); i++)
+		{
+			const CookedMesh& cooked = cookedMeshes[i];
+			InitializeMesh(device, context, cooked.vertices, cooked.vertexCount,
+						   cooked.indices, cooked.indexCount, cooked.lods, cooked.bounds,
+						   cooked.material, images[i]);
+		}
+
+		UpdateLodErrors();
+		UpdateBounds();
+		ReportBufferMemory();
+
+		return;
+	}
+
+	vector<MeshData> meshes = GeometryGenerator::ReadFromFile(basePath, fileName, reverseNormal);
 
 	Initialize(device, context, meshes);
 }
@@ -30,6 +85,53 @@ void Model::Initialize(Microsoft::WRL::ComPtr<ID3D11Device>& device,
 void Model::Initialize(Microsoft::WRL::ComPtr<ID3D11Device>& device,
 					   Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
 					   const std::vector<MeshData>& meshes)
+{
+	vector<MeshImages> images(meshes.size());
+	ThreadPool::GetInstance().ParallelFor(0, meshes.size(), [&](size_t i) {
+		ImageLoader::ReadMeshImages(meshes[i], images[i], IsTextureLoaded);
+	});
+
+	InitializeMeshes(device, context, meshes, images);
+}
+
+void Model::Initialize(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+					   Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
+					   const ModelPayload& payload)
+{
+	// Placeholder로 그리던 Mesh를 교체
+	m_meshes.clear();
+	m_visibleRanges.clear();
+	m_lod = 0;
+
+	InitializeMeshes(device, context, payload.meshes, payload.images);
+
+	// 교체 전에 설정한 World 행렬 유지
+	UpdateWorldRow(m_worldRow);
+}
+
+void Model::InitializeShared(Microsoft::WRL::ComPtr<ID3D11Device>& device, const Model& source)
+{
+	m_meshes = source.m_meshes;
+	m_visibleRanges.clear();
+	m_lodErrors = source.m_lodErrors;
+	m_bounds = source.m_bounds;
+	m_geometryVersion++;
+	m_useQuantizedVertices = source.m_useQuantizedVertices;
+	m_lod = 0;
+
+	// Texture 사용 여부 등은 원본 설정에서 시작
+	m_meshConstsCPU = source.m_meshConstsCPU;
+	m_materialConstsCPU = source.m_materialConstsCPU;
+	UpdateWorldRow(Matrix());
+
+	D3D11Utils::CreateConstBuffer(device, m_meshConstsCPU, m_meshConstsGPU);
+	D3D11Utils::CreateConstBuffer(device, m_materialConstsCPU, m_materialConstsGPU);
+}
+
+void Model::InitializeMeshes(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+							 Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
+							 const std::vector<MeshData>& meshes,
+							 const std::vector<MeshImages>& images)
 {
 	// Create ConstantBuffer
 	m_meshConstsCPU.world = Matrix();
@@ -37,117 +139,593 @@ void Model::Initialize(Microsoft::WRL::ComPtr<ID3D11Device>& device,
 	D3D11Utils::CreateConstBuffer(device, m_meshConstsCPU, m_meshConstsGPU);
 	D3D11Utils::CreateConstBuffer(device, m_materialConstsCPU, m_materialConstsGPU);
 
-	for (const MeshData& meshData : meshes)
+	// 처음 올리는 Texture들은 한꺼번에 생성 (InitializeMesh()에서는 찾기만 함)
+	vector<KeyedImage> keyedImages;
+	for (size_t i = 0; i < meshes.size(); i++)
 	{
-		shared_ptr<Mesh> newMesh = make_shared<Mesh>();
-		D3D11Utils::CreateVertexBuffer(device, meshData.vertices, newMesh->vertexBuffer);
-		newMesh->indexCount = UINT(meshData.indices.size());
-		newMesh->vertexCount = UINT(meshData.vertices.size());
-		newMesh->stride = UINT(sizeof(Vertex));
-		D3D11Utils::CreateIndexBuffer(device, meshData.indices, newMesh->indexBuffer);
+		ImageLoader::GetMeshImageKeys(meshes[i], images[i], keyedImages);
+	}
+	const vector<shared_ptr<const TextureResource>> textures =
+		TextureCache::GetInstance().CreateBatch(device, context, keyedImages);
+
+	vector<uint32_t> indices;
+	vector<MeshLodRange> lods;
 
-		if (!meshData.albedoTextureFileName.empty())
+	for (size_t i = 0; i < meshes.size(); i++)
+	{
+		const MeshData& meshData = meshes[i];
+
+		// GeometryGenerator::MakeXXX()로 만든 Mesh는 경계가 없으므로 여기서 계산
+		const MeshBounds bounds = meshData.bounds.isValid
+									  ? meshData.bounds
+									  : BoundsCalculator::Compute(meshData.vertices.data(), meshData.vertices.size());
+
+		lods.resize(meshData.lods.size() + 1);
+		lods[0].indexOffset = 0;
+		lods[0].indexCount = UINT(meshData.indices.size());
+		lods[0].error = 0.0f;
+
+		if (meshData.lods.empty())
 		{
-			D3D11Utils::CreateTexture(device, context, meshData.albedoTextureFileName, true,
-									  newMesh->albedoTexture, newMesh->albedoSRV);
-			m_materialConstsCPU.useAlbedoMap = true;
+			InitializeMesh(device, context, meshData.vertices.data(), meshData.vertices.size(),
+						   meshData.indices.data(), meshData.indices.size(), lods, bounds, meshData, images[i]);
+			continue;
 		}
-		if (!meshData.emissiveTextureFileName.empty())
+
+		// LOD들을 하나의 Index Buffer로 이어붙임
+		indices.assign(meshData.indices.begin(), meshData.indices.end());
+		for (size_t l = 0; l < meshData.lods.size(); l++)
 		{
-			D3D11Utils::CreateTexture(device, context, meshData.emissiveTextureFileName, true,
-									  newMesh->emissiveTexture, newMesh->emissiveSRV);
-			m_materialConstsCPU.useEmissiveMap = true;
+			lods[l + 1].indexOffset = UINT(indices.size());
+			lods[l + 1].indexCount = UINT(meshData.lods[l].indices.size());
+			lods[l + 1].error = meshData.lods[l].error;
+			indices.insert(indices.end(), meshData.lods[l].indices.begin(), meshData.lods[l].indices.end());
 		}
-		if (!meshData.normalTextureFileName.empty())
+
+		InitializeMesh(device, context, meshData.vertices.data(), meshData.vertices.size(),
+					   indices.data(), indices.size(), lods, bounds, meshData, images[i]);
+	}
+
+	UpdateLodErrors();
+	UpdateBounds();
+	ReportBufferMemory();
+}
+
+void Model::InitializeMesh(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+						   Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
+						   const Vertex* vertices, const size_t vertexCount,
+						   const uint32_t* indices, const size_t indexCount,
+						   const std::vector<MeshLodRange>& lods, const MeshBounds& bounds,
+						   const MeshData& meshData, const MeshImages& images)
+{
+	shared_ptr<Mesh> newMesh = make_shared<Mesh>();
+	newMesh->bounds = bounds;
+	if (m_useQuantizedVertices)
+	{
+		newMesh->quantizationConstsCPU = VertexQuantizer::ComputeConstants(vertices, vertexCount);
+
+		vector<QuantizedVertex> quantized;
+		VertexQuantizer::Quantize(vertices, vertexCount, newMesh->quantizationConstsCPU, quantized);
+		D3D11Utils::CreateVertexBuffer(device, quantized, newMesh->vertexBuffer);
+		D3D11Utils::CreateConstBuffer(device, newMesh->quantizationConstsCPU, newMesh->quantizationConstBuffer);
+		newMesh->stride = UINT(sizeof(QuantizedVertex));
+
+		vector<QuantizedPosition> positions;
+		VertexQuantizer::ExtractPositions(quantized.data(), quantized.size(), positions);
+		D3D11Utils::CreateVertexBuffer(device, positions, newMesh->positionBuffer);
+		newMesh->positionStride = UINT(sizeof(QuantizedPosition));
+	}
+	else
+	{
+		D3D11Utils::CreateVertexBuffer(device, vertices, vertexCount, newMesh->vertexBuffer);
+		newMesh->stride = UINT(sizeof(Vertex));
+	}
+	newMesh->lods = lods;
+	newMesh->indexCount = lods[0].indexCount; // LOD 0
+	newMesh->vertexCount = UINT(vertexCount);
+
+	// 대부분 16-bit로 충분함 (Vertex가 많으면 구간을 나눠서 BaseVertex 사용)
+	vector<uint16_t> narrowIndices;
+	if (IndexNarrower::Build(indices, indexCount, narrowIndices, newMesh->indexChunks))
+	{
+		D3D11Utils::CreateIndexBuffer(device, narrowIndices, newMesh->indexBuffer);
+		newMesh->indexFormat = DXGI_FORMAT_R16_UINT;
+	}
+	else
+	{
+		D3D11Utils::CreateIndexBuffer(device, indices, indexCount, newMesh->indexBuffer);
+		newMesh->indexFormat = DXGI_FORMAT_R32_UINT;
+
+		IndexChunk chunk;
+		chunk.indexCount = uint32_t(indexCount);
+		newMesh->indexChunks.assign(1, chunk);
+	}
+
+	// Meshlet Culling은 LOD 0에만 사용
+	newMesh->meshlets = MeshletBuilder::Build(vertices, vertexCount, indices, newMesh->indexCount);
+
+	// Picking은 LOD 0 삼각형으로
+	newMesh->bvh.Build(vertices, vertexCount, indices, newMesh->indexCount);
+
+	// 같은 Texture는 TextureCache에서 공유, 처음 올릴 때만 images 사용
+	// (이미 GPU에 있어서 Decoding을 건너뛰었는데 그 사이 해제되었으면 여기서 읽음)
+	auto setTexture = [&](const string& key, const shared_ptr<const ImageData>& image,
+						  const TextureCache::ReadFunc& readImage,
+						  shared_ptr<const TextureResource>& texture,
+						  Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv) {
+		texture = TextureCache::GetInstance().GetOrCreate(device, context, key, [&]() {
+			return image ? image : readImage();
+		});
+		if (texture)
 		{
-			D3D11Utils::CreateTexture(device, context, meshData.normalTextureFileName, false,
-									  newMesh->normalTexture, newMesh->normalSRV);
-			m_materialConstsCPU.useNormalMap = true;
+			srv = texture->srv;
 		}
-		if (!meshData.heightTextureFileName.empty())
+	};
+	auto setFileTexture = [&](const string& fileName, const bool useSRGB,
+							  const shared_ptr<const ImageData>& image,
+							  shared_ptr<const TextureResource>& texture,
+							  Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv) {
+		setTexture(ImageLoader::MakeKey(fileName, useSRGB), image,
+				   [&]() { return ImageLoader::ReadImageCached(fileName, useSRGB); }, texture, srv);
+	};
+
+	if (!meshData.albedoTextureFileName.empty())
+	{
+		setFileTexture(meshData.albedoTextureFileName, true, images.albedo,
+					   newMesh->albedoTexture, newMesh->albedoSRV);
+		m_materialConstsCPU.useAlbedoMap = true;
+	}
+	if (!meshData.emissiveTextureFileName.empty())
+	{
+		setFileTexture(meshData.emissiveTextureFileName, true, images.emissive,
+					   newMesh->emissiveTexture, newMesh->emissiveSRV);
+		m_materialConstsCPU.useEmissiveMap = true;
+	}
+	if (!meshData.normalTextureFileName.empty())
+	{
+		setFileTexture(meshData.normalTextureFileName, false, images.normal,
+					   newMesh->normalTexture, newMesh->normalSRV);
+		m_materialConstsCPU.useNormalMap = true;
+	}
+	if (!meshData.heightTextureFileName.empty())
+	{
+		setFileTexture(meshData.heightTextureFileName, false, images.height,
+					   newMesh->heightTexture, newMesh->heightSRV);
+		m_meshConstsCPU.useHeightMap = true;
+	}
+
+	// AO, Roughness, Metallic을 하나의 Texture에 넣음 (Shader에서 한 번만 Sample)
+	// Red: Occlusion, Green: Roughness, Blue: Metallic
+	const string& ao = meshData.aoTextureFileName;
+	const string& roughness = meshData.roughnessTextureFileName;
+	const string& metallic = meshData.metallicTextureFileName;
+	if (!ao.empty() || !roughness.empty() || !metallic.empty())
+	{
+		setTexture(ImageLoader::MakeORMKey(ao, roughness, metallic), images.orm,
+				   [&]() { return ImageLoader::ReadORMCached(ao, roughness, metallic); },
+				   newMesh->ormTexture, newMesh->ormSRV);
+	}
+	if (!ao.empty())
+	{
+		m_materialConstsCPU.useAoMap = true;
+	}
+	if (!metallic.empty())
+	{
+		m_materialConstsCPU.useMetallicMap = true;
+	}
+	if (!roughness.empty())
+	{
+		m_materialConstsCPU.useRoughnessMap = true;
+	}
+
+	this->m_meshes.push_back(newMesh);
+}
+
+void Model::UpdateConstantBuffers(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+								  Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context)
+{
+	if (m_isVisible)
+	{
+		D3D11Utils::UpdateBuffer(device, context, m_meshConstsCPU, m_meshConstsGPU);
+		D3D11Utils::UpdateBuffer(device, context, m_materialConstsCPU, m_materialConstsGPU);
+	}
+}
+
+void Model::Render(Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
+				   const CullVisibility& visibility)
+{
+	if (IsVisible(visibility))
+	{
+		for (size_t i = 0; i < m_meshes.size(); i++)
 		{
-			D3D11Utils::CreateTexture(device, context, meshData.heightTextureFileName, false,
-									  newMesh->heightTexture, newMesh->heightSRV);
-			m_meshConstsCPU.useHeightMap = true;
+			if (!IsMeshVisible(visibility, i))
+			{
+				continue;
+			}
+
+			const Mesh& mesh = *m_meshes[i];
+			SetMeshResources(context, mesh);
+
+			const MeshLodRange& lod = mesh.lods[min(m_lod, mesh.lods.size() - 1)];
+			DrawIndexRange(context.Get(), mesh, lod.indexOffset, lod.indexCount);
 		}
-		if (!meshData.aoTextureFileName.empty())
+	}
+}
+
+size_t Model::RenderDepthOnly(Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
+							  const CullVisibility& visibility, size_t* fullFetchBytes)
+{
+	if (!IsVisible(visibility))
+	{
+		return 0;
+	}
+
+	size_t fetchBytes = 0;
+	for (size_t i = 0; i < m_meshes.size(); i++)
+	{
+		if (!IsMeshVisible(visibility, i))
 		{
-			D3D11Utils::CreateTexture(device, context, meshData.aoTextureFileName, false,
-									  newMesh->aoTexture, newMesh->aoSRV);
-			m_materialConstsCPU.useAoMap = true;
+			continue;
 		}
 
-		// GLTF 방식으로 Metallic과 Roughness를 하나의 texture에 넣음
-		// Green: Roughness, Blue: Metallic
-		if (!meshData.metallicTextureFileName.empty() || !meshData.roughnessTextureFileName.empty())
+		const shared_ptr<const Mesh>& mesh = m_meshes[i];
+		context->IASetVertexBuffers(0, 1, mesh->positionBuffer.GetAddressOf(), &mesh->positionStride, &mesh->offset);
+		context->IASetIndexBuffer(mesh->indexBuffer.Get(), mesh->indexFormat, 0);
+		context->VSSetConstantBuffers(0, 1, m_meshConstsGPU.GetAddressOf());
+		context->VSSetConstantBuffers(2, 1, mesh->quantizationConstBuffer.GetAddressOf());
+
+		const MeshLodRange& lod = mesh->lods[min(m_lod, mesh->lods.size() - 1)];
+		DrawIndexRange(context.Get(), *mesh, lod.indexOffset, lod.indexCount);
+
+		fetchBytes += size_t(mesh->vertexCount) * mesh->positionStride;
+		if (fullFetchBytes)
 		{
-			D3D11Utils::CreateMetallicRoughnessTexture(device, context,
-													   meshData.metallicTextureFileName,
-													   meshData.roughnessTextureFileName,
-													   newMesh->metallicRoughnessTexture,
-													   newMesh->metallicRoughnessSRV);
+			*fullFetchBytes += size_t(mesh->vertexCount) * sizeof(Vertex);
 		}
-		if (!meshData.metallicTextureFileName.empty())
+	}
+
+	return fetchBytes;
+}
+
+void Model::UpdateVisibleMeshlets(const DirectX::SimpleMath::Matrix& viewRow,
+								  const DirectX::SimpleMath::Matrix& projRow,
+								  const DirectX::SimpleMath::Vector3& eyeWorld)
+{
+	m_visibleTriangleCount = 0;
+	m_totalTriangleCount = 0;
+
+	const MeshletCullView view = MeshletCullView::Create(m_worldRow, viewRow, projRow, eyeWorld);
+
+	m_visibleRanges.resize(m_meshes.size());
+	for (size_t i = 0; i < m_meshes.size(); i++)
+	{
+		const Mesh& mesh = *m_meshes[i];
+		vector<MeshletDrawRange>& visibleRanges = m_visibleRanges[i];
+
+		const size_t lodIndex = min(m_lod, mesh.lods.size() - 1);
+		const MeshLodRange& lod = mesh.lods[lodIndex];
+		m_totalTriangleCount += lod.indexCount / 3;
+
+		if (lodIndex == 0)
 		{
-			m_materialConstsCPU.useMetallicMap = true;
+			m_visibleTriangleCount += MeshletBuilder::Cull(mesh.meshlets, view, visibleRanges);
 		}
-		if (!meshData.roughnessTextureFileName.empty())
+		else
 		{
-			m_materialConstsCPU.useRoughnessMap = true;
+			// 단순화된 LOD는 Meshlet이 없으므로 통째로 그림
+			visibleRanges.resize(1);
+			visibleRanges[0].indexOffset = lod.indexOffset;
+			visibleRanges[0].indexCount = lod.indexCount;
+			m_visibleTriangleCount += lod.indexCount / 3;
 		}
+	}
+}
+
+void Model::UpdateLod(const DirectX::SimpleMath::Vector3& eyeWorld, const float fovAngleY,
+					  const float viewportHeight)
+{
+	if (m_lodErrors.size() <= 1)
+	{
+		return;
+	}
 
-		newMesh->vertexConstBuffer = m_meshConstsGPU;
-		newMesh->pixelConstBuffer = m_materialConstsGPU;
+	// 오차는 Model Space 기준이므로 World 변환의 최대 Scale을 곱함
+	const float scale = max(max(Vector3(m_worldRow._11, m_worldRow._12, m_worldRow._13).Length(),
+								Vector3(m_worldRow._21, m_worldRow._22, m_worldRow._23).Length()),
+							Vector3(m_worldRow._31, m_worldRow._32, m_worldRow._33).Length());
+	const float distance = (eyeWorld - m_worldRow.Translation()).Length();
 
-		this->m_meshes.push_back(newMesh);
+	const float pixelsPerUnit = LodSelector::GetPixelsPerUnit(distance, fovAngleY, viewportHeight) * scale;
+	m_lod = LodSelector::Select(m_lodErrors, pixelsPerUnit, m_lod);
+}
+
+void Model::UpdateLodErrors()
+{
+	// Model의 LOD i 오차 = 각 Mesh의 LOD i(없으면 가장 거친 LOD) 오차 중 최대값
+	size_t lodCount = 1;
+	for (const shared_ptr<const Mesh>& mesh : m_meshes)
+	{
+		lodCount = max(lodCount, mesh->lods.size());
+	}
+
+	m_lodErrors.assign(lodCount, 0.0f);
+	for (const shared_ptr<const Mesh>& mesh : m_meshes)
+	{
+		for (size_t l = 0; l < lodCount; l++)
+		{
+			m_lodErrors[l] = max(m_lodErrors[l], mesh->lods[min(l, mesh->lods.size() - 1)].error);
+		}
 	}
+
+	m_lod = 0;
 }
 
-void Model::UpdateConstantBuffers(Microsoft::WRL::ComPtr<ID3D11Device>& device,
-								  Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context)
+void Model::ReportBufferMemory() const
 {
-	if (m_isVisible)
+	if (!g_printStats)
 	{
-		D3D11Utils::UpdateBuffer(device, context, m_meshConstsCPU, m_meshConstsGPU);
-		D3D11Utils::UpdateBuffer(device, context, m_materialConstsCPU, m_materialConstsGPU);
+		return;
 	}
+
+	size_t vertexCount = 0;
+	size_t vertexBytes = 0;
+	size_t indexCount = 0;
+	size_t indexBytes = 0;
+	size_t drawRanges = 0;
+	Vector3 maxError(0.0f);
+	for (const shared_ptr<const Mesh>& mesh : m_meshes)
+	{
+		vertexCount += mesh->vertexCount;
+		vertexBytes += size_t(mesh->vertexCount) * mesh->stride;
+		size_t meshIndexCount = 0;
+		for (const IndexChunk& chunk : mesh->indexChunks)
+		{
+			meshIndexCount += chunk.indexCount;
+		}
+		indexCount += meshIndexCount;
+		indexBytes += meshIndexCount * (mesh->indexFormat == DXGI_FORMAT_R16_UINT ? 2 : 4);
+		drawRanges += mesh->indexChunks.size();
+		if (m_useQuantizedVertices)
+		{
+			maxError = Vector3::Max(maxError, VertexQuantizer::GetPositionErrorBound(mesh->quantizationConstsCPU));
+		}
+	}
+
+	// 작은 기본 도형은 출력하지 않음
+	if (vertexCount < 1000)
+	{
+		return;
+	}
+
+	// 줄어든 메모리만큼 그릴 때마다 읽는 양도 줄어듦
+	const size_t fullVertexBytes = vertexCount * sizeof(Vertex);
+	const size_t fullIndexBytes = indexCount * sizeof(uint32_t);
+	cout << "Vertex buffers: " << vertexCount << " vertices, " << fullVertexBytes / 1024 << " KB -> "
+		 << vertexBytes / 1024 << " KB (-" << 100 - vertexBytes * 100 / fullVertexBytes
+		 << "%), max position error " << max(max(maxError.x, maxError.y), maxError.z) << endl;
+	cout << "Index buffers: " << indexCount << " indices, " << fullIndexBytes / 1024 << " KB -> "
+		 << indexBytes / 1024 << " KB (-" << 100 - indexBytes * 100 / max(fullIndexBytes, size_t(1))
+		 << "%), " << drawRanges << " draw ranges for " << m_meshes.size() << " meshes" << endl;
 }
 
-void Model::Render(Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context)
+void Model::RenderVisibleMeshlets(Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
+								  const CullVisibility& visibility)
 {
-	if (m_isVisible)
+	if (IsVisible(visibility))
 	{
-		for (const shared_ptr<Mesh>& mesh : m_meshes)
+		for (size_t i = 0; i < min(m_meshes.size(), m_visibleRanges.size()); i++)
+		{
+			if (m_visibleRanges[i].empty() || !IsMeshVisible(visibility, i))
+			{
+				continue;
+			}
+
+			const Mesh& mesh = *m_meshes[i];
+			SetMeshResources(context, mesh);
+
+			for (const MeshletDrawRange& range : m_visibleRanges[i])
+			{
+				DrawIndexRange(context.Get(), mesh, range.indexOffset, range.indexCount);
+			}
+		}
+	}
+}
+
+void Model::SetMeshResources(Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context, const Mesh& mesh)
+{
+	context->IASetVertexBuffers(0, 1, mesh.vertexBuffer.GetAddressOf(), &mesh.stride, &mesh.offset);
+	context->IASetIndexBuffer(mesh.indexBuffer.Get(), mesh.indexFormat, 0);
+
+	context->VSSetShaderResources(0, 1, mesh.heightSRV.GetAddressOf());
+	context->VSSetConstantBuffers(0, 1, m_meshConstsGPU.GetAddressOf());
+	context->VSSetConstantBuffers(2, 1, mesh.quantizationConstBuffer.GetAddressOf());
+
+	ID3D11ShaderResourceView* resViews[] = { mesh.albedoSRV.Get(), mesh.normalSRV.Get(), mesh.ormSRV.Get(),
+											  mesh.emissiveSRV.Get() };
+	context->PSSetShaderResources(0, UINT(size(resViews)), resViews);
+	context->PSSetConstantBuffers(0, 1, m_materialConstsGPU.GetAddressOf());
+}
+
+void Model::DrawIndexRange(ID3D11DeviceContext* context, const Mesh& mesh,
+						   const uint32_t indexOffset, const uint32_t indexCount)
+{
+	IndexNarrower::ForEachChunkRange(mesh.indexChunks, indexOffset, indexCount,
+									 [&](uint32_t count, uint32_t offset, uint32_t baseVertex) {
+										 context->DrawIndexed(count, offset, INT(baseVertex));
+									 });
+}
+
+void Model::AddDrawPackets(RenderQueue& queue, std::vector<DrawItem>& items, const uint32_t pass,
+						   const DrawKind kind, const CullVisibility& visibility,
+						   const DirectX::SimpleMath::Matrix& viewRow)
+{
+	if (!IsVisible(visibility))
+	{
+		return;
+	}
+
+	const Matrix worldViewRow = m_worldRow * viewRow;
+	for (size_t i = 0; i < m_meshes.size(); i++)
+	{
+		if (!IsMeshVisible(visibility, i))
+		{
+			continue;
+		}
+		if (kind == DrawKind::VisibleMeshlets && (i >= m_visibleRanges.size() || m_visibleRanges[i].empty()))
+		{
+			continue;
+		}
+
+		const Mesh& mesh = *m_meshes[i];
+
+		// Depth Only는 Texture를 읽지 않으므로 Position Stream으로만 묶음
+		uint32_t material = 0;
+		uint32_t geometry = 0;
+		if (kind == DrawKind::DepthOnly)
+		{
+			geometry = RenderQueue::MakeId({ mesh.positionBuffer.Get() });
+		}
+		else
 		{
-			context->IASetVertexBuffers(0, 1, mesh->vertexBuffer.GetAddressOf(), &mesh->stride, &mesh->offset);
-			context->IASetIndexBuffer(mesh->indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
+			material = RenderQueue::MakeId({ mesh.albedoSRV.Get(), mesh.normalSRV.Get(), mesh.ormSRV.Get(),
+											 mesh.emissiveSRV.Get(), mesh.heightSRV.Get() });
+			geometry = RenderQueue::MakeId({ mesh.vertexBuffer.Get() });
+		}
+
+		// 불투명이므로 가까운 것부터 (Early Z)
+		const float depth = Vector3::Transform(Vector3(mesh.bounds.sphere.Center), worldViewRow).z;
+
+		queue.Add(RenderQueue::MakeKey(pass, material, geometry, depth), uint32_t(items.size()));
+		items.push_back({ this, uint32_t(i), kind });
+	}
+}
+
+void Model::RenderQueued(StateCache<ID3D11DeviceContext>& stateCache, const uint32_t meshIndex,
+						 const DrawKind kind)
+{
+	const Mesh& mesh = *m_meshes[meshIndex];
+
+	if (kind == DrawKind::DepthOnly)
+	{
+		stateCache.IASetVertexBuffers(0, 1, mesh.positionBuffer.GetAddressOf(), &mesh.positionStride,
+									  &mesh.offset);
+	}
+	else
+	{
+		stateCache.IASetVertexBuffers(0, 1, mesh.vertexBuffer.GetAddressOf(), &mesh.stride, &mesh.offset);
+	}
+	stateCache.IASetIndexBuffer(mesh.indexBuffer.Get(), mesh.indexFormat, 0);
+	stateCache.VSSetConstantBuffers(0, 1, m_meshConstsGPU.GetAddressOf());
+	stateCache.VSSetConstantBuffers(2, 1, mesh.quantizationConstBuffer.GetAddressOf());
 
-			context->VSSetShaderResources(0, 1, mesh->heightSRV.GetAddressOf());
-			context->VSSetConstantBuffers(0, 1, mesh->vertexConstBuffer.GetAddressOf());
+	if (kind != DrawKind::DepthOnly)
+	{
+		stateCache.VSSetShaderResources(0, 1, mesh.heightSRV.GetAddressOf());
 
-			vector<ID3D11ShaderResourceView*> resViews = { mesh->albedoSRV.Get(), mesh->normalSRV.Get(),
-														   mesh->aoSRV.Get(), mesh->metallicRoughnessSRV.Get(),
-														   mesh->emissiveSRV.Get() };
-			context->PSSetShaderResources(0, UINT(resViews.size()), resViews.data());
-			context->PSSetConstantBuffers(0, 1, mesh->pixelConstBuffer.GetAddressOf());
+		ID3D11ShaderResourceView* pixelSRVs[4] = { mesh.albedoSRV.Get(), mesh.normalSRV.Get(),
+												   mesh.ormSRV.Get(), mesh.emissiveSRV.Get() };
+		stateCache.PSSetShaderResources(0, 4, pixelSRVs);
+		stateCache.PSSetConstantBuffers(0, 1, m_materialConstsGPU.GetAddressOf());
+	}
 
-			context->DrawIndexed(mesh->indexCount, 0, 0);
-;		}
+	ID3D11DeviceContext* context = stateCache.GetContext();
+	if (kind == DrawKind::VisibleMeshlets)
+	{
+		for (const MeshletDrawRange& range : m_visibleRanges[meshIndex])
+		{
+			DrawIndexRange(context, mesh, range.indexOffset, range.indexCount);
+		}
+	}
+	else
+	{
+		const MeshLodRange& lod = mesh.lods[min(m_lod, mesh.lods.size() - 1)];
+		DrawIndexRange(context, mesh, lod.indexOffset, lod.indexCount);
 	}
 }
 
 void Model::RenderNormals(Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context)
 {
-	for (const shared_ptr<Mesh>& mesh : m_meshes)
+	for (const shared_ptr<const Mesh>& mesh : m_meshes)
 	{
 		context->IASetVertexBuffers(0, 1, mesh->vertexBuffer.GetAddressOf(), &mesh->stride, &mesh->offset);
 
+		context->VSSetConstantBuffers(2, 1, mesh->quantizationConstBuffer.GetAddressOf());
 		context->GSSetConstantBuffers(0, 1, m_meshConstsGPU.GetAddressOf());
 
 		context->Draw(mesh->vertexCount, 0);
 	}
 }
 
+void Model::UpdateBounds()
+{
+	vector<MeshBounds> meshBounds(m_meshes.size());
+	for (size_t i = 0; i < m_meshes.size(); i++)
+	{
+		meshBounds[i] = m_meshes[i]->bounds;
+	}
+
+	m_bounds = BoundsCalculator::Merge(meshBounds);
+	m_geometryVersion++;
+}
+
+DirectX::BoundingSphere Model::GetWorldBoundingSphere() const
+{
+	DirectX::BoundingSphere sphere;
+	m_bounds.sphere.Transform(sphere, m_worldRow);
+	return sphere;
+}
+
+void Model::AddCullBoxes(FrustumCuller& culler)
+{
+	m_cullIndex = culler.AddBox(m_bounds, m_worldRow);
+
+	// Mesh가 하나면 Model 전체 Box와 같으므로 넣지 않음
+	if (m_meshes.size() > 1)
+	{
+		for (const shared_ptr<const Mesh>& mesh : m_meshes)
+		{
+			culler.AddBox(mesh->bounds, m_worldRow);
+		}
+	}
+}
+
+bool Model::IntersectRay(const Vector3& origin, const Vector3& dir, RayHit& hit) const
+{
+	bool found = false;
+	for (size_t i = 0; i < m_meshes.size(); i++)
+	{
+		if (m_meshes[i]->bvh.IntersectClosest(origin, dir, hit))
+		{
+			hit.mesh = uint32_t(i);
+			found = true;
+		}
+	}
+	return found;
+}
+
+bool Model::IntersectRayAny(const Vector3& origin, const Vector3& dir, const float maxDistance) const
+{
+	for (const shared_ptr<const Mesh>& mesh : m_meshes)
+	{
+		if (mesh->bvh.IntersectAny(origin, dir, maxDistance))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool Model::IsVisible(const CullVisibility& visibility) const
+{
+	return m_isVisible && (m_cullIndex == UINT32_MAX || visibility.IsVisible(m_cullIndex));
+}
+
+bool Model::IsMeshVisible(const CullVisibility& visibility, const size_t meshIndex) const
+{
+	return m_cullIndex == UINT32_MAX || m_meshes.size() == 1 ||
+		   visibility.IsVisible(m_cullIndex + 1 + uint32_t(meshIndex));
+}
+
 void Model::UpdateWorldRow(const DirectX::SimpleMath::Matrix& worldRow)
 {
 	m_worldRow = worldRow;
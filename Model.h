@@ -1,37 +1,116 @@
 #pragma once
 
+#include "AsyncModelLoader.h"
 #include "ConstantBuffers.h"
 #include "D3D11Utils.h"
+#include "FrustumCuller.h"
 #include "Mesh.h"
+#include "MeshCache.h"
 #include "MeshData.h"
+#include "RenderQueue.h"
+#include "StateCache.h"
+
+class Model;
+
+// RenderQueue로 그릴 때 Mesh 하나를 그리는 방식
+enum class DrawKind : uint8_t {
+	Full,			 // Model::Render()와 같음
+	VisibleMeshlets, // Model::RenderVisibleMeshlets()와 같음
+	DepthOnly,		 // Model::RenderDepthOnly()와 같음
+};
+
+// RenderQueue::Packet::item이 가리키는 Draw
+struct DrawItem {
+	Model *model;
+	uint32_t mesh;
+	DrawKind kind;
+};
 
 class Model {
 public:
 	Model() {}
 	Model(Microsoft::WRL::ComPtr<ID3D11Device> &device,
 		  Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
-		  const std::string &basePath, const std::string &fileName);
+		  const std::string &basePath, const std::string &fileName,
+		  bool reverseNormal = false);
 	Model(Microsoft::WRL::ComPtr<ID3D11Device> &device,
 		  Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
 		  const std::vector<MeshData> &meshes);
 
 	void Initialize(Microsoft::WRL::ComPtr<ID3D11Device> &device,
 					Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
-					const std::string &basePath, const std::string &fileName);
+					const std::string &basePath, const std::string &fileName,
+					bool reverseNormal = false);
 
 	void Initialize(Microsoft::WRL::ComPtr<ID3D11Device> &device,
 					Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
 					const std::vector<MeshData> &meshes);
 
+	// AsyncModelLoader에서 읽은 payload로 기존 Mesh들을 교체 (Render Thread에서)
+	void Initialize(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+					Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
+					const ModelPayload &payload);
+
+	// source의 Mesh(Vertex/Index Buffer, Texture)를 복사 없이 공유하고
+	// Constant Buffer(World 행렬, Material)만 새로 만듦
+	void InitializeShared(Microsoft::WRL::ComPtr<ID3D11Device> &device, const Model &source);
+
 	void UpdateConstantBuffers(Microsoft::WRL::ComPtr<ID3D11Device> &device,
 							   Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context);
 
-	void Render(Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context);
+	// visibility: FrustumCuller::GetVisibility()로 받은 이 Pass의 결과 (AddCullBoxes() 이후)
+	void Render(Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
+				const CullVisibility &visibility = CullVisibility());
+
+	// Camera 기준으로 화면 밖/뒷면 Meshlet을 제외하고 보이는 구간만 기록
+	void UpdateVisibleMeshlets(const DirectX::SimpleMath::Matrix &viewRow,
+							   const DirectX::SimpleMath::Matrix &projRow,
+							   const DirectX::SimpleMath::Vector3 &eyeWorld);
+
+	// Camera와의 거리와 FOV로 화면에서의 오차를 계산해서 LOD 선택 (fovAngleY는 Radian)
+	void UpdateLod(const DirectX::SimpleMath::Vector3 &eyeWorld, const float fovAngleY,
+				   const float viewportHeight);
+
+	// UpdateVisibleMeshlets()의 결과만 그림 (같은 Camera를 사용하는 Pass에서만)
+	void RenderVisibleMeshlets(Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
+							   const CullVisibility &visibility = CullVisibility());
+
+	// Position Stream만 읽어서 그림 (depthOnlyPSO, stencilMaskPSO)
+	// 반환값: 읽은 Vertex Buffer 크기 (Pass별 통계용)
+	// fullFetchBytes: 그린 Mesh들을 전체 Vertex로 읽었다면의 크기를 더함 (같은 Mesh들로 비교)
+	size_t RenderDepthOnly(Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
+						   const CullVisibility &visibility = CullVisibility(),
+						   size_t *fullFetchBytes = nullptr);
 
 	void RenderNormals(Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context);
 
+	// 그릴 Mesh마다 items에 DrawItem을 추가하고 queue에 Key와 같이 넣음
+	// viewRow: 이 Pass의 Camera (Depth 정렬용), kind가 VisibleMeshlets면 UpdateVisibleMeshlets() 이후
+	void AddDrawPackets(RenderQueue &queue, std::vector<DrawItem> &items, const uint32_t pass,
+						const DrawKind kind, const CullVisibility &visibility,
+						const DirectX::SimpleMath::Matrix &viewRow);
+
+	// RenderQueue 순서로 Mesh 하나를 그림 (직전 Mesh와 같은 자원은 stateCache에서 걸러짐)
+	void RenderQueued(StateCache<ID3D11DeviceContext> &stateCache, const uint32_t meshIndex,
+					  const DrawKind kind);
+
 	void UpdateWorldRow(const DirectX::SimpleMath::Matrix &worldRow);
 
+	// m_bounds.sphere를 m_worldRow로 옮긴 것 (Picking용)
+	DirectX::BoundingSphere GetWorldBoundingSphere() const;
+
+	// Model 전체와 (Mesh가 여러 개면) Mesh마다의 World AABB를 culler에 넣음
+	void AddCullBoxes(FrustumCuller &culler);
+
+	// Model Space Ray와 모든 Mesh의 삼각형 검사 (Mesh::bvh), hit.distance보다 가까운 교차만 기록
+	// World Space Ray는 m_worldRow의 역행렬로 옮겨서 (방향은 정규화하지 않아야 거리 단위가 같음)
+	bool IntersectRay(const DirectX::SimpleMath::Vector3 &origin, const DirectX::SimpleMath::Vector3 &dir,
+					  RayHit &hit) const;
+
+	// maxDistance 안에 교차가 하나라도 있는지
+	bool IntersectRayAny(const DirectX::SimpleMath::Vector3 &origin, const DirectX::SimpleMath::Vector3 &dir,
+						 const float maxDistance) const;
+
 public:
 	DirectX::SimpleMath::Matrix m_worldRow = DirectX::SimpleMath::Matrix(); // Model Space -> World Space
 	DirectX::SimpleMath::Matrix m_worldITRow = DirectX::SimpleMath::Matrix();
@@ -43,7 +122,61 @@ public:
 	bool m_isVisible = true;
 	bool m_castShadow = true;
 
-	std::vector<std::shared_ptr<Mesh>> m_meshes;
+	// Initialize() 전에 설정, basicIL 계열 PSO는 QuantizedVertex만 그릴 수 있음
+	// (samplingIL로 그리는 화면 사각형 등은 false)
+	bool m_useQuantizedVertices = true;
+
+	// Mesh는 만든 뒤에 바꾸지 않음 (ModelInstance끼리 공유)
+	std::vector<std::shared_ptr<const Mesh>> m_meshes;
+
+	// 마지막 UpdateVisibleMeshlets() 결과 (m_meshes[i]마다 그릴 구간)
+	std::vector<std::vector<MeshletDrawRange>> m_visibleRanges;
+	size_t m_visibleTriangleCount = 0;
+	size_t m_totalTriangleCount = 0;
+
+	size_t m_lod = 0;
+	std::vector<float> m_lodErrors; // LOD 0부터, Model Space 오차
+
+	// 모든 Mesh를 합친 Model Space 경계 (Mesh별 경계는 Mesh::bounds)
+	MeshBounds m_bounds;
+
+	// m_meshes와 m_bounds를 바꿀 때마다 증가 (SceneBVH가 World 행렬이 그대로여도 경계를 다시 읽도록)
+	uint32_t m_geometryVersion = 0;
+
+	// 마지막 AddCullBoxes()의 Model 전체 Box Index (Mesh i는 m_cullIndex + 1 + i)
+	uint32_t m_cullIndex = UINT32_MAX;
+
+private:
+	// images[i]는 meshes[i]의 Texture
+	void InitializeMeshes(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+						  Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
+						  const std::vector<MeshData> &meshes,
+						  const std::vector<MeshImages> &images);
+
+	// meshData는 Texture 사용 여부만 확인 (Vertex/Index는 캐시 메모리일 수 있음)
+	// indices에는 모든 LOD가 이어져 있고 lods가 각 범위
+	void InitializeMesh(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+						Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
+						const Vertex *vertices, const size_t vertexCount,
+						const uint32_t *indices, const size_t indexCount,
+						const std::vector<MeshLodRange> &lods, const MeshBounds &bounds,
+						const MeshData &meshData, const MeshImages &images);
+
+	void UpdateLodErrors();
+
+	void UpdateBounds();
+
+	// Vertex/Index Buffer 메모리 (= 그릴 때마다 읽는 데이터) 절약량 출력
+	void ReportBufferMemory() const;
+
+	bool IsVisible(const CullVisibility &visibility) const;
+	bool IsMeshVisible(const CullVisibility &visibility, const size_t meshIndex) const;
+
+	void SetMeshResources(Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context, const Mesh &mesh);
+
+	// Index Buffer의 [indexOffset, indexOffset + indexCount) 구간을 IndexChunk 경계에서 나눠 그림
+	void DrawIndexRange(ID3D11DeviceContext *context, const Mesh &mesh,
+						const uint32_t indexOffset, const uint32_t indexCount);
 
 private:
 	Microsoft::WRL::ComPtr<ID3D11Buffer> m_meshConstsGPU;
@@ -0,0 +1,34 @@
+#include "ModelInstance.h"
+
+using namespace std;
+using namespace DirectX::SimpleMath;
+
+ModelInstance::ModelInstance(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+							 std::shared_ptr<const Model> model)
+	: m_model(model)
+{
+	this->InitializeShared(device, *m_model);
+}
+
+void ModelInstance::SetModel(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+							 Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
+							 std::shared_ptr<const Model> model)
+{
+	const Matrix worldRow = m_worldRow;
+	const MeshConstants meshConsts = m_meshConstsCPU;
+	const MaterialConstants materialConsts = m_materialConstsCPU;
+
+	m_model = model;
+	this->InitializeShared(device, *m_model);
+
+	m_meshConstsCPU.heightScale = meshConsts.heightScale;
+	m_materialConstsCPU.albedoFactor = materialConsts.albedoFactor;
+	m_materialConstsCPU.roughnessFactor = materialConsts.roughnessFactor;
+	m_materialConstsCPU.metallicFactor = materialConsts.metallicFactor;
+	m_materialConstsCPU.emissionFactor = materialConsts.emissionFactor;
+	m_materialConstsCPU.invertNoramlMapY = materialConsts.invertNoramlMapY;
+
+	// UpdateWorldRow()는 CPU 쪽 값만 바꾸므로 GPU도 갱신
+	UpdateWorldRow(worldRow);
+	UpdateConstantBuffers(device, context);
+}
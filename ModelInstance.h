@@ -4,7 +4,20 @@
 
 #include "Model.h"
 
-class ModelInstance {
-  public:
-    std::shared_ptr<const Model> m_model;
+// ModelRegistry의 Model과 Mesh(Vertex/Index Buffer, Texture)를 공유하고
+// World 행렬, Material, LOD 등 Instance별 상태만 따로 가짐
+// (Model을 상속하므로 Model과 같은 리스트에 넣어서 그릴 수 있음)
+class ModelInstance : public Model {
+public:
+	ModelInstance(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+				  std::shared_ptr<const Model> model);
+
+	// 공유하는 Geometry만 교체 (비동기로 읽은 Model이 Placeholder를 대신할 때)
+	// World 행렬과 Material Factor는 유지하고 Texture 사용 여부는 새 Model을 따름
+	void SetModel(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+				  Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
+				  std::shared_ptr<const Model> model);
+
+public:
+	std::shared_ptr<const Model> m_model; // 공유하는 원본 Geometry
 };
@@ -1,6 +1,9 @@
 #include "ModelLoader.h"
+#include "Stats.h"
+#include "TangentGenerator.h"
+#include "ThreadPool.h"
 
-#include <DirectXMesh.h>
+#include <algorithm>
 #include <filesystem>
 #include <vector>
 
@@ -37,13 +40,47 @@ void ModelLoader::Load(std::string basePath, std::string fileName, bool reverseN
 	else
 	{
 		Matrix tr; // Initalize Transformation
-		ProcessNode(pScene->mRootNode, pScene, tr);
+		vector<MeshJob> jobs;
+		CollectMeshJobs(pScene->mRootNode, pScene, tr, jobs);
+
+		// 각 Mesh는 서로 독립적이므로 병렬로 처리하고 결과는 index 위치에 저장
+		// => 스레드 수와 관계없이 m_meshes 순서가 항상 같음
+		m_meshes.resize(jobs.size());
+		ThreadPool::GetInstance().ParallelFor(0, jobs.size(), [&](size_t i) {
+			MeshData newMesh = this->ProcessMesh(jobs[i].mesh, pScene);
+
+			for (Vertex& v : newMesh.vertices)
+			{
+				v.position = Vector3::Transform(v.position, jobs[i].transform);
+			}
+
+			m_meshes[i] = std::move(newMesh);
+		});
 	}
 
 	UpdateTangents();
+
+	if (!g_printStats)
+	{
+		return;
+	}
+
+	size_t vertexCount = 0;
+	size_t indexCount = 0;
+	for (const MeshData& mesh : m_meshes)
+	{
+		vertexCount += mesh.vertices.size();
+		indexCount += mesh.indices.size();
+	}
+
+	cout << "Imported " << m_basePath + fileName << ": " << m_meshes.size() << " meshes, "
+		 << vertexCount << " vertices, " << indexCount << " indices, "
+		 << m_scratchResource.GetAllocationCount() << " scratch allocations (peak "
+		 << m_scratchResource.GetPeakBytes() / 1024 << " KB)" << endl;
 }
 
-void ModelLoader::ProcessNode(aiNode* node, const aiScene* scene, DirectX::SimpleMath::Matrix tr)
+void ModelLoader::CollectMeshJobs(aiNode* node, const aiScene* scene, DirectX::SimpleMath::Matrix tr,
+								  std::vector<MeshJob>& jobs)
 {
 	Matrix m;
 	ai_real* temp = &node->mTransformation.a1;
@@ -56,31 +93,29 @@ void ModelLoader::ProcessNode(aiNode* node, const aiScene* scene, DirectX::Simpl
 
 	for (UINT i = 0; i < node->mNumMeshes; i++)
 	{
-		aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-		MeshData newMesh = this->ProcessMesh(mesh, scene);
-
-		for (Vertex& v : newMesh.vertices)
-		{
-			v.position = Vector3::Transform(v.position, m);
-		}
-
-		m_meshes.push_back(newMesh);
+		MeshJob job;
+		job.mesh = scene->mMeshes[node->mMeshes[i]];
+		job.transform = m;
+		jobs.push_back(job);
 	}
 
 	for (UINT i = 0; i < node->mNumChildren; i++)
 	{
-		this->ProcessNode(node->mChildren[i], scene, m);
+		this->CollectMeshJobs(node->mChildren[i], scene, m, jobs);
 	}
 }
 
 MeshData ModelLoader::ProcessMesh(aiMesh* mesh, const aiScene* scene)
 {
-	vector<Vertex> vertices;
-	vector<uint32_t> indices;
+	MeshData newMesh;
+
+	// 최종 크기를 알고 있으므로 한 번에 할당하고 복사 없이 바로 채움
+	vector<Vertex>& vertices = newMesh.vertices;
+	vertices.resize(mesh->mNumVertices);
 
 	for (UINT i = 0; i < mesh->mNumVertices; i++)
 	{
-		Vertex vertex;
+		Vertex& vertex = vertices[i];
 
 		vertex.position.x = mesh->mVertices[i].x;
 		vertex.position.y = mesh->mVertices[i].y;
@@ -110,22 +145,22 @@ MeshData ModelLoader::ProcessMesh(aiMesh* mesh, const aiScene* scene)
 			vertex.texcoord.x = float(mesh->mTextureCoords[0][i].x);
 			vertex.texcoord.y = float(mesh->mTextureCoords[0][i].y);
 		}
-
-		vertices.push_back(vertex);
 	}
 
+	size_t indexCount = 0;
 	for (UINT i = 0; i < mesh->mNumFaces; i++)
 	{
-		aiFace face = mesh->mFaces[i];
-		for (UINT j = 0; j < face.mNumIndices; j++)
-		{
-			indices.push_back(face.mIndices[j]);
-		}
+		indexCount += mesh->mFaces[i].mNumIndices;
 	}
 
-	MeshData newMesh;
-	newMesh.vertices = vertices;
-	newMesh.indices = indices;
+	vector<uint32_t>& indices = newMesh.indices;
+	indices.reserve(indexCount);
+
+	for (UINT i = 0; i < mesh->mNumFaces; i++)
+	{
+		const aiFace& face = mesh->mFaces[i];
+		indices.insert(indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+	}
 
 	if (mesh->mMaterialIndex >= 0)
 	{
@@ -169,29 +204,6 @@ std::string ModelLoader::ReadFileName(aiMaterial* material, aiTextureType type)
 
 void ModelLoader::UpdateTangents()
 {
-	for (MeshData& m : m_meshes)
-	{
-		vector<XMFLOAT3> positions(m.vertices.size());
-		vector<XMFLOAT3> normals(m.vertices.size());
-		vector<XMFLOAT2> texcoords(m.vertices.size());
-		vector<XMFLOAT3> tangents(m.vertices.size());
-		vector<XMFLOAT3> bitangents(m.vertices.size());
-
-		for (size_t i = 0; i < m.vertices.size(); i++)
-		{
-			Vertex& v = m.vertices[i];
-			positions[i] = v.position;
-			normals[i] = v.normalModel;
-			texcoords[i] = v.texcoord;
-		}
-
-		ComputeTangentFrame(m.indices.data(), m.indices.size() / 3,
-							positions.data(), normals.data(), texcoords.data(),
-							m.vertices.size(), tangents.data(), bitangents.data());
-
-		for (size_t i = 0; i < m.vertices.size(); i++)
-		{
-			m.vertices[i].tangentModel = tangents[i];
-		}
-	}
+	// 임시 버퍼는 Model마다 m_scratchResource에서 한 번만 할당 (할당 횟수/최대 사용량은 Load()에서 출력)
+	TangentGenerator::Compute(m_meshes, &m_scratchResource);
 }
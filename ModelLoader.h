@@ -8,14 +8,23 @@
 #include <string>
 #include <vector>
 
+#include "CountingResource.h"
 #include "MeshData.h"
 #include "Vertex.h"
 
+// Node Tree를 펼쳐서 만든 작업 단위 (Mesh + 누적된 Node Transform)
+struct MeshJob {
+	aiMesh *mesh = nullptr;
+	DirectX::SimpleMath::Matrix transform;
+};
+
 class ModelLoader {
 public:
 	void Load(std::string basePath, std::string fileName, bool reverseNormals);
 
-	void ProcessNode(aiNode *node, const aiScene *scene, DirectX::SimpleMath::Matrix tr);
+	// 기존 재귀 순서(Node의 Mesh들 -> 자식 Node들)대로 작업 목록을 만듦
+	void CollectMeshJobs(aiNode *node, const aiScene *scene, DirectX::SimpleMath::Matrix tr,
+						 std::vector<MeshJob> &jobs);
 
 	MeshData ProcessMesh(aiMesh *mesh, const aiScene *scene);
 
@@ -28,4 +37,7 @@ public:
 	std::vector<MeshData> m_meshes;
 	bool m_isGLTF = false; // gltf or fbx
 	bool m_reverseNormals = false;
+
+	// Import 중 임시 버퍼 할당 통계 (Model마다 새로 시작)
+	CountingResource m_scratchResource;
 };
\ No newline at end of file
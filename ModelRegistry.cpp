@@ -0,0 +1,173 @@
+#include "ModelRegistry.h"
+#include "GeometryGenerator.h"
+
+#include <chrono>
+#include <filesystem>
+#include <initializer_list>
+#include <sstream>
+#include <system_error>
+
+using namespace std;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	// float는 오차 없이 구분되도록 16진수로 기록
+	string MakeKey(const char* name, std::initializer_list<float> params)
+	{
+		ostringstream key;
+		key << name << hexfloat;
+		for (const float p : params)
+		{
+			key << ' ' << p;
+		}
+		return key.str();
+	}
+}
+
+std::shared_ptr<const Model> ModelRegistry::Find(const std::string& key)
+{
+	auto it = m_models.find(key);
+	if (it != m_models.end())
+	{
+		if (shared_ptr<const Model> model = it->second.lock())
+		{
+			m_hitCount++;
+			return model;
+		}
+	}
+
+	m_missCount++;
+
+	return nullptr;
+}
+
+std::string ModelRegistry::MakeFileKey(const std::string& basePath, const std::string& fileName,
+									   bool reverseNormal, bool useQuantizedVertices)
+{
+	// 같은 파일을 다른 경로 표기로 읽어도 같은 key가 되도록
+	error_code ec;
+	filesystem::path path = filesystem::weakly_canonical(basePath + fileName, ec);
+	if (ec)
+	{
+		path = basePath + fileName;
+	}
+
+	return "file " + path.generic_string() + (reverseNormal ? " reverseNormal" : "") +
+		   (useQuantizedVertices ? " quantized" : "");
+}
+
+std::shared_ptr<const Model> ModelRegistry::Load(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+												 Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
+												 const std::string& basePath, const std::string& fileName,
+												 bool reverseNormal, bool useQuantizedVertices)
+{
+	const string key = MakeFileKey(basePath, fileName, reverseNormal, useQuantizedVertices);
+
+	if (shared_ptr<const Model> model = Find(key))
+	{
+		return model;
+	}
+
+	shared_ptr<Model> model = make_shared<Model>();
+	model->m_useQuantizedVertices = useQuantizedVertices;
+	model->Initialize(device, context, basePath, fileName, reverseNormal);
+
+	m_models[key] = model;
+
+	return model;
+}
+
+std::shared_future<void> ModelRegistry::LoadAsync(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+												  Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
+												  AsyncModelLoader& loader, const std::string& basePath,
+												  const std::string& fileName, bool reverseNormal,
+												  bool useQuantizedVertices, LoadedFunc onLoaded)
+{
+	const string key = MakeFileKey(basePath, fileName, reverseNormal, useQuantizedVertices);
+
+	// 읽는 중이면 끝날 때 같이 (이미 준비된 future가 남아 있으면 실패한 것이므로 다시 읽음)
+	auto pending = m_pendingLoads.find(key);
+	if (pending != m_pendingLoads.end() &&
+		pending->second.result.wait_for(chrono::seconds(0)) != future_status::ready)
+	{
+		m_hitCount++;
+		pending->second.onLoaded.push_back(std::move(onLoaded));
+		return pending->second.result;
+	}
+
+	if (shared_ptr<const Model> model = Find(key))
+	{
+		onLoaded(model);
+
+		promise<void> loaded;
+		loaded.set_value();
+		return loaded.get_future().share();
+	}
+
+	// GPU 자원은 loader.ProcessCompleted()에서 만들고 기다리던 곳에 모두 전달
+	AsyncModelLoader::FinishFunc finish = [this, key, device, context,
+										   useQuantizedVertices](ModelPayload& payload) mutable {
+		shared_ptr<Model> model = make_shared<Model>();
+		model->m_useQuantizedVertices = useQuantizedVertices;
+		model->Initialize(device, context, payload);
+
+		m_models[key] = model;
+
+		const vector<LoadedFunc> waiting = std::move(m_pendingLoads[key].onLoaded);
+		m_pendingLoads.erase(key);
+		for (const LoadedFunc& func : waiting)
+		{
+			func(model);
+		}
+	};
+
+	PendingLoad load;
+	load.result = loader.LoadModelAsync(basePath, fileName, reverseNormal, std::move(finish)).share();
+	load.onLoaded.push_back(std::move(onLoaded));
+	m_pendingLoads[key] = load;
+
+	return load.result;
+}
+
+std::shared_ptr<const Model> ModelRegistry::MakeSphere(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+													   Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
+													   const float radius, const int numSlices, const int numStacks,
+													   const Vector2 texScale)
+{
+	const string key = MakeKey("sphere", { radius, float(numSlices), float(numStacks), texScale.x, texScale.y });
+
+	return GetOrCreate(device, context, key, [&]() {
+		return vector{ GeometryGenerator::MakeSphere(radius, numSlices, numStacks, texScale) };
+	});
+}
+
+std::shared_ptr<const Model> ModelRegistry::MakeBox(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+													Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
+													const float scale)
+{
+	return GetOrCreate(device, context, MakeKey("box", { scale }), [&]() {
+		return vector{ GeometryGenerator::MakeBox(scale) };
+	});
+}
+
+std::shared_ptr<const Model> ModelRegistry::GetOrCreate(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+														Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
+														const std::string& key,
+														const std::function<std::vector<MeshData>()>& makeMeshes,
+														bool useQuantizedVertices)
+{
+	const string fullKey = useQuantizedVertices ? key + " quantized" : key;
+
+	if (shared_ptr<const Model> model = Find(fullKey))
+	{
+		return model;
+	}
+
+	shared_ptr<Model> model = make_shared<Model>();
+	model->m_useQuantizedVertices = useQuantizedVertices;
+	model->Initialize(device, context, makeMeshes());
+
+	m_models[fullKey] = model;
+
+	return model;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <directxtk/SimpleMath.h>
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AsyncModelLoader.h"
+#include "MeshData.h"
+#include "Model.h"
+
+// 같은 파일(+ Import 설정)이나 같은 Parameter로 만드는 Geometry를 한 번만 만들어서 공유
+// 반환된 Model은 바꾸지 않고 ModelInstance로 감싸서 그림
+// Key별로 weak_ptr만 가지고 있으므로 사용하는 곳이 없어지면 GPU 자원도 해제됨
+// Render Thread에서만 사용
+class ModelRegistry {
+public:
+	using LoadedFunc = std::function<void(std::shared_ptr<const Model>)>;
+
+	std::shared_ptr<const Model> Load(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+									  Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
+									  const std::string &basePath, const std::string &fileName,
+									  bool reverseNormal = false, bool useQuantizedVertices = true);
+
+	// Load()와 같은 key, 파일과 Texture는 loader의 Worker Thread에서 읽고 GPU 자원은 loader.ProcessCompleted()에서
+	// 이미 있으면 바로, 같은 파일을 읽는 중이면 다시 읽지 않고 그 결과로 onLoaded 호출
+	// 읽기에 실패하면 onLoaded는 호출되지 않고 future로 예외 전달 (다음 호출은 다시 읽음)
+	std::shared_future<void> LoadAsync(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+									   Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
+									   AsyncModelLoader &loader, const std::string &basePath,
+									   const std::string &fileName, bool reverseNormal, bool useQuantizedVertices,
+									   LoadedFunc onLoaded);
+
+	std::shared_ptr<const Model> MakeSphere(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+											Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
+											const float radius, const int numSlices, const int numStacks,
+											const DirectX::SimpleMath::Vector2 texScale = DirectX::SimpleMath::Vector2(1.0f));
+
+	std::shared_ptr<const Model> MakeBox(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+										 Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
+										 const float scale = 1.0f);
+
+	// 그 외의 Geometry는 만드는 방법을 모두 포함하는 key로 구분
+	std::shared_ptr<const Model> GetOrCreate(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+											 Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
+											 const std::string &key,
+											 const std::function<std::vector<MeshData>()> &makeMeshes,
+											 bool useQuantizedVertices = true);
+
+	size_t GetHitCount() const { return m_hitCount; }
+	size_t GetMissCount() const { return m_missCount; }
+
+private:
+	// 살아있는 Model이 있으면 반환 (hit/miss 집계)
+	std::shared_ptr<const Model> Find(const std::string &key);
+
+	static std::string MakeFileKey(const std::string &basePath, const std::string &fileName,
+								   bool reverseNormal, bool useQuantizedVertices);
+
+private:
+	// LoadAsync()로 읽는 중인 파일
+	struct PendingLoad {
+		std::shared_future<void> result;
+		std::vector<LoadedFunc> onLoaded;
+	};
+
+	std::unordered_map<std::string, std::weak_ptr<const Model>> m_models;
+	std::unordered_map<std::string, PendingLoad> m_pendingLoads;
+
+	size_t m_hitCount = 0;
+	size_t m_missCount = 0;
+};
@@ -6,8 +6,9 @@ struct NormalGeometryShaderInput
     float3 normalWorld : NORMAL;
 };
 
-NormalGeometryShaderInput main(VertexShaderInput input)
+NormalGeometryShaderInput main(QuantizedVertexShaderInput quantizedInput)
 {
+    VertexShaderInput input = DecodeVertex(quantizedInput);
     NormalGeometryShaderInput output;
 
     output.posModel = float4(input.posModel, 1.0);
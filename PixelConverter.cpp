@@ -0,0 +1,739 @@
+#include "PixelConverter.h"
+
+#include <fp16.h>
+
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+
+// GCC/Clang은 함수 단위로 명령어 집합을 켜야 함 (MSVC는 그대로 사용 가능)
+#if defined(_MSC_VER) && !defined(__clang__)
+#define TARGET_SSE41
+#define TARGET_AVX2
+#else
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2,f16c")))
+#endif
+
+namespace {
+	struct CpuFeatures {
+		bool sse41 = false;
+		bool avx2 = false;
+		bool f16c = false;
+	};
+
+	CpuFeatures DetectCpu()
+	{
+		unsigned int regs1[4] = {}; // eax, ebx, ecx, edx
+		unsigned int regs7[4] = {};
+		unsigned long long xcr0 = 0;
+
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		const int maxLeaf = info[0];
+		__cpuid(info, 1);
+		memcpy(regs1, info, sizeof(regs1));
+		if (maxLeaf >= 7)
+		{
+			__cpuidex(info, 7, 0);
+			memcpy(regs7, info, sizeof(regs7));
+		}
+		if (regs1[2] & (1u << 27)) // OSXSAVE
+		{
+			xcr0 = _xgetbv(0);
+		}
+#else
+		const unsigned int maxLeaf = __get_cpuid_max(0, nullptr);
+		__cpuid(1, regs1[0], regs1[1], regs1[2], regs1[3]);
+		if (maxLeaf >= 7)
+		{
+			__cpuid_count(7, 0, regs7[0], regs7[1], regs7[2], regs7[3]);
+		}
+		if (regs1[2] & (1u << 27)) // OSXSAVE
+		{
+			unsigned int eax, edx;
+			__asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+			xcr0 = (static_cast<unsigned long long>(edx) << 32) | eax;
+		}
+#endif
+
+		// AVX 계열은 OS가 YMM 레지스터를 저장해줄 때만 사용 가능
+		const bool avxState = (xcr0 & 6) == 6;
+
+		CpuFeatures features;
+		features.sse41 = (regs1[2] & (1u << 19)) != 0;
+		features.f16c = avxState && (regs1[2] & (1u << 28)) && (regs1[2] & (1u << 29));
+		features.avx2 = avxState && features.f16c && (regs7[1] & (1u << 5));
+		return features;
+	}
+
+	const CpuFeatures &GetCpu()
+	{
+		static const CpuFeatures features = DetectCpu();
+		return features;
+	}
+
+	PixelConverter::SimdLevel GetMaxLevel()
+	{
+		const CpuFeatures &cpu = GetCpu();
+		if (cpu.avx2)
+		{
+			return PixelConverter::SimdLevel::AVX2;
+		}
+		return cpu.sse41 ? PixelConverter::SimdLevel::SSE41 : PixelConverter::SimdLevel::Scalar;
+	}
+
+	atomic<PixelConverter::SimdLevel> &CurrentLevel()
+	{
+		static atomic<PixelConverter::SimdLevel> level(GetMaxLevel());
+		return level;
+	}
+
+	// 0x80은 pshufb에서 0
+	const char Z = char(0x80);
+
+	// --- Scalar (SIMD 구현의 나머지 Pixel도 여기서) ---
+
+	void ExpandScalar(const uint8_t *src, const int channels, size_t i, const size_t n, uint8_t *dst)
+	{
+		for (; i < n; i++)
+		{
+			const uint8_t *s = &src[i * channels];
+			uint8_t *d = &dst[i * 4];
+			switch (channels)
+			{
+			case 1:
+				d[0] = d[1] = d[2] = d[3] = s[0];
+				break;
+			case 2:
+				d[0] = s[0];
+				d[1] = s[1];
+				d[2] = d[3] = 255;
+				break;
+			case 3:
+				d[0] = s[0];
+				d[1] = s[1];
+				d[2] = s[2];
+				d[3] = 255;
+				break;
+			}
+		}
+	}
+
+	void SwizzleScalar(const uint8_t *src, const int order[4], size_t i, const size_t n, uint8_t *dst)
+	{
+		for (; i < n; i++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				dst[i * 4 + c] = order[c] < 0 ? 0 : src[i * 4 + order[c]];
+			}
+		}
+	}
+
+	void PackScalar(const uint8_t *src, const int srcChannel, size_t i, const size_t n,
+					uint8_t *dst, const int dstChannel)
+	{
+		for (; i < n; i++)
+		{
+			dst[i * 4 + dstChannel] = src[i * 4 + srcChannel];
+		}
+	}
+
+	void HalfToFloatScalar(const uint16_t *src, size_t i, const size_t n, float *dst)
+	{
+		for (; i < n; i++)
+		{
+			dst[i] = fp16_ieee_to_fp32_value(src[i]);
+		}
+	}
+
+	void FloatToHalfScalar(const float *src, size_t i, const size_t n, uint16_t *dst)
+	{
+		for (; i < n; i++)
+		{
+			dst[i] = fp16_ieee_from_fp32_value(src[i]);
+		}
+	}
+
+	// Rec. 709 Luminance
+	const float lumaR = 0.2126f;
+	const float lumaG = 0.7152f;
+	const float lumaB = 0.0722f;
+
+	// log2 근사 (지수 + 4차 다항식, 오차 1e-4 이하로 Histogram bin 폭보다 충분히 작음)
+	// SIMD와 같은 순서로 계산해서 bin이 같게 나오도록 함
+	float FastLog2(const float x)
+	{
+		uint32_t bits;
+		memcpy(&bits, &x, sizeof(bits));
+		const float exponent = float(int(bits >> 23) - 127);
+		bits = (bits & 0x007FFFFF) | 0x3F800000;
+		float m;
+		memcpy(&m, &bits, sizeof(m));
+		const float p = (((-0.081614486f * m + 0.645143719f) * m - 2.120699386f) * m + 4.070135f) * m - 2.512877422f;
+		return exponent + p;
+	}
+
+	struct HistogramRange {
+		float minLog2;
+		float scale; // bin / log2
+		float lastBin;
+	};
+
+	void LuminanceHistogramScalar(const uint16_t *rgba, size_t i, const size_t n, const HistogramRange &range,
+								  uint32_t *bins, float &minLuminance, float &maxLuminance)
+	{
+		for (; i < n; i++)
+		{
+			const float r = fp16_ieee_to_fp32_value(rgba[i * 4 + 0]);
+			const float g = fp16_ieee_to_fp32_value(rgba[i * 4 + 1]);
+			const float b = fp16_ieee_to_fp32_value(rgba[i * 4 + 2]);
+			float luminance = (r * lumaR + g * lumaG) + b * lumaB;
+			luminance = luminance > 0.0f ? luminance : 0.0f; // NaN, 음수는 0
+
+			minLuminance = min(minLuminance, luminance);
+			maxLuminance = max(maxLuminance, luminance);
+
+			const float t = (FastLog2(max(luminance, 1e-10f)) - range.minLog2) * range.scale;
+			bins[int(min(max(t, 0.0f), range.lastBin))]++;
+		}
+	}
+
+	const float *GetSRGBTable()
+	{
+		struct Table {
+			float values[256];
+			Table()
+			{
+				for (int i = 0; i < 256; i++)
+				{
+					const float c = float(i) / 255.0f;
+					values[i] = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+				}
+			}
+		};
+		static const Table table;
+		return table.values;
+	}
+
+	void SRGBToLinearScalar(const uint8_t *src, size_t i, const size_t n, float *dst)
+	{
+		const float *table = GetSRGBTable();
+		for (; i < n; i++)
+		{
+			dst[i] = table[src[i]];
+		}
+	}
+
+	void LinearToSRGBScalar(const float *src, size_t i, const size_t n, uint8_t *dst)
+	{
+		for (; i < n; i++)
+		{
+			const float x = min(max(src[i], 0.0f), 1.0f); // NaN은 0
+			const float c = x <= 0.0031308f ? x * 12.92f : 1.055f * powf(x, 1.0f / 2.4f) - 0.055f;
+			dst[i] = uint8_t(c * 255.0f + 0.5f);
+		}
+	}
+
+	// --- SSE4.1 (pshufb 포함) ---
+
+	TARGET_SSE41 void ExpandSSE41(const uint8_t *src, const int channels, const size_t n, uint8_t *dst)
+	{
+		size_t i = 0;
+		if (channels == 1)
+		{
+			const __m128i masks[4] = {
+				_mm_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3),
+				_mm_setr_epi8(4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7),
+				_mm_setr_epi8(8, 8, 8, 8, 9, 9, 9, 9, 10, 10, 10, 10, 11, 11, 11, 11),
+				_mm_setr_epi8(12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15),
+			};
+			for (; i + 16 <= n; i += 16)
+			{
+				const __m128i g = _mm_loadu_si128((const __m128i *)&src[i]);
+				for (int k = 0; k < 4; k++)
+				{
+					_mm_storeu_si128((__m128i *)&dst[(i + 4 * k) * 4], _mm_shuffle_epi8(g, masks[k]));
+				}
+			}
+		}
+		else if (channels == 2)
+		{
+			const __m128i alpha = _mm_set1_epi32(int(0xFFFF0000));
+			for (; i + 8 <= n; i += 8)
+			{
+				const __m128i rg = _mm_loadu_si128((const __m128i *)&src[i * 2]);
+				const __m128i lo = _mm_or_si128(_mm_cvtepu16_epi32(rg), alpha);
+				const __m128i hi = _mm_or_si128(_mm_cvtepu16_epi32(_mm_srli_si128(rg, 8)), alpha);
+				_mm_storeu_si128((__m128i *)&dst[i * 4], lo);
+				_mm_storeu_si128((__m128i *)&dst[(i + 4) * 4], hi);
+			}
+		}
+		else if (channels == 3)
+		{
+			// 16 byte를 읽어서 앞의 12 byte(4 Pixel)만 사용하므로 끝에서 읽기 범위 확인
+			const __m128i mask = _mm_setr_epi8(0, 1, 2, Z, 3, 4, 5, Z, 6, 7, 8, Z, 9, 10, 11, Z);
+			const __m128i alpha = _mm_set1_epi32(int(0xFF000000));
+			for (; i + 6 <= n; i += 4)
+			{
+				const __m128i rgb = _mm_loadu_si128((const __m128i *)&src[i * 3]);
+				_mm_storeu_si128((__m128i *)&dst[i * 4], _mm_or_si128(_mm_shuffle_epi8(rgb, mask), alpha));
+			}
+		}
+
+		ExpandScalar(src, channels, i, n, dst);
+	}
+
+	__m128i MakeSwizzleMask(const int order[4])
+	{
+		alignas(16) char bytes[16];
+		for (int p = 0; p < 4; p++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				bytes[p * 4 + c] = order[c] < 0 ? Z : char(p * 4 + order[c]);
+			}
+		}
+		return _mm_load_si128((const __m128i *)bytes);
+	}
+
+	// pshufb로 src 채널을 dst 채널 위치로 옮기는 mask와 dst 채널만 선택하는 mask
+	void MakePackMasks(const int srcChannel, const int dstChannel, __m128i &shuffle, __m128i &select)
+	{
+		alignas(16) char shuffleBytes[16];
+		alignas(16) char selectBytes[16];
+		for (int p = 0; p < 4; p++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				shuffleBytes[p * 4 + c] = c == dstChannel ? char(p * 4 + srcChannel) : Z;
+				selectBytes[p * 4 + c] = c == dstChannel ? Z : 0;
+			}
+		}
+		shuffle = _mm_load_si128((const __m128i *)shuffleBytes);
+		select = _mm_load_si128((const __m128i *)selectBytes);
+	}
+
+	TARGET_SSE41 void SwizzleSSE41(const uint8_t *src, const int order[4], const size_t n, uint8_t *dst)
+	{
+		const __m128i mask = MakeSwizzleMask(order);
+
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			const __m128i v = _mm_loadu_si128((const __m128i *)&src[i * 4]);
+			_mm_storeu_si128((__m128i *)&dst[i * 4], _mm_shuffle_epi8(v, mask));
+		}
+
+		SwizzleScalar(src, order, i, n, dst);
+	}
+
+	TARGET_SSE41 void PackSSE41(const uint8_t *src, const int srcChannel, const size_t n,
+								uint8_t *dst, const int dstChannel)
+	{
+		__m128i shuffle, select;
+		MakePackMasks(srcChannel, dstChannel, shuffle, select);
+
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			const __m128i s = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)&src[i * 4]), shuffle);
+			const __m128i d = _mm_loadu_si128((const __m128i *)&dst[i * 4]);
+			_mm_storeu_si128((__m128i *)&dst[i * 4], _mm_blendv_epi8(d, s, select));
+		}
+
+		PackScalar(src, srcChannel, i, n, dst, dstChannel);
+	}
+
+	// Linear -> sRGB 근사 (sqrt 3번, 8-bit로 반올림하면 정확한 값과 최대 1 차이)
+	TARGET_SSE41 __m128 LinearToSRGB4(__m128 x)
+	{
+		x = _mm_min_ps(_mm_max_ps(x, _mm_setzero_ps()), _mm_set1_ps(1.0f)); // NaN은 0
+
+		const __m128 s1 = _mm_sqrt_ps(x);
+		const __m128 s2 = _mm_sqrt_ps(s1);
+		const __m128 s3 = _mm_sqrt_ps(s2);
+		__m128 c = _mm_mul_ps(_mm_set1_ps(0.662002687f), s1);
+		c = _mm_add_ps(c, _mm_mul_ps(_mm_set1_ps(0.684122060f), s2));
+		c = _mm_sub_ps(c, _mm_mul_ps(_mm_set1_ps(0.323583601f), s3));
+		c = _mm_sub_ps(c, _mm_mul_ps(_mm_set1_ps(0.0225411470f), x));
+
+		const __m128 linear = _mm_mul_ps(x, _mm_set1_ps(12.92f));
+		c = _mm_blendv_ps(c, linear, _mm_cmple_ps(x, _mm_set1_ps(0.0031308f)));
+
+		return _mm_add_ps(_mm_mul_ps(c, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f));
+	}
+
+	TARGET_SSE41 void LinearToSRGBSSE41(const float *src, const size_t n, uint8_t *dst)
+	{
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			const __m128i v = _mm_cvttps_epi32(LinearToSRGB4(_mm_loadu_ps(&src[i])));
+			const __m128i packed = _mm_packus_epi16(_mm_packus_epi32(v, v), v);
+			const int bytes = _mm_cvtsi128_si32(packed);
+			memcpy(&dst[i], &bytes, 4);
+		}
+
+		LinearToSRGBScalar(src, i, n, dst);
+	}
+
+	// --- AVX2 (+ F16C) ---
+
+	TARGET_AVX2 void ExpandAVX2(const uint8_t *src, const int channels, const size_t n, uint8_t *dst)
+	{
+		size_t i = 0;
+		if (channels == 1)
+		{
+			// 128-bit Lane마다 4 Pixel씩
+			const __m256i masks[2] = {
+				_mm256_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+								 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7),
+				_mm256_setr_epi8(8, 8, 8, 8, 9, 9, 9, 9, 10, 10, 10, 10, 11, 11, 11, 11,
+								 12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15),
+			};
+			for (; i + 16 <= n; i += 16)
+			{
+				const __m256i g = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)&src[i]));
+				_mm256_storeu_si256((__m256i *)&dst[i * 4], _mm256_shuffle_epi8(g, masks[0]));
+				_mm256_storeu_si256((__m256i *)&dst[(i + 8) * 4], _mm256_shuffle_epi8(g, masks[1]));
+			}
+		}
+		else if (channels == 2)
+		{
+			const __m256i alpha = _mm256_set1_epi32(int(0xFFFF0000));
+			for (; i + 16 <= n; i += 16)
+			{
+				const __m256i rg = _mm256_loadu_si256((const __m256i *)&src[i * 2]);
+				const __m256i lo = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(rg));
+				const __m256i hi = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(rg, 1));
+				_mm256_storeu_si256((__m256i *)&dst[i * 4], _mm256_or_si256(lo, alpha));
+				_mm256_storeu_si256((__m256i *)&dst[(i + 8) * 4], _mm256_or_si256(hi, alpha));
+			}
+		}
+		else if (channels == 3)
+		{
+			// Lane마다 12 byte(4 Pixel), 두 번째 Lane은 16 byte를 읽으므로 끝에서 범위 확인
+			const __m256i mask = _mm256_setr_epi8(0, 1, 2, Z, 3, 4, 5, Z, 6, 7, 8, Z, 9, 10, 11, Z,
+												  0, 1, 2, Z, 3, 4, 5, Z, 6, 7, 8, Z, 9, 10, 11, Z);
+			const __m256i alpha = _mm256_set1_epi32(int(0xFF000000));
+			for (; i + 10 <= n; i += 8)
+			{
+				const __m128i lo = _mm_loadu_si128((const __m128i *)&src[i * 3]);
+				const __m128i hi = _mm_loadu_si128((const __m128i *)&src[i * 3 + 12]);
+				const __m256i rgb = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+				_mm256_storeu_si256((__m256i *)&dst[i * 4],
+									_mm256_or_si256(_mm256_shuffle_epi8(rgb, mask), alpha));
+			}
+		}
+
+		ExpandScalar(src, channels, i, n, dst);
+	}
+
+	TARGET_AVX2 void SwizzleAVX2(const uint8_t *src, const int order[4], const size_t n, uint8_t *dst)
+	{
+		const __m256i mask = _mm256_broadcastsi128_si256(MakeSwizzleMask(order));
+
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const __m256i v = _mm256_loadu_si256((const __m256i *)&src[i * 4]);
+			_mm256_storeu_si256((__m256i *)&dst[i * 4], _mm256_shuffle_epi8(v, mask));
+		}
+
+		SwizzleScalar(src, order, i, n, dst);
+	}
+
+	TARGET_AVX2 void PackAVX2(const uint8_t *src, const int srcChannel, const size_t n,
+							  uint8_t *dst, const int dstChannel)
+	{
+		__m128i shuffle128, select128;
+		MakePackMasks(srcChannel, dstChannel, shuffle128, select128);
+		const __m256i shuffle = _mm256_broadcastsi128_si256(shuffle128);
+		const __m256i select = _mm256_broadcastsi128_si256(select128);
+
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const __m256i s = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)&src[i * 4]), shuffle);
+			const __m256i d = _mm256_loadu_si256((const __m256i *)&dst[i * 4]);
+			_mm256_storeu_si256((__m256i *)&dst[i * 4], _mm256_blendv_epi8(d, s, select));
+		}
+
+		PackScalar(src, srcChannel, i, n, dst, dstChannel);
+	}
+
+	TARGET_AVX2 void SRGBToLinearAVX2(const uint8_t *src, const size_t n, float *dst)
+	{
+		const float *table = GetSRGBTable();
+
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const __m256i index = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)&src[i]));
+			_mm256_storeu_ps(&dst[i], _mm256_i32gather_ps(table, index, 4));
+		}
+
+		SRGBToLinearScalar(src, i, n, dst);
+	}
+
+	TARGET_AVX2 void LinearToSRGBAVX2(const float *src, const size_t n, uint8_t *dst)
+	{
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const __m128i lo = _mm_cvttps_epi32(LinearToSRGB4(_mm_loadu_ps(&src[i])));
+			const __m128i hi = _mm_cvttps_epi32(LinearToSRGB4(_mm_loadu_ps(&src[i + 4])));
+			const __m128i packed = _mm_packus_epi16(_mm_packus_epi32(lo, hi), lo);
+			_mm_storel_epi64((__m128i *)&dst[i], packed);
+		}
+
+		LinearToSRGBScalar(src, i, n, dst);
+	}
+
+	TARGET_AVX2 void HalfToFloatF16C(const uint16_t *src, const size_t n, float *dst)
+	{
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			_mm256_storeu_ps(&dst[i], _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)&src[i])));
+		}
+
+		HalfToFloatScalar(src, i, n, dst);
+	}
+
+	TARGET_AVX2 void FloatToHalfF16C(const float *src, const size_t n, uint16_t *dst)
+	{
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(&src[i]), _MM_FROUND_TO_NEAREST_INT);
+			_mm_storeu_si128((__m128i *)&dst[i], h);
+		}
+
+		FloatToHalfScalar(src, i, n, dst);
+	}
+
+	TARGET_AVX2 void LuminanceHistogramF16C(const uint16_t *rgba, const size_t n, const HistogramRange &range,
+											uint32_t *bins, float &minLuminance, float &maxLuminance)
+	{
+		// Alpha가 NaN/Inf여도 영향이 없도록 0으로 지우고 곱함
+		const __m256 rgbMask = _mm256_castsi256_ps(_mm256_setr_epi32(-1, -1, -1, 0, -1, -1, -1, 0));
+		const __m256 weights = _mm256_setr_ps(lumaR, lumaG, lumaB, 0.0f, lumaR, lumaG, lumaB, 0.0f);
+		const __m256 zero = _mm256_setzero_ps();
+		const __m256 minClamp = _mm256_set1_ps(1e-10f);
+		const __m256 minLog2 = _mm256_set1_ps(range.minLog2);
+		const __m256 scale = _mm256_set1_ps(range.scale);
+		const __m256 lastBin = _mm256_set1_ps(range.lastBin);
+		const __m256i mantissaMask = _mm256_set1_epi32(0x007FFFFF);
+		const __m256i one = _mm256_set1_epi32(0x3F800000);
+		const __m256i bias = _mm256_set1_epi32(127);
+
+		__m256 minV = _mm256_set1_ps(minLuminance);
+		__m256 maxV = _mm256_set1_ps(maxLuminance);
+		alignas(32) int32_t index[8];
+
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			// 2 pixel씩 (r g b a r g b a)
+			__m256 p[4];
+			for (int k = 0; k < 4; k++)
+			{
+				const __m128i h = _mm_loadu_si128((const __m128i *)&rgba[(i + 2 * k) * 4]);
+				p[k] = _mm256_mul_ps(_mm256_and_ps(_mm256_cvtph_ps(h), rgbMask), weights);
+			}
+
+			// 가로로 더해서 pixel마다 하나 (순서: 0 2 4 6 1 3 5 7, Histogram에는 상관없음)
+			const __m256 h01 = _mm256_hadd_ps(p[0], p[1]);
+			const __m256 h23 = _mm256_hadd_ps(p[2], p[3]);
+			__m256 luminance = _mm256_hadd_ps(h01, h23);
+			luminance = _mm256_max_ps(luminance, zero); // NaN이면 두 번째 값(0)
+
+			minV = _mm256_min_ps(luminance, minV);
+			maxV = _mm256_max_ps(luminance, maxV);
+
+			// FastLog2()와 같은 계산
+			const __m256i bits = _mm256_castps_si256(_mm256_max_ps(luminance, minClamp));
+			const __m256 exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), bias));
+			const __m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, mantissaMask), one));
+			__m256 poly = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(-0.081614486f), m), _mm256_set1_ps(0.645143719f));
+			poly = _mm256_sub_ps(_mm256_mul_ps(poly, m), _mm256_set1_ps(2.120699386f));
+			poly = _mm256_add_ps(_mm256_mul_ps(poly, m), _mm256_set1_ps(4.070135f));
+			poly = _mm256_sub_ps(_mm256_mul_ps(poly, m), _mm256_set1_ps(2.512877422f));
+
+			__m256 t = _mm256_mul_ps(_mm256_sub_ps(_mm256_add_ps(exponent, poly), minLog2), scale);
+			t = _mm256_min_ps(_mm256_max_ps(t, zero), lastBin);
+			_mm256_store_si256((__m256i *)index, _mm256_cvttps_epi32(t));
+
+			for (int k = 0; k < 8; k++)
+			{
+				bins[index[k]]++;
+			}
+		}
+
+		alignas(32) float mins[8];
+		alignas(32) float maxs[8];
+		_mm256_store_ps(mins, minV);
+		_mm256_store_ps(maxs, maxV);
+		for (int k = 0; k < 8; k++)
+		{
+			minLuminance = min(minLuminance, mins[k]);
+			maxLuminance = max(maxLuminance, maxs[k]);
+		}
+
+		LuminanceHistogramScalar(rgba, i, n, range, bins, minLuminance, maxLuminance);
+	}
+}
+
+PixelConverter::SimdLevel PixelConverter::GetSimdLevel() { return CurrentLevel(); }
+
+void PixelConverter::SetSimdLevel(const SimdLevel level)
+{
+	CurrentLevel() = min(level, GetMaxLevel());
+}
+
+bool PixelConverter::HasF16C() { return GetCpu().f16c; }
+
+void PixelConverter::ExpandToRGBA8(const uint8_t* src, const int channels, const size_t pixelCount,
+								   uint8_t* dst)
+{
+	if (channels == 4)
+	{
+		memcpy(dst, src, pixelCount * 4);
+		return;
+	}
+
+	switch (GetSimdLevel())
+	{
+	case SimdLevel::AVX2:
+		ExpandAVX2(src, channels, pixelCount, dst);
+		break;
+	case SimdLevel::SSE41:
+		ExpandSSE41(src, channels, pixelCount, dst);
+		break;
+	default:
+		ExpandScalar(src, channels, 0, pixelCount, dst);
+		break;
+	}
+}
+
+void PixelConverter::SwizzleRGBA8(const uint8_t* src, const int order[4], const size_t pixelCount,
+								  uint8_t* dst)
+{
+	switch (GetSimdLevel())
+	{
+	case SimdLevel::AVX2:
+		SwizzleAVX2(src, order, pixelCount, dst);
+		break;
+	case SimdLevel::SSE41:
+		SwizzleSSE41(src, order, pixelCount, dst);
+		break;
+	default:
+		SwizzleScalar(src, order, 0, pixelCount, dst);
+		break;
+	}
+}
+
+void PixelConverter::PackChannelRGBA8(const uint8_t* src, const int srcChannel, const size_t pixelCount,
+									  uint8_t* dst, const int dstChannel)
+{
+	switch (GetSimdLevel())
+	{
+	case SimdLevel::AVX2:
+		PackAVX2(src, srcChannel, pixelCount, dst, dstChannel);
+		break;
+	case SimdLevel::SSE41:
+		PackSSE41(src, srcChannel, pixelCount, dst, dstChannel);
+		break;
+	default:
+		PackScalar(src, srcChannel, 0, pixelCount, dst, dstChannel);
+		break;
+	}
+}
+
+void PixelConverter::HalfToFloat(const uint16_t* src, const size_t count, float* dst)
+{
+	if (GetSimdLevel() == SimdLevel::AVX2)
+	{
+		HalfToFloatF16C(src, count, dst);
+	}
+	else
+	{
+		HalfToFloatScalar(src, 0, count, dst);
+	}
+}
+
+void PixelConverter::FloatToHalf(const float* src, const size_t count, uint16_t* dst)
+{
+	if (GetSimdLevel() == SimdLevel::AVX2)
+	{
+		FloatToHalfF16C(src, count, dst);
+	}
+	else
+	{
+		FloatToHalfScalar(src, 0, count, dst);
+	}
+}
+
+void PixelConverter::LuminanceHistogramHalf(const uint16_t* rgba, const size_t pixelCount,
+											const float minLog2, const float maxLog2, uint32_t* bins,
+											const int binCount, float& minLuminance, float& maxLuminance)
+{
+	if (binCount <= 0 || !(maxLog2 > minLog2))
+	{
+		return;
+	}
+
+	const HistogramRange range = { minLog2, float(binCount) / (maxLog2 - minLog2), float(binCount - 1) };
+
+	if (GetSimdLevel() == SimdLevel::AVX2)
+	{
+		LuminanceHistogramF16C(rgba, pixelCount, range, bins, minLuminance, maxLuminance);
+	}
+	else
+	{
+		LuminanceHistogramScalar(rgba, 0, pixelCount, range, bins, minLuminance, maxLuminance);
+	}
+}
+
+void PixelConverter::SRGBToLinear(const uint8_t* src, const size_t count, float* dst)
+{
+	// 256개 Table이라 SSE는 Scalar와 같음 (AVX2는 gather)
+	if (GetSimdLevel() == SimdLevel::AVX2)
+	{
+		SRGBToLinearAVX2(src, count, dst);
+	}
+	else
+	{
+		SRGBToLinearScalar(src, 0, count, dst);
+	}
+}
+
+void PixelConverter::LinearToSRGB(const float* src, const size_t count, uint8_t* dst)
+{
+	switch (GetSimdLevel())
+	{
+	case SimdLevel::AVX2:
+		LinearToSRGBAVX2(src, count, dst);
+		break;
+	case SimdLevel::SSE41:
+		LinearToSRGBSSE41(src, count, dst);
+		break;
+	default:
+		LinearToSRGBScalar(src, 0, count, dst);
+		break;
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// 이미지 Pixel 변환 (실행 중 CPU를 확인해서 AVX2 / SSE4.1 / Scalar 중 선택)
+// fp16 변환은 F16C가 있을 때만 SIMD
+// 모든 함수는 pixelCount(또는 값 개수) 단위, src와 dst는 겹치지 않아야 함
+class PixelConverter {
+public:
+	enum class SimdLevel { Scalar, SSE41, AVX2 };
+
+	// 현재 사용하는 구현 (SetSimdLevel은 tests/TestPixelConverter에서 Scalar와 비교할 때만 사용, CPU가 지원하는 수준까지만)
+	static SimdLevel GetSimdLevel();
+	static void SetSimdLevel(const SimdLevel level);
+	static bool HasF16C();
+
+	// 1/2/3/4 채널 -> RGBA8 (stb_image 결과를 Texture로 올릴 때)
+	// Gray: (g, g, g, g), RG: (r, g, 255, 255), RGB: (r, g, b, 255)
+	static void ExpandToRGBA8(const uint8_t *src, const int channels, const size_t pixelCount,
+							  uint8_t *dst);
+
+	// RGBA8의 채널 순서 변경, dst의 채널 c = src의 채널 order[c] (order[c] < 0이면 0)
+	static void SwizzleRGBA8(const uint8_t *src, const int order[4], const size_t pixelCount,
+							 uint8_t *dst);
+
+	// RGBA8 src의 한 채널을 RGBA8 dst의 한 채널에 넣음 (dst의 나머지 채널은 그대로)
+	static void PackChannelRGBA8(const uint8_t *src, const int srcChannel, const size_t pixelCount,
+								 uint8_t *dst, const int dstChannel);
+
+	static void HalfToFloat(const uint16_t *src, const size_t count, float *dst);
+	static void FloatToHalf(const float *src, const size_t count, uint16_t *dst);
+
+	// RGBA fp16 pixel들의 Luminance를 [minLog2, maxLog2)에서 binCount개 구간으로 나눈 Histogram
+	// bins와 minLuminance/maxLuminance에 누적 (범위 밖은 양 끝 bin, NaN/음수는 0)
+	// Auto Exposure와 .exr 확인에 사용 (fp32 배열을 따로 만들지 않음)
+	static void LuminanceHistogramHalf(const uint16_t *rgba, const size_t pixelCount, const float minLog2,
+									   const float maxLog2, uint32_t *bins, const int binCount,
+									   float &minLuminance, float &maxLuminance);
+
+	// 8-bit sRGB <-> Linear float (SIMD 구현의 Linear -> sRGB는 정확한 값과 최대 1 차이)
+	static void SRGBToLinear(const uint8_t *src, const size_t count, float *dst);
+	static void LinearToSRGB(const float *src, const size_t count, uint8_t *dst);
+};
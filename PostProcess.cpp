@@ -6,8 +6,8 @@ using namespace Microsoft::WRL;
 
 void PostProcess::Initialize(Microsoft::WRL::ComPtr<ID3D11Device>& device,
 							Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
-							const std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>>& srvs,
-							const std::vector<Microsoft::WRL::ComPtr<ID3D11RenderTargetView>>& rtvs,
+							ArrayView<const Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> srvs,
+							ArrayView<const Microsoft::WRL::ComPtr<ID3D11RenderTargetView>> rtvs,
 							const int width, const int height, const int bloomLevels)
 {
 	MeshData meshData = GeometryGenerator::MakeSquare();
@@ -15,7 +15,11 @@ void PostProcess::Initialize(Microsoft::WRL::ComPtr<ID3D11Device>& device,
 	m_mesh = make_shared<Mesh>();
 	D3D11Utils::CreateVertexBuffer(device, meshData.vertices, m_mesh->vertexBuffer);
 	m_mesh->indexCount = UINT(meshData.indices.size());
-	D3D11Utils::CreateIndexBuffer(device, meshData.indices, m_mesh->indexBuffer);
+
+	vector<uint16_t> indices(meshData.indices.size());
+	IndexNarrower::Narrow(meshData.indices.data(), meshData.indices.size(), 0, indices.data());
+	D3D11Utils::CreateIndexBuffer(device, indices, m_mesh->indexBuffer);
+	m_mesh->indexFormat = DXGI_FORMAT_R16_UINT;
 
 	// Bloom Donw
 	m_bloomSRVs.resize(bloomLevels);
@@ -63,9 +67,26 @@ void PostProcess::Initialize(Microsoft::WRL::ComPtr<ID3D11Device>& device,
 	m_combineFilter.SetShaderResources({ srvs[0], m_bloomSRVs[0] });
 	m_combineFilter.SetRenderTarget(rtvs);
 	m_combineFilter.m_constData.strength = 0.0f; // Bloom Strength
-	m_combineFilter.m_constData.option1 = 1.0f; // Exposure로 사용
+	m_combineFilter.m_constData.option1 = m_useAutoExposure ? m_autoExposure.GetExposure() : 1.0f; // Exposure로 사용
 	m_combineFilter.m_constData.option2 = 2.2f; // Gamma로 사용
 	m_combineFilter.UpdateConstantBuffers(device, context);
+
+	// Auto Exposure용 Readback (해상도가 바뀌면 이전에 복사한 것은 버림)
+	ComPtr<ID3D11Resource> exposureResource;
+	m_bloomSRVs.back()->GetResource(exposureResource.GetAddressOf());
+	ThrowIfFailed(exposureResource.As(&m_exposureSource));
+
+	D3D11_TEXTURE2D_DESC stagingDesc;
+	m_exposureSource->GetDesc(&stagingDesc);
+	stagingDesc.Usage = D3D11_USAGE_STAGING;
+	stagingDesc.BindFlags = 0;
+	stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+	for (ComPtr<ID3D11Texture2D>& staging : m_exposureStaging)
+	{
+		ThrowIfFailed(device->CreateTexture2D(&stagingDesc, NULL, staging.ReleaseAndGetAddressOf()));
+	}
+	m_exposureCopyCount = 0;
+	m_exposureReadCount = 0;
 }
 
 void PostProcess::Render(Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context)
@@ -76,24 +97,67 @@ void PostProcess::Render(Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context)
 	UINT offset = 0;
 
 	context->IASetVertexBuffers(0, 1, m_mesh->vertexBuffer.GetAddressOf(), &stride, &offset);
-	context->IASetIndexBuffer(m_mesh->indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
+	context->IASetIndexBuffer(m_mesh->indexBuffer.Get(), m_mesh->indexFormat, 0);
 
-	// Bloom이 필요한 경우만
-	if (m_combineFilter.m_constData.strength > 0.0f)
+	// Bloom이 필요한 경우만 (Down은 Auto Exposure에서도 사용)
+	const bool useBloom = m_combineFilter.m_constData.strength > 0.0f;
+	if (useBloom || m_useAutoExposure)
 	{
 		for (int i = 0; i < m_bloomDownFilters.size(); i++)
 		{
 			RenderImageFilter(context, m_bloomDownFilters[i]);
 		}
+	}
+	if (useBloom)
+	{
 		for (int i = 0; i < m_bloomUpFilters.size(); i++)
 		{
 			RenderImageFilter(context, m_bloomUpFilters[i]);
 		}
 	}
 
+	// 읽지 않은 것이 꽉 차 있으면 이번 Frame은 건너뜀
+	if (m_useAutoExposure && m_exposureCopyCount - m_exposureReadCount < exposureReadbackCount)
+	{
+		context->CopyResource(m_exposureStaging[m_exposureCopyCount % exposureReadbackCount].Get(),
+							  m_exposureSource.Get());
+		m_exposureCopyCount++;
+	}
+
 	RenderImageFilter(context, m_combineFilter);
 }
 
+void PostProcess::UpdateExposure(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+								 Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context, const float dt)
+{
+	m_exposureElapsed += dt;
+
+	if (!m_useAutoExposure || m_exposureReadCount == m_exposureCopyCount)
+	{
+		return;
+	}
+
+	// 가장 오래된 복사본, GPU가 아직 안 끝났으면 다음 Frame에 다시 시도
+	ID3D11Texture2D* staging = m_exposureStaging[m_exposureReadCount % exposureReadbackCount].Get();
+	D3D11_MAPPED_SUBRESOURCE ms;
+	if (context->Map(staging, 0, D3D11_MAP_READ, D3D11_MAP_FLAG_DO_NOT_WAIT, &ms) != S_OK)
+	{
+		return;
+	}
+
+	D3D11_TEXTURE2D_DESC desc;
+	staging->GetDesc(&desc);
+
+	m_histogram.Clear();
+	m_histogram.Add((const uint16_t*)ms.pData, desc.Width, desc.Height, ms.RowPitch);
+	context->Unmap(staging, 0);
+	m_exposureReadCount++;
+
+	m_combineFilter.m_constData.option1 = m_autoExposure.Update(m_histogram, m_exposureElapsed);
+	m_combineFilter.UpdateConstantBuffers(device, context);
+	m_exposureElapsed = 0.0f;
+}
+
 void PostProcess::RenderImageFilter(Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
 									const ImageFilter& imageFilter)
 {
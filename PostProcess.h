@@ -1,17 +1,22 @@
 #pragma once
 
+#include "AutoExposure.h"
 #include "ImageFilter.h"
 
 class PostProcess {
 public:
 	void Initialize(Microsoft::WRL::ComPtr<ID3D11Device> &device,
 				   Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
-				   const std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> &srvs,
-				   const std::vector<Microsoft::WRL::ComPtr<ID3D11RenderTargetView>> &rtvs,
+				   ArrayView<const Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> srvs,
+				   ArrayView<const Microsoft::WRL::ComPtr<ID3D11RenderTargetView>> rtvs,
 				   const int width, const int height, const int bloomLevels);
 
 	void Render(Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context);
 
+	// 몇 Frame 전에 복사해둔 작은 HDR 이미지로 Exposure(m_combineFilter의 option1)를 갱신
+	void UpdateExposure(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+						Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context, const float dt);
+
 	void RenderImageFilter(Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
 						   const ImageFilter &imageFilter);
 
@@ -28,7 +33,20 @@ public:
 
 	std::shared_ptr<Mesh> m_mesh;
 
+	bool m_useAutoExposure = true;
+	AutoExposure m_autoExposure;
+	LuminanceHistogram m_histogram; // 마지막으로 읽은 Frame
+
 private:
 	std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> m_bloomSRVs;
 	std::vector<Microsoft::WRL::ComPtr<ID3D11RenderTargetView>> m_bloomRTVs;
+
+	// Bloom Down의 가장 작은 단계를 Staging Texture로 복사해두고
+	// GPU가 끝났을 때 읽음 (기다리지 않도록 여러 개를 돌려가며 사용)
+	static const int exposureReadbackCount = 3;
+	Microsoft::WRL::ComPtr<ID3D11Texture2D> m_exposureSource;
+	Microsoft::WRL::ComPtr<ID3D11Texture2D> m_exposureStaging[exposureReadbackCount];
+	uint64_t m_exposureCopyCount = 0;
+	uint64_t m_exposureReadCount = 0;
+	float m_exposureElapsed = 0.0f; // 마지막으로 읽은 뒤 지난 시간
 };
\ No newline at end of file
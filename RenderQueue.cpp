@@ -0,0 +1,131 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+uint64_t RenderQueue::MakeKey(const uint32_t pass, const uint32_t material, const uint32_t geometry,
+							  const float depth, const bool frontToBack)
+{
+	// 양수 float는 Bit 순서와 크기 순서가 같음 (카메라 뒤는 0)
+	uint32_t depthBits = 0;
+	if (depth > 0.0f)
+	{
+		memcpy(&depthBits, &depth, sizeof(depthBits));
+	}
+	uint64_t depthKey = depthBits >> 8; // 24 bit
+	if (!frontToBack)
+	{
+		depthKey = 0xFFFFFF - depthKey;
+	}
+
+	return (uint64_t(pass & 0xFF) << 56) | (uint64_t(material & 0xFFFF) << 40) |
+		   (uint64_t(geometry & 0xFFFF) << 24) | depthKey;
+}
+
+uint32_t RenderQueue::MakeId(std::initializer_list<const void*> resources)
+{
+	uint64_t hash = 0;
+	for (const void* resource : resources)
+	{
+		hash = (hash ^ uint64_t(uintptr_t(resource))) * 0x9E3779B97F4A7C15ull;
+		hash ^= hash >> 29;
+	}
+	return uint32_t(hash >> 48);
+}
+
+void RenderQueue::Clear()
+{
+	// Capacity는 유지 (Frame마다 비슷한 개수)
+	m_packets.clear();
+	m_passOffsets.clear();
+}
+
+void RenderQueue::Sort()
+{
+	const size_t count = m_packets.size();
+	if (count > 1)
+	{
+		m_scratch.resize(count);
+
+		// 한 번 읽으면서 8자리의 Histogram을 모두 계산
+		uint32_t histograms[8][256] = {};
+		for (const Packet& packet : m_packets)
+		{
+			for (int digit = 0; digit < 8; digit++)
+			{
+				histograms[digit][(packet.key >> (digit * 8)) & 0xFF]++;
+			}
+		}
+
+		Packet* src = m_packets.data();
+		Packet* dst = m_scratch.data();
+		for (int digit = 0; digit < 8; digit++)
+		{
+			uint32_t* histogram = histograms[digit];
+			const int shift = digit * 8;
+
+			// 모든 Key의 이 자리가 같으면 순서가 바뀌지 않음 (Pass, 빈 Material 등)
+			if (histogram[(src[0].key >> shift) & 0xFF] == count)
+			{
+				continue;
+			}
+
+			uint32_t offset = 0;
+			for (int b = 0; b < 256; b++)
+			{
+				const uint32_t binCount = histogram[b];
+				histogram[b] = offset;
+				offset += binCount;
+			}
+
+			for (size_t i = 0; i < count; i++)
+			{
+				dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+			}
+			swap(src, dst);
+		}
+
+		if (src != m_packets.data())
+		{
+			m_packets.swap(m_scratch);
+		}
+	}
+
+	UpdatePassOffsets();
+}
+
+void RenderQueue::SortComparison()
+{
+	// 같은 Key는 넣은 순서 유지 (Radix Sort와 결과가 같도록)
+	stable_sort(m_packets.begin(), m_packets.end(),
+				[](const Packet& a, const Packet& b) { return a.key < b.key; });
+
+	UpdatePassOffsets();
+}
+
+void RenderQueue::UpdatePassOffsets()
+{
+	m_passOffsets.assign(MAX_PASSES + 1, 0);
+	for (const Packet& packet : m_packets)
+	{
+		m_passOffsets[(packet.key >> 56) + 1]++;
+	}
+	for (uint32_t pass = 0; pass < MAX_PASSES; pass++)
+	{
+		m_passOffsets[pass + 1] += m_passOffsets[pass];
+	}
+}
+
+const RenderQueue::Packet* RenderQueue::GetPassPackets(const uint32_t pass, size_t& count) const
+{
+	if (pass >= MAX_PASSES || m_passOffsets.empty())
+	{
+		count = 0;
+		return nullptr;
+	}
+
+	count = m_passOffsets[pass + 1] - m_passOffsets[pass];
+	return m_packets.data() + m_passOffsets[pass];
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+// 한 Frame의 Draw들을 64-bit Key로 정렬해서 상태 변경이 적은 순서로 그림
+// Key와 호출하는 쪽의 Item Index만 저장 (D3D 없이 동작, 그리는 것은 호출하는 쪽에서)
+class RenderQueue {
+public:
+	// 높은 Bit부터: Pass 8 | Material 16 | Geometry 16 | Depth 24
+	// Pass마다 PSO가 정해져 있으므로 Pass 순서가 곧 PSO 순서
+	static const uint32_t MAX_PASSES = 256;
+
+	struct Packet {
+		uint64_t key;
+		uint32_t item;
+	};
+
+	// depth: View Space z (frontToBack이면 가까운 것부터, 아니면 먼 것부터)
+	static uint64_t MakeKey(const uint32_t pass, const uint32_t material, const uint32_t geometry,
+							const float depth, const bool frontToBack = true);
+
+	// 자원 포인터들로 만든 16-bit Id (같은 조합이면 같은 값, 충돌해도 정렬 순서만 달라짐)
+	static uint32_t MakeId(std::initializer_list<const void *> resources);
+
+	void Clear();
+
+	void Add(const uint64_t key, const uint32_t item) { m_packets.push_back({ key, item }); }
+
+	// 8-bit씩 LSD Radix Sort (모든 Key가 같은 자리는 건너뜀)
+	void Sort();
+
+	// std::stable_sort (비교용)
+	void SortComparison();
+
+	// Sort() 이후 pass의 Packet들 [first, first + count)
+	const Packet *GetPassPackets(const uint32_t pass, size_t &count) const;
+
+	const std::vector<Packet> &GetPackets() const { return m_packets; }
+	size_t GetSize() const { return m_packets.size(); }
+
+private:
+	void UpdatePassOffsets();
+
+	std::vector<Packet> m_packets;
+	std::vector<Packet> m_scratch;		 // Radix Sort 중간 결과 (Frame마다 재사용)
+	std::vector<uint32_t> m_passOffsets; // MAX_PASSES + 1개
+};
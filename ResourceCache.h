@@ -0,0 +1,125 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// key로 공유하는 자원 (사용하는 곳이 모두 사라지면 자동으로 해제)
+// 여러 Thread에서 같은 key를 동시에 요청해도 create()는 한 번만 실행되고 나머지는 기다림
+// D3D와 무관하므로 Decoding한 이미지, GPU Texture 등에 공통으로 사용
+template <typename T>
+class ResourceCache {
+public:
+	using CreateFunc = std::function<std::shared_ptr<T>()>;
+
+	std::shared_ptr<T> GetOrCreate(const std::string &key, const CreateFunc &create)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		Entry &entry = m_entries[key];
+		if (std::shared_ptr<T> value = entry.value.lock())
+		{
+			m_hitCount++;
+			return value;
+		}
+
+		// 다른 Thread에서 만드는 중
+		if (entry.pending.valid())
+		{
+			m_hitCount++;
+			std::shared_future<std::shared_ptr<T>> pending = entry.pending;
+			lock.unlock();
+			return pending.get();
+		}
+
+		m_missCount++;
+
+		std::promise<std::shared_ptr<T>> promise;
+		entry.pending = promise.get_future().share();
+		lock.unlock();
+
+		std::shared_ptr<T> value;
+		try
+		{
+			value = create();
+		}
+		catch (...)
+		{
+			lock.lock();
+			m_entries.erase(key);
+			lock.unlock();
+
+			promise.set_exception(std::current_exception());
+			throw;
+		}
+
+		// Lock을 풀었던 동안 다른 Thread가 map을 바꿨을 수 있으므로 다시 찾음
+		lock.lock();
+		Entry &created = m_entries[key];
+		created.value = value;
+		created.pending = {};
+		lock.unlock();
+
+		promise.set_value(value);
+
+		return value;
+	}
+
+	// 만들지 않고 살아있는 것만 찾음 (통계에 포함하지 않음)
+	std::shared_ptr<T> Find(const std::string &key) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		auto it = m_entries.find(key);
+		return it != m_entries.end() ? it->second.value.lock() : nullptr;
+	}
+
+	bool Contains(const std::string &key) const { return Find(key) != nullptr; }
+
+	// 해제된 자원의 key를 정리하고 살아있는 개수 반환
+	size_t PruneExpired()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		for (auto it = m_entries.begin(); it != m_entries.end();)
+		{
+			if (it->second.value.expired() && !it->second.pending.valid())
+			{
+				it = m_entries.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		return m_entries.size();
+	}
+
+	size_t GetHitCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_hitCount;
+	}
+
+	size_t GetMissCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_missCount;
+	}
+
+private:
+	struct Entry {
+		std::weak_ptr<T> value;
+		std::shared_future<std::shared_ptr<T>> pending; // 만드는 중일 때만 valid
+	};
+
+	mutable std::mutex m_mutex;
+	std::unordered_map<std::string, Entry> m_entries;
+
+	size_t m_hitCount = 0;
+	size_t m_missCount = 0;
+};
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <directxtk/SimpleMath.h>
+
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "ArrayView.h"
+#include "BVH.h"
+#include "MeshBVH.h"
+
+// 여러 Model의 World AABB로 만든 BVH, Leaf에서는 Ray를 Model Space로 옮겨서 Mesh::bvh로 검사
+// Model 포인터만 저장하므로 검사하는 동안 Model을 유지해야 함
+// T_MODEL은 m_worldRow, m_bounds, m_geometryVersion, IntersectRay(), IntersectRayAny()만 사용
+// (D3D 자원 없이 테스트할 수 있도록 Template, 앱에서는 SceneBVH)
+template <typename T_MODEL>
+class BasicSceneBVH {
+public:
+	// 현재 m_worldRow로 다시 만듦 (RayHit::object는 models의 Index)
+	void Build(ArrayView<const T_MODEL *const> models);
+
+	// Build() 이후 Model들이 움직였거나 Geometry가 바뀌었을 때 (비동기로 읽은 Model로 교체 등)
+	// Tree 구조는 유지하고 경계만 갱신 (바뀐 것이 없으면 그대로)
+	// (많이 움직여서 Box가 많이 겹치면 Build()가 더 나음)
+	void Refit();
+
+	// World Space Ray, hit.distance보다 가까운 교차만 기록
+	bool IntersectClosest(const DirectX::SimpleMath::Ray &ray, RayHit &hit) const;
+
+	// maxDistance 안에 교차가 하나라도 있는지
+	bool IntersectAny(const DirectX::SimpleMath::Ray &ray, const float maxDistance = FLT_MAX) const;
+
+	const T_MODEL *GetModel(const uint32_t object) const { return m_models[object]; }
+	size_t GetObjectCount() const { return m_models.size(); }
+
+private:
+	// Model의 World AABB와 World -> Model Space 행렬 (경계가 없으면 빈 Box)
+	void UpdateObject(const size_t object);
+
+	template <bool anyHit>
+	bool Intersect(const DirectX::SimpleMath::Ray &ray, RayHit &hit) const;
+
+	std::vector<const T_MODEL *> m_models;
+	std::vector<DirectX::SimpleMath::Matrix> m_worldRows; // 경계를 계산할 때의 m_worldRow
+	std::vector<uint32_t> m_geometryVersions;             // 경계를 계산할 때의 m_geometryVersion
+	std::vector<DirectX::SimpleMath::Matrix> m_worldToModel;
+	std::vector<BVHBox> m_boxes;
+
+	std::vector<BVHNode> m_nodes;
+	std::vector<uint32_t> m_order;
+};
+
+class Model;
+using SceneBVH = BasicSceneBVH<Model>;
+
+template <typename T_MODEL>
+void BasicSceneBVH<T_MODEL>::Build(ArrayView<const T_MODEL *const> models)
+{
+	m_models.assign(models.begin(), models.end());
+	m_worldRows.resize(models.size());
+	m_geometryVersions.resize(models.size());
+	m_worldToModel.resize(models.size());
+	m_boxes.resize(models.size());
+	for (size_t i = 0; i < models.size(); i++)
+	{
+		UpdateObject(i);
+	}
+
+	// Leaf에서 Model마다 Mesh BVH를 따로 순회하므로 작은 Leaf
+	BVH::Settings settings;
+	settings.maxLeafSize = 2;
+	BVH::Build(m_boxes, settings, m_nodes, m_order);
+}
+
+template <typename T_MODEL>
+void BasicSceneBVH<T_MODEL>::Refit()
+{
+	// 마지막으로 계산한 뒤에 움직였거나 Mesh가 바뀐 Model만 (Picking 때마다 부르므로 대부분 그대로)
+	// Placeholder를 읽은 Model로 바꾸면 World 행렬은 그대로이고 경계만 바뀜
+	bool isChanged = false;
+	for (size_t i = 0; i < m_models.size(); i++)
+	{
+		if (m_worldRows[i] != m_models[i]->m_worldRow ||
+			m_geometryVersions[i] != m_models[i]->m_geometryVersion)
+		{
+			UpdateObject(i);
+			isChanged = true;
+		}
+	}
+
+	if (isChanged)
+	{
+		BVH::Refit(m_boxes, m_order, m_nodes);
+	}
+}
+
+template <typename T_MODEL>
+void BasicSceneBVH<T_MODEL>::UpdateObject(const size_t object)
+{
+	using namespace DirectX;
+	using namespace DirectX::SimpleMath;
+
+	const T_MODEL &model = *m_models[object];
+	const Matrix &m = model.m_worldRow;
+	m_worldRows[object] = m;
+	m_geometryVersions[object] = model.m_geometryVersion;
+
+	// Mesh가 없어서 경계가 없으면 빈 Box (부모 Node를 키우지 않고 Leaf에서 건너뜀)
+	if (!model.m_bounds.isValid)
+	{
+		m_worldToModel[object] = Matrix();
+		m_boxes[object].boxMin = XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX);
+		m_boxes[object].boxMax = XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+		return;
+	}
+
+	m_worldToModel[object] = m.Invert();
+
+	// Model Space AABB를 World로 (Center는 그대로 옮기고 Extents는 |M|로)
+	const BoundingBox &box = model.m_bounds.box;
+	const Vector3 center = Vector3::Transform(Vector3(box.Center), m);
+	const Vector3 extents(
+		std::fabs(m._11) * box.Extents.x + std::fabs(m._21) * box.Extents.y + std::fabs(m._31) * box.Extents.z,
+		std::fabs(m._12) * box.Extents.x + std::fabs(m._22) * box.Extents.y + std::fabs(m._32) * box.Extents.z,
+		std::fabs(m._13) * box.Extents.x + std::fabs(m._23) * box.Extents.y + std::fabs(m._33) * box.Extents.z);
+
+	m_boxes[object].boxMin = center - extents;
+	m_boxes[object].boxMax = center + extents;
+}
+
+template <typename T_MODEL>
+template <bool anyHit>
+bool BasicSceneBVH<T_MODEL>::Intersect(const DirectX::SimpleMath::Ray &ray, RayHit &hit) const
+{
+	using namespace DirectX::SimpleMath;
+
+	const BVHRay bvhRay(ray.position, ray.direction);
+
+	bool found = false;
+	float maxDistance = hit.distance;
+	BVH::Traverse(m_nodes, bvhRay, maxDistance, [&](const BVHNode &leaf, float &distance) {
+		for (uint32_t k = leaf.leftFirst; k < leaf.leftFirst + leaf.count; k++)
+		{
+			const uint32_t object = m_order[k];
+			if (m_boxes[object].boxMin.x > m_boxes[object].boxMax.x)
+			{
+				continue;
+			}
+
+			// 방향을 정규화하지 않으면 Model Space에서도 같은 거리 단위
+			const Vector3 origin = Vector3::Transform(ray.position, m_worldToModel[object]);
+			const Vector3 dir = Vector3::TransformNormal(ray.direction, m_worldToModel[object]);
+
+			if (anyHit)
+			{
+				if (m_models[object]->IntersectRayAny(origin, dir, distance))
+				{
+					found = true;
+					return true;
+				}
+			}
+			else if (m_models[object]->IntersectRay(origin, dir, hit))
+			{
+				hit.object = object;
+				distance = hit.distance;
+				found = true;
+			}
+		}
+		return false;
+	});
+
+	return found;
+}
+
+template <typename T_MODEL>
+bool BasicSceneBVH<T_MODEL>::IntersectClosest(const DirectX::SimpleMath::Ray &ray, RayHit &hit) const
+{
+	return Intersect<false>(ray, hit);
+}
+
+template <typename T_MODEL>
+bool BasicSceneBVH<T_MODEL>::IntersectAny(const DirectX::SimpleMath::Ray &ray, const float maxDistance) const
+{
+	RayHit hit;
+	hit.distance = maxDistance;
+	return Intersect<true>(ray, hit);
+}
@@ -6,8 +6,9 @@ struct SkyboxPixelShaderInput
     float3 posModel : POSITION;
 };
 
-SkyboxPixelShaderInput main(VertexShaderInput input)
+SkyboxPixelShaderInput main(QuantizedVertexShaderInput quantizedInput)
 {
+    VertexShaderInput input = DecodeVertex(quantizedInput);
 
     SkyboxPixelShaderInput output;
     output.posModel = input.posModel;
@@ -0,0 +1,408 @@
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstring>
+
+#include "D3D11Types.h"
+
+// Device Context 앞에서 마지막으로 설정한 상태를 기억하고 같은 값을 다시 설정하는 호출은 버림
+// 여러 Slot을 한 번에 설정하면 바뀐 Slot 구간만 보냄, 나머지 호출은 GetContext()로 직접
+// Context는 ID3D11DeviceContext 또는 같은 함수를 가진 Mock (MockDeviceContext)
+//
+// 주의: Context를 직접 사용해서 상태를 바꿨으면 Invalidate()로 기억한 상태를 버려야 함
+//       Render Target을 바꾸면 D3D11이 같은 자원의 SRV를 풀 수 있으므로
+//       OMSetRenderTargets()는 여기로 호출하거나 호출한 뒤 InvalidateResources()
+template <typename Context>
+class StateCache {
+public:
+	struct Stats {
+		size_t calls = 0;	// 이 Class로 들어온 Set 호출
+		size_t dropped = 0; // 모두 같아서 보내지 않은 호출
+		size_t trimmed = 0; // 바뀐 Slot 구간만 보낸 호출
+	};
+
+	void SetContext(Context *context)
+	{
+		m_context = context;
+		Invalidate();
+	}
+
+	Context *GetContext() const { return m_context; }
+
+	// 실제 상태를 모르는 것으로 봄 (다음 설정은 모두 보냄)
+	void Invalidate()
+	{
+		InvalidateResources();
+
+		m_inputLayout.known = false;
+		m_topology.known = false;
+		m_rasterizerState.known = false;
+		m_blendState.known = false;
+		m_depthStencilState.known = false;
+		for (Stage *stage : { &m_vs, &m_hs, &m_ds, &m_gs, &m_ps })
+		{
+			stage->shader.known = false;
+			stage->samplers.known.reset();
+		}
+	}
+
+	// Buffer와 SRV만 버림 (Pipeline State와 Sampler는 유지)
+	void InvalidateResources()
+	{
+		m_vertexBuffers.known.reset();
+		m_indexBuffer.known = false;
+		for (Stage *stage : { &m_vs, &m_hs, &m_ds, &m_gs, &m_ps })
+		{
+			stage->constantBuffers.known.reset();
+			stage->shaderResources.known.reset();
+		}
+	}
+
+	const Stats &GetStats() const { return m_stats; }
+	void ResetStats() { m_stats = Stats(); }
+
+	void IASetInputLayout(ID3D11InputLayout *inputLayout)
+	{
+		if (SetValue(m_inputLayout, inputLayout))
+		{
+			m_context->IASetInputLayout(inputLayout);
+		}
+	}
+
+	void IASetPrimitiveTopology(const D3D11_PRIMITIVE_TOPOLOGY topology)
+	{
+		if (SetValue(m_topology, topology))
+		{
+			m_context->IASetPrimitiveTopology(topology);
+		}
+	}
+
+	void IASetVertexBuffers(const UINT startSlot, const UINT numBuffers, ID3D11Buffer *const *buffers,
+							const UINT *strides, const UINT *offsets)
+	{
+		VertexBuffer values[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+		for (UINT i = 0; i < numBuffers; i++)
+		{
+			values[i] = { buffers[i], strides[i], offsets[i] };
+		}
+
+		UINT first, count;
+		if (SetSlots(m_vertexBuffers, startSlot, numBuffers, values, first, count))
+		{
+			const UINT skip = first - startSlot;
+			m_context->IASetVertexBuffers(first, count, buffers + skip, strides + skip, offsets + skip);
+		}
+	}
+
+	void IASetIndexBuffer(ID3D11Buffer *indexBuffer, const DXGI_FORMAT format, const UINT offset)
+	{
+		if (SetValue(m_indexBuffer, IndexBuffer{ indexBuffer, format, offset }))
+		{
+			m_context->IASetIndexBuffer(indexBuffer, format, offset);
+		}
+	}
+
+	void VSSetShader(ID3D11VertexShader *shader, ID3D11ClassInstance *const *classInstances,
+					 const UINT numClassInstances)
+	{
+		if (SetShader(m_vs, shader, numClassInstances))
+		{
+			m_context->VSSetShader(shader, classInstances, numClassInstances);
+		}
+	}
+
+	void HSSetShader(ID3D11HullShader *shader, ID3D11ClassInstance *const *classInstances,
+					 const UINT numClassInstances)
+	{
+		if (SetShader(m_hs, shader, numClassInstances))
+		{
+			m_context->HSSetShader(shader, classInstances, numClassInstances);
+		}
+	}
+
+	void DSSetShader(ID3D11DomainShader *shader, ID3D11ClassInstance *const *classInstances,
+					 const UINT numClassInstances)
+	{
+		if (SetShader(m_ds, shader, numClassInstances))
+		{
+			m_context->DSSetShader(shader, classInstances, numClassInstances);
+		}
+	}
+
+	void GSSetShader(ID3D11GeometryShader *shader, ID3D11ClassInstance *const *classInstances,
+					 const UINT numClassInstances)
+	{
+		if (SetShader(m_gs, shader, numClassInstances))
+		{
+			m_context->GSSetShader(shader, classInstances, numClassInstances);
+		}
+	}
+
+	void PSSetShader(ID3D11PixelShader *shader, ID3D11ClassInstance *const *classInstances,
+					 const UINT numClassInstances)
+	{
+		if (SetShader(m_ps, shader, numClassInstances))
+		{
+			m_context->PSSetShader(shader, classInstances, numClassInstances);
+		}
+	}
+
+	void VSSetConstantBuffers(const UINT startSlot, const UINT numBuffers, ID3D11Buffer *const *buffers)
+	{
+		UINT first, count;
+		if (SetSlots(m_vs.constantBuffers, startSlot, numBuffers, buffers, first, count))
+		{
+			m_context->VSSetConstantBuffers(first, count, buffers + (first - startSlot));
+		}
+	}
+
+	void GSSetConstantBuffers(const UINT startSlot, const UINT numBuffers, ID3D11Buffer *const *buffers)
+	{
+		UINT first, count;
+		if (SetSlots(m_gs.constantBuffers, startSlot, numBuffers, buffers, first, count))
+		{
+			m_context->GSSetConstantBuffers(first, count, buffers + (first - startSlot));
+		}
+	}
+
+	void PSSetConstantBuffers(const UINT startSlot, const UINT numBuffers, ID3D11Buffer *const *buffers)
+	{
+		UINT first, count;
+		if (SetSlots(m_ps.constantBuffers, startSlot, numBuffers, buffers, first, count))
+		{
+			m_context->PSSetConstantBuffers(first, count, buffers + (first - startSlot));
+		}
+	}
+
+	void VSSetShaderResources(const UINT startSlot, const UINT numViews,
+							  ID3D11ShaderResourceView *const *views)
+	{
+		UINT first, count;
+		if (SetSlots(m_vs.shaderResources, startSlot, numViews, views, first, count))
+		{
+			m_context->VSSetShaderResources(first, count, views + (first - startSlot));
+		}
+	}
+
+	void GSSetShaderResources(const UINT startSlot, const UINT numViews,
+							  ID3D11ShaderResourceView *const *views)
+	{
+		UINT first, count;
+		if (SetSlots(m_gs.shaderResources, startSlot, numViews, views, first, count))
+		{
+			m_context->GSSetShaderResources(first, count, views + (first - startSlot));
+		}
+	}
+
+	void PSSetShaderResources(const UINT startSlot, const UINT numViews,
+							  ID3D11ShaderResourceView *const *views)
+	{
+		UINT first, count;
+		if (SetSlots(m_ps.shaderResources, startSlot, numViews, views, first, count))
+		{
+			m_context->PSSetShaderResources(first, count, views + (first - startSlot));
+		}
+	}
+
+	void VSSetSamplers(const UINT startSlot, const UINT numSamplers, ID3D11SamplerState *const *samplers)
+	{
+		UINT first, count;
+		if (SetSlots(m_vs.samplers, startSlot, numSamplers, samplers, first, count))
+		{
+			m_context->VSSetSamplers(first, count, samplers + (first - startSlot));
+		}
+	}
+
+	void PSSetSamplers(const UINT startSlot, const UINT numSamplers, ID3D11SamplerState *const *samplers)
+	{
+		UINT first, count;
+		if (SetSlots(m_ps.samplers, startSlot, numSamplers, samplers, first, count))
+		{
+			m_context->PSSetSamplers(first, count, samplers + (first - startSlot));
+		}
+	}
+
+	void RSSetState(ID3D11RasterizerState *rasterizerState)
+	{
+		if (SetValue(m_rasterizerState, rasterizerState))
+		{
+			m_context->RSSetState(rasterizerState);
+		}
+	}
+
+	void OMSetBlendState(ID3D11BlendState *blendState, const FLOAT blendFactor[4], const UINT sampleMask)
+	{
+		BlendState value = { blendState, { 1.0f, 1.0f, 1.0f, 1.0f }, sampleMask };
+		if (blendFactor)
+		{
+			memcpy(value.blendFactor, blendFactor, sizeof(value.blendFactor));
+		}
+
+		if (SetValue(m_blendState, value))
+		{
+			m_context->OMSetBlendState(blendState, blendFactor, sampleMask);
+		}
+	}
+
+	void OMSetDepthStencilState(ID3D11DepthStencilState *depthStencilState, const UINT stencilRef)
+	{
+		if (SetValue(m_depthStencilState, DepthStencilState{ depthStencilState, stencilRef }))
+		{
+			m_context->OMSetDepthStencilState(depthStencilState, stencilRef);
+		}
+	}
+
+	// Render Target은 기억하지 않고 항상 보냄 (같은 자원의 SRV가 풀릴 수 있으므로 SRV를 버림)
+	void OMSetRenderTargets(const UINT numViews, ID3D11RenderTargetView *const *renderTargetViews,
+							ID3D11DepthStencilView *depthStencilView)
+	{
+		for (Stage *stage : { &m_vs, &m_hs, &m_ds, &m_gs, &m_ps })
+		{
+			stage->shaderResources.known.reset();
+		}
+		m_context->OMSetRenderTargets(numViews, renderTargetViews, depthStencilView);
+	}
+
+	void DrawIndexed(const UINT indexCount, const UINT startIndexLocation, const INT baseVertexLocation)
+	{
+		m_context->DrawIndexed(indexCount, startIndexLocation, baseVertexLocation);
+	}
+
+private:
+	template <typename T>
+	struct Value {
+		T value;
+		bool known = false;
+	};
+
+	template <typename T, size_t N>
+	struct Slots {
+		T values[N];
+		std::bitset<N> known;
+	};
+
+	struct Stage {
+		Value<void *> shader;
+		Slots<ID3D11Buffer *, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT> constantBuffers;
+		Slots<ID3D11ShaderResourceView *, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT> shaderResources;
+		Slots<ID3D11SamplerState *, D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT> samplers;
+	};
+
+	struct VertexBuffer {
+		ID3D11Buffer *buffer;
+		UINT stride;
+		UINT offset;
+		bool operator==(const VertexBuffer &v) const
+		{
+			return buffer == v.buffer && stride == v.stride && offset == v.offset;
+		}
+	};
+
+	struct IndexBuffer {
+		ID3D11Buffer *buffer;
+		DXGI_FORMAT format;
+		UINT offset;
+		bool operator==(const IndexBuffer &v) const
+		{
+			return buffer == v.buffer && format == v.format && offset == v.offset;
+		}
+	};
+
+	struct BlendState {
+		ID3D11BlendState *state;
+		FLOAT blendFactor[4]; // nullptr이면 D3D11처럼 1
+		UINT sampleMask;
+		bool operator==(const BlendState &v) const
+		{
+			return state == v.state && sampleMask == v.sampleMask &&
+				   memcmp(blendFactor, v.blendFactor, sizeof(blendFactor)) == 0;
+		}
+	};
+
+	struct DepthStencilState {
+		ID3D11DepthStencilState *state;
+		UINT stencilRef;
+		bool operator==(const DepthStencilState &v) const
+		{
+			return state == v.state && stencilRef == v.stencilRef;
+		}
+	};
+
+	// 반환값: 보내야 하는지
+	template <typename T>
+	bool SetValue(Value<T> &cached, const T &value)
+	{
+		m_stats.calls++;
+		if (cached.known && cached.value == value)
+		{
+			m_stats.dropped++;
+			return false;
+		}
+		cached.value = value;
+		cached.known = true;
+		return true;
+	}
+
+	// Class Instance를 쓰면 비교하지 않고 보냄
+	bool SetShader(Stage &stage, void *shader, const UINT numClassInstances)
+	{
+		if (numClassInstances > 0)
+		{
+			m_stats.calls++;
+			stage.shader.known = false;
+			return true;
+		}
+		return SetValue(stage.shader, shader);
+	}
+
+	// [startSlot, startSlot + num) 중 바뀐 Slot들을 덮는 구간 [first, first + count)
+	// 반환값: 보내야 하는지
+	template <typename T, size_t N>
+	bool SetSlots(Slots<T, N> &cached, const UINT startSlot, const UINT num, const T *values, UINT &first,
+				  UINT &count)
+	{
+		m_stats.calls++;
+
+		UINT last = startSlot;
+		first = startSlot + num;
+		for (UINT i = 0; i < num && startSlot + i < N; i++)
+		{
+			const UINT slot = startSlot + i;
+			if (!cached.known[slot] || !(cached.values[slot] == values[i]))
+			{
+				first = std::min(first, slot);
+				last = slot + 1;
+				cached.values[slot] = values[i];
+				cached.known[slot] = true;
+			}
+		}
+
+		if (first >= last)
+		{
+			m_stats.dropped++;
+			return false;
+		}
+
+		count = last - first;
+		if (count < num)
+		{
+			m_stats.trimmed++;
+		}
+		return true;
+	}
+
+	Context *m_context = nullptr;
+	Stats m_stats;
+
+	Value<ID3D11InputLayout *> m_inputLayout;
+	Value<D3D11_PRIMITIVE_TOPOLOGY> m_topology;
+	Slots<VertexBuffer, D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT> m_vertexBuffers;
+	Value<IndexBuffer> m_indexBuffer;
+	Value<ID3D11RasterizerState *> m_rasterizerState;
+	Value<BlendState> m_blendState;
+	Value<DepthStencilState> m_depthStencilState;
+
+	Stage m_vs, m_hs, m_ds, m_gs, m_ps;
+};
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <atomic>
+
+// 불러오기/메모리 통계를 Console에 출력할지 (기본은 끔, 실행할 때 --stats로 켬)
+// Model 불러오기 Worker Thread에서도 읽으므로 atomic
+inline std::atomic<bool> g_printStats{ false };
@@ -0,0 +1,402 @@
+#include "TangentGenerator.h"
+#include "ThreadPool.h"
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+using namespace std;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	// 삼각형 하나의 결과 (Tangent는 정규화된 U 증가 방향, 퇴화된 삼각형은 0)
+	struct FaceTangent {
+		Vector3 tangent;
+		float sign;
+		float angles[3]; // 각 꼭짓점의 내각 (가중치)
+	};
+
+	// 이 크기보다 큰 Mesh만 안에서 블록 단위로 나눔
+	const size_t BLOCK_SIZE = 4096;
+
+	__m128 Dot3(const __m128 ax, const __m128 ay, const __m128 az,
+				const __m128 bx, const __m128 by, const __m128 bz)
+	{
+		return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+	}
+
+	__m128 Select(const __m128 mask, const __m128 a, const __m128 b)
+	{
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+
+	// acos 근사 (Abramowitz & Stegun 4.4.45, 최대 오차 약 7e-5 Radian)
+	__m128 Acos(__m128 x)
+	{
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+		x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+
+		const __m128 negative = _mm_cmplt_ps(x, _mm_setzero_ps());
+		const __m128 a = _mm_andnot_ps(signMask, x);
+
+		__m128 poly = _mm_set1_ps(-0.0187293f);
+		poly = _mm_add_ps(_mm_mul_ps(poly, a), _mm_set1_ps(0.0742610f));
+		poly = _mm_add_ps(_mm_mul_ps(poly, a), _mm_set1_ps(-0.2121144f));
+		poly = _mm_add_ps(_mm_mul_ps(poly, a), _mm_set1_ps(1.5707288f));
+		const __m128 result = _mm_mul_ps(poly, _mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), a)));
+
+		return Select(negative, _mm_sub_ps(_mm_set1_ps(XM_PI), result), result);
+	}
+
+	// 두 벡터 사이 각도, 길이가 0이면 0
+	__m128 Angle(const __m128 ax, const __m128 ay, const __m128 az,
+				 const __m128 bx, const __m128 by, const __m128 bz)
+	{
+		const __m128 lengthSq = _mm_mul_ps(Dot3(ax, ay, az, ax, ay, az), Dot3(bx, by, bz, bx, by, bz));
+		const __m128 valid = _mm_cmpgt_ps(lengthSq, _mm_set1_ps(1e-30f));
+		const __m128 cosine = _mm_div_ps(Dot3(ax, ay, az, bx, by, bz),
+										 _mm_sqrt_ps(_mm_max_ps(lengthSq, _mm_set1_ps(1e-30f))));
+		return _mm_and_ps(valid, Acos(cosine));
+	}
+
+	// 삼각형 4개씩 (SSE2), 남은 삼각형은 마지막 삼각형을 반복해서 채움
+	void ComputeFaceTangents(const Vertex *vertices, const uint32_t *indices, const size_t begin,
+							 const size_t end, FaceTangent *faces)
+	{
+		for (size_t f = begin; f < end; f += 4)
+		{
+			const Vertex *v[4][3];
+			for (size_t k = 0; k < 4; k++)
+			{
+				const size_t face = min(f + k, end - 1);
+				for (int c = 0; c < 3; c++)
+				{
+					v[k][c] = &vertices[indices[face * 3 + c]];
+				}
+			}
+
+#define GATHER(corner, member) _mm_setr_ps(v[0][corner]->member, v[1][corner]->member, \
+										   v[2][corner]->member, v[3][corner]->member)
+			const __m128 p0x = GATHER(0, position.x), p0y = GATHER(0, position.y), p0z = GATHER(0, position.z);
+			const __m128 d1x = _mm_sub_ps(GATHER(1, position.x), p0x);
+			const __m128 d1y = _mm_sub_ps(GATHER(1, position.y), p0y);
+			const __m128 d1z = _mm_sub_ps(GATHER(1, position.z), p0z);
+			const __m128 d2x = _mm_sub_ps(GATHER(2, position.x), p0x);
+			const __m128 d2y = _mm_sub_ps(GATHER(2, position.y), p0y);
+			const __m128 d2z = _mm_sub_ps(GATHER(2, position.z), p0z);
+
+			const __m128 t0x = GATHER(0, texcoord.x), t0y = GATHER(0, texcoord.y);
+			const __m128 t21x = _mm_sub_ps(GATHER(1, texcoord.x), t0x);
+			const __m128 t21y = _mm_sub_ps(GATHER(1, texcoord.y), t0y);
+			const __m128 t31x = _mm_sub_ps(GATHER(2, texcoord.x), t0x);
+			const __m128 t31y = _mm_sub_ps(GATHER(2, texcoord.y), t0y);
+#undef GATHER
+
+			// UV 면적의 부호가 방향 (음수면 UV가 뒤집힌 삼각형)
+			const __m128 area = _mm_sub_ps(_mm_mul_ps(t21x, t31y), _mm_mul_ps(t21y, t31x));
+
+			// U가 증가하는 방향 = (t31y * d1 - t21y * d2) / area, 길이는 정규화하므로 부호만 곱함
+			const __m128 osx = _mm_sub_ps(_mm_mul_ps(t31y, d1x), _mm_mul_ps(t21y, d2x));
+			const __m128 osy = _mm_sub_ps(_mm_mul_ps(t31y, d1y), _mm_mul_ps(t21y, d2y));
+			const __m128 osz = _mm_sub_ps(_mm_mul_ps(t31y, d1z), _mm_mul_ps(t21y, d2z));
+
+			const __m128 signMask = _mm_set1_ps(-0.0f);
+			const __m128 lengthSq = Dot3(osx, osy, osz, osx, osy, osz);
+			const __m128 valid = _mm_and_ps(_mm_cmpgt_ps(lengthSq, _mm_set1_ps(1e-30f)),
+											_mm_cmpgt_ps(_mm_andnot_ps(signMask, area), _mm_set1_ps(1e-20f)));
+			const __m128 sign = Select(_mm_cmplt_ps(area, _mm_setzero_ps()), _mm_set1_ps(-1.0f), _mm_set1_ps(1.0f));
+			const __m128 scale = _mm_and_ps(valid, _mm_div_ps(sign, _mm_sqrt_ps(_mm_max_ps(lengthSq, _mm_set1_ps(1e-30f)))));
+
+			// 꼭짓점별 내각
+			const __m128 e3x = _mm_sub_ps(d2x, d1x), e3y = _mm_sub_ps(d2y, d1y), e3z = _mm_sub_ps(d2z, d1z);
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 angle0 = Angle(d1x, d1y, d1z, d2x, d2y, d2z);
+			const __m128 angle1 = Angle(_mm_sub_ps(zero, d1x), _mm_sub_ps(zero, d1y), _mm_sub_ps(zero, d1z),
+										e3x, e3y, e3z);
+			const __m128 angle2 = Angle(d2x, d2y, d2z, e3x, e3y, e3z);
+
+			alignas(16) float tx[4], ty[4], tz[4], s[4], a0[4], a1[4], a2[4];
+			_mm_store_ps(tx, _mm_mul_ps(osx, scale));
+			_mm_store_ps(ty, _mm_mul_ps(osy, scale));
+			_mm_store_ps(tz, _mm_mul_ps(osz, scale));
+			_mm_store_ps(s, sign);
+			_mm_store_ps(a0, angle0);
+			_mm_store_ps(a1, angle1);
+			_mm_store_ps(a2, angle2);
+
+			for (size_t k = 0; k < 4 && f + k < end; k++)
+			{
+				FaceTangent& face = faces[f + k];
+				face.tangent = Vector3(tx[k], ty[k], tz[k]);
+				face.sign = s[k];
+				face.angles[0] = a0[k];
+				face.angles[1] = a1[k];
+				face.angles[2] = a2[k];
+			}
+		}
+	}
+
+	// 두 벡터 사이 각도 (Angle과 같은 조건), 길이가 0이면 0
+	float AngleScalar(const Vector3& a, const Vector3& b)
+	{
+		const float lengthSq = a.LengthSquared() * b.LengthSquared();
+		if (lengthSq <= 1e-30f)
+		{
+			return 0.0f;
+		}
+		return acos(clamp(a.Dot(b) / sqrt(lengthSq), -1.0f, 1.0f));
+	}
+
+	// ComputeFaceTangents와 같은 계산을 삼각형 하나씩 (acos는 근사하지 않음)
+	void ComputeFaceTangentsScalar(const Vertex *vertices, const uint32_t *indices, const size_t begin,
+								   const size_t end, FaceTangent *faces)
+	{
+		for (size_t f = begin; f < end; f++)
+		{
+			const Vertex& v0 = vertices[indices[f * 3]];
+			const Vertex& v1 = vertices[indices[f * 3 + 1]];
+			const Vertex& v2 = vertices[indices[f * 3 + 2]];
+
+			const Vector3 d1 = v1.position - v0.position;
+			const Vector3 d2 = v2.position - v0.position;
+			const Vector2 t21 = v1.texcoord - v0.texcoord;
+			const Vector2 t31 = v2.texcoord - v0.texcoord;
+
+			const float area = t21.x * t31.y - t21.y * t31.x;
+			const Vector3 os = d1 * t31.y - d2 * t21.y;
+			const float sign = (area < 0.0f) ? -1.0f : 1.0f;
+
+			FaceTangent& face = faces[f];
+			face.tangent = (os.LengthSquared() > 1e-30f && abs(area) > 1e-20f) ? os * (sign / os.Length()) : Vector3(0.0f);
+			face.sign = sign;
+			face.angles[0] = AngleScalar(d1, d2);
+			face.angles[1] = AngleScalar(-d1, d2 - d1);
+			face.angles[2] = AngleScalar(d2, d2 - d1);
+		}
+	}
+
+	// Normal에 수직인 아무 방향 (Tangent를 정할 수 없는 Vertex용)
+	Vector3 AnyPerpendicular(const Vector3& normal)
+	{
+		const Vector3 axis = (abs(normal.x) < 0.9f) ? Vector3(1.0f, 0.0f, 0.0f) : Vector3(0.0f, 1.0f, 0.0f);
+		Vector3 tangent = axis - normal * normal.Dot(axis);
+		tangent.Normalize();
+		return tangent;
+	}
+
+	// count가 크면 BLOCK_SIZE 단위로 나눠서 병렬 실행 (parallel이 false면 한 번에)
+	template <typename T_FUNC>
+	void ForEachBlock(const size_t count, const bool parallel, T_FUNC func)
+	{
+		const size_t numBlocks = (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+		if (numBlocks <= 1 || !parallel)
+		{
+			func(size_t(0), count);
+			return;
+		}
+
+		ThreadPool::GetInstance().ParallelFor(0, numBlocks, [&](size_t block) {
+			func(block * BLOCK_SIZE, min((block + 1) * BLOCK_SIZE, count));
+		});
+	}
+}
+
+void TangentGenerator::Compute(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+							   std::pmr::memory_resource* scratch)
+{
+	ComputeMesh(vertices, indices, scratch, false);
+}
+
+void TangentGenerator::ComputeScalar(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+	ComputeMesh(vertices, indices, pmr::get_default_resource(), true);
+}
+
+void TangentGenerator::ComputeMesh(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+								   std::pmr::memory_resource* scratch, const bool scalar)
+{
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0)
+	{
+		return;
+	}
+
+	// 1. 삼각형별 Tangent, 방향, 내각
+	pmr::vector<FaceTangent> faces(triangleCount, scratch);
+	ForEachBlock(triangleCount, !scalar, [&](size_t begin, size_t end) {
+		if (scalar)
+		{
+			ComputeFaceTangentsScalar(vertices.data(), indices.data(), begin, end, faces.data());
+		}
+		else
+		{
+			ComputeFaceTangents(vertices.data(), indices.data(), begin, end, faces.data());
+		}
+	});
+
+	// 2. 방향이 다른 삼각형들이 같이 쓰는 Vertex는 복제해서 뒤집힌 쪽 삼각형에 연결
+	const size_t originalVertexCount = vertices.size();
+	pmr::vector<uint8_t> orientations(originalVertexCount, 0, scratch); // 1: 정방향, 2: 뒤집힘
+	for (size_t f = 0; f < triangleCount; f++)
+	{
+		const uint8_t flag = (faces[f].sign > 0.0f) ? 1 : 2;
+		for (int c = 0; c < 3; c++)
+		{
+			orientations[indices[f * 3 + c]] |= flag;
+		}
+	}
+
+	pmr::vector<uint32_t> mirrored(originalVertexCount, UINT32_MAX, scratch);
+	for (size_t i = 0; i < originalVertexCount; i++)
+	{
+		if (orientations[i] == 3)
+		{
+			mirrored[i] = uint32_t(vertices.size());
+			vertices.push_back(vertices[i]);
+		}
+	}
+
+	if (vertices.size() > originalVertexCount)
+	{
+		for (size_t f = 0; f < triangleCount; f++)
+		{
+			if (faces[f].sign < 0.0f)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					uint32_t& index = indices[f * 3 + c];
+					if (mirrored[index] != UINT32_MAX)
+					{
+						index = mirrored[index];
+					}
+				}
+			}
+		}
+	}
+
+	// 3. Vertex -> 삼각형 꼭짓점 목록 (CSR)
+	const size_t vertexCount = vertices.size();
+	pmr::vector<uint32_t> cornerOffsets(vertexCount + 1, 0, scratch);
+	for (const uint32_t index : indices)
+	{
+		cornerOffsets[index + 1]++;
+	}
+	for (size_t i = 0; i < vertexCount; i++)
+	{
+		cornerOffsets[i + 1] += cornerOffsets[i];
+	}
+
+	pmr::vector<uint32_t> corners(indices.size(), scratch);
+	pmr::vector<uint32_t> cursor(cornerOffsets.begin(), cornerOffsets.end() - 1, scratch);
+	for (size_t i = 0; i < triangleCount * 3; i++)
+	{
+		corners[cursor[indices[i]]++] = uint32_t(i);
+	}
+
+	// 4. 내각 가중 평균 후 Normal에 직교화 (Vertex마다 독립이라 블록 병렬)
+	ForEachBlock(vertexCount, !scalar, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++)
+		{
+			Vertex& v = vertices[i];
+
+			Vector3 sum(0.0f);
+			float sign = 1.0f;
+			for (uint32_t c = cornerOffsets[i]; c < cornerOffsets[i + 1]; c++)
+			{
+				const FaceTangent& face = faces[corners[c] / 3];
+				sum += face.tangent * face.angles[corners[c] % 3];
+				sign = face.sign;
+			}
+
+			Vector3 tangent = sum - v.normalModel * v.normalModel.Dot(sum);
+
+			if (tangent.LengthSquared() > 1e-20f)
+			{
+				tangent.Normalize();
+			}
+			else
+			{
+				tangent = AnyPerpendicular(v.normalModel);
+			}
+
+			v.tangentModel = Vector4(tangent.x, tangent.y, tangent.z, sign);
+		}
+	});
+}
+
+void TangentGenerator::Compute(std::vector<MeshData>& meshes, std::pmr::memory_resource* scratch)
+{
+	size_t maxBytes = 0;
+	for (const MeshData& mesh : meshes)
+	{
+		maxBytes = max(maxBytes, GetScratchBytes(mesh.vertices.size(), mesh.indices.size()));
+	}
+	if (maxBytes == 0)
+	{
+		return;
+	}
+
+	// 동시에 처리되는 Mesh는 Worker 수 + 호출한 스레드를 넘지 않으므로 가장 큰 Mesh 크기의 구간을 그만큼만 할당
+	// Mesh는 빈 구간을 하나 가져가서 쓰고 돌려줌
+	ThreadPool& pool = ThreadPool::GetInstance();
+	const size_t slotCount = min(meshes.size(), pool.GetThreadCount() + 1);
+	const size_t slotBytes = (maxBytes + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1);
+
+	pmr::monotonic_buffer_resource arena(slotBytes * slotCount, scratch);
+	uint8_t* buffer = static_cast<uint8_t*>(arena.allocate(slotBytes * slotCount, alignof(max_align_t)));
+
+	mutex slotMutex;
+	vector<size_t> freeSlots(slotCount);
+	for (size_t i = 0; i < slotCount; i++)
+	{
+		freeSlots[i] = i;
+	}
+
+	pool.ParallelFor(0, meshes.size(), [&](size_t i) {
+		size_t slot = SIZE_MAX;
+		{
+			lock_guard<mutex> lock(slotMutex);
+			if (!freeSlots.empty())
+			{
+				slot = freeSlots.back();
+				freeSlots.pop_back();
+			}
+		}
+
+		// 다른 곳에서도 같은 Pool로 ParallelFor를 호출하면 구간이 모자랄 수 있음 => scratch에서 따로 할당
+		if (slot == SIZE_MAX)
+		{
+			Compute(meshes[i].vertices, meshes[i].indices, scratch);
+			return;
+		}
+
+		// 구간이 부족하면 추가 할당 대신 bad_alloc (GetScratchBytes()가 틀렸다는 뜻)
+		{
+			pmr::monotonic_buffer_resource meshArena(buffer + slot * slotBytes, slotBytes, pmr::null_memory_resource());
+			Compute(meshes[i].vertices, meshes[i].indices, &meshArena);
+		}
+
+		lock_guard<mutex> lock(slotMutex);
+		freeSlots.push_back(slot);
+	});
+}
+
+size_t TangentGenerator::GetScratchBytes(const size_t vertexCount, const size_t indexCount)
+{
+	const size_t triangleCount = indexCount / 3;
+	if (triangleCount == 0)
+	{
+		return 0;
+	}
+
+	// faces, orientations, mirrored + 복제 후 최대 2배인 cornerOffsets, corners, cursor
+	const size_t maxVertexCount = vertexCount * 2;
+	return sizeof(FaceTangent) * triangleCount + sizeof(uint8_t) * vertexCount + sizeof(uint32_t) * vertexCount +
+		   sizeof(uint32_t) * (maxVertexCount + 1) + sizeof(uint32_t) * indexCount +
+		   sizeof(uint32_t) * maxVertexCount + alignof(max_align_t) * 6;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "MeshData.h"
+#include "Vertex.h"
+
+// Normal과 Texcoord로 Vertex의 tangentModel을 계산 (MikkTSpace와 같은 규칙)
+// - 삼각형마다 UV 방향의 Tangent와 방향(UV 면적의 부호)을 구하고 Vertex에서 각도 가중 평균
+// - tangentModel.w는 Bitangent 부호: B = cross(N, T) * w
+// - 거울 UV처럼 방향이 다른 삼각형들이 Vertex를 공유하면 Vertex를 복제해서 나눔
+class TangentGenerator {
+public:
+	// vertices 뒤에 복제된 Vertex가 추가될 수 있음 (indices도 같이 수정)
+	static void Compute(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices,
+						std::pmr::memory_resource *scratch = std::pmr::get_default_resource());
+
+	// Mesh 단위로 병렬, 큰 Mesh는 안에서 삼각형/Vertex 블록 단위로도 병렬
+	// 임시 버퍼는 scratch에서 한 번만 할당 (가장 큰 Mesh 크기 x 동시에 처리하는 Mesh 수)
+	static void Compute(std::vector<MeshData> &meshes,
+						std::pmr::memory_resource *scratch = std::pmr::get_default_resource());
+
+	// 삼각형 Tangent와 내각을 Scalar(std::acos)로 계산하고 스레드를 쓰지 않는 구현
+	// tests/TestTangentGenerator에서 SSE2 결과(acos 근사)와 비교할 때만 사용
+	static void ComputeScalar(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices);
+
+	// Compute() 하나가 scratch에서 할당하는 최대 크기 (Vertex가 모두 복제되는 경우, 정렬 여유 포함)
+	static size_t GetScratchBytes(const size_t vertexCount, const size_t indexCount);
+
+private:
+	// scalar면 삼각형 단계를 ComputeFaceTangentsScalar로 하고 블록 병렬도 하지 않음 (나머지 단계는 같음)
+	static void ComputeMesh(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices,
+							std::pmr::memory_resource *scratch, const bool scalar);
+};
@@ -0,0 +1,973 @@
+#include "TextureBaker.h"
+#include "MappedFile.h"
+#include "PixelConverter.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+#include <unordered_map>
+
+using namespace std;
+
+namespace {
+	// DDS 파일 구조 (ddraw.h / dds.h 없이 Linux에서도 쓰도록 직접 정의)
+	const uint32_t DDS_MAGIC = 0x20534444; // "DDS "
+	const uint32_t DDS_FOURCC_DX10 = 0x30315844; // "DX10"
+	const uint32_t DDPF_FOURCC = 0x4;
+	const uint32_t DDSD_CAPS = 0x1;
+	const uint32_t DDSD_HEIGHT = 0x2;
+	const uint32_t DDSD_WIDTH = 0x4;
+	const uint32_t DDSD_PITCH = 0x8;
+	const uint32_t DDSD_PIXELFORMAT = 0x1000;
+	const uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+	const uint32_t DDSD_LINEARSIZE = 0x80000;
+	const uint32_t DDSCAPS_COMPLEX = 0x8;
+	const uint32_t DDSCAPS_TEXTURE = 0x1000;
+	const uint32_t DDSCAPS_MIPMAP = 0x400000;
+	const uint32_t DDS_DIMENSION_TEXTURE2D = 3;
+	const uint32_t DDS_MISC_TEXTURECUBE = 0x4;
+
+	struct DDSPixelFormat {
+		uint32_t size;
+		uint32_t flags;
+		uint32_t fourCC;
+		uint32_t rgbBitCount;
+		uint32_t rBitMask;
+		uint32_t gBitMask;
+		uint32_t bBitMask;
+		uint32_t aBitMask;
+	};
+
+	struct DDSHeader {
+		uint32_t size;
+		uint32_t flags;
+		uint32_t height;
+		uint32_t width;
+		uint32_t pitchOrLinearSize;
+		uint32_t depth;
+		uint32_t mipMapCount;
+		uint32_t reserved1[11];
+		DDSPixelFormat pixelFormat;
+		uint32_t caps;
+		uint32_t caps2;
+		uint32_t caps3;
+		uint32_t caps4;
+		uint32_t reserved2;
+	};
+
+	struct DDSHeaderDX10 {
+		uint32_t dxgiFormat;
+		uint32_t resourceDimension;
+		uint32_t miscFlag;
+		uint32_t arraySize;
+		uint32_t miscFlags2;
+	};
+
+	static_assert(sizeof(DDSHeader) == 124, "DDS header size");
+	static_assert(sizeof(DDSHeaderDX10) == 20, "DDS DX10 header size");
+
+	const size_t ddsDataOffset = sizeof(uint32_t) + sizeof(DDSHeader) + sizeof(DDSHeaderDX10);
+
+	bool IsSRGBRole(const TextureRole role)
+	{
+		return role == TextureRole::Albedo || role == TextureRole::Emissive;
+	}
+
+	int CountMipLevels(const int width, const int height)
+	{
+		int levels = 1;
+		for (int size = max(width, height); size > 1; size /= 2)
+		{
+			levels++;
+		}
+		return levels;
+	}
+
+	// Box Filter의 한 방향 가중치
+	// 홀수 크기(예: 5 -> 2)도 원본 texel이 모두 같은 비율로 들어가도록 겹치는 길이로 계산
+	struct FilterTap {
+		int index;
+		float weight;
+	};
+
+	vector<vector<FilterTap>> MakeFilterTaps(const int srcSize, const int dstSize)
+	{
+		vector<vector<FilterTap>> taps(dstSize);
+		const float scale = float(srcSize) / float(dstSize);
+
+		for (int i = 0; i < dstSize; i++)
+		{
+			const float begin = i * scale;
+			const float end = (i + 1) * scale;
+			for (int s = int(begin); s < srcSize && float(s) < end; s++)
+			{
+				const float overlap = min(end, float(s + 1)) - max(begin, float(s));
+				if (overlap > 1e-6f)
+				{
+					taps[i].push_back({ s, overlap / scale });
+				}
+			}
+		}
+
+		return taps;
+	}
+
+	// RGBA8 -> Linear float (Alpha는 항상 Linear)
+	void ToLinear(const uint8_t* src, const size_t pixelCount, const bool useSRGB, float* dst)
+	{
+		if (useSRGB)
+		{
+			PixelConverter::SRGBToLinear(src, pixelCount * 4, dst);
+			for (size_t i = 0; i < pixelCount; i++)
+			{
+				dst[i * 4 + 3] = src[i * 4 + 3] / 255.0f;
+			}
+		}
+		else
+		{
+			for (size_t i = 0; i < pixelCount * 4; i++)
+			{
+				dst[i] = src[i] / 255.0f;
+			}
+		}
+	}
+
+	uint8_t ToUNorm8(const float value)
+	{
+		return uint8_t(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+	}
+
+	void FromLinear(const float* src, const size_t pixelCount, const bool useSRGB, uint8_t* dst)
+	{
+		if (useSRGB)
+		{
+			PixelConverter::LinearToSRGB(src, pixelCount * 4, dst);
+			for (size_t i = 0; i < pixelCount; i++)
+			{
+				dst[i * 4 + 3] = ToUNorm8(src[i * 4 + 3]);
+			}
+		}
+		else
+		{
+			for (size_t i = 0; i < pixelCount * 4; i++)
+			{
+				dst[i] = ToUNorm8(src[i]);
+			}
+		}
+	}
+
+	// 4x4 Block을 RGBA8 16개로 가져옴 (작은 Mip에서 범위를 넘는 texel은 가장자리를 반복)
+	void FetchBlock(const uint8_t* src, const int width, const int height, const int blockX,
+					const int blockY, uint8_t block[64])
+	{
+		for (int y = 0; y < 4; y++)
+		{
+			const int sy = min(blockY * 4 + y, height - 1);
+			for (int x = 0; x < 4; x++)
+			{
+				const int sx = min(blockX * 4 + x, width - 1);
+				memcpy(&block[(y * 4 + x) * 4], &src[(size_t(sy) * width + sx) * 4], 4);
+			}
+		}
+	}
+
+	// Block 안 색들의 평균과 주축 (Covariance에 Power Iteration)
+	void FindPrincipalAxis(const uint8_t block[64], const int dims, float mean[4], float axis[4])
+	{
+		for (int c = 0; c < dims; c++)
+		{
+			mean[c] = 0.0f;
+			for (int i = 0; i < 16; i++)
+			{
+				mean[c] += block[i * 4 + c];
+			}
+			mean[c] /= 16.0f;
+		}
+
+		float cov[4][4] = {};
+		for (int i = 0; i < 16; i++)
+		{
+			for (int a = 0; a < dims; a++)
+			{
+				for (int b = a; b < dims; b++)
+				{
+					cov[a][b] += (block[i * 4 + a] - mean[a]) * (block[i * 4 + b] - mean[b]);
+				}
+			}
+		}
+		for (int a = 0; a < dims; a++)
+		{
+			for (int b = 0; b < a; b++)
+			{
+				cov[a][b] = cov[b][a];
+			}
+		}
+
+		for (int c = 0; c < dims; c++)
+		{
+			axis[c] = 1.0f;
+		}
+
+		for (int iter = 0; iter < 8; iter++)
+		{
+			float next[4] = {};
+			float length = 0.0f;
+			for (int a = 0; a < dims; a++)
+			{
+				for (int b = 0; b < dims; b++)
+				{
+					next[a] += cov[a][b] * axis[b];
+				}
+				length += next[a] * next[a];
+			}
+
+			// 모든 색이 같으면 축이 없음
+			if (length < 1e-12f)
+			{
+				break;
+			}
+
+			length = sqrt(length);
+			for (int c = 0; c < dims; c++)
+			{
+				axis[c] = next[c] / length;
+			}
+		}
+	}
+
+	// 주축 위에서 가장 먼 두 점 (0 ~ 255로 제한)
+	void FindEndpoints(const uint8_t block[64], const int dims, float lo[4], float hi[4])
+	{
+		float mean[4], axis[4];
+		FindPrincipalAxis(block, dims, mean, axis);
+
+		float tMin = FLT_MAX, tMax = -FLT_MAX;
+		for (int i = 0; i < 16; i++)
+		{
+			float t = 0.0f;
+			for (int c = 0; c < dims; c++)
+			{
+				t += (block[i * 4 + c] - mean[c]) * axis[c];
+			}
+			tMin = min(tMin, t);
+			tMax = max(tMax, t);
+		}
+
+		for (int c = 0; c < dims; c++)
+		{
+			lo[c] = std::clamp(mean[c] + axis[c] * tMin, 0.0f, 255.0f);
+			hi[c] = std::clamp(mean[c] + axis[c] * tMax, 0.0f, 255.0f);
+		}
+	}
+
+	// index마다 정해진 endpoint 비율(weights[i]는 e0의 비율)로 두 endpoint를 최소제곱 근사
+	bool RefitEndpoints(const uint8_t block[64], const int dims, const uint8_t indices[16],
+						const float* weights, float e0[4], float e1[4])
+	{
+		float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+		float ax[4] = {}, bx[4] = {};
+		for (int i = 0; i < 16; i++)
+		{
+			const float a = weights[indices[i]];
+			const float b = 1.0f - a;
+			aa += a * a;
+			ab += a * b;
+			bb += b * b;
+			for (int c = 0; c < dims; c++)
+			{
+				ax[c] += a * block[i * 4 + c];
+				bx[c] += b * block[i * 4 + c];
+			}
+		}
+
+		const float det = aa * bb - ab * ab;
+		if (fabs(det) < 1e-6f)
+		{
+			return false;
+		}
+
+		for (int c = 0; c < dims; c++)
+		{
+			e0[c] = std::clamp((ax[c] * bb - bx[c] * ab) / det, 0.0f, 255.0f);
+			e1[c] = std::clamp((bx[c] * aa - ax[c] * ab) / det, 0.0f, 255.0f);
+		}
+
+		return true;
+	}
+
+	// ---- BC1: RGB 565 endpoint 2개 + 2-bit index ----
+
+	uint16_t ToRGB565(const float color[4])
+	{
+		const int r = int(color[0] * 31.0f / 255.0f + 0.5f);
+		const int g = int(color[1] * 63.0f / 255.0f + 0.5f);
+		const int b = int(color[2] * 31.0f / 255.0f + 0.5f);
+		return uint16_t((r << 11) | (g << 5) | b);
+	}
+
+	void FromRGB565(const uint16_t value, int color[3])
+	{
+		const int r = value >> 11;
+		const int g = (value >> 5) & 63;
+		const int b = value & 31;
+		color[0] = (r << 3) | (r >> 2);
+		color[1] = (g << 2) | (g >> 4);
+		color[2] = (b << 3) | (b >> 2);
+	}
+
+	// c0 > c1이면 4색 모드, 같으면 모두 index 0
+	int FindIndicesBC1(const uint8_t block[64], uint16_t& c0, uint16_t& c1, uint8_t indices[16])
+	{
+		if (c0 < c1)
+		{
+			swap(c0, c1);
+		}
+
+		int palette[4][3];
+		FromRGB565(c0, palette[0]);
+		FromRGB565(c1, palette[1]);
+		for (int c = 0; c < 3; c++)
+		{
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+		const int paletteSize = c0 == c1 ? 1 : 4;
+
+		int totalError = 0;
+		for (int i = 0; i < 16; i++)
+		{
+			int bestError = INT_MAX;
+			for (int p = 0; p < paletteSize; p++)
+			{
+				int error = 0;
+				for (int c = 0; c < 3; c++)
+				{
+					const int d = block[i * 4 + c] - palette[p][c];
+					error += d * d;
+				}
+				if (error < bestError)
+				{
+					bestError = error;
+					indices[i] = uint8_t(p);
+				}
+			}
+			totalError += bestError;
+		}
+
+		return totalError;
+	}
+
+	void EncodeBC1(const uint8_t block[64], uint8_t* out)
+	{
+		float lo[4], hi[4];
+		FindEndpoints(block, 3, lo, hi);
+
+		uint16_t c0 = ToRGB565(hi), c1 = ToRGB565(lo);
+		uint8_t indices[16];
+		int error = FindIndicesBC1(block, c0, c1, indices);
+
+		// index를 고정하고 endpoint를 다시 맞춰서 오차가 줄면 사용
+		const float weights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+		float e0[4], e1[4];
+		if (error > 0 && c0 != c1 && RefitEndpoints(block, 3, indices, weights, e0, e1))
+		{
+			uint16_t r0 = ToRGB565(e0), r1 = ToRGB565(e1);
+			uint8_t refitIndices[16];
+			const int refitError = FindIndicesBC1(block, r0, r1, refitIndices);
+			if (refitError < error)
+			{
+				c0 = r0;
+				c1 = r1;
+				memcpy(indices, refitIndices, 16);
+			}
+		}
+
+		uint32_t bits = 0;
+		for (int i = 0; i < 16; i++)
+		{
+			bits |= uint32_t(indices[i]) << (i * 2);
+		}
+
+		memcpy(out, &c0, 2);
+		memcpy(out + 2, &c1, 2);
+		memcpy(out + 4, &bits, 4);
+	}
+
+	// ---- BC4: 8-bit endpoint 2개 + 3-bit index (한 채널) ----
+
+	void EncodeBC4(const uint8_t block[64], const int channel, uint8_t* out)
+	{
+		int lo = 255, hi = 0;
+		for (int i = 0; i < 16; i++)
+		{
+			lo = min(lo, int(block[i * 4 + channel]));
+			hi = max(hi, int(block[i * 4 + channel]));
+		}
+
+		out[0] = uint8_t(hi);
+		out[1] = uint8_t(lo);
+
+		uint64_t bits = 0;
+		if (hi > lo) // 8단계 모드 (값이 모두 같으면 index 0)
+		{
+			int palette[8];
+			palette[0] = hi;
+			palette[1] = lo;
+			for (int p = 2; p < 8; p++)
+			{
+				palette[p] = ((8 - p) * hi + (p - 1) * lo) / 7;
+			}
+
+			for (int i = 0; i < 16; i++)
+			{
+				const int value = block[i * 4 + channel];
+				int best = 0;
+				for (int p = 1; p < 8; p++)
+				{
+					if (abs(value - palette[p]) < abs(value - palette[best]))
+					{
+						best = p;
+					}
+				}
+				bits |= uint64_t(best) << (i * 3);
+			}
+		}
+
+		for (int i = 0; i < 6; i++)
+		{
+			out[2 + i] = uint8_t(bits >> (i * 8));
+		}
+	}
+
+	// ---- BC7: Mode 6만 사용 (Subset 1개, RGBA 7-bit + p-bit endpoint, 4-bit index) ----
+
+	const int bc7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	struct BC7Endpoints {
+		int q0[4];
+		int q1[4];
+		int p0;
+		int p1;
+	};
+
+	void QuantizeBC7(const float value[4], const int pBit, int q[4])
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			q[c] = std::clamp(int((value[c] - pBit) / 2.0f + 0.5f), 0, 127);
+		}
+	}
+
+	int FindIndicesBC7(const uint8_t block[64], const BC7Endpoints& endpoints, uint8_t indices[16])
+	{
+		int e0[4], e1[4];
+		for (int c = 0; c < 4; c++)
+		{
+			e0[c] = (endpoints.q0[c] << 1) | endpoints.p0;
+			e1[c] = (endpoints.q1[c] << 1) | endpoints.p1;
+		}
+
+		int palette[16][4];
+		for (int p = 0; p < 16; p++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				palette[p][c] = ((64 - bc7Weights[p]) * e0[c] + bc7Weights[p] * e1[c] + 32) >> 6;
+			}
+		}
+
+		int totalError = 0;
+		for (int i = 0; i < 16; i++)
+		{
+			int bestError = INT_MAX;
+			for (int p = 0; p < 16; p++)
+			{
+				int error = 0;
+				for (int c = 0; c < 4; c++)
+				{
+					const int d = block[i * 4 + c] - palette[p][c];
+					error += d * d;
+				}
+				if (error < bestError)
+				{
+					bestError = error;
+					indices[i] = uint8_t(p);
+				}
+			}
+			totalError += bestError;
+		}
+
+		return totalError;
+	}
+
+	// p-bit 4가지 조합 중 오차가 가장 작은 것
+	int QuantizeBestBC7(const uint8_t block[64], const float e0[4], const float e1[4],
+						BC7Endpoints& best, uint8_t indices[16])
+	{
+		int bestError = INT_MAX;
+		for (int p0 = 0; p0 < 2; p0++)
+		{
+			for (int p1 = 0; p1 < 2; p1++)
+			{
+				BC7Endpoints endpoints;
+				endpoints.p0 = p0;
+				endpoints.p1 = p1;
+				QuantizeBC7(e0, p0, endpoints.q0);
+				QuantizeBC7(e1, p1, endpoints.q1);
+
+				uint8_t candidate[16];
+				const int error = FindIndicesBC7(block, endpoints, candidate);
+				if (error < bestError)
+				{
+					bestError = error;
+					best = endpoints;
+					memcpy(indices, candidate, 16);
+				}
+			}
+		}
+		return bestError;
+	}
+
+	struct BitWriter {
+		uint8_t* out;
+		int position = 0;
+
+		void Write(const uint32_t value, const int bitCount)
+		{
+			for (int b = 0; b < bitCount; b++, position++)
+			{
+				if ((value >> b) & 1)
+				{
+					out[position >> 3] |= uint8_t(1 << (position & 7));
+				}
+			}
+		}
+	};
+
+	void EncodeBC7(const uint8_t block[64], uint8_t* out)
+	{
+		float lo[4], hi[4];
+		FindEndpoints(block, 4, lo, hi);
+
+		BC7Endpoints endpoints;
+		uint8_t indices[16];
+		int error = QuantizeBestBC7(block, lo, hi, endpoints, indices);
+
+		float weights[16];
+		for (int p = 0; p < 16; p++)
+		{
+			weights[p] = (64 - bc7Weights[p]) / 64.0f;
+		}
+
+		float e0[4], e1[4];
+		if (error > 0 && RefitEndpoints(block, 4, indices, weights, e0, e1))
+		{
+			BC7Endpoints refit;
+			uint8_t refitIndices[16];
+			if (QuantizeBestBC7(block, e0, e1, refit, refitIndices) < error)
+			{
+				endpoints = refit;
+				memcpy(indices, refitIndices, 16);
+			}
+		}
+
+		// 첫 index의 최상위 bit는 저장하지 않으므로 0이 되도록 endpoint를 바꿈
+		if (indices[0] & 8)
+		{
+			swap(endpoints.q0, endpoints.q1);
+			swap(endpoints.p0, endpoints.p1);
+			for (int i = 0; i < 16; i++)
+			{
+				indices[i] = uint8_t(15 - indices[i]);
+			}
+		}
+
+		memset(out, 0, 16);
+		BitWriter writer{ out };
+		writer.Write(1 << 6, 7); // Mode 6
+		for (int c = 0; c < 4; c++)
+		{
+			writer.Write(endpoints.q0[c], 7);
+			writer.Write(endpoints.q1[c], 7);
+		}
+		writer.Write(endpoints.p0, 1);
+		writer.Write(endpoints.p1, 1);
+		writer.Write(indices[0], 3);
+		for (int i = 1; i < 16; i++)
+		{
+			writer.Write(indices[i], 4);
+		}
+	}
+}
+
+DXGI_FORMAT TextureBaker::GetBakedFormat(const TextureRole role, const int width, const int height)
+{
+	const bool canCompress = width % 4 == 0 && height % 4 == 0;
+
+	switch (role)
+	{
+	case TextureRole::Albedo:
+		return canCompress ? DXGI_FORMAT_BC7_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+	case TextureRole::Emissive:
+		return canCompress ? DXGI_FORMAT_BC1_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+	case TextureRole::Normal:
+		return canCompress ? DXGI_FORMAT_BC5_UNORM : DXGI_FORMAT_R8G8B8A8_UNORM;
+	case TextureRole::ORM:
+		return canCompress ? DXGI_FORMAT_BC7_UNORM : DXGI_FORMAT_R8G8B8A8_UNORM;
+	default:
+		return canCompress ? DXGI_FORMAT_BC4_UNORM : DXGI_FORMAT_R8G8B8A8_UNORM;
+	}
+}
+
+std::string TextureBaker::GetBakedPath(const std::string& fileName)
+{
+	return fileName + ".dds";
+}
+
+bool TextureBaker::IsUpToDate(const std::string& fileName)
+{
+	error_code ec;
+	const auto bakedTime = filesystem::last_write_time(GetBakedPath(fileName), ec);
+	if (ec)
+	{
+		return false;
+	}
+
+	// 원본 없이 .dds만 배포한 경우도 사용
+	const auto sourceTime = filesystem::last_write_time(fileName, ec);
+	return ec || bakedTime >= sourceTime;
+}
+
+bool TextureBaker::ReadBaked(const std::string& fileName, const bool useSRGB, ImageData& image)
+{
+	if (!IsUpToDate(fileName))
+	{
+		return false;
+	}
+
+	// 다른 용도로 Bake한 것(sRGB 여부가 다름)은 사용하지 않음
+	ImageData baked;
+	if (!ReadDDS(GetBakedPath(fileName), baked) || ImageData::IsSRGB(baked.format) != useSRGB)
+	{
+		return false;
+	}
+
+	image = std::move(baked);
+	return true;
+}
+
+bool TextureBaker::Bake(const std::string& fileName, const TextureRole role, ImageData& image)
+{
+	ImageData source;
+	ImageLoader::ReadSourceImage(fileName, IsSRGBRole(role), source);
+	if (source.IsEmpty())
+	{
+		return false;
+	}
+
+	if (source.format != DXGI_FORMAT_R8G8B8A8_UNORM && source.format != DXGI_FORMAT_R8G8B8A8_UNORM_SRGB)
+	{
+		cout << "Cannot bake " << fileName << " (only 8-bit images)" << endl;
+		return false;
+	}
+
+	GenerateMips(source, role);
+
+	const DXGI_FORMAT format = GetBakedFormat(role, source.width, source.height);
+	if (ImageData::IsBlockCompressed(format))
+	{
+		Compress(source, format, image);
+	}
+	else
+	{
+		image = std::move(source);
+	}
+
+	return true;
+}
+
+bool TextureBaker::BakeFile(const std::string& fileName, const TextureRole role, const bool force)
+{
+	if (!force && IsUpToDate(fileName))
+	{
+		return false;
+	}
+
+	ImageData image;
+	if (!Bake(fileName, role, image))
+	{
+		return false;
+	}
+
+	return WriteDDS(GetBakedPath(fileName), image);
+}
+
+size_t TextureBaker::BakeFiles(const std::vector<BakeItem>& items, const bool force)
+{
+	// 여러 Mesh가 같은 파일을 쓰는 경우가 많음 (처음 나온 용도로 Bake)
+	vector<BakeItem> uniqueItems;
+	unordered_map<string, TextureRole> roles;
+	for (const BakeItem& item : items)
+	{
+		auto inserted = roles.emplace(item.fileName, item.role);
+		if (inserted.second)
+		{
+			uniqueItems.push_back(item);
+		}
+		else if (inserted.first->second != item.role)
+		{
+			cout << item.fileName << " is used for different roles, baking the first one." << endl;
+		}
+	}
+
+	// 파일 단위로 병렬, 안에서도 Mip/Block 줄 단위로 병렬
+	atomic<size_t> bakedCount(0);
+	ThreadPool::GetInstance().ParallelFor(0, uniqueItems.size(), [&](size_t i) {
+		if (BakeFile(uniqueItems[i].fileName, uniqueItems[i].role, force))
+		{
+			bakedCount++;
+		}
+	});
+
+	return bakedCount;
+}
+
+void TextureBaker::GenerateMips(ImageData& image, const TextureRole role)
+{
+	const bool useSRGB = IsSRGBRole(role);
+	const bool isNormal = role == TextureRole::Normal;
+
+	image.mipLevels = CountMipLevels(image.width, image.height);
+	image.pixels.resize(image.GetMipOffset(image.mipLevels));
+
+	// 8-bit로 줄이면서 오차가 쌓이지 않도록 바로 위 Mip의 float 값에서 만듦
+	vector<float> current(size_t(image.width) * image.height * 4);
+	ToLinear(image.pixels.data(), size_t(image.width) * image.height, useSRGB, current.data());
+
+	ThreadPool& pool = ThreadPool::GetInstance();
+	for (int mip = 1; mip < image.mipLevels; mip++)
+	{
+		const int srcWidth = image.GetMipWidth(mip - 1);
+		const int srcHeight = image.GetMipHeight(mip - 1);
+		const int dstWidth = image.GetMipWidth(mip);
+		const int dstHeight = image.GetMipHeight(mip);
+
+		const vector<vector<FilterTap>> tapsX = MakeFilterTaps(srcWidth, dstWidth);
+		const vector<vector<FilterTap>> tapsY = MakeFilterTaps(srcHeight, dstHeight);
+
+		vector<float> next(size_t(dstWidth) * dstHeight * 4);
+		uint8_t* dst = image.pixels.data() + image.GetMipOffset(mip);
+
+		pool.ParallelFor(0, dstHeight, [&](size_t y) {
+			float* row = &next[y * dstWidth * 4];
+			for (int x = 0; x < dstWidth; x++)
+			{
+				float sum[4] = {};
+				for (const FilterTap& ty : tapsY[y])
+				{
+					for (const FilterTap& tx : tapsX[x])
+					{
+						const float* texel = &current[(size_t(ty.index) * srcWidth + tx.index) * 4];
+						const float weight = ty.weight * tx.weight;
+						for (int c = 0; c < 4; c++)
+						{
+							sum[c] += texel[c] * weight;
+						}
+					}
+				}
+
+				// 평균한 Normal은 길이가 1보다 짧아짐
+				if (isNormal)
+				{
+					float n[3], length = 0.0f;
+					for (int c = 0; c < 3; c++)
+					{
+						n[c] = sum[c] * 2.0f - 1.0f;
+						length += n[c] * n[c];
+					}
+					if (length > 1e-12f)
+					{
+						length = sqrt(length);
+						for (int c = 0; c < 3; c++)
+						{
+							sum[c] = n[c] / length * 0.5f + 0.5f;
+						}
+					}
+				}
+
+				memcpy(&row[x * 4], sum, sizeof(sum));
+			}
+
+			FromLinear(row, dstWidth, useSRGB, dst + y * dstWidth * 4);
+		}, 8);
+
+		current.swap(next);
+	}
+}
+
+void TextureBaker::Compress(const ImageData& source, const DXGI_FORMAT format, ImageData& compressed)
+{
+	compressed.width = source.width;
+	compressed.height = source.height;
+	compressed.format = format;
+	compressed.mipLevels = max(source.mipLevels, 1);
+	compressed.pixels.assign(compressed.GetMipOffset(compressed.mipLevels), 0);
+
+	const size_t blockSize = compressed.GetRowPitch(0) / ((source.width + 3) / 4);
+
+	ThreadPool& pool = ThreadPool::GetInstance();
+	for (int mip = 0; mip < compressed.mipLevels; mip++)
+	{
+		const int width = source.GetMipWidth(mip);
+		const int height = source.GetMipHeight(mip);
+		const int blocksX = (width + 3) / 4;
+		const int blocksY = (height + 3) / 4;
+		const size_t rowPitch = compressed.GetRowPitch(mip);
+
+		const uint8_t* src = source.pixels.data() + source.GetMipOffset(mip);
+		uint8_t* dst = compressed.pixels.data() + compressed.GetMipOffset(mip);
+
+		pool.ParallelFor(0, blocksY, [&](size_t blockY) {
+			uint8_t block[64];
+			for (int blockX = 0; blockX < blocksX; blockX++)
+			{
+				FetchBlock(src, width, height, blockX, int(blockY), block);
+
+				uint8_t* out = dst + blockY * rowPitch + blockX * blockSize;
+				switch (format)
+				{
+				case DXGI_FORMAT_BC1_UNORM:
+				case DXGI_FORMAT_BC1_UNORM_SRGB:
+					EncodeBC1(block, out);
+					break;
+				case DXGI_FORMAT_BC4_UNORM:
+					EncodeBC4(block, 0, out);
+					break;
+				case DXGI_FORMAT_BC5_UNORM:
+					EncodeBC4(block, 0, out);
+					EncodeBC4(block, 1, out + 8);
+					break;
+				default:
+					EncodeBC7(block, out);
+					break;
+				}
+			}
+		}, 4);
+	}
+}
+
+bool TextureBaker::WriteDDS(const std::string& fileName, const ImageData& image)
+{
+	if (image.IsEmpty() || image.GetRowPitch(0) == 0)
+	{
+		cout << "WriteDDS() unsupported image " << fileName << endl;
+		return false;
+	}
+
+	const int mipLevels = max(image.mipLevels, 1);
+	const bool isCompressed = ImageData::IsBlockCompressed(image.format);
+
+	DDSHeader header = {};
+	header.size = sizeof(DDSHeader);
+	header.flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT |
+				   (isCompressed ? DDSD_LINEARSIZE : DDSD_PITCH);
+	header.height = uint32_t(image.height);
+	header.width = uint32_t(image.width);
+	header.pitchOrLinearSize = uint32_t(isCompressed ? image.GetMipSize(0) : image.GetRowPitch(0));
+	header.mipMapCount = uint32_t(mipLevels);
+	header.pixelFormat.size = sizeof(DDSPixelFormat);
+	header.pixelFormat.flags = DDPF_FOURCC;
+	header.pixelFormat.fourCC = DDS_FOURCC_DX10;
+	header.caps = DDSCAPS_TEXTURE | (mipLevels > 1 ? DDSCAPS_COMPLEX | DDSCAPS_MIPMAP : 0);
+
+	DDSHeaderDX10 headerDX10 = {};
+	headerDX10.dxgiFormat = uint32_t(image.format);
+	headerDX10.resourceDimension = DDS_DIMENSION_TEXTURE2D;
+	headerDX10.arraySize = 1;
+
+	// 실행 중인 프로그램이 쓰다 만 파일을 읽지 않도록 임시 파일에 쓰고 이름을 바꿈
+	const string tempName = fileName + ".tmp";
+	{
+		ofstream file(tempName, ios::binary | ios::trunc);
+		file.write((const char*)&DDS_MAGIC, sizeof(DDS_MAGIC));
+		file.write((const char*)&header, sizeof(header));
+		file.write((const char*)&headerDX10, sizeof(headerDX10));
+		file.write((const char*)image.pixels.data(), image.GetMipOffset(mipLevels));
+
+		if (!file)
+		{
+			cout << "Failed to write " << tempName << endl;
+			return false;
+		}
+	}
+
+	error_code ec;
+	filesystem::rename(tempName, fileName, ec);
+	if (ec)
+	{
+		cout << "Failed to write " << fileName << ": " << ec.message() << endl;
+		filesystem::remove(tempName, ec);
+		return false;
+	}
+
+	return true;
+}
+
+bool TextureBaker::ReadDDS(const std::string& fileName, ImageData& image)
+{
+	MappedFile file;
+	if (!file.Open(fileName) || file.GetSize() < ddsDataOffset)
+	{
+		cout << "Failed to read " << fileName << endl;
+		return false;
+	}
+
+	uint32_t magic;
+	DDSHeader header;
+	DDSHeaderDX10 headerDX10;
+	memcpy(&magic, file.GetData(), sizeof(magic));
+	memcpy(&header, file.GetData() + sizeof(magic), sizeof(header));
+	memcpy(&headerDX10, file.GetData() + sizeof(magic) + sizeof(header), sizeof(headerDX10));
+
+	if (magic != DDS_MAGIC || header.size != sizeof(DDSHeader) ||
+		!(header.pixelFormat.flags & DDPF_FOURCC) || header.pixelFormat.fourCC != DDS_FOURCC_DX10 ||
+		headerDX10.resourceDimension != DDS_DIMENSION_TEXTURE2D || headerDX10.arraySize != 1 ||
+		(headerDX10.miscFlag & DDS_MISC_TEXTURECUBE) || header.width == 0 || header.height == 0)
+	{
+		cout << "Unsupported DDS " << fileName << endl;
+		return false;
+	}
+
+	ImageData result;
+	result.width = int(header.width);
+	result.height = int(header.height);
+	result.format = DXGI_FORMAT(headerDX10.dxgiFormat);
+	result.mipLevels = max(int(header.mipMapCount), 1);
+
+	if (result.GetRowPitch(0) == 0 || result.mipLevels > CountMipLevels(result.width, result.height))
+	{
+		cout << "Unsupported DDS " << fileName << endl;
+		return false;
+	}
+
+	const size_t dataSize = result.GetMipOffset(result.mipLevels);
+	if (file.GetSize() - ddsDataOffset < dataSize)
+	{
+		cout << "Failed to read " << fileName << " (truncated)" << endl;
+		return false;
+	}
+
+	const uint8_t* data = file.GetData() + ddsDataOffset;
+	result.pixels.assign(data, data + dataSize);
+
+	image = std::move(result);
+	return true;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <dxgiformat.h>
+
+#include <string>
+#include <vector>
+
+#include "ImageLoader.h"
+
+// Bake할 Texture의 용도 (Format과 Mipmap을 만드는 방식이 다름)
+// ORM: MaterialPacker로 합친 Occlusion/Roughness/Metallic
+enum class TextureRole { Albedo, Emissive, Normal, Height, AO, ORM };
+
+struct BakeItem {
+	std::string fileName;
+	TextureRole role;
+};
+
+// 실행 중에 하던 GenerateMips와 RGBA8 업로드 대신
+// CPU에서 미리 Mipmap을 만들고 BC 압축해서 원본 옆에 .dds로 저장
+// Albedo: BC7, Emissive: BC1 (둘 다 sRGB), Normal: BC5 (xy만 저장, z는 Shader에서 복원), Height/AO: BC4, ORM: BC7
+// D3D Device를 사용하지 않음 (Linux에서도 빌드/실행 가능)
+class TextureBaker {
+public:
+	// Mip 0의 가로/세로가 4의 배수가 아니면 BC를 쓸 수 없으므로 RGBA8 (Mipmap만 미리 생성)
+	static DXGI_FORMAT GetBakedFormat(const TextureRole role, const int width, const int height);
+
+	// 원본 파일 이름 + ".dds"
+	static std::string GetBakedPath(const std::string &fileName);
+
+	// .dds가 있고 원본보다 나중에 만들어졌는지
+	static bool IsUpToDate(const std::string &fileName);
+
+	// 최신 .dds가 있고 sRGB 여부가 같으면 읽음 (ImageLoader::ReadImage()에서 사용)
+	static bool ReadBaked(const std::string &fileName, const bool useSRGB, ImageData &image);
+
+	// 원본을 읽어서 Mipmap 생성 + 압축 (.exr은 지원하지 않음)
+	static bool Bake(const std::string &fileName, const TextureRole role, ImageData &image);
+
+	// Bake()해서 .dds로 저장, force가 아니면 최신인 것은 건너뜀
+	static bool BakeFile(const std::string &fileName, const TextureRole role, const bool force = false);
+
+	// 중복을 제거하고 파일 단위로 병렬 처리, 새로 저장한 개수 반환
+	static size_t BakeFiles(const std::vector<BakeItem> &items, const bool force = false);
+
+	// RGBA8 Mip 0에서 나머지 Mip을 만들어 붙임 (Box Filter)
+	// sRGB는 Linear로 바꿔서 평균, Normal은 평균한 뒤 다시 정규화
+	static void GenerateMips(ImageData &image, const TextureRole role);
+
+	// Mipmap이 있는 RGBA8 이미지를 format으로 압축 (BC1/BC4/BC5/BC7)
+	static void Compress(const ImageData &source, const DXGI_FORMAT format, ImageData &compressed);
+
+	// DX10 확장 Header를 사용하는 2D Texture만
+	static bool WriteDDS(const std::string &fileName, const ImageData &image);
+	static bool ReadDDS(const std::string &fileName, ImageData &image);
+};
@@ -0,0 +1,91 @@
+#include "TextureCache.h"
+#include "D3D11Utils.h"
+
+#include <unordered_map>
+
+using namespace std;
+
+TextureCache& TextureCache::GetInstance()
+{
+	static TextureCache cache;
+	return cache;
+}
+
+std::shared_ptr<const TextureResource> TextureCache::GetOrCreate(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+																 Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
+																 const std::string& key, const ReadFunc& readImage)
+{
+	return m_textures.GetOrCreate(key, [&]() -> shared_ptr<const TextureResource> {
+		shared_ptr<const ImageData> image = readImage();
+		if (!image || image->IsEmpty())
+		{
+			cout << "Failed to create texture " << key << endl;
+			return nullptr;
+		}
+
+		shared_ptr<TextureResource> texture = make_shared<TextureResource>();
+		D3D11Utils::CreateTexture(device, context, *image, texture->texture, texture->srv);
+
+		return texture;
+	});
+}
+
+std::vector<std::shared_ptr<const TextureResource>> TextureCache::CreateBatch(Microsoft::WRL::ComPtr<ID3D11Device>& device,
+																			  Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context,
+																			  const std::vector<KeyedImage>& keyedImages)
+{
+	vector<shared_ptr<const TextureResource>> result(keyedImages.size());
+
+	// 이미 있는 것은 그대로 사용하고, 없는 key는 한 번씩만 생성
+	unordered_map<string, size_t> newIndices;
+	vector<const ImageData*> newImages;
+	vector<size_t> newOwners; // newImages[j]를 처음 요청한 keyedImages의 index
+	for (size_t i = 0; i < keyedImages.size(); i++)
+	{
+		const KeyedImage& keyed = keyedImages[i];
+		if ((result[i] = m_textures.Find(keyed.key)) || !keyed.image || keyed.image->IsEmpty())
+		{
+			continue;
+		}
+
+		if (newIndices.emplace(keyed.key, newImages.size()).second)
+		{
+			newImages.push_back(keyed.image.get());
+			newOwners.push_back(i);
+		}
+	}
+
+	vector<Microsoft::WRL::ComPtr<ID3D11Texture2D>> textures;
+	vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> srvs;
+	D3D11Utils::CreateTextures(device, context, newImages, textures, srvs);
+
+	vector<shared_ptr<const TextureResource>> created(newImages.size());
+	for (size_t j = 0; j < newImages.size(); j++)
+	{
+		if (!textures[j])
+		{
+			continue;
+		}
+
+		shared_ptr<TextureResource> texture = make_shared<TextureResource>();
+		texture->texture = textures[j];
+		texture->srv = srvs[j];
+
+		// 통계도 한 번씩 (그 사이 다른 곳에서 만들었으면 그쪽을 사용)
+		created[j] = m_textures.GetOrCreate(keyedImages[newOwners[j]].key, [&]() { return texture; });
+	}
+
+	for (size_t i = 0; i < keyedImages.size(); i++)
+	{
+		if (!result[i])
+		{
+			auto it = newIndices.find(keyedImages[i].key);
+			if (it != newIndices.end())
+			{
+				result[i] = created[it->second];
+			}
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <d3d11.h>
+#include <wrl/client.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ImageLoader.h"
+#include "ResourceCache.h"
+
+// 여러 Mesh/Model이 공유하는 GPU Texture
+struct TextureResource {
+	Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
+};
+
+// 같은 key(ImageLoader::MakeKey)의 Texture는 Process 전체에서 한 번만 GPU에 올림
+// Mesh가 모두 사라지면 GPU 자원도 해제됨
+class TextureCache {
+public:
+	using ReadFunc = std::function<std::shared_ptr<const ImageData>()>;
+
+	static TextureCache &GetInstance();
+
+	// 없을 때만 readImage()로 이미지를 받아서 생성 (실패하면 nullptr)
+	std::shared_ptr<const TextureResource> GetOrCreate(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+														Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
+														const std::string &key, const ReadFunc &readImage);
+
+	// 아직 없는 것들을 한꺼번에 생성 (D3D11Utils::CreateTextures)
+	// 반환값(keyedImages와 같은 순서)을 들고 있는 동안 TextureCache에 유지됨
+	// image가 nullptr인 것은 이미 있는 경우에만 찾아서 반환
+	std::vector<std::shared_ptr<const TextureResource>> CreateBatch(Microsoft::WRL::ComPtr<ID3D11Device> &device,
+																	Microsoft::WRL::ComPtr<ID3D11DeviceContext> &context,
+																	const std::vector<KeyedImage> &keyedImages);
+
+	// Worker Thread에서 Decoding을 건너뛸지 확인할 때 사용
+	bool Contains(const std::string &key) const { return m_textures.Contains(key); }
+
+	size_t GetHitCount() const { return m_textures.GetHitCount(); }
+	size_t GetMissCount() const { return m_textures.GetMissCount(); }
+
+private:
+	ResourceCache<const TextureResource> m_textures;
+};
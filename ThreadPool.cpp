@@ -0,0 +1,160 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+using namespace std;
+
+ThreadPool::ThreadPool(size_t numThreads)
+{
+	for (size_t i = 0; i < numThreads; i++)
+	{
+		m_workers.emplace_back([this]() { WorkerLoop(); });
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_condition.notify_all();
+
+	for (thread& worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+ThreadPool& ThreadPool::GetInstance()
+{
+	// 호출한 스레드도 ParallelFor에 참여하므로 코어 하나는 남겨둠
+	static ThreadPool pool(max(thread::hardware_concurrency(), 2u) - 1);
+
+	return pool;
+}
+
+void ThreadPool::ParallelFor(size_t begin, size_t end, const std::function<void(size_t)>& func,
+							 size_t grainSize)
+{
+	if (begin >= end)
+	{
+		return;
+	}
+
+	grainSize = max(grainSize, size_t(1));
+	const size_t numChunks = (end - begin + grainSize - 1) / grainSize;
+
+	if (numChunks == 1 || m_workers.empty())
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			func(i);
+		}
+		return;
+	}
+
+	struct SharedState {
+		atomic<size_t> nextChunk{ 0 };
+		size_t doneChunks = 0;
+		exception_ptr exception;
+		mutex doneMutex;
+		condition_variable done;
+	};
+	shared_ptr<SharedState> state = make_shared<SharedState>();
+
+	// 늦게 시작한 Worker는 남은 Chunk가 없으면 func를 건드리지 않고 끝남
+	// => 모든 Chunk가 끝난 뒤에는 호출자의 스택(func)을 참조하지 않음
+	auto runChunks = [state, &func, begin, end, grainSize, numChunks]() {
+		size_t completed = 0;
+		for (;;)
+		{
+			const size_t chunk = state->nextChunk.fetch_add(1);
+			if (chunk >= numChunks)
+			{
+				break;
+			}
+
+			const size_t chunkBegin = begin + chunk * grainSize;
+			const size_t chunkEnd = min(chunkBegin + grainSize, end);
+			try
+			{
+				for (size_t i = chunkBegin; i < chunkEnd; i++)
+				{
+					func(i);
+				}
+			}
+			catch (...)
+			{
+				lock_guard<mutex> lock(state->doneMutex);
+				if (!state->exception)
+				{
+					state->exception = current_exception();
+				}
+			}
+			completed++;
+		}
+
+		if (completed > 0)
+		{
+			lock_guard<mutex> lock(state->doneMutex);
+			state->doneChunks += completed;
+			if (state->doneChunks == numChunks)
+			{
+				state->done.notify_all();
+			}
+		}
+	};
+
+	const size_t numHelpers = min(numChunks - 1, m_workers.size());
+	{
+		lock_guard<mutex> lock(m_mutex);
+		for (size_t i = 0; i < numHelpers; i++)
+		{
+			m_tasks.push(runChunks);
+		}
+	}
+	if (numHelpers == 1)
+	{
+		m_condition.notify_one();
+	}
+	else
+	{
+		m_condition.notify_all();
+	}
+
+	// Worker가 모두 바쁘더라도(중첩 호출) 호출자 혼자서 끝까지 처리 가능
+	runChunks();
+
+	unique_lock<mutex> lock(state->doneMutex);
+	state->done.wait(lock, [&state, numChunks]() { return state->doneChunks == numChunks; });
+
+	if (state->exception)
+	{
+		rethrow_exception(state->exception);
+	}
+}
+
+void ThreadPool::WorkerLoop()
+{
+	for (;;)
+	{
+		function<void()> task;
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+
+			if (m_stop && m_tasks.empty())
+			{
+				return;
+			}
+
+			task = move(m_tasks.front());
+			m_tasks.pop();
+		}
+
+		task();
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Import, Texture Decoding 등 CPU 작업을 나눠서 처리하는 공용 Worker Thread 모음
+class ThreadPool {
+public:
+	explicit ThreadPool(size_t numThreads);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	// 프로세스 전체에서 같이 사용하는 Pool (코어 수 - 1개의 Worker)
+	static ThreadPool &GetInstance();
+
+	template <typename T_FUNC>
+	auto Submit(T_FUNC &&func) -> std::future<decltype(func())>
+	{
+		using T_RESULT = decltype(func());
+
+		// std::function은 복사 가능해야 해서 shared_ptr로 감쌈
+		auto task = std::make_shared<std::packaged_task<T_RESULT()>>(std::forward<T_FUNC>(func));
+		std::future<T_RESULT> result = task->get_future();
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_tasks.push([task]() { (*task)(); });
+		}
+		m_condition.notify_one();
+
+		return result;
+	}
+
+	// [begin, end)를 grainSize 단위로 나눠서 실행, 호출한 스레드도 같이 일함
+	// 결과를 index로 저장하면 실행 순서와 관계없이 출력 순서가 유지됨
+	void ParallelFor(size_t begin, size_t end, const std::function<void(size_t)> &func,
+					 size_t grainSize = 1);
+
+	size_t GetThreadCount() const { return m_workers.size(); }
+
+private:
+	void WorkerLoop();
+
+private:
+	std::vector<std::thread> m_workers;
+	std::queue<std::function<void()>> m_tasks;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	bool m_stop = false;
+};
@@ -0,0 +1,445 @@
+#include "UploadManager.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace {
+	const uint32_t maxTextureSize = 16384; // D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION
+	const uint32_t bufferAlignment = 16;
+}
+
+UploadManager::UploadManager(UploadDevice& device) : UploadManager(device, Settings()) {}
+
+UploadManager::UploadManager(UploadDevice& device, const Settings& settings)
+	: m_device(device), m_settings(settings)
+{
+	m_settings.pageWidth = std::clamp((m_settings.pageWidth + 3) / 4 * 4, 4u, maxTextureSize);
+	m_settings.pageBytes = max(m_settings.pageBytes, size_t(64 << 10));
+	m_settings.maxBytes = max(m_settings.maxBytes, m_settings.pageBytes);
+}
+
+UploadManager::~UploadManager()
+{
+	// 보내지 않은 복사는 버림
+	for (unique_ptr<Page>& page : m_pages)
+	{
+		if (page->state == PageState::Open)
+		{
+			m_device.UnmapPage(page->handle);
+			for (const UploadCopy& copy : page->copies)
+			{
+				m_device.Release(copy.dst);
+			}
+		}
+		m_device.DestroyPage(page->handle);
+	}
+}
+
+DXGI_FORMAT UploadManager::GetPageFormat(const DXGI_FORMAT format)
+{
+	// 같은 Typeless 그룹끼리는 CopySubresourceRegion 가능
+	switch (format)
+	{
+	case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+		return DXGI_FORMAT_R8G8B8A8_UNORM;
+	case DXGI_FORMAT_BC1_UNORM_SRGB:
+		return DXGI_FORMAT_BC1_UNORM;
+	case DXGI_FORMAT_BC7_UNORM_SRGB:
+		return DXGI_FORMAT_BC7_UNORM;
+	default:
+		return format;
+	}
+}
+
+UploadManager::FormatInfo UploadManager::GetFormatInfo(const DXGI_FORMAT format)
+{
+	// Block 하나 크기의 이미지로 ImageData의 Pitch 계산을 그대로 사용
+	ImageData probe;
+	probe.format = format;
+	probe.width = probe.height = ImageData::IsBlockCompressed(format) ? 4 : 1;
+
+	FormatInfo info;
+	info.blockSize = uint32_t(probe.width);
+	info.bytesPerBlock = uint32_t(probe.GetRowPitch(0));
+	return info;
+}
+
+UploadPageDesc UploadManager::MakeTexturePageDesc(const DXGI_FORMAT pageFormat, const FormatInfo& info) const
+{
+	const size_t rowBytes = size_t(m_settings.pageWidth / info.blockSize) * info.bytesPerBlock;
+	const size_t blockRows = max(m_settings.pageBytes / rowBytes, size_t(1));
+
+	UploadPageDesc desc;
+	desc.format = pageFormat;
+	desc.width = m_settings.pageWidth;
+	desc.height = uint32_t(min(blockRows * info.blockSize, size_t(maxTextureSize)));
+	return desc;
+}
+
+UploadPageDesc UploadManager::MakeBufferPageDesc() const
+{
+	UploadPageDesc desc;
+	desc.format = DXGI_FORMAT_UNKNOWN;
+	desc.width = uint32_t(m_settings.pageBytes);
+	desc.height = 1;
+	return desc;
+}
+
+void UploadManager::UploadTexture(ID3D11Resource* dst, const uint32_t dstMipLevels, const uint32_t arraySlice,
+								  const ImageData& image)
+{
+	if (!dst || image.IsEmpty())
+	{
+		return;
+	}
+
+	m_stats.uploadCount++;
+
+	const FormatInfo info = GetFormatInfo(image.format);
+	const bool isSupported = info.bytesPerBlock > 0;
+	const UploadPageDesc desc = isSupported ? MakeTexturePageDesc(GetPageFormat(image.format), info)
+											: UploadPageDesc();
+	const uint32_t pageBlocksY = desc.height / info.blockSize;
+	const int mipLevels = max(image.mipLevels, 1);
+
+	for (int mip = 0; mip < mipLevels; mip++)
+	{
+		const uint32_t blocksX = (uint32_t(image.GetMipWidth(mip)) + info.blockSize - 1) / info.blockSize;
+		const uint32_t blocksY = (uint32_t(image.GetMipHeight(mip)) + info.blockSize - 1) / info.blockSize;
+		const size_t srcPitch = image.GetRowPitch(mip);
+		const uint8_t* src = image.pixels.data() + image.GetMipOffset(mip);
+
+		UploadCopy copy;
+		copy.dst = dst;
+		copy.subresource = uint32_t(mip) + arraySlice * dstMipLevels; // D3D11CalcSubresource
+
+		m_stats.uploadedBytes += srcPitch * blocksY;
+
+		// 너무 넓거나 지원하지 않는 Format은 바로
+		if (!isSupported || blocksX * info.blockSize > desc.width)
+		{
+			copy.width = blocksX * info.blockSize;
+			copy.height = blocksY * info.blockSize;
+			m_device.UpdateDirect(copy, src, srcPitch);
+			m_stats.directCount++;
+			continue;
+		}
+
+		// Page보다 높으면 여러 Page에 나눠서
+		for (uint32_t row = 0; row < blocksY;)
+		{
+			const uint32_t rows = min(blocksY - row, pageBlocksY);
+
+			uint32_t x, y;
+			Page* page = Allocate(desc, blocksX, rows, 1, x, y);
+			if (!page)
+			{
+				copy.dstY = row * info.blockSize;
+				copy.width = blocksX * info.blockSize;
+				copy.height = (blocksY - row) * info.blockSize;
+				m_device.UpdateDirect(copy, src + row * srcPitch, srcPitch);
+				m_stats.directCount++;
+				break;
+			}
+
+			const size_t rowBytes = size_t(blocksX) * info.bytesPerBlock;
+			uint8_t* mapped = page->data + y * page->rowPitch + x * info.bytesPerBlock;
+			for (uint32_t r = 0; r < rows; r++)
+			{
+				memcpy(mapped + r * page->rowPitch, src + (row + r) * srcPitch, rowBytes);
+			}
+
+			copy.dstX = 0;
+			copy.dstY = row * info.blockSize;
+			copy.srcX = x * info.blockSize;
+			copy.srcY = y * info.blockSize;
+			copy.width = blocksX * info.blockSize;
+			copy.height = rows * info.blockSize;
+			page->copies.push_back(copy);
+			m_device.AddRef(dst);
+
+			row += rows;
+		}
+	}
+}
+
+void UploadManager::UploadBuffer(ID3D11Resource* dst, const void* data, const size_t size, const size_t dstOffset)
+{
+	if (!dst || size == 0)
+	{
+		return;
+	}
+
+	m_stats.uploadCount++;
+	m_stats.uploadedBytes += size;
+
+	const UploadPageDesc desc = MakeBufferPageDesc();
+	const uint8_t* src = (const uint8_t*)data;
+
+	for (size_t offset = 0; offset < size;)
+	{
+		const uint32_t chunk = uint32_t(min(size - offset, size_t(desc.width)));
+
+		UploadCopy copy;
+		copy.dst = dst;
+		copy.dstX = uint32_t(dstOffset + offset);
+		copy.width = chunk;
+		copy.height = 1;
+
+		uint32_t x, y;
+		Page* page = Allocate(desc, chunk, 1, bufferAlignment, x, y);
+		if (!page)
+		{
+			copy.width = uint32_t(size - offset);
+			m_device.UpdateDirect(copy, src + offset, copy.width);
+			m_stats.directCount++;
+			return;
+		}
+
+		memcpy(page->data + x, src + offset, chunk);
+		copy.srcX = x;
+		page->copies.push_back(copy);
+		m_device.AddRef(dst);
+
+		offset += chunk;
+	}
+}
+
+void UploadManager::Flush()
+{
+	bool submitted = false;
+	for (unique_ptr<Page>& page : m_pages)
+	{
+		if (page->state != PageState::Open)
+		{
+			continue;
+		}
+
+		m_device.UnmapPage(page->handle);
+		page->data = nullptr;
+
+		for (const UploadCopy& copy : page->copies)
+		{
+			m_device.Copy(page->handle, copy);
+			m_device.Release(copy.dst);
+		}
+		m_stats.copyCount += page->copies.size();
+		page->copies.clear();
+
+		page->state = PageState::Submitted;
+		page->frame = m_frame;
+		submitted = true;
+	}
+
+	if (!submitted)
+	{
+		return;
+	}
+
+	// 이번에 보낸 Page들은 같은 Fence
+	const uint64_t fence = m_device.Signal();
+	for (unique_ptr<Page>& page : m_pages)
+	{
+		if (page->state == PageState::Submitted && page->fence == 0)
+		{
+			page->fence = fence;
+		}
+	}
+
+	m_stats.flushCount++;
+}
+
+void UploadManager::EndFrame()
+{
+	Flush();
+	m_frame++;
+	Retire();
+}
+
+void UploadManager::Retire()
+{
+	const uint64_t completed = m_device.GetCompletedFence();
+	for (unique_ptr<Page>& page : m_pages)
+	{
+		if (page->state != PageState::Submitted)
+		{
+			continue;
+		}
+
+		// D3D11은 Staging을 Map할 때 GPU가 아직 읽고 있으면 알아서 기다리므로 Frame 수로 회수해도 안전
+		const bool isFenceDone = page->fence <= completed;
+		const bool isOldEnough = m_settings.retireFrames > 0 && m_frame >= page->frame + m_settings.retireFrames;
+		if (isFenceDone || isOldEnough)
+		{
+			page->state = PageState::Free;
+			page->fence = 0;
+		}
+	}
+}
+
+bool UploadManager::WaitForOldest()
+{
+	uint64_t oldest = 0;
+	for (const unique_ptr<Page>& page : m_pages)
+	{
+		if (page->state == PageState::Submitted && (oldest == 0 || page->fence < oldest))
+		{
+			oldest = page->fence;
+		}
+	}
+
+	if (oldest == 0)
+	{
+		return false;
+	}
+
+	m_device.WaitForFence(oldest);
+	m_stats.waitCount++;
+	Retire();
+	return true;
+}
+
+void UploadManager::DestroyPage(const size_t index)
+{
+	m_stats.pageCount--;
+	m_stats.pageMemory -= m_pages[index]->size;
+	m_stats.pageDestroyCount++;
+
+	m_device.DestroyPage(m_pages[index]->handle);
+	m_pages.erase(m_pages.begin() + index);
+}
+
+bool UploadManager::TryAllocate(Page& page, const uint32_t width, const uint32_t height, const uint32_t alignment,
+								uint32_t& x, uint32_t& y)
+{
+	uint32_t cursorX = (page.cursorX + alignment - 1) / alignment * alignment;
+	uint32_t shelfY = page.shelfY;
+	uint32_t shelfHeight = page.shelfHeight;
+
+	// 이번 줄에 자리가 없으면 다음 줄 (Shelf)
+	if (cursorX + width > page.width)
+	{
+		cursorX = 0;
+		shelfY += shelfHeight;
+		shelfHeight = 0;
+	}
+
+	if (width > page.width || shelfY + height > page.height)
+	{
+		return false;
+	}
+
+	x = cursorX;
+	y = shelfY;
+	page.cursorX = cursorX + width;
+	page.shelfY = shelfY;
+	page.shelfHeight = max(shelfHeight, height);
+	return true;
+}
+
+UploadManager::Page* UploadManager::Allocate(const UploadPageDesc& desc, const uint32_t width, const uint32_t height,
+											 const uint32_t alignment, uint32_t& x, uint32_t& y)
+{
+	// 같은 종류의 Open Page부터
+	for (unique_ptr<Page>& page : m_pages)
+	{
+		if (page->state == PageState::Open && page->desc.format == desc.format &&
+			TryAllocate(*page, width, height, alignment, x, y))
+		{
+			return page.get();
+		}
+	}
+
+	// 새 Page는 비어있으므로 (Page보다 크지 않으면) 항상 들어감
+	Page* page = AcquirePage(desc);
+	if (page && TryAllocate(*page, width, height, alignment, x, y))
+	{
+		return page;
+	}
+
+	return nullptr;
+}
+
+UploadManager::Page* UploadManager::AcquirePage(const UploadPageDesc& desc)
+{
+	// 넣지 못한 Open Page도 Flush() 전까지 열어둠 (작은 것들이 남은 자리를 씀)
+	const bool isBuffer = desc.format == DXGI_FORMAT_UNKNOWN;
+	const FormatInfo info = GetFormatInfo(desc.format);
+	const uint32_t width = isBuffer ? desc.width : desc.width / info.blockSize;
+	const uint32_t height = isBuffer ? 1 : desc.height / info.blockSize;
+	const size_t pageSize = isBuffer ? size_t(width) : size_t(width) * info.bytesPerBlock * height;
+
+	while (true)
+	{
+		Retire();
+
+		// 다 읽은 같은 종류의 Page를 다시 사용
+		for (unique_ptr<Page>& page : m_pages)
+		{
+			if (page->state == PageState::Free && page->desc.format == desc.format &&
+				page->desc.width == desc.width && page->desc.height == desc.height)
+			{
+				page->data = m_device.MapPage(page->handle, page->rowPitch);
+				if (!page->data)
+				{
+					return nullptr;
+				}
+
+				m_stats.mapCount++;
+				page->state = PageState::Open;
+				page->cursorX = page->shelfY = page->shelfHeight = 0;
+				return page.get();
+			}
+		}
+
+		// 자리가 없으면 다른 종류의 놀고 있는 Page부터 정리
+		for (size_t i = m_pages.size(); i-- > 0 && m_stats.pageMemory + pageSize > m_settings.maxBytes;)
+		{
+			if (m_pages[i]->state == PageState::Free)
+			{
+				DestroyPage(i);
+			}
+		}
+
+		if (m_stats.pageMemory + pageSize <= m_settings.maxBytes || m_pages.empty())
+		{
+			break;
+		}
+
+		// 그래도 없으면 모아둔 것을 보내고 GPU가 가장 오래된 Page를 다 읽을 때까지 기다림
+		Flush();
+		if (!WaitForOldest())
+		{
+			break;
+		}
+	}
+
+	unique_ptr<Page> page = make_unique<Page>();
+	page->desc = desc;
+	page->size = pageSize;
+	page->width = width;
+	page->height = height;
+	page->handle = m_device.CreatePage(desc);
+	if (!page->handle)
+	{
+		return nullptr;
+	}
+
+	page->data = m_device.MapPage(page->handle, page->rowPitch);
+	if (!page->data)
+	{
+		m_device.DestroyPage(page->handle);
+		return nullptr;
+	}
+
+	m_stats.pageCreateCount++;
+	m_stats.mapCount++;
+	m_stats.pageCount++;
+	m_stats.pageMemory += page->size;
+
+	page->state = PageState::Open;
+	m_pages.push_back(std::move(page));
+	return m_pages.back().get();
+}
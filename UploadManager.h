@@ -0,0 +1,168 @@
+#pragma once
+
+#include <dxgiformat.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ImageLoader.h"
+
+struct ID3D11Resource;
+
+// Staging 메모리 한 Page
+// Texture Page: format이 같은(UNORM/SRGB는 같은 것으로 봄) Texture끼리 2D로 나눠 씀 (width x height texel)
+// Buffer Page: format이 UNKNOWN, width Byte (height = 1)
+struct UploadPageDesc {
+	DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+	uint32_t width = 0;
+	uint32_t height = 0;
+};
+
+// Page의 (srcX, srcY)부터 width x height를 dst의 subresource (dstX, dstY)로 복사
+// Buffer는 x와 width가 Byte 단위 (y = 0, height = 1)
+// BC Format은 4x4 Block 단위로 맞춰져 있음 (작은 Mip도 Block 하나)
+struct UploadCopy {
+	ID3D11Resource *dst = nullptr;
+	uint32_t subresource = 0;
+	uint32_t dstX = 0;
+	uint32_t dstY = 0;
+	uint32_t srcX = 0;
+	uint32_t srcY = 0;
+	uint32_t width = 0;
+	uint32_t height = 0;
+};
+
+// UploadManager가 사용하는 GPU 기능 (D3D11UploadDevice, Test/Benchmark용 MockUploadDevice)
+// page는 CreatePage()가 반환한 것
+class UploadDevice {
+public:
+	virtual ~UploadDevice() {}
+
+	virtual void *CreatePage(const UploadPageDesc &desc) = 0; // 실패하면 nullptr
+	virtual void DestroyPage(void *page) = 0;
+
+	// rowPitch: Page 가로 한 줄(BC는 Block 한 줄)의 Byte 수
+	virtual uint8_t *MapPage(void *page, size_t &rowPitch) = 0;
+	virtual void UnmapPage(void *page) = 0;
+
+	virtual void Copy(void *page, const UploadCopy &copy) = 0;
+
+	// Page에 들어가지 않는 것은 Staging 없이 바로 (copy의 src는 사용하지 않음)
+	virtual void UpdateDirect(const UploadCopy &copy, const uint8_t *data, const size_t rowPitch) = 0;
+
+	// 복사를 보내기 전에 dst가 해제되지 않도록
+	virtual void AddRef(ID3D11Resource *resource) = 0;
+	virtual void Release(ID3D11Resource *resource) = 0;
+
+	// 지금까지 보낸 명령이 GPU에서 끝나면 완료되는 값 (1부터 증가)
+	virtual uint64_t Signal() = 0;
+	virtual uint64_t GetCompletedFence() = 0;
+	virtual void WaitForFence(const uint64_t fence) = 0;
+};
+
+// 매번 Staging Texture/Buffer를 만들고 Map하는 대신
+// 계속 재사용하는 Staging Page들에 나눠 담아서 Flush() 때 한꺼번에 복사
+// GPU가 다 읽은 Page(Fence 완료 또는 retireFrames가 지난 것)는 다시 사용
+// Render Thread 전용 (Device Context와 같음)
+class UploadManager {
+public:
+	struct Settings {
+		uint32_t pageWidth = 4096;		 // Texture Page 가로 (texel), 이보다 넓으면 UpdateDirect
+		size_t pageBytes = 4 << 20;		 // Page 하나의 크기
+		size_t maxBytes = 64 << 20;		 // 모든 Page를 합친 최대 크기 (넘으면 GPU를 기다림)
+		uint32_t retireFrames = 3;		 // Fence와 별개로 이만큼 Frame이 지나면 다시 사용 (0이면 Fence만)
+	};
+
+	struct Stats {
+		size_t uploadCount = 0; // UploadTexture/UploadBuffer 호출
+		size_t copyCount = 0;	// CopySubresourceRegion
+		size_t directCount = 0; // UpdateDirect
+		size_t uploadedBytes = 0;
+		size_t flushCount = 0;	// 실제로 복사를 보낸 Flush()
+		size_t mapCount = 0;
+		size_t pageCreateCount = 0;
+		size_t pageDestroyCount = 0;
+		size_t waitCount = 0;	// Page가 부족해서 GPU를 기다린 횟수
+		size_t pageCount = 0;	// 현재
+		size_t pageMemory = 0;	// 현재 (Byte)
+	};
+
+	UploadManager(UploadDevice &device);
+	UploadManager(UploadDevice &device, const Settings &settings);
+	~UploadManager();
+
+	UploadManager(const UploadManager &) = delete;
+	UploadManager &operator=(const UploadManager &) = delete;
+
+	// image의 모든 Mip(없으면 Mip 0만)을 dst의 arraySlice로
+	// dstMipLevels는 dst Texture의 Mip 개수 (Subresource 계산용)
+	void UploadTexture(ID3D11Resource *dst, const uint32_t dstMipLevels, const uint32_t arraySlice,
+					   const ImageData &image);
+
+	void UploadBuffer(ID3D11Resource *dst, const void *data, const size_t size, const size_t dstOffset = 0);
+
+	// 모아둔 복사를 GPU에 보냄 (복사 결과로 GenerateMips 등을 하려면 먼저 호출)
+	void Flush();
+
+	// Frame마다 그리기 전에 한 번: Flush() + 다 읽은 Page 회수
+	void EndFrame();
+
+	const Stats &GetStats() const { return m_stats; }
+	const Settings &GetSettings() const { return m_settings; }
+
+	// Page를 나누는 단위 (Texture: UNORM으로 합친 format, BC는 4x4 Block)
+	static DXGI_FORMAT GetPageFormat(const DXGI_FORMAT format);
+
+private:
+	enum class PageState { Free, Open, Submitted };
+
+	struct Page {
+		UploadPageDesc desc;
+		void *handle = nullptr;
+		size_t size = 0;
+		PageState state = PageState::Free;
+
+		uint8_t *data = nullptr; // Open일 때만
+		size_t rowPitch = 0;
+
+		// Shelf 방식으로 나눠 씀 (Block 단위, Buffer는 Byte 단위이고 높이 1)
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t cursorX = 0;
+		uint32_t shelfY = 0;
+		uint32_t shelfHeight = 0;
+
+		std::vector<UploadCopy> copies;
+		uint64_t fence = 0;
+		uint64_t frame = 0;
+	};
+
+	struct FormatInfo {
+		uint32_t blockSize = 1;		// texel (BC는 4)
+		uint32_t bytesPerBlock = 0; // 0이면 지원하지 않는 Format
+	};
+
+	static FormatInfo GetFormatInfo(const DXGI_FORMAT format);
+
+	UploadPageDesc MakeTexturePageDesc(const DXGI_FORMAT pageFormat, const FormatInfo &info) const;
+	UploadPageDesc MakeBufferPageDesc() const;
+
+	// width x height(Block 단위)를 넣을 수 있는 Open Page (없으면 새로 Map), 실패하면 nullptr
+	Page *Allocate(const UploadPageDesc &desc, const uint32_t width, const uint32_t height,
+				   const uint32_t alignment, uint32_t &x, uint32_t &y);
+	Page *AcquirePage(const UploadPageDesc &desc);
+	bool TryAllocate(Page &page, const uint32_t width, const uint32_t height, const uint32_t alignment,
+					 uint32_t &x, uint32_t &y);
+
+	void Retire();
+	bool WaitForOldest();
+	void DestroyPage(const size_t index);
+
+	UploadDevice &m_device;
+	Settings m_settings;
+	Stats m_stats;
+	std::vector<std::unique_ptr<Page>> m_pages;
+	uint64_t m_frame = 0;
+};
@@ -2,11 +2,29 @@
 
 #include <directxtk/SimpleMath.h>
 
+#include <cstdint>
 #include <vector>
 
 struct Vertex {
 	DirectX::SimpleMath::Vector3 position;
 	DirectX::SimpleMath::Vector3 normalModel;
 	DirectX::SimpleMath::Vector2 texcoord;
-	DirectX::SimpleMath::Vector3 tangentModel;
-};
\ No newline at end of file
+	DirectX::SimpleMath::Vector4 tangentModel; // w: Bitangent 부호 (B = cross(N, T) * w)
+};
+
+// GPU용 압축 Vertex (48 Byte -> 20 Byte), VertexQuantizer로 생성
+// position: SNORM16 x 4 (w는 Tangent의 Bitangent 부호 ±1), Mesh의 QuantizationConstants로 복원
+// normal, tangent: Octahedral SNORM16 x 2
+// texcoord: FLOAT16 x 2 (Wrap 때문에 [0, 1]을 벗어날 수 있음)
+struct QuantizedVertex {
+	int16_t position[4];
+	int16_t normal[2];
+	uint16_t texcoord[2];
+	int16_t tangent[2];
+};
+
+// Depth Only/Shadow Pass용 Position Stream (8 Byte)
+// QuantizedVertex::position과 같은 값이라서 두 Pass의 위치가 정확히 일치함
+struct QuantizedPosition {
+	int16_t position[4];
+};
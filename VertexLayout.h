@@ -0,0 +1,87 @@
+#pragma once
+
+#include <d3d11.h>
+
+#include <cstddef>
+
+#include "Vertex.h"
+
+// Vertex 구조체별 Input Layout을 컴파일 타임에 정의
+// D3D11Utils::GetInputElements<T_VERTEX>()로 D3D11_INPUT_ELEMENT_DESC 생성
+struct VertexElement {
+	const char *semanticName;
+	DXGI_FORMAT format;
+	UINT offset;
+};
+
+constexpr UINT GetFormatSize(const DXGI_FORMAT format)
+{
+	switch (format)
+	{
+	case DXGI_FORMAT_R32G32B32A32_FLOAT:
+		return 16;
+	case DXGI_FORMAT_R32G32B32_FLOAT:
+		return 12;
+	case DXGI_FORMAT_R32G32_FLOAT:
+	case DXGI_FORMAT_R16G16B16A16_SNORM:
+	case DXGI_FORMAT_R16G16B16A16_FLOAT:
+		return 8;
+	case DXGI_FORMAT_R32_FLOAT:
+	case DXGI_FORMAT_R16G16_SNORM:
+	case DXGI_FORMAT_R16G16_FLOAT:
+	case DXGI_FORMAT_R8G8B8A8_SNORM:
+		return 4;
+	default:
+		return 0;
+	}
+}
+
+template <typename T_VERTEX>
+struct VertexLayout;
+
+template <>
+struct VertexLayout<Vertex> {
+	static constexpr VertexElement elements[] = {
+		{"POSITION", DXGI_FORMAT_R32G32B32_FLOAT, offsetof(Vertex, position)},
+		{"NORMAL", DXGI_FORMAT_R32G32B32_FLOAT, offsetof(Vertex, normalModel)},
+		{"TEXCOORD", DXGI_FORMAT_R32G32_FLOAT, offsetof(Vertex, texcoord)},
+		{"TANGENT", DXGI_FORMAT_R32G32B32A32_FLOAT, offsetof(Vertex, tangentModel)},
+	};
+};
+
+template <>
+struct VertexLayout<QuantizedVertex> {
+	static constexpr VertexElement elements[] = {
+		{"POSITION", DXGI_FORMAT_R16G16B16A16_SNORM, offsetof(QuantizedVertex, position)},
+		{"NORMAL", DXGI_FORMAT_R16G16_SNORM, offsetof(QuantizedVertex, normal)},
+		{"TEXCOORD", DXGI_FORMAT_R16G16_FLOAT, offsetof(QuantizedVertex, texcoord)},
+		{"TANGENT", DXGI_FORMAT_R16G16_SNORM, offsetof(QuantizedVertex, tangent)},
+	};
+};
+
+template <>
+struct VertexLayout<QuantizedPosition> {
+	static constexpr VertexElement elements[] = {
+		{"POSITION", DXGI_FORMAT_R16G16B16A16_SNORM, offsetof(QuantizedPosition, position)},
+	};
+};
+
+// Element들이 빈틈이나 겹침 없이 구조체 전체를 덮는지 확인
+template <typename T_VERTEX>
+constexpr bool IsLayoutComplete()
+{
+	UINT size = 0;
+	for (const VertexElement &element : VertexLayout<T_VERTEX>::elements)
+	{
+		if (GetFormatSize(element.format) == 0 || element.offset != size)
+		{
+			return false;
+		}
+		size += GetFormatSize(element.format);
+	}
+	return size == sizeof(T_VERTEX);
+}
+
+static_assert(IsLayoutComplete<Vertex>(), "VertexLayout<Vertex> does not match Vertex");
+static_assert(IsLayoutComplete<QuantizedVertex>(), "VertexLayout<QuantizedVertex> does not match QuantizedVertex");
+static_assert(IsLayoutComplete<QuantizedPosition>(), "VertexLayout<QuantizedPosition> does not match QuantizedPosition");
@@ -0,0 +1,307 @@
+#include "VertexQuantizer.h"
+
+#include <emmintrin.h>
+#include <fp16.h>
+
+#if defined(__F16C__) || defined(__AVX2__)
+#include <immintrin.h>
+#define USE_F16C
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	const float SNORM16_MAX = 32767.0f;
+
+	// [-1, 1] -> SNORM16 (반올림), 결과는 32-bit 정수 4개
+	__m128i ToSnorm16(__m128 value)
+	{
+		value = _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+		return _mm_cvtps_epi32(_mm_mul_ps(value, _mm_set1_ps(SNORM16_MAX)));
+	}
+
+	// a, b의 각 Lane을 int16 쌍 (a[i], b[i])으로 만들어 32-bit Lane i에 넣음
+	__m128i PackPairs(const __m128i a, const __m128i b)
+	{
+		return _mm_unpacklo_epi16(_mm_packs_epi32(a, a), _mm_packs_epi32(b, b));
+	}
+
+	// 32-bit Lane 4개를 각 Vertex의 같은 위치에 저장
+	template <typename T_MEMBER>
+	void StoreLanes(const __m128i pairs, QuantizedVertex *output, T_MEMBER member)
+	{
+		uint32_t lanes[4];
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), pairs);
+		for (int k = 0; k < 4; k++)
+		{
+			memcpy(output[k].*member, &lanes[k], 4);
+		}
+	}
+
+	// 방향 4개를 Octahedral [-1, 1]^2로 (SoA)
+	void OctEncode4(__m128 x, __m128 y, const __m128 z, __m128 &u, __m128 &v)
+	{
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+		const __m128 one = _mm_set1_ps(1.0f);
+
+		// |x| + |y| + |z| = 1인 팔면체로 투영 (길이가 0이면 (0, 0)이 되어 +z로 복원됨)
+		const __m128 absSum = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, x), _mm_andnot_ps(signMask, y)),
+										 _mm_andnot_ps(signMask, z));
+		const __m128 valid = _mm_cmpgt_ps(absSum, _mm_set1_ps(1e-20f));
+		const __m128 invSum = _mm_and_ps(valid, _mm_div_ps(one, _mm_max_ps(absSum, _mm_set1_ps(1e-20f))));
+		x = _mm_mul_ps(x, invSum);
+		y = _mm_mul_ps(y, invSum);
+
+		// 아래쪽 반구(z < 0)는 대각선을 기준으로 접음: ((1 - |y|) * sign(x), (1 - |x|) * sign(y))
+		const __m128 lower = _mm_cmplt_ps(z, _mm_setzero_ps());
+		const __m128 signX = _mm_or_ps(_mm_and_ps(x, signMask), one);
+		const __m128 signY = _mm_or_ps(_mm_and_ps(y, signMask), one);
+		const __m128 foldedX = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, y)), signX);
+		const __m128 foldedY = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, x)), signY);
+
+		u = _mm_or_ps(_mm_and_ps(lower, foldedX), _mm_andnot_ps(lower, x));
+		v = _mm_or_ps(_mm_and_ps(lower, foldedY), _mm_andnot_ps(lower, y));
+	}
+
+	// ToSnorm16과 같은 변환 (_mm_cvtps_epi32처럼 짝수 쪽으로 반올림)
+	int16_t ToSnorm16Scalar(const float value)
+	{
+		return int16_t(lrintf(min(max(value, -1.0f), 1.0f) * SNORM16_MAX));
+	}
+
+	// OctEncode4와 같은 순서의 연산
+	void OctEncodeScalar(float x, float y, const float z, int16_t output[2])
+	{
+		const float absSum = (abs(x) + abs(y)) + abs(z);
+		const float invSum = (absSum > 1e-20f) ? 1.0f / max(absSum, 1e-20f) : 0.0f;
+		x *= invSum;
+		y *= invSum;
+
+		if (z < 0.0f)
+		{
+			const float foldedX = (1.0f - abs(y)) * copysign(1.0f, x);
+			const float foldedY = (1.0f - abs(x)) * copysign(1.0f, y);
+			x = foldedX;
+			y = foldedY;
+		}
+
+		output[0] = ToSnorm16Scalar(x);
+		output[1] = ToSnorm16Scalar(y);
+	}
+
+	void StoreHalf2x4(const Vertex *v, QuantizedVertex *output)
+	{
+#ifdef USE_F16C
+		const __m128 uv01 = _mm_setr_ps(v[0].texcoord.x, v[0].texcoord.y, v[1].texcoord.x, v[1].texcoord.y);
+		const __m128 uv23 = _mm_setr_ps(v[2].texcoord.x, v[2].texcoord.y, v[3].texcoord.x, v[3].texcoord.y);
+		const __m128i half01 = _mm_cvtps_ph(uv01, _MM_FROUND_TO_NEAREST_INT);
+		const __m128i half23 = _mm_cvtps_ph(uv23, _MM_FROUND_TO_NEAREST_INT);
+		StoreLanes(_mm_unpacklo_epi64(half01, half23), output, &QuantizedVertex::texcoord);
+#else
+		for (int k = 0; k < 4; k++)
+		{
+			output[k].texcoord[0] = fp16_ieee_from_fp32_value(v[k].texcoord.x);
+			output[k].texcoord[1] = fp16_ieee_from_fp32_value(v[k].texcoord.y);
+		}
+#endif
+	}
+
+	// Vertex 4개 변환 (AoS -> SoA로 모아서 계산 후 다시 AoS로 저장)
+	void QuantizeBlock(const Vertex *v, const __m128 offset[3], const __m128 invScale[3],
+					   QuantizedVertex *output)
+	{
+		const __m128 px = _mm_setr_ps(v[0].position.x, v[1].position.x, v[2].position.x, v[3].position.x);
+		const __m128 py = _mm_setr_ps(v[0].position.y, v[1].position.y, v[2].position.y, v[3].position.y);
+		const __m128 pz = _mm_setr_ps(v[0].position.z, v[1].position.z, v[2].position.z, v[3].position.z);
+
+		const __m128i qx = ToSnorm16(_mm_mul_ps(_mm_sub_ps(px, offset[0]), invScale[0]));
+		const __m128i qy = ToSnorm16(_mm_mul_ps(_mm_sub_ps(py, offset[1]), invScale[1]));
+		const __m128i qz = ToSnorm16(_mm_mul_ps(_mm_sub_ps(pz, offset[2]), invScale[2]));
+
+		// w에는 Bitangent 부호 (음수면 -1, 그 외에는 1)
+		const __m128 tw = _mm_setr_ps(v[0].tangentModel.w, v[1].tangentModel.w, v[2].tangentModel.w, v[3].tangentModel.w);
+		const __m128 mirrored = _mm_cmplt_ps(tw, _mm_setzero_ps());
+		const __m128i qw = ToSnorm16(_mm_or_ps(_mm_and_ps(mirrored, _mm_set1_ps(-1.0f)),
+											   _mm_andnot_ps(mirrored, _mm_set1_ps(1.0f))));
+
+		// (x, y), (z, w)를 합쳐서 Vertex마다 64-bit
+		const __m128i xy = PackPairs(qx, qy);
+		const __m128i zw = PackPairs(qz, qw);
+		const __m128i position01 = _mm_unpacklo_epi32(xy, zw);
+		const __m128i position23 = _mm_unpackhi_epi32(xy, zw);
+		_mm_storel_epi64(reinterpret_cast<__m128i *>(output[0].position), position01);
+		_mm_storel_epi64(reinterpret_cast<__m128i *>(output[1].position), _mm_srli_si128(position01, 8));
+		_mm_storel_epi64(reinterpret_cast<__m128i *>(output[2].position), position23);
+		_mm_storel_epi64(reinterpret_cast<__m128i *>(output[3].position), _mm_srli_si128(position23, 8));
+
+		__m128 u, w;
+		OctEncode4(_mm_setr_ps(v[0].normalModel.x, v[1].normalModel.x, v[2].normalModel.x, v[3].normalModel.x),
+				   _mm_setr_ps(v[0].normalModel.y, v[1].normalModel.y, v[2].normalModel.y, v[3].normalModel.y),
+				   _mm_setr_ps(v[0].normalModel.z, v[1].normalModel.z, v[2].normalModel.z, v[3].normalModel.z),
+				   u, w);
+		const __m128i normals = PackPairs(ToSnorm16(u), ToSnorm16(w));
+
+		OctEncode4(_mm_setr_ps(v[0].tangentModel.x, v[1].tangentModel.x, v[2].tangentModel.x, v[3].tangentModel.x),
+				   _mm_setr_ps(v[0].tangentModel.y, v[1].tangentModel.y, v[2].tangentModel.y, v[3].tangentModel.y),
+				   _mm_setr_ps(v[0].tangentModel.z, v[1].tangentModel.z, v[2].tangentModel.z, v[3].tangentModel.z),
+				   u, w);
+		const __m128i tangents = PackPairs(ToSnorm16(u), ToSnorm16(w));
+
+		StoreLanes(normals, output, &QuantizedVertex::normal);
+		StoreLanes(tangents, output, &QuantizedVertex::tangent);
+
+		StoreHalf2x4(v, output);
+	}
+}
+
+QuantizationConstants VertexQuantizer::ComputeConstants(const Vertex* vertices, const size_t vertexCount)
+{
+	QuantizationConstants consts;
+	if (vertexCount == 0)
+	{
+		return consts;
+	}
+
+	Vector3 vmin = vertices[0].position;
+	Vector3 vmax = vertices[0].position;
+	for (size_t i = 1; i < vertexCount; i++)
+	{
+		vmin = Vector3::Min(vmin, vertices[i].position);
+		vmax = Vector3::Max(vmax, vertices[i].position);
+	}
+
+	consts.positionOffset = (vmin + vmax) * 0.5f;
+	consts.positionScale = (vmax - vmin) * 0.5f;
+
+	return consts;
+}
+
+void VertexQuantizer::Quantize(const Vertex* vertices, const size_t vertexCount,
+							   const QuantizationConstants& consts, QuantizedVertex* output)
+{
+	// 납작한 Mesh는 Scale이 0인 축이 있으므로 그 축은 모두 0(= Offset)으로
+	const float scale[3] = { consts.positionScale.x, consts.positionScale.y, consts.positionScale.z };
+	const float center[3] = { consts.positionOffset.x, consts.positionOffset.y, consts.positionOffset.z };
+	__m128 offset[3];
+	__m128 invScale[3];
+	for (int a = 0; a < 3; a++)
+	{
+		offset[a] = _mm_set1_ps(center[a]);
+		invScale[a] = _mm_set1_ps(scale[a] > 0.0f ? 1.0f / scale[a] : 0.0f);
+	}
+
+	size_t i = 0;
+	for (; i + 4 <= vertexCount; i += 4)
+	{
+		QuantizeBlock(vertices + i, offset, invScale, output + i);
+	}
+
+	// 남은 Vertex는 4개로 채워서 같은 경로로 처리
+	if (i < vertexCount)
+	{
+		const size_t remaining = vertexCount - i;
+
+		Vertex block[4];
+		QuantizedVertex blockOutput[4];
+		for (size_t k = 0; k < 4; k++)
+		{
+			block[k] = vertices[i + min(k, remaining - 1)];
+		}
+
+		QuantizeBlock(block, offset, invScale, blockOutput);
+		memcpy(output + i, blockOutput, sizeof(QuantizedVertex) * remaining);
+	}
+}
+
+void VertexQuantizer::Quantize(const Vertex* vertices, const size_t vertexCount,
+							   const QuantizationConstants& consts, std::vector<QuantizedVertex>& output)
+{
+	output.resize(vertexCount);
+	Quantize(vertices, vertexCount, consts, output.data());
+}
+
+void VertexQuantizer::QuantizeScalar(const Vertex* vertices, const size_t vertexCount,
+									 const QuantizationConstants& consts, QuantizedVertex* output)
+{
+	const float scale[3] = { consts.positionScale.x, consts.positionScale.y, consts.positionScale.z };
+	const float center[3] = { consts.positionOffset.x, consts.positionOffset.y, consts.positionOffset.z };
+	float invScale[3];
+	for (int a = 0; a < 3; a++)
+	{
+		invScale[a] = scale[a] > 0.0f ? 1.0f / scale[a] : 0.0f;
+	}
+
+	for (size_t i = 0; i < vertexCount; i++)
+	{
+		const Vertex& v = vertices[i];
+		QuantizedVertex& q = output[i];
+
+		const float position[3] = { v.position.x, v.position.y, v.position.z };
+		for (int a = 0; a < 3; a++)
+		{
+			q.position[a] = ToSnorm16Scalar((position[a] - center[a]) * invScale[a]);
+		}
+		q.position[3] = ToSnorm16Scalar((v.tangentModel.w < 0.0f) ? -1.0f : 1.0f);
+
+		OctEncodeScalar(v.normalModel.x, v.normalModel.y, v.normalModel.z, q.normal);
+		OctEncodeScalar(v.tangentModel.x, v.tangentModel.y, v.tangentModel.z, q.tangent);
+
+		q.texcoord[0] = fp16_ieee_from_fp32_value(v.texcoord.x);
+		q.texcoord[1] = fp16_ieee_from_fp32_value(v.texcoord.y);
+	}
+}
+
+void VertexQuantizer::ExtractPositions(const QuantizedVertex* vertices, const size_t vertexCount,
+									   std::vector<QuantizedPosition>& output)
+{
+	output.resize(vertexCount);
+	for (size_t i = 0; i < vertexCount; i++)
+	{
+		memcpy(output[i].position, vertices[i].position, sizeof(QuantizedPosition));
+	}
+}
+
+Vertex VertexQuantizer::Dequantize(const QuantizedVertex& vertex, const QuantizationConstants& consts)
+{
+	Vertex result;
+
+	// SNORM -> float는 max(q / 32767, -1)
+	const Vector3 snorm(max(vertex.position[0] / SNORM16_MAX, -1.0f),
+						max(vertex.position[1] / SNORM16_MAX, -1.0f),
+						max(vertex.position[2] / SNORM16_MAX, -1.0f));
+	result.position = consts.positionOffset + snorm * consts.positionScale;
+
+	result.normalModel = DecodeOctahedral(vertex.normal[0], vertex.normal[1]);
+	const Vector3 tangent = DecodeOctahedral(vertex.tangent[0], vertex.tangent[1]);
+	result.tangentModel = Vector4(tangent.x, tangent.y, tangent.z, (vertex.position[3] < 0) ? -1.0f : 1.0f);
+
+	result.texcoord.x = fp16_ieee_to_fp32_value(vertex.texcoord[0]);
+	result.texcoord.y = fp16_ieee_to_fp32_value(vertex.texcoord[1]);
+
+	return result;
+}
+
+Vector3 VertexQuantizer::DecodeOctahedral(const int16_t x, const int16_t y)
+{
+	Vector3 n(max(x / SNORM16_MAX, -1.0f), max(y / SNORM16_MAX, -1.0f), 0.0f);
+	n.z = 1.0f - abs(n.x) - abs(n.y);
+
+	// 아래쪽 반구는 접었던 것을 다시 펼침
+	const float t = max(-n.z, 0.0f);
+	n.x += (n.x >= 0.0f) ? -t : t;
+	n.y += (n.y >= 0.0f) ? -t : t;
+
+	n.Normalize();
+	return n;
+}
+
+Vector3 VertexQuantizer::GetPositionErrorBound(const QuantizationConstants& consts)
+{
+	return consts.positionScale * (0.5f / SNORM16_MAX);
+}
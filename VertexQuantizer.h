@@ -0,0 +1,42 @@
+#pragma once
+
+#include <directxtk/SimpleMath.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "ConstantBuffers.h"
+#include "Vertex.h"
+
+// Vertex -> QuantizedVertex 변환 (SSE2, 4개씩 처리)
+// 오차 상한
+// - position: 축마다 positionScale / 65534 (반올림, Mesh AABB 기준) + float 연산 오차
+// - normal, tangent: 약 1e-4 Radian (Octahedral 16-bit)
+// - texcoord: 상대 오차 2^-11 (FLOAT16)
+class VertexQuantizer {
+public:
+	// Mesh의 AABB가 SNORM 범위 [-1, 1]에 꽉 차도록 Offset(중심)과 Scale(반 크기) 계산
+	static QuantizationConstants ComputeConstants(const Vertex *vertices, const size_t vertexCount);
+
+	static void Quantize(const Vertex *vertices, const size_t vertexCount,
+						 const QuantizationConstants &consts, QuantizedVertex *output);
+
+	static void Quantize(const Vertex *vertices, const size_t vertexCount,
+						 const QuantizationConstants &consts, std::vector<QuantizedVertex> &output);
+
+	// Vertex 하나씩 변환 (tests/TestVertexQuantizer에서 SSE2/F16C 결과와 비교할 때만 사용, 결과는 Bit 단위로 같음)
+	static void QuantizeScalar(const Vertex *vertices, const size_t vertexCount,
+							   const QuantizationConstants &consts, QuantizedVertex *output);
+
+	// Position만 따로 모은 Stream (Depth Only/Shadow Pass용)
+	static void ExtractPositions(const QuantizedVertex *vertices, const size_t vertexCount,
+								 std::vector<QuantizedPosition> &output);
+
+	// Shader(Common.hlsli의 DecodeVertex)와 같은 복원, CPU에서 검증/디버깅용
+	static Vertex Dequantize(const QuantizedVertex &vertex, const QuantizationConstants &consts);
+
+	static DirectX::SimpleMath::Vector3 DecodeOctahedral(const int16_t x, const int16_t y);
+
+	// 축마다 최대 Position 오차
+	static DirectX::SimpleMath::Vector3 GetPositionErrorBound(const QuantizationConstants &consts);
+};
@@ -1,12 +1,23 @@
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <windows.h>
 
 #include "ExampleApp.h"
+#include "Stats.h"
 
 using namespace std;
 
-int main() {
+int main(int argc, char* argv[]) {
+	// --stats: 불러오기/메모리 통계 출력
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--stats") == 0)
+		{
+			g_printStats = true;
+		}
+	}
+
 	ExampleApp exampleApp;
 
 	if (!exampleApp.Initialize())
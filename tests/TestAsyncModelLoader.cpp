@@ -0,0 +1,444 @@
+// LockFreeQueue(여러 Thread가 동시에 Push, 한 Thread만 Pop)와 AsyncModelLoader의 CPU 쪽
+// Render Thread에서만 finish, 예외 전달, Loader가 먼저 사라지는 경우, Placeholder로 첫 프레임을 먼저 그리는지
+// GeometryGenerator::ReadFromFile은 Assimp 없이 테스트하도록 이 파일에서 대신 정의 (PPM Texture를 쓰는 Mesh)
+// Benchmark는 Time to first frame: 다 읽은 뒤 첫 프레임(기존 방식)과 Placeholder로 바로 그리는 방식 비교
+// 사용법: TestAsyncModelLoader [--bench]
+
+#include "AsyncModelLoader.h"
+#include "GeometryGenerator.h"
+#include "LockFreeQueue.h"
+#include "TestCommon.h"
+#include "ThreadPool.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// 파일 하나에 Mesh meshCount개, 각 Mesh는 Albedo와 Normal Texture (basePath의 PPM)
+// fileName이 "<meshCount>.model" 형식이 아니면 실패
+std::vector<MeshData> GeometryGenerator::ReadFromFile(std::string basePath, std::string fileName,
+													  bool reverseNormal)
+{
+	const size_t meshCount = stoul(fileName);
+	if (!filesystem::exists(basePath + fileName))
+	{
+		throw runtime_error("not found: " + basePath + fileName);
+	}
+
+	vector<MeshData> meshes(meshCount);
+	for (size_t i = 0; i < meshCount; i++)
+	{
+		meshes[i].vertices.resize(3 + i);
+		meshes[i].albedoTextureFileName = basePath + "albedo" + to_string(i % 2) + ".ppm";
+		meshes[i].normalTextureFileName = basePath + "normal.ppm";
+	}
+	return meshes;
+}
+
+namespace {
+	void WritePPM(const string& fileName, const int width, const int height, const uint8_t seed)
+	{
+		ofstream file(fileName, ios::binary);
+		file << "P6\n" << width << " " << height << "\n255\n";
+
+		vector<uint8_t> pixels(size_t(width) * height * 3);
+		for (size_t i = 0; i < pixels.size(); i++)
+		{
+			pixels[i] = uint8_t(i * 7 + seed);
+		}
+		file.write((const char*)pixels.data(), pixels.size());
+	}
+
+	void WriteModel(const string& dir, const size_t meshCount, const int textureSize)
+	{
+		filesystem::create_directories(dir);
+		ofstream(dir + to_string(meshCount) + ".model") << meshCount;
+		WritePPM(dir + "albedo0.ppm", textureSize, textureSize, 1);
+		WritePPM(dir + "albedo1.ppm", textureSize, textureSize, 2);
+		WritePPM(dir + "normal.ppm", textureSize, textureSize, 3);
+	}
+
+	bool IsReady(const future<void>& result)
+	{
+		return result.wait_for(chrono::seconds(0)) == future_status::ready;
+	}
+
+	void TestQueue()
+	{
+		// 비어 있으면 실패, Push한 순서대로
+		{
+			LockFreeQueue<int> queue;
+			int value = -1;
+			CHECK(!queue.TryPop(value));
+			queue.Push(1);
+			queue.Push(2);
+			CHECK(queue.TryPop(value) && value == 1);
+			queue.Push(3); // Pop하는 중에 들어온 것은 남은 것 뒤로
+			CHECK(queue.TryPop(value) && value == 2);
+			CHECK(queue.TryPop(value) && value == 3);
+			CHECK(!queue.TryPop(value));
+		}
+
+		// Producer 여러 개가 동시에 Push하는 동안 Pop: 빠지거나 중복 없이, Producer별로는 Push 순서대로
+		for (const int producerCount : { 2, 4, 8 })
+		{
+			const uint32_t perProducer = 200000;
+			LockFreeQueue<uint32_t> queue;
+			atomic<bool> start{ false };
+			atomic<int> running{ producerCount };
+
+			vector<thread> producers;
+			for (int p = 0; p < producerCount; p++)
+			{
+				producers.emplace_back([&, p]() {
+					while (!start)
+					{
+						this_thread::yield();
+					}
+					for (uint32_t i = 0; i < perProducer; i++)
+					{
+						queue.Push((uint32_t(p) << 24) | i);
+					}
+					running--;
+				});
+			}
+
+			// Producer가 모두 끝난 뒤에도 비어 있을 때까지 (빠진 항목이 있어도 멈추지 않음)
+			start = true;
+			vector<uint32_t> next(producerCount, 0);
+			bool ordered = true;
+			size_t popped = 0;
+			while (true)
+			{
+				const bool finished = running == 0;
+				uint32_t value;
+				if (!queue.TryPop(value))
+				{
+					if (finished)
+					{
+						break;
+					}
+					this_thread::yield();
+					continue;
+				}
+
+				const uint32_t p = value >> 24;
+				ordered &= p < uint32_t(producerCount) && (value & 0xFFFFFF) == next[p];
+				if (p < uint32_t(producerCount))
+				{
+					next[p]++;
+				}
+				popped++;
+			}
+
+			for (thread& producer : producers)
+			{
+				producer.join();
+			}
+
+			CHECK(ordered);
+			CHECK(popped == size_t(producerCount) * perProducer);
+		}
+
+		// 소멸자는 남은 항목을 모두 해제 (이동만 되는 타입도)
+		shared_ptr<int> shared = make_shared<int>(7);
+		{
+			LockFreeQueue<shared_ptr<int>> queue;
+			for (int i = 0; i < 100; i++)
+			{
+				queue.Push(shared);
+			}
+			shared_ptr<int> value;
+			CHECK(queue.TryPop(value) && *value == 7);
+		}
+		CHECK(shared.use_count() == 1);
+
+		LockFreeQueue<unique_ptr<int>> uniqueQueue;
+		uniqueQueue.Push(make_unique<int>(5));
+		unique_ptr<int> unique;
+		CHECK(uniqueQueue.TryPop(unique) && *unique == 5);
+	}
+
+	void TestLoader()
+	{
+		const thread::id renderThread = this_thread::get_id();
+
+		// 여러 작업을 동시에, finish는 ProcessCompleted를 부른 Thread에서만
+		AsyncModelLoader loader;
+		vector<future<void>> results;
+		atomic<int> loadsOnRenderThread{ 0 };
+		int finished = 0;
+		bool finishOnRenderThread = true;
+		bool payloadsMatch = true;
+		for (size_t i = 0; i < 16; i++)
+		{
+			results.push_back(loader.LoadAsync(
+				[&, i]() {
+					loadsOnRenderThread += this_thread::get_id() == renderThread;
+					ModelPayload payload;
+					payload.meshes.resize(i + 1);
+					return payload;
+				},
+				[&, i](ModelPayload& payload) {
+					finishOnRenderThread &= this_thread::get_id() == renderThread;
+					payloadsMatch &= payload.meshes.size() == i + 1;
+					finished++;
+				}));
+		}
+		CHECK(loader.GetPendingCount() == 16);
+
+		// maxCount로 한 번에 처리하는 개수 제한
+		bool limited = true;
+		while (loader.GetPendingCount() > 0)
+		{
+			limited &= loader.ProcessCompleted(3) <= 3;
+			this_thread::yield();
+		}
+		CHECK(limited);
+		CHECK(finished == 16);
+		CHECK(finishOnRenderThread);
+		CHECK(payloadsMatch);
+		CHECK(loadsOnRenderThread == 0);
+		bool allReady = true;
+		for (future<void>& result : results)
+		{
+			allReady &= IsReady(result);
+			result.get();
+		}
+		CHECK(allReady);
+		CHECK(loader.ProcessCompleted() == 0);
+
+		// 읽기에서 예외: finish 없이 future로, finish에서 예외: 그 future로, 다른 작업은 그대로
+		bool finishCalled = false;
+		future<void> loadFailed = loader.LoadAsync([]() -> ModelPayload { throw runtime_error("load"); },
+												   [&](ModelPayload&) { finishCalled = true; });
+		future<void> finishFailed = loader.LoadAsync([]() { return ModelPayload(); },
+													 [](ModelPayload&) { throw logic_error("finish"); });
+		future<void> succeeded = loader.LoadAsync([]() { return ModelPayload(); }, [](ModelPayload&) {});
+		while (loader.GetPendingCount() > 0)
+		{
+			loader.ProcessCompleted();
+			this_thread::yield();
+		}
+
+		bool loadCaught = false, finishCaught = false;
+		try
+		{
+			loadFailed.get();
+		}
+		catch (const runtime_error& e)
+		{
+			loadCaught = string(e.what()) == "load";
+		}
+		try
+		{
+			finishFailed.get();
+		}
+		catch (const logic_error& e)
+		{
+			finishCaught = string(e.what()) == "finish";
+		}
+		CHECK(loadCaught);
+		CHECK(finishCaught);
+		CHECK(!finishCalled);
+		CHECK(IsReady(succeeded));
+
+		// Worker가 끝나기 전에 Loader가 사라져도 Push는 안전하고, finish는 불리지 않음 (broken_promise)
+		promise<void> gate;
+		shared_future<void> opened = gate.get_future().share();
+		atomic<bool> loaded{ false };
+		future<void> orphan;
+		{
+			AsyncModelLoader shortLived;
+			orphan = shortLived.LoadAsync(
+				[opened, &loaded]() {
+					opened.wait();
+					loaded = true;
+					return ModelPayload();
+				},
+				[&](ModelPayload&) { finishCalled = true; });
+		}
+		gate.set_value();
+		bool broken = false;
+		try
+		{
+			orphan.get();
+		}
+		catch (const future_error& e)
+		{
+			broken = e.code() == future_errc::broken_promise;
+		}
+		CHECK(broken);
+		CHECK(loaded);
+		CHECK(!finishCalled);
+	}
+
+	void TestLoadModel(const string& dir)
+	{
+		WriteModel(dir, 3, 16);
+
+		// 파일에서 읽은 Mesh와 Decoding한 Texture, 같은 파일은 Mesh끼리 공유
+		AsyncModelLoader loader;
+		ModelPayload loaded;
+		future<void> result = loader.LoadModelAsync(dir, "3.model", true,
+													[&](ModelPayload& payload) { loaded = std::move(payload); });
+		while (loader.GetPendingCount() > 0)
+		{
+			loader.ProcessCompleted();
+			this_thread::yield();
+		}
+		result.get();
+
+		CHECK(loaded.meshes.size() == 3 && loaded.images.size() == 3);
+		CHECK(loaded.meshes.size() == 3 && loaded.meshes[2].vertices.size() == 5);
+		bool decoded = loaded.images.size() == 3;
+		for (size_t i = 0; decoded && i < loaded.images.size(); i++)
+		{
+			decoded &= loaded.images[i].albedo && loaded.images[i].albedo->width == 16;
+			decoded &= loaded.images[i].normal && loaded.images[i].normal->height == 16;
+		}
+		CHECK(decoded);
+		CHECK(decoded && loaded.images[0].albedo == loaded.images[2].albedo);
+		CHECK(decoded && loaded.images[0].normal == loaded.images[1].normal);
+
+		// m_skipImage로 건너뛴 Texture는 nullptr (이미 GPU에 있는 것)
+		const string skippedKey = ImageLoader::MakeKey(dir + "normal.ppm", false);
+		loader.m_skipImage = [&](const string& key) { return key == skippedKey; };
+		result = loader.LoadModelAsync(dir, "3.model", true, [&](ModelPayload& payload) { loaded = std::move(payload); });
+		while (loader.GetPendingCount() > 0)
+		{
+			loader.ProcessCompleted();
+			this_thread::yield();
+		}
+		result.get();
+		CHECK(loaded.images.size() == 3 && !loaded.images[0].normal && loaded.images[0].albedo);
+
+		// 없는 파일: finish 없이 예외
+		bool finishCalled = false;
+		result = loader.LoadModelAsync(dir, "4.model", true, [&](ModelPayload&) { finishCalled = true; });
+		while (loader.GetPendingCount() > 0)
+		{
+			loader.ProcessCompleted();
+			this_thread::yield();
+		}
+		bool caught = false;
+		try
+		{
+			result.get();
+		}
+		catch (const runtime_error&)
+		{
+			caught = true;
+		}
+		CHECK(caught && !finishCalled);
+	}
+
+	// 첫 프레임은 읽기가 끝나기를 기다리지 않고 Placeholder로 (ExampleApp::Initialize와 Update처럼)
+	void TestFirstFrame()
+	{
+		promise<void> gate;
+		shared_future<void> opened = gate.get_future().share();
+
+		AsyncModelLoader loader;
+		bool modelReady = false;
+		future<void> result = loader.LoadAsync(
+			[opened]() {
+				opened.wait();
+				return ModelPayload();
+			},
+			[&](ModelPayload&) { modelReady = true; });
+
+		// 읽기가 막혀 있어도 프레임이 진행됨
+		int placeholderFrames = 0;
+		for (int frame = 0; frame < 3; frame++)
+		{
+			loader.ProcessCompleted();
+			placeholderFrames += !modelReady;
+		}
+		CHECK(placeholderFrames == 3);
+		CHECK(loader.GetPendingCount() == 1);
+
+		gate.set_value();
+		while (!modelReady)
+		{
+			loader.ProcessCompleted();
+			this_thread::yield();
+		}
+		CHECK(IsReady(result));
+		CHECK(loader.GetPendingCount() == 0);
+	}
+
+	void Benchmark(const string& dir)
+	{
+		// 큰 Texture 여러 장을 Decoding하는 Model (Worker에서 하는 일이 대부분)
+		const size_t meshCount = 6;
+		const int textureSize = 2048;
+		WriteModel(dir, meshCount, textureSize);
+		const string fileName = to_string(meshCount) + ".model";
+
+		// 프레임 하나를 그리는 대신 (약 60fps)
+		auto renderFrame = []() { this_thread::sleep_for(chrono::milliseconds(16)); };
+
+		// 기존 방식: 다 읽은 뒤에 첫 프레임
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		ModelPayload payload = AsyncModelLoader::ReadModel(dir, fileName, true);
+		renderFrame();
+		const chrono::duration<double, milli> syncFirstFrame = chrono::steady_clock::now() - start;
+		payload = ModelPayload();
+
+		// 비동기: Placeholder로 바로 첫 프레임, Model은 준비되는 프레임부터
+		// (위 payload를 해제했으므로 Decoding Cache도 비어 있음)
+		start = chrono::steady_clock::now();
+		AsyncModelLoader loader;
+		bool modelReady = false;
+		chrono::duration<double, milli> asyncReady(0.0);
+		future<void> result = loader.LoadModelAsync(dir, fileName, true, [&](ModelPayload&) {
+			modelReady = true;
+			asyncReady = chrono::steady_clock::now() - start;
+		});
+
+		chrono::duration<double, milli> asyncFirstFrame(0.0);
+		int placeholderFrames = 0;
+		while (!modelReady)
+		{
+			loader.ProcessCompleted();
+			renderFrame();
+			if (placeholderFrames++ == 0)
+			{
+				asyncFirstFrame = chrono::steady_clock::now() - start;
+			}
+		}
+		result.get();
+
+		cout << meshCount << " meshes, " << 3 << " textures " << textureSize << "x" << textureSize << ", "
+			 << ThreadPool::GetInstance().GetThreadCount() << " workers" << endl;
+		cout << "Time to first frame: sync " << syncFirstFrame.count() << " ms, async " << asyncFirstFrame.count()
+			 << " ms (model ready " << asyncReady.count() << " ms, " << placeholderFrames << " placeholder frames)"
+			 << endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const string dir = (filesystem::temp_directory_path() / "TestAsyncModelLoader").string() + "/";
+	filesystem::remove_all(dir);
+
+	TestQueue();
+	TestLoader();
+	TestLoadModel(dir);
+	TestFirstFrame();
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark(dir);
+	}
+
+	filesystem::remove_all(dir);
+	return ReportChecks("TestAsyncModelLoader");
+}
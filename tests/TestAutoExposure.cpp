@@ -0,0 +1,217 @@
+// LuminanceHistogram과 AutoExposure (Frame의 fp16 이미지 -> Histogram -> Exposure)
+// 사용법: TestAutoExposure [--bench]
+
+#include "AutoExposure.h"
+#include "PixelConverter.h"
+#include "TestCommon.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	// 회색 Pixel들 (Luminance = value), rowPitch에는 Histogram에 들어가면 안 되는 값을 채움
+	vector<uint16_t> MakeImage(const vector<float>& values, const size_t width, const size_t rowPitch)
+	{
+		const size_t height = values.size() / width;
+		vector<float> rgba(rowPitch / 2 * height, 1e6f);
+		for (size_t y = 0; y < height; y++)
+		{
+			for (size_t x = 0; x < width; x++)
+			{
+				float* pixel = &rgba[y * rowPitch / 2 + x * 4];
+				pixel[0] = pixel[1] = pixel[2] = values[y * width + x];
+				pixel[3] = 1.0f;
+			}
+		}
+
+		vector<uint16_t> halfs(rgba.size());
+		PixelConverter::FloatToHalf(rgba.data(), rgba.size(), halfs.data());
+		return halfs;
+	}
+
+	float BinCenter(const LuminanceHistogram& histogram, const int bin)
+	{
+		const float binSize = (histogram.maxLog2 - histogram.minLog2) / float(LuminanceHistogram::binCount);
+		return histogram.minLog2 + (float(bin) + 0.5f) * binSize;
+	}
+
+	int BinOf(const LuminanceHistogram& histogram, const float log2Luminance)
+	{
+		const float binSize = (histogram.maxLog2 - histogram.minLog2) / float(LuminanceHistogram::binCount);
+		return int((log2Luminance - histogram.minLog2) / binSize);
+	}
+
+	void TestHistogram()
+	{
+		// 4x2, 한 줄 뒤에 2 Pixel만큼 빈 공간 (Map한 Staging Texture처럼)
+		const size_t width = 4;
+		const size_t rowPitch = (width + 2) * 8;
+		const vector<float> values = { 1.0f, 1.0f, 1.0f, 1.0f, 0.25f, 0.25f, 1e-6f, 1e6f };
+
+		LuminanceHistogram histogram;
+		histogram.Add(MakeImage(values, width, rowPitch).data(), width, 2, rowPitch);
+
+		CHECK(histogram.pixelCount == 8);
+		CHECK(histogram.bins[BinOf(histogram, 0.0f)] == 4);
+		CHECK(histogram.bins[BinOf(histogram, -2.0f)] == 2);
+		CHECK(histogram.bins[0] == 1);								  // 범위보다 어두우면 첫 bin
+		CHECK(histogram.bins[LuminanceHistogram::binCount - 1] == 1); // 범위보다 밝으면 마지막 bin
+
+		uint32_t total = 0;
+		for (const uint32_t count : histogram.bins)
+		{
+			total += count;
+		}
+		CHECK(total == 8); // 줄 사이의 빈 공간은 세지 않음
+
+		// fp16으로 바뀐 값 기준 (1e6은 fp16에서 Inf)
+		CHECK(histogram.minLuminance > 0.0f && histogram.minLuminance < 1e-5f);
+		CHECK(histogram.maxLuminance > 60000.0f);
+
+		// 양 끝을 빼면 1.0 4개와 0.25 2개 중에서
+		const float trimmed = histogram.GetAverageLog2(1.0f / 8.0f, 7.0f / 8.0f);
+		const float expected = (4.0f * BinCenter(histogram, BinOf(histogram, 0.0f)) +
+								2.0f * BinCenter(histogram, BinOf(histogram, -2.0f))) /
+							   6.0f;
+		CHECK(fabs(trimmed - expected) < 1e-4f);
+
+		// 어두운 쪽 절반, 밝은 쪽 절반
+		const float centerOfOne = BinCenter(histogram, BinOf(histogram, 0.0f));
+		CHECK(histogram.GetAverageLog2(0.0f, 0.25f) < -2.0f);
+		CHECK(fabs(histogram.GetAverageLog2(0.5f, 0.875f) - centerOfOne) < 1e-4f);
+
+		// low == high이면 그 위치의 bin 하나
+		CHECK(histogram.GetAverageLog2(0.5f, 0.5f) == centerOfOne);
+
+		// NaN과 음수는 0 (첫 bin)
+		LuminanceHistogram invalid;
+		invalid.Add(MakeImage({ NAN, -1.0f }, 2, 16).data(), 2, 1, 16);
+		CHECK(invalid.pixelCount == 2 && invalid.bins[0] == 2);
+		CHECK(invalid.minLuminance == 0.0f && invalid.maxLuminance == 0.0f);
+
+		// Add는 누적, Clear는 처음으로
+		histogram.Add(MakeImage({ 1.0f }, 1, 8).data(), 1, 1, 8);
+		CHECK(histogram.pixelCount == 9 && histogram.bins[BinOf(histogram, 0.0f)] == 5);
+		histogram.Clear();
+		CHECK(histogram.pixelCount == 0 && histogram.bins[BinOf(histogram, 0.0f)] == 0);
+		CHECK(histogram.GetAverageLog2(0.0f, 1.0f) == 0.0f);
+	}
+
+	void TestAutoExposure()
+	{
+		// 평균 Luminance 0.18이면 Exposure 1 (bin 크기만큼 오차)
+		LuminanceHistogram histogram;
+		histogram.Add(MakeImage(vector<float>(64, 0.18f), 8, 64).data(), 8, 8, 64);
+
+		AutoExposure exposure;
+		const float binSize = (histogram.maxLog2 - histogram.minLog2) / float(LuminanceHistogram::binCount);
+		CHECK(fabs(log2(exposure.GetTargetExposure(histogram))) <= binSize);
+
+		exposure.m_compensation = 1.0f;
+		CHECK(fabs(log2(exposure.GetTargetExposure(histogram)) - 1.0f) <= binSize);
+		exposure.m_compensation = 0.0f;
+
+		// 최소/최대 Exposure로 제한
+		LuminanceHistogram bright;
+		bright.Add(MakeImage(vector<float>(4, 1000.0f), 2, 16).data(), 2, 2, 16);
+		CHECK(exposure.GetTargetExposure(bright) == exposure.m_minExposure);
+
+		// Histogram이 비어 있으면 그대로
+		exposure.Reset(2.0f);
+		CHECK(exposure.Update(LuminanceHistogram(), 1.0f) == 2.0f);
+
+		// 시간이 지나면 목표에 수렴
+		const float target = exposure.GetTargetExposure(bright);
+		for (int i = 0; i < 600; i++)
+		{
+			exposure.Update(bright, 1.0f / 60.0f);
+		}
+		CHECK(fabs(exposure.GetExposure() - target) < 1e-3f * target);
+
+		// Frame Rate와 무관 (30fps 15번 == 60fps 30번)
+		AutoExposure at30;
+		AutoExposure at60;
+		for (int i = 0; i < 30; i++)
+		{
+			if (i < 15)
+			{
+				at30.Update(bright, 1.0f / 30.0f);
+			}
+			at60.Update(bright, 1.0f / 60.0f);
+		}
+		CHECK(fabs(at30.GetExposure() - at60.GetExposure()) < 1e-4f * at60.GetExposure());
+		CHECK(at60.GetExposure() < 1.0f && at60.GetExposure() > target);
+
+		// 어두우면 Exposure를 올림
+		LuminanceHistogram dark;
+		dark.Add(MakeImage(vector<float>(4, 0.18f / 8.0f), 2, 16).data(), 2, 2, 16);
+		const float middle = exposure.GetTargetExposure(histogram);
+		CHECK(fabs(log2(exposure.GetTargetExposure(dark) / middle) - 3.0f) <= 2.0f * binSize);
+
+		// 같은 EV 차이라도 Exposure를 올릴 때(m_speedUp)가 내릴 때(m_speedDown)보다 빠름
+		AutoExposure up;
+		AutoExposure down;
+		up.Reset(middle / 8.0f);
+		down.Reset(middle * 8.0f);
+		up.Update(histogram, 0.1f);
+		down.Update(histogram, 0.1f);
+		CHECK(log2(up.GetExposure() * 8.0f / middle) > log2(middle * 8.0f / down.GetExposure()));
+	}
+
+	void Benchmark()
+	{
+		struct Size {
+			const char* name;
+			size_t width;
+			size_t height;
+		};
+		// 720p, 4K 전체와 PostProcess가 실제로 읽어오는 1/8 크기
+		const Size sizes[] = {
+			{ "1280x720", 1280, 720 },
+			{ "3840x2160", 3840, 2160 },
+			{ "160x90 (720p readback)", 160, 90 },
+			{ "480x270 (4K readback)", 480, 270 },
+		};
+
+		const PixelConverter::SimdLevel maxLevel = PixelConverter::GetSimdLevel();
+		for (const Size& size : sizes)
+		{
+			vector<float> values(size.width * size.height);
+			for (size_t i = 0; i < values.size(); i++)
+			{
+				values[i] = exp2(float(i % 4096) / 256.0f - 10.0f);
+			}
+			const vector<uint16_t> image = MakeImage(values, size.width, size.width * 8);
+
+			LuminanceHistogram histogram;
+			auto run = [&]() {
+				histogram.Clear();
+				histogram.Add(image.data(), size.width, size.height, size.width * 8);
+			};
+
+			PixelConverter::SetSimdLevel(PixelConverter::SimdLevel::Scalar);
+			const double scalarMs = MeasureMs(run);
+			PixelConverter::SetSimdLevel(maxLevel);
+			const double simdMs = MeasureMs(run);
+
+			cout << size.name << ": Scalar " << scalarMs << " ms, "
+				 << (maxLevel == PixelConverter::SimdLevel::AVX2 ? "F16C " : "(no F16C) ") << simdMs << " ms"
+				 << endl;
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	TestHistogram();
+	TestAutoExposure();
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark();
+	}
+
+	return ReportChecks("TestAutoExposure");
+}
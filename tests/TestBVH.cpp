@@ -0,0 +1,606 @@
+// BVH (Build, Refit, Traverse)와 MeshBVH의 Ray 검사가 모든 것을 하나씩 검사한 결과와 같은지
+// SceneBVH는 D3D11 자원이 없는 TestModel(World 행렬, 경계, MeshBVH만)로 검사
+// (움직이지 않고 Mesh만 바꿔도, 예를 들어 Placeholder를 읽은 Model로 교체해도 Refit 후 Picking이 맞는지)
+// Scene Benchmark는 SceneBVH와 같은 방식(Model마다 Box 하나, Leaf에서 Model Space로 옮겨 MeshBVH 검사)
+// 사용법: TestBVH [--bench]
+
+#include "BVH.h"
+#include "MeshBVH.h"
+#include "MeshData.h"
+#include "SceneBVH.h"
+#include "TestCommon.h"
+
+#include <DirectXCollision.h>
+
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	// 반지름 1 근처의 울퉁불퉁한 구 (segments * segments * 4개 삼각형)
+	void MakeSphere(const int segments, const float noise, mt19937& random, vector<Vertex>& vertices,
+					vector<uint32_t>& indices)
+	{
+		uniform_real_distribution<float> offset(-noise, noise);
+		const int columns = segments * 2 + 1;
+		for (int i = 0; i <= segments; i++)
+		{
+			for (int j = 0; j < columns; j++)
+			{
+				const float theta = XM_PI * float(i) / float(segments);
+				const float phi = XM_PI * float(j) / float(segments);
+				const float radius = 1.0f + offset(random);
+
+				Vertex v = {};
+				v.position = Vector3(radius * sin(theta) * cos(phi), radius * cos(theta), radius * sin(theta) * sin(phi));
+				vertices.push_back(v);
+			}
+		}
+
+		for (int i = 0; i < segments; i++)
+		{
+			for (int j = 0; j < segments * 2; j++)
+			{
+				const uint32_t a = i * columns + j;
+				const uint32_t c = a + columns;
+				indices.insert(indices.end(), { a, c, a + 1, a + 1, c, c + 1 });
+			}
+		}
+	}
+
+	// 방향은 정규화하지 않음 (SceneBVH가 Model Space로 옮긴 Ray처럼)
+	void MakeRay(mt19937& random, const float spread, Vector3& origin, Vector3& dir)
+	{
+		uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		origin = Vector3(unit(random) * spread, unit(random) * spread, -4.0f);
+		dir = Vector3(unit(random) * 0.5f, unit(random) * 0.5f, 1.0f) * (0.5f + unit(random) * 0.25f);
+	}
+
+	void TestMeshBVH()
+	{
+		mt19937 random(1);
+		for (const int segments : { 1, 3, 20, 60 })
+		{
+			vector<Vertex> vertices;
+			vector<uint32_t> indices;
+			MakeSphere(segments, 0.05f, random, vertices, indices);
+
+			MeshBVH bvh;
+			bvh.Build(vertices.data(), vertices.size(), indices.data(), indices.size());
+			CHECK(!bvh.IsEmpty() && bvh.GetTriangleCount() == indices.size() / 3);
+
+			int hitCount = 0;
+			int closestMismatch = 0;
+			int anyMismatch = 0;
+			int pointMismatch = 0;
+			for (int r = 0; r < 500; r++)
+			{
+				Vector3 origin, dir;
+				MakeRay(random, 2.0f, origin, dir);
+
+				RayHit hit;
+				RayHit expected;
+				const bool isHit = bvh.IntersectClosest(origin, dir, hit);
+				const bool isExpected = bvh.IntersectClosestBruteForce(origin, dir, expected);
+				hitCount += isHit;
+				closestMismatch += isHit != isExpected || hit.distance != expected.distance;
+
+				// 가장 가까운 교차 바로 앞까지는 없고, 바로 뒤까지는 있음
+				anyMismatch += bvh.IntersectAny(origin, dir) != isExpected;
+				if (isExpected)
+				{
+					anyMismatch += bvh.IntersectAny(origin, dir, expected.distance * 0.999f);
+					anyMismatch += !bvh.IntersectAny(origin, dir, expected.distance * 1.001f);
+				}
+
+				// 기록한 삼각형과 Barycentric이 교차 지점
+				if (isHit)
+				{
+					const Vector3& p0 = vertices[indices[hit.triangle * 3 + 0]].position;
+					const Vector3& p1 = vertices[indices[hit.triangle * 3 + 1]].position;
+					const Vector3& p2 = vertices[indices[hit.triangle * 3 + 2]].position;
+					const Vector3 onTriangle = p0 * (1.0f - hit.u - hit.v) + p1 * hit.u + p2 * hit.v;
+					pointMismatch += (onTriangle - (origin + dir * hit.distance)).Length() > 1e-4f;
+				}
+			}
+			CHECK(hitCount > 50 || segments == 1);
+			CHECK(closestMismatch == 0);
+			CHECK(anyMismatch == 0);
+			CHECK(pointMismatch == 0);
+		}
+
+		// hit.distance보다 먼 교차는 기록하지 않음
+		vector<Vertex> vertices;
+		vector<uint32_t> indices;
+		MakeSphere(10, 0.0f, random, vertices, indices);
+		MeshBVH bvh;
+		bvh.Build(vertices.data(), vertices.size(), indices.data(), indices.size());
+		const Vector3 origin(0.01f, 0.02f, -4.0f);
+		const Vector3 dir(0.0f, 0.0f, 1.0f);
+		RayHit hit;
+		hit.distance = 2.0f;
+		CHECK(!bvh.IntersectClosest(origin, dir, hit));
+		CHECK(!hit.IsHit() && hit.distance == 2.0f);
+		hit = RayHit();
+		CHECK(bvh.IntersectClosest(origin, dir, hit));
+		CHECK(fabs(hit.distance - 3.0f) < 0.02f);
+
+		// 빈 Mesh
+		MeshBVH empty;
+		empty.Build(vertices.data(), 0, indices.data(), 0);
+		RayHit none;
+		CHECK(empty.IsEmpty());
+		CHECK(!empty.IntersectClosest(origin, dir, none));
+		CHECK(!empty.IntersectAny(origin, dir));
+	}
+
+	void MakeBoxes(mt19937& random, const size_t count, const float extent, vector<BVHBox>& boxes)
+	{
+		uniform_real_distribution<float> position(-extent, extent);
+		uniform_real_distribution<float> size(0.1f, 2.0f);
+		boxes.resize(count);
+		for (BVHBox& box : boxes)
+		{
+			const Vector3 center(position(random), position(random), position(random));
+			const Vector3 half(size(random), size(random), size(random));
+			box.boxMin = center - half;
+			box.boxMax = center + half;
+		}
+	}
+
+	bool Contains(const XMFLOAT3& outerMin, const XMFLOAT3& outerMax, const XMFLOAT3& innerMin,
+				  const XMFLOAT3& innerMax)
+	{
+		return outerMin.x <= innerMin.x && outerMin.y <= innerMin.y && outerMin.z <= innerMin.z &&
+			   outerMax.x >= innerMax.x && outerMax.y >= innerMax.y && outerMax.z >= innerMax.z;
+	}
+
+	// 모든 Node가 자식(Leaf는 Primitive)을 감싸고, 모든 Primitive가 한 번씩 있는지
+	bool IsValidTree(const vector<BVHBox>& boxes, const vector<BVHNode>& nodes, const vector<uint32_t>& order)
+	{
+		vector<int> seen(boxes.size(), 0);
+		for (const BVHNode& node : nodes)
+		{
+			if (node.IsLeaf())
+			{
+				for (uint32_t k = node.leftFirst; k < node.leftFirst + node.count; k++)
+				{
+					const BVHBox& box = boxes[order[k]];
+					if (!Contains(node.boxMin, node.boxMax, box.boxMin, box.boxMax))
+					{
+						return false;
+					}
+					seen[order[k]]++;
+				}
+				continue;
+			}
+
+			for (const uint32_t child : { node.leftFirst, node.leftFirst + 1 })
+			{
+				if (!Contains(node.boxMin, node.boxMax, nodes[child].boxMin, nodes[child].boxMax))
+				{
+					return false;
+				}
+			}
+		}
+		return all_of(seen.begin(), seen.end(), [](int count) { return count == 1; });
+	}
+
+	// Ray가 지나가는 Box들 (Traverse는 leaf를 모두 방문하도록 maxDistance를 줄이지 않음)
+	vector<uint32_t> TraverseBoxes(const vector<BVHBox>& boxes, const vector<BVHNode>& nodes,
+								   const vector<uint32_t>& order, const BVHRay& ray)
+	{
+		vector<uint32_t> result;
+		float maxDistance = FLT_MAX;
+		BVH::Traverse(nodes, ray, maxDistance, [&](const BVHNode& leaf, float&) {
+			for (uint32_t k = leaf.leftFirst; k < leaf.leftFirst + leaf.count; k++)
+			{
+				BVHNode single = {};
+				single.boxMin = boxes[order[k]].boxMin;
+				single.boxMax = boxes[order[k]].boxMax;
+				if (ray.IntersectBox(single, FLT_MAX) != FLT_MAX)
+				{
+					result.push_back(order[k]);
+				}
+			}
+			return false;
+		});
+		sort(result.begin(), result.end());
+		return result;
+	}
+
+	vector<uint32_t> BruteForceBoxes(const vector<BVHBox>& boxes, const BVHRay& ray)
+	{
+		vector<uint32_t> result;
+		for (uint32_t i = 0; i < boxes.size(); i++)
+		{
+			BVHNode single = {};
+			single.boxMin = boxes[i].boxMin;
+			single.boxMax = boxes[i].boxMax;
+			if (ray.IntersectBox(single, FLT_MAX) != FLT_MAX)
+			{
+				result.push_back(i);
+			}
+		}
+		return result;
+	}
+
+	void TestRefit()
+	{
+		mt19937 random(2);
+		for (const size_t count : { size_t(1), size_t(2), size_t(7), size_t(500), size_t(5000) })
+		{
+			vector<BVHBox> boxes;
+			MakeBoxes(random, count, 50.0f, boxes);
+
+			BVH::Settings settings;
+			settings.maxLeafSize = 2;
+			vector<BVHNode> nodes;
+			vector<uint32_t> order;
+			BVH::Build(boxes, settings, nodes, order);
+			CHECK(IsValidTree(boxes, nodes, order));
+
+			// 모두 움직인 뒤 Refit: 구조는 그대로, 경계는 새 위치를 감쌈
+			const vector<BVHNode> built = nodes;
+			const vector<uint32_t> builtOrder = order;
+			uniform_real_distribution<float> move(-20.0f, 20.0f);
+			for (BVHBox& box : boxes)
+			{
+				const Vector3 offset(move(random), move(random), move(random));
+				box.boxMin = Vector3(box.boxMin) + offset;
+				box.boxMax = Vector3(box.boxMax) + offset;
+			}
+			BVH::Refit(boxes, order, nodes);
+			CHECK(IsValidTree(boxes, nodes, order));
+			CHECK(order == builtOrder && nodes.size() == built.size());
+
+			bool sameStructure = true;
+			for (size_t i = 0; i < nodes.size(); i++)
+			{
+				sameStructure &= nodes[i].leftFirst == built[i].leftFirst && nodes[i].count == built[i].count;
+			}
+			CHECK(sameStructure);
+
+			// Refit한 Tree로도 Ray가 지나가는 Box를 모두 찾음
+			int mismatch = 0;
+			for (int r = 0; r < 200; r++)
+			{
+				Vector3 origin, dir;
+				MakeRay(random, 60.0f, origin, dir);
+				origin.z = -100.0f;
+				const BVHRay ray(origin, dir);
+				mismatch += TraverseBoxes(boxes, nodes, order, ray) != BruteForceBoxes(boxes, ray);
+			}
+			CHECK(mismatch == 0);
+		}
+
+		// 빈 Box(경계 없는 Model)는 부모를 키우지 않음
+		vector<BVHBox> boxes(3);
+		boxes[0] = { XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(1.0f, 1.0f, 1.0f) };
+		boxes[1] = { XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX), XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX) };
+		boxes[2] = { XMFLOAT3(4.0f, 0.0f, 0.0f), XMFLOAT3(5.0f, 1.0f, 1.0f) };
+		vector<BVHNode> nodes;
+		vector<uint32_t> order;
+		BVH::Settings settings;
+		settings.maxLeafSize = 1;
+		BVH::Build(boxes, settings, nodes, order);
+		BVH::Refit(boxes, order, nodes);
+		CHECK(nodes[0].boxMin.x == 0.0f && nodes[0].boxMax.x == 5.0f && nodes[0].boxMax.y == 1.0f);
+
+		// 비어 있으면 Node도 없음
+		BVH::Build(vector<BVHBox>(), settings, nodes, order);
+		CHECK(nodes.empty() && order.empty());
+		BVH::Refit(vector<BVHBox>(), order, nodes);
+	}
+
+	// SceneBVH가 사용하는 것만 있는 Model
+	struct TestModel {
+		bool IntersectRay(const Vector3& origin, const Vector3& dir, RayHit& hit) const
+		{
+			return mesh && mesh->IntersectClosest(origin, dir, hit);
+		}
+		bool IntersectRayAny(const Vector3& origin, const Vector3& dir, const float maxDistance) const
+		{
+			return mesh && mesh->IntersectAny(origin, dir, maxDistance);
+		}
+
+		// Model::InitializeShared()처럼 Mesh와 경계를 함께 바꾸고 m_geometryVersion 증가
+		void SetMesh(const MeshBVH* newMesh, const float radius)
+		{
+			mesh = newMesh;
+			m_bounds = MeshBounds();
+			if (newMesh)
+			{
+				// SceneBVH는 AABB만 사용
+				m_bounds.box = BoundingBox(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(radius, radius, radius));
+				m_bounds.isValid = true;
+			}
+			m_geometryVersion++;
+		}
+
+		Matrix m_worldRow;
+		MeshBounds m_bounds;
+		uint32_t m_geometryVersion = 0;
+		const MeshBVH* mesh = nullptr;
+	};
+
+	void TestSceneBVH()
+	{
+		mt19937 random(4);
+		vector<Vertex> smallVertices, largeVertices;
+		vector<uint32_t> smallIndices, largeIndices;
+		MakeSphere(12, 0.0f, random, smallVertices, smallIndices);
+		MakeSphere(12, 0.0f, random, largeVertices, largeIndices);
+		for (Vertex& v : largeVertices)
+		{
+			v.position *= 3.0f;
+		}
+		MeshBVH smallMesh, largeMesh;
+		smallMesh.Build(smallVertices.data(), smallVertices.size(), smallIndices.data(), smallIndices.size());
+		largeMesh.Build(largeVertices.data(), largeVertices.size(), largeIndices.data(), largeIndices.size());
+
+		// x축으로 10씩 떨어진 반지름 1인 구 3개
+		vector<TestModel> models(3);
+		vector<const TestModel*> pointers;
+		for (size_t i = 0; i < models.size(); i++)
+		{
+			models[i].m_worldRow = Matrix::CreateTranslation(Vector3(float(i) * 10.0f, 0.0f, 0.0f));
+			models[i].SetMesh(&smallMesh, 1.0f);
+			pointers.push_back(&models[i]);
+		}
+
+		BasicSceneBVH<TestModel> scene;
+		scene.Build(ArrayView<const TestModel* const>(pointers.data(), pointers.size()));
+		CHECK(scene.GetObjectCount() == 3 && scene.GetModel(1) == &models[1]);
+
+		auto pick = [&](const Vector3& origin, const Vector3& dir) {
+			RayHit hit;
+			scene.IntersectClosest(Ray(origin, dir), hit);
+			return hit;
+		};
+
+		// 구 1의 중심에서 y로 2 떨어진 곳은 빈 공간
+		const Vector3 down(0.0f, -1.0f, 0.0f);
+		const Vector3 aboveOffset(10.0f, 2.0f, -10.0f);
+		const Vector3 forward(0.0f, 0.0f, 1.0f);
+		RayHit hit = pick(Vector3(10.0f, 0.0f, -10.0f), forward);
+		CHECK(hit.object == 1 && fabs(hit.distance - 9.0f) < 0.02f);
+		CHECK(!pick(aboveOffset, forward).IsHit());
+		CHECK(scene.IntersectAny(Ray(Vector3(20.0f, 0.0f, -10.0f), forward)));
+		CHECK(!scene.IntersectAny(Ray(Vector3(20.0f, 0.0f, -10.0f), forward), 8.5f));
+
+		// 움직인 Model: Refit 후 새 위치에서 찾음
+		models[2].m_worldRow = Matrix::CreateTranslation(Vector3(30.0f, 0.0f, 0.0f));
+		scene.Refit();
+		CHECK(!pick(Vector3(20.0f, 0.0f, -10.0f), forward).IsHit());
+		CHECK(pick(Vector3(30.0f, 0.0f, -10.0f), forward).object == 2);
+
+		// 움직이지 않고 Mesh만 더 큰 것으로 교체 (Placeholder -> 읽은 Model)
+		// World 행렬이 그대로여도 경계를 다시 읽어야 커진 부분을 찾음
+		models[1].SetMesh(&largeMesh, 3.0f);
+		scene.Refit();
+		hit = pick(aboveOffset, forward);
+		CHECK(hit.object == 1 && fabs(hit.distance - (10.0f - sqrt(5.0f))) < 0.05f);
+		CHECK(pick(Vector3(10.0f, 5.0f, 0.0f), down).object == 1);
+		CHECK(scene.IntersectAny(Ray(aboveOffset, forward)));
+
+		// 경계가 없는 Model(아직 Mesh 없음)은 건너뛰고, Mesh가 생기면 찾음
+		models[0].SetMesh(nullptr, 0.0f);
+		scene.Refit();
+		CHECK(!pick(Vector3(0.0f, 0.0f, -10.0f), forward).IsHit());
+		CHECK(!scene.IntersectAny(Ray(Vector3(0.0f, 0.0f, -10.0f), forward)));
+		models[0].SetMesh(&smallMesh, 1.0f);
+		scene.Refit();
+		CHECK(pick(Vector3(0.0f, 0.0f, -10.0f), forward).object == 0);
+
+		// 다시 작은 Mesh로: 예전 경계로 찾지 않음
+		models[1].SetMesh(&smallMesh, 1.0f);
+		scene.Refit();
+		CHECK(!pick(aboveOffset, forward).IsHit());
+
+		// Build와 같은 결과
+		BasicSceneBVH<TestModel> rebuilt;
+		rebuilt.Build(ArrayView<const TestModel* const>(pointers.data(), pointers.size()));
+		int mismatch = 0;
+		uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		for (int r = 0; r < 200; r++)
+		{
+			const Ray ray(Vector3(unit(random) * 5.0f + 15.0f, unit(random) * 4.0f, -10.0f),
+						  Vector3(unit(random), unit(random) * 0.2f, 1.0f));
+			RayHit a, b;
+			scene.IntersectClosest(ray, a);
+			rebuilt.IntersectClosest(ray, b);
+			mismatch += a.object != b.object || a.distance != b.distance;
+		}
+		CHECK(mismatch == 0);
+	}
+
+	// SceneBVH와 같은 구성: Model마다 World 행렬과 Model Space Box, 공유하는 MeshBVH
+	struct SceneObject {
+		Matrix worldRow;
+		Matrix worldToModel;
+	};
+
+	void UpdateBox(const SceneObject& object, const BoundingBox& box, BVHBox& worldBox)
+	{
+		const Matrix& m = object.worldRow;
+		const Vector3 center = Vector3::Transform(Vector3(box.Center), m);
+		const Vector3 extents(fabs(m._11) * box.Extents.x + fabs(m._21) * box.Extents.y + fabs(m._31) * box.Extents.z,
+							  fabs(m._12) * box.Extents.x + fabs(m._22) * box.Extents.y + fabs(m._32) * box.Extents.z,
+							  fabs(m._13) * box.Extents.x + fabs(m._23) * box.Extents.y + fabs(m._33) * box.Extents.z);
+		worldBox.boxMin = center - extents;
+		worldBox.boxMax = center + extents;
+	}
+
+	bool PickScene(const vector<SceneObject>& objects, const MeshBVH& mesh, const vector<BVHNode>& nodes,
+				   const vector<uint32_t>& order, const Vector3& origin, const Vector3& dir, RayHit& hit)
+	{
+		bool found = false;
+		float maxDistance = hit.distance;
+		BVH::Traverse(nodes, BVHRay(origin, dir), maxDistance, [&](const BVHNode& leaf, float& distance) {
+			for (uint32_t k = leaf.leftFirst; k < leaf.leftFirst + leaf.count; k++)
+			{
+				const SceneObject& object = objects[order[k]];
+				if (mesh.IntersectClosest(Vector3::Transform(origin, object.worldToModel),
+										  Vector3::TransformNormal(dir, object.worldToModel), hit))
+				{
+					hit.object = order[k];
+					distance = hit.distance;
+					found = true;
+				}
+			}
+			return false;
+		});
+		return found;
+	}
+
+	void Benchmark()
+	{
+		mt19937 random(3);
+
+		for (const int segments : { 50, 150, 400 })
+		{
+			vector<Vertex> vertices;
+			vector<uint32_t> indices;
+			MakeSphere(segments, 0.05f, random, vertices, indices);
+
+			MeshBVH bvh;
+			const double buildMs = MeasureMs(
+				[&]() { bvh.Build(vertices.data(), vertices.size(), indices.data(), indices.size()); }, 3);
+
+			const int rayCount = 1000;
+			vector<Vector3> origins(rayCount), dirs(rayCount);
+			for (int r = 0; r < rayCount; r++)
+			{
+				MakeRay(random, 2.0f, origins[r], dirs[r]);
+			}
+			const double bvhMs = MeasureMs([&]() {
+				for (int r = 0; r < rayCount; r++)
+				{
+					RayHit hit;
+					bvh.IntersectClosest(origins[r], dirs[r], hit);
+				}
+			});
+			const double bruteMs = MeasureMs(
+				[&]() {
+					for (int r = 0; r < rayCount; r += 10)
+					{
+						RayHit hit;
+						bvh.IntersectClosestBruteForce(origins[r], dirs[r], hit);
+					}
+				},
+				1);
+
+			cout << "Mesh " << bvh.GetTriangleCount() << " triangles: Build " << buildMs << " ms ("
+				 << bvh.GetMemorySize() / 1024 << " KB), IntersectClosest " << bvhMs * 1000.0 / rayCount
+				 << " us/ray, BruteForce " << bruteMs * 1000.0 / (rayCount / 10) << " us/ray" << endl;
+		}
+
+		// 수천 개 Model: 처음 Build, 이후 Picking은 Refit(하나만 움직임) + 가장 가까운 교차
+		vector<Vertex> vertices;
+		vector<uint32_t> indices;
+		MakeSphere(30, 0.02f, random, vertices, indices);
+		MeshBVH mesh;
+		mesh.Build(vertices.data(), vertices.size(), indices.data(), indices.size());
+		const BoundingBox modelBox(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(1.05f, 1.05f, 1.05f));
+
+		uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		for (const int count : { 1000, 5000, 20000 })
+		{
+			const int side = int(ceil(cbrt(float(count))));
+			vector<SceneObject> objects(count);
+			vector<BVHBox> boxes(count);
+			for (int i = 0; i < count; i++)
+			{
+				const Vector3 position(float(i % side) * 3.0f + unit(random), float(i / side % side) * 3.0f + unit(random),
+									   float(i / side / side) * 3.0f + unit(random));
+				objects[i].worldRow = Matrix::CreateScale(0.5f + 0.2f * unit(random)) * Matrix::CreateTranslation(position);
+			}
+
+			BVH::Settings settings;
+			settings.maxLeafSize = 2;
+			vector<BVHNode> nodes;
+			vector<uint32_t> order;
+			const double buildMs = MeasureMs([&]() {
+				for (int i = 0; i < count; i++)
+				{
+					objects[i].worldToModel = objects[i].worldRow.Invert();
+					UpdateBox(objects[i], modelBox, boxes[i]);
+				}
+				BVH::Build(boxes, settings, nodes, order);
+			});
+
+			const double refitMs = MeasureMs([&]() {
+				SceneObject& moved = objects[count / 2];
+				moved.worldRow._41 += 0.01f;
+				moved.worldToModel = moved.worldRow.Invert();
+				UpdateBox(moved, modelBox, boxes[count / 2]);
+				BVH::Refit(boxes, order, nodes);
+			});
+
+			const int rayCount = 1000;
+			const float extent = float(side) * 3.0f;
+			vector<Vector3> origins(rayCount), dirs(rayCount);
+			for (int r = 0; r < rayCount; r++)
+			{
+				origins[r] = Vector3(extent * 0.5f * (1.0f + unit(random)), extent * 0.5f * (1.0f + unit(random)), -10.0f);
+				dirs[r] = Vector3(unit(random) * 0.2f, unit(random) * 0.2f, 1.0f);
+			}
+
+			int hitCount = 0;
+			int mismatch = 0;
+			const double pickMs = MeasureMs([&]() {
+				hitCount = 0;
+				for (int r = 0; r < rayCount; r++)
+				{
+					RayHit hit;
+					hitCount += PickScene(objects, mesh, nodes, order, origins[r], dirs[r], hit);
+				}
+			});
+
+			// 비교용: 모든 Model을 하나씩 (10개 Ray만)
+			const double allMs = MeasureMs(
+				[&]() {
+					for (int r = 0; r < rayCount; r += 100)
+					{
+						RayHit expected;
+						for (int i = 0; i < count; i++)
+						{
+							if (mesh.IntersectClosest(Vector3::Transform(origins[r], objects[i].worldToModel),
+													  Vector3::TransformNormal(dirs[r], objects[i].worldToModel),
+													  expected))
+							{
+								expected.object = uint32_t(i);
+							}
+						}
+						RayHit hit;
+						PickScene(objects, mesh, nodes, order, origins[r], dirs[r], hit);
+						mismatch += hit.object != expected.object || hit.distance != expected.distance;
+					}
+				},
+				1);
+			CHECK(mismatch == 0);
+
+			cout << count << " objects: Build " << buildMs << " ms, Refit (one moved) " << refitMs
+				 << " ms, Pick " << pickMs * 1000.0 / rayCount << " us/ray (" << hitCount << " hits), all models "
+				 << allMs * 1000.0 / (rayCount / 100) << " us/ray" << endl;
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	TestMeshBVH();
+	TestRefit();
+	TestSceneBVH();
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark();
+	}
+
+	return ReportChecks("TestBVH");
+}
@@ -0,0 +1,333 @@
+// BoundsCalculator의 AABB, 경계 구(Ritter), OBB(PCA)가 모든 Vertex를 포함하는지
+// 기울어진 점 구름, 점 하나, 같은 점 반복, 한 직선 위, 한 평면 위, 빈 Mesh, 블록 병렬(16384개 이상), Merge와 Transform
+// 사용법: TestBoundsCalculator [--bench]
+
+#include "BoundsCalculator.h"
+#include "TestCommon.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	// 좌표 크기에 비례한 허용 오차 (SSE 합과 Quaternion 변환의 반올림)
+	float GetTolerance(const vector<Vertex>& vertices)
+	{
+		float maxCoordinate = 0.0f;
+		for (const Vertex& v : vertices)
+		{
+			maxCoordinate = max({ maxCoordinate, abs(v.position.x), abs(v.position.y), abs(v.position.z) });
+		}
+		return 1e-5f * (1.0f + maxCoordinate);
+	}
+
+	// q의 역회전 (q는 단위 Quaternion)
+	Vector3 InverseRotate(const XMFLOAT4& q, const Vector3& v)
+	{
+		const Vector3 u(-q.x, -q.y, -q.z);
+		const float s = q.w;
+		return u * (2.0f * u.Dot(v)) + v * (s * s - u.Dot(u)) + u.Cross(v) * (2.0f * s);
+	}
+
+	bool IsFinite(const MeshBounds& bounds)
+	{
+		const float values[] = { bounds.sphere.Radius,
+								 bounds.orientedBox.Center.x, bounds.orientedBox.Center.y, bounds.orientedBox.Center.z,
+								 bounds.orientedBox.Extents.x, bounds.orientedBox.Extents.y, bounds.orientedBox.Extents.z,
+								 bounds.orientedBox.Orientation.x, bounds.orientedBox.Orientation.y,
+								 bounds.orientedBox.Orientation.z, bounds.orientedBox.Orientation.w };
+		for (const float value : values)
+		{
+			if (!isfinite(value))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// 세 경계가 모든 점을 포함하고, AABB는 딱 맞고, OBB는 AABB보다 크지 않은지
+	bool ContainsAll(const MeshBounds& bounds, const vector<Vertex>& vertices, const float tolerance)
+	{
+		if (!bounds.isValid || !IsFinite(bounds))
+		{
+			return false;
+		}
+
+		Vector3 vmin(FLT_MAX), vmax(-FLT_MAX);
+		for (const Vertex& v : vertices)
+		{
+			vmin = Vector3::Min(vmin, v.position);
+			vmax = Vector3::Max(vmax, v.position);
+		}
+		const Vector3 boxCenter = bounds.box.Center;
+		const Vector3 boxExtents = bounds.box.Extents;
+		if ((boxCenter - boxExtents - vmin).Length() > tolerance || (boxCenter + boxExtents - vmax).Length() > tolerance)
+		{
+			return false;
+		}
+
+		const Vector3 sphereCenter = bounds.sphere.Center;
+		const BoundingOrientedBox& obb = bounds.orientedBox;
+		const Vector3 obbCenter = obb.Center;
+		const Vector3 obbExtents = obb.Extents;
+		const XMFLOAT4& q = obb.Orientation;
+		if (abs(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w - 1.0f) > 1e-4f)
+		{
+			return false;
+		}
+
+		for (const Vertex& v : vertices)
+		{
+			if ((v.position - sphereCenter).Length() > bounds.sphere.Radius + tolerance)
+			{
+				return false;
+			}
+
+			const Vector3 local = InverseRotate(q, v.position - obbCenter);
+			if (abs(local.x) > obbExtents.x + tolerance || abs(local.y) > obbExtents.y + tolerance ||
+				abs(local.z) > obbExtents.z + tolerance)
+			{
+				return false;
+			}
+		}
+
+		const float obbVolume = obbExtents.x * obbExtents.y * obbExtents.z;
+		const float boxVolume = boxExtents.x * boxExtents.y * boxExtents.z;
+		return obbVolume <= boxVolume * (1.0f + 1e-4f) + tolerance;
+	}
+
+	// axes 방향으로 늘린 상자 안의 점 (offset만큼 원점에서 떨어짐)
+	vector<Vertex> MakeCloud(const size_t count, const Vector3 axes[3], const Vector3& offset, mt19937& random)
+	{
+		uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+		vector<Vertex> vertices(count);
+		for (Vertex& v : vertices)
+		{
+			v = {};
+			v.position = offset;
+			for (int a = 0; a < 3; a++)
+			{
+				v.position += axes[a] * distribution(random);
+			}
+		}
+		return vertices;
+	}
+
+	vector<Vertex> MakeTiltedCloud(const size_t count, mt19937& random)
+	{
+		Vector3 x(1.0f, 1.0f, 0.0f), y(-1.0f, 1.0f, 0.0f);
+		x.Normalize();
+		y.Normalize();
+		const Vector3 axes[3] = { x * 3.0f, y * 0.5f, Vector3(0.0f, 0.0f, 0.2f) };
+		return MakeCloud(count, axes, Vector3(100.0f, 50.0f, -20.0f), random);
+	}
+
+	void TestRandom()
+	{
+		mt19937 random(3);
+
+		// 4개 단위 SIMD의 남는 Lane, 블록 병렬 경계 (16384)
+		for (const size_t count : { 1, 2, 3, 4, 5, 7, 1000, 16383, 16384, 16385, 100003 })
+		{
+			const vector<Vertex> vertices = MakeTiltedCloud(count, random);
+			const float tolerance = GetTolerance(vertices);
+
+			const MeshBounds bounds = BoundsCalculator::Compute(vertices.data(), vertices.size());
+			CHECK(ContainsAll(bounds, vertices, tolerance));
+
+			// OBB를 끄면 AABB와 같음
+			const MeshBounds noObb = BoundsCalculator::Compute(vertices.data(), vertices.size(), false);
+			CHECK(ContainsAll(noObb, vertices, tolerance));
+			CHECK(Vector3(noObb.orientedBox.Extents) == Vector3(noObb.box.Extents));
+
+			if (count >= 1000)
+			{
+				// 45도 기울어진 길쭉한 상자: PCA 축이 AABB보다 훨씬 작음 (실제 부피 3 * 0.5 * 0.2)
+				const Vector3 e = bounds.orientedBox.Extents;
+				const Vector3 be = bounds.box.Extents;
+				CHECK(e.x * e.y * e.z < be.x * be.y * be.z * 0.3f);
+				CHECK(e.x * e.y * e.z < 0.3f * 1.05f);
+
+				// Ritter 구는 AABB를 감싸는 구보다 작고 가장 긴 반지름(약 3.05)보다 크게 벗어나지 않음
+				CHECK(bounds.sphere.Radius <= be.Length());
+				CHECK(bounds.sphere.Radius < 3.05f * 1.1f);
+			}
+		}
+
+		// 회전 없는 상자 구름: AABB가 이미 최소라 OBB가 커지면 안 됨
+		const Vector3 axes[3] = { Vector3(2.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f), Vector3(0.0f, 0.0f, 0.5f) };
+		const vector<Vertex> aligned = MakeCloud(5000, axes, Vector3(-3.0f, 7.0f, 1.0f), random);
+		CHECK(ContainsAll(BoundsCalculator::Compute(aligned.data(), aligned.size()), aligned, GetTolerance(aligned)));
+	}
+
+	void TestDegenerate()
+	{
+		// 빈 Mesh: 원점의 크기 0인 경계
+		const MeshBounds empty = BoundsCalculator::Compute(nullptr, 0);
+		CHECK(empty.isValid);
+		CHECK(empty.sphere.Radius == 0.0f);
+		CHECK(Vector3(empty.box.Extents) == Vector3(0.0f));
+		CHECK(Vector3(empty.orientedBox.Extents) == Vector3(0.0f));
+
+		mt19937 random(7);
+		uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+		for (const size_t count : { 1, 3, 6, 1001, 40000 })
+		{
+			// 같은 점 반복: 공분산이 0이어도 NaN이 없고 크기 0
+			vector<Vertex> same(count);
+			for (Vertex& v : same)
+			{
+				v = {};
+				v.position = Vector3(1.5f, -2.0f, 3.0f);
+			}
+			const MeshBounds point = BoundsCalculator::Compute(same.data(), same.size());
+			CHECK(ContainsAll(point, same, GetTolerance(same)));
+			CHECK(point.sphere.Radius == 0.0f);
+
+			// 한 직선 위 (축에 나란하지 않음): 구 반지름은 선분 길이의 절반
+			Vector3 direction(1.0f, 2.0f, -0.5f);
+			direction.Normalize();
+			vector<Vertex> line(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				line[i] = {};
+				line[i].position = Vector3(10.0f, 0.0f, 5.0f) + direction * (count == 1 ? 0.0f : 4.0f * float(i) / float(count - 1));
+			}
+			shuffle(line.begin(), line.end(), random);
+			const MeshBounds collinear = BoundsCalculator::Compute(line.data(), line.size());
+			CHECK(ContainsAll(collinear, line, GetTolerance(line)));
+			CHECK(abs(collinear.sphere.Radius - (count == 1 ? 0.0f : 2.0f)) < 1e-4f);
+
+			// 한 평면 위 (기울어진 평면): OBB의 한 축은 두께 0
+			Vector3 u(1.0f, 0.0f, 1.0f), w(0.0f, 1.0f, 0.0f);
+			u.Normalize();
+			vector<Vertex> plane(count);
+			for (Vertex& v : plane)
+			{
+				v = {};
+				v.position = Vector3(-4.0f, 2.0f, 0.0f) + u * (2.0f * distribution(random)) + w * distribution(random);
+			}
+			const MeshBounds coplanar = BoundsCalculator::Compute(plane.data(), plane.size());
+			CHECK(ContainsAll(coplanar, plane, GetTolerance(plane)));
+			if (count > 1000)
+			{
+				const Vector3 e = coplanar.orientedBox.Extents;
+				CHECK(min({ e.x, e.y, e.z }) < 1e-4f);
+			}
+		}
+
+		// 두 점만 아주 멀리 (나머지는 한 곳에 몰림): 처음 구가 두 점 사이
+		vector<Vertex> outliers(20000);
+		for (Vertex& v : outliers)
+		{
+			v = {};
+			v.position = Vector3(distribution(random), distribution(random), distribution(random)) * 0.01f;
+		}
+		outliers[123].position = Vector3(-1000.0f, 0.0f, 0.0f);
+		outliers[19999].position = Vector3(0.0f, 0.0f, 1000.0f);
+		CHECK(ContainsAll(BoundsCalculator::Compute(outliers.data(), outliers.size()), outliers, GetTolerance(outliers)));
+	}
+
+	void TestMergeTransform()
+	{
+		mt19937 random(11);
+		vector<MeshData> meshes(4);
+		vector<Vertex> all;
+		for (size_t m = 0; m < meshes.size(); m++)
+		{
+			meshes[m].vertices = MakeTiltedCloud(500 + m * 20000, random);
+			for (Vertex& v : meshes[m].vertices)
+			{
+				v.position += Vector3(float(m) * 10.0f, 0.0f, 0.0f);
+			}
+			all.insert(all.end(), meshes[m].vertices.begin(), meshes[m].vertices.end());
+		}
+
+		// Mesh 단위 병렬은 하나씩 계산한 것과 같음
+		BoundsCalculator::Compute(meshes);
+		vector<MeshBounds> bounds;
+		for (const MeshData& mesh : meshes)
+		{
+			CHECK(ContainsAll(mesh.bounds, mesh.vertices, GetTolerance(mesh.vertices)));
+			const MeshBounds single = BoundsCalculator::Compute(mesh.vertices.data(), mesh.vertices.size());
+			CHECK(Vector3(single.sphere.Center) == Vector3(mesh.bounds.sphere.Center));
+			CHECK(single.sphere.Radius == mesh.bounds.sphere.Radius);
+			bounds.push_back(mesh.bounds);
+		}
+
+		// 계산하지 않은 경계는 Merge에서 무시
+		bounds.push_back(MeshBounds());
+		const MeshBounds merged = BoundsCalculator::Merge(bounds);
+		CHECK(ContainsAll(merged, all, GetTolerance(all)));
+
+		// 정규화처럼 scale, translation을 적용해도 옮긴 점을 모두 포함
+		const float scale = 0.037f;
+		const Vector3 translation(-1.0f, 4.0f, 2.5f);
+		vector<Vertex> moved = all;
+		for (Vertex& v : moved)
+		{
+			v.position = v.position * scale + translation;
+		}
+		const MeshBounds transformed = BoundsCalculator::Transform(merged, scale, translation);
+		CHECK(transformed.isValid);
+		CHECK(ContainsAll(transformed, moved, GetTolerance(moved)));
+
+		const MeshBounds meshTransformed = BoundsCalculator::Transform(meshes[2].bounds, scale, translation);
+		vector<Vertex> movedMesh = meshes[2].vertices;
+		for (Vertex& v : movedMesh)
+		{
+			v.position = v.position * scale + translation;
+		}
+		CHECK(ContainsAll(meshTransformed, movedMesh, GetTolerance(movedMesh)));
+	}
+
+	void Benchmark()
+	{
+		mt19937 random(5);
+		for (const size_t count : { 10000, 1000000 })
+		{
+			const vector<Vertex> vertices = MakeTiltedCloud(count, random);
+			MeshBounds bounds;
+			const double fullMs = MeasureMs([&]() { bounds = BoundsCalculator::Compute(vertices.data(), vertices.size()); });
+			const double noObbMs = MeasureMs([&]() { BoundsCalculator::Compute(vertices.data(), vertices.size(), false); });
+
+			// 비교: AABB를 감싸는 구, DirectXMath의 CreateFromPoints
+			BoundingSphere boxSphere;
+			BoundingSphere::CreateFromBoundingBox(boxSphere, bounds.box);
+			BoundingSphere pointsSphere;
+			const double pointsMs = MeasureMs([&]() {
+				BoundingSphere::CreateFromPoints(pointsSphere, vertices.size(), &vertices[0].position, sizeof(Vertex));
+			});
+
+			const Vector3 e = bounds.orientedBox.Extents;
+			const Vector3 be = bounds.box.Extents;
+			cout << count << " vertices: " << fullMs << " ms (without OBB " << noObbMs
+				 << " ms), CreateFromPoints " << pointsMs << " ms" << endl;
+			cout << "  sphere radius " << bounds.sphere.Radius << " (AABB sphere " << boxSphere.Radius
+				 << ", CreateFromPoints " << pointsSphere.Radius << "), OBB volume " << 8.0f * e.x * e.y * e.z
+				 << " (AABB " << 8.0f * be.x * be.y * be.z << ")" << endl;
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	TestRandom();
+	TestDegenerate();
+	TestMergeTransform();
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark();
+	}
+
+	return ReportChecks("TestBoundsCalculator");
+}
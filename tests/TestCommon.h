@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+// tests/의 실행 파일들이 같이 쓰는 검사와 시간 측정 (빌드 방법은 README.md)
+// 검사는 항상 실행하고, --bench를 붙이면 Benchmark도 실행
+// 실패한 CHECK가 있으면 main()이 1을 반환
+
+inline int g_checkFailures = 0;
+
+#define CHECK(condition)                                                                                 \
+	do                                                                                                   \
+	{                                                                                                    \
+		if (!(condition))                                                                                \
+		{                                                                                                \
+			std::cout << __FILE__ << "(" << __LINE__ << "): CHECK(" #condition ") failed" << std::endl; \
+			g_checkFailures++;                                                                           \
+		}                                                                                                \
+	} while (0)
+
+inline bool HasArgument(int argc, char *argv[], const char *argument)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], argument) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// 검사 결과를 출력하고 main()의 반환값으로 사용
+inline int ReportChecks(const char *testName)
+{
+	if (g_checkFailures > 0)
+	{
+		std::cout << testName << ": " << g_checkFailures << " checks failed" << std::endl;
+		return 1;
+	}
+
+	std::cout << testName << ": all checks passed" << std::endl;
+	return 0;
+}
+
+// func를 repeat번 실행해서 가장 빠른 시간 (ms)
+template <typename Func>
+double MeasureMs(Func &&func, const int repeat = 5)
+{
+	double best = 1e30;
+	for (int i = 0; i < repeat; i++)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		func();
+		const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		best = std::min(best, elapsed.count());
+	}
+	return best;
+}
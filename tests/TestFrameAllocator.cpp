@@ -0,0 +1,451 @@
+// FrameAllocator와 ArrayView 검사, Render Loop를 흉내 낸 Frame들이 처음 몇 Frame 뒤에는 Heap 할당이 없는지
+// 전역 operator new를 바꿔서 할당 횟수를 셈 (Frame: Reset, 임시 배열, Culling, BVH Refit, RenderQueue, StateCache)
+// Frame의 FrustumCuller는 ThreadPool 없이 (parallelThreshold = SIZE_MAX)
+// Box가 parallelThreshold 이상이면 ThreadPool::ParallelFor가 호출마다 SharedState와 Worker마다 std::function을
+// 할당하므로 0이 아님: 따로 결과가 같은지와 Cull 한 번의 할당이 Box 수와 관계없이 Worker 수만큼인지만 검사
+// 사용법: TestFrameAllocator [--bench]
+
+#include "ArrayView.h"
+#include "BVH.h"
+#include "FrameAllocator.h"
+#include "FrustumCuller.h"
+#include "MockDeviceContext.h"
+#include "RenderQueue.h"
+#include "StateCache.h"
+#include "TestCommon.h"
+#include "ThreadPool.h"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	atomic<size_t> g_allocCount{ 0 };
+}
+
+void* operator new(size_t size)
+{
+	g_allocCount++;
+	void* p = malloc(size ? size : 1);
+	if (!p)
+	{
+		throw bad_alloc();
+	}
+	return p;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+namespace {
+	using Cache = StateCache<MockDeviceContext>;
+
+	bool IsAligned(const void* p, const size_t alignment) { return (uintptr_t(p) & (alignment - 1)) == 0; }
+
+	size_t Sum(ArrayView<const int> values)
+	{
+		size_t sum = 0;
+		for (const int value : values)
+		{
+			sum += value;
+		}
+		return sum;
+	}
+
+	void TestArrayView()
+	{
+		vector<int> values = { 1, 2, 3 };
+		const vector<int>& constValues = values;
+		int array[2] = { 4, 5 };
+		std::array<int, 2> stdArray = { 6, 7 };
+
+		const size_t before = g_allocCount;
+		CHECK(Sum(values) == 6 && Sum(constValues) == 6);
+		CHECK(Sum(array) == 9 && Sum(stdArray) == 13);
+		CHECK(Sum({ 8, 9, 10 }) == 27); // 임시 vector를 만들지 않음
+		CHECK(Sum({}) == 0);
+
+		ArrayView<int> view(values);
+		view[0] = 11;
+		const ArrayView<const int> constView(view);
+		CHECK(values[0] == 11 && constView.size() == 3 && constView.data() == values.data());
+		CHECK(ArrayView<int>().empty() && ArrayView<int>().begin() == ArrayView<int>().end());
+		CHECK(g_allocCount == before);
+	}
+
+	void TestAllocate()
+	{
+		FrameAllocator allocator(1024);
+		CHECK(allocator.GetCapacity() == 0 && allocator.GetBlockAllocCount() == 0);
+
+		// 홀수 크기 뒤에도 요청한 정렬
+		for (const size_t alignment : { 1, 2, 4, 8, 16, 64, 256 })
+		{
+			allocator.Allocate(3);
+			CHECK(IsAligned(allocator.Allocate(5, alignment), alignment));
+		}
+		CHECK(IsAligned(allocator.AllocateArray<double>(3).data(), alignof(double)));
+		CHECK(allocator.GetBlockAllocCount() == 1 && allocator.GetCapacity() == 1024);
+		CHECK(allocator.GetUsedSize() <= 1024 && allocator.GetUsedSize() >= 7 * 8 + 24);
+
+		// 서로 겹치지 않음
+		ArrayView<uint32_t> a = allocator.AllocateArray<uint32_t>(50);
+		ArrayView<uint16_t> b = allocator.AllocateArray<uint16_t>(33);
+		ArrayView<uint64_t> c = allocator.AllocateArray<uint64_t>(20);
+		for (uint32_t i = 0; i < a.size(); i++)
+		{
+			a[i] = 0xA0000000 + i;
+		}
+		for (uint32_t i = 0; i < b.size(); i++)
+		{
+			b[i] = uint16_t(0xB000 + i);
+		}
+		for (uint32_t i = 0; i < c.size(); i++)
+		{
+			c[i] = 0xC000000000000000ull + i;
+		}
+		bool intact = true;
+		for (uint32_t i = 0; i < a.size(); i++)
+		{
+			intact &= a[i] == 0xA0000000 + i;
+		}
+		for (uint32_t i = 0; i < b.size(); i++)
+		{
+			intact &= b[i] == uint16_t(0xB000 + i);
+		}
+		CHECK(intact);
+
+		// Block이 모자라면 새 Block (요청이 크면 그 크기), Reset()에서 합친 크기 하나로
+		const size_t blockCount = allocator.GetBlockAllocCount();
+		allocator.AllocateArray<uint8_t>(3000);
+		allocator.AllocateArray<uint8_t>(100);
+		CHECK(allocator.GetBlockAllocCount() == blockCount + 2);
+		const size_t capacity = allocator.GetCapacity();
+		const size_t peak = allocator.GetPeakSize();
+		CHECK(capacity >= 1024 + 3000 + 1024 && peak == allocator.GetUsedSize());
+
+		allocator.Reset();
+		CHECK(allocator.GetUsedSize() == 0 && allocator.GetPeakSize() == peak);
+		CHECK(allocator.GetCapacity() == capacity && allocator.GetBlockAllocCount() == blockCount + 3);
+
+		// 같은 만큼 다시 써도 할당 없음 (Peak은 이전보다 작거나 같음)
+		const size_t before = g_allocCount;
+		for (int frame = 0; frame < 3; frame++)
+		{
+			allocator.Reset();
+			allocator.AllocateArray<uint8_t>(3000);
+			allocator.AllocateArray<uint8_t>(100);
+			CHECK(IsAligned(allocator.AllocateArray<uint64_t>(10).data(), 8));
+		}
+		CHECK(g_allocCount == before && allocator.GetBlockAllocCount() == blockCount + 3);
+		CHECK(allocator.GetPeakSize() == peak);
+
+		// 크기 0도 유효한 Pointer
+		CHECK(allocator.AllocateArray<int>(0).data() != nullptr && allocator.AllocateArray<int>(0).empty());
+	}
+
+	// Render Loop의 한 Frame: Model 목록은 FrameAllocator, 나머지는 Capacity를 유지하는 Member
+	class FrameSimulation {
+	public:
+		explicit FrameSimulation(const size_t maxModels)
+		{
+			m_boxes.resize(maxModels);
+			mt19937 random(1);
+			uniform_real_distribution<float> position(-50.0f, 50.0f);
+			for (BVHBox& box : m_boxes)
+			{
+				const XMFLOAT3 center(position(random), position(random) * 0.2f, position(random));
+				box.boxMin = XMFLOAT3(center.x - 1.0f, center.y - 1.0f, center.z - 1.0f);
+				box.boxMax = XMFLOAT3(center.x + 1.0f, center.y + 1.0f, center.z + 1.0f);
+			}
+			BVH::Build(m_boxes, BVH::Settings(), m_nodes, m_order);
+
+			m_culler.AddView(Matrix(XMMatrixLookAtLH(Vector3(0.0f, 5.0f, -60.0f), Vector3(0.0f, 0.0f, 0.0f),
+													 Vector3(0.0f, 1.0f, 0.0f))) *
+							 Matrix(XMMatrixPerspectiveFovLH(XMConvertToRadians(70.0f), 16.0f / 9.0f, 0.1f, 200.0f)));
+			m_culler.parallelThreshold = SIZE_MAX;
+
+			m_cache.SetContext(&m_context);
+			m_context.m_calls.reserve(maxModels * 8);
+		}
+
+		// 반환값: 그린 수
+		size_t Render(const size_t modelCount, mt19937& random)
+		{
+			m_allocator.Reset();
+			m_queue.Clear();
+			m_culler.ClearBoxes();
+			m_context.ClearCalls();
+			m_cache.InvalidateResources();
+
+			// PickModel()처럼 이번 Frame의 Model 목록
+			ArrayView<uint32_t> models = m_allocator.AllocateArray<uint32_t>(modelCount);
+			for (uint32_t i = 0; i < modelCount; i++)
+			{
+				models[i] = uint32_t((i * 7919) % m_boxes.size());
+			}
+
+			// Model 하나가 움직임
+			BVHBox& moved = m_boxes[random() % m_boxes.size()];
+			moved.boxMin.y += 0.01f;
+			moved.boxMax.y += 0.01f;
+			BVH::Refit(m_boxes, m_order, m_nodes);
+			float maxDistance = FLT_MAX;
+			size_t leafCount = 0;
+			BVH::Traverse(m_nodes, BVHRay(XMFLOAT3(0.0f, 0.0f, -100.0f), XMFLOAT3(0.1f, 0.0f, 1.0f)), maxDistance,
+						  [&](const BVHNode&, float&) {
+							  leafCount++;
+							  return false;
+						  });
+
+			for (const uint32_t model : models)
+			{
+				const BVHBox& box = m_boxes[model];
+				BoundingBox worldBox;
+				BoundingBox::CreateFromPoints(worldBox, XMLoadFloat3(&box.boxMin), XMLoadFloat3(&box.boxMax));
+				m_culler.AddBox(worldBox);
+			}
+			m_culler.Cull();
+
+			for (uint32_t i = 0; i < modelCount; i++)
+			{
+				if (m_culler.IsVisible(0, i))
+				{
+					m_queue.Add(RenderQueue::MakeKey(i % 3, models[i] % 40, models[i] % 100, float(i)), i);
+				}
+			}
+			m_queue.Sort();
+
+			// SetMeshResources()처럼 Stack 배열과 { } 목록으로 설정
+			for (const RenderQueue::Packet& packet : m_queue.GetPackets())
+			{
+				ID3D11ShaderResourceView* views[4] = { reinterpret_cast<ID3D11ShaderResourceView*>(
+														   uintptr_t(16 + 16 * ((packet.key >> 40) % 8))),
+													   nullptr, nullptr, nullptr };
+				m_cache.PSSetShaderResources(0, 4, views);
+				SetConstants({ reinterpret_cast<ID3D11Buffer*>(uintptr_t(16 + 16 * packet.item)), nullptr });
+				m_cache.DrawIndexed(36, 0, 0);
+			}
+			return m_context.m_drawCount;
+		}
+
+		const FrameAllocator& GetAllocator() const { return m_allocator; }
+
+	private:
+		void SetConstants(ArrayView<ID3D11Buffer* const> buffers)
+		{
+			m_cache.VSSetConstantBuffers(0, UINT(buffers.size()), buffers.data());
+		}
+
+		FrameAllocator m_allocator{ 1024 };
+		vector<BVHBox> m_boxes;
+		vector<BVHNode> m_nodes;
+		vector<uint32_t> m_order;
+		FrustumCuller m_culler;
+		RenderQueue m_queue;
+		MockDeviceContext m_context;
+		Cache m_cache;
+	};
+
+	void TestFrames(const bool isBench)
+	{
+		const size_t maxModels = 3000;
+		FrameSimulation simulation(maxModels);
+		mt19937 random(2);
+
+		// 처음 Frame에 가장 많은 Model (Scene을 불러온 직후), 이후에는 그보다 적은 수
+		size_t warmUpAllocs = 0;
+		for (int frame = 0; frame < 3; frame++)
+		{
+			const size_t before = g_allocCount;
+			simulation.Render(maxModels, random);
+			warmUpAllocs += g_allocCount - before;
+		}
+		CHECK(warmUpAllocs > 0);
+
+		size_t steadyAllocs = 0;
+		size_t draws = 0;
+		for (int frame = 0; frame < 200; frame++)
+		{
+			const size_t before = g_allocCount;
+			draws += simulation.Render(100 + random() % (maxModels - 100), random);
+			steadyAllocs += g_allocCount - before;
+		}
+		CHECK(steadyAllocs == 0);
+		CHECK(draws > 0);
+		CHECK(simulation.GetAllocator().GetCapacity() >= maxModels * sizeof(uint32_t));
+
+		// 전보다 많이 쓰는 Frame은 다시 할당하고 그 다음부터는 다시 0
+		const size_t blockCount = simulation.GetAllocator().GetBlockAllocCount();
+		FrameAllocator allocator(1024);
+		allocator.AllocateArray<uint8_t>(1000);
+		allocator.Reset();
+		size_t before = g_allocCount;
+		allocator.AllocateArray<uint8_t>(5000);
+		allocator.Reset();
+		CHECK(g_allocCount - before == 2); // 모자라서 한 번, 합치면서 한 번
+		before = g_allocCount;
+		allocator.AllocateArray<uint8_t>(5000);
+		allocator.Reset();
+		CHECK(g_allocCount == before);
+		CHECK(simulation.GetAllocator().GetBlockAllocCount() == blockCount);
+
+		if (isBench)
+		{
+			cout << "heap allocations: first 3 frames " << warmUpAllocs << ", next 200 frames " << steadyAllocs
+				 << " (peak " << simulation.GetAllocator().GetPeakSize() << " B, "
+				 << simulation.GetAllocator().GetBlockAllocCount() << " blocks)" << endl;
+		}
+	}
+
+	// parallelThreshold 이상: ParallelFor로 나눈 결과가 한 Thread와 같고, 할당은 Cull마다 Worker 수 정도
+	void TestParallelCull(const bool isBench)
+	{
+		const Matrix viewProj =
+			Matrix(XMMatrixLookAtLH(Vector3(0.0f, 5.0f, -60.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f))) *
+			Matrix(XMMatrixPerspectiveFovLH(XMConvertToRadians(70.0f), 16.0f / 9.0f, 0.1f, 200.0f));
+		FrustumCuller parallel, single;
+		parallel.AddView(viewProj);
+		single.AddView(viewProj);
+		single.parallelThreshold = SIZE_MAX;
+
+		mt19937 random(4);
+		uniform_real_distribution<float> position(-100.0f, 100.0f);
+		const size_t threadCount = ThreadPool::GetInstance().GetThreadCount();
+		size_t maxAllocs = 0;
+		int mismatch = 0;
+		for (int frame = 0; frame < 23; frame++)
+		{
+			// 처음 3 Frame에 가장 많은 Box (결과 Bit 배열을 키움), 이후 Box 수가 달라도 (Task 수만 다름) 할당 수는 같음
+			const size_t boxCount = parallel.parallelThreshold + (frame < 3 ? 40000 : random() % 40000);
+			parallel.ClearBoxes();
+			single.ClearBoxes();
+			for (size_t i = 0; i < boxCount; i++)
+			{
+				const BoundingBox box(XMFLOAT3(position(random), position(random) * 0.2f, position(random)),
+									  XMFLOAT3(1.0f, 1.0f, 1.0f));
+				parallel.AddBox(box);
+				single.AddBox(box);
+			}
+
+			const size_t before = g_allocCount;
+			parallel.Cull();
+			const size_t allocs = g_allocCount - before;
+			single.Cull();
+
+			if (frame >= 3)
+			{
+				maxAllocs = max(maxAllocs, allocs);
+			}
+			for (size_t i = 0; i < boxCount; i++)
+			{
+				mismatch += parallel.IsVisible(0, uint32_t(i)) != single.IsVisible(0, uint32_t(i));
+			}
+		}
+		CHECK(mismatch == 0);
+		CHECK(parallel.GetVisibleCount(0) == single.GetVisibleCount(0));
+		CHECK(single.GetVisibleCount(0) > 0 && single.GetVisibleCount(0) < single.GetBoxCount());
+
+		// SharedState 하나, Worker마다 std::function 하나, 가끔 std::queue의 Block
+		CHECK(maxAllocs <= 2 + 2 * threadCount);
+
+		if (isBench)
+		{
+			cout << "parallel Cull (" << threadCount << " workers): up to " << maxAllocs
+				 << " heap allocations per call, not covered by the zero-allocation frames above" << endl;
+		}
+	}
+
+	void Benchmark()
+	{
+		const size_t frameCount = 1000, drawCount = 3000;
+		mt19937 random(3);
+		vector<size_t> counts(frameCount);
+		for (size_t& count : counts)
+		{
+			count = 100 + random() % drawCount;
+		}
+
+		// Frame마다 임시 배열: vector를 새로 만드는 것과 FrameAllocator
+		size_t sink = 0;
+		size_t before = g_allocCount;
+		const double vectorMs = MeasureMs([&]() {
+			for (const size_t count : counts)
+			{
+				vector<const void*> models(count);
+				sink += size_t(models.data()[count / 2]);
+			}
+		});
+		const size_t vectorAllocs = (g_allocCount - before) / 5;
+
+		FrameAllocator allocator;
+		before = g_allocCount;
+		const double allocatorMs = MeasureMs([&]() {
+			for (const size_t count : counts)
+			{
+				allocator.Reset();
+				ArrayView<const void*> models = allocator.AllocateArray<const void*>(count);
+				fill(models.begin(), models.end(), nullptr);
+				sink += size_t(models[count / 2]);
+			}
+		});
+		const size_t allocatorAllocs = (g_allocCount - before) / 5;
+		CHECK(sink == 0);
+		cout << frameCount << " frames of temporary arrays: vector " << vectorMs << " ms (" << vectorAllocs
+			 << " allocations), FrameAllocator " << allocatorMs << " ms (" << allocatorAllocs << " allocations)"
+			 << endl;
+
+		// Draw마다 SRV 목록: vector와 Stack 배열
+		MockDeviceContext context;
+		context.m_calls.reserve(drawCount);
+		before = g_allocCount;
+		const double perDrawVectorMs = MeasureMs([&]() {
+			for (size_t i = 0; i < drawCount; i++)
+			{
+				vector<ID3D11ShaderResourceView*> views = { nullptr, nullptr, nullptr, nullptr };
+				context.PSSetShaderResources(0, UINT(views.size()), views.data());
+			}
+			context.ClearCalls();
+		});
+		const size_t perDrawVectorAllocs = (g_allocCount - before) / 5;
+
+		before = g_allocCount;
+		const double stackMs = MeasureMs([&]() {
+			for (size_t i = 0; i < drawCount; i++)
+			{
+				ID3D11ShaderResourceView* views[4] = {};
+				context.PSSetShaderResources(0, 4, views);
+			}
+			context.ClearCalls();
+		});
+		const size_t stackAllocs = (g_allocCount - before) / 5;
+		cout << drawCount << " draws of 4 SRVs: vector " << perDrawVectorMs << " ms (" << perDrawVectorAllocs
+			 << " allocations), stack array " << stackMs << " ms (" << stackAllocs << " allocations)" << endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	TestArrayView();
+	TestAllocate();
+	const bool isBench = HasArgument(argc, argv, "--bench");
+	TestFrames(isBench);
+	TestParallelCull(isBench);
+
+	if (isBench)
+	{
+		Benchmark();
+	}
+
+	return ReportChecks("TestFrameAllocator");
+}
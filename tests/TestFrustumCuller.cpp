@@ -0,0 +1,242 @@
+// FrustumCuller의 한 번에 여러 View 검사(Cull)가 View별 Scalar 검사(CullScalar)와 같은 Bit인지
+// SIMD 수준은 PixelConverter::SetSimdLevel()로 바꿔가며 이 CPU가 지원하는 것만
+// 사용법: TestFrustumCuller [--bench]
+
+#include "FrustumCuller.h"
+#include "PixelConverter.h"
+#include "TestCommon.h"
+
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+using SimdLevel = PixelConverter::SimdLevel;
+
+namespace {
+	const char* levelNames[] = { "Scalar", "SSE4.1", "AVX2" };
+
+	// Word 경계와 SIMD 폭(4, 8)의 배수가 아닌 개수 (마지막 Word의 남는 bit, 0으로 채운 Box)
+	const size_t testCounts[] = { 1, 3, 7, 8, 9, 63, 64, 65, 127, 1000, 4097 };
+
+	Matrix MakeViewProj(const Vector3& eye, const Vector3& at, const Vector3& up, const float fovY,
+						const float aspect, const float nearZ, const float farZ)
+	{
+		return Matrix(XMMatrixLookAtLH(eye, at, up)) *
+			   Matrix(XMMatrixPerspectiveFovLH(XMConvertToRadians(fovY), aspect, nearZ, farZ));
+	}
+
+	// Main Camera, 거울 반사, Shadow Light 3개 (ExampleApp과 비슷한 구성)
+	vector<Matrix> MakeViews()
+	{
+		vector<Matrix> views;
+		const Matrix main = MakeViewProj(Vector3(0.0f, 5.0f, -20.0f), Vector3(0.0f, 0.0f, 10.0f),
+										 Vector3(0.0f, 1.0f, 0.0f), 70.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+		views.push_back(main);
+
+		Matrix reflection = Matrix::CreateScale(Vector3(1.0f, -1.0f, 1.0f)); // y = -0.5 평면
+		reflection._42 = -1.0f;
+		views.push_back(reflection * main);
+
+		for (const float x : { -10.0f, 0.0f, 15.0f })
+		{
+			views.push_back(MakeViewProj(Vector3(x, 10.0f, x * 0.5f), Vector3(0.0f, 0.0f, 0.0f),
+										 Vector3(0.0f, 0.0f, 1.0f), 120.0f, 1.0f, 0.1f, 60.0f));
+		}
+		return views;
+	}
+
+	// 가끔 경계가 없는 Box (항상 보임)
+	void AddRandomBoxes(FrustumCuller& culler, const size_t count, mt19937& random)
+	{
+		uniform_real_distribution<float> position(-100.0f, 100.0f);
+		uniform_real_distribution<float> extent(0.1f, 3.0f);
+		for (size_t i = 0; i < count; i++)
+		{
+			if (i % 17 == 5)
+			{
+				culler.AddBox(MeshBounds(), Matrix());
+				continue;
+			}
+			culler.AddBox(BoundingBox(XMFLOAT3(position(random), position(random) * 0.2f, position(random)),
+									  XMFLOAT3(extent(random), extent(random), extent(random))));
+		}
+	}
+
+	// 모든 View의 Bitset (마지막 Word의 남는 bit 포함)
+	vector<uint64_t> GetWords(const FrustumCuller& culler)
+	{
+		const size_t wordCount = (culler.GetBoxCount() + 63) / 64;
+		vector<uint64_t> words;
+		for (uint32_t v = 0; v < culler.GetViewCount(); v++)
+		{
+			const CullVisibility visibility = culler.GetVisibility(v);
+			if (visibility.bits)
+			{
+				words.insert(words.end(), visibility.bits, visibility.bits + wordCount);
+			}
+		}
+		return words;
+	}
+
+	void TestSimple()
+	{
+		// 원점에서 +z를 보는 Camera (90도, Far 100)
+		FrustumCuller culler;
+		const uint32_t view = culler.AddView(MakeViewProj(Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 1.0f),
+														  Vector3(0.0f, 1.0f, 0.0f), 90.0f, 1.0f, 0.1f, 100.0f));
+		const XMFLOAT3 one(1.0f, 1.0f, 1.0f);
+		const uint32_t inside = culler.AddBox(BoundingBox(XMFLOAT3(0.0f, 0.0f, 10.0f), one));
+		const uint32_t behind = culler.AddBox(BoundingBox(XMFLOAT3(0.0f, 0.0f, -10.0f), one));
+		const uint32_t beyondFar = culler.AddBox(BoundingBox(XMFLOAT3(0.0f, 0.0f, 150.0f), one));
+		const uint32_t onFar = culler.AddBox(BoundingBox(XMFLOAT3(0.0f, 0.0f, 99.5f), one));
+		const uint32_t right = culler.AddBox(BoundingBox(XMFLOAT3(20.0f, 0.0f, 10.0f), one));
+		const uint32_t onRight = culler.AddBox(BoundingBox(XMFLOAT3(10.5f, 0.0f, 10.0f), one));
+		const uint32_t unbounded = culler.AddBox(MeshBounds(), Matrix::CreateTranslation(Vector3(0.0f, 0.0f, -50.0f)));
+
+		// Model Space Box를 World로 옮긴 것 (Camera 뒤)
+		MeshBounds bounds;
+		bounds.isValid = true;
+		bounds.box = BoundingBox(XMFLOAT3(0.0f, 0.0f, 0.0f), one);
+		const uint32_t moved = culler.AddBox(bounds, Matrix::CreateTranslation(Vector3(0.0f, 0.0f, -10.0f)));
+		const uint32_t scaled = culler.AddBox(bounds, Matrix::CreateScale(30.0f) *
+														  Matrix::CreateTranslation(Vector3(0.0f, 0.0f, -10.0f)));
+
+		for (int pass = 0; pass < 2; pass++)
+		{
+			if (pass == 0)
+			{
+				culler.Cull();
+			}
+			else
+			{
+				culler.CullScalar();
+			}
+			CHECK(culler.IsVisible(view, inside));
+			CHECK(!culler.IsVisible(view, behind));
+			CHECK(!culler.IsVisible(view, beyondFar));
+			CHECK(culler.IsVisible(view, onFar));
+			CHECK(!culler.IsVisible(view, right));
+			CHECK(culler.IsVisible(view, onRight));
+			CHECK(culler.IsVisible(view, unbounded));
+			CHECK(!culler.IsVisible(view, moved));
+			CHECK(culler.IsVisible(view, scaled)); // 커져서 Near에 걸침
+			CHECK(culler.GetVisibleCount(view) == 5);
+		}
+
+		// Cull() 뒤에 넣은 Box와 없는 View는 보이는 것으로
+		CHECK(culler.IsVisible(view, 1000));
+		CHECK(culler.IsVisible(5, behind));
+
+		for (uint32_t i = 1; i < FrustumCuller::MAX_VIEWS; i++)
+		{
+			culler.AddView(Matrix());
+		}
+		CHECK(culler.AddView(Matrix()) == UINT32_MAX);
+		CHECK(culler.GetViewCount() == FrustumCuller::MAX_VIEWS);
+	}
+
+	void TestLevel(const SimdLevel level)
+	{
+		const vector<Matrix> views = MakeViews();
+		mt19937 random(1);
+
+		for (const size_t count : testCounts)
+		{
+			FrustumCuller culler;
+			for (const Matrix& view : views)
+			{
+				culler.AddView(view);
+			}
+			AddRandomBoxes(culler, count, random);
+
+			culler.CullScalar();
+			const vector<uint64_t> expected = GetWords(culler);
+			CHECK(expected.size() == views.size() * ((count + 63) / 64));
+
+			PixelConverter::SetSimdLevel(level);
+			culler.Cull();
+			CHECK(GetWords(culler) == expected);
+		}
+
+		// ThreadPool로 나눠도 같은 결과 (Task 경계와 맞지 않는 개수)
+		FrustumCuller culler;
+		for (const Matrix& view : views)
+		{
+			culler.AddView(view);
+		}
+		AddRandomBoxes(culler, 70001, random);
+		culler.parallelThreshold = 1000;
+
+		culler.CullScalar();
+		const vector<uint64_t> expected = GetWords(culler);
+		PixelConverter::SetSimdLevel(level);
+		culler.Cull();
+		CHECK(GetWords(culler) == expected);
+
+		// 다시 Cull해도 이전 결과가 남지 않음
+		culler.ClearBoxes();
+		AddRandomBoxes(culler, 100, random);
+		culler.Cull();
+		CHECK(GetWords(culler).size() == views.size() * 2);
+	}
+
+	void Benchmark(const vector<SimdLevel>& levels)
+	{
+		const vector<Matrix> views = MakeViews();
+		mt19937 random(2);
+
+		for (const size_t count : { size_t(10000), size_t(100000), size_t(1000000) })
+		{
+			FrustumCuller culler;
+			for (const Matrix& view : views)
+			{
+				culler.AddView(view);
+			}
+			AddRandomBoxes(culler, count, random);
+
+			cout << count << " boxes x " << views.size() << " views: CullScalar "
+				 << MeasureMs([&]() { culler.CullScalar(); }) << " ms";
+
+			culler.parallelThreshold = SIZE_MAX;
+			for (const SimdLevel level : levels)
+			{
+				PixelConverter::SetSimdLevel(level);
+				cout << ", " << levelNames[int(level)] << " " << MeasureMs([&]() { culler.Cull(); }) << " ms";
+			}
+
+			culler.parallelThreshold = FrustumCuller().parallelThreshold;
+			cout << ", " << levelNames[int(levels.back())] << " + threads " << MeasureMs([&]() { culler.Cull(); })
+				 << " ms (visible " << culler.GetVisibleCount(0) << ")" << endl;
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	TestSimple();
+
+	vector<SimdLevel> levels;
+	for (const SimdLevel level : { SimdLevel::Scalar, SimdLevel::SSE41, SimdLevel::AVX2 })
+	{
+		PixelConverter::SetSimdLevel(level);
+		if (PixelConverter::GetSimdLevel() == level)
+		{
+			levels.push_back(level);
+			TestLevel(level);
+		}
+		else
+		{
+			cout << levelNames[int(level)] << " is not supported, skipped" << endl;
+		}
+	}
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark(levels);
+	}
+
+	return ReportChecks("TestFrustumCuller");
+}
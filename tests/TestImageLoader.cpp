@@ -0,0 +1,224 @@
+// MappedFile과 ImageLoader의 CPU 쪽 (매핑한 파일에서 Decoding, Mesh Texture를 병렬로 읽고 공유)
+// 사용법: TestImageLoader [--bench]
+
+#include "ImageLoader.h"
+#include "MappedFile.h"
+#include "TestCommon.h"
+#include "ThreadPool.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "stb_image.h"
+
+using namespace std;
+
+namespace {
+	// stb_image가 읽을 수 있는 가장 단순한 형식 (Binary PPM, RGB 8-bit)
+	void WritePPM(const string& fileName, const int width, const int height, const uint8_t seed)
+	{
+		ofstream file(fileName, ios::binary);
+		file << "P6\n" << width << " " << height << "\n255\n";
+
+		vector<uint8_t> pixels(size_t(width) * height * 3);
+		for (size_t i = 0; i < pixels.size(); i++)
+		{
+			pixels[i] = uint8_t(i * 7 + seed);
+		}
+		file.write((const char*)pixels.data(), pixels.size());
+	}
+
+	void TestMappedFile(const string& dir)
+	{
+		const string fileName = dir + "/bytes.bin";
+		vector<uint8_t> bytes(100000);
+		for (size_t i = 0; i < bytes.size(); i++)
+		{
+			bytes[i] = uint8_t(i * 31);
+		}
+		ofstream(fileName, ios::binary).write((const char*)bytes.data(), bytes.size());
+
+		MappedFile file;
+		CHECK(file.Open(fileName));
+		CHECK(file.IsOpen());
+		CHECK(file.GetSize() == bytes.size());
+		CHECK(file.GetData() && memcmp(file.GetData(), bytes.data(), bytes.size()) == 0);
+
+		// 다시 Open하면 이전 것을 닫고 새로 매핑
+		CHECK(file.Open(fileName));
+		CHECK(file.GetSize() == bytes.size());
+
+		file.Close();
+		CHECK(!file.IsOpen());
+		CHECK(file.GetSize() == 0);
+
+		CHECK(!file.Open(dir + "/missing.bin"));
+		CHECK(!file.IsOpen());
+
+		// 빈 파일은 매핑할 수 없으므로 실패
+		const string emptyName = dir + "/empty.bin";
+		ofstream(emptyName, ios::binary).close();
+		CHECK(!file.Open(emptyName));
+	}
+
+	void TestReadSourceImage(const string& dir)
+	{
+		const string fileName = dir + "/small.ppm";
+		WritePPM(fileName, 3, 2, 10);
+
+		ImageData image;
+		ImageLoader::ReadSourceImage(fileName, true, image);
+		CHECK(image.width == 3 && image.height == 2);
+		CHECK(image.format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB);
+		CHECK(!image.HasMips());
+		CHECK(image.pixels.size() == 3 * 2 * 4);
+
+		// RGB는 그대로, Alpha는 255로 채움
+		bool pixelsMatch = image.pixels.size() == 3 * 2 * 4;
+		for (size_t i = 0; pixelsMatch && i < 3 * 2; i++)
+		{
+			for (size_t c = 0; c < 3; c++)
+			{
+				pixelsMatch &= image.pixels[i * 4 + c] == uint8_t((i * 3 + c) * 7 + 10);
+			}
+			pixelsMatch &= image.pixels[i * 4 + 3] == 255;
+		}
+		CHECK(pixelsMatch);
+
+		ImageLoader::ReadSourceImage(fileName, false, image);
+		CHECK(image.format == DXGI_FORMAT_R8G8B8A8_UNORM);
+
+		// 없는 파일, 잘린 파일은 빈 이미지
+		ImageData missing;
+		ImageLoader::ReadSourceImage(dir + "/missing.ppm", false, missing);
+		CHECK(missing.IsEmpty() && missing.width == 0 && missing.height == 0);
+
+		const string truncatedName = dir + "/truncated.ppm";
+		ofstream(truncatedName, ios::binary) << "P6\n64 64\n255\nabc";
+		ImageData truncated;
+		ImageLoader::ReadSourceImage(truncatedName, false, truncated);
+		CHECK(truncated.IsEmpty());
+	}
+
+	void TestReadMeshImages(const string& dir)
+	{
+		WritePPM(dir + "/albedo.ppm", 8, 8, 1);
+		WritePPM(dir + "/normal.ppm", 8, 8, 2);
+		WritePPM(dir + "/emissive.ppm", 8, 8, 3);
+
+		// 두 Mesh가 같은 Albedo를 사용
+		MeshData meshA;
+		meshA.albedoTextureFileName = dir + "/albedo.ppm";
+		meshA.normalTextureFileName = dir + "/normal.ppm";
+		MeshData meshB;
+		meshB.albedoTextureFileName = dir + "/./albedo.ppm"; // 경로가 달라도 같은 파일이면 같은 key
+		meshB.emissiveTextureFileName = dir + "/emissive.ppm";
+
+		const size_t missCount = ImageLoader::GetCache().GetMissCount();
+
+		MeshImages imagesA;
+		MeshImages imagesB;
+		ThreadPool::GetInstance().ParallelFor(0, 2, [&](size_t i) {
+			ImageLoader::ReadMeshImages(i == 0 ? meshA : meshB, i == 0 ? imagesA : imagesB);
+		});
+
+		CHECK(imagesA.albedo && imagesA.albedo == imagesB.albedo);
+		CHECK(imagesA.normal && imagesA.normal->width == 8);
+		CHECK(imagesB.emissive && imagesB.emissive->format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB);
+		CHECK(imagesA.normal->format == DXGI_FORMAT_R8G8B8A8_UNORM);
+		CHECK(!imagesA.emissive && !imagesA.height && !imagesA.orm);
+		CHECK(ImageLoader::GetCache().GetMissCount() - missCount == 3); // 파일 3개를 한 번씩만 Decoding
+
+		// skip이 true인 key는 읽지 않음 (이미 GPU에 있는 Texture)
+		const string normalKey = ImageLoader::MakeKey(meshA.normalTextureFileName, false);
+		MeshImages skipped;
+		ImageLoader::ReadMeshImages(meshA, skipped, [&](const string& key) { return key == normalKey; });
+		CHECK(skipped.albedo == imagesA.albedo);
+		CHECK(!skipped.normal);
+
+		// 건너뛴 것도 key는 있고 image가 nullptr
+		vector<KeyedImage> keyedImages;
+		ImageLoader::GetMeshImageKeys(meshA, skipped, keyedImages);
+		CHECK(keyedImages.size() == 2);
+		if (keyedImages.size() == 2)
+		{
+			CHECK(keyedImages[0].key == ImageLoader::MakeKey(meshA.albedoTextureFileName, true));
+			CHECK(keyedImages[0].image == imagesA.albedo);
+			CHECK(keyedImages[1].key == normalKey && !keyedImages[1].image);
+		}
+	}
+
+	void Benchmark(const string& dir)
+	{
+		const int fileCount = 32;
+		const int size = 1024;
+
+		vector<MeshData> meshes(fileCount / 4);
+		vector<string> fileNames;
+		for (int i = 0; i < fileCount; i++)
+		{
+			fileNames.push_back(dir + "/bench" + to_string(i) + ".ppm");
+			WritePPM(fileNames.back(), size, size, uint8_t(i));
+		}
+		for (size_t m = 0; m < meshes.size(); m++)
+		{
+			meshes[m].albedoTextureFileName = fileNames[m * 4 + 0];
+			meshes[m].emissiveTextureFileName = fileNames[m * 4 + 1];
+			meshes[m].normalTextureFileName = fileNames[m * 4 + 2];
+			meshes[m].heightTextureFileName = fileNames[m * 4 + 3];
+		}
+
+		// 이전 방식 (stdio로 읽으면서 Decoding, 비교용)
+		const double stdioMs = MeasureMs([&]() {
+			for (const string& fileName : fileNames)
+			{
+				int width, height, channels;
+				stbi_image_free(stbi_load(fileName.c_str(), &width, &height, &channels, 0));
+			}
+		});
+
+		const double mappedMs = MeasureMs([&]() {
+			for (const string& fileName : fileNames)
+			{
+				ImageData image;
+				ImageLoader::ReadSourceImage(fileName, false, image);
+			}
+		});
+
+		// Mesh와 Texture 종류를 모두 병렬로 (Model이 불러오는 방식), 끝나면 Cache에서 해제됨
+		const double parallelMs = MeasureMs([&]() {
+			vector<MeshImages> images(meshes.size());
+			ThreadPool::GetInstance().ParallelFor(0, meshes.size(), [&](size_t m) {
+				ImageLoader::ReadMeshImages(meshes[m], images[m]);
+			});
+		});
+
+		cout << fileCount << " images " << size << "x" << size << " RGB:" << endl;
+		cout << "  stbi_load (stdio): " << stdioMs << " ms" << endl;
+		cout << "  ReadSourceImage (mapped): " << mappedMs << " ms" << endl;
+		cout << "  ReadMeshImages (" << ThreadPool::GetInstance().GetThreadCount() + 1
+			 << " threads): " << parallelMs << " ms" << endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const string dir = (filesystem::temp_directory_path() / "TestImageLoader").string();
+	filesystem::create_directories(dir);
+
+	TestMappedFile(dir);
+	TestReadSourceImage(dir);
+	TestReadMeshImages(dir);
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark(dir);
+	}
+
+	filesystem::remove_all(dir);
+
+	return ReportChecks("TestImageLoader");
+}
@@ -0,0 +1,291 @@
+// IndexNarrower: 16-bit 경계(Vertex 65535/65536/65537개), 구간 나누기(삼각형 단위, 참조 범위, BaseVertex),
+// SSE2 Narrow와 Scalar 비교(Pack 부호 처리 경계 값), Build가 너무 잘게 나뉘면 32-bit로 되돌리는지,
+// ForEachChunkRange(Model::DrawIndexRange)로 LOD/Meshlet 범위를 그렸을 때 원래 Index와 같은지
+// Benchmark는 큰 Index Buffer의 Build 시간과 크기
+// 사용법: TestIndexNarrower [--bench]
+
+#include "IndexNarrower.h"
+#include "TestCommon.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	// 구간이 빈틈없이 이어지고, 삼각형 경계에서 나뉘고, 참조 범위가 16-bit이며 BaseVertex가 최솟값인지
+	bool IsValidSplit(const vector<uint32_t>& indices, const vector<IndexChunk>& chunks)
+	{
+		uint32_t nextOffset = 0;
+		for (size_t c = 0; c < chunks.size(); c++)
+		{
+			const IndexChunk& chunk = chunks[c];
+			if (chunk.indexOffset != nextOffset || chunk.indexCount == 0 ||
+				(c + 1 < chunks.size() && chunk.indexCount % 3 != 0))
+			{
+				return false;
+			}
+
+			const auto begin = indices.begin() + chunk.indexOffset;
+			const auto end = begin + chunk.indexCount;
+			const uint32_t chunkMin = *min_element(begin, end);
+			const uint32_t chunkMax = *max_element(begin, end);
+			if (chunk.baseVertex != chunkMin || chunkMax - chunkMin >= IndexNarrower::MAX_VERTEX_RANGE)
+			{
+				return false;
+			}
+			nextOffset += chunk.indexCount;
+		}
+		return nextOffset == indices.size();
+	}
+
+	// 각 구간의 16-bit Index + BaseVertex가 원래 Index
+	bool RestoresIndices(const vector<uint32_t>& indices, const vector<uint16_t>& narrow, const vector<IndexChunk>& chunks)
+	{
+		bool same = narrow.size() == indices.size();
+		for (const IndexChunk& chunk : chunks)
+		{
+			for (uint32_t i = chunk.indexOffset; same && i < chunk.indexOffset + chunk.indexCount; i++)
+			{
+				same = narrow[i] + chunk.baseVertex == indices[i];
+			}
+		}
+		return same;
+	}
+
+	// 0, 1, ..., vertexCount - 1을 모두 쓰는 삼각형 (Index 순서대로)
+	vector<uint32_t> MakeStrip(const uint32_t vertexCount)
+	{
+		vector<uint32_t> indices;
+		for (uint32_t v = 0; v + 2 < vertexCount; v++)
+		{
+			indices.insert(indices.end(), { v, v + 1, v + 2 });
+		}
+		return indices;
+	}
+
+	void TestBoundary()
+	{
+		// 65536개(0 ~ 65535)까지는 구간 하나, 65537개부터 둘
+		for (const uint32_t vertexCount : { 65535u, 65536u, 65537u })
+		{
+			const vector<uint32_t> indices = MakeStrip(vertexCount);
+			const vector<IndexChunk> chunks = IndexNarrower::Split(indices.data(), indices.size());
+			CHECK(chunks.size() == (vertexCount <= 65536 ? 1u : 2u));
+			CHECK(IsValidSplit(indices, chunks));
+		}
+
+		// 삼각형 하나가 0과 65535를 참조해도 16-bit, 65536이면 다음 구간으로
+		vector<uint32_t> wide = { 0, 1, 65535, 65535, 1, 2 };
+		CHECK(IndexNarrower::Split(wide.data(), wide.size()).size() == 1);
+		wide.insert(wide.end(), { 2, 65536, 3 });
+		const vector<IndexChunk> wideChunks = IndexNarrower::Split(wide.data(), wide.size());
+		CHECK(wideChunks.size() == 2 && wideChunks[1].indexOffset == 6 && wideChunks[1].baseVertex == 2);
+		CHECK(IsValidSplit(wide, wideChunks));
+
+		// 혼자서 16-bit를 넘는 삼각형은 나눌 수 없으므로 그대로 (Build는 32-bit로)
+		const vector<uint32_t> huge = { 0, 70000, 1 };
+		CHECK(IndexNarrower::Split(huge.data(), huge.size()).size() == 1);
+
+		// 빈 Buffer, 3의 배수가 아닌 끝
+		CHECK(IndexNarrower::Split(nullptr, 0).empty());
+		const vector<uint32_t> partial = { 5, 6, 7, 8 };
+		const vector<IndexChunk> partialChunks = IndexNarrower::Split(partial.data(), partial.size());
+		CHECK(partialChunks.size() == 1 && partialChunks[0].indexCount == 4 && partialChunks[0].baseVertex == 5);
+	}
+
+	void TestNarrow()
+	{
+		// SSE2 8개 단위와 남은 Index, Pack의 부호 경계 (0, 32767, 32768, 65535)
+		const uint32_t values[] = { 0, 1, 32766, 32767, 32768, 32769, 65534, 65535 };
+		for (const uint32_t baseVertex : { 0u, 1u, 100000u, 0xFFFF0000u })
+		{
+			for (size_t count = 0; count <= 19; count++)
+			{
+				vector<uint32_t> indices(count);
+				for (size_t i = 0; i < count; i++)
+				{
+					indices[i] = baseVertex + values[(i * 5) % size(values)];
+				}
+
+				vector<uint16_t> output(count + 1, 0xABCD);
+				IndexNarrower::Narrow(indices.data(), count, baseVertex, output.data());
+				bool same = output[count] == 0xABCD;
+				for (size_t i = 0; i < count; i++)
+				{
+					same &= output[i] == uint16_t(indices[i] - baseVertex);
+				}
+				CHECK(same);
+			}
+		}
+	}
+
+	void TestBuild()
+	{
+		mt19937 random(1);
+
+		// 작은 Mesh는 구간 하나, 65535가 0xFFFF로
+		vector<uint32_t> indices = MakeStrip(65536);
+		vector<uint16_t> narrow;
+		vector<IndexChunk> chunks;
+		CHECK(IndexNarrower::Build(indices.data(), indices.size(), narrow, chunks));
+		CHECK(chunks.size() == 1 && RestoresIndices(indices, narrow, chunks));
+		CHECK(*max_element(narrow.begin(), narrow.end()) == 0xFFFF);
+
+		// Vertex 30만 개, Index 순서대로 쓰는 Mesh는 구간 5개 (각 구간의 삼각형은 1024개 이상)
+		indices = MakeStrip(300000);
+		CHECK(IndexNarrower::Build(indices.data(), indices.size(), narrow, chunks));
+		CHECK(chunks.size() == 5 && IsValidSplit(indices, chunks) && RestoresIndices(indices, narrow, chunks));
+
+		// Vertex를 무작위로 참조하면 구간마다 삼각형이 너무 적으므로 32-bit 그대로
+		vector<uint32_t> scattered(30000);
+		uniform_int_distribution<uint32_t> vertex(0, 299999);
+		for (uint32_t& index : scattered)
+		{
+			index = vertex(random);
+		}
+		narrow.assign(5, 0);
+		CHECK(!IndexNarrower::Build(scattered.data(), scattered.size(), narrow, chunks));
+		CHECK(narrow.empty() && chunks.empty());
+
+		// 구간당 평균 1024개 경계: 구간 2개에 삼각형 2048개면 16-bit, 2047개면 32-bit
+		for (const uint32_t triangleCount : { 2048u, 2047u })
+		{
+			vector<uint32_t> twoChunks;
+			for (uint32_t t = 0; t < triangleCount; t++)
+			{
+				const uint32_t base = (t < triangleCount / 2) ? 0 : 100000;
+				twoChunks.insert(twoChunks.end(), { base + t, base + t + 1, base + t + 2 });
+			}
+			CHECK(IndexNarrower::Build(twoChunks.data(), twoChunks.size(), narrow, chunks) == (triangleCount == 2048));
+		}
+	}
+
+	// ForEachChunkRange로 나눈 Draw들이 그리는 Index (DrawIndexed(count, offset, baseVertex)를 CPU에서 재현)
+	vector<uint32_t> Draw(const vector<uint16_t>& narrow, const vector<IndexChunk>& chunks, const uint32_t indexOffset,
+						  const uint32_t indexCount, size_t& drawCount, bool& ordered)
+	{
+		vector<uint32_t> drawn;
+		uint32_t next = indexOffset;
+		drawCount = 0;
+		ordered = true;
+		IndexNarrower::ForEachChunkRange(chunks, indexOffset, indexCount, [&](uint32_t count, uint32_t offset, uint32_t baseVertex) {
+			ordered &= offset == next && count > 0;
+			next = offset + count;
+			drawCount++;
+			for (uint32_t i = offset; i < offset + count; i++)
+			{
+				drawn.push_back(narrow[i] + baseVertex);
+			}
+		});
+		return drawn;
+	}
+
+	void TestChunkRanges()
+	{
+		// LOD 0 (Vertex 30만 개) 뒤에 LOD 1을 이어붙인 Buffer, Model처럼 전체를 한 번에 Build
+		vector<uint32_t> indices = MakeStrip(300000);
+		const uint32_t lod0Count = uint32_t(indices.size());
+		for (uint32_t v = 0; v + 4 < 300000; v += 2)
+		{
+			indices.insert(indices.end(), { v, v + 2, v + 4 });
+		}
+		const uint32_t lod1Count = uint32_t(indices.size()) - lod0Count;
+
+		vector<uint16_t> narrow;
+		vector<IndexChunk> chunks;
+		CHECK(IndexNarrower::Build(indices.data(), indices.size(), narrow, chunks) && chunks.size() > 6);
+
+		// LOD 전체, 구간 경계에 걸친 범위, 구간 하나 안의 범위, 빈 범위, 임의의 Meshlet 범위
+		struct Range {
+			uint32_t offset;
+			uint32_t count;
+		};
+		vector<Range> ranges = { { 0, lod0Count }, { lod0Count, lod1Count }, { 0, uint32_t(indices.size()) },
+								 { chunks[1].indexOffset - 3, 6 }, { chunks[1].indexOffset, chunks[1].indexCount },
+								 { chunks[2].indexOffset + 3, 3 }, { 123, 0 } };
+		mt19937 random(2);
+		uniform_int_distribution<uint32_t> triangle(0, uint32_t(indices.size() / 3) - 1);
+		for (int i = 0; i < 500; i++)
+		{
+			const uint32_t a = triangle(random), b = triangle(random);
+			ranges.push_back({ min(a, b) * 3, (max(a, b) - min(a, b) + 1) * 3 });
+		}
+
+		bool same = true, ordered = true, minimal = true;
+		for (const Range& range : ranges)
+		{
+			size_t drawCount = 0;
+			bool inOrder = true;
+			const vector<uint32_t> drawn = Draw(narrow, chunks, range.offset, range.count, drawCount, inOrder);
+			same &= equal(drawn.begin(), drawn.end(), indices.begin() + range.offset, indices.begin() + range.offset + range.count) &&
+					drawn.size() == range.count;
+			ordered &= inOrder;
+
+			// 겹치는 구간 수만큼만 Draw
+			size_t overlapping = 0;
+			for (const IndexChunk& chunk : chunks)
+			{
+				overlapping += range.count > 0 && chunk.indexOffset < range.offset + range.count &&
+							   range.offset < chunk.indexOffset + chunk.indexCount;
+			}
+			minimal &= drawCount == overlapping;
+		}
+		CHECK(same);
+		CHECK(ordered);
+		CHECK(minimal);
+
+		// 32-bit Mesh는 Model이 구간 하나 (baseVertex 0)로 그림
+		size_t drawCount = 0;
+		bool inOrder = true;
+		const vector<IndexChunk> single = { { 0, lod0Count, 0 } };
+		vector<uint16_t> identity(lod0Count);
+		iota(identity.begin(), identity.end(), uint16_t(0));
+		Draw(identity, single, 30, 60, drawCount, inOrder);
+		CHECK(drawCount == 1 && inOrder);
+	}
+
+	void Benchmark()
+	{
+		// Vertex 400만 개를 Index 순서대로 쓰는 Mesh (Vertex Cache 최적화 뒤처럼 대부분 가까운 Index)
+		const vector<uint32_t> indices = MakeStrip(4000000);
+
+		vector<IndexChunk> chunks;
+		const double splitMs = MeasureMs([&]() { chunks = IndexNarrower::Split(indices.data(), indices.size()); });
+
+		vector<uint16_t> narrow(indices.size());
+		const double narrowMs = MeasureMs([&]() { IndexNarrower::Narrow(indices.data(), indices.size(), 0, narrow.data()); });
+		const double scalarMs = MeasureMs([&]() {
+			volatile uint32_t baseVertex = 0;
+			const uint32_t base = baseVertex;
+			for (size_t i = 0; i < indices.size(); i++)
+			{
+				narrow[i] = uint16_t(indices[i] - base);
+			}
+		});
+
+		vector<uint16_t> output;
+		const double buildMs = MeasureMs([&]() { IndexNarrower::Build(indices.data(), indices.size(), output, chunks); });
+
+		cout << indices.size() << " indices: " << chunks.size() << " chunks, " << indices.size() * 4 / 1024 << " KB -> "
+			 << output.size() * 2 / 1024 << " KB, Split " << splitMs << " ms, Narrow " << narrowMs << " ms (scalar "
+			 << scalarMs << " ms), Build " << buildMs << " ms" << endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	TestBoundary();
+	TestNarrow();
+	TestBuild();
+	TestChunkRanges();
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark();
+	}
+
+	return ReportChecks("TestIndexNarrower");
+}
@@ -0,0 +1,217 @@
+// MaterialPacker (AO/Roughness/Metallic -> ORM 하나, .packed.dds 저장본 재사용)
+// 사용법: TestMaterialPacker [--bench]
+
+#include "MaterialPacker.h"
+#include "TestCommon.h"
+#include "TextureBaker.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	// stb_image가 읽을 수 있는 Binary PPM (RGB 8-bit), value(x, y, channel)
+	void WritePPM(const string& fileName, const int width, const int height,
+				  const function<uint8_t(int, int, int)>& value)
+	{
+		ofstream file(fileName, ios::binary);
+		file << "P6\n" << width << " " << height << "\n255\n";
+		for (int y = 0; y < height; y++)
+		{
+			for (int x = 0; x < width; x++)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					file.put(char(value(x, y, c)));
+				}
+			}
+		}
+	}
+
+	int Pixel(const ImageData& image, const int x, const int y, const int channel)
+	{
+		return image.pixels[(size_t(y) * image.width + x) * 4 + channel];
+	}
+
+	void TestSources()
+	{
+		// 따로 있으면 각 파일의 Red
+		const ChannelSources separate = MaterialPacker::GetORMSources("ao.png", "rough.png", "metal.png");
+		CHECK(separate[0].fileName == "ao.png" && separate[0].channel == 0);
+		CHECK(separate[1].fileName == "rough.png" && separate[1].channel == 0);
+		CHECK(separate[2].fileName == "metal.png" && separate[2].channel == 0);
+		CHECK(separate[3].fileName.empty() && separate[3].defaultValue == 255);
+
+		// GLTF처럼 Roughness와 Metallic이 같은 파일이면 G/B 그대로
+		const ChannelSources gltf = MaterialPacker::GetORMSources("", "mr.png", "mr.png");
+		CHECK(gltf[0].fileName.empty() && gltf[0].defaultValue == 255);
+		CHECK(gltf[1].channel == 1 && gltf[2].channel == 2);
+	}
+
+	void TestResample()
+	{
+		// 8x8 -> 4x4 Box 축소: 100, 200이 번갈아 있으면 150
+		vector<uint8_t> src(8 * 8 * 4, 0);
+		for (int i = 0; i < 64; i++)
+		{
+			src[i * 4 + 1] = uint8_t(i % 2 ? 200 : 100);
+		}
+		vector<uint8_t> dst(4 * 4 * 4, 7);
+		MaterialPacker::ResampleChannel(src.data(), 8, 8, 1, dst.data(), 4, 4, 0);
+
+		bool allAverage = true;
+		bool othersKept = true;
+		for (int i = 0; i < 16; i++)
+		{
+			allAverage &= dst[i * 4] == 150;
+			othersKept &= dst[i * 4 + 1] == 7 && dst[i * 4 + 2] == 7 && dst[i * 4 + 3] == 7;
+		}
+		CHECK(allAverage);
+		CHECK(othersKept);
+
+		// 2x1 -> 4x1 Bilinear 확대는 양 끝 값이 유지되고 사이가 단조 증가
+		const uint8_t edge[] = { 0, 0, 0, 0, 200, 0, 0, 0 };
+		uint8_t wide[16] = {};
+		MaterialPacker::ResampleChannel(edge, 2, 1, 0, wide, 4, 1, 0);
+		CHECK(wide[0] == 0 && wide[12] == 200);
+		CHECK(wide[0] <= wide[4] && wide[4] < wide[8] && wide[8] <= wide[12]);
+	}
+
+	void TestPack(const string& dir)
+	{
+		// AO 64x64 가로 Gradient, Roughness 128x128 상수, Metallic 32x16 Checker
+		const string ao = dir + "/ao.ppm";
+		const string roughness = dir + "/rough.ppm";
+		const string metallic = dir + "/metal.ppm";
+		WritePPM(ao, 64, 64, [](int x, int, int) { return uint8_t(x * 4); });
+		WritePPM(roughness, 128, 128, [](int, int, int) { return uint8_t(100); });
+		WritePPM(metallic, 32, 16, [](int x, int y, int) { return uint8_t((x / 4 + y / 4) & 1 ? 255 : 0); });
+
+		const ChannelSources sources = MaterialPacker::GetORMSources(ao, roughness, metallic);
+		ImageData image;
+		CHECK(MaterialPacker::Pack(sources, image));
+		CHECK(image.width == 128 && image.height == 128); // 가장 큰 것에 맞춤
+		CHECK(image.format == DXGI_FORMAT_R8G8B8A8_UNORM && !image.HasMips());
+		if (image.width != 128 || image.height != 128)
+		{
+			return;
+		}
+
+		// 두 배로 늘어난 AO는 x * 2 근처
+		CHECK(abs(Pixel(image, 64, 5, 0) - 128) <= 2);
+		CHECK(Pixel(image, 0, 5, 0) <= 2 && Pixel(image, 127, 5, 0) >= 250);
+		CHECK(Pixel(image, 3, 3, 1) == 100);
+		CHECK(Pixel(image, 8, 16, 2) == 0 && Pixel(image, 24, 16, 2) == 255); // Checker 칸 가운데
+		CHECK(Pixel(image, 9, 9, 3) == 255);
+
+		// GLTF: 한 파일의 G/B, AO가 없으면 255
+		const string metallicRoughness = dir + "/mr.ppm";
+		WritePPM(metallicRoughness, 16, 16,
+				 [](int, int, int c) { return uint8_t(c == 1 ? 77 : c == 2 ? 200 : 9); });
+		ImageData gltf;
+		CHECK(MaterialPacker::Pack(MaterialPacker::GetORMSources("", metallicRoughness, metallicRoughness), gltf));
+		CHECK(gltf.width == 16 && Pixel(gltf, 1, 1, 0) == 255 && Pixel(gltf, 1, 1, 1) == 77 &&
+			  Pixel(gltf, 1, 1, 2) == 200);
+
+		// 읽은 파일이 하나도 없으면 실패
+		ImageData none;
+		CHECK(!MaterialPacker::Pack(MaterialPacker::GetORMSources(dir + "/missing.ppm", "", ""), none));
+	}
+
+	void TestCache(const string& dir)
+	{
+		const string ao = dir + "/cache_ao.ppm";
+		const string roughness = dir + "/cache_rough.ppm";
+		WritePPM(ao, 128, 128, [](int x, int y, int) { return uint8_t(x + y); });
+		WritePPM(roughness, 128, 128, [](int x, int, int) { return uint8_t(255 - x); });
+		const ChannelSources sources = MaterialPacker::GetORMSources(ao, roughness, "");
+
+		// 첫 번째 원본 옆에 원본 이름을 이어서
+		const string cachePath = MaterialPacker::GetCachePath(sources);
+		CHECK(filesystem::path(cachePath).parent_path() == filesystem::path(ao).parent_path());
+		CHECK(cachePath.size() > 11 && cachePath.compare(cachePath.size() - 11, 11, ".packed.dds") == 0);
+		CHECK(!MaterialPacker::IsUpToDate(sources));
+
+		// 처음에는 Pack + Mipmap 생성 후 저장
+		ImageData first;
+		CHECK(MaterialPacker::ReadPacked(sources, first));
+		CHECK(first.mipLevels == 8 && first.format == DXGI_FORMAT_R8G8B8A8_UNORM);
+		CHECK(filesystem::exists(cachePath) && MaterialPacker::IsUpToDate(sources));
+
+		// 두 번째는 저장본을 그대로 읽음 (다시 쓰지 않음)
+		const auto writeTime = filesystem::last_write_time(cachePath);
+		ImageData second;
+		CHECK(MaterialPacker::ReadPacked(sources, second));
+		CHECK(second.pixels == first.pixels && second.mipLevels == first.mipLevels);
+		CHECK(filesystem::last_write_time(cachePath) == writeTime);
+
+		// 원본이 더 새로우면 다시 만듦
+		filesystem::last_write_time(cachePath, filesystem::last_write_time(roughness) - chrono::seconds(2));
+		CHECK(!MaterialPacker::IsUpToDate(sources));
+
+		// BakeTextures: BC7 + Mipmap으로 저장, 최신이면 건너뜀
+		CHECK(MaterialPacker::BakeFile(sources));
+		ImageData baked;
+		CHECK(TextureBaker::ReadDDS(cachePath, baked));
+		CHECK(baked.format == DXGI_FORMAT_BC7_UNORM && baked.mipLevels == 8);
+		CHECK(MaterialPacker::IsUpToDate(sources));
+		CHECK(!MaterialPacker::BakeFile(sources));
+		CHECK(MaterialPacker::BakeFile(sources, true));
+
+		// 같은 경로는 한 번만
+		CHECK(MaterialPacker::BakeFiles({ sources, sources }, true) == 1);
+	}
+
+	void Benchmark(const string& dir)
+	{
+		for (const int size : { 1024, 2048 })
+		{
+			const string ao = dir + "/bench_ao" + to_string(size) + ".ppm";
+			const string metallicRoughness = dir + "/bench_mr" + to_string(size) + ".ppm";
+			WritePPM(ao, size / 2, size / 2, [](int x, int y, int) { return uint8_t(x ^ y); });
+			WritePPM(metallicRoughness, size, size, [](int x, int y, int c) { return uint8_t(x * c + y); });
+			const ChannelSources sources = MaterialPacker::GetORMSources(ao, metallicRoughness, metallicRoughness);
+
+			ImageData image;
+			const double packMs = MeasureMs([&]() { MaterialPacker::Pack(sources, image); });
+
+			const double missMs = MeasureMs([&]() {
+				filesystem::remove(MaterialPacker::GetCachePath(sources));
+				MaterialPacker::ReadPacked(sources, image);
+			});
+			const double hitMs = MeasureMs([&]() { MaterialPacker::ReadPacked(sources, image); });
+			const double bakeMs = MeasureMs([&]() { MaterialPacker::BakeFile(sources, true); }, 1);
+
+			cout << size << "x" << size << " (AO " << size / 2 << "x" << size / 2 << " upsampled): Pack "
+				 << packMs << " ms, ReadPacked miss " << missMs << " ms, hit " << hitMs << " ms, BakeFile (BC7) "
+				 << bakeMs << " ms" << endl;
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const string dir = (filesystem::temp_directory_path() / "TestMaterialPacker").string();
+	filesystem::remove_all(dir);
+	filesystem::create_directories(dir);
+
+	TestSources();
+	TestResample();
+	TestPack(dir);
+	TestCache(dir);
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark(dir);
+	}
+
+	filesystem::remove_all(dir);
+
+	return ReportChecks("TestMaterialPacker");
+}
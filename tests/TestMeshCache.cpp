@@ -0,0 +1,325 @@
+// MeshCache (.cmesh 저장, mmap으로 읽기)의 Round-trip과 버려야 하는 캐시(오래됨, 옵션/VERSION 다름, 잘림)
+// Benchmark는 캐시가 건너뛰는 Import 뒤 처리(경계, Optimize, LOD)와 캐시 읽기를 비교
+// Assimp 읽기 시간은 빠져 있으므로 실제 ReadFromFile()과의 차이는 이보다 큼
+// 사용법: TestMeshCache [--bench]
+
+#include "BoundsCalculator.h"
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "TestCommon.h"
+#include "ThreadPool.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	// 반지름 1 근처의 울퉁불퉁한 구, UV Seam이 있음 (segments * segments * 4개 삼각형)
+	MeshData MakeSphere(const int segments, mt19937& random)
+	{
+		MeshData mesh;
+		uniform_real_distribution<float> offset(-0.02f, 0.02f);
+		const int columns = segments * 2 + 1;
+		for (int i = 0; i <= segments; i++)
+		{
+			for (int j = 0; j < columns; j++)
+			{
+				const float theta = XM_PI * float(i) / float(segments);
+				const float phi = XM_PI * float(j) / float(segments);
+				const Vector3 normal(sin(theta) * cos(phi), cos(theta), sin(theta) * sin(phi));
+
+				Vertex v = {};
+				v.position = normal * (1.0f + offset(random));
+				v.normalModel = normal;
+				v.texcoord = Vector2(float(j) / float(columns - 1), float(i) / float(segments));
+				v.tangentModel = Vector4(-sin(phi), 0.0f, cos(phi), 1.0f);
+				mesh.vertices.push_back(v);
+			}
+		}
+
+		for (int i = 0; i < segments; i++)
+		{
+			for (int j = 0; j < segments * 2; j++)
+			{
+				const uint32_t a = i * columns + j;
+				const uint32_t c = a + columns;
+				mesh.indices.insert(mesh.indices.end(), { a, c, a + 1, a + 1, c, c + 1 });
+			}
+		}
+		return mesh;
+	}
+
+	void WriteText(const string& fileName, const string& text)
+	{
+		ofstream file(fileName, ios::binary | ios::trunc);
+		file << text;
+	}
+
+	void Truncate(const string& fileName, const uintmax_t size)
+	{
+		filesystem::resize_file(fileName, size);
+	}
+
+	void Patch(const string& fileName, const size_t offset, const uint32_t value)
+	{
+		fstream file(fileName, ios::binary | ios::in | ios::out);
+		file.seekp(streamoff(offset));
+		file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	bool SameVertices(const Vertex* a, const Vertex* b, const size_t count)
+	{
+		return count == 0 || memcmp(a, b, sizeof(Vertex) * count) == 0;
+	}
+
+	// Mesh 3개: LOD가 있는 구, Texture만 있는 빈 Mesh, LOD가 MAX_LODS보다 많은 작은 구
+	vector<MeshData> MakeMeshes(mt19937& random)
+	{
+		vector<MeshData> meshes(3);
+		meshes[0] = MakeSphere(12, random);
+		meshes[0].albedoTextureFileName = "albedo.png";
+		meshes[0].roughnessTextureFileName = "metallicRoughness.png";
+		meshes[0].metallicTextureFileName = "metallicRoughness.png";
+		meshes[0].lods = MeshSimplifier::BuildLodChain(meshes[0]);
+		meshes[0].bounds = BoundsCalculator::Compute(meshes[0].vertices.data(), meshes[0].vertices.size());
+
+		meshes[1].normalTextureFileName = "normal.png";
+
+		meshes[2] = MakeSphere(3, random);
+		meshes[2].emissiveTextureFileName = "emissive.png";
+		for (uint32_t l = 0; l < MeshCache::MAX_LODS + 2; l++)
+		{
+			meshes[2].lods.push_back({ { 0, 1, 2 }, 0.1f * float(l + 1) });
+		}
+		return meshes;
+	}
+
+	void TestRoundTrip(const string& dir)
+	{
+		mt19937 random(1);
+		const vector<MeshData> meshes = MakeMeshes(random);
+		WriteText(dir + "/model.gltf", "{}");
+
+		const string cacheFileName = MeshCache::GetCacheFileName(dir + "/", "model.gltf");
+		CHECK(cacheFileName == dir + "/model.gltf.cmesh");
+		CHECK(MeshCache::Write(cacheFileName, meshes, true));
+		CHECK(!filesystem::exists(cacheFileName + ".tmp"));
+
+		shared_ptr<MeshCache> cache = MeshCache::Load(dir + "/", "model.gltf", true);
+		CHECK(cache != nullptr);
+		if (!cache)
+		{
+			return;
+		}
+		CHECK(cache->GetMeshCount() == 3);
+
+		// mmap한 메모리를 그대로 가리키고 16Byte 정렬
+		const CookedMesh& sphere = cache->GetMesh(0);
+		CHECK(sphere.vertexCount == meshes[0].vertices.size());
+		CHECK(SameVertices(sphere.vertices, meshes[0].vertices.data(), sphere.vertexCount));
+		CHECK(reinterpret_cast<uintptr_t>(sphere.vertices) % 16 == 0);
+		CHECK(reinterpret_cast<uintptr_t>(sphere.indices) % 16 == 0);
+
+		// LOD 0 뒤에 나머지 LOD를 이어붙인 Index
+		CHECK(sphere.lods.size() == meshes[0].lods.size() + 1);
+		CHECK(sphere.lods[0].indexOffset == 0 && sphere.lods[0].indexCount == meshes[0].indices.size());
+		CHECK(memcmp(sphere.indices, meshes[0].indices.data(), sizeof(uint32_t) * meshes[0].indices.size()) == 0);
+		for (size_t l = 1; l < sphere.lods.size(); l++)
+		{
+			const MeshLod& lod = meshes[0].lods[l - 1];
+			CHECK(sphere.lods[l].indexOffset == sphere.lods[l - 1].indexOffset + sphere.lods[l - 1].indexCount);
+			CHECK(sphere.lods[l].indexCount == lod.indices.size() && sphere.lods[l].error == lod.error);
+			CHECK(memcmp(sphere.indices + sphere.lods[l].indexOffset, lod.indices.data(),
+						 sizeof(uint32_t) * lod.indices.size()) == 0);
+		}
+
+		// 저장한 경계를 다시 계산하지 않고 그대로
+		const MeshBounds& bounds = meshes[0].bounds;
+		CHECK(sphere.bounds.isValid);
+		CHECK(Vector3(sphere.bounds.box.Center) == Vector3(bounds.box.Center));
+		CHECK(Vector3(sphere.bounds.box.Extents) == Vector3(bounds.box.Extents));
+		CHECK(sphere.bounds.sphere.Radius == bounds.sphere.Radius);
+		CHECK(memcmp(&sphere.bounds.orientedBox, &bounds.orientedBox, sizeof(BoundingOrientedBox)) == 0);
+
+		CHECK(sphere.material.albedoTextureFileName == "albedo.png");
+		CHECK(sphere.material.metallicTextureFileName == "metallicRoughness.png");
+		CHECK(sphere.material.normalTextureFileName.empty() && sphere.material.vertices.empty());
+
+		// 빈 Mesh도 Texture 경로는 남음, 경계가 없으면 Write()에서 계산
+		const CookedMesh& empty = cache->GetMesh(1);
+		CHECK(empty.vertexCount == 0 && empty.indexCount == 0 && empty.lods.size() == 1);
+		CHECK(empty.material.normalTextureFileName == "normal.png" && empty.bounds.isValid);
+
+		// LOD는 MAX_LODS개까지만 저장
+		const CookedMesh& small = cache->GetMesh(2);
+		CHECK(small.lods.size() == MeshCache::MAX_LODS);
+		CHECK(small.indexCount == meshes[2].indices.size() + 3 * (MeshCache::MAX_LODS - 1));
+		CHECK(small.lods.back().error == meshes[2].lods[MeshCache::MAX_LODS - 2].error);
+		const MeshBounds smallBounds = BoundsCalculator::Compute(meshes[2].vertices.data(), meshes[2].vertices.size());
+		CHECK(small.bounds.sphere.Radius == smallBounds.sphere.Radius);
+
+		// ToMeshData()는 원래 MeshData와 같은 내용
+		const vector<MeshData> copies = cache->ToMeshData();
+		CHECK(copies.size() == 3);
+		CHECK(copies[0].vertices.size() == meshes[0].vertices.size() &&
+			  SameVertices(copies[0].vertices.data(), meshes[0].vertices.data(), meshes[0].vertices.size()));
+		CHECK(copies[0].indices == meshes[0].indices && copies[0].lods.size() == meshes[0].lods.size());
+		for (size_t l = 0; l < copies[0].lods.size(); l++)
+		{
+			CHECK(copies[0].lods[l].indices == meshes[0].lods[l].indices);
+		}
+		CHECK(copies[1].vertices.empty() && copies[1].lods.empty() && copies[1].normalTextureFileName == "normal.png");
+		CHECK(copies[2].lods.size() == MeshCache::MAX_LODS - 1 && copies[2].bounds.isValid);
+
+		// Mesh가 없는 캐시
+		CHECK(MeshCache::Write(dir + "/none.gltf.cmesh", {}, false));
+		shared_ptr<MeshCache> none = MeshCache::Load(dir + "/", "none.gltf", false);
+		CHECK(none && none->GetMeshCount() == 0);
+	}
+
+	void TestRejected(const string& dir)
+	{
+		mt19937 random(2);
+		const vector<MeshData> meshes = MakeMeshes(random);
+		const string source = dir + "/reject.gltf";
+		const string cacheFileName = MeshCache::GetCacheFileName(dir + "/", "reject.gltf");
+
+		// 캐시가 없음
+		filesystem::remove(cacheFileName);
+		WriteText(source, "{}");
+		CHECK(!MeshCache::Load(dir + "/", "reject.gltf", false));
+
+		// 원본이 캐시보다 새로움, 원본이 없으면 캐시만 사용
+		CHECK(MeshCache::Write(cacheFileName, meshes, false));
+		CHECK(MeshCache::Load(dir + "/", "reject.gltf", false));
+		filesystem::last_write_time(source, filesystem::last_write_time(cacheFileName) + chrono::seconds(2));
+		CHECK(!MeshCache::Load(dir + "/", "reject.gltf", false));
+		filesystem::remove(source);
+		CHECK(MeshCache::Load(dir + "/", "reject.gltf", false));
+
+		// Import 옵션(reverseNormal)이 다름
+		CHECK(!MeshCache::Load(dir + "/", "reject.gltf", true));
+		MeshCache opened;
+		CHECK(opened.Open(cacheFileName, false) && opened.GetMeshCount() == 3);
+		CHECK(!opened.Open(cacheFileName, true) && opened.GetMeshCount() == 0);
+
+		// Header: magic, version, flags, meshCount, vertexStride 순서
+		const uintmax_t fileSize = filesystem::file_size(cacheFileName);
+		const struct {
+			size_t offset;
+			uint32_t value;
+		} patches[] = {
+			{ 0, MeshCache::MAGIC + 1 },
+			{ 4, MeshCache::VERSION - 1 },
+			{ 4, MeshCache::VERSION + 1 },
+			{ 8, 0x02 },
+			{ 12, 1000000 },
+			{ 16, uint32_t(sizeof(Vertex) - 4) },
+		};
+		for (const auto& patch : patches)
+		{
+			CHECK(MeshCache::Write(cacheFileName, meshes, false));
+			Patch(cacheFileName, patch.offset, patch.value);
+			CHECK(!opened.Open(cacheFileName, false) && opened.GetMeshCount() == 0);
+		}
+
+		// 잘린 파일: 빈 파일, Header 중간, Table 중간, 마지막 Index Data의 1Byte
+		for (const uintmax_t size : { uintmax_t(0), uintmax_t(16), uintmax_t(32 + 40), fileSize - 1 })
+		{
+			CHECK(MeshCache::Write(cacheFileName, meshes, false));
+			Truncate(cacheFileName, size);
+			CHECK(!MeshCache::Load(dir + "/", "reject.gltf", false));
+		}
+
+		// 다시 쓰면 읽을 수 있음 (.tmp를 거쳐 교체)
+		CHECK(MeshCache::Write(cacheFileName, meshes, false));
+		CHECK(MeshCache::Load(dir + "/", "reject.gltf", false));
+		CHECK(!MeshCache::Load(dir + "/missing/", "reject.gltf", false));
+	}
+
+	void Benchmark(const string& dir)
+	{
+		// 큰 Mesh 몇 개와 작은 Mesh 여러 개 (glTF 한 개 정도)
+		mt19937 random(3);
+		vector<MeshData> imported;
+		for (int i = 0; i < 4; i++)
+		{
+			imported.push_back(MakeSphere(200, random));
+		}
+		for (int i = 0; i < 60; i++)
+		{
+			imported.push_back(MakeSphere(20, random));
+		}
+
+		size_t vertexCount = 0, triangleCount = 0;
+		for (const MeshData& mesh : imported)
+		{
+			vertexCount += mesh.vertices.size();
+			triangleCount += mesh.indices.size() / 3;
+		}
+
+		// GeometryGenerator::ReadFromFile()에서 Assimp 다음에 하는 일
+		vector<MeshData> processed;
+		const double processMs = MeasureMs([&]() {
+			processed = imported;
+			BoundsCalculator::Compute(processed);
+			ThreadPool::GetInstance().ParallelFor(0, processed.size(), [&](size_t i) {
+				MeshOptimizer::Optimize(processed[i]);
+				processed[i].lods = MeshSimplifier::BuildLodChain(processed[i]);
+			});
+		}, 1);
+
+		WriteText(dir + "/bench.gltf", "{}");
+		const string cacheFileName = MeshCache::GetCacheFileName(dir + "/", "bench.gltf");
+		const double writeMs = MeasureMs([&]() { MeshCache::Write(cacheFileName, processed, false); }, 3);
+
+		// Model::Initialize()처럼 mmap한 메모리를 그대로 쓰는 경우와 ReadFromFile()처럼 복사하는 경우
+		size_t sink = 0;
+		const double loadMs = MeasureMs([&]() {
+			shared_ptr<MeshCache> cache = MeshCache::Load(dir + "/", "bench.gltf", false);
+			for (const CookedMesh& mesh : cache->GetMeshes())
+			{
+				sink += mesh.vertexCount + mesh.indices[mesh.indexCount - 1];
+			}
+		});
+		const double copyMs = MeasureMs([&]() {
+			shared_ptr<MeshCache> cache = MeshCache::Load(dir + "/", "bench.gltf", false);
+			sink += cache->ToMeshData().size();
+		});
+		CHECK(sink > 0);
+
+		cout << imported.size() << " meshes, " << vertexCount << " vertices, " << triangleCount
+			 << " triangles, cache " << filesystem::file_size(cacheFileName) / (1024 * 1024) << " MB" << endl;
+		cout << "Import processing (bounds, Optimize, LOD chain) " << processMs << " ms, Write " << writeMs
+			 << " ms" << endl;
+		cout << "Load (mmap) " << loadMs << " ms, Load + ToMeshData " << copyMs << " ms" << endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const string dir = (filesystem::temp_directory_path() / "TestMeshCache").string();
+	filesystem::remove_all(dir);
+	filesystem::create_directories(dir);
+
+	TestRoundTrip(dir);
+	TestRejected(dir);
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark(dir);
+	}
+
+	filesystem::remove_all(dir);
+
+	return ReportChecks("TestMeshCache");
+}
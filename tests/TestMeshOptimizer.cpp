@@ -0,0 +1,298 @@
+// MeshOptimizer: 최적화 후에도 같은 삼각형(같은 감는 방향)인지, Weld와 Vertex Fetch 순서, ACMR/ATVR 감소, 삼각형 0~1개
+// Benchmark는 삼각형 순서를 섞은 Grid의 단계별 시간과 ACMR/ATVR
+// 사용법: TestMeshOptimizer [--bench]
+
+#include "MeshOptimizer.h"
+#include "TestCommon.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	Vertex MakeVertex(const int x, const int y, const int size)
+	{
+		Vertex v = {};
+		v.position = Vector3(float(x), sin(float(x + y) * 0.3f), float(y));
+		v.normalModel = Vector3(0.0f, 1.0f, 0.0f);
+		v.texcoord = Vector2(float(x) / float(size), float(y) / float(size));
+		return v;
+	}
+
+	// size x size Grid를 삼각형마다 Vertex 3개씩(Index 없이 펼친 것처럼) 만들고 삼각형 순서를 섞음
+	MeshData MakeShuffledSoup(const int size, mt19937& random)
+	{
+		vector<array<Vertex, 3>> triangles;
+		for (int y = 0; y < size; y++)
+		{
+			for (int x = 0; x < size; x++)
+			{
+				triangles.push_back({ MakeVertex(x, y, size), MakeVertex(x, y + 1, size), MakeVertex(x + 1, y, size) });
+				triangles.push_back(
+					{ MakeVertex(x + 1, y, size), MakeVertex(x, y + 1, size), MakeVertex(x + 1, y + 1, size) });
+			}
+		}
+		shuffle(triangles.begin(), triangles.end(), random);
+
+		MeshData mesh;
+		for (const array<Vertex, 3>& triangle : triangles)
+		{
+			for (const Vertex& v : triangle)
+			{
+				mesh.indices.push_back(uint32_t(mesh.vertices.size()));
+				mesh.vertices.push_back(v);
+			}
+		}
+		return mesh;
+	}
+
+	// 삼각형을 Vertex 내용으로 표현 (가장 작은 꼭짓점부터 회전 => 감는 방향은 유지)
+	vector<string> GetTriangles(const MeshData& mesh)
+	{
+		vector<string> triangles;
+		for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3)
+		{
+			array<string, 3> corners;
+			for (int k = 0; k < 3; k++)
+			{
+				corners[k].assign(reinterpret_cast<const char*>(&mesh.vertices[mesh.indices[t + k]]), sizeof(Vertex));
+			}
+			rotate(corners.begin(), min_element(corners.begin(), corners.end()), corners.end());
+			triangles.push_back(corners[0] + corners[1] + corners[2]);
+		}
+		sort(triangles.begin(), triangles.end());
+		return triangles;
+	}
+
+	bool AllUnique(const vector<Vertex>& vertices)
+	{
+		vector<string> keys;
+		for (const Vertex& v : vertices)
+		{
+			keys.emplace_back(reinterpret_cast<const char*>(&v), sizeof(Vertex));
+		}
+		sort(keys.begin(), keys.end());
+		return adjacent_find(keys.begin(), keys.end()) == keys.end();
+	}
+
+	// 처음 사용되는 순서대로 0, 1, 2, ... 이고 모든 Vertex가 사용됨
+	bool IsFetchOrdered(const MeshData& mesh)
+	{
+		uint32_t next = 0;
+		for (const uint32_t index : mesh.indices)
+		{
+			if (index > next)
+			{
+				return false;
+			}
+			next += (index == next);
+		}
+		return next == mesh.vertices.size();
+	}
+
+	void TestWeld()
+	{
+		mt19937 random(1);
+		MeshData mesh = MakeShuffledSoup(10, random);
+		const vector<string> triangles = GetTriangles(mesh);
+
+		MeshOptimizer::WeldVertices(mesh);
+		CHECK(mesh.vertices.size() == 11 * 11);
+		CHECK(AllUnique(mesh.vertices));
+		CHECK(GetTriangles(mesh) == triangles);
+
+		// Normal이나 UV만 달라도 합치지 않음 (Seam 유지)
+		MeshData seam;
+		for (int i = 0; i < 3; i++)
+		{
+			seam.vertices.push_back(MakeVertex(i, 0, 4));
+		}
+		seam.vertices.push_back(seam.vertices[0]);
+		seam.vertices.push_back(seam.vertices[1]);
+		seam.vertices.back().texcoord.x += 0.5f;
+		seam.vertices.push_back(seam.vertices[2]);
+		seam.vertices.back().normalModel = Vector3(1.0f, 0.0f, 0.0f);
+		seam.indices = { 0, 1, 2, 3, 4, 5 };
+		MeshOptimizer::WeldVertices(seam);
+		CHECK(seam.vertices.size() == 5);
+		CHECK(seam.indices[3] == seam.indices[0] && seam.indices[4] != seam.indices[1] && seam.indices[5] != seam.indices[2]);
+
+		// 이미 중복이 없으면 그대로
+		MeshData unique = seam;
+		MeshOptimizer::WeldVertices(unique);
+		CHECK(unique.indices == seam.indices && unique.vertices.size() == seam.vertices.size());
+	}
+
+	void TestOptimize()
+	{
+		mt19937 random(2);
+		for (const int size : { 2, 10, 60 })
+		{
+			MeshData mesh = MakeShuffledSoup(size, random);
+			const vector<string> triangles = GetTriangles(mesh);
+
+			const MeshOptimizerStats stats = MeshOptimizer::Optimize(mesh);
+			CHECK(GetTriangles(mesh) == triangles);
+			CHECK(IsFetchOrdered(mesh));
+			CHECK(stats.vertexCountBefore == size_t(size) * size * 6);
+			CHECK(stats.vertexCountAfter == size_t(size + 1) * (size + 1) && mesh.vertices.size() == stats.vertexCountAfter);
+
+			// 펼친 Mesh는 삼각형마다 Vertex 3개 (ACMR 3, ATVR 1)
+			CHECK(stats.acmrBefore == 3.0f && stats.atvrBefore == 1.0f);
+			CHECK(stats.acmrAfter < stats.acmrBefore && stats.atvrAfter >= 1.0f);
+			CHECK(stats.acmrAfter == MeshOptimizer::ComputeACMR(mesh.indices));
+			if (size >= 10)
+			{
+				CHECK(stats.acmrAfter < 0.8f && stats.atvrAfter < 1.5f);
+			}
+		}
+
+		// Weld된 Mesh에서도 섞인 순서보다 캐시 효율이 좋아짐
+		MeshData welded = MakeShuffledSoup(60, random);
+		MeshOptimizer::WeldVertices(welded);
+		const float shuffledACMR = MeshOptimizer::ComputeACMR(welded.indices);
+		const float shuffledATVR = MeshOptimizer::ComputeATVR(welded.indices, welded.vertices.size());
+		const MeshOptimizerStats stats = MeshOptimizer::Optimize(welded);
+		CHECK(stats.acmrBefore == shuffledACMR && stats.acmrAfter < shuffledACMR * 0.5f);
+		CHECK(stats.atvrBefore == shuffledATVR && stats.atvrAfter < shuffledATVR * 0.5f);
+	}
+
+	void TestStages()
+	{
+		mt19937 random(3);
+		MeshData mesh = MakeShuffledSoup(40, random);
+		MeshOptimizer::WeldVertices(mesh);
+		const vector<uint32_t> welded = mesh.indices;
+
+		// Vertex Cache와 Overdraw는 삼각형 순서만 바꿈 (Index 세 개는 그대로)
+		auto sortedTriangles = [](const vector<uint32_t>& indices) {
+			vector<array<uint32_t, 3>> triangles;
+			for (size_t t = 0; t < indices.size(); t += 3)
+			{
+				triangles.push_back({ indices[t], indices[t + 1], indices[t + 2] });
+			}
+			sort(triangles.begin(), triangles.end());
+			return triangles;
+		};
+
+		MeshOptimizer::OptimizeVertexCache(mesh.indices, mesh.vertices.size());
+		CHECK(sortedTriangles(mesh.indices) == sortedTriangles(welded));
+		const float cacheACMR = MeshOptimizer::ComputeACMR(mesh.indices);
+		CHECK(cacheACMR < MeshOptimizer::ComputeACMR(welded));
+
+		// Overdraw 순서는 ACMR을 threshold 근처까지만 양보
+		MeshOptimizer::OptimizeOverdraw(mesh.indices, mesh.vertices, 1.05f);
+		CHECK(sortedTriangles(mesh.indices) == sortedTriangles(welded));
+		CHECK(MeshOptimizer::ComputeACMR(mesh.indices) <= cacheACMR * 1.05f + 0.05f);
+
+		// Vertex Fetch는 Vertex만 재배치
+		const vector<string> triangles = GetTriangles(mesh);
+		MeshOptimizer::OptimizeVertexFetch(mesh);
+		CHECK(IsFetchOrdered(mesh) && GetTriangles(mesh) == triangles);
+
+		// 사용되지 않는 Vertex는 제거
+		MeshData unused;
+		unused.vertices = { MakeVertex(0, 0, 4), MakeVertex(1, 0, 4), MakeVertex(2, 0, 4), MakeVertex(3, 0, 4) };
+		unused.indices = { 3, 1, 3 };
+		MeshOptimizer::OptimizeVertexFetch(unused);
+		CHECK(unused.vertices.size() == 2 && unused.indices == vector<uint32_t>({ 0, 1, 0 }));
+		CHECK(unused.vertices[0].position == MakeVertex(3, 0, 4).position);
+	}
+
+	void TestDegenerate()
+	{
+		// 빈 Mesh
+		MeshData empty;
+		MeshOptimizerStats stats = MeshOptimizer::Optimize(empty);
+		CHECK(empty.vertices.empty() && empty.indices.empty());
+		CHECK(stats.acmrBefore == 0.0f && stats.acmrAfter == 0.0f && stats.atvrAfter == 0.0f);
+
+		// Vertex만 있고 삼각형이 없음, 삼각형이 안 되는 Index 2개 (그대로 둠)
+		MeshData noTriangles;
+		noTriangles.vertices = { MakeVertex(0, 0, 1), MakeVertex(1, 0, 1) };
+		noTriangles.indices = { 1, 0 };
+		stats = MeshOptimizer::Optimize(noTriangles);
+		CHECK(noTriangles.vertices.size() == 2 && noTriangles.indices == vector<uint32_t>({ 1, 0 }));
+		CHECK(stats.acmrAfter == 0.0f);
+
+		// 삼각형 하나: 중복 Vertex는 합쳐지고 순서와 감는 방향은 유지
+		MeshData one;
+		one.vertices = { MakeVertex(0, 0, 1), MakeVertex(5, 5, 1), MakeVertex(0, 1, 1), MakeVertex(1, 0, 1),
+						 MakeVertex(0, 0, 1) };
+		one.indices = { 4, 2, 3 };
+		stats = MeshOptimizer::Optimize(one);
+		CHECK(one.vertices.size() == 3 && one.indices == vector<uint32_t>({ 0, 1, 2 }));
+		CHECK(one.vertices[1].position == MakeVertex(0, 1, 1).position);
+		CHECK(stats.vertexCountBefore == 5 && stats.vertexCountAfter == 3);
+		CHECK(stats.acmrBefore == 3.0f && stats.acmrAfter == 3.0f && stats.atvrAfter == 1.0f);
+
+		// 넓이가 0인 삼각형(같은 Index 반복)도 지우지 않고 유지
+		MeshData degenerate;
+		degenerate.vertices = { MakeVertex(0, 0, 1), MakeVertex(1, 0, 1), MakeVertex(0, 1, 1) };
+		degenerate.indices = { 0, 1, 2, 1, 1, 1, 2, 2, 0 };
+		const vector<string> triangles = GetTriangles(degenerate);
+		MeshOptimizer::Optimize(degenerate);
+		CHECK(degenerate.indices.size() == 9 && GetTriangles(degenerate) == triangles);
+	}
+
+	void Benchmark()
+	{
+		mt19937 random(4);
+		for (const int size : { 100, 300, 600 })
+		{
+			const MeshData soup = MakeShuffledSoup(size, random);
+
+			MeshData mesh = soup;
+			const double weldMs = MeasureMs([&]() {
+				mesh = soup;
+				MeshOptimizer::WeldVertices(mesh);
+			}, 3);
+			const MeshData welded = mesh;
+			const double cacheMs = MeasureMs([&]() {
+				mesh.indices = welded.indices;
+				MeshOptimizer::OptimizeVertexCache(mesh.indices, mesh.vertices.size());
+			}, 3);
+			const vector<uint32_t> cacheOrder = mesh.indices;
+			const double overdrawMs = MeasureMs([&]() {
+				mesh.indices = cacheOrder;
+				MeshOptimizer::OptimizeOverdraw(mesh.indices, mesh.vertices);
+			}, 3);
+			const double fetchMs = MeasureMs([&]() {
+				MeshData copy = mesh;
+				MeshOptimizer::OptimizeVertexFetch(copy);
+			}, 3);
+
+			MeshData optimized = soup;
+			const MeshOptimizerStats stats = MeshOptimizer::Optimize(optimized);
+
+			cout << size * size * 2 << " triangles: Weld " << weldMs << " ms, VertexCache " << cacheMs
+				 << " ms, Overdraw " << overdrawMs << " ms, VertexFetch " << fetchMs << " ms" << endl;
+			cout << "    vertices " << stats.vertexCountBefore << " -> " << stats.vertexCountAfter << ", ACMR "
+				 << MeshOptimizer::ComputeACMR(welded.indices) << " (welded, shuffled) -> "
+				 << MeshOptimizer::ComputeACMR(cacheOrder) << " (VertexCache) -> " << stats.acmrAfter << ", ATVR "
+				 << MeshOptimizer::ComputeATVR(welded.indices, welded.vertices.size()) << " -> " << stats.atvrAfter
+				 << endl;
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	TestWeld();
+	TestOptimize();
+	TestStages();
+	TestDegenerate();
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark();
+	}
+
+	return ReportChecks("TestMeshOptimizer");
+}
@@ -0,0 +1,370 @@
+// MeshSimplifier: 목표 삼각형 수까지 줄이는지, 보고한 오차가 실제 원본 Vertex와 단순화된 표면 사이 거리 이상인지,
+// 삼각형이 뒤집히지 않고 열린 경계가 유지되는지, LOD Chain의 감소 비율과 오차 증가
+// LodSelector: 화면 오차 기준 선택과 경계 거리에서 Hysteresis로 LOD가 떨리지 않는지
+// Benchmark는 큰 Mesh의 LOD Chain 생성 시간과 LOD별 삼각형 비율/오차
+// 사용법: TestMeshSimplifier [--bench]
+
+#include "MeshSimplifier.h"
+#include "TestCommon.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	// 적도 방향으로 울퉁불퉁한 구, UV Seam(첫 열과 마지막 열)과 극점의 Vertex는 복제됨
+	// 극점의 넓이 0인 삼각형은 만들지 않음
+	MeshData MakeSphere(const int columns, const int rows, const float bump)
+	{
+		MeshData mesh;
+		for (int i = 0; i <= rows; i++)
+		{
+			for (int j = 0; j <= columns; j++)
+			{
+				const float theta = XM_PI * float(i) / float(rows);
+				const float phi = XM_2PI * float(j) / float(columns);
+				const float r = 1.0f + bump * sin(5.0f * phi);
+
+				Vertex v = {};
+				v.position = Vector3(sin(theta) * cos(phi) * r, cos(theta), sin(theta) * sin(phi) * r);
+				v.normalModel = Vector3(sin(theta) * cos(phi), cos(theta), sin(theta) * sin(phi));
+				v.texcoord = Vector2(float(j) / float(columns), float(i) / float(rows));
+				mesh.vertices.push_back(v);
+			}
+		}
+
+		for (int i = 0; i < rows; i++)
+		{
+			for (int j = 0; j < columns; j++)
+			{
+				const uint32_t a = i * (columns + 1) + j;
+				const uint32_t b = a + 1;
+				const uint32_t c = a + columns + 1;
+				const uint32_t d = c + 1;
+				if (i > 0)
+				{
+					mesh.indices.insert(mesh.indices.end(), { a, b, c });
+				}
+				if (i < rows - 1)
+				{
+					mesh.indices.insert(mesh.indices.end(), { b, d, c });
+				}
+			}
+		}
+		return mesh;
+	}
+
+	// 열린 경계가 있는 Height Field (height가 0이면 평면)
+	MeshData MakeGrid(const int size, const float height, mt19937& random)
+	{
+		MeshData mesh;
+		uniform_real_distribution<float> offset(-height, height);
+		for (int y = 0; y <= size; y++)
+		{
+			for (int x = 0; x <= size; x++)
+			{
+				Vertex v = {};
+				v.position = Vector3(float(x), offset(random), float(y)) / float(size);
+				v.normalModel = Vector3(0.0f, 1.0f, 0.0f);
+				mesh.vertices.push_back(v);
+			}
+		}
+		for (int y = 0; y < size; y++)
+		{
+			for (int x = 0; x < size; x++)
+			{
+				const uint32_t a = y * (size + 1) + x;
+				const uint32_t c = a + size + 1;
+				mesh.indices.insert(mesh.indices.end(), { a, c, a + 1, a + 1, c, c + 1 });
+			}
+		}
+		return mesh;
+	}
+
+	float DistanceToSegment(const Vector3& p, const Vector3& a, const Vector3& b)
+	{
+		const Vector3 ab = b - a;
+		const float t = clamp((p - a).Dot(ab) / max(ab.Dot(ab), 1e-20f), 0.0f, 1.0f);
+		return (a + ab * t - p).Length();
+	}
+
+	float DistanceToTriangle(const Vector3& p, const Vector3& a, const Vector3& b, const Vector3& c)
+	{
+		Vector3 n = (b - a).Cross(c - a);
+		const float edgeDistance = min({ DistanceToSegment(p, a, b), DistanceToSegment(p, b, c), DistanceToSegment(p, c, a) });
+		if (n.LengthSquared() < 1e-24f)
+		{
+			return edgeDistance;
+		}
+		n.Normalize();
+
+		// 평면에 투영한 점이 삼각형 안이면 평면까지 거리
+		const float planeDistance = (p - a).Dot(n);
+		const Vector3 q = p - n * planeDistance;
+		const bool s0 = (b - a).Cross(q - a).Dot(n) >= 0.0f;
+		const bool s1 = (c - b).Cross(q - b).Dot(n) >= 0.0f;
+		const bool s2 = (a - c).Cross(q - c).Dot(n) >= 0.0f;
+		return (s0 == s1 && s1 == s2) ? abs(planeDistance) : edgeDistance;
+	}
+
+	// 원본의 모든 Vertex에서 단순화된 표면까지 거리의 최댓값 (Brute Force)
+	float MeasureError(const MeshData& mesh, const vector<uint32_t>& indices)
+	{
+		float maxDistance = 0.0f;
+		for (const Vertex& v : mesh.vertices)
+		{
+			float best = FLT_MAX;
+			for (size_t i = 0; i < indices.size(); i += 3)
+			{
+				best = min(best, DistanceToTriangle(v.position, mesh.vertices[indices[i]].position,
+													mesh.vertices[indices[i + 1]].position,
+													mesh.vertices[indices[i + 2]].position));
+			}
+			maxDistance = max(maxDistance, best);
+		}
+		return maxDistance;
+	}
+
+	bool IsValid(const MeshData& mesh, const vector<uint32_t>& indices)
+	{
+		bool valid = indices.size() % 3 == 0;
+		for (size_t i = 0; valid && i < indices.size(); i += 3)
+		{
+			const uint32_t a = indices[i], b = indices[i + 1], c = indices[i + 2];
+			valid = max({ a, b, c }) < mesh.vertices.size() && a != b && b != c && c != a;
+		}
+		return valid;
+	}
+
+	// 위치 기준으로 삼각형 하나만 쓰는 Edge 길이의 합
+	float GetBorderLength(const MeshData& mesh, const vector<uint32_t>& indices)
+	{
+		map<pair<uint32_t, uint32_t>, int> edges;
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			for (int k = 0; k < 3; k++)
+			{
+				const uint32_t a = indices[i + k], b = indices[i + (k + 1) % 3];
+				edges[{ min(a, b), max(a, b) }]++;
+			}
+		}
+
+		float length = 0.0f;
+		for (const auto& edge : edges)
+		{
+			if (edge.second == 1)
+			{
+				length += (mesh.vertices[edge.first.first].position - mesh.vertices[edge.first.second].position).Length();
+			}
+		}
+		return length;
+	}
+
+	void TestSimplify()
+	{
+		// 닫힌 구: 목표까지 줄고, 뒤집힌 삼각형이 없고, 실제 오차가 보고한 오차 안
+		const MeshData sphere = MakeSphere(48, 32, 0.1f);
+		const size_t triangleCount = sphere.indices.size() / 3;
+		for (const size_t target : { triangleCount * 3 / 4, triangleCount / 2, triangleCount / 4 })
+		{
+			float error = -1.0f;
+			const vector<uint32_t> result = MeshSimplifier::Simplify(sphere.vertices, sphere.indices, target * 3, error);
+			CHECK(result.size() <= target * 3 && result.size() > target * 3 * 3 / 4);
+			CHECK(IsValid(sphere, result));
+			CHECK(error > 0.0f);
+			CHECK(MeasureError(sphere, result) <= error + 1e-5f);
+
+			bool outward = true;
+			for (size_t i = 0; i < result.size(); i += 3)
+			{
+				const Vector3& p0 = sphere.vertices[result[i]].position;
+				const Vector3& p1 = sphere.vertices[result[i + 1]].position;
+				const Vector3& p2 = sphere.vertices[result[i + 2]].position;
+				outward &= (p1 - p0).Cross(p2 - p0).Dot(p0 + p1 + p2) > 0.0f;
+			}
+			CHECK(outward);
+		}
+
+		// 평면은 오차 0으로 크게 줄고, 열린 경계는 그대로
+		mt19937 random(1);
+		const MeshData flat = MakeGrid(24, 0.0f, random);
+		float flatError = -1.0f;
+		const vector<uint32_t> flatResult = MeshSimplifier::Simplify(flat.vertices, flat.indices, 0, flatError);
+		CHECK(IsValid(flat, flatResult));
+		CHECK(flatResult.size() < flat.indices.size() / 4);
+		CHECK(flatError < 1e-6f && MeasureError(flat, flatResult) < 1e-5f);
+		CHECK(abs(GetBorderLength(flat, flatResult) - 4.0f) < 1e-4f);
+
+		const MeshData terrain = MakeGrid(24, 0.02f, random);
+		float terrainError = -1.0f;
+		const vector<uint32_t> terrainResult =
+			MeshSimplifier::Simplify(terrain.vertices, terrain.indices, terrain.indices.size() / 3, terrainError);
+		CHECK(IsValid(terrain, terrainResult) && terrainResult.size() <= terrain.indices.size() / 3);
+		CHECK(abs(GetBorderLength(terrain, terrainResult) - GetBorderLength(terrain, terrain.indices)) < 1e-4f);
+		CHECK(MeasureError(terrain, terrainResult) <= terrainError + 1e-5f);
+
+		// 이미 목표 이하면 그대로 (3의 배수가 아닌 끝은 버림)
+		float error = -1.0f;
+		vector<uint32_t> indices = sphere.indices;
+		indices.push_back(0);
+		CHECK(MeshSimplifier::Simplify(sphere.vertices, indices, indices.size(), error) == sphere.indices && error == 0.0f);
+		CHECK(MeshSimplifier::Simplify(sphere.vertices, {}, 0, error).empty() && error == 0.0f);
+
+		// 모든 Vertex가 Seam(같은 위치에 다른 UV)이면 움직일 수 없음
+		MeshData seams = sphere;
+		for (size_t i = 0; i < sphere.vertices.size(); i++)
+		{
+			Vertex copy = sphere.vertices[i];
+			copy.texcoord.x += 0.5f;
+			seams.vertices.push_back(copy);
+		}
+		CHECK(MeshSimplifier::Simplify(seams.vertices, seams.indices, 0, error) == seams.indices && error == 0.0f);
+	}
+
+	void TestLodChain()
+	{
+		const MeshData sphere = MakeSphere(64, 48, 0.1f);
+		const vector<MeshLod> lods = MeshSimplifier::BuildLodChain(sphere, 8, 0.5f);
+
+		// 처음 몇 단계는 매번 절반 (UV Seam과 극점은 움직일 수 없으므로 마지막 단계는 덜 줄어들 수 있지만 90% 이하)
+		// 오차는 이전 LOD에 누적되어 증가
+		size_t previousCount = sphere.indices.size() / 3;
+		float previousError = 0.0f;
+		bool halved = true, reduced = true, increasing = true, valid = true, bounded = true;
+		for (size_t i = 0; i < lods.size(); i++)
+		{
+			const size_t count = lods[i].indices.size() / 3;
+			if (i < 4)
+			{
+				halved &= count <= previousCount / 2 && count > previousCount / 4;
+			}
+			reduced &= count <= previousCount * 9 / 10 && count >= 32;
+			increasing &= lods[i].error > previousError;
+			valid &= IsValid(sphere, lods[i].indices);
+			bounded &= MeasureError(sphere, lods[i].indices) <= lods[i].error + 1e-5f;
+			previousCount = count;
+			previousError = lods[i].error;
+		}
+		CHECK(lods.size() >= 4 && lods.size() <= 7);
+		CHECK(halved && reduced && increasing && valid && bounded);
+
+		CHECK(MeshSimplifier::BuildLodChain(sphere, 3, 0.5f).size() == 2);
+		CHECK(MeshSimplifier::BuildLodChain(sphere, 1, 0.5f).empty());
+
+		// 작은 Mesh는 LOD를 만들지 않음
+		const MeshData small = MakeSphere(8, 4, 0.1f);
+		CHECK(small.indices.size() / 3 < 64 && MeshSimplifier::BuildLodChain(small).empty());
+
+		// 거의 줄지 않으면(90% 초과) 중단: 모든 Vertex가 Seam
+		MeshData seams = sphere;
+		for (Vertex v : sphere.vertices)
+		{
+			v.texcoord.y += 0.5f;
+			seams.vertices.push_back(v);
+		}
+		CHECK(MeshSimplifier::BuildLodChain(seams).empty());
+	}
+
+	void TestLodSelector()
+	{
+		// 화면 높이 1080, 수직 FOV 90도, 거리 10: 1 / (2 * 10 * tan(45)) * 1080
+		CHECK(abs(LodSelector::GetPixelsPerUnit(10.0f, XM_PIDIV2, 1080.0f) - 54.0f) < 1e-3f);
+		const float nearPixels = LodSelector::GetPixelsPerUnit(0.0f, XM_PIDIV2, 1080.0f);
+		CHECK(isfinite(nearPixels) && nearPixels > 1e6f);
+
+		const vector<float> errors = { 0.0f, 0.01f, 0.02f, 0.04f };
+		CHECK(LodSelector::Select(errors, 1000.0f, 0) == 0);
+		CHECK(LodSelector::Select(errors, 1.0f, 0) == 3);
+		CHECK(LodSelector::Select({ 0.0f }, 1.0f, 0) == 0);
+
+		// Hysteresis 0: 오차가 정확히 1픽셀 이하인 가장 거친 LOD
+		CHECK(LodSelector::Select(errors, 50.0f, 0, 1.0f, 0.0f) == 2);
+		CHECK(LodSelector::Select(errors, 49.0f, 0, 1.0f, 0.0f) == 2);
+		CHECK(LodSelector::Select(errors, 51.0f, 0, 1.0f, 0.0f) == 1);
+
+		// 거친 LOD로는 0.75픽셀, 현재 LOD는 1.25픽셀까지 유지
+		CHECK(LodSelector::Select(errors, 80.0f, 0) == 0);  // LOD 1 = 0.8픽셀
+		CHECK(LodSelector::Select(errors, 75.0f, 0) == 1);  // LOD 1 = 0.75픽셀
+		CHECK(LodSelector::Select(errors, 120.0f, 1) == 1); // LOD 1 = 1.2픽셀
+		CHECK(LodSelector::Select(errors, 130.0f, 1) == 0); // LOD 1 = 1.3픽셀
+
+		// 경계 거리 근처를 ±10% 오가면 한 번만 바뀜, Hysteresis가 없으면 매번 바뀜
+		for (const float hysteresis : { 0.25f, 0.0f })
+		{
+			size_t lod = 0, switches = 0;
+			for (int frame = 0; frame < 100; frame++)
+			{
+				const float distance = 10.0f * (1.0f + ((frame % 2) ? 0.1f : -0.1f)) * (54.0f / 100.0f);
+				const size_t next = LodSelector::Select(errors, LodSelector::GetPixelsPerUnit(distance, XM_PIDIV2, 1080.0f),
+														lod, 1.0f, hysteresis);
+				switches += next != lod;
+				lod = next;
+			}
+			CHECK(hysteresis > 0.0f ? switches <= 1 : switches >= 99);
+		}
+
+		// 멀어질수록 거친 LOD (단조 증가), 다시 가까워지면 LOD 0으로
+		size_t lod = 0;
+		bool monotonic = true;
+		for (float distance = 0.5f; distance < 100.0f; distance *= 1.1f)
+		{
+			const size_t next = LodSelector::Select(errors, LodSelector::GetPixelsPerUnit(distance, XM_PIDIV2, 1080.0f), lod);
+			monotonic &= next >= lod;
+			lod = next;
+		}
+		CHECK(monotonic && lod == 3);
+		for (float distance = 100.0f; distance > 0.5f; distance /= 1.1f)
+		{
+			const size_t next = LodSelector::Select(errors, LodSelector::GetPixelsPerUnit(distance, XM_PIDIV2, 1080.0f), lod);
+			monotonic &= next <= lod;
+			lod = next;
+		}
+		CHECK(monotonic && lod == 0);
+	}
+
+	void Benchmark()
+	{
+		for (const int columns : { 96, 384, 768 })
+		{
+			const MeshData mesh = MakeSphere(columns, columns * 2 / 3, 0.1f);
+			const size_t triangleCount = mesh.indices.size() / 3;
+
+			vector<MeshLod> lods;
+			const double ms = MeasureMs([&]() { lods = MeshSimplifier::BuildLodChain(mesh); }, 3);
+			cout << triangleCount << " triangles: LOD chain " << ms << " ms";
+			for (size_t i = 0; i < lods.size(); i++)
+			{
+				cout << ", LOD " << i + 1 << " " << 100.0 * lods[i].indices.size() / mesh.indices.size() << "% error "
+					 << lods[i].error;
+
+				// Brute Force 거리 측정은 작은 Mesh만
+				if (triangleCount < 20000)
+				{
+					cout << " (measured " << MeasureError(mesh, lods[i].indices) << ")";
+				}
+			}
+			cout << endl;
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	TestSimplify();
+	TestLodChain();
+	TestLodSelector();
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark();
+	}
+
+	return ReportChecks("TestMeshSimplifier");
+}
@@ -0,0 +1,375 @@
+// MeshletBuilder: Vertex/삼각형 수 제한, Index 순서대로 빈틈없이 나누는지, 경계 구와 법선 원뿔
+// Culling은 제외한 Meshlet이 정말 안 보이는지(모든 Vertex가 Plane 밖이거나 모든 삼각형이 뒷면) 하나씩 확인
+// Benchmark는 시점별로 Frustum만 / Frustum + 원뿔로 제외한 삼각형 비율과 Cull 시간
+// 사용법: TestMeshlet [--bench]
+
+#include "MeshOptimizer.h"
+#include "Meshlet.h"
+#include "TestCommon.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	// 반지름 1 근처의 울퉁불퉁한 닫힌 구 (segments * segments * 4개 삼각형), Import처럼 Optimize까지
+	MeshData MakeSphere(const int segments, const float noise, mt19937& random)
+	{
+		MeshData mesh;
+		uniform_real_distribution<float> offset(-noise, noise);
+		const int columns = segments * 2 + 1;
+		for (int i = 0; i <= segments; i++)
+		{
+			for (int j = 0; j < columns; j++)
+			{
+				const float theta = XM_PI * float(i) / float(segments);
+				const float phi = XM_PI * float(j) / float(segments);
+				const Vector3 normal(sin(theta) * cos(phi), cos(theta), sin(theta) * sin(phi));
+
+				Vertex v = {};
+				v.position = normal * (1.0f + offset(random));
+				v.normalModel = normal;
+				v.texcoord = Vector2(float(j) / float(columns - 1), float(i) / float(segments));
+				mesh.vertices.push_back(v);
+			}
+		}
+
+		// 바깥에서 봤을 때 (p1 - p0) x (p2 - p0)가 바깥을 향하도록
+		for (int i = 0; i < segments; i++)
+		{
+			for (int j = 0; j < segments * 2; j++)
+			{
+				const uint32_t a = i * columns + j;
+				const uint32_t c = a + columns;
+				mesh.indices.insert(mesh.indices.end(), { a, a + 1, c, a + 1, c + 1, c });
+			}
+		}
+
+		MeshOptimizer::Optimize(mesh);
+		return mesh;
+	}
+
+	Vector3 GetNormal(const MeshData& mesh, const size_t firstIndex)
+	{
+		const Vector3& p0 = mesh.vertices[mesh.indices[firstIndex]].position;
+		const Vector3& p1 = mesh.vertices[mesh.indices[firstIndex + 1]].position;
+		const Vector3& p2 = mesh.vertices[mesh.indices[firstIndex + 2]].position;
+		return (p1 - p0).Cross(p2 - p0);
+	}
+
+	vector<Meshlet> Build(const MeshData& mesh, const uint32_t maxVertices = MeshletBuilder::MAX_VERTICES,
+						  const uint32_t maxTriangles = MeshletBuilder::MAX_TRIANGLES)
+	{
+		return MeshletBuilder::Build(mesh.vertices.data(), mesh.vertices.size(), mesh.indices.data(),
+									 mesh.indices.size(), maxVertices, maxTriangles);
+	}
+
+	// Meshlet 하나에 들어있는 서로 다른 Vertex
+	vector<uint32_t> GetVertices(const MeshData& mesh, const Meshlet& meshlet)
+	{
+		vector<uint32_t> vertices(mesh.indices.begin() + meshlet.indexOffset,
+								  mesh.indices.begin() + meshlet.indexOffset + meshlet.indexCount);
+		sort(vertices.begin(), vertices.end());
+		vertices.erase(unique(vertices.begin(), vertices.end()), vertices.end());
+		return vertices;
+	}
+
+	void CheckMeshlets(const MeshData& mesh, const vector<Meshlet>& meshlets, const uint32_t maxVertices,
+					   const uint32_t maxTriangles)
+	{
+		uint32_t nextOffset = 0;
+		bool contiguous = true, withinLimits = true, counted = true, bounded = true, coneHolds = true, full = true;
+		for (size_t m = 0; m < meshlets.size(); m++)
+		{
+			const Meshlet& meshlet = meshlets[m];
+			contiguous &= meshlet.indexOffset == nextOffset && meshlet.indexCount % 3 == 0 && meshlet.indexCount > 0;
+			nextOffset = meshlet.indexOffset + meshlet.indexCount;
+
+			const vector<uint32_t> vertices = GetVertices(mesh, meshlet);
+			withinLimits &= vertices.size() <= maxVertices && meshlet.indexCount / 3 <= maxTriangles;
+			counted &= meshlet.vertexCount == vertices.size();
+
+			for (const uint32_t v : vertices)
+			{
+				bounded &= (mesh.vertices[v].position - meshlet.center).Length() <= meshlet.radius * 1.0001f + 1e-6f;
+			}
+
+			// 모든 삼각형 법선과 축 사이 각도가 원뿔 반각 이하 (cos >= sqrt(1 - cutoff^2))
+			if (meshlet.coneCutoff < 1.0f)
+			{
+				const float minDot = sqrt(1.0f - meshlet.coneCutoff * meshlet.coneCutoff);
+				for (uint32_t i = meshlet.indexOffset; i < meshlet.indexOffset + meshlet.indexCount; i += 3)
+				{
+					Vector3 normal = GetNormal(mesh, i);
+					if (normal.LengthSquared() > 1e-20f)
+					{
+						normal.Normalize();
+						coneHolds &= normal.Dot(meshlet.coneAxis) >= minDot - 1e-4f;
+					}
+				}
+			}
+
+			// 앞에서부터 채우므로 마지막이 아니면 다음 삼각형이 들어갈 자리가 없었음
+			if (m + 1 < meshlets.size())
+			{
+				vector<uint32_t> withNext = vertices;
+				withNext.insert(withNext.end(), mesh.indices.begin() + nextOffset, mesh.indices.begin() + nextOffset + 3);
+				sort(withNext.begin(), withNext.end());
+				withNext.erase(unique(withNext.begin(), withNext.end()), withNext.end());
+				full &= withNext.size() > maxVertices || meshlet.indexCount / 3 == maxTriangles;
+			}
+		}
+		CHECK(contiguous && nextOffset == mesh.indices.size());
+		CHECK(withinLimits);
+		CHECK(counted);
+		CHECK(bounded);
+		CHECK(coneHolds);
+		CHECK(full);
+	}
+
+	void TestBuild()
+	{
+		mt19937 random(1);
+		for (const int segments : { 1, 4, 30, 90 })
+		{
+			const MeshData mesh = MakeSphere(segments, 0.05f, random);
+			const vector<Meshlet> meshlets = Build(mesh);
+			CheckMeshlets(mesh, meshlets, MeshletBuilder::MAX_VERTICES, MeshletBuilder::MAX_TRIANGLES);
+
+			// 작은 제한: 삼각형 하나씩, Vertex 3개씩
+			CheckMeshlets(mesh, Build(mesh, 64, 1), 64, 1);
+			CheckMeshlets(mesh, Build(mesh, 3, 124), 3, 124);
+			CheckMeshlets(mesh, Build(mesh, 8, 4), 8, 4);
+		}
+
+		// 평면은 원뿔 반각 0, 반구보다 넓게 펼쳐진 Meshlet은 원뿔을 쓰지 않음
+		MeshData flat;
+		for (int i = 0; i < 25; i++)
+		{
+			Vertex v = {};
+			v.position = Vector3(float(i % 5), float(i / 5), 0.0f);
+			flat.vertices.push_back(v);
+		}
+		for (uint32_t y = 0; y < 4; y++)
+		{
+			for (uint32_t x = 0; x < 4; x++)
+			{
+				const uint32_t a = y * 5 + x;
+				flat.indices.insert(flat.indices.end(), { a, a + 5, a + 1, a + 1, a + 5, a + 6 });
+			}
+		}
+		vector<Meshlet> flatMeshlets = Build(flat);
+		CHECK(flatMeshlets.size() == 1 && flatMeshlets[0].vertexCount == 25);
+		CHECK(flatMeshlets[0].coneCutoff < 1e-3f && abs(flatMeshlets[0].coneAxis.z) > 0.999f);
+
+		mt19937 sphereRandom(2);
+		const MeshData sphere = MakeSphere(4, 0.0f, sphereRandom);
+		const vector<Meshlet> whole = Build(sphere, 1000, 1000);
+		CHECK(whole.size() == 1 && whole[0].coneCutoff == 1.0f);
+
+		// 빈 Mesh, 같은 Index가 반복된 삼각형(서로 다른 Vertex로 셈)
+		CHECK(Build(MeshData()).empty());
+		MeshData degenerate = flat;
+		degenerate.indices = { 0, 0, 1, 2, 2, 2, 0, 1, 5 };
+		const vector<Meshlet> degenerateMeshlets = Build(degenerate, 3, 124);
+		CHECK(degenerateMeshlets.size() == 2 && degenerateMeshlets[0].vertexCount == 3 &&
+			  degenerateMeshlets[0].indexCount == 6 && degenerateMeshlets[0].coneCutoff == 1.0f);
+		CHECK(degenerateMeshlets[1].vertexCount == 3 && degenerateMeshlets[1].indexOffset == 6);
+	}
+
+	MeshletCullView MakeView(const Matrix& world, const Vector3& eye, const Vector3& at, const float fovY)
+	{
+		const Matrix view = Matrix(XMMatrixLookAtLH(eye, at, Vector3(0.0f, 1.0f, 0.0f)));
+		const Matrix proj = Matrix(XMMatrixPerspectiveFovLH(XMConvertToRadians(fovY), 16.0f / 9.0f, 0.1f, 100.0f));
+		return MeshletCullView::Create(world, view, proj, eye);
+	}
+
+	// 제외된 Meshlet은 어떤 Plane 밖에 모든 Vertex가 있거나, 시점에서 모든 삼각형이 뒷면
+	bool IsReallyHidden(const MeshData& mesh, const Meshlet& meshlet, const MeshletCullView& view)
+	{
+		const vector<uint32_t> vertices = GetVertices(mesh, meshlet);
+		for (const Vector4& plane : view.planes)
+		{
+			bool allOutside = true;
+			for (const uint32_t v : vertices)
+			{
+				const Vector3& p = mesh.vertices[v].position;
+				allOutside &= plane.x * p.x + plane.y * p.y + plane.z * p.z + plane.w < 0.0f;
+			}
+			if (allOutside)
+			{
+				return true;
+			}
+		}
+
+		if (!view.useConeCulling)
+		{
+			return false;
+		}
+		for (uint32_t i = meshlet.indexOffset; i < meshlet.indexOffset + meshlet.indexCount; i += 3)
+		{
+			if (GetNormal(mesh, i).Dot(mesh.vertices[mesh.indices[i]].position - view.eyeModel) < 0.0f)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void TestCull()
+	{
+		mt19937 random(3);
+		const MeshData mesh = MakeSphere(60, 0.03f, random);
+		const vector<Meshlet> meshlets = Build(mesh);
+
+		uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		size_t culledByCone = 0;
+		for (int i = 0; i < 200; i++)
+		{
+			// Model을 옮기고 키운 상태에서 여러 거리/방향으로 봄 (일부는 Mesh를 벗어난 곳을 봄)
+			const Matrix world = Matrix::CreateScale(2.0f) * Matrix::CreateTranslation(Vector3(unit(random), unit(random), 5.0f));
+			Vector3 direction(unit(random), unit(random), unit(random));
+			direction.Normalize();
+			const Vector3 center = Vector3::Transform(Vector3(0.0f), world);
+			const Vector3 eye = center + direction * (2.5f + 6.0f * abs(unit(random)));
+			const Vector3 at = center + Vector3(unit(random), unit(random), unit(random)) * 2.0f;
+			const MeshletCullView view = MakeView(world, eye, at, 30.0f + 40.0f * abs(unit(random)));
+			CHECK(view.useConeCulling);
+			CHECK(abs(Vector3(view.planes[0].x, view.planes[0].y, view.planes[0].z).Length() - 1.0f) < 1e-4f);
+
+			vector<MeshletDrawRange> ranges;
+			const size_t visibleTriangles = MeshletBuilder::Cull(meshlets, view, ranges);
+
+			size_t expectedTriangles = 0;
+			bool hiddenOk = true;
+			vector<MeshletDrawRange> expectedRanges;
+			for (const Meshlet& meshlet : meshlets)
+			{
+				if (MeshletBuilder::IsVisible(meshlet, view))
+				{
+					expectedTriangles += meshlet.indexCount / 3;
+					if (!expectedRanges.empty() &&
+						expectedRanges.back().indexOffset + expectedRanges.back().indexCount == meshlet.indexOffset)
+					{
+						expectedRanges.back().indexCount += meshlet.indexCount;
+					}
+					else
+					{
+						expectedRanges.push_back({ meshlet.indexOffset, meshlet.indexCount });
+					}
+				}
+				else
+				{
+					hiddenOk &= IsReallyHidden(mesh, meshlet, view);
+
+					MeshletCullView frustumOnly = view;
+					frustumOnly.useConeCulling = false;
+					culledByCone += MeshletBuilder::IsVisible(meshlet, frustumOnly);
+				}
+			}
+			CHECK(hiddenOk);
+			CHECK(visibleTriangles == expectedTriangles);
+
+			// 이어진 Meshlet은 하나의 범위로 합침
+			bool sameRanges = ranges.size() == expectedRanges.size();
+			for (size_t r = 0; sameRanges && r < ranges.size(); r++)
+			{
+				sameRanges = ranges[r].indexOffset == expectedRanges[r].indexOffset &&
+							 ranges[r].indexCount == expectedRanges[r].indexCount;
+				if (r > 0)
+				{
+					sameRanges &= ranges[r - 1].indexOffset + ranges[r - 1].indexCount < ranges[r].indexOffset;
+				}
+			}
+			CHECK(sameRanges);
+		}
+		CHECK(culledByCone > 0);
+
+		// 직교 투영(_44 = 1)에서는 원뿔을 쓰지 않음
+		const MeshletCullView ortho = MeshletCullView::Create(Matrix(), Matrix(), Matrix(), Vector3(0.0f, 0.0f, -5.0f));
+		CHECK(!ortho.useConeCulling);
+
+		// 모두 보이면 범위 하나
+		vector<MeshletDrawRange> ranges;
+		const MeshletCullView far = MakeView(Matrix(), Vector3(0.0f, 0.0f, -50.0f), Vector3(0.0f), 60.0f);
+		MeshletCullView farNoCone = far;
+		farNoCone.useConeCulling = false;
+		CHECK(MeshletBuilder::Cull(meshlets, farNoCone, ranges) == mesh.indices.size() / 3);
+		CHECK(ranges.size() == 1 && ranges[0].indexOffset == 0 && ranges[0].indexCount == mesh.indices.size());
+	}
+
+	void Benchmark()
+	{
+		struct Shot {
+			const char* name;
+			Vector3 eye;
+			Vector3 at;
+			float fovY;
+		};
+		const Shot shots[] = {
+			{ "whole model", Vector3(0.0f, 0.5f, -4.0f), Vector3(0.0f), 45.0f },
+			{ "close-up", Vector3(0.3f, 0.2f, -1.6f), Vector3(0.3f, 0.2f, 0.0f), 45.0f },
+			{ "grazing", Vector3(-1.4f, 0.0f, -1.4f), Vector3(2.0f, 0.0f, 0.0f), 60.0f },
+			{ "inside", Vector3(0.0f), Vector3(0.0f, 0.0f, 1.0f), 70.0f },
+		};
+
+		// 매끈한 표면은 원뿔이 좁고, 삼각형 크기만큼 울퉁불퉁하면 원뿔이 넓어져서 거의 쓰지 못함
+		for (const float noise : { 0.0f, 0.002f, 0.02f })
+		{
+			mt19937 random(4);
+			const MeshData mesh = MakeSphere(200, noise, random);
+			const size_t triangleCount = mesh.indices.size() / 3;
+
+			vector<Meshlet> meshlets;
+			const double buildMs = MeasureMs([&]() { meshlets = Build(mesh); }, 3);
+			size_t coneCount = 0;
+			for (const Meshlet& meshlet : meshlets)
+			{
+				coneCount += meshlet.coneCutoff < 1.0f;
+			}
+			cout << "noise " << noise << ": " << triangleCount << " triangles -> " << meshlets.size() << " meshlets ("
+				 << coneCount << " with a cone), Build " << buildMs << " ms" << endl;
+
+			vector<MeshletDrawRange> ranges;
+			for (const Shot& shot : shots)
+			{
+				const MeshletCullView view = MakeView(Matrix(), shot.eye, shot.at, shot.fovY);
+				MeshletCullView frustumOnly = view;
+				frustumOnly.useConeCulling = false;
+
+				const size_t frustumVisible = MeshletBuilder::Cull(meshlets, frustumOnly, ranges);
+				size_t visible = 0;
+				const double cullMs = MeasureMs([&]() { visible = MeshletBuilder::Cull(meshlets, view, ranges); });
+
+				// 실제 뒷면 비율 (Meshlet 단위 Culling이 얻을 수 있는 상한)
+				size_t backFacing = 0;
+				for (size_t i = 0; i < mesh.indices.size(); i += 3)
+				{
+					backFacing += GetNormal(mesh, i).Dot(mesh.vertices[mesh.indices[i]].position - shot.eye) >= 0.0f;
+				}
+
+				cout << "  " << shot.name << ": culled " << 100.0 * (triangleCount - frustumVisible) / triangleCount
+					 << "% (frustum) -> " << 100.0 * (triangleCount - visible) / triangleCount
+					 << "% (frustum + cone), back-facing " << 100.0 * backFacing / triangleCount << "%, "
+					 << ranges.size() << " draw ranges, Cull " << cullMs << " ms" << endl;
+			}
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	TestBuild();
+	TestCull();
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark();
+	}
+
+	return ReportChecks("TestMeshlet");
+}
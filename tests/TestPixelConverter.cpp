@@ -0,0 +1,266 @@
+// PixelConverter의 SIMD 구현 (SSE4.1, AVX2/F16C)이 Scalar와 같은 결과인지
+// 이 CPU가 지원하는 수준만 검사 (SetSimdLevel은 지원하는 수준까지만 올라감)
+// 사용법: TestPixelConverter [--bench]
+
+#include "PixelConverter.h"
+#include "TestCommon.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+using SimdLevel = PixelConverter::SimdLevel;
+
+namespace {
+	const char* levelNames[] = { "Scalar", "SSE4.1", "AVX2" };
+
+	// SIMD 구현의 나머지(Tail) 처리까지 확인하도록 Vector 폭의 배수가 아닌 크기들
+	const size_t testCounts[] = { 0, 1, 5, 7, 13, 33, 1001 };
+
+	bool SameFloats(const vector<float>& a, const vector<float>& b)
+	{
+		for (size_t i = 0; i < a.size(); i++)
+		{
+			if (!(a[i] == b[i] || (isnan(a[i]) && isnan(b[i]))))
+			{
+				return false;
+			}
+		}
+		return a.size() == b.size();
+	}
+
+	void TestScalar()
+	{
+		PixelConverter::SetSimdLevel(SimdLevel::Scalar);
+		CHECK(PixelConverter::GetSimdLevel() == SimdLevel::Scalar);
+
+		// Gray: (g, g, g, g), RG: (r, g, 255, 255), RGB: (r, g, b, 255)
+		const uint8_t src[] = { 10, 20, 30, 40 };
+		uint8_t dst[4];
+		PixelConverter::ExpandToRGBA8(src, 1, 1, dst);
+		CHECK(dst[0] == 10 && dst[1] == 10 && dst[2] == 10 && dst[3] == 10);
+		PixelConverter::ExpandToRGBA8(src, 2, 1, dst);
+		CHECK(dst[0] == 10 && dst[1] == 20 && dst[2] == 255 && dst[3] == 255);
+		PixelConverter::ExpandToRGBA8(src, 3, 1, dst);
+		CHECK(dst[0] == 10 && dst[1] == 20 && dst[2] == 30 && dst[3] == 255);
+
+		const int order[4] = { 2, 1, 0, -1 };
+		PixelConverter::SwizzleRGBA8(src, order, 1, dst);
+		CHECK(dst[0] == 30 && dst[1] == 20 && dst[2] == 10 && dst[3] == 0);
+
+		PixelConverter::PackChannelRGBA8(src, 3, 1, dst, 0);
+		CHECK(dst[0] == 40 && dst[1] == 20 && dst[2] == 10 && dst[3] == 0);
+
+		const float floats[] = { 0.0f, 1.0f, -2.0f, 65504.0f };
+		uint16_t halfs[4];
+		PixelConverter::FloatToHalf(floats, 4, halfs);
+		CHECK(halfs[0] == 0x0000 && halfs[1] == 0x3c00 && halfs[2] == 0xc000 && halfs[3] == 0x7bff);
+
+		float back[4];
+		PixelConverter::HalfToFloat(halfs, 4, back);
+		CHECK(memcmp(back, floats, sizeof(floats)) == 0);
+
+		const uint8_t srgb[] = { 0, 255 };
+		float linear[2];
+		PixelConverter::SRGBToLinear(srgb, 2, linear);
+		CHECK(linear[0] == 0.0f && linear[1] == 1.0f);
+
+		uint8_t roundTrip[2];
+		PixelConverter::LinearToSRGB(linear, 2, roundTrip);
+		CHECK(roundTrip[0] == 0 && roundTrip[1] == 255);
+	}
+
+	void TestLevel(const SimdLevel level)
+	{
+		mt19937 random(1);
+		vector<uint8_t> bytes(1001 * 4 + 64);
+		for (uint8_t& b : bytes)
+		{
+			b = uint8_t(random());
+		}
+
+		// fp16은 Inf/NaN이 아닌 값과 NaN 하나, float는 [0, 1] 밖과 NaN 포함
+		vector<uint16_t> halfs(1001 * 4);
+		for (uint16_t& h : halfs)
+		{
+			h = uint16_t(random() & 0x7bff) | (random() % 8 == 0 ? 0x8000 : 0);
+		}
+		halfs[3] = 0x7e00;
+
+		vector<float> floats(1001);
+		uniform_real_distribution<float> floatRange(-0.1f, 1.1f);
+		for (float& f : floats)
+		{
+			f = floatRange(random);
+		}
+
+		for (const size_t n : testCounts)
+		{
+			vector<uint8_t> expected(n * 4);
+			vector<uint8_t> result(n * 4);
+
+			for (int channels = 1; channels <= 4; channels++)
+			{
+				PixelConverter::SetSimdLevel(SimdLevel::Scalar);
+				PixelConverter::ExpandToRGBA8(bytes.data(), channels, n, expected.data());
+				PixelConverter::SetSimdLevel(level);
+				PixelConverter::ExpandToRGBA8(bytes.data(), channels, n, result.data());
+				CHECK(result == expected);
+			}
+
+			const int order[4] = { 2, 1, 0, -1 };
+			PixelConverter::SetSimdLevel(SimdLevel::Scalar);
+			PixelConverter::SwizzleRGBA8(bytes.data(), order, n, expected.data());
+			PixelConverter::SetSimdLevel(level);
+			PixelConverter::SwizzleRGBA8(bytes.data(), order, n, result.data());
+			CHECK(result == expected);
+
+			// dst의 다른 채널은 그대로 남아야 함
+			const vector<uint8_t> initial(bytes.begin() + 7, bytes.begin() + 7 + n * 4);
+			expected = initial;
+			result = initial;
+			PixelConverter::SetSimdLevel(SimdLevel::Scalar);
+			PixelConverter::PackChannelRGBA8(bytes.data(), 0, n, expected.data(), 2);
+			PixelConverter::SetSimdLevel(level);
+			PixelConverter::PackChannelRGBA8(bytes.data(), 0, n, result.data(), 2);
+			CHECK(result == expected);
+
+			vector<float> expectedFloats(n);
+			vector<float> resultFloats(n);
+			PixelConverter::SetSimdLevel(SimdLevel::Scalar);
+			PixelConverter::HalfToFloat(halfs.data(), n, expectedFloats.data());
+			PixelConverter::SetSimdLevel(level);
+			PixelConverter::HalfToFloat(halfs.data(), n, resultFloats.data());
+			CHECK(SameFloats(resultFloats, expectedFloats));
+
+			PixelConverter::SetSimdLevel(SimdLevel::Scalar);
+			PixelConverter::SRGBToLinear(bytes.data(), n, expectedFloats.data());
+			PixelConverter::SetSimdLevel(level);
+			PixelConverter::SRGBToLinear(bytes.data(), n, resultFloats.data());
+			CHECK(SameFloats(resultFloats, expectedFloats));
+
+			vector<uint16_t> expectedHalfs(n);
+			vector<uint16_t> resultHalfs(n);
+			PixelConverter::SetSimdLevel(SimdLevel::Scalar);
+			PixelConverter::FloatToHalf(floats.data(), n, expectedHalfs.data());
+			PixelConverter::SetSimdLevel(level);
+			PixelConverter::FloatToHalf(floats.data(), n, resultHalfs.data());
+			CHECK(resultHalfs == expectedHalfs);
+
+			// Linear -> sRGB는 SIMD 근사라 최대 1 차이
+			vector<uint8_t> expectedSRGB(n);
+			vector<uint8_t> resultSRGB(n);
+			PixelConverter::SetSimdLevel(SimdLevel::Scalar);
+			PixelConverter::LinearToSRGB(floats.data(), n, expectedSRGB.data());
+			PixelConverter::SetSimdLevel(level);
+			PixelConverter::LinearToSRGB(floats.data(), n, resultSRGB.data());
+			int maxError = 0;
+			for (size_t i = 0; i < n; i++)
+			{
+				maxError = max(maxError, abs(int(resultSRGB[i]) - int(expectedSRGB[i])));
+			}
+			CHECK(maxError <= 1);
+
+			uint32_t expectedBins[16] = {};
+			uint32_t resultBins[16] = {};
+			float expectedMin = 1e30f, expectedMax = 0.0f;
+			float resultMin = 1e30f, resultMax = 0.0f;
+			PixelConverter::SetSimdLevel(SimdLevel::Scalar);
+			PixelConverter::LuminanceHistogramHalf(halfs.data(), n, -8.0f, 4.0f, expectedBins, 16, expectedMin,
+												   expectedMax);
+			PixelConverter::SetSimdLevel(level);
+			PixelConverter::LuminanceHistogramHalf(halfs.data(), n, -8.0f, 4.0f, resultBins, 16, resultMin,
+												   resultMax);
+			CHECK(memcmp(resultBins, expectedBins, sizeof(expectedBins)) == 0);
+			CHECK(resultMin == expectedMin && resultMax == expectedMax);
+		}
+	}
+
+	// 출력 기준 GB/s (Histogram은 입력 기준)
+	void Benchmark(const SimdLevel level)
+	{
+		const size_t n = 3840 * 2160; // 4K
+
+		mt19937 random(2);
+		vector<uint8_t> bytes(n * 4);
+		for (uint8_t& b : bytes)
+		{
+			b = uint8_t(random());
+		}
+		vector<uint16_t> halfs(n * 4);
+		for (uint16_t& h : halfs)
+		{
+			h = uint16_t(random() & 0x7bff);
+		}
+		vector<float> floats(n);
+		for (size_t i = 0; i < n; i++)
+		{
+			floats[i] = float(i % 1000) / 999.0f;
+		}
+
+		vector<uint8_t> dstBytes(n * 4);
+		vector<float> dstFloats(n);
+		vector<uint16_t> dstHalfs(n);
+		uint32_t bins[64] = {};
+		float minLuminance = 1e30f, maxLuminance = 0.0f;
+
+		auto gbps = [](const size_t bytes, const double ms) { return double(bytes) / (ms * 1e6); };
+		const int order[4] = { 2, 1, 0, 3 };
+
+		PixelConverter::SetSimdLevel(level);
+		cout << levelNames[int(level)] << " (GB/s):";
+		cout << " RGB->RGBA "
+			 << gbps(n * 4, MeasureMs([&]() { PixelConverter::ExpandToRGBA8(bytes.data(), 3, n, dstBytes.data()); }));
+		cout << ", Swizzle "
+			 << gbps(n * 4, MeasureMs([&]() { PixelConverter::SwizzleRGBA8(bytes.data(), order, n, dstBytes.data()); }));
+		cout << ", Pack "
+			 << gbps(n * 4, MeasureMs([&]() { PixelConverter::PackChannelRGBA8(bytes.data(), 0, n, dstBytes.data(), 1); }));
+		cout << ", Half->Float "
+			 << gbps(n * 4, MeasureMs([&]() { PixelConverter::HalfToFloat(halfs.data(), n, dstFloats.data()); }));
+		cout << ", Float->Half "
+			 << gbps(n * 2, MeasureMs([&]() { PixelConverter::FloatToHalf(floats.data(), n, dstHalfs.data()); }));
+		cout << ", sRGB->Linear "
+			 << gbps(n * 4, MeasureMs([&]() { PixelConverter::SRGBToLinear(bytes.data(), n, dstFloats.data()); }));
+		cout << ", Linear->sRGB "
+			 << gbps(n, MeasureMs([&]() { PixelConverter::LinearToSRGB(floats.data(), n, dstBytes.data()); }));
+		cout << ", Histogram "
+			 << gbps(n * 8, MeasureMs([&]() {
+					PixelConverter::LuminanceHistogramHalf(halfs.data(), n, -10.0f, 6.0f, bins, 64, minLuminance,
+														   maxLuminance);
+				}))
+			 << endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	TestScalar();
+
+	vector<SimdLevel> levels = { SimdLevel::Scalar };
+	for (const SimdLevel level : { SimdLevel::SSE41, SimdLevel::AVX2 })
+	{
+		PixelConverter::SetSimdLevel(level);
+		if (PixelConverter::GetSimdLevel() == level)
+		{
+			levels.push_back(level);
+			TestLevel(level);
+		}
+		else
+		{
+			cout << levelNames[int(level)] << " is not supported, skipped" << endl;
+		}
+	}
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		for (const SimdLevel level : levels)
+		{
+			Benchmark(level);
+		}
+	}
+
+	return ReportChecks("TestPixelConverter");
+}
@@ -0,0 +1,260 @@
+// RenderQueue::Sort()(Radix Sort)가 SortComparison()(std::stable_sort)과 같은 순서인지
+// 일부 자리만 다른 Key들로 건너뛰는 자리 수(0개, 홀수, 짝수)를 바꿔가며 검사하고 Pass별 범위도 확인
+// 사용법: TestRenderQueue [--bench]
+
+#include "RenderQueue.h"
+#include "TestCommon.h"
+
+#include <random>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	using Packet = RenderQueue::Packet;
+
+	bool SamePackets(const vector<Packet>& a, const vector<Packet>& b)
+	{
+		if (a.size() != b.size())
+		{
+			return false;
+		}
+		for (size_t i = 0; i < a.size(); i++)
+		{
+			if (a[i].key != b[i].key || a[i].item != b[i].item)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void Fill(RenderQueue& queue, const vector<uint64_t>& keys)
+	{
+		queue.Clear();
+		for (size_t i = 0; i < keys.size(); i++)
+		{
+			queue.Add(keys[i], uint32_t(i));
+		}
+	}
+
+	// GetPassPackets()가 Pass마다 연속된 범위를 빠짐없이 가리키는지
+	void CheckPassOffsets(const RenderQueue& queue)
+	{
+		const vector<Packet>& packets = queue.GetPackets();
+		size_t total = 0;
+		for (uint32_t pass = 0; pass < RenderQueue::MAX_PASSES; pass++)
+		{
+			size_t count = 0;
+			const Packet* first = queue.GetPassPackets(pass, count);
+
+			size_t expected = 0;
+			for (const Packet& packet : packets)
+			{
+				expected += (packet.key >> 56) == pass;
+			}
+			CHECK(count == expected);
+			if (count > 0)
+			{
+				CHECK(first == packets.data() + total);
+				for (size_t i = 0; i < count; i++)
+				{
+					CHECK((first[i].key >> 56) == pass);
+				}
+			}
+			total += count;
+		}
+		CHECK(total == packets.size());
+
+		size_t count = 1;
+		CHECK(queue.GetPassPackets(RenderQueue::MAX_PASSES, count) == nullptr && count == 0);
+	}
+
+	// digitMask의 bit가 켜진 자리(8-bit 단위)만 다르고 나머지 자리는 모든 Key가 같음
+	// valueCount를 작게 하면 같은 Key가 많아져서 넣은 순서가 유지되는지도 검사
+	vector<uint64_t> MakeKeys(const size_t count, const uint32_t digitMask, const uint32_t valueCount,
+							  mt19937& random)
+	{
+		const uint64_t base = (uint64_t(random()) << 32) | random();
+		vector<uint64_t> keys(count, base);
+		for (uint64_t& key : keys)
+		{
+			for (int digit = 0; digit < 8; digit++)
+			{
+				if (digitMask & (1u << digit))
+				{
+					const int shift = digit * 8;
+					key = (key & ~(0xFFull << shift)) | (uint64_t(random() % valueCount) << shift);
+				}
+			}
+		}
+		return keys;
+	}
+
+	void TestDigits()
+	{
+		// 정렬하는 자리 수가 0개, 1개(홀수: m_scratch에 끝남), 2개(짝수), 사이를 건너뜀, 8개 모두
+		const uint32_t digitMasks[] = { 0x00, 0x01, 0x80, 0x81, 0x2A, 0x7E, 0x0F, 0xFF };
+		const size_t counts[] = { 2, 3, 255, 256, 257, 5000 };
+		mt19937 random(1);
+
+		for (const uint32_t digitMask : digitMasks)
+		{
+			for (const size_t count : counts)
+			{
+				for (const uint32_t valueCount : { 2u, 256u })
+				{
+					const vector<uint64_t> keys = MakeKeys(count, digitMask, valueCount, random);
+
+					RenderQueue radix;
+					Fill(radix, keys);
+					radix.Sort();
+
+					RenderQueue comparison;
+					Fill(comparison, keys);
+					comparison.SortComparison();
+
+					CHECK(SamePackets(radix.GetPackets(), comparison.GetPackets()));
+					CheckPassOffsets(radix);
+				}
+			}
+		}
+
+		// 한 자리만 다르고 첫 Key의 값이 그 자리에 하나뿐 (건너뛰면 안 되는 경우)
+		vector<uint64_t> keys(100, 0x0500000000000000ull);
+		keys[0] = 0x0400000000000000ull;
+		keys[50] = 0x0300000000000000ull;
+		RenderQueue queue;
+		Fill(queue, keys);
+		queue.Sort();
+		CHECK(queue.GetPackets()[0].item == 50 && queue.GetPackets()[1].item == 0 && queue.GetPackets()[2].item == 1);
+		CheckPassOffsets(queue);
+	}
+
+	void TestPassOffsets()
+	{
+		RenderQueue queue;
+		size_t count = 1;
+
+		// Sort() 전, 빈 Queue, Packet 하나
+		queue.GetPassPackets(0, count);
+		CHECK(count == 0);
+		queue.Sort();
+		CheckPassOffsets(queue);
+
+		queue.Add(RenderQueue::MakeKey(255, 1, 2, 3.0f), 7);
+		queue.Sort();
+		CheckPassOffsets(queue);
+		CHECK(queue.GetPassPackets(255, count)->item == 7 && count == 1);
+
+		queue.Clear();
+		queue.GetPassPackets(255, count);
+		CHECK(count == 0);
+
+		// 처음, 중간, 마지막 Pass만 있고 나머지는 비어 있음
+		mt19937 random(2);
+		const uint32_t passes[] = { 0, 3, 4, 200, 255 };
+		for (uint32_t i = 0; i < 3000; i++)
+		{
+			queue.Add(RenderQueue::MakeKey(passes[random() % 5], random() % 8, random() % 64, float(random() % 100)), i);
+		}
+		queue.Sort();
+		CheckPassOffsets(queue);
+		queue.SortComparison();
+		CheckPassOffsets(queue);
+
+		// 이전 Frame보다 적은 개수 (m_scratch가 더 큼)
+		queue.Clear();
+		for (uint32_t i = 0; i < 10; i++)
+		{
+			queue.Add(RenderQueue::MakeKey(i % 2, 0, 9 - i, 1.0f), i);
+		}
+		queue.Sort();
+		CHECK(queue.GetSize() == 10);
+		CheckPassOffsets(queue);
+		CHECK(queue.GetPassPackets(0, count)->item == 8 && count == 5);
+	}
+
+	void TestMakeKey()
+	{
+		// Pass > Material > Geometry > Depth 순서
+		CHECK(RenderQueue::MakeKey(1, 0, 0, 0.0f) > RenderQueue::MakeKey(0, 0xFFFF, 0xFFFF, 1e30f));
+		CHECK(RenderQueue::MakeKey(0, 1, 0, 0.0f) > RenderQueue::MakeKey(0, 0, 0xFFFF, 1e30f));
+		CHECK(RenderQueue::MakeKey(0, 0, 1, 0.0f) > RenderQueue::MakeKey(0, 0, 0, 1e30f));
+
+		// 가까운 것부터 / 먼 것부터, 카메라 뒤는 0과 같음
+		CHECK(RenderQueue::MakeKey(0, 0, 0, 1.0f) < RenderQueue::MakeKey(0, 0, 0, 2.0f));
+		CHECK(RenderQueue::MakeKey(0, 0, 0, 1.0f, false) > RenderQueue::MakeKey(0, 0, 0, 2.0f, false));
+		CHECK(RenderQueue::MakeKey(0, 0, 0, -5.0f) == RenderQueue::MakeKey(0, 0, 0, 0.0f));
+
+		// 범위를 넘는 값은 다른 자리를 덮지 않음
+		CHECK(RenderQueue::MakeKey(0x1FF, 0x1FFFF, 0, 0.0f) == RenderQueue::MakeKey(0xFF, 0xFFFF, 0, 0.0f));
+
+		int a = 0, b = 0;
+		CHECK(RenderQueue::MakeId({ &a, &b }) == RenderQueue::MakeId({ &a, &b }));
+		CHECK(RenderQueue::MakeId({ &a }) <= 0xFFFF);
+	}
+
+	// ExampleApp과 비슷한 구성: Pass 6개, Material 200개, Geometry 1000개
+	vector<uint64_t> MakeSceneKeys(const size_t count, mt19937& random)
+	{
+		vector<uint32_t> materialIds(200), geometryIds(1000);
+		for (size_t i = 0; i < materialIds.size(); i++)
+		{
+			materialIds[i] = RenderQueue::MakeId({ &materialIds[i] });
+		}
+		for (size_t i = 0; i < geometryIds.size(); i++)
+		{
+			geometryIds[i] = RenderQueue::MakeId({ &geometryIds[i] });
+		}
+
+		uniform_real_distribution<float> depth(0.1f, 100.0f);
+		vector<uint64_t> keys(count);
+		for (uint64_t& key : keys)
+		{
+			const uint32_t geometry = random() % 1000;
+			key = RenderQueue::MakeKey(random() % 6, materialIds[geometry % 200], geometryIds[geometry], depth(random));
+		}
+		return keys;
+	}
+
+	void Benchmark()
+	{
+		mt19937 random(3);
+		for (const size_t count : { size_t(1000), size_t(10000), size_t(100000), size_t(1000000) })
+		{
+			const vector<uint64_t> keys = MakeSceneKeys(count, random);
+			RenderQueue queue;
+
+			// Add()도 포함 (정렬할 때마다 다시 채워야 하므로)
+			const double fillMs = MeasureMs([&]() { Fill(queue, keys); });
+			const double radixMs = MeasureMs([&]() {
+				Fill(queue, keys);
+				queue.Sort();
+			});
+			const vector<Packet> sorted = queue.GetPackets();
+			const double comparisonMs = MeasureMs([&]() {
+				Fill(queue, keys);
+				queue.SortComparison();
+			});
+			CHECK(SamePackets(sorted, queue.GetPackets()));
+
+			cout << count << " packets: Add " << fillMs << " ms, Add + Sort " << radixMs << " ms, Add + SortComparison "
+				 << comparisonMs << " ms" << endl;
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	TestMakeKey();
+	TestDigits();
+	TestPassOffsets();
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark();
+	}
+
+	return ReportChecks("TestRenderQueue");
+}
@@ -0,0 +1,312 @@
+// ResourceCache(hit/miss 집계, 사용하는 곳이 모두 사라지면 해제, 동시에 요청해도 create()는 한 번, 예외)와
+// ImageLoader::MakeKey/MakeORMKey의 경로 정규화 (같은 파일을 다른 표기로 읽어도 Decoding은 한 번)
+// Benchmark는 Hit 하나의 비용 (Thread 1개/여러 개)과 Decoding 비교
+// 사용법: TestResourceCache [--bench]
+
+#include "ImageLoader.h"
+#include "ResourceCache.h"
+#include "TestCommon.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	void WritePPM(const string& fileName, const int width, const int height, const uint8_t seed)
+	{
+		ofstream file(fileName, ios::binary);
+		file << "P6\n" << width << " " << height << "\n255\n";
+
+		vector<uint8_t> pixels(size_t(width) * height * 3);
+		for (size_t i = 0; i < pixels.size(); i++)
+		{
+			pixels[i] = uint8_t(i * 7 + seed);
+		}
+		file.write((const char*)pixels.data(), pixels.size());
+	}
+
+	// 소멸자가 불린 횟수를 세는 자원
+	struct Counted {
+		explicit Counted(atomic<int>& destroyed, int value = 0) : destroyed(destroyed), value(value) {}
+		~Counted() { destroyed++; }
+
+		atomic<int>& destroyed;
+		int value;
+	};
+
+	void TestKeys(const string& dir)
+	{
+		filesystem::create_directories(dir + "sub");
+		WritePPM(dir + "a.ppm", 4, 4, 1);
+
+		// 같은 파일의 다른 표기는 같은 key (상대 경로, ".", "..", 중복된 "/")
+		const string key = ImageLoader::MakeKey(dir + "a.ppm", true);
+		const string relative = filesystem::relative(dir + "a.ppm").generic_string();
+		CHECK(ImageLoader::MakeKey(dir + "./a.ppm", true) == key);
+		CHECK(ImageLoader::MakeKey(dir + "sub/../a.ppm", true) == key);
+		CHECK(ImageLoader::MakeKey(dir + "sub//..//a.ppm", true) == key);
+		CHECK(ImageLoader::MakeKey(relative, true) == key);
+
+		// 없는 파일도 표기만 정규화
+		CHECK(ImageLoader::MakeKey(dir + "sub/../missing.png", false) == ImageLoader::MakeKey(dir + "missing.png", false));
+
+		// 다른 파일, sRGB 여부, Format(.exr은 Float)이 다르면 다른 key
+		CHECK(ImageLoader::MakeKey(dir + "b.ppm", true) != key);
+		CHECK(ImageLoader::MakeKey(dir + "a.ppm", false) != key);
+		CHECK(ImageLoader::MakeKey(dir + "a.exr", false) != ImageLoader::MakeKey(dir + "a.png", false));
+		CHECK(ImageLoader::MakeKey(dir + "a.EXR", false).find("rgba16f") != string::npos);
+		CHECK(ImageLoader::MakeKey(dir + "a.png", false).find("rgba16f") == string::npos);
+
+#ifdef _WIN32
+		// Windows는 대소문자를 구분하지 않음
+		CHECK(ImageLoader::MakeKey(dir + "A.PPM", true) == key);
+#endif
+
+		// ORM은 세 파일의 순서와 빈 자리까지 구분
+		const string orm = ImageLoader::MakeORMKey(dir + "ao.png", dir + "r.png", "");
+		CHECK(ImageLoader::MakeORMKey(dir + "sub/../ao.png", dir + "./r.png", "") == orm);
+		CHECK(ImageLoader::MakeORMKey(dir + "r.png", dir + "ao.png", "") != orm);
+		CHECK(ImageLoader::MakeORMKey(dir + "ao.png", "", dir + "r.png") != orm);
+		CHECK(ImageLoader::MakeORMKey(dir + "ao.png", dir + "r.png", "") != ImageLoader::MakeKey(dir + "ao.png", false));
+	}
+
+	void TestCounts()
+	{
+		ResourceCache<const Counted> cache;
+		atomic<int> destroyed{ 0 };
+		int created = 0;
+		auto create = [&]() {
+			created++;
+			return make_shared<const Counted>(destroyed, created);
+		};
+
+		// 처음은 miss, 살아있는 동안은 hit (create 없이 같은 자원)
+		shared_ptr<const Counted> a = cache.GetOrCreate("a", create);
+		shared_ptr<const Counted> a2 = cache.GetOrCreate("a", create);
+		shared_ptr<const Counted> b = cache.GetOrCreate("b", create);
+		CHECK(a == a2 && a != b);
+		CHECK(created == 2);
+		CHECK(cache.GetMissCount() == 2 && cache.GetHitCount() == 1);
+
+		// Find, Contains는 집계하지 않고 만들지도 않음
+		CHECK(cache.Find("a") == a);
+		CHECK(cache.Contains("b"));
+		CHECK(!cache.Contains("c") && cache.Find("c") == nullptr);
+		CHECK(cache.GetMissCount() == 2 && cache.GetHitCount() == 1);
+		CHECK(created == 2);
+
+		// Cache는 weak_ptr만 가지므로 사용하는 곳이 모두 사라지면 바로 해제
+		a.reset();
+		CHECK(destroyed == 0 && cache.Contains("a"));
+		a2.reset();
+		CHECK(destroyed == 1);
+		CHECK(!cache.Contains("a") && cache.Find("a") == nullptr);
+
+		// 해제된 key는 다시 만듦 (miss)
+		shared_ptr<const Counted> again = cache.GetOrCreate("a", create);
+		CHECK(created == 3 && again->value == 3);
+		CHECK(cache.GetMissCount() == 3 && cache.GetHitCount() == 1);
+
+		// PruneExpired는 해제된 key만 지우고 살아있는 개수 반환
+		b.reset();
+		CHECK(destroyed == 2);
+		CHECK(cache.PruneExpired() == 1);
+		again.reset();
+		CHECK(cache.PruneExpired() == 0);
+		CHECK(destroyed == 3);
+
+		// create()에서 예외: 호출자에게 전달되고 key는 남지 않음 (다음 요청은 다시 만듦)
+		bool caught = false;
+		try
+		{
+			cache.GetOrCreate("bad", []() -> shared_ptr<const Counted> { throw runtime_error("create"); });
+		}
+		catch (const runtime_error&)
+		{
+			caught = true;
+		}
+		CHECK(caught);
+		CHECK(cache.PruneExpired() == 0);
+		CHECK(cache.GetOrCreate("bad", create)->value == 4);
+	}
+
+	void TestConcurrent()
+	{
+		// 여러 Thread가 같은 key를 동시에: create()는 한 번, 나머지는 기다렸다가 같은 자원 (hit)
+		for (const int threadCount : { 2, 8, 16 })
+		{
+			ResourceCache<const int> cache;
+			atomic<int> created{ 0 };
+			atomic<bool> start{ false };
+			vector<shared_ptr<const int>> results(threadCount);
+
+			vector<thread> threads;
+			for (int t = 0; t < threadCount; t++)
+			{
+				threads.emplace_back([&, t]() {
+					while (!start)
+					{
+						this_thread::yield();
+					}
+					results[t] = cache.GetOrCreate("shared", [&]() {
+						created++;
+						this_thread::sleep_for(chrono::milliseconds(20));
+						return make_shared<const int>(42);
+					});
+				});
+			}
+			start = true;
+			for (thread& t : threads)
+			{
+				t.join();
+			}
+
+			bool same = true;
+			for (const shared_ptr<const int>& result : results)
+			{
+				same &= result == results[0] && *result == 42;
+			}
+			CHECK(created == 1);
+			CHECK(same);
+			CHECK(cache.GetMissCount() == 1 && cache.GetHitCount() == size_t(threadCount - 1));
+		}
+
+		// 만드는 중에 실패하면 기다리던 Thread에도 예외, 그 뒤에는 다시 만들 수 있음
+		ResourceCache<const int> cache;
+		atomic<int> failures{ 0 };
+		atomic<bool> creating{ false };
+		thread creator([&]() {
+			try
+			{
+				cache.GetOrCreate("fail", [&]() -> shared_ptr<const int> {
+					creating = true;
+					this_thread::sleep_for(chrono::milliseconds(50));
+					throw runtime_error("decode");
+				});
+			}
+			catch (const runtime_error&)
+			{
+				failures++;
+			}
+		});
+		while (!creating)
+		{
+			this_thread::yield();
+		}
+		try
+		{
+			cache.GetOrCreate("fail", []() { return make_shared<const int>(0); });
+		}
+		catch (const runtime_error&)
+		{
+			failures++;
+		}
+		creator.join();
+		CHECK(failures == 2);
+		CHECK(*cache.GetOrCreate("fail", []() { return make_shared<const int>(5); }) == 5);
+	}
+
+	// ImageLoader의 Decoding Cache: 다른 표기도 한 번만 Decoding, 다 쓰면 해제되고 다시 읽음
+	void TestImageCache(const string& dir)
+	{
+		WritePPM(dir + "image.ppm", 8, 4, 2);
+
+		ResourceCache<const ImageData>& cache = ImageLoader::GetCache();
+		const size_t misses = cache.GetMissCount();
+		const size_t hits = cache.GetHitCount();
+
+		shared_ptr<const ImageData> first = ImageLoader::ReadImageCached(dir + "image.ppm", true);
+		shared_ptr<const ImageData> second = ImageLoader::ReadImageCached(dir + "sub/../image.ppm", true);
+		shared_ptr<const ImageData> linear = ImageLoader::ReadImageCached(dir + "image.ppm", false);
+		CHECK(first && first->width == 8 && first->height == 4);
+		CHECK(first == second);
+		CHECK(first != linear);
+		CHECK(cache.GetMissCount() - misses == 2 && cache.GetHitCount() - hits == 1);
+
+		const string key = ImageLoader::MakeKey(dir + "image.ppm", true);
+		CHECK(cache.Contains(key));
+
+		weak_ptr<const ImageData> released = first;
+		first.reset();
+		second.reset();
+		CHECK(released.expired());
+		CHECK(!cache.Contains(key));
+
+		shared_ptr<const ImageData> reread = ImageLoader::ReadImageCached(dir + "./image.ppm", true);
+		CHECK(reread && reread->pixels.size() == size_t(8) * 4 * 4);
+		CHECK(cache.GetMissCount() - misses == 3);
+	}
+
+	void Benchmark(const string& dir)
+	{
+		ResourceCache<const int> cache;
+		vector<string> keys;
+		vector<shared_ptr<const int>> alive;
+		for (int i = 0; i < 1000; i++)
+		{
+			keys.push_back(ImageLoader::MakeKey(dir + "texture" + to_string(i) + ".png", true));
+			alive.push_back(cache.GetOrCreate(keys.back(), [i]() { return make_shared<const int>(i); }));
+		}
+
+		const size_t lookups = 1000000;
+		for (const size_t threadCount : { 1, 4 })
+		{
+			const double ms = MeasureMs([&]() {
+				vector<thread> threads;
+				for (size_t t = 0; t < threadCount; t++)
+				{
+					threads.emplace_back([&, t]() {
+						for (size_t i = t; i < lookups; i += threadCount)
+						{
+							cache.GetOrCreate(keys[i % keys.size()], []() { return make_shared<const int>(0); });
+						}
+					});
+				}
+				for (thread& thread : threads)
+				{
+					thread.join();
+				}
+			}, 3);
+			cout << threadCount << " threads: " << lookups << " hits " << ms << " ms (" << ms * 1e6 / double(lookups)
+				 << " ns each)" << endl;
+		}
+
+		// Key 만들기(경로 정규화)와 Decoding
+		const double keyMs = MeasureMs([&]() {
+			for (int i = 0; i < 1000; i++)
+			{
+				ImageLoader::MakeKey(dir + "sub/../image.ppm", true);
+			}
+		});
+		WritePPM(dir + "large.ppm", 1024, 1024, 3);
+		const double decodeMs = MeasureMs([&]() { ImageLoader::ReadImageCached(dir + "large.ppm", true); }, 3);
+		cout << "MakeKey " << keyMs << " us each, 1024x1024 decode (released, so not cached) " << decodeMs
+			 << " ms" << endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const string dir = (filesystem::temp_directory_path() / "TestResourceCache").string() + "/";
+	filesystem::remove_all(dir);
+
+	TestKeys(dir);
+	TestCounts();
+	TestConcurrent();
+	TestImageCache(dir);
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark(dir);
+	}
+
+	filesystem::remove_all(dir);
+	return ReportChecks("TestResourceCache");
+}
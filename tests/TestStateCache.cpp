@@ -0,0 +1,513 @@
+// StateCache<MockDeviceContext>가 같은 상태를 다시 설정하는 호출만 버리고 여러 Slot 호출은 바뀐 구간만 보내는지
+// 직접 호출한 MockDeviceContext와 최종 상태가 같은지 (HasSameState)도 매 호출 검사
+// 사용법: TestStateCache [--bench]
+
+#include "MockDeviceContext.h"
+#include "RenderQueue.h"
+#include "StateCache.h"
+#include "TestCommon.h"
+
+#include <initializer_list>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	using Cache = StateCache<MockDeviceContext>;
+
+	// 포인터로만 비교하므로 가짜 주소 (0은 nullptr)
+	template <typename T>
+	T* Fake(const uint32_t id)
+	{
+		return id ? reinterpret_cast<T*>(uintptr_t(id) * 16) : nullptr;
+	}
+
+	struct ExpectedCall {
+		const char* name;
+		UINT startSlot;
+		UINT count;
+	};
+
+	// 마지막 검사 이후 Context로 보낸 호출이 expected와 같은지 (검사 후 기록을 지움)
+	bool SameCalls(MockDeviceContext& context, initializer_list<ExpectedCall> expected)
+	{
+		bool same = context.m_calls.size() == expected.size();
+		size_t i = 0;
+		for (const ExpectedCall& call : expected)
+		{
+			if (!same)
+			{
+				break;
+			}
+			const MockDeviceContext::Call& actual = context.m_calls[i++];
+			same = strcmp(actual.name, call.name) == 0 && actual.startSlot == call.startSlot &&
+				   actual.count == call.count;
+		}
+		context.ClearCalls();
+		return same;
+	}
+
+	bool SameStats(const Cache& cache, const size_t calls, const size_t dropped, const size_t trimmed)
+	{
+		const Cache::Stats& stats = cache.GetStats();
+		return stats.calls == calls && stats.dropped == dropped && stats.trimmed == trimmed;
+	}
+
+	void TestSingleValues()
+	{
+		MockDeviceContext context, direct;
+		Cache cache;
+		cache.SetContext(&context);
+
+		ID3D11InputLayout* layout = Fake<ID3D11InputLayout>(1);
+		cache.IASetInputLayout(layout);
+		cache.IASetInputLayout(layout);
+		cache.IASetInputLayout(nullptr); // 처음 설정하는 nullptr도 보냄
+		direct.IASetInputLayout(nullptr);
+		CHECK(SameCalls(context, { { "IASetInputLayout", 0, 1 }, { "IASetInputLayout", 0, 1 } }));
+		CHECK(SameStats(cache, 3, 1, 0));
+
+		cache.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		cache.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		direct.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		CHECK(SameCalls(context, { { "IASetPrimitiveTopology", 0, 1 } }));
+
+		// Index Buffer는 Format, Offset까지 비교
+		ID3D11Buffer* indexBuffer = Fake<ID3D11Buffer>(2);
+		cache.IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R16_UINT, 0);
+		cache.IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R16_UINT, 0);
+		cache.IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R32_UINT, 0);
+		cache.IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R32_UINT, 64);
+		direct.IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R32_UINT, 64);
+		CHECK(SameCalls(context, { { "IASetIndexBuffer", 0, 1 },
+								   { "IASetIndexBuffer", 0, 1 },
+								   { "IASetIndexBuffer", 0, 1 } }));
+
+		// Class Instance를 쓰면 항상 보내고 다음 호출도 비교하지 않음
+		ID3D11VertexShader* vs = Fake<ID3D11VertexShader>(3);
+		ID3D11ClassInstance* instance = Fake<ID3D11ClassInstance>(4);
+		cache.VSSetShader(vs, nullptr, 0);
+		cache.VSSetShader(vs, nullptr, 0);
+		cache.VSSetShader(vs, &instance, 1);
+		cache.VSSetShader(vs, &instance, 1);
+		cache.VSSetShader(vs, nullptr, 0);
+		cache.VSSetShader(vs, nullptr, 0);
+		direct.VSSetShader(vs, nullptr, 0);
+		CHECK(SameCalls(context, { { "VSSetShader", 0, 1 },
+								   { "VSSetShader", 0, 1 },
+								   { "VSSetShader", 0, 1 },
+								   { "VSSetShader", 0, 1 } }));
+
+		// Blend Factor가 nullptr이면 D3D11처럼 1로 보고 비교
+		ID3D11BlendState* blend = Fake<ID3D11BlendState>(5);
+		const FLOAT ones[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		const FLOAT half[4] = { 0.5f, 0.5f, 0.5f, 0.5f };
+		cache.OMSetBlendState(blend, nullptr, 0xffffffff);
+		cache.OMSetBlendState(blend, ones, 0xffffffff);
+		cache.OMSetBlendState(blend, half, 0xffffffff);
+		cache.OMSetBlendState(blend, half, 0x0000ffff);
+		direct.OMSetBlendState(blend, half, 0x0000ffff);
+		CHECK(SameCalls(context, { { "OMSetBlendState", 0, 1 },
+								   { "OMSetBlendState", 0, 1 },
+								   { "OMSetBlendState", 0, 1 } }));
+
+		ID3D11DepthStencilState* depthStencil = Fake<ID3D11DepthStencilState>(6);
+		cache.OMSetDepthStencilState(depthStencil, 0);
+		cache.OMSetDepthStencilState(depthStencil, 1);
+		cache.OMSetDepthStencilState(depthStencil, 1);
+		cache.RSSetState(nullptr);
+		cache.RSSetState(nullptr);
+		direct.OMSetDepthStencilState(depthStencil, 1);
+		direct.RSSetState(nullptr);
+		CHECK(SameCalls(context, { { "OMSetDepthStencilState", 0, 1 },
+								   { "OMSetDepthStencilState", 0, 1 },
+								   { "RSSetState", 0, 1 } }));
+		CHECK(SameStats(cache, 24, 8, 0));
+		CHECK(context.HasSameState(direct));
+
+		// Invalidate() 뒤에는 같은 값도 다시 보냄
+		cache.Invalidate();
+		cache.IASetInputLayout(nullptr);
+		cache.RSSetState(nullptr);
+		cache.VSSetShader(vs, nullptr, 0);
+		CHECK(SameCalls(context, { { "IASetInputLayout", 0, 1 }, { "RSSetState", 0, 1 }, { "VSSetShader", 0, 1 } }));
+
+		// InvalidateResources()는 Pipeline State를 유지
+		cache.InvalidateResources();
+		cache.IASetInputLayout(nullptr);
+		cache.IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R32_UINT, 64);
+		CHECK(SameCalls(context, { { "IASetIndexBuffer", 0, 1 } }));
+
+		// 다른 Context로 바꾸면 모두 모르는 것으로
+		MockDeviceContext other;
+		cache.SetContext(&other);
+		cache.IASetInputLayout(nullptr);
+		CHECK(SameCalls(other, { { "IASetInputLayout", 0, 1 } }));
+		CHECK(context.m_calls.empty());
+
+		cache.ResetStats();
+		CHECK(SameStats(cache, 0, 0, 0));
+	}
+
+	void TestSlots()
+	{
+		MockDeviceContext context, direct;
+		Cache cache;
+		cache.SetContext(&context);
+
+		ID3D11ShaderResourceView* views[8];
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			views[i] = Fake<ID3D11ShaderResourceView>(i + 1);
+		}
+
+		auto setViews = [&](const UINT startSlot, const UINT num) {
+			cache.PSSetShaderResources(startSlot, num, views);
+			direct.PSSetShaderResources(startSlot, num, views);
+		};
+
+		// 처음은 모두 보내고, 같으면 버림
+		setViews(0, 8);
+		setViews(0, 8);
+		CHECK(SameCalls(context, { { "PSSetShaderResources", 0, 8 } }));
+		CHECK(SameStats(cache, 2, 1, 0));
+
+		// 3번, 5번 Slot만 바뀜 -> [3, 6)
+		views[3] = Fake<ID3D11ShaderResourceView>(100);
+		views[5] = nullptr;
+		setViews(0, 8);
+		CHECK(SameCalls(context, { { "PSSetShaderResources", 3, 3 } }));
+		CHECK(SameStats(cache, 3, 1, 1));
+		CHECK(context.HasSameState(direct));
+
+		// 첫 Slot, 마지막 Slot만 바뀜 (구간 양 끝)
+		views[0] = Fake<ID3D11ShaderResourceView>(101);
+		setViews(0, 8);
+		views[7] = Fake<ID3D11ShaderResourceView>(102);
+		setViews(0, 8);
+		CHECK(SameCalls(context, { { "PSSetShaderResources", 0, 1 }, { "PSSetShaderResources", 7, 1 } }));
+		CHECK(context.HasSameState(direct));
+
+		// startSlot이 0이 아니면 views도 같은 만큼 건너뛰어서 보냄
+		// [4, 12)에 views[0..7]: 4~7은 이전 값과 다르고 8~11은 처음 -> 모두 보냄
+		setViews(4, 8);
+		CHECK(SameCalls(context, { { "PSSetShaderResources", 4, 8 } }));
+		views[6] = Fake<ID3D11ShaderResourceView>(103); // Slot 10
+		setViews(4, 8);
+		CHECK(SameCalls(context, { { "PSSetShaderResources", 10, 1 } }));
+		CHECK(context.m_ps.shaderResources[10] == views[6] && context.HasSameState(direct));
+
+		// 모르는 Slot이 섞이면 그 Slot까지 포함
+		setViews(10, 4); // 10~12는 이전 값과 다르거나 처음, 13은 처음
+		CHECK(SameCalls(context, { { "PSSetShaderResources", 10, 4 } }));
+		setViews(10, 2);
+		CHECK(SameCalls(context, {}));
+
+		// 다른 Stage, 다른 종류의 Slot은 따로 기억
+		cache.VSSetShaderResources(3, 2, views + 3);
+		direct.VSSetShaderResources(3, 2, views + 3);
+		CHECK(SameCalls(context, { { "VSSetShaderResources", 3, 2 } }));
+
+		ID3D11Buffer* constants[3] = { Fake<ID3D11Buffer>(1), Fake<ID3D11Buffer>(2), Fake<ID3D11Buffer>(3) };
+		cache.VSSetConstantBuffers(0, 3, constants);
+		cache.PSSetConstantBuffers(0, 3, constants);
+		constants[1] = Fake<ID3D11Buffer>(4);
+		cache.VSSetConstantBuffers(0, 3, constants);
+		cache.PSSetConstantBuffers(1, 1, constants + 1);
+		cache.PSSetConstantBuffers(0, 3, constants);
+		direct.VSSetConstantBuffers(0, 3, constants);
+		direct.PSSetConstantBuffers(0, 3, constants);
+		CHECK(SameCalls(context, { { "VSSetConstantBuffers", 0, 3 },
+								   { "PSSetConstantBuffers", 0, 3 },
+								   { "VSSetConstantBuffers", 1, 1 },
+								   { "PSSetConstantBuffers", 1, 1 } }));
+
+		ID3D11SamplerState* samplers[4] = { Fake<ID3D11SamplerState>(1), Fake<ID3D11SamplerState>(2),
+											Fake<ID3D11SamplerState>(3), Fake<ID3D11SamplerState>(4) };
+		cache.PSSetSamplers(0, 4, samplers);
+		samplers[2] = Fake<ID3D11SamplerState>(5);
+		cache.PSSetSamplers(0, 4, samplers);
+		cache.VSSetSamplers(0, 4, samplers);
+		direct.PSSetSamplers(0, 4, samplers);
+		direct.VSSetSamplers(0, 4, samplers);
+		CHECK(SameCalls(context, { { "PSSetSamplers", 0, 4 }, { "PSSetSamplers", 2, 1 }, { "VSSetSamplers", 0, 4 } }));
+		CHECK(context.HasSameState(direct));
+
+		// Vertex Buffer는 Stride, Offset만 바뀌어도 보내고 세 배열을 같이 건너뜀
+		ID3D11Buffer* buffers[3] = { Fake<ID3D11Buffer>(10), Fake<ID3D11Buffer>(11), Fake<ID3D11Buffer>(12) };
+		UINT strides[3] = { 12, 16, 32 };
+		UINT offsets[3] = { 0, 0, 0 };
+		cache.IASetVertexBuffers(0, 3, buffers, strides, offsets);
+		strides[1] = 20;
+		cache.IASetVertexBuffers(0, 3, buffers, strides, offsets);
+		offsets[2] = 256;
+		cache.IASetVertexBuffers(0, 3, buffers, strides, offsets);
+		cache.IASetVertexBuffers(0, 3, buffers, strides, offsets);
+		direct.IASetVertexBuffers(0, 3, buffers, strides, offsets);
+		CHECK(SameCalls(context, { { "IASetVertexBuffers", 0, 3 },
+								   { "IASetVertexBuffers", 1, 1 },
+								   { "IASetVertexBuffers", 2, 1 } }));
+		CHECK(context.m_vertexStrides[1] == 20 && context.m_vertexOffsets[2] == 256);
+		CHECK(context.HasSameState(direct));
+
+		// Render Target을 바꾸면 SRV만 다시 보냄 (Constant Buffer, Sampler는 유지)
+		cache.ResetStats();
+		cache.OMSetRenderTargets(1, nullptr, nullptr);
+		setViews(0, 8);
+		cache.PSSetConstantBuffers(0, 3, constants);
+		cache.PSSetSamplers(0, 4, samplers);
+		CHECK(SameCalls(context, { { "OMSetRenderTargets", 0, 1 }, { "PSSetShaderResources", 0, 8 } }));
+		CHECK(SameStats(cache, 3, 2, 0));
+
+		// InvalidateResources()는 Buffer와 SRV를 버리고 Sampler는 유지
+		cache.InvalidateResources();
+		cache.PSSetConstantBuffers(0, 3, constants);
+		cache.IASetVertexBuffers(1, 1, buffers + 1, strides + 1, offsets + 1);
+		cache.PSSetSamplers(0, 4, samplers);
+		CHECK(SameCalls(context, { { "PSSetConstantBuffers", 0, 3 }, { "IASetVertexBuffers", 1, 1 } }));
+		CHECK(context.HasSameState(direct));
+	}
+
+	// 임의의 호출을 StateCache와 직접 호출에 똑같이 보내서 상태가 항상 같은지
+	template <typename Context>
+	void RandomCall(Context& context, const uint32_t op, const uint32_t start, const uint32_t value, const UINT num)
+	{
+		ID3D11Buffer* buffers[8];
+		ID3D11ShaderResourceView* views[8];
+		ID3D11SamplerState* samplers[8];
+		UINT strides[8], offsets[8];
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			buffers[i] = Fake<ID3D11Buffer>((value + i) % 4);
+			views[i] = Fake<ID3D11ShaderResourceView>((value * 3 + i) % 5);
+			samplers[i] = Fake<ID3D11SamplerState>((value + i) % 3);
+			strides[i] = 16 + 4 * (value % 2);
+			offsets[i] = (value / 3) * 64;
+		}
+		const FLOAT blendFactor[4] = { 0.0f, 0.0f, 0.0f, float(value % 2) };
+
+		switch (op)
+		{
+		case 0: context.IASetInputLayout(Fake<ID3D11InputLayout>(value % 3)); break;
+		case 1:
+			context.IASetPrimitiveTopology(value % 2 ? D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST
+													 : D3D11_PRIMITIVE_TOPOLOGY_POINTLIST);
+			break;
+		case 2: context.IASetVertexBuffers(start % 4, num, buffers, strides, offsets); break;
+		case 3:
+			context.IASetIndexBuffer(Fake<ID3D11Buffer>(value % 3),
+									 value % 2 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT, 0);
+			break;
+		case 4: context.VSSetShader(Fake<ID3D11VertexShader>(value % 3), nullptr, 0); break;
+		case 5: context.PSSetShader(Fake<ID3D11PixelShader>(value % 3), nullptr, 0); break;
+		case 6: context.GSSetShader(Fake<ID3D11GeometryShader>(value % 2), nullptr, 0); break;
+		case 7: context.HSSetShader(Fake<ID3D11HullShader>(value % 2), nullptr, 0); break;
+		case 8: context.DSSetShader(Fake<ID3D11DomainShader>(value % 2), nullptr, 0); break;
+		case 9: context.VSSetConstantBuffers(start % 6, num, buffers); break;
+		case 10: context.PSSetConstantBuffers(start % 6, num, buffers); break;
+		case 11: context.GSSetConstantBuffers(start % 6, num, buffers); break;
+		case 12: context.VSSetShaderResources(start % 12, num, views); break;
+		case 13: context.PSSetShaderResources(start % 12, num, views); break;
+		case 14: context.GSSetShaderResources(start % 12, num, views); break;
+		case 15: context.PSSetSamplers(start % 8, num, samplers); break;
+		case 16: context.VSSetSamplers(start % 8, num, samplers); break;
+		case 17: context.RSSetState(Fake<ID3D11RasterizerState>(value % 3)); break;
+		case 18:
+			context.OMSetBlendState(Fake<ID3D11BlendState>(value % 2), value % 3 ? blendFactor : nullptr, 0xffffffff);
+			break;
+		case 19: context.OMSetDepthStencilState(Fake<ID3D11DepthStencilState>(value % 2), value % 2); break;
+		}
+	}
+
+	void TestRandom()
+	{
+		MockDeviceContext context, direct;
+		Cache cache;
+		cache.SetContext(&context);
+		mt19937 random(7);
+
+		size_t mismatches = 0;
+		for (int i = 0; i < 200000; i++)
+		{
+			const uint32_t op = random() % 20, start = random(), value = random() % 6;
+			const UINT num = 1 + random() % 8;
+
+			// 가끔 Context를 직접 바꾸고 Invalidate()
+			if (random() % 1000 == 0)
+			{
+				RandomCall(context, op, start, value, num);
+				RandomCall(direct, op, start, value, num);
+				cache.Invalidate();
+				continue;
+			}
+
+			RandomCall(cache, op, start, value, num);
+			RandomCall(direct, op, start, value, num);
+			mismatches += !context.HasSameState(direct);
+		}
+		CHECK(mismatches == 0);
+
+		const Cache::Stats& stats = cache.GetStats();
+		CHECK(stats.dropped > 0 && stats.trimmed > 0);
+		CHECK(context.m_calls.size() + stats.dropped == direct.m_calls.size());
+		CHECK(context.m_slotCount < direct.m_slotCount);
+	}
+
+	// ExampleApp과 비슷한 Frame: Depth Only, Shadow, 불투명 Pass에 Model 2000개 x Mesh 3개
+	// 많은 Model이 Geometry와 Texture를 공유, Pass를 시작할 때 InvalidateResources()
+	struct BenchMesh {
+		ID3D11Buffer* vertexBuffer;
+		ID3D11Buffer* positionBuffer;
+		ID3D11Buffer* indexBuffer;
+		ID3D11Buffer* meshConstants;
+		ID3D11ShaderResourceView* views[4];
+	};
+
+	struct BenchModel {
+		ID3D11Buffer* modelConstants;
+		ID3D11Buffer* materialConstants;
+		BenchMesh meshes[3];
+	};
+
+	template <typename Context>
+	void BenchDraw(Context& context, const BenchModel& model, const BenchMesh& mesh, const bool depthOnly)
+	{
+		const UINT stride = depthOnly ? 12 : 32, offset = 0;
+		context.IASetVertexBuffers(0, 1, depthOnly ? &mesh.positionBuffer : &mesh.vertexBuffer, &stride, &offset);
+		context.IASetIndexBuffer(mesh.indexBuffer, DXGI_FORMAT_R32_UINT, 0);
+		context.VSSetConstantBuffers(0, 1, &model.modelConstants);
+		context.VSSetConstantBuffers(2, 1, &mesh.meshConstants);
+		if (!depthOnly)
+		{
+			context.PSSetShaderResources(0, 4, mesh.views);
+			context.PSSetConstantBuffers(0, 1, &model.materialConstants);
+		}
+		context.DrawIndexed(36, 0, 0);
+	}
+
+	template <typename Context>
+	void BenchPipeline(Context& context, const bool depthOnly)
+	{
+		const uint32_t id = depthOnly ? 1 : 2;
+		const FLOAT blendFactor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+		context.IASetInputLayout(Fake<ID3D11InputLayout>(id));
+		context.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		context.VSSetShader(Fake<ID3D11VertexShader>(id), nullptr, 0);
+		context.HSSetShader(nullptr, nullptr, 0);
+		context.DSSetShader(nullptr, nullptr, 0);
+		context.GSSetShader(nullptr, nullptr, 0);
+		context.RSSetState(Fake<ID3D11RasterizerState>(1));
+		context.PSSetShader(Fake<ID3D11PixelShader>(id), nullptr, 0);
+		context.OMSetBlendState(nullptr, blendFactor, 0xffffffff);
+		context.OMSetDepthStencilState(nullptr, 0);
+	}
+
+	void Benchmark()
+	{
+		mt19937 random(3);
+		vector<BenchModel> models(2000);
+		for (uint32_t i = 0; i < models.size(); i++)
+		{
+			BenchModel& model = models[i];
+			model.modelConstants = Fake<ID3D11Buffer>(100000 + i);
+			model.materialConstants = Fake<ID3D11Buffer>(200000 + i);
+			const uint32_t geometry = random() % 50, material = random() % 40;
+			for (uint32_t k = 0; k < 3; k++)
+			{
+				BenchMesh& mesh = model.meshes[k];
+				mesh.vertexBuffer = Fake<ID3D11Buffer>(1 + geometry * 3 + k);
+				mesh.positionBuffer = Fake<ID3D11Buffer>(1000 + geometry * 3 + k);
+				mesh.indexBuffer = Fake<ID3D11Buffer>(2000 + geometry * 3 + k);
+				mesh.meshConstants = Fake<ID3D11Buffer>(3000 + geometry * 3 + k);
+				mesh.views[0] = Fake<ID3D11ShaderResourceView>(1 + material * 4 + k);
+				mesh.views[1] = Fake<ID3D11ShaderResourceView>(500 + material);
+				mesh.views[2] = nullptr; // Texture가 없는 Slot
+				mesh.views[3] = nullptr;
+			}
+		}
+
+		const bool depthOnlyPasses[3] = { true, true, false };
+		RenderQueue queue;
+		vector<pair<uint32_t, uint32_t>> items; // (Model, Mesh)
+		for (uint32_t pass = 0; pass < 3; pass++)
+		{
+			for (uint32_t i = 0; i < models.size(); i++)
+			{
+				for (uint32_t k = 0; k < 3; k++)
+				{
+					const BenchMesh& mesh = models[i].meshes[k];
+					const bool depthOnly = depthOnlyPasses[pass];
+					const uint32_t material = depthOnly ? 0 : RenderQueue::MakeId({ mesh.views[0], mesh.views[1] });
+					const uint32_t geometry =
+						RenderQueue::MakeId({ depthOnly ? mesh.positionBuffer : mesh.vertexBuffer });
+					queue.Add(RenderQueue::MakeKey(pass, material, geometry, float(random() % 1000)),
+							  uint32_t(items.size()));
+					items.push_back({ i, k });
+				}
+			}
+		}
+		queue.Sort();
+
+		// sorted가 아니면 넣은 순서
+		auto drawFrame = [&](auto& context, const bool sorted, auto beginPass) {
+			for (uint32_t pass = 0; pass < 3; pass++)
+			{
+				BenchPipeline(context, depthOnlyPasses[pass]);
+				beginPass();
+
+				size_t count;
+				const RenderQueue::Packet* packets = queue.GetPassPackets(pass, count);
+				for (size_t j = 0; j < count; j++)
+				{
+					const pair<uint32_t, uint32_t>& item = items[sorted ? packets[j].item : pass * models.size() * 3 + j];
+					const BenchModel& model = models[item.first];
+					BenchDraw(context, model, model.meshes[item.second], depthOnlyPasses[pass]);
+				}
+			}
+		};
+
+		for (const bool sorted : { false, true })
+		{
+			MockDeviceContext direct, context;
+			Cache cache;
+			cache.SetContext(&context);
+			drawFrame(direct, sorted, []() {});
+			drawFrame(cache, sorted, [&]() { cache.InvalidateResources(); });
+			CHECK(context.HasSameState(direct));
+
+			cout << (sorted ? "sorted" : "submission order") << ": direct " << direct.m_calls.size() << " calls ("
+				 << direct.m_slotCount << " slots), StateCache " << context.m_calls.size() << " calls ("
+				 << context.m_slotCount << " slots), dropped " << cache.GetStats().dropped << ", trimmed "
+				 << cache.GetStats().trimmed << endl;
+		}
+
+		// Mock은 호출 비용이 거의 없으므로 StateCache 자체의 CPU 비용만 보임
+		MockDeviceContext direct, context;
+		Cache cache;
+		cache.SetContext(&context);
+		const double directMs = MeasureMs([&]() {
+			direct.ClearCalls();
+			drawFrame(direct, true, []() {});
+		});
+		const double cacheMs = MeasureMs([&]() {
+			context.ClearCalls();
+			drawFrame(cache, true, [&]() { cache.InvalidateResources(); });
+		});
+		cout << "frame CPU (mock): direct " << directMs << " ms, StateCache " << cacheMs << " ms" << endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	TestSingleValues();
+	TestSlots();
+	TestRandom();
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark();
+	}
+
+	return ReportChecks("TestStateCache");
+}
@@ -0,0 +1,288 @@
+// TangentGenerator의 임시 버퍼: Model마다 한 번 할당한 구간 안에서 끝나는지, 결과는 Mesh마다 따로 할당한 것과 같은지
+// SSE2(acos 근사) 결과가 ComputeScalar와 같은지 (복제, 부호는 정확히, Tangent 방향은 각도 오차 안)
+// Benchmark는 Import한 Model 크기의 Scene에서 Mesh마다 할당하는 방식과 할당 횟수, 최대 사용량, 시간 비교, SSE2와 Scalar 시간
+// (ModelLoader가 --stats로 출력하는 scratch allocations / peak와 같은 CountingResource 값)
+// 사용법: TestTangentGenerator [--bench]
+
+#include "CountingResource.h"
+#include "TangentGenerator.h"
+#include "TestCommon.h"
+#include "ThreadPool.h"
+
+#include <cstring>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	// 반지름 1 근처의 울퉁불퉁한 구, UV Seam이 있음 (segments * segments * 4개 삼각형)
+	MeshData MakeSphere(const int segments, mt19937& random)
+	{
+		MeshData mesh;
+		uniform_real_distribution<float> offset(-0.02f, 0.02f);
+		const int columns = segments * 2 + 1;
+		for (int i = 0; i <= segments; i++)
+		{
+			for (int j = 0; j < columns; j++)
+			{
+				const float theta = XM_PI * float(i) / float(segments);
+				const float phi = XM_PI * float(j) / float(segments);
+				const Vector3 normal(sin(theta) * cos(phi), cos(theta), sin(theta) * sin(phi));
+
+				Vertex v = {};
+				v.position = normal * (1.0f + offset(random));
+				v.normalModel = normal;
+				v.texcoord = Vector2(float(j) / float(columns - 1), float(i) / float(segments));
+				mesh.vertices.push_back(v);
+			}
+		}
+
+		for (int i = 0; i < segments; i++)
+		{
+			for (int j = 0; j < segments * 2; j++)
+			{
+				const uint32_t a = i * columns + j;
+				const uint32_t c = a + columns;
+				mesh.indices.insert(mesh.indices.end(), { a, c, a + 1, a + 1, c, c + 1 });
+			}
+		}
+		return mesh;
+	}
+
+	// 모든 삼각형을 반대로 감은 삼각형도 추가 => UV 방향이 반대라서 모든 Vertex가 복제됨 (임시 버퍼 최대)
+	MeshData MakeMirrored(MeshData mesh)
+	{
+		const size_t indexCount = mesh.indices.size();
+		for (size_t i = 0; i < indexCount; i += 3)
+		{
+			mesh.indices.insert(mesh.indices.end(),
+								{ mesh.indices[i], mesh.indices[i + 2], mesh.indices[i + 1] });
+		}
+		return mesh;
+	}
+
+	bool SameMeshes(const vector<MeshData>& a, const vector<MeshData>& b)
+	{
+		if (a.size() != b.size())
+		{
+			return false;
+		}
+		for (size_t i = 0; i < a.size(); i++)
+		{
+			if (a[i].vertices.size() != b[i].vertices.size() || a[i].indices != b[i].indices ||
+				(!a[i].vertices.empty() &&
+				 memcmp(a[i].vertices.data(), b[i].vertices.data(), sizeof(Vertex) * a[i].vertices.size()) != 0))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// 이전 방식: Mesh마다 각자 임시 버퍼를 할당
+	void ComputePerMesh(vector<MeshData>& meshes, pmr::memory_resource* scratch)
+	{
+		ThreadPool::GetInstance().ParallelFor(0, meshes.size(), [&](size_t i) {
+			TangentGenerator::Compute(meshes[i].vertices, meshes[i].indices, scratch);
+		});
+	}
+
+	void TestScratch()
+	{
+		mt19937 random(1);
+
+		// 빈 Mesh, 삼각형이 없는 Mesh, 작은 Mesh, 블록으로 나뉘는 큰 Mesh, 모든 Vertex가 복제되는 Mesh
+		vector<MeshData> meshes(2);
+		meshes[1].vertices.resize(5);
+		meshes[1].indices = { 0, 1 };
+		meshes.push_back(MakeSphere(1, random));
+		meshes.push_back(MakeSphere(8, random));
+		meshes.push_back(MakeSphere(80, random));
+		meshes.push_back(MakeMirrored(MakeSphere(6, random)));
+		meshes.push_back(MakeMirrored(MakeSphere(70, random)));
+
+		vector<MeshData> perMesh = meshes;
+		CountingResource perMeshResource;
+		ComputePerMesh(perMesh, &perMeshResource);
+
+		// 구간이 모자라면 null_memory_resource가 bad_alloc을 던짐
+		vector<MeshData> arena = meshes;
+		CountingResource arenaResource;
+		bool enough = true;
+		try
+		{
+			TangentGenerator::Compute(arena, &arenaResource);
+		}
+		catch (const bad_alloc&)
+		{
+			enough = false;
+		}
+		CHECK(enough);
+		CHECK(arenaResource.GetAllocationCount() == 1 && arenaResource.GetCurrentBytes() == 0);
+		CHECK(perMeshResource.GetAllocationCount() > meshes.size());
+		CHECK(SameMeshes(perMesh, arena));
+
+		// 복제된 Mesh는 Vertex가 2배
+		CHECK(arena[5].vertices.size() == meshes[5].vertices.size() * 2);
+		CHECK(arena[6].vertices.size() == meshes[6].vertices.size() * 2);
+
+		// 삼각형이 없으면 할당하지 않음
+		CHECK(TangentGenerator::GetScratchBytes(5, 2) == 0);
+		vector<MeshData> empty(3);
+		CountingResource emptyResource;
+		TangentGenerator::Compute(empty, &emptyResource);
+		CHECK(emptyResource.GetAllocationCount() == 0);
+
+		// Mesh 하나의 실제 사용량은 GetScratchBytes() 안
+		for (const MeshData& mesh : meshes)
+		{
+			MeshData copy = mesh;
+			CountingResource resource;
+			TangentGenerator::Compute(copy.vertices, copy.indices, &resource);
+			CHECK(resource.GetPeakBytes() <= TangentGenerator::GetScratchBytes(mesh.vertices.size(), mesh.indices.size()));
+		}
+	}
+
+	// 두 Tangent 사이 각도의 최댓값, 복제된 Vertex/Index/부호가 다르면 음수
+	float CompareTangents(const MeshData& a, const MeshData& b)
+	{
+		if (a.vertices.size() != b.vertices.size() || a.indices != b.indices)
+		{
+			return -1.0f;
+		}
+
+		float maxAngle = 0.0f;
+		for (size_t i = 0; i < a.vertices.size(); i++)
+		{
+			const Vector4& ta = a.vertices[i].tangentModel;
+			const Vector4& tb = b.vertices[i].tangentModel;
+			if (ta.w != tb.w)
+			{
+				return -1.0f;
+			}
+			const Vector3 u(ta.x, ta.y, ta.z), v(tb.x, tb.y, tb.z);
+			maxAngle = max(maxAngle, atan2(u.Cross(v).Length(), u.Dot(v)));
+		}
+		return maxAngle;
+	}
+
+	void TestScalar()
+	{
+		mt19937 random(3);
+
+		// 블록으로 나뉘는 큰 Mesh(삼각형 4096개 초과), 4의 배수가 아닌 삼각형 수, 거울 UV, 넓이/UV 면적 0인 삼각형
+		vector<MeshData> meshes;
+		meshes.push_back(MakeSphere(1, random));
+		meshes.push_back(MakeSphere(7, random));
+		meshes.push_back(MakeSphere(60, random));
+		meshes.push_back(MakeMirrored(MakeSphere(9, random)));
+		MeshData degenerate = MakeSphere(5, random);
+		degenerate.vertices[1].texcoord = degenerate.vertices[0].texcoord;
+		degenerate.vertices[2].position = degenerate.vertices[0].position;
+		degenerate.indices.insert(degenerate.indices.end(), { 0, 0, 1, 3, 4, 3 });
+		meshes.push_back(degenerate);
+
+		float maxAngle = 0.0f;
+		bool same = true;
+		for (const MeshData& mesh : meshes)
+		{
+			MeshData simd = mesh, scalar = mesh;
+			TangentGenerator::Compute(simd.vertices, simd.indices);
+			TangentGenerator::ComputeScalar(scalar.vertices, scalar.indices);
+
+			const float angle = CompareTangents(simd, scalar);
+			same &= angle >= 0.0f;
+			maxAngle = max(maxAngle, angle);
+
+			// 결과는 단위 길이이고 Normal에 수직
+			for (const Vertex& v : scalar.vertices)
+			{
+				const Vector3 tangent(v.tangentModel.x, v.tangentModel.y, v.tangentModel.z);
+				same &= abs(tangent.Length() - 1.0f) < 1e-4f && abs(tangent.Dot(v.normalModel)) < 1e-4f;
+			}
+		}
+		CHECK(same);
+
+		// acos 근사 오차(약 7e-5 Radian)가 내각 가중치에만 들어가므로 방향 차이는 그보다 작음
+		CHECK(maxAngle < 1e-4f);
+	}
+
+	void Benchmark()
+	{
+		// 큰 Mesh 몇 개와 작은 Mesh 여러 개, 일부는 거울 UV
+		mt19937 random(2);
+		vector<MeshData> scene;
+		for (int i = 0; i < 6; i++)
+		{
+			scene.push_back(MakeSphere(180, random));
+		}
+		for (int i = 0; i < 300; i++)
+		{
+			MeshData mesh = MakeSphere(6 + i % 20, random);
+			scene.push_back((i % 10 == 0) ? MakeMirrored(mesh) : mesh);
+		}
+
+		size_t vertexCount = 0, indexCount = 0;
+		for (const MeshData& mesh : scene)
+		{
+			vertexCount += mesh.vertices.size();
+			indexCount += mesh.indices.size();
+		}
+		cout << scene.size() << " meshes, " << vertexCount << " vertices, " << indexCount << " indices" << endl;
+
+		for (const bool useArena : { false, true })
+		{
+			CountingResource resource;
+			vector<MeshData> meshes;
+			const double ms = MeasureMs([&]() {
+				meshes = scene;
+				if (useArena)
+				{
+					TangentGenerator::Compute(meshes, &resource);
+				}
+				else
+				{
+					ComputePerMesh(meshes, &resource);
+				}
+			}, 3);
+
+			// MeasureMs가 3번 실행하므로 1회 기준
+			cout << (useArena ? "Model arena: " : "Per mesh:    ") << resource.GetAllocationCount() / 3
+				 << " scratch allocations, peak " << resource.GetPeakBytes() / 1024 << " KB, " << ms << " ms"
+				 << endl;
+		}
+
+		// SSE2 + 블록 병렬과 Scalar (acos, 스레드 없음)
+		MeshData big = MakeSphere(400, random);
+		vector<MeshData> work(2);
+		const double simdMs = MeasureMs([&]() {
+			work[0] = big;
+			TangentGenerator::Compute(work[0].vertices, work[0].indices);
+		}, 3);
+		const double scalarMs = MeasureMs([&]() {
+			work[1] = big;
+			TangentGenerator::ComputeScalar(work[1].vertices, work[1].indices);
+		}, 3);
+		cout << big.indices.size() / 3 << " triangles: SSE2 " << simdMs << " ms, Scalar " << scalarMs
+			 << " ms, max tangent difference " << CompareTangents(work[0], work[1]) << " rad (hardware_concurrency "
+			 << thread::hardware_concurrency() << ")" << endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	TestScratch();
+	TestScalar();
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark();
+	}
+
+	return ReportChecks("TestTangentGenerator");
+}
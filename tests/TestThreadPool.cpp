@@ -0,0 +1,276 @@
+// ThreadPool의 ParallelFor(모든 Index를 한 번씩, 중첩 호출, 예외 전달)와 Submit
+// Benchmark는 Worker 수를 바꿔가며 Mesh 단위 작업(ModelLoader처럼)과 잘게 나눈 작업의 속도 향상
+// 사용법: TestThreadPool [--bench]
+
+#include "MeshOptimizer.h"
+#include "TestCommon.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	// [begin, end)의 Index가 모두 정확히 한 번씩 실행됐는지
+	bool RunsEachOnce(ThreadPool& pool, const size_t begin, const size_t end, const size_t grainSize)
+	{
+		vector<atomic<int>> counts(end + 1);
+		pool.ParallelFor(begin, end, [&](size_t i) { counts[i]++; }, grainSize);
+
+		for (size_t i = 0; i < counts.size(); i++)
+		{
+			if (counts[i] != ((i >= begin && i < end) ? 1 : 0))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void TestParallelFor()
+	{
+		for (const size_t workers : { 0, 1, 2, 4 })
+		{
+			ThreadPool pool(workers);
+			CHECK(pool.GetThreadCount() == workers);
+
+			// 빈 범위, 한 개, Chunk 하나, Chunk가 Worker보다 많거나 적은 경우
+			CHECK(RunsEachOnce(pool, 0, 0, 1));
+			CHECK(RunsEachOnce(pool, 5, 3, 1));
+			CHECK(RunsEachOnce(pool, 7, 8, 1));
+			CHECK(RunsEachOnce(pool, 0, 10007, 1));
+			CHECK(RunsEachOnce(pool, 3, 10007, 13));
+			CHECK(RunsEachOnce(pool, 100, 10007, 10007));
+			CHECK(RunsEachOnce(pool, 0, 3, 2));
+			CHECK(RunsEachOnce(pool, 0, 1000, 0)); // grainSize 0은 1로
+
+			// 결과를 Index로 저장하면 순서가 유지됨
+			vector<size_t> squares(5000);
+			pool.ParallelFor(0, squares.size(), [&](size_t i) { squares[i] = i * i; }, 7);
+			bool ordered = true;
+			for (size_t i = 0; i < squares.size(); i++)
+			{
+				ordered &= squares[i] == i * i;
+			}
+			CHECK(ordered);
+		}
+	}
+
+	void TestNested()
+	{
+		// ParallelFor 안에서 ParallelFor: Worker가 모두 바빠도 호출자가 끝까지 처리
+		for (const size_t workers : { 1, 2, 4 })
+		{
+			ThreadPool pool(workers);
+			atomic<size_t> sum{ 0 };
+			pool.ParallelFor(0, 64, [&](size_t i) {
+				pool.ParallelFor(0, 100, [&](size_t j) { sum += i * 100 + j; }, 3);
+			});
+			CHECK(sum == 6400 * 6399 / 2);
+
+			// Submit한 작업 안에서 ParallelFor (Worker 전부가 이 작업을 실행 중)
+			vector<future<size_t>> results;
+			for (size_t t = 0; t < workers * 2; t++)
+			{
+				results.push_back(pool.Submit([&pool, t]() {
+					atomic<size_t> count{ 0 };
+					pool.ParallelFor(0, 1000 + t, [&](size_t) { count++; }, 10);
+					return count.load();
+				}));
+			}
+			bool allDone = true;
+			for (size_t t = 0; t < results.size(); t++)
+			{
+				allDone &= results[t].get() == 1000 + t;
+			}
+			CHECK(allDone);
+		}
+	}
+
+	void TestExceptions()
+	{
+		for (const size_t workers : { 0, 1, 4 })
+		{
+			ThreadPool pool(workers);
+
+			// 던진 예외는 호출자에게, 나머지 Chunk는 반환 전에 모두 끝남 (Worker가 없으면 그 자리에서 멈춤)
+			atomic<size_t> count{ 0 };
+			bool caught = false;
+			try
+			{
+				pool.ParallelFor(0, 1000, [&](size_t i) {
+					if (i == 500)
+					{
+						throw runtime_error("item 500");
+					}
+					count++;
+				});
+			}
+			catch (const runtime_error& e)
+			{
+				caught = string(e.what()) == "item 500";
+			}
+			CHECK(caught);
+			CHECK(count == (workers == 0 ? 500 : 999));
+
+			// 여러 Chunk가 던져도 예외는 하나
+			int thrown = 0;
+			try
+			{
+				pool.ParallelFor(0, 100, [&](size_t) { throw logic_error("all"); }, 5);
+			}
+			catch (const logic_error&)
+			{
+				thrown++;
+			}
+			CHECK(thrown == 1);
+
+			// 예외 뒤에도 Pool은 그대로 사용 가능
+			CHECK(RunsEachOnce(pool, 0, 3000, 7));
+
+			// Submit의 예외는 future::get()에서 (Worker가 없으면 Submit한 작업은 실행되지 않음)
+			if (workers == 0)
+			{
+				continue;
+			}
+			future<int> failed = pool.Submit([]() -> int { throw runtime_error("submit"); });
+			bool submitCaught = false;
+			try
+			{
+				failed.get();
+			}
+			catch (const runtime_error&)
+			{
+				submitCaught = true;
+			}
+			CHECK(submitCaught);
+		}
+	}
+
+	void TestSubmit()
+	{
+		atomic<int> count{ 0 };
+		{
+			ThreadPool pool(2);
+			CHECK(pool.Submit([]() { return 42; }).get() == 42);
+			CHECK(pool.Submit([]() { return string("text"); }).get() == "text");
+
+			// 소멸자는 남은 작업을 모두 실행한 뒤에 끝남
+			for (int i = 0; i < 200; i++)
+			{
+				pool.Submit([&count]() { count++; });
+			}
+		}
+		CHECK(count == 200);
+
+		CHECK(ThreadPool::GetInstance().GetThreadCount() == max(thread::hardware_concurrency(), 2u) - 1);
+	}
+
+	// 반지름 1인 구 (segments * segments * 4개 삼각형), 각 Vertex를 삼각형마다 따로 만들어서 Weld가 할 일이 있음
+	MeshData MakeSoup(const int segments)
+	{
+		MeshData mesh;
+		const int columns = segments * 2 + 1;
+		auto position = [&](int i, int j) {
+			const float theta = XM_PI * float(i) / float(segments);
+			const float phi = XM_PI * float(j) / float(segments);
+			return Vector3(sin(theta) * cos(phi), cos(theta), sin(theta) * sin(phi));
+		};
+
+		for (int i = 0; i < segments; i++)
+		{
+			for (int j = 0; j < columns - 1; j++)
+			{
+				const Vector3 corners[] = { position(i, j), position(i + 1, j), position(i, j + 1),
+											position(i, j + 1), position(i + 1, j), position(i + 1, j + 1) };
+				for (const Vector3& corner : corners)
+				{
+					Vertex v = {};
+					v.position = corner;
+					v.normalModel = corner;
+					mesh.indices.push_back(uint32_t(mesh.vertices.size()));
+					mesh.vertices.push_back(v);
+				}
+			}
+		}
+		return mesh;
+	}
+
+	void Benchmark()
+	{
+		const unsigned int cores = thread::hardware_concurrency();
+		vector<size_t> threadCounts = { 1, 2, 4, 8 };
+		if (cores > 8)
+		{
+			threadCounts.push_back(cores);
+		}
+		cout << "hardware_concurrency " << cores << endl;
+
+		// ModelLoader처럼 Mesh 하나가 작업 하나 (크기가 다른 Mesh들)
+		vector<MeshData> meshes;
+		for (int i = 0; i < 48; i++)
+		{
+			meshes.push_back(MakeSoup(10 + (i % 8) * 8));
+		}
+
+		// 잘게 나눈 작업 (Texture 변환처럼 항목당 일이 적음)
+		vector<float> values(1 << 22);
+		for (size_t i = 0; i < values.size(); i++)
+		{
+			values[i] = float(i % 1000) * 0.01f;
+		}
+
+		double meshBaseMs = 0.0, fineBaseMs = 0.0;
+		for (const size_t threadCount : threadCounts)
+		{
+			// 호출한 스레드도 일하므로 Worker는 하나 적게
+			ThreadPool pool(threadCount - 1);
+
+			const double meshMs = MeasureMs([&]() {
+				vector<MeshData> work = meshes;
+				pool.ParallelFor(0, work.size(), [&](size_t i) { MeshOptimizer::Optimize(work[i]); });
+			}, 3);
+
+			vector<float> results(values.size());
+			const double fineMs = MeasureMs([&]() {
+				pool.ParallelFor(0, values.size() / 4096, [&](size_t chunk) {
+					for (size_t i = chunk * 4096; i < (chunk + 1) * 4096; i++)
+					{
+						results[i] = sqrt(values[i]) * sin(values[i]);
+					}
+				});
+			});
+
+			if (threadCount == 1)
+			{
+				meshBaseMs = meshMs;
+				fineBaseMs = fineMs;
+			}
+			cout << threadCount << " threads: " << meshes.size() << " meshes Optimize " << meshMs << " ms (x"
+				 << meshBaseMs / meshMs << "), " << values.size() << " items " << fineMs << " ms (x"
+				 << fineBaseMs / fineMs << ")" << endl;
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	TestParallelFor();
+	TestNested();
+	TestExceptions();
+	TestSubmit();
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark();
+	}
+
+	return ReportChecks("TestThreadPool");
+}
@@ -0,0 +1,386 @@
+// UploadManager의 Staging Page 관리 (Free -> Open -> Submitted -> Free, Fence/Frame 회수, 예산)
+// GPU 대신 MockUploadDevice (Copy는 바로 메모리 복사, Fence는 gpuLatency번의 Signal 뒤에 완료)
+// 사용법: TestUploadManager [--bench]
+
+#include "MockUploadDevice.h"
+#include "TestCommon.h"
+#include "UploadManager.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	// GPU 복사 시간은 빼고 CPU 쪽 비용만
+	class NoCopyDevice : public MockUploadDevice {
+	public:
+		void Copy(void*, const UploadCopy&) override { m_copyCount++; }
+	};
+
+	ImageData MakeImage(const DXGI_FORMAT format, const int width, const int height, const int mipLevels,
+						const uint32_t seed)
+	{
+		ImageData image;
+		image.format = format;
+		image.width = width;
+		image.height = height;
+		image.mipLevels = mipLevels;
+
+		size_t size = 0;
+		for (int mip = 0; mip < max(mipLevels, 1); mip++)
+		{
+			size += image.GetMipSize(mip);
+		}
+		image.pixels.resize(size);
+
+		mt19937 random(seed);
+		for (uint8_t& b : image.pixels)
+		{
+			b = uint8_t(random());
+		}
+		return image;
+	}
+
+	bool SameTexture(const MockResource& resource, const ImageData& image, const int arraySlice,
+					 const int dstMipLevels)
+	{
+		for (int mip = 0; mip < max(image.mipLevels, 1); mip++)
+		{
+			const vector<uint8_t>& data = resource.subresources[arraySlice * dstMipLevels + mip];
+			if (data.size() != image.GetMipSize(mip) ||
+				memcmp(data.data(), image.pixels.data() + image.GetMipOffset(mip), data.size()) != 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	UploadManager::Settings SmallSettings()
+	{
+		UploadManager::Settings settings;
+		settings.pageWidth = 1024;
+		settings.pageBytes = 1 << 20;
+		settings.maxBytes = 8 << 20;
+		return settings;
+	}
+
+	void TestPageStates()
+	{
+		MockUploadDevice device;
+		UploadManager manager(device, SmallSettings());
+		const UploadManager::Stats& stats = manager.GetStats();
+
+		// 아무것도 없으면 Flush는 Signal하지 않음
+		manager.Flush();
+		manager.EndFrame();
+		CHECK(stats.flushCount == 0 && device.m_signaled == 0);
+		CHECK(stats.pageCount == 0 && device.m_pageCreateCount == 0);
+
+		// Open: Map된 Page에 담아두기만 하고 dst는 아직 그대로 (참조를 잡고 있음)
+		const vector<uint8_t> data(1000, 42);
+		unique_ptr<MockResource> buffer = MockResource::CreateBuffer(data.size());
+		manager.UploadBuffer(buffer->Get(), data.data(), data.size());
+		CHECK(stats.pageCount == 1 && stats.pageCreateCount == 1 && stats.mapCount == 1);
+		CHECK(buffer->refCount == 2);
+		CHECK(buffer->subresources[0][0] == 0);
+
+		// 같은 Page의 남은 자리 (Map을 더 하지 않음)
+		unique_ptr<MockResource> small = MockResource::CreateBuffer(16);
+		manager.UploadBuffer(small->Get(), data.data(), 16);
+		CHECK(stats.pageCount == 1 && device.m_mapCount == 1);
+
+		// Submitted: Unmap하고 복사, Fence 하나로 Signal
+		manager.Flush();
+		CHECK(stats.flushCount == 1 && device.m_signaled == 1);
+		CHECK(stats.copyCount == 2 && device.m_copyCount == 2);
+		CHECK(buffer->subresources[0] == data && buffer->refCount == 1 && small->refCount == 1);
+
+		// 이미 보낸 뒤에 다시 Flush해도 Signal하지 않음
+		manager.Flush();
+		CHECK(stats.flushCount == 1 && device.m_signaled == 1);
+
+		// GPU가 아직 읽는 중이면 새 Page
+		manager.UploadBuffer(buffer->Get(), data.data(), data.size());
+		CHECK(stats.pageCount == 2 && stats.pageCreateCount == 2);
+		manager.Flush();
+		CHECK(stats.flushCount == 2 && device.m_signaled == 2);
+
+		// Free: Fence가 끝나면 만들지 않고 다시 Map
+		device.WaitForFence(device.m_signaled);
+		const size_t mapCount = device.m_mapCount;
+		manager.UploadBuffer(buffer->Get(), data.data(), data.size());
+		CHECK(stats.pageCount == 2 && stats.pageCreateCount == 2);
+		CHECK(device.m_mapCount == mapCount + 1 && device.m_mapStallCount == 0);
+		manager.EndFrame();
+		CHECK(stats.flushCount == 3 && buffer->subresources[0] == data);
+		CHECK(device.m_errorCount == 0);
+	}
+
+	void TestFenceRecycling()
+	{
+		const vector<uint8_t> data(4096, 7);
+		unique_ptr<MockResource> buffer = MockResource::CreateBuffer(data.size());
+
+		// Fence만 사용: GPU가 2 Frame 늦으면 Page 3개를 돌려 씀, 읽는 중인 Page는 Map하지 않음
+		{
+			MockUploadDevice device;
+			UploadManager::Settings settings = SmallSettings();
+			settings.retireFrames = 0;
+			UploadManager manager(device, settings);
+			for (int frame = 0; frame < 20; frame++)
+			{
+				manager.UploadBuffer(buffer->Get(), data.data(), data.size());
+				manager.EndFrame();
+			}
+			CHECK(device.m_pageCreateCount == device.m_gpuLatency + 1);
+			CHECK(device.m_mapCount == 20 && device.m_mapStallCount == 0);
+			CHECK(manager.GetStats().flushCount == 20 && manager.GetStats().waitCount == 0);
+		}
+
+		// Fence가 끝나지 않아도 retireFrames가 지나면 다시 사용 (D3D11은 Map이 기다림)
+		{
+			MockUploadDevice device;
+			device.m_gpuLatency = 100;
+			UploadManager::Settings settings = SmallSettings();
+			settings.retireFrames = 1;
+			UploadManager manager(device, settings);
+			for (int frame = 0; frame < 20; frame++)
+			{
+				manager.UploadBuffer(buffer->Get(), data.data(), data.size());
+				manager.EndFrame();
+			}
+			CHECK(device.m_pageCreateCount == 1);
+			CHECK(device.m_mapStallCount == 19);
+		}
+
+		// Flush를 여러 번 해도 Frame 단위로는 같음 (같은 Frame의 Page는 retireFrames 전까지 Submitted)
+		{
+			MockUploadDevice device;
+			device.m_gpuLatency = 100;
+			UploadManager manager(device, SmallSettings());
+			for (int frame = 0; frame < 10; frame++)
+			{
+				for (int i = 0; i < 2; i++)
+				{
+					manager.UploadBuffer(buffer->Get(), data.data(), data.size());
+					manager.Flush();
+				}
+				manager.EndFrame();
+			}
+			CHECK(device.m_pageCreateCount == 2 * 3);
+			CHECK(device.m_signaled == 20);
+			CHECK(device.m_errorCount == 0);
+		}
+	}
+
+	void TestCopies()
+	{
+		MockUploadDevice device;
+		UploadManager manager(device, SmallSettings());
+
+		const ImageData rgba = MakeImage(DXGI_FORMAT_R8G8B8A8_UNORM, 300, 200, 0, 1);
+		const ImageData srgb = MakeImage(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, 256, 256, 9, 2); // rgba와 같은 Page
+		const ImageData bc7 = MakeImage(DXGI_FORMAT_BC7_UNORM, 512, 512, 10, 3);
+		const ImageData bc1 = MakeImage(DXGI_FORMAT_BC1_UNORM_SRGB, 100, 60, 7, 4); // 4의 배수가 아닌 크기
+		const ImageData tall = MakeImage(DXGI_FORMAT_R8G8B8A8_UNORM, 64, 3000, 0, 5); // Page 높이보다 높음
+		const ImageData wide = MakeImage(DXGI_FORMAT_R8G8B8A8_UNORM, 2048, 8, 0, 6);	 // Page보다 넓음
+		const ImageData hdr = MakeImage(DXGI_FORMAT_R16G16B16A16_FLOAT, 128, 64, 0, 7);
+
+		unique_ptr<MockResource> rgbaTexture = MockResource::CreateTexture(rgba.format, 300, 200, 9, 1);
+		unique_ptr<MockResource> srgbTexture = MockResource::CreateTexture(srgb.format, 256, 256, 9, 1);
+		unique_ptr<MockResource> bc7Texture = MockResource::CreateTexture(bc7.format, 512, 512, 10, 1);
+		unique_ptr<MockResource> bc1Texture = MockResource::CreateTexture(bc1.format, 100, 60, 7, 1);
+		unique_ptr<MockResource> tallTexture = MockResource::CreateTexture(tall.format, 64, 3000, 1, 1);
+		unique_ptr<MockResource> wideTexture = MockResource::CreateTexture(wide.format, 2048, 8, 1, 1);
+		unique_ptr<MockResource> hdrArray = MockResource::CreateTexture(hdr.format, 128, 64, 1, 3);
+
+		manager.UploadTexture(rgbaTexture->Get(), 9, 0, rgba);
+		manager.UploadTexture(srgbTexture->Get(), 9, 0, srgb);
+		manager.UploadTexture(bc7Texture->Get(), 10, 0, bc7);
+		manager.UploadTexture(bc1Texture->Get(), 7, 0, bc1);
+		manager.UploadTexture(tallTexture->Get(), 1, 0, tall);
+		manager.UploadTexture(wideTexture->Get(), 1, 0, wide);
+		manager.UploadTexture(hdrArray->Get(), 1, 2, hdr);
+
+		// Page보다 큰 Buffer는 여러 Page로 나눠서, 작은 것은 16 Byte 정렬
+		vector<uint8_t> large(3 << 20);
+		mt19937 random(9);
+		for (uint8_t& b : large)
+		{
+			b = uint8_t(random());
+		}
+		unique_ptr<MockResource> largeBuffer = MockResource::CreateBuffer(large.size() + 100);
+		manager.UploadBuffer(largeBuffer->Get(), large.data(), large.size(), 100);
+		const vector<uint8_t> odd(333, 5);
+		unique_ptr<MockResource> oddBuffer = MockResource::CreateBuffer(odd.size());
+		manager.UploadBuffer(oddBuffer->Get(), odd.data(), odd.size());
+
+		manager.EndFrame();
+
+		CHECK(SameTexture(*rgbaTexture, rgba, 0, 9));
+		CHECK(SameTexture(*srgbTexture, srgb, 0, 9));
+		CHECK(SameTexture(*bc7Texture, bc7, 0, 10));
+		CHECK(SameTexture(*bc1Texture, bc1, 0, 7));
+		CHECK(SameTexture(*tallTexture, tall, 0, 1));
+		CHECK(SameTexture(*wideTexture, wide, 0, 1));
+		CHECK(SameTexture(*hdrArray, hdr, 2, 1));
+		CHECK(memcmp(largeBuffer->subresources[0].data() + 100, large.data(), large.size()) == 0);
+		CHECK(oddBuffer->subresources[0] == odd);
+
+		for (const MockResource* resource : { rgbaTexture.get(), srgbTexture.get(), bc7Texture.get(),
+											  bc1Texture.get(), tallTexture.get(), wideTexture.get(), hdrArray.get(),
+											  largeBuffer.get(), oddBuffer.get() })
+		{
+			CHECK(resource->refCount == 1);
+		}
+
+		const UploadManager::Stats& stats = manager.GetStats();
+		CHECK(stats.uploadCount == 9);
+		CHECK(stats.directCount == 1 && device.m_directCount == 1); // wide만
+		CHECK(stats.copyCount == device.m_copyCount);
+		CHECK(stats.pageCount == device.m_livePageCount);
+		CHECK(stats.pageMemory <= SmallSettings().maxBytes);
+		CHECK(UploadManager::GetPageFormat(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB) == DXGI_FORMAT_R8G8B8A8_UNORM);
+		CHECK(device.m_errorCount == 0);
+	}
+
+	void TestBudget()
+	{
+		// 한 Frame에 maxBytes보다 많이 올리면 보내고 기다린 뒤 같은 Page를 다시 사용
+		MockUploadDevice device;
+		UploadManager::Settings settings;
+		settings.pageWidth = 512;
+		settings.pageBytes = 1 << 20;
+		settings.maxBytes = 3 << 20;
+		UploadManager manager(device, settings);
+
+		vector<ImageData> images;
+		vector<unique_ptr<MockResource>> textures;
+		for (int i = 0; i < 12; i++)
+		{
+			images.push_back(MakeImage(DXGI_FORMAT_R8G8B8A8_UNORM, 512, 512, 0, 100 + i));
+			textures.push_back(MockResource::CreateTexture(DXGI_FORMAT_R8G8B8A8_UNORM, 512, 512, 1, 1));
+			manager.UploadTexture(textures.back()->Get(), 1, 0, images.back());
+			CHECK(manager.GetStats().pageMemory <= settings.maxBytes);
+		}
+		manager.EndFrame();
+
+		bool allSame = true;
+		for (int i = 0; i < 12; i++)
+		{
+			allSame &= SameTexture(*textures[i], images[i], 0, 1);
+		}
+		CHECK(allSame);
+		CHECK(manager.GetStats().pageCount == 3 && device.m_pageCreateCount == 3);
+		CHECK(manager.GetStats().waitCount > 0 && manager.GetStats().waitCount == device.m_waitCount);
+		CHECK(device.m_errorCount == 0);
+
+		// 예산 때문에 다른 종류의 Free Page는 정리
+		const vector<uint8_t> data(256, 1);
+		unique_ptr<MockResource> buffer = MockResource::CreateBuffer(data.size());
+		device.WaitForFence(device.m_signaled);
+		manager.UploadBuffer(buffer->Get(), data.data(), data.size());
+		CHECK(manager.GetStats().pageDestroyCount == 1 && device.m_livePageCount == 3);
+		manager.EndFrame();
+		CHECK(buffer->subresources[0] == data);
+	}
+
+	void TestDestroy()
+	{
+		// 보내지 않은 복사의 참조를 돌려주고 Page를 모두 해제
+		MockUploadDevice device;
+		unique_ptr<MockResource> buffer = MockResource::CreateBuffer(64);
+		{
+			UploadManager manager(device);
+			const vector<uint8_t> data(64, 1);
+			manager.UploadBuffer(buffer->Get(), data.data(), data.size());
+			CHECK(buffer->refCount == 2);
+		}
+		CHECK(buffer->refCount == 1);
+		CHECK(device.m_livePageCount == 0);
+	}
+
+	// Mesh마다 Albedo/Normal/ORM 같은 작은 Texture를 Frame마다 여러 개
+	// Mock의 CreatePage는 메모리 할당뿐이라 D3D11의 CreateTexture2D 비용은 빠져 있으므로 만든 횟수를 같이 출력
+	void Benchmark()
+	{
+		const int frameCount = 50;
+		for (const int size : { 64, 128, 256 })
+		{
+			const int perFrame = 64;
+			vector<ImageData> images;
+			for (int i = 0; i < perFrame; i++)
+			{
+				images.push_back(MakeImage(DXGI_FORMAT_R8G8B8A8_UNORM, size, size, 0, i));
+			}
+			unique_ptr<MockResource> dst = MockResource::CreateTexture(DXGI_FORMAT_R8G8B8A8_UNORM, size, size, 1, 1);
+
+			// 이전 방식 (업로드마다 Staging을 만들고 Map/복사/해제, 비교용)
+			NoCopyDevice stagingDevice;
+			const double stagingMs = MeasureMs([&]() {
+				for (int frame = 0; frame < frameCount; frame++)
+				{
+					for (const ImageData& image : images)
+					{
+						UploadPageDesc desc;
+						desc.format = image.format;
+						desc.width = size;
+						desc.height = size;
+						void* page = stagingDevice.CreatePage(desc);
+						size_t rowPitch;
+						uint8_t* mapped = stagingDevice.MapPage(page, rowPitch);
+						for (int y = 0; y < size; y++)
+						{
+							memcpy(mapped + y * rowPitch, image.pixels.data() + y * image.GetRowPitch(0),
+								   image.GetRowPitch(0));
+						}
+						stagingDevice.UnmapPage(page);
+
+						UploadCopy copy;
+						copy.dst = dst->Get();
+						copy.width = copy.height = size;
+						stagingDevice.Copy(page, copy);
+						stagingDevice.DestroyPage(page);
+					}
+				}
+			});
+
+			NoCopyDevice pageDevice;
+			UploadManager manager(pageDevice);
+			const double managerMs = MeasureMs([&]() {
+				for (int frame = 0; frame < frameCount; frame++)
+				{
+					for (const ImageData& image : images)
+					{
+						manager.UploadTexture(dst->Get(), 1, 0, image);
+					}
+					manager.EndFrame();
+				}
+			});
+
+			cout << frameCount << " frames x " << perFrame << " textures " << size << "x" << size
+				 << ": per-upload staging " << stagingMs << " ms (" << stagingDevice.m_pageCreateCount / 5
+				 << " creates), UploadManager " << managerMs << " ms (" << pageDevice.m_pageCreateCount
+				 << " creates, " << manager.GetStats().flushCount / 5 << " flushes)" << endl;
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	TestPageStates();
+	TestFenceRecycling();
+	TestCopies();
+	TestBudget();
+	TestDestroy();
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark();
+	}
+
+	return ReportChecks("TestUploadManager");
+}
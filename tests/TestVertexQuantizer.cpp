@@ -0,0 +1,254 @@
+// VertexQuantizer: SSE2(와 F16C) 결과가 QuantizeScalar와 Bit 단위로 같은지, 복원 오차가 상한 안인지
+// (Position은 GetPositionErrorBound, Normal/Tangent는 Octahedral 16-bit 각도 오차, Texcoord는 FLOAT16 상대 오차)
+// F16C 경로는 -mf16c(또는 -mavx2)로 빌드했을 때만 사용됨
+// Benchmark는 100만 Vertex 변환 시간과 Vertex Buffer 크기
+// 사용법: TestVertexQuantizer [--bench]
+
+#include "TestCommon.h"
+#include "VertexQuantizer.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	Vector3 RandomDirection(mt19937& random)
+	{
+		normal_distribution<float> gaussian;
+		Vector3 direction;
+		do
+		{
+			direction = Vector3(gaussian(random), gaussian(random), gaussian(random));
+		} while (direction.LengthSquared() < 1e-6f);
+		direction.Normalize();
+		return direction;
+	}
+
+	// Mesh 중심이 원점에서 멀고 축마다 크기가 다른 Vertex들 + 경계 값
+	vector<Vertex> MakeVertices(const size_t count, mt19937& random)
+	{
+		uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		vector<Vertex> vertices(count);
+		for (Vertex& v : vertices)
+		{
+			v.position = Vector3(100.0f + unit(random) * 3.0f, unit(random) * 0.2f, -50.0f + unit(random));
+			v.normalModel = RandomDirection(random);
+			const Vector3 tangent = RandomDirection(random);
+			v.tangentModel = Vector4(tangent.x, tangent.y, tangent.z, unit(random) < 0.0f ? -1.0f : 1.0f);
+			v.texcoord = Vector2(unit(random) * 8.0f, unit(random));
+		}
+
+		// 축 방향, 접히는 대각선, -0, 길이 0, Bitangent 부호 0/-0
+		const Vector3 directions[] = { Vector3(1.0f, 0.0f, 0.0f),  Vector3(-1.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f),
+									   Vector3(0.0f, -1.0f, 0.0f), Vector3(0.0f, 0.0f, 1.0f),  Vector3(0.0f, 0.0f, -1.0f),
+									   Vector3(0.7071068f, 0.0f, -0.7071068f), Vector3(-0.0f, -0.0f, -1.0f),
+									   Vector3(0.5773503f, -0.5773503f, -0.5773503f), Vector3(0.0f) };
+		for (size_t i = 0; i < size(directions) && i < count; i++)
+		{
+			vertices[i].normalModel = directions[i];
+			vertices[i].tangentModel = Vector4(directions[size(directions) - 1 - i].x, directions[size(directions) - 1 - i].y,
+											   directions[size(directions) - 1 - i].z, (i % 2) ? -0.0f : 0.0f);
+		}
+
+		// FLOAT16 Subnormal, 최대값 근처, 범위 밖(Inf)
+		const Vector2 texcoords[] = { Vector2(1e-6f, -3e-7f), Vector2(65504.0f, -65519.0f), Vector2(1e6f, -0.0f) };
+		for (size_t i = 0; i < size(texcoords) && i < count; i++)
+		{
+			vertices[count - 1 - i].texcoord = texcoords[i];
+		}
+		return vertices;
+	}
+
+	float GetAngle(const Vector3& a, const Vector3& b)
+	{
+		return atan2(a.Cross(b).Length(), a.Dot(b));
+	}
+
+	void TestMatchesScalar()
+	{
+		mt19937 random(1);
+
+		// 4개 단위 Block과 남은 Vertex 처리
+		for (const size_t count : { 0, 1, 3, 4, 5, 7, 8, 13, 100003 })
+		{
+			const vector<Vertex> vertices = MakeVertices(count, random);
+			const QuantizationConstants consts = VertexQuantizer::ComputeConstants(vertices.data(), count);
+
+			vector<QuantizedVertex> simd;
+			VertexQuantizer::Quantize(vertices.data(), count, consts, simd);
+			vector<QuantizedVertex> scalar(count);
+			VertexQuantizer::QuantizeScalar(vertices.data(), count, consts, scalar.data());
+			CHECK(simd.size() == count);
+			CHECK(count == 0 || memcmp(simd.data(), scalar.data(), sizeof(QuantizedVertex) * count) == 0);
+
+			// Depth Pass의 Position Stream은 같은 값
+			vector<QuantizedPosition> positions;
+			VertexQuantizer::ExtractPositions(simd.data(), count, positions);
+			bool samePositions = positions.size() == count;
+			for (size_t i = 0; samePositions && i < count; i++)
+			{
+				samePositions = memcmp(positions[i].position, simd[i].position, sizeof(QuantizedPosition)) == 0;
+			}
+			CHECK(samePositions);
+		}
+	}
+
+	void TestErrors(const bool report)
+	{
+		mt19937 random(2);
+		const vector<Vertex> vertices = MakeVertices(200000, random);
+		const QuantizationConstants consts = VertexQuantizer::ComputeConstants(vertices.data(), vertices.size());
+		vector<QuantizedVertex> quantized;
+		VertexQuantizer::Quantize(vertices.data(), vertices.size(), consts, quantized);
+
+		// AABB의 양 끝이 SNORM 범위를 꽉 채움
+		int16_t qmin[3] = { 32767, 32767, 32767 }, qmax[3] = { -32767, -32767, -32767 };
+		for (const QuantizedVertex& q : quantized)
+		{
+			for (int a = 0; a < 3; a++)
+			{
+				qmin[a] = min(qmin[a], q.position[a]);
+				qmax[a] = max(qmax[a], q.position[a]);
+			}
+		}
+		CHECK(qmin[0] == -32767 && qmin[1] == -32767 && qmin[2] == -32767);
+		CHECK(qmax[0] == 32767 && qmax[1] == 32767 && qmax[2] == 32767);
+
+		// Position 상한에는 축마다 float 연산 오차(원래 좌표 크기의 2 ulp)를 더함
+		const Vector3 bound = VertexQuantizer::GetPositionErrorBound(consts);
+		const Vector3 roundoff = (Vector3(abs(consts.positionOffset.x), abs(consts.positionOffset.y), abs(consts.positionOffset.z)) +
+								  consts.positionScale) * (2.0f * FLT_EPSILON);
+		Vector3 positionError(0.0f);
+		float normalError = 0.0f, tangentError = 0.0f, texcoordError = 0.0f;
+		bool signs = true, zeroToZ = true;
+		for (size_t i = 0; i < vertices.size(); i++)
+		{
+			const Vertex& v = vertices[i];
+			const Vertex r = VertexQuantizer::Dequantize(quantized[i], consts);
+
+			positionError = Vector3::Max(positionError, Vector3(abs(r.position.x - v.position.x), abs(r.position.y - v.position.y),
+																abs(r.position.z - v.position.z)));
+
+			if (v.normalModel.LengthSquared() > 0.0f)
+			{
+				normalError = max(normalError, GetAngle(r.normalModel, v.normalModel));
+			}
+			else
+			{
+				zeroToZ &= r.normalModel.z == 1.0f;
+			}
+			const Vector3 tangent(v.tangentModel.x, v.tangentModel.y, v.tangentModel.z);
+			if (tangent.LengthSquared() > 0.0f)
+			{
+				tangentError = max(tangentError, GetAngle(Vector3(r.tangentModel.x, r.tangentModel.y, r.tangentModel.z), tangent));
+			}
+			else
+			{
+				zeroToZ &= r.tangentModel.z == 1.0f;
+			}
+			signs &= r.tangentModel.w == ((v.tangentModel.w < 0.0f) ? -1.0f : 1.0f);
+
+			// FLOAT16 정규 범위에서는 상대 오차 2^-11, Subnormal은 절대 오차 2^-25, 범위 밖은 Inf
+			const float uv[2] = { v.texcoord.x, v.texcoord.y };
+			const float ruv[2] = { r.texcoord.x, r.texcoord.y };
+			for (int k = 0; k < 2; k++)
+			{
+				if (abs(uv[k]) >= 65520.0f)
+				{
+					signs &= isinf(ruv[k]) && signbit(ruv[k]) == signbit(uv[k]);
+				}
+				else if (abs(uv[k]) >= 6.1035156e-5f)
+				{
+					texcoordError = max(texcoordError, abs(ruv[k] - uv[k]) / abs(uv[k]));
+				}
+				else
+				{
+					texcoordError = max(texcoordError, abs(ruv[k] - uv[k]) * 16384.0f);
+				}
+			}
+		}
+
+		CHECK(positionError.x <= bound.x + roundoff.x && positionError.y <= bound.y + roundoff.y &&
+			  positionError.z <= bound.z + roundoff.z);
+		CHECK(normalError < 1e-4f && tangentError < 1e-4f);
+		CHECK(texcoordError <= 1.0f / 2048.0f);
+		CHECK(signs && zeroToZ);
+
+		// 납작한 축(Scale 0)은 모두 Offset으로 복원
+		vector<Vertex> flat = MakeVertices(64, random);
+		for (Vertex& v : flat)
+		{
+			v.position.y = 7.0f;
+		}
+		const QuantizationConstants flatConsts = VertexQuantizer::ComputeConstants(flat.data(), flat.size());
+		vector<QuantizedVertex> flatQuantized;
+		VertexQuantizer::Quantize(flat.data(), flat.size(), flatConsts, flatQuantized);
+		bool flatY = flatConsts.positionScale.y == 0.0f;
+		for (const QuantizedVertex& q : flatQuantized)
+		{
+			flatY &= q.position[1] == 0 && VertexQuantizer::Dequantize(q, flatConsts).position.y == 7.0f;
+		}
+		CHECK(flatY);
+
+		// Octahedral 복원은 단위 길이, 모서리(-1, -1)은 -z 쪽
+		CHECK(abs(VertexQuantizer::DecodeOctahedral(12345, -20000).Length() - 1.0f) < 1e-6f);
+		CHECK(VertexQuantizer::DecodeOctahedral(-32767, -32767).z < -0.9999f);
+		CHECK(VertexQuantizer::DecodeOctahedral(-32768, 0).x == -1.0f);
+
+		if (report)
+		{
+			cout << "position error " << positionError.x << " " << positionError.y << " " << positionError.z << " (bound "
+				 << bound.x << " " << bound.y << " " << bound.z << "), normal " << normalError << " rad, tangent "
+				 << tangentError << " rad, texcoord " << texcoordError << endl;
+		}
+	}
+
+	void Benchmark()
+	{
+		mt19937 random(3);
+		const vector<Vertex> vertices = MakeVertices(1 << 20, random);
+		const QuantizationConstants consts = VertexQuantizer::ComputeConstants(vertices.data(), vertices.size());
+
+		vector<QuantizedVertex> quantized(vertices.size());
+		const double simdMs = MeasureMs([&]() { VertexQuantizer::Quantize(vertices.data(), vertices.size(), consts, quantized.data()); });
+		const double scalarMs = MeasureMs([&]() { VertexQuantizer::QuantizeScalar(vertices.data(), vertices.size(), consts, quantized.data()); });
+		vector<QuantizedPosition> positions;
+		const double extractMs = MeasureMs([&]() { VertexQuantizer::ExtractPositions(quantized.data(), quantized.size(), positions); });
+
+#ifdef __F16C__
+		const char* simdName = "SSE2 + F16C";
+#else
+		const char* simdName = "SSE2";
+#endif
+		cout << vertices.size() << " vertices: Quantize (" << simdName << ") " << simdMs << " ms, QuantizeScalar "
+			 << scalarMs << " ms, ExtractPositions " << extractMs << " ms" << endl;
+
+		// Main Pass Vertex Buffer와 Depth Only/Shadow Pass용 Position Stream
+		const double megabytes = double(vertices.size()) / (1024.0 * 1024.0);
+		cout << "Vertex " << sizeof(Vertex) << " B -> QuantizedVertex " << sizeof(QuantizedVertex) << " B + QuantizedPosition "
+			 << sizeof(QuantizedPosition) << " B: " << megabytes * sizeof(Vertex) << " MB -> "
+			 << megabytes * sizeof(QuantizedVertex) << " MB (" << megabytes * (sizeof(QuantizedVertex) + sizeof(QuantizedPosition))
+			 << " MB with positions), Depth Pass fetch " << sizeof(Vertex) << " -> " << sizeof(QuantizedPosition) << " B per vertex"
+			 << endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	TestMatchesScalar();
+	TestErrors(HasArgument(argc, argv, "--bench"));
+
+	if (HasArgument(argc, argv, "--bench"))
+	{
+		Benchmark();
+	}
+
+	return ReportChecks("TestVertexQuantizer");
+}
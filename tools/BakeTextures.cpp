@@ -0,0 +1,91 @@
+// Model이 사용하는 Texture들을 미리 Mipmap 생성 + BC 압축해서 원본 옆에 .dds로 저장하는 도구
+// AO/Roughness/Metallic은 MaterialPacker로 합쳐서 .packed.dds로 저장
+// 실행 파일(main.cpp)과 따로 빌드 (D3D 없이 Linux에서도 동작, 빌드 방법은 README.md)
+//
+// 사용법: BakeTextures [--force] [--stats] <basePath> <modelFile> [<basePath> <modelFile> ...]
+
+#include "MaterialPacker.h"
+#include "ModelLoader.h"
+#include "Stats.h"
+#include "TextureBaker.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+	bool force = false;
+	vector<string> args;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--force") == 0)
+		{
+			force = true;
+		}
+		else if (strcmp(argv[i], "--stats") == 0)
+		{
+			g_printStats = true;
+		}
+		else
+		{
+			args.push_back(argv[i]);
+		}
+	}
+
+	if (args.empty() || args.size() % 2 != 0)
+	{
+		cout << "Usage: BakeTextures [--force] [--stats] <basePath> <modelFile> [<basePath> <modelFile> ...]" << endl;
+		return -1;
+	}
+
+	// 같은 Texture라도 Mesh마다 용도가 정해져 있으므로 Model을 읽어서 모음
+	vector<BakeItem> items;
+	vector<ChannelSources> packedItems;
+	for (size_t i = 0; i < args.size(); i += 2)
+	{
+		ModelLoader modelLoader;
+		modelLoader.Load(args[i], args[i + 1], false);
+
+		for (const MeshData& meshData : modelLoader.m_meshes)
+		{
+			const BakeItem meshItems[] = {
+				{ meshData.albedoTextureFileName, TextureRole::Albedo },
+				{ meshData.emissiveTextureFileName, TextureRole::Emissive },
+				{ meshData.normalTextureFileName, TextureRole::Normal },
+				{ meshData.heightTextureFileName, TextureRole::Height },
+			};
+
+			for (const BakeItem& item : meshItems)
+			{
+				if (!item.fileName.empty())
+				{
+					items.push_back(item);
+				}
+			}
+
+			if (!meshData.aoTextureFileName.empty() || !meshData.roughnessTextureFileName.empty() ||
+				!meshData.metallicTextureFileName.empty())
+			{
+				packedItems.push_back(MaterialPacker::GetORMSources(meshData.aoTextureFileName,
+																	meshData.roughnessTextureFileName,
+																	meshData.metallicTextureFileName));
+			}
+		}
+	}
+
+	const auto startTime = chrono::steady_clock::now();
+	const size_t bakedCount = TextureBaker::BakeFiles(items, force);
+	const size_t packedCount = MaterialPacker::BakeFiles(packedItems, force);
+	const chrono::duration<double> elapsed = chrono::steady_clock::now() - startTime;
+
+	cout << "Baked " << bakedCount << " textures (" << items.size() << " references) and "
+		 << packedCount << " packed materials (" << packedItems.size() << " references) in "
+		 << elapsed.count() << " s" << endl;
+
+	return 0;
+}